@@ -0,0 +1,172 @@
+#include "CrashLog.h"
+
+#include <Arduino.h>
+#include <SDCardManager.h>
+#include <esp_attr.h>
+#include <esp_system.h>
+
+#include <cstring>
+
+namespace {
+constexpr uint32_t REGION_MAGIC = 0xC7A54106;
+constexpr const char* CRASH_LOG_PATH = "/crash.log";
+// Append across field sessions, but don't let the log grow without bound
+constexpr size_t MAX_LOG_BYTES = 64 * 1024;
+
+struct Region {
+  uint32_t magic;
+  uint32_t versionHash;
+  uint32_t bootCount;
+  uint32_t uptimeMs;
+  uint32_t freeHeapLowWater;
+  char task[16];
+  char checkpoint[24];
+  uint32_t eventIds[CrashLog::EVENT_COUNT];
+  uint32_t eventHead;
+};
+
+// Survives every reset that doesn't power down the RTC domain: panic, both watchdogs, brownout
+RTC_NOINIT_ATTR Region region;
+
+// Notes come from the web server handlers and background workers as well as the main loop
+portMUX_TYPE regionMux = portMUX_INITIALIZER_UNLOCKED;
+
+// FNV-1a over the version string: event-name addresses only mean anything to the same build
+uint32_t versionHash() {
+  uint32_t hash = 2166136261u;
+  for (const char* c = CROSSPOINT_VERSION; *c; c++) {
+    hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+  }
+  return hash;
+}
+
+bool isAbnormalReset(const esp_reset_reason_t reason) {
+  return reason == ESP_RST_PANIC || reason == ESP_RST_INT_WDT || reason == ESP_RST_TASK_WDT ||
+         reason == ESP_RST_WDT || reason == ESP_RST_BROWNOUT;
+}
+}  // namespace
+
+CrashLog CrashLog::instance;
+
+void CrashLog::begin() {
+  const esp_reset_reason_t reason = esp_reset_reason();
+  const uint32_t ourVersion = versionHash();
+
+  if (region.magic == REGION_MAGIC && isAbnormalReset(reason)) {
+    report.valid = true;
+    report.resetReason = reason;
+    report.bootCount = region.bootCount;
+    report.uptimeMs = region.uptimeMs;
+    report.freeHeapLowWater = region.freeHeapLowWater;
+    report.namesResolvable = region.versionHash == ourVersion;
+    memcpy(report.task, region.task, sizeof(report.task));
+    memcpy(report.checkpoint, region.checkpoint, sizeof(report.checkpoint));
+    report.task[sizeof(report.task) - 1] = '\0';
+    report.checkpoint[sizeof(report.checkpoint) - 1] = '\0';
+    // Unroll the ring oldest-first
+    for (size_t i = 0; i < EVENT_COUNT; i++) {
+      report.eventIds[i] = region.eventIds[(region.eventHead + i) % EVENT_COUNT];
+    }
+    Serial.printf("[%lu] [CRH] Previous run ended in %s after %lu ms (checkpoint \"%s\", task \"%s\")\n", millis(),
+                  resetReasonName(report.resetReason), report.uptimeMs, report.checkpoint, report.task);
+  }
+
+  // Re-arm for this run
+  const uint32_t bootCount = region.magic == REGION_MAGIC ? region.bootCount + 1 : 1;
+  memset(&region, 0, sizeof(region));
+  region.magic = REGION_MAGIC;
+  region.versionHash = ourVersion;
+  region.bootCount = bootCount;
+  region.freeHeapLowWater = ESP.getFreeHeap();
+  strlcpy(region.checkpoint, "boot", sizeof(region.checkpoint));
+}
+
+void CrashLog::persistIfCrashed() {
+  if (!report.valid || report.persisted) {
+    return;
+  }
+
+  FsFile file = SdMan.open(CRASH_LOG_PATH, O_WRONLY | O_CREAT | O_AT_END);
+  if (file && file.fileSize() > MAX_LOG_BYTES) {
+    file.close();
+    SdMan.remove(CRASH_LOG_PATH);
+    file = SdMan.open(CRASH_LOG_PATH, O_WRONLY | O_CREAT | O_AT_END);
+  }
+  if (!file) {
+    Serial.printf("[%lu] [CRH] Failed to open %s\n", millis(), CRASH_LOG_PATH);
+    return;
+  }
+
+  char line[192];
+  int len = snprintf(line, sizeof(line),
+                     "[boot %lu] %s after %lu ms, heap low-water %lu, task \"%s\", checkpoint \"%s\"\n",
+                     static_cast<unsigned long>(report.bootCount), resetReasonName(report.resetReason),
+                     static_cast<unsigned long>(report.uptimeMs), static_cast<unsigned long>(report.freeHeapLowWater),
+                     report.task, report.checkpoint);
+  if (len > 0) {
+    file.write(reinterpret_cast<const uint8_t*>(line), len);
+  }
+
+  for (size_t i = 0; i < EVENT_COUNT; i++) {
+    if (report.eventIds[i] == 0) {
+      continue;
+    }
+    if (report.namesResolvable) {
+      len = snprintf(line, sizeof(line), "[boot %lu]   event %s\n", static_cast<unsigned long>(report.bootCount),
+                     reinterpret_cast<const char*>(report.eventIds[i]));
+    } else {
+      len = snprintf(line, sizeof(line), "[boot %lu]   event 0x%08lx\n", static_cast<unsigned long>(report.bootCount),
+                     static_cast<unsigned long>(report.eventIds[i]));
+    }
+    if (len > 0) {
+      file.write(reinterpret_cast<const uint8_t*>(line), len);
+    }
+  }
+  file.close();
+
+  report.persisted = true;
+  Serial.printf("[%lu] [CRH] Crash report appended to %s\n", millis(), CRASH_LOG_PATH);
+}
+
+void CrashLog::note(const char* checkpoint) {
+  const char* taskName = pcTaskGetName(nullptr);
+  portENTER_CRITICAL(&regionMux);
+  strlcpy(region.checkpoint, checkpoint, sizeof(region.checkpoint));
+  strlcpy(region.task, taskName, sizeof(region.task));
+  region.uptimeMs = millis();
+  portEXIT_CRITICAL(&regionMux);
+}
+
+void CrashLog::noteEvent(const char* name) {
+  portENTER_CRITICAL(&regionMux);
+  region.eventIds[region.eventHead] = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(name));
+  region.eventHead = (region.eventHead + 1) % EVENT_COUNT;
+  portEXIT_CRITICAL(&regionMux);
+}
+
+void CrashLog::sample() {
+  const uint32_t freeHeap = ESP.getFreeHeap();
+  portENTER_CRITICAL(&regionMux);
+  region.uptimeMs = millis();
+  if (freeHeap < region.freeHeapLowWater) {
+    region.freeHeapLowWater = freeHeap;
+  }
+  portEXIT_CRITICAL(&regionMux);
+}
+
+const char* CrashLog::resetReasonName(const int reason) {
+  switch (reason) {
+    case ESP_RST_PANIC:
+      return "panic";
+    case ESP_RST_INT_WDT:
+      return "interrupt watchdog";
+    case ESP_RST_TASK_WDT:
+      return "task watchdog";
+    case ESP_RST_WDT:
+      return "watchdog";
+    case ESP_RST_BROWNOUT:
+      return "brownout";
+    default:
+      return "unknown";
+  }
+}
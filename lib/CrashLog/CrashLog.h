@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Crash flight recorder kept in RTC noinit RAM, surviving the resets that lose everything else:
+// panics, watchdog bites and brownouts. While running, the firmware keeps the region fresh with
+// a checkpoint string (current activity, risky operations), the noting task's name, the
+// free-heap low-water mark and the last few trace-recorder event ids. On the next boot, if the
+// reset reason is abnormal, the captured region is appended to /crash.log and served through
+// the web server's /api/crash debug endpoint, so performance cliffs that end in a watchdog
+// reset (SdFat stalls mid-upload, OOM death spirals) leave evidence behind.
+//
+// Event ids are the trace recorder's string-literal addresses; they resolve back to names only
+// when the booting firmware is the same build as the crashing one, and are reported as raw hex
+// otherwise.
+class CrashLog {
+ public:
+  static constexpr size_t EVENT_COUNT = 16;
+
+  struct Report {
+    bool valid = false;      // previous run ended abnormally and the region survived
+    bool persisted = false;  // appended to /crash.log this boot
+    bool namesResolvable = false;
+    int resetReason = 0;
+    uint32_t bootCount = 0;
+    uint32_t uptimeMs = 0;
+    uint32_t freeHeapLowWater = 0;
+    char task[16] = {0};
+    char checkpoint[24] = {0};
+    uint32_t eventIds[EVENT_COUNT] = {0};  // oldest-first, 0 = empty slot
+  };
+
+  // Get singleton instance
+  static CrashLog& getInstance() { return instance; }
+
+  // Examine the region left behind by the previous run and re-arm it for this one. Call once,
+  // as early in setup() as possible, so everything after runs on our watch
+  void begin();
+
+  // Append the captured report (if any) to /crash.log. Split from begin() because the SD card
+  // comes up later in setup()
+  void persistIfCrashed();
+
+  // Record where execution is; cheap enough for activity transitions and risky operations.
+  // The string is copied, so it doesn't have to be a literal
+  void note(const char* checkpoint);
+
+  // Mirror of the trace recorder: remember the event's string-literal address as an id
+  void noteEvent(const char* name);
+
+  // Refresh uptime and the heap low-water mark; the main loop calls this on its stats cadence
+  void sample();
+
+  // The previous run's report, valid only if that run ended abnormally
+  const Report& lastReport() const { return report; }
+
+  static const char* resetReasonName(int reason);
+
+ private:
+  // Static instance
+  static CrashLog instance;
+
+  Report report;
+};
+
+// Helper macro to access the crash log
+#define CRASH_LOG CrashLog::getInstance()
@@ -0,0 +1,161 @@
+#include "Dictionary.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+#include <cctype>
+#include <cstring>
+
+namespace {
+constexpr char DICTIONARY_FILE[] = "/dictionary.xdic";
+constexpr uint32_t DICTIONARY_MAGIC = 0x43494458;  // 'XDIC'
+constexpr uint8_t DICTIONARY_VERSION = 1;
+// Definitions larger than this are cut off rather than ballooning the heap
+constexpr size_t MAX_DEFINITION_BYTES = 4096;
+
+struct IndexRecord {
+  char headword[Dictionary::HEADWORD_BYTES];
+  uint32_t defOffset;
+  uint32_t defLen;
+};
+static_assert(sizeof(IndexRecord) == Dictionary::RECORD_SIZE, "index record must stay 32 bytes");
+}  // namespace
+
+// Initialize the static instance
+Dictionary Dictionary::instance;
+
+std::string Dictionary::foldWord(const std::string& word) {
+  std::string folded;
+  folded.reserve(word.size());
+  for (const char c : word) {
+    folded += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+  }
+  if (folded.size() > HEADWORD_BYTES) {
+    folded.resize(HEADWORD_BYTES);
+  }
+  return folded;
+}
+
+bool Dictionary::readHeader() {
+  FsFile file;
+  if (!SdMan.openFileForRead("DIC", DICTIONARY_FILE, file)) {
+    return false;
+  }
+
+  uint8_t header[HEADER_SIZE];
+  const bool ok = file.read(header, HEADER_SIZE) == static_cast<int>(HEADER_SIZE);
+  file.close();
+  if (!ok) {
+    return false;
+  }
+
+  uint32_t magic;
+  memcpy(&magic, header, sizeof(magic));
+  if (magic != DICTIONARY_MAGIC || header[4] != DICTIONARY_VERSION) {
+    Serial.printf("[%lu] [DIC] %s is not a v%u dictionary file\n", millis(), DICTIONARY_FILE, DICTIONARY_VERSION);
+    return false;
+  }
+  memcpy(&entryCount, header + 5, sizeof(entryCount));
+  return entryCount > 0;
+}
+
+bool Dictionary::isAvailable() {
+  if (!checked) {
+    checked = true;
+    available = readHeader();
+    if (available) {
+      Serial.printf("[%lu] [DIC] Dictionary ready: %lu entries\n", millis(), static_cast<unsigned long>(entryCount));
+    }
+  }
+  return available;
+}
+
+bool Dictionary::lookup(const std::string& word, std::string& definition) {
+  if (word.empty() || !isAvailable()) {
+    return false;
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForRead("DIC", DICTIONARY_FILE, file)) {
+    return false;
+  }
+
+  // The exact form first, then common English suffixes stripped back to a base
+  // form. Cheap stemming, but it covers plurals and regular verb forms without
+  // the build script having to enumerate every inflection.
+  const std::string folded = foldWord(word);
+  std::string candidates[6];
+  size_t candidateCount = 0;
+  candidates[candidateCount++] = folded;
+  if (folded.size() > 2 && folded.compare(folded.size() - 2, 2, "'s") == 0) {
+    candidates[candidateCount++] = folded.substr(0, folded.size() - 2);
+  }
+  if (folded.size() > 3 && folded.compare(folded.size() - 3, 3, "ies") == 0) {
+    candidates[candidateCount++] = folded.substr(0, folded.size() - 3) + "y";
+  }
+  if (folded.size() > 2 && folded.compare(folded.size() - 2, 2, "es") == 0) {
+    candidates[candidateCount++] = folded.substr(0, folded.size() - 2);
+  }
+  if (folded.size() > 1 && folded.back() == 's') {
+    candidates[candidateCount++] = folded.substr(0, folded.size() - 1);
+  }
+  if (folded.size() > 3 && folded.compare(folded.size() - 3, 3, "ing") == 0) {
+    candidates[candidateCount++] = folded.substr(0, folded.size() - 3);
+  } else if (folded.size() > 2 && folded.compare(folded.size() - 2, 2, "ed") == 0) {
+    candidates[candidateCount++] = folded.substr(0, folded.size() - 2);
+  }
+
+  const unsigned long start = millis();
+  bool found = false;
+  IndexRecord record = {};
+  for (size_t c = 0; c < candidateCount && !found; c++) {
+    const std::string& candidate = candidates[c];
+    char needle[HEADWORD_BYTES] = {};
+    memcpy(needle, candidate.c_str(), candidate.size());
+
+    // Binary search over the sorted fixed-size records; every probe is one
+    // aligned 32-byte read
+    uint32_t lo = 0;
+    uint32_t hi = entryCount;
+    while (lo < hi) {
+      const uint32_t mid = lo + (hi - lo) / 2;
+      if (!file.seek(HEADER_SIZE + static_cast<uint32_t>(RECORD_SIZE) * mid) ||
+          file.read(&record, RECORD_SIZE) != static_cast<int>(RECORD_SIZE)) {
+        file.close();
+        return false;
+      }
+      const int cmp = memcmp(needle, record.headword, HEADWORD_BYTES);
+      if (cmp == 0) {
+        found = true;
+        break;
+      }
+      if (cmp < 0) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+  }
+
+  if (!found) {
+    file.close();
+    Serial.printf("[%lu] [DIC] No entry for \"%s\" (%lums)\n", millis(), folded.c_str(), millis() - start);
+    return false;
+  }
+
+  size_t defLen = record.defLen;
+  if (defLen > MAX_DEFINITION_BYTES) {
+    defLen = MAX_DEFINITION_BYTES;
+  }
+  definition.resize(defLen);
+  const bool ok =
+      file.seek(record.defOffset) && file.read(&definition[0], defLen) == static_cast<int>(defLen);
+  file.close();
+  if (!ok) {
+    definition.clear();
+    return false;
+  }
+  Serial.printf("[%lu] [DIC] \"%s\": %u byte definition in %lums\n", millis(), folded.c_str(),
+                static_cast<unsigned>(defLen), millis() - start);
+  return true;
+}
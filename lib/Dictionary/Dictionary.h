@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * Singleton reader for the on-SD dictionary file (/dictionary.xdic).
+ *
+ * The format is built for lookups without loading the dictionary into RAM:
+ * a 16-byte pinned header, then a sorted block of fixed 32-byte index
+ * records (case-folded headword + definition offset/length), then the raw
+ * UTF-8 definitions. A lookup is a binary search over aligned index-record
+ * reads followed by one read of the definition, so even a 100k-entry
+ * dictionary answers in a handful of SD sectors.
+ *
+ * Dictionary files are produced on the host with scripts/make_dictionary.py
+ * and copied to the SD card root.
+ */
+class Dictionary {
+ public:
+  // Fixed index record layout; headwords longer than HEADWORD_BYTES are
+  // truncated (both at build time and at lookup time, so they still match)
+  static constexpr size_t HEADWORD_BYTES = 24;
+  static constexpr size_t RECORD_SIZE = 32;
+  static constexpr size_t HEADER_SIZE = 16;
+
+ private:
+  // Static instance
+  static Dictionary instance;
+
+  // Header fields pinned in RAM after the first open; `checked` gates the
+  // one-time header read so boots without a dictionary cost a single exists()
+  bool checked = false;
+  bool available = false;
+  uint32_t entryCount = 0;
+
+  // Private constructor for singleton
+  Dictionary() = default;
+
+  bool readHeader();
+
+ public:
+  // Delete copy constructor and assignment
+  Dictionary(const Dictionary&) = delete;
+  Dictionary& operator=(const Dictionary&) = delete;
+
+  // Get singleton instance
+  static Dictionary& getInstance() { return instance; }
+
+  // True when a valid dictionary file is present (lazy header check on first call)
+  bool isAvailable();
+
+  // Re-check the dictionary file on the next isAvailable() (for when the file is replaced)
+  void invalidate() {
+    checked = false;
+    available = false;
+  }
+
+  // Look up a word (case-insensitive; falls back to stripping common English
+  // suffixes when the exact form is absent). Returns false when the word has
+  // no entry or no dictionary is present.
+  bool lookup(const std::string& word, std::string& definition);
+
+  // Case-fold a word the same way the build script does (ASCII lowercase)
+  static std::string foldWord(const std::string& word);
+};
+
+// Helper macro to access the dictionary
+#define DICTIONARY Dictionary::getInstance()
@@ -1,12 +1,27 @@
 #pragma once
+#include <vector>
+
 #include "EpdFontData.h"
 
 class EpdFont {
   void getTextBounds(const char* string, int startX, int startY, int* minX, int* minY, int* maxX, int* maxY) const;
 
+  // Printable ASCII resolved at construction: the generator emits 0x20-0x7E as one contiguous
+  // interval, so list-screen measurement (mostly ASCII) indexes straight into the glyph table
+  // instead of binary-searching the intervals for every character. Null when a font splits
+  // the range.
+  static constexpr uint32_t ASCII_FIRST = 0x20;
+  static constexpr uint32_t ASCII_LAST = 0x7E;
+  const EpdGlyph* asciiGlyphs = nullptr;
+  // Fallback direct index for fonts whose ASCII coverage is fragmented (subsetted SD fonts):
+  // one pointer per printable ASCII codepoint, resolved through the interval search once at
+  // construction. Empty for the built-in fonts above, so they cost nothing; a null entry means
+  // the font genuinely lacks that character.
+  std::vector<const EpdGlyph*> asciiIndex;
+
  public:
   const EpdFontData* data;
-  explicit EpdFont(const EpdFontData* data) : data(data) {}
+  explicit EpdFont(const EpdFontData* data);
   ~EpdFont() = default;
   void getTextDimensions(const char* string, int* w, int* h) const;
   bool hasPrintableChars(const char* string) const;
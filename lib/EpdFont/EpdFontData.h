@@ -23,8 +23,8 @@ typedef struct {
 } EpdUnicodeInterval;
 
 /// Data stored for FONT AS A WHOLE
-typedef struct {
-  const uint8_t* bitmap;                ///< Glyph bitmaps, concatenated
+typedef struct EpdFontDataT {
+  const uint8_t* bitmap;                ///< Glyph bitmaps, concatenated (null for SD-backed fonts)
   const EpdGlyph* glyph;                ///< Glyph array
   const EpdUnicodeInterval* intervals;  ///< Valid unicode intervals for this font
   uint32_t intervalCount;               ///< Number of unicode intervals.
@@ -32,4 +32,9 @@ typedef struct {
   int ascender;                         ///< Maximal height of a glyph above the base line
   int descender;                        ///< Maximal height of a glyph below the base line
   bool is2Bit;
+  /// Demand-paged bitmap hook for SD-backed fonts (see SdFont): when bitmap is null, packed
+  /// glyph bytes are fetched through this instead. The generated built-in fonts list only the
+  /// fields above, so both stay zero-initialized for them.
+  bool (*readBitmap)(void* readCtx, uint32_t dataOffset, uint16_t dataLength, uint8_t* out);
+  void* readCtx;
 } EpdFontData;
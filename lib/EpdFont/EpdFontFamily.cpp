@@ -1,5 +1,9 @@
 #include "EpdFontFamily.h"
 
+#include <Utf8.h>
+
+#include <algorithm>
+
 const EpdFont* EpdFontFamily::getFont(const Style style) const {
   if (style == BOLD && bold) {
     return bold;
@@ -35,3 +39,32 @@ const EpdFontData* EpdFontFamily::getData(const Style style) const { return getF
 const EpdGlyph* EpdFontFamily::getGlyph(const uint32_t cp, const Style style) const {
   return getFont(style)->getGlyph(cp);
 };
+
+EpdShapedRun EpdFontFamily::shape(const char* string, const Style style) const {
+  EpdShapedRun run;
+  if (!string || *string == '\0') {
+    return run;
+  }
+
+  const EpdFont* font = getFont(style);
+  int minX = 0, maxX = 0;
+  utf8ForEachCodepoint(string, [&](const uint32_t cp, const uint32_t byteOffset) {
+    uint32_t resolvedCp = cp;
+    const EpdGlyph* glyph = font->getGlyph(resolvedCp);
+    if (!glyph) {
+      resolvedCp = REPLACEMENT_GLYPH;
+      glyph = font->getGlyph(resolvedCp);
+    }
+    if (!glyph) {
+      return;
+    }
+
+    minX = std::min(minX, run.advance + glyph->left);
+    maxX = std::max(maxX, run.advance + glyph->left + glyph->width);
+    run.glyphs.push_back({resolvedCp, glyph, byteOffset, run.advance});
+    run.advance += glyph->advanceX;
+  });
+
+  run.width = maxX - minX;
+  return run;
+}
@@ -1,6 +1,25 @@
 #pragma once
+#include <vector>
+
 #include "EpdFont.h"
 
+// A string resolved once into glyphs with pre-summed advances. Shaping (UTF-8 decode plus the
+// per-codepoint interval binary search) happens once; both width queries and drawing then walk
+// the resolved glyphs, so layout and draw don't shape the same string twice.
+struct EpdShapedRun {
+  struct ShapedGlyph {
+    uint32_t cp;            // Resolved codepoint (replacement glyph already substituted)
+    const EpdGlyph* glyph;  // Never null for stored entries
+    uint32_t byteOffset;    // Offset of the source character in the shaped string
+    int x;                  // Cursor position of this glyph relative to the run start
+  };
+  std::vector<ShapedGlyph> glyphs;
+  int width = 0;    // Bounds width, matches getTextDimensions()
+  int advance = 0;  // Total cursor advance
+
+  bool empty() const { return glyphs.empty(); }
+};
+
 class EpdFontFamily {
  public:
   enum Style : uint8_t { REGULAR = 0, BOLD = 1, ITALIC = 2, BOLD_ITALIC = 3 };
@@ -13,6 +32,7 @@ class EpdFontFamily {
   bool hasPrintableChars(const char* string, Style style = REGULAR) const;
   const EpdFontData* getData(Style style = REGULAR) const;
   const EpdGlyph* getGlyph(uint32_t cp, Style style = REGULAR) const;
+  EpdShapedRun shape(const char* string, Style style = REGULAR) const;
 
  private:
   const EpdFont* regular;
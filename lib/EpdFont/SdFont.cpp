@@ -0,0 +1,99 @@
+#include "SdFont.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+namespace {
+constexpr char CPF_MAGIC[4] = {'C', 'P', 'F', '1'};
+// Sanity caps against corrupt headers; generous for any realistic reading font
+constexpr uint32_t MAX_INTERVALS = 4096;
+constexpr uint32_t MAX_GLYPHS = 65536;
+}  // namespace
+
+SdFont::~SdFont() {
+  if (file) {
+    file.close();
+  }
+}
+
+bool SdFont::load(const std::string& path) {
+  if (!SdMan.openFileForRead("FNT", path, file)) {
+    return false;
+  }
+
+  char magic[4];
+  if (file.read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, CPF_MAGIC, sizeof(CPF_MAGIC)) != 0) {
+    Serial.printf("[%lu] [FNT] Not a CPF font: %s\n", millis(), path.c_str());
+    file.close();
+    return false;
+  }
+
+  uint8_t advanceY;
+  int32_t ascender, descender;
+  uint8_t is2Bit;
+  uint32_t intervalCount, glyphCount, bitmapLength;
+  serialization::readPod(file, advanceY);
+  serialization::readPod(file, ascender);
+  serialization::readPod(file, descender);
+  serialization::readPod(file, is2Bit);
+  serialization::readPod(file, intervalCount);
+  serialization::readPod(file, glyphCount);
+  serialization::readPod(file, bitmapLength);
+
+  if (intervalCount == 0 || intervalCount > MAX_INTERVALS || glyphCount == 0 || glyphCount > MAX_GLYPHS) {
+    Serial.printf("[%lu] [FNT] Malformed CPF header: %s\n", millis(), path.c_str());
+    file.close();
+    return false;
+  }
+
+  // Pin the interval and glyph tables; the bitmap blob stays on the card
+  intervals.resize(intervalCount);
+  glyphs.resize(glyphCount);
+  const size_t intervalBytes = intervalCount * sizeof(EpdUnicodeInterval);
+  const size_t glyphBytes = glyphCount * sizeof(EpdGlyph);
+  if (file.read(reinterpret_cast<uint8_t*>(intervals.data()), intervalBytes) != static_cast<int>(intervalBytes) ||
+      file.read(reinterpret_cast<uint8_t*>(glyphs.data()), glyphBytes) != static_cast<int>(glyphBytes)) {
+    Serial.printf("[%lu] [FNT] Truncated CPF tables: %s\n", millis(), path.c_str());
+    file.close();
+    return false;
+  }
+
+  bitmapFileOffset = file.position();
+  if (file.size() - bitmapFileOffset < bitmapLength) {
+    Serial.printf("[%lu] [FNT] Truncated CPF bitmap: %s\n", millis(), path.c_str());
+    file.close();
+    return false;
+  }
+
+  filePath = path;
+  data.bitmap = nullptr;
+  data.glyph = glyphs.data();
+  data.intervals = intervals.data();
+  data.intervalCount = intervalCount;
+  data.advanceY = advanceY;
+  data.ascender = ascender;
+  data.descender = descender;
+  data.is2Bit = is2Bit != 0;
+  data.readBitmap = &SdFont::readBitmapThunk;
+  data.readCtx = this;
+
+  font.reset(new EpdFont(&data));
+  family.reset(new EpdFontFamily(font.get()));
+
+  Serial.printf("[%lu] [FNT] Loaded %s: %lu glyphs, %lu KB bitmap on SD, %u KB pinned\n", millis(), path.c_str(),
+                static_cast<unsigned long>(glyphCount), static_cast<unsigned long>(bitmapLength / 1024),
+                static_cast<unsigned>((intervalBytes + glyphBytes) / 1024));
+  return true;
+}
+
+bool SdFont::readBitmap(const uint32_t dataOffset, const uint16_t dataLength, uint8_t* out) {
+  if (!file || !file.seek(bitmapFileOffset + dataOffset)) {
+    return false;
+  }
+  return file.read(out, dataLength) == static_cast<int>(dataLength);
+}
+
+bool SdFont::readBitmapThunk(void* readCtx, const uint32_t dataOffset, const uint16_t dataLength, uint8_t* out) {
+  return static_cast<SdFont*>(readCtx)->readBitmap(dataOffset, dataLength, out);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <SdFat.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EpdFontFamily.h"
+
+/**
+ * SD-backed font loaded from a .cpf file, for user fonts too large to live in flash or SRAM.
+ *
+ * Only the metrics header plus the interval and glyph tables are pinned in RAM (a few KB for a
+ * Latin subset); the multi-megabyte bitmap blob stays on the card and packed glyph bytes are
+ * fetched on demand through the EpdFontData readBitmap hook. The renderer's expanded-glyph
+ * cache sits in front of those reads, so after warm-up the hot glyph range renders at built-in
+ * font speed.
+ *
+ * File layout (little-endian, pods match the in-RAM structs):
+ *   magic "CPF1"
+ *   u8 advanceY, i32 ascender, i32 descender, u8 is2Bit
+ *   u32 intervalCount, u32 glyphCount, u32 bitmapLength
+ *   EpdUnicodeInterval[intervalCount]
+ *   EpdGlyph[glyphCount]
+ *   bitmap bytes
+ */
+class SdFont {
+  std::string filePath;
+  std::vector<EpdUnicodeInterval> intervals;
+  std::vector<EpdGlyph> glyphs;
+  EpdFontData data = {};
+  std::unique_ptr<EpdFont> font;
+  std::unique_ptr<EpdFontFamily> family;
+  // Kept open so a glyph-cache miss costs one seek and one short read, not a file open
+  FsFile file;
+  uint32_t bitmapFileOffset = 0;
+
+  bool readBitmap(uint32_t dataOffset, uint16_t dataLength, uint8_t* out);
+  static bool readBitmapThunk(void* readCtx, uint32_t dataOffset, uint16_t dataLength, uint8_t* out);
+
+ public:
+  SdFont() = default;
+  // Not copyable/movable: the font data hands out pointers into this object
+  SdFont(const SdFont&) = delete;
+  SdFont& operator=(const SdFont&) = delete;
+  ~SdFont();
+
+  // Parse the header and pin the glyph tables; returns false on a missing or malformed file
+  bool load(const std::string& path);
+  bool isLoaded() const { return family != nullptr; }
+  const std::string& getPath() const { return filePath; }
+  // Single-face family (the regular face serves all styles); valid while this object lives
+  const EpdFontFamily& getFamily() const { return *family; }
+};
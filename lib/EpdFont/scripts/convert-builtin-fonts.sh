@@ -4,6 +4,17 @@ set -e
 
 cd "$(dirname "$0")"
 
+# Optional deployment subsetting: point SUBSET_CONFIG at a code point ranges file (see
+# subsets/) to trim glyph coverage, e.g.
+#   SUBSET_CONFIG=subsets/latin1.txt ./convert-builtin-fonts.sh
+# Re-run build-font-ids.sh afterwards: the font IDs hash the generated headers, so trimmed
+# fonts get new IDs and stale paginated caches are invalidated automatically.
+SUBSET_ARGS=()
+if [ -n "$SUBSET_CONFIG" ]; then
+  SUBSET_ARGS=(--subset-config "$SUBSET_CONFIG")
+  echo "Subsetting to ranges from $SUBSET_CONFIG"
+fi
+
 READER_FONT_STYLES=("Regular" "Italic" "Bold" "BoldItalic")
 BOOKERLY_FONT_SIZES=(12 14 16 18)
 NOTOSANS_FONT_SIZES=(12 14 16 18)
@@ -14,7 +25,7 @@ for size in ${BOOKERLY_FONT_SIZES[@]}; do
     font_name="bookerly_${size}_$(echo $style | tr '[:upper:]' '[:lower:]')"
     font_path="../builtinFonts/source/Bookerly/Bookerly-${style}.ttf"
     output_path="../builtinFonts/${font_name}.h"
-    python fontconvert.py $font_name $size $font_path --2bit > $output_path
+    python fontconvert.py $font_name $size $font_path --2bit "${SUBSET_ARGS[@]}" > $output_path
     echo "Generated $output_path"
   done
 done
@@ -24,7 +35,7 @@ for size in ${NOTOSANS_FONT_SIZES[@]}; do
     font_name="notosans_${size}_$(echo $style | tr '[:upper:]' '[:lower:]')"
     font_path="../builtinFonts/source/NotoSans/NotoSans-${style}.ttf"
     output_path="../builtinFonts/${font_name}.h"
-    python fontconvert.py $font_name $size $font_path --2bit > $output_path
+    python fontconvert.py $font_name $size $font_path --2bit "${SUBSET_ARGS[@]}" > $output_path
     echo "Generated $output_path"
   done
 done
@@ -34,7 +45,7 @@ for size in ${OPENDYSLEXIC_FONT_SIZES[@]}; do
     font_name="opendyslexic_${size}_$(echo $style | tr '[:upper:]' '[:lower:]')"
     font_path="../builtinFonts/source/OpenDyslexic/OpenDyslexic-${style}.otf"
     output_path="../builtinFonts/${font_name}.h"
-    python fontconvert.py $font_name $size $font_path --2bit > $output_path
+    python fontconvert.py $font_name $size $font_path --2bit "${SUBSET_ARGS[@]}" > $output_path
     echo "Generated $output_path"
   done
 done
@@ -47,9 +58,9 @@ for size in ${UI_FONT_SIZES[@]}; do
     font_name="ubuntu_${size}_$(echo $style | tr '[:upper:]' '[:lower:]')"
     font_path="../builtinFonts/source/Ubuntu/Ubuntu-${style}.ttf"
     output_path="../builtinFonts/${font_name}.h"
-    python fontconvert.py $font_name $size $font_path > $output_path
+    python fontconvert.py $font_name $size $font_path "${SUBSET_ARGS[@]}" > $output_path
     echo "Generated $output_path"
   done
 done
 
-python fontconvert.py notosans_8_regular 8 ../builtinFonts/source/NotoSans/NotoSans-Regular.ttf > ../builtinFonts/notosans_8_regular.h
+python fontconvert.py notosans_8_regular 8 ../builtinFonts/source/NotoSans/NotoSans-Regular.ttf "${SUBSET_ARGS[@]}" > ../builtinFonts/notosans_8_regular.h
@@ -15,6 +15,7 @@ parser.add_argument("size", type=int, help="font size to use.")
 parser.add_argument("fontstack", action="store", nargs='+', help="list of font files, ordered by descending priority.")
 parser.add_argument("--2bit", dest="is2Bit", action="store_true", help="generate 2-bit greyscale bitmap instead of 1-bit black and white.")
 parser.add_argument("--additional-intervals", dest="additional_intervals", action="append", help="Additional code point intervals to export as min,max. This argument can be repeated.")
+parser.add_argument("--subset-config", dest="subset_config", help="Path to a file of code point ranges (one min,max per line, '#' comments) that replaces the built-in coverage list. See subsets/ for deployment configs.")
 args = parser.parse_args()
 
 GlyphProps = namedtuple("GlyphProps", ["width", "height", "advance_x", "left", "top", "data_length", "data_offset", "code_point"])
@@ -106,6 +107,29 @@ intervals = [
     (0xFFFD, 0xFFFD),
 ]
 
+def parse_subset_config(path):
+    ranges = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            try:
+                start, end = (int(n, base=0) for n in line.split(","))
+            except ValueError:
+                sys.exit(f"{path}:{lineno}: expected 'min,max', got '{line}'")
+            if end < start:
+                sys.exit(f"{path}:{lineno}: range end below start")
+            ranges.append((start, end))
+    if not ranges:
+        sys.exit(f"{path}: no code point ranges found")
+    return ranges
+
+if args.subset_config:
+    intervals = parse_subset_config(args.subset_config)
+    # The renderer substitutes U+FFFD for anything outside the subset; always keep it
+    intervals.append((0xFFFD, 0xFFFD))
+
 add_ints = []
 if args.additional_intervals:
     add_ints = [tuple([int(n, base=0) for n in i.split(",")]) for i in args.additional_intervals]
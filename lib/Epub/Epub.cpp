@@ -1,17 +1,60 @@
 #include "Epub.h"
 
+#include <BufferedPrint.h>
 #include <FsHelpers.h>
 #include <HardwareSerial.h>
 #include <JpegToBmpConverter.h>
+#include <PngToBmpConverter.h>
 #include <SDCardManager.h>
 #include <ZipFile.h>
+#include <ZipInflateStream.h>
 
+#include "Epub/hyphenation/Hyphenator.h"
 #include "Epub/parsers/ContainerParser.h"
 #include "Epub/parsers/ContentOpfParser.h"
+#include "Epub/parsers/CssLiteParser.h"
 #include "Epub/parsers/TocNavParser.h"
 #include "Epub/parsers/TocNcxParser.h"
 
+Epub::Epub(std::string filepath, const std::string& cacheDir) : filepath(std::move(filepath)) {
+  // create a cache key based on the filepath
+  cachePath = cacheDir + "/epub_" + std::to_string(std::hash<std::string>{}(this->filepath));
+}
+
+Epub::~Epub() = default;
+
+// Lazily constructs the shared ZipFile, restoring (or building) the persisted central-directory
+// cache so repeat item lookups skip the on-SD directory walk
+ZipFile& Epub::zipFile() const {
+  if (!zip) {
+    zip.reset(new ZipFile(filepath));
+    const auto statCachePath = cachePath + "/zipdir.bin";
+    if (!zip->loadStatCache(statCachePath)) {
+      // Only persist once the cache dir exists; failure just means we fall back to scanning
+      if (SdMan.exists(cachePath.c_str()) && zip->saveStatCache(statCachePath)) {
+        zip->loadStatCache(statCachePath);
+      }
+    }
+  }
+  return *zip;
+}
+
 bool Epub::findContentOpfFile(std::string* contentOpfFile) const {
+  // Fast probe: nearly every EPUB in the wild keeps its OPF at one of a few
+  // well-known paths. Each probe is one hash lookup against the zip's central
+  // directory cache, so hitting one skips the container.xml inflate+parse on
+  // every cold load. Misses (or exotic layouts) fall through to the full parse.
+  static constexpr const char* COMMON_OPF_PATHS[] = {"OEBPS/content.opf", "EPUB/package.opf", "OPS/content.opf",
+                                                     "content.opf"};
+  for (const char* probe : COMMON_OPF_PATHS) {
+    size_t probeSize;
+    if (zipFile().getInflatedFileSize(probe, &probeSize)) {
+      Serial.printf("[%lu] [EBP] OPF probe hit: %s\n", millis(), probe);
+      *contentOpfFile = probe;
+      return true;
+    }
+  }
+
   const auto containerPath = "META-INF/container.xml";
   size_t containerSize;
 
@@ -54,19 +97,21 @@ bool Epub::parseContentOpf(BookMetadataCache::BookMetadata& bookMetadata) {
 
   Serial.printf("[%lu] [EBP] Parsing content.opf: %s\n", millis(), contentOpfFilePath.c_str());
 
-  size_t contentOpfSize;
-  if (!getItemSize(contentOpfFilePath, &contentOpfSize)) {
-    Serial.printf("[%lu] [EBP] Could not get size of content.opf\n", millis());
+  ContentOpfParser opfParser(getCachePath(), getBasePath(), bookMetadataCache.get());
+  if (!opfParser.setup()) {
+    Serial.printf("[%lu] [EBP] Could not setup content.opf parser\n", millis());
     return false;
   }
 
-  ContentOpfParser opfParser(getCachePath(), getBasePath(), contentOpfSize, bookMetadataCache.get());
-  if (!opfParser.setup()) {
-    Serial.printf("[%lu] [EBP] Could not setup content.opf parser\n", millis());
+  // Pull the OPF through expat straight from the zip inflate stream. No size pre-pass is needed:
+  // the stream knows when the entry is drained, so the final-chunk flag comes from it.
+  ZipInflateStream opfStream(filepath);
+  if (!opfStream.open(zipFile(), FsHelpers::normalisePath(contentOpfFilePath).c_str(), 1024)) {
+    Serial.printf("[%lu] [EBP] Could not open content.opf\n", millis());
     return false;
   }
 
-  if (!readItemContentsToStream(contentOpfFilePath, opfParser, 1024)) {
+  if (!opfParser.parse(opfStream)) {
     Serial.printf("[%lu] [EBP] Could not read content.opf\n", millis());
     return false;
   }
@@ -86,10 +131,79 @@ bool Epub::parseContentOpf(BookMetadataCache::BookMetadata& bookMetadata) {
     tocNavItem = opfParser.tocNavPath;
   }
 
+  // Compile the stylesheets now, while we're paying for a cache build anyway; failure just
+  // means class-styled text renders flat
+  buildClassStyles(opfParser.cssItemHrefs);
+
   Serial.printf("[%lu] [EBP] Successfully parsed content.opf\n", millis());
   return true;
 }
 
+bool Epub::buildClassStyles(const std::vector<std::string>& cssHrefs) const {
+  CssClassStyles styles;
+
+  // Drain each sheet through the inflate stream in bounded chunks; the tail after the last
+  // complete rule is carried into the next feed, so peak memory is one chunk regardless of
+  // sheet size
+  constexpr size_t CSS_CHUNK_SIZE = 4096;
+  std::vector<char> buf(CSS_CHUNK_SIZE);
+  for (const auto& href : cssHrefs) {
+    ZipInflateStream cssStream(filepath);
+    if (!cssStream.open(zipFile(), FsHelpers::normalisePath(href).c_str(), 1024)) {
+      Serial.printf("[%lu] [EBP] Could not open stylesheet: %s\n", millis(), href.c_str());
+      continue;
+    }
+
+    size_t held = 0;
+    while (true) {
+      const int n = cssStream.read(reinterpret_cast<uint8_t*>(buf.data()) + held, CSS_CHUNK_SIZE - held);
+      if (n < 0) {
+        break;
+      }
+      const bool atEof = n == 0 || cssStream.available() == 0;
+      const size_t total = held + n;
+      const size_t consumed = CssLiteParser::parseRules(buf.data(), total, atEof, styles);
+      if (atEof) {
+        break;
+      }
+      if (consumed == 0 && total == CSS_CHUNK_SIZE) {
+        // A single rule bigger than the chunk (giant @media or data URI); drop the buffer and
+        // resynchronise on the next brace
+        held = 0;
+        continue;
+      }
+      memmove(buf.data(), buf.data() + consumed, total - consumed);
+      held = total - consumed;
+    }
+  }
+  styles.finalize();
+
+  FsFile stylesFile;
+  if (!SdMan.openFileForWrite("EBP", cachePath + "/styles.bin", stylesFile)) {
+    return false;
+  }
+  styles.writeToFile(stylesFile);
+  stylesFile.close();
+  Serial.printf("[%lu] [EBP] Compiled %zu class styles from %zu stylesheet(s)\n", millis(), styles.size(),
+                cssHrefs.size());
+  return true;
+}
+
+const CssClassStyles& Epub::getClassStyles() const {
+  if (!classStyles) {
+    classStyles.reset(new CssClassStyles());
+    FsFile stylesFile;
+    if (SdMan.openFileForRead("EBP", cachePath + "/styles.bin", stylesFile)) {
+      if (!classStyles->readFromFile(stylesFile)) {
+        // Unreadable table - treat as unstyled rather than failing the build
+        classStyles.reset(new CssClassStyles());
+      }
+      stylesFile.close();
+    }
+  }
+  return *classStyles;
+}
+
 bool Epub::parseTocNcxFile() const {
   // the ncx file should have been specified in the content.opf file
   if (tocNcxItem.empty()) {
@@ -104,7 +218,11 @@ bool Epub::parseTocNcxFile() const {
   if (!SdMan.openFileForWrite("EBP", tmpNcxPath, tempNcxFile)) {
     return false;
   }
-  readItemContentsToStream(tocNcxItem, tempNcxFile, 1024);
+  {
+    // Coalesce the inflater's odd-sized output pieces into aligned SD writes
+    BufferedPrint bufferedNcx(tempNcxFile, BufferedPrint::FILE_SINK_CAPACITY);
+    readItemContentsToStream(tocNcxItem, bufferedNcx, 1024);
+  }
   tempNcxFile.close();
   if (!SdMan.openFileForRead("EBP", tmpNcxPath, tempNcxFile)) {
     return false;
@@ -161,7 +279,10 @@ bool Epub::parseTocNavFile() const {
   if (!SdMan.openFileForWrite("EBP", tmpNavPath, tempNavFile)) {
     return false;
   }
-  readItemContentsToStream(tocNavItem, tempNavFile, 1024);
+  {
+    BufferedPrint bufferedNav(tempNavFile, BufferedPrint::FILE_SINK_CAPACITY);
+    readItemContentsToStream(tocNavItem, bufferedNav, 1024);
+  }
   tempNavFile.close();
   if (!SdMan.openFileForRead("EBP", tmpNavPath, tempNavFile)) {
     return false;
@@ -245,6 +366,8 @@ bool Epub::load(const bool buildIfMissing) {
     Serial.printf("[%lu] [EBP] Could not parse content.opf\n", millis());
     return false;
   }
+  // Resolve the hyphenation language once here so section builds pick patterns by tag
+  bookMetadata.hyphenationTag = Hyphenator::resolvePrimaryTag(bookMetadata.language);
   if (!bookMetadataCache->endContentOpfPass()) {
     Serial.printf("[%lu] [EBP] Could not end writing content.opf pass\n", millis());
     return false;
@@ -291,7 +414,7 @@ bool Epub::load(const bool buildIfMissing) {
 
   // Build final book.bin
   const uint32_t buildStart = millis();
-  if (!bookMetadataCache->buildBookBin(filepath, bookMetadata)) {
+  if (!bookMetadataCache->buildBookBin(zipFile(), bookMetadata)) {
     Serial.printf("[%lu] [EBP] Could not update mappings and sizes\n", millis());
     return false;
   }
@@ -319,7 +442,7 @@ bool Epub::clearCache() const {
     return true;
   }
 
-  if (!SdMan.removeDir(cachePath.c_str())) {
+  if (!FsHelpers::removeDirRecursive(cachePath)) {
     Serial.printf("[%lu] [EPB] Failed to clear cache\n", millis());
     return false;
   }
@@ -367,13 +490,22 @@ const std::string& Epub::getLanguage() const {
   return bookMetadataCache->coreMetadata.language;
 }
 
+const std::string& Epub::getHyphenationTag() const {
+  static std::string blank;
+  if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
+    return blank;
+  }
+
+  return bookMetadataCache->coreMetadata.hyphenationTag;
+}
+
 std::string Epub::getCoverBmpPath(bool cropped) const {
   const auto coverFileName = std::string("cover") + (cropped ? "_crop" : "");
   return cachePath + "/" + coverFileName + ".bmp";
 }
 
-bool Epub::generateCoverBmp(bool cropped) const {
-  // Already generated, return true
+bool Epub::generateCoverBmp(bool cropped, const JpegToBmpConverter::RowSink* sink) const {
+  // Already generated, return true (the sink is only fed when we actually decode)
   if (SdMan.exists(getCoverBmpPath(cropped).c_str())) {
     return true;
   }
@@ -398,7 +530,10 @@ bool Epub::generateCoverBmp(bool cropped) const {
     if (!SdMan.openFileForWrite("EBP", coverJpgTempPath, coverJpg)) {
       return false;
     }
-    readItemContentsToStream(coverImageHref, coverJpg, 1024);
+    {
+      BufferedPrint bufferedCover(coverJpg, BufferedPrint::FILE_SINK_CAPACITY);
+      readItemContentsToStream(coverImageHref, bufferedCover, 1024);
+    }
     coverJpg.close();
 
     if (!SdMan.openFileForRead("EBP", coverJpgTempPath, coverJpg)) {
@@ -410,7 +545,10 @@ bool Epub::generateCoverBmp(bool cropped) const {
       coverJpg.close();
       return false;
     }
-    const bool success = JpegToBmpConverter::jpegFileToBmpStream(coverJpg, coverBmp, cropped);
+    // The sink contract is packed 2-bit rows, so the streamed decode keeps the dithered
+    // pipeline; the plain cache write stores 4-bit raw tones tone-mapped at blit time
+    const bool success = sink ? JpegToBmpConverter::jpegFileToBmpStreamWithSink(coverJpg, &coverBmp, *sink, cropped)
+                              : JpegToBmpConverter::jpegFileTo4BitBmpStream(coverJpg, coverBmp, cropped);
     coverJpg.close();
     coverBmp.close();
     SdMan.remove(coverJpgTempPath.c_str());
@@ -421,10 +559,47 @@ bool Epub::generateCoverBmp(bool cropped) const {
     }
     Serial.printf("[%lu] [EBP] Generated BMP from JPG cover image, success: %s\n", millis(), success ? "yes" : "no");
     return success;
-  } else {
-    Serial.printf("[%lu] [EBP] Cover image is not a JPG, skipping\n", millis());
   }
 
+  if (coverImageHref.length() > 4 && coverImageHref.substr(coverImageHref.length() - 4) == ".png") {
+    Serial.printf("[%lu] [EBP] Generating BMP from PNG cover image (%s mode)\n", millis(), cropped ? "cropped" : "fit");
+    const auto coverPngTempPath = getCachePath() + "/.cover.png";
+
+    FsFile coverPng;
+    if (!SdMan.openFileForWrite("EBP", coverPngTempPath, coverPng)) {
+      return false;
+    }
+    {
+      BufferedPrint bufferedCover(coverPng, BufferedPrint::FILE_SINK_CAPACITY);
+      readItemContentsToStream(coverImageHref, bufferedCover, 1024);
+    }
+    coverPng.close();
+
+    if (!SdMan.openFileForRead("EBP", coverPngTempPath, coverPng)) {
+      return false;
+    }
+
+    FsFile coverBmp;
+    if (!SdMan.openFileForWrite("EBP", getCoverBmpPath(cropped), coverBmp)) {
+      coverPng.close();
+      return false;
+    }
+    // Same split as the JPG path: 2-bit rows for the sink, 4-bit raw tones for the cache
+    const bool success = sink ? PngToBmpConverter::pngFileToBmpStreamWithSink(coverPng, &coverBmp, *sink, cropped)
+                              : PngToBmpConverter::pngFileTo4BitBmpStream(coverPng, coverBmp, cropped);
+    coverPng.close();
+    coverBmp.close();
+    SdMan.remove(coverPngTempPath.c_str());
+
+    if (!success) {
+      Serial.printf("[%lu] [EBP] Failed to generate BMP from PNG cover image\n", millis());
+      SdMan.remove(getCoverBmpPath(cropped).c_str());
+    }
+    Serial.printf("[%lu] [EBP] Generated BMP from PNG cover image, success: %s\n", millis(), success ? "yes" : "no");
+    return success;
+  }
+
+  Serial.printf("[%lu] [EBP] Cover image is not a JPG or PNG, skipping\n", millis());
   return false;
 }
 
@@ -456,7 +631,10 @@ bool Epub::generateThumbBmp() const {
     if (!SdMan.openFileForWrite("EBP", coverJpgTempPath, coverJpg)) {
       return false;
     }
-    readItemContentsToStream(coverImageHref, coverJpg, 1024);
+    {
+      BufferedPrint bufferedCover(coverJpg, BufferedPrint::FILE_SINK_CAPACITY);
+      readItemContentsToStream(coverImageHref, bufferedCover, 1024);
+    }
     coverJpg.close();
 
     if (!SdMan.openFileForRead("EBP", coverJpgTempPath, coverJpg)) {
@@ -485,13 +663,160 @@ bool Epub::generateThumbBmp() const {
     Serial.printf("[%lu] [EBP] Generated thumb BMP from JPG cover image, success: %s\n", millis(),
                   success ? "yes" : "no");
     return success;
-  } else {
-    Serial.printf("[%lu] [EBP] Cover image is not a JPG, skipping thumbnail\n", millis());
   }
 
+  if (coverImageHref.length() > 4 && coverImageHref.substr(coverImageHref.length() - 4) == ".png") {
+    Serial.printf("[%lu] [EBP] Generating thumb BMP from PNG cover image\n", millis());
+    const auto coverPngTempPath = getCachePath() + "/.cover.png";
+
+    FsFile coverPng;
+    if (!SdMan.openFileForWrite("EBP", coverPngTempPath, coverPng)) {
+      return false;
+    }
+    {
+      BufferedPrint bufferedCover(coverPng, BufferedPrint::FILE_SINK_CAPACITY);
+      readItemContentsToStream(coverImageHref, bufferedCover, 1024);
+    }
+    coverPng.close();
+
+    if (!SdMan.openFileForRead("EBP", coverPngTempPath, coverPng)) {
+      return false;
+    }
+
+    FsFile thumbBmp;
+    if (!SdMan.openFileForWrite("EBP", getThumbBmpPath(), thumbBmp)) {
+      coverPng.close();
+      return false;
+    }
+    // Same half-screen 1-bit target as the JPG thumbnail path
+    constexpr int THUMB_TARGET_WIDTH = 240;
+    constexpr int THUMB_TARGET_HEIGHT = 400;
+    const bool success = PngToBmpConverter::pngFileTo1BitBmpStreamWithSize(coverPng, thumbBmp, THUMB_TARGET_WIDTH,
+                                                                           THUMB_TARGET_HEIGHT);
+    coverPng.close();
+    thumbBmp.close();
+    SdMan.remove(coverPngTempPath.c_str());
+
+    if (!success) {
+      Serial.printf("[%lu] [EBP] Failed to generate thumb BMP from PNG cover image\n", millis());
+      SdMan.remove(getThumbBmpPath().c_str());
+    }
+    Serial.printf("[%lu] [EBP] Generated thumb BMP from PNG cover image, success: %s\n", millis(),
+                  success ? "yes" : "no");
+    return success;
+  }
+
+  Serial.printf("[%lu] [EBP] Cover image is not a JPG or PNG, skipping thumbnail\n", millis());
   return false;
 }
 
+bool Epub::generateCoverAssets() const {
+  const bool needCover = !SdMan.exists(getCoverBmpPath(false).c_str());
+  const bool needCropped = !SdMan.exists(getCoverBmpPath(true).c_str());
+  const bool needThumb = !SdMan.exists(getThumbBmpPath().c_str());
+  if (!needCover && !needCropped && !needThumb) {
+    return true;
+  }
+
+  if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
+    Serial.printf("[%lu] [EBP] Cannot generate cover assets, cache not loaded\n", millis());
+    return false;
+  }
+
+  const auto coverImageHref = bookMetadataCache->coreMetadata.coverItemHref;
+  if (coverImageHref.empty()) {
+    Serial.printf("[%lu] [EBP] No known cover image\n", millis());
+    return false;
+  }
+
+  const bool isJpeg = coverImageHref.substr(coverImageHref.length() - 4) == ".jpg" ||
+                      coverImageHref.substr(coverImageHref.length() - 5) == ".jpeg";
+  if (!isJpeg) {
+    // The PNG decoder has no combined pass; fall back to one decode per variant
+    bool success = generateCoverBmp(false);
+    success = generateCoverBmp(true) && success;
+    success = generateThumbBmp() && success;
+    return success;
+  }
+
+  Serial.printf("[%lu] [EBP] Generating cover assets from JPG cover image in one decode\n", millis());
+  const auto coverJpgTempPath = getCachePath() + "/.cover.jpg";
+
+  FsFile coverJpg;
+  if (!SdMan.openFileForWrite("EBP", coverJpgTempPath, coverJpg)) {
+    return false;
+  }
+  {
+    BufferedPrint bufferedCover(coverJpg, BufferedPrint::FILE_SINK_CAPACITY);
+    readItemContentsToStream(coverImageHref, bufferedCover, 1024);
+  }
+  coverJpg.close();
+
+  if (!SdMan.openFileForRead("EBP", coverJpgTempPath, coverJpg)) {
+    return false;
+  }
+
+  // One output per missing variant, all fed from the same decode
+  JpegToBmpConverter::Output outputs[3];
+  FsFile bmpFiles[3];
+  std::string bmpPaths[3];
+  int count = 0;
+  bool success = true;
+  const auto addOutput = [&](const std::string& path, const bool oneBit, const bool fourBit, const bool crop,
+                             const int targetWidth, const int targetHeight) {
+    if (!SdMan.openFileForWrite("EBP", path, bmpFiles[count])) {
+      success = false;
+      return;
+    }
+    outputs[count].bmpOut = &bmpFiles[count];
+    outputs[count].targetMaxWidth = targetWidth;
+    outputs[count].targetMaxHeight = targetHeight;
+    outputs[count].oneBit = oneBit;
+    outputs[count].fourBit = fourBit;
+    outputs[count].crop = crop;
+    bmpPaths[count] = path;
+    count++;
+  };
+
+  // Same half-screen 1-bit target as generateThumbBmp
+  constexpr int THUMB_TARGET_WIDTH = 240;
+  constexpr int THUMB_TARGET_HEIGHT = 400;
+  // Full-size covers cache as 4-bit raw tones (tone-mapped to panel levels at blit time);
+  // the thumbnail stays 1-bit for the home screen
+  if (needCover) {
+    addOutput(getCoverBmpPath(false), false, true, false, JpegToBmpConverter::COVER_TARGET_WIDTH,
+              JpegToBmpConverter::COVER_TARGET_HEIGHT);
+  }
+  if (success && needCropped) {
+    addOutput(getCoverBmpPath(true), false, true, true, JpegToBmpConverter::COVER_TARGET_WIDTH,
+              JpegToBmpConverter::COVER_TARGET_HEIGHT);
+  }
+  if (success && needThumb) {
+    addOutput(getThumbBmpPath(), true, false, false, THUMB_TARGET_WIDTH, THUMB_TARGET_HEIGHT);
+  }
+
+  if (success) {
+    success = JpegToBmpConverter::jpegFileToBmpStreams(coverJpg, outputs, count);
+  }
+
+  coverJpg.close();
+  for (int i = 0; i < count; i++) {
+    bmpFiles[i].close();
+  }
+  SdMan.remove(coverJpgTempPath.c_str());
+
+  if (!success) {
+    Serial.printf("[%lu] [EBP] Failed to generate cover assets from JPG cover image\n", millis());
+    // Half-written variants are worse than missing ones
+    for (int i = 0; i < count; i++) {
+      SdMan.remove(bmpPaths[i].c_str());
+    }
+  }
+  Serial.printf("[%lu] [EBP] Generated %d cover asset(s) from JPG cover image, success: %s\n", millis(), count,
+                success ? "yes" : "no");
+  return success;
+}
+
 uint8_t* Epub::readItemContentsToBytes(const std::string& itemHref, size_t* size, const bool trailingNullByte) const {
   if (itemHref.empty()) {
     Serial.printf("[%lu] [EBP] Failed to read item, empty href\n", millis());
@@ -500,7 +825,7 @@ uint8_t* Epub::readItemContentsToBytes(const std::string& itemHref, size_t* size
 
   const std::string path = FsHelpers::normalisePath(itemHref);
 
-  const auto content = ZipFile(filepath).readFileToMemory(path.c_str(), size, trailingNullByte);
+  const auto content = zipFile().readFileToMemory(path.c_str(), size, trailingNullByte);
   if (!content) {
     Serial.printf("[%lu] [EBP] Failed to read item %s\n", millis(), path.c_str());
     return nullptr;
@@ -516,12 +841,12 @@ bool Epub::readItemContentsToStream(const std::string& itemHref, Print& out, con
   }
 
   const std::string path = FsHelpers::normalisePath(itemHref);
-  return ZipFile(filepath).readFileToStream(path.c_str(), out, chunkSize);
+  return zipFile().readFileToStream(path.c_str(), out, chunkSize);
 }
 
 bool Epub::getItemSize(const std::string& itemHref, size_t* size) const {
   const std::string path = FsHelpers::normalisePath(itemHref);
-  return ZipFile(filepath).getInflatedFileSize(path.c_str(), size);
+  return zipFile().getInflatedFileSize(path.c_str(), size);
 }
 
 int Epub::getSpineItemsCount() const {
@@ -531,7 +856,13 @@ int Epub::getSpineItemsCount() const {
   return bookMetadataCache->getSpineCount();
 }
 
-size_t Epub::getCumulativeSpineItemSize(const int spineIndex) const { return getSpineItem(spineIndex).cumulativeSize; }
+// Served from the in-RAM column BookMetadataCache::load() restored; no SD access
+size_t Epub::getCumulativeSpineItemSize(const int spineIndex) const {
+  if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
+    return 0;
+  }
+  return bookMetadataCache->getCumulativeSize(spineIndex);
+}
 
 BookMetadataCache::SpineEntry Epub::getSpineItem(const int spineIndex) const {
   if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
@@ -561,6 +892,15 @@ BookMetadataCache::TocEntry Epub::getTocItem(const int tocIndex) const {
   return bookMetadataCache->getTocEntry(tocIndex);
 }
 
+bool Epub::getTocItems(const int startIndex, const int count, std::vector<BookMetadataCache::TocEntry>& out) const {
+  if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
+    Serial.printf("[%lu] [EBP] getTocItems called but cache not loaded\n", millis());
+    return false;
+  }
+
+  return bookMetadataCache->getTocEntries(startIndex, count, out);
+}
+
 int Epub::getTocItemsCount() const {
   if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
     return 0;
@@ -615,13 +955,12 @@ int Epub::getSpineIndexForTextReference() const {
     return 0;
   }
 
-  // loop through spine items to get the correct index matching the text href
-  for (size_t i = 0; i < getSpineItemsCount(); i++) {
-    if (getSpineItem(i).href == bookMetadataCache->coreMetadata.textReferenceHref) {
-      Serial.printf("[%lu] [ERS] Text reference %s found at index %d\n", millis(),
-                    bookMetadataCache->coreMetadata.textReferenceHref.c_str(), i);
-      return i;
-    }
+  // Resolve against the href hash index persisted in book.bin
+  const int16_t spineIndex = bookMetadataCache->getSpineIndexForHref(bookMetadataCache->coreMetadata.textReferenceHref);
+  if (spineIndex >= 0) {
+    Serial.printf("[%lu] [ERS] Text reference %s found at index %d\n", millis(),
+                  bookMetadataCache->coreMetadata.textReferenceHref.c_str(), spineIndex);
+    return spineIndex;
   }
   // This should not happen, as we checked for empty textReferenceHref earlier
   Serial.printf("[%lu] [EBP] Section not found for text reference\n", millis());
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <JpegToBmpConverter.h>
 #include <Print.h>
 
 #include <memory>
@@ -9,6 +10,7 @@
 
 #include "Epub/BookMetadataCache.h"
 
+class CssClassStyles;
 class ZipFile;
 
 class Epub {
@@ -24,18 +26,26 @@ class Epub {
   std::string cachePath;
   // Spine and TOC cache
   std::unique_ptr<BookMetadataCache> bookMetadataCache;
+  // Reusable zip handle so the persisted central-directory cache survives across item reads
+  mutable std::unique_ptr<ZipFile> zip;
+  // Class→style table compiled from the book's stylesheets, loaded from styles.bin on first use
+  mutable std::unique_ptr<CssClassStyles> classStyles;
 
+  ZipFile& zipFile() const;
   bool findContentOpfFile(std::string* contentOpfFile) const;
   bool parseContentOpf(BookMetadataCache::BookMetadata& bookMetadata);
+  // Compile the manifest stylesheets into the class→style table and persist it as styles.bin
+  // (runs once, during the metadata cache build)
+  bool buildClassStyles(const std::vector<std::string>& cssHrefs) const;
   bool parseTocNcxFile() const;
   bool parseTocNavFile() const;
 
  public:
-  explicit Epub(std::string filepath, const std::string& cacheDir) : filepath(std::move(filepath)) {
-    // create a cache key based on the filepath
-    cachePath = cacheDir + "/epub_" + std::to_string(std::hash<std::string>{}(this->filepath));
-  }
-  ~Epub() = default;
+  // Defined out of line (with the destructor): the unique_ptr members hold types this header
+  // only forward-declares, so any inline member that could run their destructors would force
+  // includers to see the complete ZipFile/CssClassStyles definitions
+  explicit Epub(std::string filepath, const std::string& cacheDir);
+  ~Epub();
   std::string& getBasePath() { return contentBasePath; }
   bool load(bool buildIfMissing = true);
   bool clearCache() const;
@@ -45,16 +55,27 @@ class Epub {
   const std::string& getTitle() const;
   const std::string& getAuthor() const;
   const std::string& getLanguage() const;
+  // Primary hyphenation subtag resolved from the OPF language at metadata build time
+  const std::string& getHyphenationTag() const;
   std::string getCoverBmpPath(bool cropped = false) const;
-  bool generateCoverBmp(bool cropped = false) const;
+  // Generate the cover BMP cache if missing. When sink is provided the decoded rows are also
+  // streamed to it, so the first caller can paint while the cache file is being written.
+  bool generateCoverBmp(bool cropped = false, const JpegToBmpConverter::RowSink* sink = nullptr) const;
   std::string getThumbBmpPath() const;
   bool generateThumbBmp() const;
+  // Generate every missing cover asset (fit cover, cropped cover, home-screen thumbnail);
+  // a JPEG cover is decoded once for all of them, so warming a new book's caches pays for a
+  // single decode instead of three. Returns true when all three assets exist afterwards.
+  bool generateCoverAssets() const;
   uint8_t* readItemContentsToBytes(const std::string& itemHref, size_t* size = nullptr,
                                    bool trailingNullByte = false) const;
   bool readItemContentsToStream(const std::string& itemHref, Print& out, size_t chunkSize) const;
   bool getItemSize(const std::string& itemHref, size_t* size) const;
   BookMetadataCache::SpineEntry getSpineItem(int spineIndex) const;
   BookMetadataCache::TocEntry getTocItem(int tocIndex) const;
+  // Windowed bulk read of [startIndex, startIndex + count) TOC entries in one pass;
+  // much cheaper than per-index getTocItem calls for list views
+  bool getTocItems(int startIndex, int count, std::vector<BookMetadataCache::TocEntry>& out) const;
   int getSpineItemsCount() const;
   int getTocItemsCount() const;
   int getSpineIndexForTocIndex(int tocIndex) const;
@@ -62,6 +83,10 @@ class Epub {
   size_t getCumulativeSpineItemSize(int spineIndex) const;
   int getSpineIndexForTextReference() const;
 
+  // The compiled class→style table (empty when the book has no usable stylesheets); used by
+  // section builds to honour class-driven bold/italic/alignment
+  const CssClassStyles& getClassStyles() const;
+
   size_t getBookSize() const;
   float calculateProgress(int currentSpineIndex, float currentSpineRead) const;
 };
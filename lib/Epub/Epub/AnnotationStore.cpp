@@ -0,0 +1,187 @@
+#include "AnnotationStore.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr uint8_t ANNOTATION_FILE_VERSION = 1;
+constexpr char ANNOTATION_FILE_NAME[] = "/annot.bin";
+// High bit of the record flags marks a removal (the key identifies the target)
+constexpr uint8_t REMOVAL_FLAG = 0x80;
+}  // namespace
+
+uint16_t AnnotationStore::filterBit(const uint16_t spineIndex, const uint16_t page) {
+  // Knuth multiplicative mix of the page key into the filter's bit space
+  const uint32_t hash = spineIndex * 2654435761u + page * 40503u;
+  return static_cast<uint16_t>(hash % (FILTER_BYTES * 8));
+}
+
+void AnnotationStore::markFilter(const uint16_t spineIndex, const uint16_t page) {
+  const uint16_t bit = filterBit(spineIndex, page);
+  pageFilter[bit / 8] |= 1 << (bit % 8);
+}
+
+bool AnnotationStore::testFilter(const uint16_t spineIndex, const uint16_t page) const {
+  const uint16_t bit = filterBit(spineIndex, page);
+  return pageFilter[bit / 8] & (1 << (bit % 8));
+}
+
+void AnnotationStore::load(const std::string& cachePath) {
+  filePath = cachePath + ANNOTATION_FILE_NAME;
+  entries.clear();
+  memset(pageFilter, 0, FILTER_BYTES);
+  loaded = true;
+
+  FsFile file;
+  if (!SdMan.openFileForRead("ANN", filePath, file)) {
+    return;  // No annotations yet
+  }
+
+  uint8_t version = 0;
+  serialization::readPod(file, version);
+  if (version != ANNOTATION_FILE_VERSION) {
+    Serial.printf("[%lu] [ANN] Ignoring annotation file with unknown version %u\n", millis(), version);
+    file.close();
+    return;
+  }
+
+  // Single sequential replay; removals cancel the matching live record
+  const uint32_t fileSize = file.size();
+  while (file.position() < fileSize) {
+    const uint32_t offset = file.position();
+    uint8_t flags;
+    uint16_t spineIndex, page;
+    serialization::readPod(file, flags);
+    serialization::readPod(file, spineIndex);
+    serialization::readPod(file, page);
+    std::string text;
+    serialization::readString(file, text);
+
+    const Type type = static_cast<Type>(flags & ~REMOVAL_FLAG);
+    if (flags & REMOVAL_FLAG) {
+      entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                   [&](const Entry& e) {
+                                     return e.type == type && e.spineIndex == spineIndex && e.page == page;
+                                   }),
+                    entries.end());
+    } else {
+      entries.push_back({spineIndex, page, offset, type});
+    }
+  }
+  file.close();
+
+  for (const Entry& entry : entries) {
+    markFilter(entry.spineIndex, entry.page);
+  }
+  Serial.printf("[%lu] [ANN] Loaded %d annotation(s) from %s\n", millis(), count(), filePath.c_str());
+}
+
+bool AnnotationStore::appendRecord(const Type type, const bool removal, const uint16_t spineIndex, const uint16_t page,
+                                   const std::string& text, uint32_t& payloadOffset) const {
+  FsFile file = SdMan.open(filePath.c_str(), O_WRONLY | O_CREAT | O_AT_END);
+  if (!file) {
+    Serial.printf("[%lu] [ANN] Failed to open %s for append\n", millis(), filePath.c_str());
+    return false;
+  }
+  if (file.size() == 0) {
+    serialization::writePod(file, ANNOTATION_FILE_VERSION);
+  }
+  payloadOffset = file.position();
+  const uint8_t flags = static_cast<uint8_t>(type) | (removal ? REMOVAL_FLAG : 0);
+  serialization::writePod(file, flags);
+  serialization::writePod(file, spineIndex);
+  serialization::writePod(file, page);
+  serialization::writeString(file, text);
+  file.close();
+  return true;
+}
+
+bool AnnotationStore::hasAnnotations(const uint16_t spineIndex, const uint16_t page) const {
+  if (!testFilter(spineIndex, page)) {
+    return false;  // A clear bit is definitive
+  }
+  for (const Entry& entry : entries) {
+    if (entry.spineIndex == spineIndex && entry.page == page) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AnnotationStore::isBookmarked(const uint16_t spineIndex, const uint16_t page) const {
+  if (!testFilter(spineIndex, page)) {
+    return false;
+  }
+  for (const Entry& entry : entries) {
+    if (entry.type == Type::Bookmark && entry.spineIndex == spineIndex && entry.page == page) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AnnotationStore::toggleBookmark(const uint16_t spineIndex, const uint16_t page) {
+  uint32_t offset = 0;
+  if (isBookmarked(spineIndex, page)) {
+    if (appendRecord(Type::Bookmark, true, spineIndex, page, "", offset)) {
+      entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                   [&](const Entry& e) {
+                                     return e.type == Type::Bookmark && e.spineIndex == spineIndex && e.page == page;
+                                   }),
+                    entries.end());
+    }
+    return false;
+  }
+  if (appendRecord(Type::Bookmark, false, spineIndex, page, "", offset)) {
+    entries.push_back({spineIndex, page, offset, Type::Bookmark});
+    markFilter(spineIndex, page);
+  }
+  return true;
+}
+
+bool AnnotationStore::addHighlight(const uint16_t spineIndex, const uint16_t page, const std::string& text) {
+  uint32_t offset = 0;
+  if (!appendRecord(Type::Highlight, false, spineIndex, page, text, offset)) {
+    return false;
+  }
+  entries.push_back({spineIndex, page, offset, Type::Highlight});
+  markFilter(spineIndex, page);
+  return true;
+}
+
+bool AnnotationStore::readPageAnnotations(const uint16_t spineIndex, const uint16_t page,
+                                          std::vector<Annotation>& out) const {
+  if (!hasAnnotations(spineIndex, page)) {
+    return true;  // Nothing to read is still success
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForRead("ANN", filePath, file)) {
+    return false;
+  }
+  for (const Entry& entry : entries) {
+    if (entry.spineIndex != spineIndex || entry.page != page) {
+      continue;
+    }
+    if (!file.seek(entry.offset)) {
+      continue;
+    }
+    uint8_t flags;
+    uint16_t recSpine, recPage;
+    serialization::readPod(file, flags);
+    serialization::readPod(file, recSpine);
+    serialization::readPod(file, recPage);
+    Annotation annotation;
+    annotation.type = entry.type;
+    annotation.spineIndex = spineIndex;
+    annotation.page = page;
+    serialization::readString(file, annotation.text);
+    out.push_back(std::move(annotation));
+  }
+  file.close();
+  return true;
+}
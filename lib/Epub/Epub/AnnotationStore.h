@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Per-book store for bookmarks and highlights, kept under Epub::getCachePath().
+ *
+ * The record file is append-only: toggling a bookmark off appends a removal
+ * record rather than rewriting, so writes are one small append regardless of
+ * how many annotations the book has. At open the file is replayed once into a
+ * compact in-RAM index of live records plus a page-presence bit filter, so the
+ * render path answers "any annotations on this page?" with a bit test and a
+ * short index probe - record payloads are only read back when a page actually
+ * has one.
+ */
+class AnnotationStore {
+ public:
+  enum class Type : uint8_t {
+    Bookmark = 1,
+    Highlight = 2,
+  };
+
+  struct Annotation {
+    Type type;
+    uint16_t spineIndex;
+    uint16_t page;
+    std::string text;  // Highlight excerpt/note; empty for bookmarks
+  };
+
+ private:
+  // Live record: key plus the payload's file offset (payloads stay on SD)
+  struct Entry {
+    uint16_t spineIndex;
+    uint16_t page;
+    uint32_t offset;
+    Type type;
+  };
+
+  std::string filePath;
+  std::vector<Entry> entries;
+  bool loaded = false;
+
+  // One-sided page-presence filter: a clear bit proves the page has no
+  // annotations, which is the answer for almost every page turn. Bits are only
+  // set (removals leave them), so a hit still confirms against `entries`.
+  static constexpr size_t FILTER_BYTES = 256;
+  uint8_t pageFilter[FILTER_BYTES] = {};
+
+  static uint16_t filterBit(uint16_t spineIndex, uint16_t page);
+  void markFilter(uint16_t spineIndex, uint16_t page);
+  bool testFilter(uint16_t spineIndex, uint16_t page) const;
+  bool appendRecord(Type type, bool removal, uint16_t spineIndex, uint16_t page, const std::string& text,
+                    uint32_t& payloadOffset) const;
+
+ public:
+  // Replay the record file for this book (cache dir) into the in-RAM index;
+  // starts empty when the file is missing or from an unknown version
+  void load(const std::string& cachePath);
+
+  bool isLoaded() const { return loaded; }
+  int count() const { return static_cast<int>(entries.size()); }
+
+  // O(1) for the common no-annotation page; used on every render
+  bool hasAnnotations(uint16_t spineIndex, uint16_t page) const;
+
+  bool isBookmarked(uint16_t spineIndex, uint16_t page) const;
+
+  // Append an add/remove record and update the index; returns the new state
+  bool toggleBookmark(uint16_t spineIndex, uint16_t page);
+
+  // Append a highlight record carrying the excerpt text
+  bool addHighlight(uint16_t spineIndex, uint16_t page, const std::string& text);
+
+  // Read the full payloads for one page's annotations (seeks per live record)
+  bool readPageAnnotations(uint16_t spineIndex, uint16_t page, std::vector<Annotation>& out) const;
+};
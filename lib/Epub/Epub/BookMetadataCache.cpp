@@ -1,5 +1,6 @@
 #include "BookMetadataCache.h"
 
+#include <BufferedFileReader.h>
 #include <HardwareSerial.h>
 #include <Serialization.h>
 #include <ZipFile.h>
@@ -9,10 +10,18 @@
 #include "FsHelpers.h"
 
 namespace {
-constexpr uint8_t BOOK_CACHE_VERSION = 5;
+// v6: spine/TOC entries are length-prefixed record blobs read with one bulk read each
+// v7: sorted spine href hash index persisted between the metadata block and the LUTs
+// v8: styles.bin (class→style table) is compiled alongside the cache during the OPF pass
+// v9: resolved hyphenation primary tag persisted in the metadata block
+constexpr uint8_t BOOK_CACHE_VERSION = 9;
 constexpr char bookBinFile[] = "/book.bin";
 constexpr char tmpSpineBinFile[] = "/spine.bin.tmp";
 constexpr char tmpTocBinFile[] = "/toc.bin.tmp";
+// Sector-aligned window for the sequential entry loops (build passes and getTocEntries).
+// These always run on one task at a time and each loop scopes its own reader, so a single
+// shared buffer serves every pass without stack pressure.
+uint8_t entryWindow[4 * 1024];
 }  // namespace
 
 /* ============= WRITING / BUILDING FUNCTIONS ================ */
@@ -29,12 +38,18 @@ bool BookMetadataCache::beginContentOpfPass() {
   Serial.printf("[%lu] [BMC] Beginning content opf pass\n", millis());
 
   // Open spine file for writing
-  return SdMan.openFileForWrite("BMC", cachePath + tmpSpineBinFile, spineFile);
+  if (!SdMan.openFileForWrite("BMC", cachePath + tmpSpineBinFile, spineFile)) {
+    return false;
+  }
+  spineWriter.reset(new BufferedFileWriter(spineFile));
+  return true;
 }
 
 bool BookMetadataCache::endContentOpfPass() {
+  const bool flushed = !spineWriter || spineWriter->flushBuffer();
+  spineWriter.reset();
   spineFile.close();
-  return true;
+  return flushed;
 }
 
 bool BookMetadataCache::beginTocPass() {
@@ -47,34 +62,37 @@ bool BookMetadataCache::beginTocPass() {
     spineFile.close();
     return false;
   }
+  tocWriter.reset(new BufferedFileWriter(tocFile));
 
-  if (spineCount >= LARGE_SPINE_THRESHOLD) {
-    spineHrefIndex.clear();
-    spineHrefIndex.reserve(spineCount);
-    spineFile.seek(0);
+  // Build the href hash index for every book; the TOC pass resolves against it
+  // and buildBookBin persists it into book.bin
+  spineHrefIndex.clear();
+  spineHrefIndex.reserve(spineCount);
+  {
+    BufferedFileReader reader(spineFile, entryWindow, sizeof(entryWindow));
     for (int i = 0; i < spineCount; i++) {
-      auto entry = readSpineEntry(spineFile);
+      auto entry = readSpineEntry(reader);
       SpineHrefIndexEntry idx;
       idx.hrefHash = fnvHash64(entry.href);
       idx.hrefLen = static_cast<uint16_t>(entry.href.size());
       idx.spineIndex = static_cast<int16_t>(i);
       spineHrefIndex.push_back(idx);
     }
-    std::sort(spineHrefIndex.begin(), spineHrefIndex.end(),
-              [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
-                return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
-              });
-    spineFile.seek(0);
-    useSpineHrefIndex = true;
-    Serial.printf("[%lu] [BMC] Using fast index for %d spine items\n", millis(), spineCount);
-  } else {
-    useSpineHrefIndex = false;
   }
+  std::sort(spineHrefIndex.begin(), spineHrefIndex.end(),
+            [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
+              return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
+            });
+  spineFile.seek(0);
+  useSpineHrefIndex = true;
+  Serial.printf("[%lu] [BMC] Indexed %d spine hrefs\n", millis(), spineCount);
 
   return true;
 }
 
 bool BookMetadataCache::endTocPass() {
+  const bool flushed = !tocWriter || tocWriter->flushBuffer();
+  tocWriter.reset();
   tocFile.close();
   spineFile.close();
 
@@ -82,7 +100,7 @@ bool BookMetadataCache::endTocPass() {
   spineHrefIndex.shrink_to_fit();
   useSpineHrefIndex = false;
 
-  return true;
+  return flushed;
 }
 
 bool BookMetadataCache::endWrite() {
@@ -96,7 +114,7 @@ bool BookMetadataCache::endWrite() {
   return true;
 }
 
-bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMetadata& metadata) {
+bool BookMetadataCache::buildBookBin(ZipFile& zip, const BookMetadata& metadata) {
   // Open all three files, writing to meta, reading from spine and toc
   if (!SdMan.openFileForWrite("BMC", cachePath + bookBinFile, bookFile)) {
     return false;
@@ -116,37 +134,74 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
   constexpr uint32_t headerASize =
       sizeof(BOOK_CACHE_VERSION) + /* LUT Offset */ sizeof(uint32_t) + sizeof(spineCount) + sizeof(tocCount);
   const uint32_t metadataSize = metadata.title.size() + metadata.author.size() + metadata.language.size() +
-                                metadata.coverItemHref.size() + metadata.textReferenceHref.size() +
-                                sizeof(uint32_t) * 5;
+                                metadata.hyphenationTag.size() + metadata.coverItemHref.size() +
+                                metadata.textReferenceHref.size() + sizeof(uint32_t) * 6;
+  const uint32_t indexSize = sizeof(SpineHrefIndexEntry) * spineCount;
   const uint32_t lutSize = sizeof(uint32_t) * spineCount + sizeof(uint32_t) * tocCount;
-  const uint32_t lutOffset = headerASize + metadataSize;
+  const uint32_t lutOffset = headerASize + metadataSize + indexSize;
+
+  // book.bin is laid out strictly front to back (offsets are computed above, never patched),
+  // so the whole build can go through one coalescing writer and hit the card in aligned units
+  BufferedFileWriter bookWriter(bookFile);
 
   // Header A
-  serialization::writePod(bookFile, BOOK_CACHE_VERSION);
-  serialization::writePod(bookFile, lutOffset);
-  serialization::writePod(bookFile, spineCount);
-  serialization::writePod(bookFile, tocCount);
+  serialization::writePod(bookWriter, BOOK_CACHE_VERSION);
+  serialization::writePod(bookWriter, lutOffset);
+  serialization::writePod(bookWriter, spineCount);
+  serialization::writePod(bookWriter, tocCount);
   // Metadata
-  serialization::writeString(bookFile, metadata.title);
-  serialization::writeString(bookFile, metadata.author);
-  serialization::writeString(bookFile, metadata.language);
-  serialization::writeString(bookFile, metadata.coverItemHref);
-  serialization::writeString(bookFile, metadata.textReferenceHref);
+  serialization::writeString(bookWriter, metadata.title);
+  serialization::writeString(bookWriter, metadata.author);
+  serialization::writeString(bookWriter, metadata.language);
+  serialization::writeString(bookWriter, metadata.hyphenationTag);
+  serialization::writeString(bookWriter, metadata.coverItemHref);
+  serialization::writeString(bookWriter, metadata.textReferenceHref);
+
+  // Loop through spine entries collecting LUT positions and the href hash index;
+  // the index is written ahead of the LUTs so both sit in the fixed-size region
+  std::vector<uint32_t> spineLut(spineCount);
+  spineHrefIndex.clear();
+  spineHrefIndex.reserve(spineCount);
+  uint32_t spineBytes = 0;
+  {
+    BufferedFileReader reader(spineFile, entryWindow, sizeof(entryWindow));
+    for (int i = 0; i < spineCount; i++) {
+      const uint32_t pos = reader.position();
+      auto spineEntry = readSpineEntry(reader);
+      spineLut[i] = pos + lutOffset + lutSize;
 
-  // Loop through spine entries, writing LUT positions
-  spineFile.seek(0);
+      SpineHrefIndexEntry idx;
+      idx.hrefHash = fnvHash64(spineEntry.href);
+      idx.hrefLen = static_cast<uint16_t>(spineEntry.href.size());
+      idx.spineIndex = static_cast<int16_t>(i);
+      spineHrefIndex.push_back(idx);
+    }
+    spineBytes = reader.position();
+  }
+
+  // Persist the sorted index with one bulk write (entries are packed PODs)
+  std::sort(spineHrefIndex.begin(), spineHrefIndex.end(),
+            [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
+              return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
+            });
+  bookWriter.write(reinterpret_cast<const uint8_t*>(spineHrefIndex.data()), indexSize);
+  spineHrefIndex.clear();
+  spineHrefIndex.shrink_to_fit();
+  useSpineHrefIndex = false;
+
+  // Spine LUT
   for (int i = 0; i < spineCount; i++) {
-    uint32_t pos = spineFile.position();
-    auto spineEntry = readSpineEntry(spineFile);
-    serialization::writePod(bookFile, pos + lutOffset + lutSize);
+    serialization::writePod(bookWriter, spineLut[i]);
   }
 
   // Loop through toc entries, writing LUT positions
-  tocFile.seek(0);
-  for (int i = 0; i < tocCount; i++) {
-    uint32_t pos = tocFile.position();
-    auto tocEntry = readTocEntry(tocFile);
-    serialization::writePod(bookFile, pos + lutOffset + lutSize + static_cast<uint32_t>(spineFile.position()));
+  {
+    BufferedFileReader reader(tocFile, entryWindow, sizeof(entryWindow));
+    for (int i = 0; i < tocCount; i++) {
+      const uint32_t pos = reader.position();
+      auto tocEntry = readTocEntry(reader);
+      serialization::writePod(bookWriter, pos + lutOffset + lutSize + spineBytes);
+    }
   }
 
   // LUTs complete
@@ -154,18 +209,22 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
 
   // Build spineIndex->tocIndex mapping in one pass (O(n) instead of O(n*m))
   std::vector<int16_t> spineToTocIndex(spineCount, -1);
-  tocFile.seek(0);
-  for (int j = 0; j < tocCount; j++) {
-    auto tocEntry = readTocEntry(tocFile);
-    if (tocEntry.spineIndex >= 0 && tocEntry.spineIndex < spineCount) {
-      if (spineToTocIndex[tocEntry.spineIndex] == -1) {
-        spineToTocIndex[tocEntry.spineIndex] = static_cast<int16_t>(j);
+  {
+    BufferedFileReader reader(tocFile, entryWindow, sizeof(entryWindow));
+    for (int j = 0; j < tocCount; j++) {
+      auto tocEntry = readTocEntry(reader);
+      if (tocEntry.spineIndex >= 0 && tocEntry.spineIndex < spineCount) {
+        if (spineToTocIndex[tocEntry.spineIndex] == -1) {
+          spineToTocIndex[tocEntry.spineIndex] = static_cast<int16_t>(j);
+        }
       }
     }
   }
 
-  ZipFile zip(epubPath);
-  // Pre-open zip file to speed up size calculations
+  // The caller's shared ZipFile carries the persisted central-dir index that Epub::zipFile()
+  // built when the OPF pass first touched the archive, so the size lookups below resolve from
+  // RAM and first open does exactly one central-directory walk (the one that built the index).
+  // Pre-open the underlying file so per-lookup fallbacks don't reopen it.
   if (!zip.open()) {
     Serial.printf("[%lu] [BMC] Could not open EPUB zip for size calculations\n", millis());
     bookFile.close();
@@ -177,8 +236,9 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
   // For large EPUBs (2000+ chapters), pre-loading all ZIP central directory entries
   // into memory causes OOM crashes on ESP32-C3's limited ~380KB RAM.
   // Instead, for large books we use a one-pass batch lookup that scans the ZIP
-  // central directory once and matches against spine targets using hash comparison.
-  // This is O(n*log(m)) instead of O(n*m) while avoiding memory exhaustion.
+  // central directory once (or the restored index) and matches against spine targets
+  // using hash comparison. This is O(n*log(m)) instead of O(n*m) while avoiding
+  // memory exhaustion.
   // See: https://github.com/crosspoint-reader/crosspoint-reader/issues/134
 
   std::vector<uint32_t> spineSizes;
@@ -190,10 +250,12 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
     std::vector<ZipFile::SizeTarget> targets;
     targets.reserve(spineCount);
 
-    spineFile.seek(0);
+    BufferedFileReader reader(spineFile, entryWindow, sizeof(entryWindow));
     for (int i = 0; i < spineCount; i++) {
-      auto entry = readSpineEntry(spineFile);
-      std::string path = FsHelpers::normalisePath(entry.href);
+      auto entry = readSpineEntry(reader);
+      // The entry copy is throwaway here, so normalise its href buffer in place
+      std::string path = std::move(entry.href);
+      FsHelpers::normalisePathInPlace(path);
 
       ZipFile::SizeTarget t;
       t.hash = ZipFile::fnvHash64(path.c_str(), path.size());
@@ -217,10 +279,11 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
   }
 
   uint32_t cumSize = 0;
-  spineFile.seek(0);
+  std::string pathScratch;  // Reused across spine items; hrefs stay intact for the rewrite below
+  BufferedFileReader spineReader(spineFile, entryWindow, sizeof(entryWindow));
   int lastSpineTocIndex = -1;
   for (int i = 0; i < spineCount; i++) {
-    auto spineEntry = readSpineEntry(spineFile);
+    auto spineEntry = readSpineEntry(spineReader);
 
     spineEntry.tocIndex = spineToTocIndex[i];
 
@@ -238,15 +301,17 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
     if (useBatchSizes) {
       itemSize = spineSizes[i];
       if (itemSize == 0) {
-        const std::string path = FsHelpers::normalisePath(spineEntry.href);
-        if (!zip.getInflatedFileSize(path.c_str(), &itemSize)) {
-          Serial.printf("[%lu] [BMC] Warning: Could not get size for spine item: %s\n", millis(), path.c_str());
+        pathScratch.assign(spineEntry.href);
+        FsHelpers::normalisePathInPlace(pathScratch);
+        if (!zip.getInflatedFileSize(pathScratch.c_str(), &itemSize)) {
+          Serial.printf("[%lu] [BMC] Warning: Could not get size for spine item: %s\n", millis(), pathScratch.c_str());
         }
       }
     } else {
-      const std::string path = FsHelpers::normalisePath(spineEntry.href);
-      if (!zip.getInflatedFileSize(path.c_str(), &itemSize)) {
-        Serial.printf("[%lu] [BMC] Warning: Could not get size for spine item: %s\n", millis(), path.c_str());
+      pathScratch.assign(spineEntry.href);
+      FsHelpers::normalisePathInPlace(pathScratch);
+      if (!zip.getInflatedFileSize(pathScratch.c_str(), &itemSize)) {
+        Serial.printf("[%lu] [BMC] Warning: Could not get size for spine item: %s\n", millis(), pathScratch.c_str());
       }
     }
 
@@ -254,22 +319,31 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
     spineEntry.cumulativeSize = cumSize;
 
     // Write out spine data to book.bin
-    writeSpineEntry(bookFile, spineEntry);
+    writeSpineEntry(bookWriter, spineEntry);
   }
   // Close opened zip file
   zip.close();
 
   // Loop through toc entries from toc file writing to book.bin
-  tocFile.seek(0);
-  for (int i = 0; i < tocCount; i++) {
-    auto tocEntry = readTocEntry(tocFile);
-    writeTocEntry(bookFile, tocEntry);
+  {
+    BufferedFileReader reader(tocFile, entryWindow, sizeof(entryWindow));
+    for (int i = 0; i < tocCount; i++) {
+      auto tocEntry = readTocEntry(reader);
+      writeTocEntry(bookWriter, tocEntry);
+    }
   }
 
+  const bool flushed = bookWriter.flushBuffer();
   bookFile.close();
   spineFile.close();
   tocFile.close();
 
+  if (!flushed) {
+    Serial.printf("[%lu] [BMC] Failed to flush book.bin\n", millis());
+    SdMan.remove((cachePath + bookBinFile).c_str());
+    return false;
+  }
+
   Serial.printf("[%lu] [BMC] Successfully built book.bin\n", millis());
   return true;
 }
@@ -284,40 +358,42 @@ bool BookMetadataCache::cleanupTmpFiles() const {
   return true;
 }
 
-uint32_t BookMetadataCache::writeSpineEntry(FsFile& file, const SpineEntry& entry) const {
-  const uint32_t pos = file.position();
-  serialization::writeString(file, entry.href);
-  serialization::writePod(file, entry.cumulativeSize);
-  serialization::writePod(file, entry.tocIndex);
-  return pos;
+template <typename File>
+uint32_t BookMetadataCache::writeSpineEntry(File& file, const SpineEntry& entry) const {
+  serialization::RecordWriter record;
+  record.str(entry.href);
+  record.pod(entry.cumulativeSize);
+  record.pod(entry.tocIndex);
+  return record.writeTo(file);
 }
 
-uint32_t BookMetadataCache::writeTocEntry(FsFile& file, const TocEntry& entry) const {
-  const uint32_t pos = file.position();
-  serialization::writeString(file, entry.title);
-  serialization::writeString(file, entry.href);
-  serialization::writeString(file, entry.anchor);
-  serialization::writePod(file, entry.level);
-  serialization::writePod(file, entry.spineIndex);
-  return pos;
+template <typename File>
+uint32_t BookMetadataCache::writeTocEntry(File& file, const TocEntry& entry) const {
+  serialization::RecordWriter record;
+  record.str(entry.title);
+  record.str(entry.href);
+  record.str(entry.anchor);
+  record.pod(entry.level);
+  record.pod(entry.spineIndex);
+  return record.writeTo(file);
 }
 
 // Note: for the LUT to be accurate, this **MUST** be called for all spine items before `addTocEntry` is ever called
 // this is because in this function we're marking positions of the items
 void BookMetadataCache::createSpineEntry(const std::string& href) {
-  if (!buildMode || !spineFile) {
+  if (!buildMode || !spineFile || !spineWriter) {
     Serial.printf("[%lu] [BMC] createSpineEntry called but not in build mode\n", millis());
     return;
   }
 
   const SpineEntry entry(href, 0, -1);
-  writeSpineEntry(spineFile, entry);
+  writeSpineEntry(*spineWriter, entry);
   spineCount++;
 }
 
 void BookMetadataCache::createTocEntry(const std::string& title, const std::string& href, const std::string& anchor,
                                        const uint8_t level) {
-  if (!buildMode || !tocFile || !spineFile) {
+  if (!buildMode || !tocFile || !spineFile || !tocWriter) {
     Serial.printf("[%lu] [BMC] createTocEntry called but not in build mode\n", millis());
     return;
   }
@@ -343,9 +419,9 @@ void BookMetadataCache::createTocEntry(const std::string& title, const std::stri
       Serial.printf("[%lu] [BMC] createTocEntry: Could not find spine item for TOC href %s\n", millis(), href.c_str());
     }
   } else {
-    spineFile.seek(0);
+    BufferedFileReader reader(spineFile, entryWindow, sizeof(entryWindow));
     for (int i = 0; i < spineCount; i++) {
-      auto spineEntry = readSpineEntry(spineFile);
+      auto spineEntry = readSpineEntry(reader);
       if (spineEntry.href == href) {
         spineIndex = static_cast<int16_t>(i);
         break;
@@ -357,7 +433,7 @@ void BookMetadataCache::createTocEntry(const std::string& title, const std::stri
   }
 
   const TocEntry entry(title, href, anchor, level, spineIndex);
-  writeTocEntry(tocFile, entry);
+  writeTocEntry(*tocWriter, entry);
   tocCount++;
 }
 
@@ -383,9 +459,27 @@ bool BookMetadataCache::load() {
   serialization::readString(bookFile, coreMetadata.title);
   serialization::readString(bookFile, coreMetadata.author);
   serialization::readString(bookFile, coreMetadata.language);
+  serialization::readString(bookFile, coreMetadata.hyphenationTag);
   serialization::readString(bookFile, coreMetadata.coverItemHref);
   serialization::readString(bookFile, coreMetadata.textReferenceHref);
 
+  // The href hash index sits directly after the metadata block; note its offset
+  // so getSpineIndexForHref can bulk-read it on first use
+  spineHrefIndexOffset = bookFile.position();
+  useSpineHrefIndex = false;
+
+  // Restore the cumulative-size column with one sequential pass over the spine
+  // records (4 bytes per entry resident); progress math then never seeks
+  cumulativeSizes.resize(spineCount);
+  {
+    const uint32_t lutSize = sizeof(uint32_t) * (spineCount + tocCount);
+    BufferedFileReader reader(bookFile, entryWindow, sizeof(entryWindow));
+    reader.seek(lutOffset + lutSize);
+    for (int i = 0; i < spineCount; i++) {
+      cumulativeSizes[i] = readSpineEntry(reader).cumulativeSize;
+    }
+  }
+
   loaded = true;
   Serial.printf("[%lu] [BMC] Loaded cache data: %d spine, %d TOC entries\n", millis(), spineCount, tocCount);
   return true;
@@ -429,20 +523,95 @@ BookMetadataCache::TocEntry BookMetadataCache::getTocEntry(const int index) {
   return readTocEntry(bookFile);
 }
 
-BookMetadataCache::SpineEntry BookMetadataCache::readSpineEntry(FsFile& file) const {
+bool BookMetadataCache::getTocEntries(const int startIndex, const int count, std::vector<TocEntry>& out) {
+  out.clear();
+  if (!loaded) {
+    Serial.printf("[%lu] [BMC] getTocEntries called but cache not loaded\n", millis());
+    return false;
+  }
+
+  if (startIndex < 0 || count <= 0 || startIndex + count > static_cast<int>(tocCount)) {
+    Serial.printf("[%lu] [BMC] getTocEntries range [%d, %d) out of bounds\n", millis(), startIndex, startIndex + count);
+    return false;
+  }
+
+  // One LUT lookup locates the window start; the records themselves sit back to back
+  bookFile.seek(lutOffset + sizeof(uint32_t) * spineCount + sizeof(uint32_t) * startIndex);
+  uint32_t tocEntryPos;
+  serialization::readPod(bookFile, tocEntryPos);
+
+  out.reserve(count);
+  BufferedFileReader reader(bookFile, entryWindow, sizeof(entryWindow));
+  reader.seek(tocEntryPos);
+  for (int i = 0; i < count; i++) {
+    out.push_back(readTocEntry(reader));
+  }
+  return true;
+}
+
+int16_t BookMetadataCache::getSpineIndexForHref(const std::string& href) {
+  if (!loaded) {
+    Serial.printf("[%lu] [BMC] getSpineIndexForHref called but cache not loaded\n", millis());
+    return -1;
+  }
+
+  if (spineCount == 0) {
+    return -1;
+  }
+
+  if (!useSpineHrefIndex) {
+    // One bulk read restores the sorted index built by buildBookBin()
+    const size_t indexBytes = sizeof(SpineHrefIndexEntry) * spineCount;
+    spineHrefIndex.resize(spineCount);
+    bookFile.seek(spineHrefIndexOffset);
+    if (bookFile.read(reinterpret_cast<uint8_t*>(spineHrefIndex.data()), indexBytes) != indexBytes) {
+      Serial.printf("[%lu] [BMC] Failed to read spine href index\n", millis());
+      spineHrefIndex.clear();
+      return -1;
+    }
+    useSpineHrefIndex = true;
+  }
+
+  const uint64_t targetHash = fnvHash64(href);
+  const uint16_t targetLen = static_cast<uint16_t>(href.size());
+
+  auto it =
+      std::lower_bound(spineHrefIndex.begin(), spineHrefIndex.end(), SpineHrefIndexEntry{targetHash, targetLen, 0},
+                       [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
+                         return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
+                       });
+
+  if (it != spineHrefIndex.end() && it->hrefHash == targetHash && it->hrefLen == targetLen) {
+    return it->spineIndex;
+  }
+  return -1;
+}
+
+template <typename File>
+BookMetadataCache::SpineEntry BookMetadataCache::readSpineEntry(File& file) const {
   SpineEntry entry;
-  serialization::readString(file, entry.href);
-  serialization::readPod(file, entry.cumulativeSize);
-  serialization::readPod(file, entry.tocIndex);
+  // One bulk read per entry; the scratch view reuses its buffer across the entry loops
+  if (!recordScratch.readFrom(file)) {
+    Serial.printf("[%lu] [BMC] Bad spine entry record\n", millis());
+    return entry;
+  }
+  recordScratch.str(entry.href);
+  recordScratch.pod(entry.cumulativeSize);
+  recordScratch.pod(entry.tocIndex);
   return entry;
 }
 
-BookMetadataCache::TocEntry BookMetadataCache::readTocEntry(FsFile& file) const {
+template <typename File>
+BookMetadataCache::TocEntry BookMetadataCache::readTocEntry(File& file) const {
   TocEntry entry;
-  serialization::readString(file, entry.title);
-  serialization::readString(file, entry.href);
-  serialization::readString(file, entry.anchor);
-  serialization::readPod(file, entry.level);
-  serialization::readPod(file, entry.spineIndex);
+  if (!recordScratch.readFrom(file)) {
+    Serial.printf("[%lu] [BMC] Bad TOC entry record\n", millis());
+    return entry;
+  }
+  recordScratch.str(entry.title);
+  recordScratch.str(entry.href);
+  recordScratch.str(entry.anchor);
+  recordScratch.pod(entry.level);
+  recordScratch.pod(entry.spineIndex);
   return entry;
 }
@@ -1,17 +1,25 @@
 #pragma once
 
+#include <BufferedFileWriter.h>
 #include <SDCardManager.h>
+#include <Serialization.h>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
+class ZipFile;
+
 class BookMetadataCache {
  public:
   struct BookMetadata {
     std::string title;
     std::string author;
     std::string language;
+    // Primary hyphenation subtag resolved from language at build time (e.g. "en"), so the
+    // section builder selects patterns without re-normalizing the BCP-47 tag per open
+    std::string hyphenationTag;
     std::string coverItemHref;
     std::string textReferenceHref;
   };
@@ -44,7 +52,9 @@ class BookMetadataCache {
 
  private:
   std::string cachePath;
-  size_t lutOffset;
+  // Fixed-width because it round-trips through book.bin as a uint32_t; a size_t member reads
+  // 8 bytes on a 64-bit host (env:native) and desyncs the stream
+  uint32_t lutOffset;
   uint16_t spineCount;
   uint16_t tocCount;
   bool loaded;
@@ -54,15 +64,27 @@ class BookMetadataCache {
   // Temp file handles during build
   FsFile spineFile;
   FsFile tocFile;
-
-  // Index for fast href→spineIndex lookup (used only for large EPUBs)
+  // Coalescing writers around the temp files while their build pass is emitting entry records;
+  // one short record per FsFile call is what makes the build passes card-latency bound. Flushed
+  // and reset by the matching end*Pass().
+  std::unique_ptr<BufferedFileWriter> spineWriter;
+  std::unique_ptr<BufferedFileWriter> tocWriter;
+
+  // Index for fast href→spineIndex lookup. Built for every book during the TOC
+  // pass and persisted into book.bin as a packed sorted array, so the read side
+  // resolves hrefs in O(log n) after one bulk read instead of rebuilding.
+#pragma pack(push, 1)
   struct SpineHrefIndexEntry {
     uint64_t hrefHash;  // FNV-1a 64-bit hash
     uint16_t hrefLen;   // length for collision reduction
     int16_t spineIndex;
-  };
+  };  // 12 bytes on disk
+#pragma pack(pop)
   std::vector<SpineHrefIndexEntry> spineHrefIndex;
   bool useSpineHrefIndex = false;
+  // Cumulative-size column restored by load() so per-page progress math stays in RAM
+  std::vector<uint32_t> cumulativeSizes;
+  size_t spineHrefIndexOffset = 0;  // file offset of the persisted index, set by load()
 
   static constexpr uint16_t LARGE_SPINE_THRESHOLD = 400;
 
@@ -76,10 +98,21 @@ class BookMetadataCache {
     return hash;
   }
 
-  uint32_t writeSpineEntry(FsFile& file, const SpineEntry& entry) const;
-  uint32_t writeTocEntry(FsFile& file, const TocEntry& entry) const;
-  SpineEntry readSpineEntry(FsFile& file) const;
-  TocEntry readTocEntry(FsFile& file) const;
+  // Templated over the sink so the build passes can write through a BufferedFileWriter; like
+  // the readers below, both instantiations live in the .cpp
+  template <typename File>
+  uint32_t writeSpineEntry(File& file, const SpineEntry& entry) const;
+  template <typename File>
+  uint32_t writeTocEntry(File& file, const TocEntry& entry) const;
+  // Templated over the source so the sequential build loops can read through a BufferedFileReader
+  // window while the random-access getters stay on the bare FsFile; both instantiations live in
+  // the .cpp
+  template <typename File>
+  SpineEntry readSpineEntry(File& file) const;
+  template <typename File>
+  TocEntry readTocEntry(File& file) const;
+  // Reused across entry reads so the loops over thousands of entries don't reallocate per record
+  mutable serialization::RecordView recordScratch;
 
  public:
   BookMetadata coreMetadata;
@@ -99,13 +132,28 @@ class BookMetadataCache {
   bool endWrite();
   bool cleanupTmpFiles() const;
 
-  // Post-processing to update mappings and sizes
-  bool buildBookBin(const std::string& epubPath, const BookMetadata& metadata);
+  // Post-processing to update mappings and sizes. Takes the book's shared ZipFile so size
+  // lookups reuse its restored central-directory index instead of re-walking the archive.
+  bool buildBookBin(ZipFile& zip, const BookMetadata& metadata);
 
   // Reading phase (read mode)
   bool load();
   SpineEntry getSpineEntry(int index);
   TocEntry getTocEntry(int index);
+  // Bulk-reads a contiguous window of TOC entries: one LUT lookup for the window start,
+  // then a single buffered sequential read over the records (they are contiguous in file
+  // order). The chapter list virtualizes over this instead of seeking per row.
+  bool getTocEntries(int startIndex, int count, std::vector<TocEntry>& out);
+  // O(log n) href→spineIndex lookup against the persisted hash index; the index
+  // is bulk-read from book.bin on first use. Returns -1 when not found.
+  int16_t getSpineIndexForHref(const std::string& href);
+  // Cumulative inflated size up to and including spineIndex, served from RAM
+  size_t getCumulativeSize(int spineIndex) const {
+    if (spineIndex < 0 || spineIndex >= static_cast<int>(cumulativeSizes.size())) {
+      return 0;
+    }
+    return cumulativeSizes[spineIndex];
+  }
   int getSpineCount() const { return spineCount; }
   int getTocCount() const { return tocCount; }
   bool isLoaded() const { return loaded; }
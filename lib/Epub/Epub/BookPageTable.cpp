@@ -0,0 +1,80 @@
+#include "BookPageTable.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+namespace {
+constexpr uint8_t PAGE_TABLE_VERSION = 1;
+}  // namespace
+
+void BookPageTable::load(const std::string& path, const int spineCount) {
+  filePath = path;
+  pageCounts.assign(spineCount, 0);
+
+  FsFile file;
+  if (!SdMan.openFileForRead("BPT", filePath, file)) {
+    return;
+  }
+  uint8_t version;
+  uint16_t count;
+  serialization::readPod(file, version);
+  serialization::readPod(file, count);
+  if (version != PAGE_TABLE_VERSION || count != spineCount) {
+    file.close();
+    return;
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    serialization::readPod(file, pageCounts[i]);
+  }
+  file.close();
+}
+
+bool BookPageTable::saveToFile() const {
+  FsFile file;
+  if (!SdMan.openFileForWrite("BPT", filePath, file)) {
+    return false;
+  }
+  serialization::writePod(file, PAGE_TABLE_VERSION);
+  serialization::writePod(file, static_cast<uint16_t>(pageCounts.size()));
+  for (const uint16_t pages : pageCounts) {
+    serialization::writePod(file, pages);
+  }
+  file.close();
+  return true;
+}
+
+bool BookPageTable::setPageCount(const int spineIndex, const uint16_t pageCount) {
+  if (spineIndex < 0 || spineIndex >= static_cast<int>(pageCounts.size()) ||
+      pageCounts[spineIndex] == pageCount) {
+    return false;
+  }
+  pageCounts[spineIndex] = pageCount;
+  // Checkpoint every entry: the table is a few hundred bytes and this lets an
+  // interrupted background pagination pass pick up where it stopped
+  if (!saveToFile()) {
+    Serial.printf("[%lu] [BPT] Failed to persist page table\n", millis());
+  }
+  return true;
+}
+
+bool BookPageTable::isComplete() const { return isLoaded() && firstUnknownSpine() == -1; }
+
+int BookPageTable::firstUnknownSpine() const {
+  for (size_t i = 0; i < pageCounts.size(); i++) {
+    if (pageCounts[i] == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+uint32_t BookPageTable::pagesBefore(const int spineIndex) const {
+  uint32_t total = 0;
+  for (int i = 0; i < spineIndex && i < static_cast<int>(pageCounts.size()); i++) {
+    total += pageCounts[i];
+  }
+  return total;
+}
+
+uint32_t BookPageTable::totalPages() const { return pagesBefore(static_cast<int>(pageCounts.size())); }
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Per-layout table of page counts for every spine item, persisted alongside the
+ * section files so the status bar can show "page X of Y" for the whole book
+ * instead of a byte-size interpolation. Entries start unknown and are filled in
+ * as chapters are paginated (on demand or by the idle pre-paginate task); the
+ * file is rewritten after every new entry, so an interrupted background pass
+ * resumes where it left off. Page counts are layout-specific, which is why the
+ * table lives in the layout namespace and is evicted together with it.
+ */
+class BookPageTable {
+  std::string filePath;
+  // Page count per spine index; 0 means not yet paginated (a built chapter always has >= 1 page)
+  std::vector<uint16_t> pageCounts;
+
+  bool saveToFile() const;
+
+ public:
+  // Read the table for the given layout namespace, or start an empty one when the
+  // file is missing, stale, or was written for a different spine count
+  void load(const std::string& path, int spineCount);
+  // Record a chapter's page count; persists and returns true when this changes the table
+  bool setPageCount(int spineIndex, uint16_t pageCount);
+  bool isLoaded() const { return !pageCounts.empty(); }
+  // True once every spine item has a known page count
+  bool isComplete() const;
+  // Lowest spine index still unpaginated, or -1 when the table is complete
+  int firstUnknownSpine() const;
+  // Total pages across chapters before the given spine index; only meaningful when complete
+  uint32_t pagesBefore(int spineIndex) const;
+  uint32_t totalPages() const;
+};
@@ -1,13 +1,26 @@
 #include "Page.h"
 
+#include <BufferedFileReader.h>
+#include <GfxRenderer.h>
 #include <HardwareSerial.h>
 #include <Serialization.h>
+#include <Utf8.h>
+
+#include <memory>
+
+namespace {
+// Guard against corrupt records (mirrors the TextBlock word count cap)
+constexpr uint16_t MAX_GLYPHS_PER_RUN = 1000;
+// Upper bound on a deserialized image's packed pixel bytes; the builder caps images well below
+// this, so anything larger is a corrupt record
+constexpr uint32_t MAX_IMAGE_BYTES = 64 * 1024;
+}  // namespace
 
 void PageLine::render(GfxRenderer& renderer, const int fontId, const int xOffset, const int yOffset) {
   block->render(renderer, fontId, xPos + xOffset, yPos + yOffset);
 }
 
-bool PageLine::serialize(FsFile& file) {
+bool PageLine::serialize(Print& file) {
   serialization::writePod(file, xPos);
   serialization::writePod(file, yPos);
 
@@ -15,14 +28,133 @@ bool PageLine::serialize(FsFile& file) {
   return block->serialize(file);
 }
 
-std::unique_ptr<PageLine> PageLine::deserialize(FsFile& file) {
+bool PageLine::compile(PageElementList& out, const GfxRenderer& renderer, const int fontId) {
+  // One glyph run per word: word x positions were resolved at layout time, and within a word
+  // successive glyph advances equal the shaped offsets, so codepoints are all a run needs. Each
+  // word is measured once here so its run persists a bounding box for hit-testing.
+  block->forEachWord(
+      [this, &out, &renderer, fontId](const std::string& word, const uint16_t wordX, const EpdFontFamily::Style style) {
+        GlyphRunCps cps;
+        utf8ForEachCodepoint(word.c_str(), [&cps](const uint32_t cp, uint32_t) { cps.push_back(cp); });
+        if (cps.empty()) {
+          return;
+        }
+        const auto width = static_cast<uint16_t>(renderer.getTextWidth(fontId, word.c_str(), style));
+        out.push_back(std::allocate_shared<PageGlyphRun>(ParseArenaAllocator<PageGlyphRun>(), std::move(cps), style,
+                                                         width, static_cast<int16_t>(xPos + wordX), yPos));
+      });
+  return true;
+}
+
+void PageLine::forEachWord(const std::function<void(const std::string&)>& visitor) const {
+  block->forEachWord(
+      [&visitor](const std::string& word, const uint16_t, const EpdFontFamily::Style) { visitor(word); });
+}
+
+void PageGlyphRun::render(GfxRenderer& renderer, const int fontId, const int xOffset, const int yOffset) {
+  renderer.drawGlyphs(fontId, xPos + xOffset, yPos + yOffset, cps.data(), cps.size(), true, style);
+}
+
+bool PageGlyphRun::serialize(Print& file) {
+  serialization::writePod(file, xPos);
+  serialization::writePod(file, yPos);
+  serialization::writePod(file, width);
+  serialization::writePod(file, style);
+  serialization::writePod(file, static_cast<uint16_t>(cps.size()));
+  // The codepoint array is contiguous and its disk layout matches RAM; one bulk write
+  file.write(reinterpret_cast<const uint8_t*>(cps.data()), cps.size() * sizeof(uint32_t));
+  return true;
+}
+
+bool PageGlyphRun::hitTestWord(const int x, const int y, const int lineHeight, std::string& outWord) const {
+  if (x < xPos || x >= xPos + width || y < yPos || y >= yPos + lineHeight) {
+    return false;
+  }
+  outWord.clear();
+  for (const uint32_t cp : cps) {
+    utf8AppendCodepoint(outWord, cp);
+  }
+  return true;
+}
+
+std::shared_ptr<PageGlyphRun> PageGlyphRun::deserialize(BufferedFileReader& in) {
+  int16_t xPos;
+  int16_t yPos;
+  uint16_t width;
+  EpdFontFamily::Style style;
+  uint16_t count;
+  in.pod(xPos);
+  in.pod(yPos);
+  in.pod(width);
+  in.pod(style);
+  in.pod(count);
+
+  if (count > MAX_GLYPHS_PER_RUN) {
+    Serial.printf("[%lu] [PGE] Deserialization failed: glyph count %u exceeds maximum\n", millis(), count);
+    return nullptr;
+  }
+
+  GlyphRunCps cps(count);
+  // One bulk read straight into the array instead of one call per glyph
+  const size_t cpsBytes = count * sizeof(uint32_t);
+  if (in.read(reinterpret_cast<uint8_t*>(cps.data()), cpsBytes) != static_cast<int>(cpsBytes)) {
+    Serial.printf("[%lu] [PGE] Deserialization failed: truncated glyph run\n", millis());
+    return nullptr;
+  }
+  return std::allocate_shared<PageGlyphRun>(ParseArenaAllocator<PageGlyphRun>(), std::move(cps), style, width, xPos,
+                                            yPos);
+}
+
+std::shared_ptr<PageLine> PageLine::deserialize(BufferedFileReader& in) {
   int16_t xPos;
   int16_t yPos;
-  serialization::readPod(file, xPos);
-  serialization::readPod(file, yPos);
+  in.pod(xPos);
+  in.pod(yPos);
 
-  auto tb = TextBlock::deserialize(file);
-  return std::unique_ptr<PageLine>(new PageLine(std::move(tb), xPos, yPos));
+  auto tb = TextBlock::deserialize(in);
+  return std::allocate_shared<PageLine>(ParseArenaAllocator<PageLine>(), std::move(tb), xPos, yPos);
+}
+
+void PageImage::render(GfxRenderer& renderer, const int fontId, const int xOffset, const int yOffset) {
+  const uint16_t stride = bytesPerRow(width);
+  for (uint16_t y = 0; y < height; y++) {
+    renderer.drawPacked2BitRow(xPos + xOffset, yPos + yOffset + y, rows.data() + static_cast<size_t>(y) * stride,
+                               width);
+  }
+}
+
+bool PageImage::serialize(Print& file) {
+  serialization::writePod(file, xPos);
+  serialization::writePod(file, yPos);
+  serialization::writePod(file, width);
+  serialization::writePod(file, height);
+  // Rows are contiguous and the disk layout matches RAM; one bulk write
+  file.write(rows.data(), rows.size());
+  return true;
+}
+
+std::shared_ptr<PageImage> PageImage::deserialize(BufferedFileReader& in) {
+  int16_t xPos;
+  int16_t yPos;
+  uint16_t width;
+  uint16_t height;
+  in.pod(xPos);
+  in.pod(yPos);
+  in.pod(width);
+  in.pod(height);
+
+  const size_t rowBytes = static_cast<size_t>(bytesPerRow(width)) * height;
+  if (width == 0 || height == 0 || rowBytes > MAX_IMAGE_BYTES) {
+    Serial.printf("[%lu] [PGE] Deserialization failed: image %ux%u exceeds limits\n", millis(), width, height);
+    return nullptr;
+  }
+
+  ImageRowBytes rows(rowBytes);
+  if (in.read(rows.data(), rowBytes) != static_cast<int>(rowBytes)) {
+    Serial.printf("[%lu] [PGE] Deserialization failed: truncated image\n", millis());
+    return nullptr;
+  }
+  return std::allocate_shared<PageImage>(ParseArenaAllocator<PageImage>(), std::move(rows), width, height, xPos, yPos);
 }
 
 void Page::render(GfxRenderer& renderer, const int fontId, const int xOffset, const int yOffset) const {
@@ -31,13 +163,38 @@ void Page::render(GfxRenderer& renderer, const int fontId, const int xOffset, co
   }
 }
 
-bool Page::serialize(FsFile& file) const {
+void Page::forEachWord(const std::function<void(const std::string&)>& visitor) const {
+  for (const auto& element : elements) {
+    element->forEachWord(visitor);
+  }
+}
+
+void Page::compile(const GfxRenderer& renderer, const int fontId) {
+  PageElementList compiled;
+  compiled.reserve(elements.size());
+  for (auto& element : elements) {
+    if (!element->compile(compiled, renderer, fontId)) {
+      compiled.push_back(element);
+    }
+  }
+  elements = std::move(compiled);
+}
+
+bool Page::findWordAt(const int x, const int y, const int lineHeight, std::string& outWord) const {
+  for (const auto& element : elements) {
+    if (element->hitTestWord(x, y, lineHeight, outWord)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Page::serialize(Print& file) const {
   const uint16_t count = elements.size();
   serialization::writePod(file, count);
 
   for (const auto& el : elements) {
-    // Only PageLine exists currently
-    serialization::writePod(file, static_cast<uint8_t>(TAG_PageLine));
+    serialization::writePod(file, static_cast<uint8_t>(el->tag()));
     if (!el->serialize(file)) {
       return false;
     }
@@ -46,19 +203,31 @@ bool Page::serialize(FsFile& file) const {
   return true;
 }
 
-std::unique_ptr<Page> Page::deserialize(FsFile& file) {
+std::unique_ptr<Page> Page::deserialize(BufferedFileReader& in) {
   auto page = std::unique_ptr<Page>(new Page());
 
   uint16_t count;
-  serialization::readPod(file, count);
+  in.pod(count);
 
   for (uint16_t i = 0; i < count; i++) {
     uint8_t tag;
-    serialization::readPod(file, tag);
+    in.pod(tag);
 
     if (tag == TAG_PageLine) {
-      auto pl = PageLine::deserialize(file);
+      auto pl = PageLine::deserialize(in);
       page->elements.push_back(std::move(pl));
+    } else if (tag == TAG_PageGlyphRun) {
+      auto run = PageGlyphRun::deserialize(in);
+      if (!run) {
+        return nullptr;
+      }
+      page->elements.push_back(std::move(run));
+    } else if (tag == TAG_PageImage) {
+      auto image = PageImage::deserialize(in);
+      if (!image) {
+        return nullptr;
+      }
+      page->elements.push_back(std::move(image));
     } else {
       Serial.printf("[%lu] [PGE] Deserialization failed: Unknown tag %u\n", millis(), tag);
       return nullptr;
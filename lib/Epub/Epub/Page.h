@@ -4,12 +4,26 @@
 #include <utility>
 #include <vector>
 
+#include "ParseArena.h"
 #include "blocks/TextBlock.h"
 
+class BufferedFileReader;
+
 enum PageElementTag : uint8_t {
   TAG_PageLine = 1,
+  TAG_PageGlyphRun = 2,
+  TAG_PageImage = 3,
 };
 
+class PageElement;
+
+// Page storage is routed through ParseArenaAllocator: element objects, their shared_ptr control
+// blocks and the vectors below come out of whichever arena is active (the reader keeps one
+// recycled across page turns), falling back to the plain heap when none is
+using PageElementList = std::vector<std::shared_ptr<PageElement>, ParseArenaAllocator<std::shared_ptr<PageElement>>>;
+using GlyphRunCps = std::vector<uint32_t, ParseArenaAllocator<uint32_t>>;
+using ImageRowBytes = std::vector<uint8_t, ParseArenaAllocator<uint8_t>>;
+
 // represents something that has been added to a page
 class PageElement {
  public:
@@ -18,7 +32,17 @@ class PageElement {
   explicit PageElement(const int16_t xPos, const int16_t yPos) : xPos(xPos), yPos(yPos) {}
   virtual ~PageElement() = default;
   virtual void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) = 0;
-  virtual bool serialize(FsFile& file) = 0;
+  virtual PageElementTag tag() const = 0;
+  virtual bool serialize(Print& file) = 0;
+  // Replace this element with compiled equivalents in `out`; returns false when the element
+  // doesn't compile (the caller keeps it as-is). The renderer measures word widths so compiled
+  // runs carry their bounding box.
+  virtual bool compile(PageElementList& out, const GfxRenderer& renderer, int fontId) { return false; }
+  // Visit the element's words, if it has any pre-compile text (used by the search indexer)
+  virtual void forEachWord(const std::function<void(const std::string&)>& visitor) const {}
+  // Hit-test a point against this element's word box, filling `outWord` with the UTF-8 word on a
+  // hit. Only compiled glyph runs carry boxes; other elements report a miss.
+  virtual bool hitTestWord(int x, int y, int lineHeight, std::string& outWord) const { return false; }
 };
 
 // a line from a block element
@@ -29,15 +53,72 @@ class PageLine final : public PageElement {
   PageLine(std::shared_ptr<TextBlock> block, const int16_t xPos, const int16_t yPos)
       : PageElement(xPos, yPos), block(std::move(block)) {}
   void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) override;
-  bool serialize(FsFile& file) override;
-  static std::unique_ptr<PageLine> deserialize(FsFile& file);
+  PageElementTag tag() const override { return TAG_PageLine; }
+  bool serialize(Print& file) override;
+  bool compile(PageElementList& out, const GfxRenderer& renderer, int fontId) override;
+  void forEachWord(const std::function<void(const std::string&)>& visitor) const override;
+  static std::shared_ptr<PageLine> deserialize(BufferedFileReader& in);
+};
+
+// A word compiled to codepoints with the pen position already resolved at section build time, so
+// rendering it is glyph lookup + blit with no UTF-8 decoding or measurement passes. The measured
+// word width rides along in the record, giving each run a bounding box (xPos, yPos, width) that
+// selection UIs can hit-test straight from cached data.
+class PageGlyphRun final : public PageElement {
+  GlyphRunCps cps;
+  EpdFontFamily::Style style;
+  uint16_t width;
+
+ public:
+  PageGlyphRun(GlyphRunCps cps, const EpdFontFamily::Style style, const uint16_t width, const int16_t xPos,
+               const int16_t yPos)
+      : PageElement(xPos, yPos), cps(std::move(cps)), style(style), width(width) {}
+  uint16_t getWidth() const { return width; }
+  void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) override;
+  PageElementTag tag() const override { return TAG_PageGlyphRun; }
+  bool serialize(Print& file) override;
+  bool hitTestWord(int x, int y, int lineHeight, std::string& outWord) const override;
+  static std::shared_ptr<PageGlyphRun> deserialize(BufferedFileReader& in);
+};
+
+// An inline chapter image, pre-scaled and dithered at section build time and stored as packed
+// 2-bit rows (the JpegToBmpConverter sink layout), so rendering is a row blit with no decoding
+class PageImage final : public PageElement {
+  uint16_t width;
+  uint16_t height;
+  ImageRowBytes rows;  // height * bytesPerRow(width) bytes, top-down
+
+ public:
+  PageImage(ImageRowBytes rows, const uint16_t width, const uint16_t height, const int16_t xPos, const int16_t yPos)
+      : PageElement(xPos, yPos), width(width), height(height), rows(std::move(rows)) {}
+  uint16_t getWidth() const { return width; }
+  uint16_t getHeight() const { return height; }
+  // Packed bytes per row at 2 bits per pixel
+  static uint16_t bytesPerRow(const uint16_t width) { return (width + 3) / 4; }
+  void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) override;
+  PageElementTag tag() const override { return TAG_PageImage; }
+  bool serialize(Print& file) override;
+  static std::shared_ptr<PageImage> deserialize(BufferedFileReader& in);
 };
 
 class Page {
  public:
   // the list of block index and line numbers on this page
-  std::vector<std::shared_ptr<PageElement>> elements;
+  PageElementList elements;
   void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) const;
-  bool serialize(FsFile& file) const;
-  static std::unique_ptr<Page> deserialize(FsFile& file);
+  // Compile elements to pre-positioned glyph runs; called once per page at section build time so
+  // the render path after loadPageFromSectionFile() does zero layout work. The renderer measures
+  // each word once so the runs persist their bounding boxes.
+  void compile(const GfxRenderer& renderer, int fontId);
+  // Resolve a screen point (content coordinates, pre-margin) to the word whose compiled box
+  // contains it; the caller supplies the font line height for the vertical extent. Returns false
+  // when no word sits under the point.
+  bool findWordAt(int x, int y, int lineHeight, std::string& outWord) const;
+  // Visit every word on the page in reading order. Only meaningful before compile(), while the
+  // lines still carry their word strings.
+  void forEachWord(const std::function<void(const std::string&)>& visitor) const;
+  bool serialize(Print& file) const;
+  // Decodes from the section loader's buffered window; small field reads hit RAM instead of
+  // issuing one SdFat call each
+  static std::unique_ptr<Page> deserialize(BufferedFileReader& in);
 };
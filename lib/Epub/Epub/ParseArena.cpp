@@ -0,0 +1,89 @@
+#include "ParseArena.h"
+
+#include <cstdlib>
+
+namespace {
+// Keep allocations pointer-aligned; nodes hold pointers and small PODs only
+size_t roundUp8(const size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+}  // namespace
+
+ParseArena* ParseArena::active = nullptr;
+
+ParseArena::~ParseArena() {
+  Chunk* chunk = chunks;
+  while (chunk) {
+    Chunk* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+}
+
+void* ParseArena::allocFromChunks(const size_t totalSize) {
+  if (!chunks || chunks->used + totalSize > chunks->capacity) {
+    const size_t payload = totalSize > CHUNK_PAYLOAD_SIZE ? totalSize : CHUNK_PAYLOAD_SIZE;
+    auto* chunk = static_cast<Chunk*>(malloc(sizeof(Chunk) + payload));
+    if (!chunk) {
+      // Out of chunk memory; let the caller fall back to the plain heap
+      return nullptr;
+    }
+    chunk->next = chunks;
+    chunk->used = 0;
+    chunk->capacity = payload;
+    chunks = chunk;
+  }
+  auto* base = reinterpret_cast<uint8_t*>(chunks + 1) + chunks->used;
+  chunks->used += totalSize;
+  return base;
+}
+
+void* ParseArena::alloc(const size_t size) {
+  const size_t totalSize = HEADER_SIZE + roundUp8(size);
+
+  // Reuse a freed node of the same size if one is available
+  for (int i = 0; i < FREE_SLOTS; i++) {
+    if (freeSizes[i] == totalSize && freeHeads[i]) {
+      auto* base = reinterpret_cast<uint8_t*>(freeHeads[i]);
+      freeHeads[i] = freeHeads[i]->next;
+      *reinterpret_cast<ParseArena**>(base) = this;
+      return base + HEADER_SIZE;
+    }
+  }
+
+  uint8_t* base = static_cast<uint8_t*>(allocFromChunks(totalSize));
+  if (!base) {
+    return fallbackAlloc(size);
+  }
+  *reinterpret_cast<ParseArena**>(base) = this;
+  return base + HEADER_SIZE;
+}
+
+void ParseArena::release(void* ptr, const size_t size) {
+  auto* base = static_cast<uint8_t*>(ptr) - HEADER_SIZE;
+  ParseArena* owner = *reinterpret_cast<ParseArena**>(base);
+  if (!owner) {
+    free(base);
+    return;
+  }
+
+  const size_t totalSize = HEADER_SIZE + roundUp8(size);
+  for (int i = 0; i < FREE_SLOTS; i++) {
+    if (owner->freeSizes[i] == totalSize || owner->freeSizes[i] == 0) {
+      owner->freeSizes[i] = totalSize;
+      auto* node = reinterpret_cast<FreeNode*>(base);
+      node->next = owner->freeHeads[i];
+      owner->freeHeads[i] = node;
+      return;
+    }
+  }
+  // More distinct sizes than slots: the memory stays in the arena until the
+  // arena itself is destroyed
+}
+
+void* ParseArena::fallbackAlloc(const size_t size) {
+  auto* base = static_cast<uint8_t*>(malloc(HEADER_SIZE + roundUp8(size)));
+  if (!base) {
+    return nullptr;
+  }
+  *reinterpret_cast<ParseArena**>(base) = nullptr;
+  return base + HEADER_SIZE;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+
+// Bump allocator for the chapter parse pipeline. Building a section means
+// churning through six small list-node allocations per word, which leaves the
+// heap fragmented enough that large reads can fail even with plenty of total
+// free memory. The arena hands those nodes out of big chunks instead: freed
+// nodes go onto per-size free lists (the live set is only ever roughly one
+// paragraph plus one page), and everything is returned to the heap wholesale
+// when the arena is destroyed at the end of Section::createSectionFile().
+//
+// Each allocation carries a header naming the owning arena (or nullptr for the
+// malloc fallback), so containers created outside a parse - e.g. TextBlocks
+// deserialized from a section file - use the same allocator type and are freed
+// correctly either way.
+class ParseArena {
+  struct Chunk {
+    Chunk* next;
+    size_t used;
+    size_t capacity;
+    // payload follows the struct
+  };
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  static constexpr size_t CHUNK_PAYLOAD_SIZE = 8 * 1024;
+  static constexpr size_t HEADER_SIZE = 8;  // owning arena pointer, padded for alignment
+  static constexpr int FREE_SLOTS = 8;
+
+  Chunk* chunks = nullptr;
+  // Exact-size free lists; parse nodes come in only a handful of sizes
+  FreeNode* freeHeads[FREE_SLOTS] = {};
+  size_t freeSizes[FREE_SLOTS] = {};
+
+  static ParseArena* active;
+
+  void* allocFromChunks(size_t totalSize);
+
+ public:
+  ParseArena() = default;
+  ~ParseArena();
+
+  ParseArena(const ParseArena&) = delete;
+  ParseArena& operator=(const ParseArena&) = delete;
+
+  // Allocate `size` bytes from this arena (header added internally)
+  void* alloc(size_t size);
+
+  // Return an allocation made through ParseArenaAllocator to its owner - the
+  // arena named in the header, or the heap for fallback allocations
+  static void release(void* ptr, size_t size);
+
+  // Heap allocation with the same header layout, used when no arena is active
+  static void* fallbackAlloc(size_t size);
+
+  static ParseArena* current() { return active; }
+
+  // Routes ParseArenaAllocator allocations to `arena` while in scope
+  class Scope {
+    ParseArena* previous;
+
+   public:
+    explicit Scope(ParseArena& arena) : previous(active) { active = &arena; }
+    ~Scope() { active = previous; }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+};
+
+// Minimal allocator front-end; all instances are interchangeable, which keeps
+// std::list::splice between ParsedText and TextBlock lists legal
+template <typename T>
+struct ParseArenaAllocator {
+  using value_type = T;
+
+  ParseArenaAllocator() = default;
+  template <typename U>
+  ParseArenaAllocator(const ParseArenaAllocator<U>&) {}  // NOLINT(google-explicit-constructor)
+
+  T* allocate(size_t n) {
+    const size_t size = n * sizeof(T);
+    if (ParseArena* arena = ParseArena::current()) {
+      return static_cast<T*>(arena->alloc(size));
+    }
+    return static_cast<T*>(ParseArena::fallbackAlloc(size));
+  }
+
+  void deallocate(T* ptr, size_t n) { ParseArena::release(ptr, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const ParseArenaAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const ParseArenaAllocator<U>&) const {
+    return false;
+  }
+};
+
+// List type used for the parse-time word/style/position chains
+template <typename T>
+using ParseList = std::list<T, ParseArenaAllocator<T>>;
@@ -12,6 +12,9 @@
 #include "hyphenation/Hyphenator.h"
 
 constexpr int MAX_COST = std::numeric_limits<int>::max();
+// Flat badness added per hyphenated line ending in the optimal-fit breaker, in the same units as
+// squared slack; 50px of slack is roughly where a hyphen starts to read better than a loose line
+constexpr int HYPHEN_COST = 50 * 50;
 
 namespace {
 
@@ -29,11 +32,90 @@ void stripSoftHyphensInPlace(std::string& word) {
   }
 }
 
+// Memoizes rendered word widths across text blocks so common words ("the", "and") are measured
+// once per section build instead of once per occurrence. Open addressing with a short probe run;
+// entries are keyed by an FNV-1a hash of the word bytes, style and font id and compared by
+// hash + length (the same convention the spine href index uses), so no word bytes are stored.
+class WordWidthCache {
+  struct Slot {
+    uint64_t hash = 0;
+    uint16_t width = 0;
+    uint8_t len = 0;
+    bool used = false;
+  };
+
+  static constexpr size_t SLOT_COUNT = 512;
+  static constexpr size_t PROBE_DEPTH = 8;
+
+  Slot slots[SLOT_COUNT] = {};
+
+ public:
+  static uint64_t keyHash(const std::string& word, const EpdFontFamily::Style style, const int fontId) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : word) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ull;
+    }
+    hash ^= static_cast<uint8_t>(style);
+    hash *= 1099511628211ull;
+    hash ^= static_cast<uint32_t>(fontId);
+    hash *= 1099511628211ull;
+    return hash;
+  }
+
+  bool lookup(const uint64_t hash, const size_t len, uint16_t* width) const {
+    for (size_t i = 0; i < PROBE_DEPTH; i++) {
+      const Slot& slot = slots[(hash + i) % SLOT_COUNT];
+      if (!slot.used) {
+        return false;
+      }
+      if (slot.hash == hash && slot.len == len) {
+        *width = slot.width;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void insert(const uint64_t hash, const size_t len, const uint16_t width) {
+    // Prefer an empty slot in the probe run; otherwise overwrite the first one. Stale entries
+    // just cost a re-measure later, so eviction can stay this simple.
+    Slot* target = nullptr;
+    for (size_t i = 0; i < PROBE_DEPTH; i++) {
+      Slot& slot = slots[(hash + i) % SLOT_COUNT];
+      if (!slot.used) {
+        target = &slot;
+        break;
+      }
+      if (!target) {
+        target = &slot;
+      }
+    }
+    target->hash = hash;
+    target->width = width;
+    target->len = static_cast<uint8_t>(len);
+    target->used = true;
+  }
+};
+
+WordWidthCache wordWidthCache;
+
 // Returns the rendered width for a word while ignoring soft hyphen glyphs and optionally appending a visible hyphen.
 uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const std::string& word,
                           const EpdFontFamily::Style style, const bool appendHyphen = false) {
   const bool hasSoftHyphen = containsSoftHyphen(word);
   if (!hasSoftHyphen && !appendHyphen) {
+    // Plain words (the overwhelmingly common case) go through the memo table
+    if (word.size() <= UINT8_MAX) {
+      const uint64_t hash = WordWidthCache::keyHash(word, style, fontId);
+      uint16_t width;
+      if (wordWidthCache.lookup(hash, word.size(), &width)) {
+        return width;
+      }
+      width = renderer.getTextWidth(fontId, word.c_str(), style);
+      wordWidthCache.insert(hash, word.size(), width);
+      return width;
+    }
     return renderer.getTextWidth(fontId, word.c_str(), style);
   }
 
@@ -72,9 +154,15 @@ void ParsedText::layoutAndExtractLines(const GfxRenderer& renderer, const int fo
   auto wordWidths = calculateWordWidths(renderer, fontId);
   std::vector<size_t> lineBreakIndices;
   if (hyphenationEnabled) {
-    // Use greedy layout that can split words mid-loop when a hyphenated prefix fits.
-    lineBreakIndices = computeHyphenatedLineBreaks(renderer, fontId, pageWidth, spaceWidth, wordWidths);
+    if (optimalLineBreaks) {
+      // Optimal fit over hyphenation points; pricier, but this only ever runs in the section build
+      lineBreakIndices = computeOptimalHyphenatedLineBreaks(renderer, fontId, pageWidth, spaceWidth, wordWidths);
+    } else {
+      // Use greedy layout that can split words mid-loop when a hyphenated prefix fits.
+      lineBreakIndices = computeHyphenatedLineBreaks(renderer, fontId, pageWidth, spaceWidth, wordWidths);
+    }
   } else {
+    // Already optimal fit: DP over whole words minimising squared slack
     lineBreakIndices = computeLineBreaks(renderer, fontId, pageWidth, spaceWidth, wordWidths);
   }
   const size_t lineCount = includeLastLine ? lineBreakIndices.size() : lineBreakIndices.size() - 1;
@@ -255,6 +343,154 @@ std::vector<size_t> ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& r
   return lineBreakIndices;
 }
 
+// Optimal-fit variant of the hyphenated breaker: a Knuth-Plass style dynamic programme over every
+// legal breakpoint (word boundaries plus hyphenation points) minimising squared end-of-line slack,
+// with a flat penalty per hyphenated ending so hyphens are only spent where they buy real evenness.
+// Quadratic-ish over a denser candidate set than computeLineBreaks, which is why it only runs in
+// the cached section build.
+std::vector<size_t> ParsedText::computeOptimalHyphenatedLineBreaks(const GfxRenderer& renderer, const int fontId,
+                                                                   const int pageWidth, const int spaceWidth,
+                                                                   std::vector<uint16_t>& wordWidths) {
+  if (words.empty()) {
+    return {};
+  }
+
+  // Ensure any word that would overflow even as the first entry on a line is split using fallback hyphenation.
+  for (size_t i = 0; i < wordWidths.size(); ++i) {
+    while (wordWidths[i] > pageWidth) {
+      if (!hyphenateWordAtIndex(i, pageWidth, renderer, fontId, wordWidths, /*allowFallbackBreaks=*/true)) {
+        break;
+      }
+    }
+  }
+
+  // A break atom is the span of a word up to the next legal breakpoint; every atom may end a line,
+  // and mid-word atoms cost a hyphen when they do. Advance widths are additive in these fonts, so
+  // a line's width is the sum of its atom widths plus inter-word spaces.
+  struct BreakAtom {
+    uint32_t wordIndex;    // index into words after the oversize pre-split above
+    uint16_t width;        // rendered width of this span
+    uint16_t hyphenExtra;  // extra advance when a line ends here mid-word
+    uint16_t byteOffset;   // breakpoint within the word after this span (0 at word end)
+    bool needsHyphen;      // breakpoint requires an inserted '-'
+    bool wordEnd;          // span ends the word; breaking here costs no hyphen
+  };
+
+  std::vector<BreakAtom> atoms;
+  atoms.reserve(wordWidths.size());
+  {
+    constexpr size_t MAX_BREAK_CANDIDATES = 24;
+    Hyphenator::BreakInfo breakInfos[MAX_BREAK_CANDIDATES];
+    size_t wordIndex = 0;
+    auto styleIt = wordStyles.begin();
+    for (auto wordIt = words.begin(); wordIt != words.end(); ++wordIt, ++styleIt, ++wordIndex) {
+      const std::string& word = *wordIt;
+      const size_t breakCount = Hyphenator::breakOffsetsInto(word, false, breakInfos, MAX_BREAK_CANDIDATES);
+      const uint16_t hyphenWidth =
+          breakCount > 0 ? static_cast<uint16_t>(renderer.getTextWidth(fontId, "-", *styleIt)) : 0;
+      size_t prev = 0;
+      for (size_t breakIdx = 0; breakIdx < breakCount; ++breakIdx) {
+        const auto& info = breakInfos[breakIdx];
+        if (info.byteOffset <= prev || info.byteOffset >= word.size()) {
+          continue;
+        }
+        const uint16_t width = measureWordWidth(renderer, fontId, word.substr(prev, info.byteOffset - prev), *styleIt);
+        atoms.push_back({static_cast<uint32_t>(wordIndex), width,
+                         static_cast<uint16_t>(info.requiresInsertedHyphen ? hyphenWidth : 0),
+                         static_cast<uint16_t>(info.byteOffset), info.requiresInsertedHyphen, false});
+        prev = info.byteOffset;
+      }
+      const uint16_t tailWidth =
+          prev == 0 ? wordWidths[wordIndex] : measureWordWidth(renderer, fontId, word.substr(prev), *styleIt);
+      atoms.push_back({static_cast<uint32_t>(wordIndex), tailWidth, 0, 0, false, true});
+    }
+  }
+
+  // Same backwards DP shape as computeLineBreaks, over atoms instead of whole words
+  const size_t atomCount = atoms.size();
+  std::vector<int> dp(atomCount);
+  std::vector<size_t> ans(atomCount);
+
+  dp[atomCount - 1] = 0;
+  ans[atomCount - 1] = atomCount - 1;
+
+  for (int i = static_cast<int>(atomCount) - 2; i >= 0; --i) {
+    int currlen = 0;
+    dp[i] = MAX_COST;
+
+    for (size_t j = i; j < atomCount; ++j) {
+      if (j > static_cast<size_t>(i) && atoms[j].wordIndex != atoms[j - 1].wordIndex) {
+        currlen += spaceWidth;
+      }
+      currlen += atoms[j].width;
+      if (currlen > pageWidth) {
+        break;
+      }
+
+      // A mid-word ending adds the hyphen advance; the line may still extend past a candidate
+      // whose hyphen would not fit, so this skips rather than stopping the scan
+      const int lineWidth = currlen + atoms[j].hyphenExtra;
+      if (lineWidth > pageWidth) {
+        continue;
+      }
+
+      int cost;
+      if (j == atomCount - 1) {
+        cost = 0;  // Last line
+      } else {
+        const int remainingSpace = pageWidth - lineWidth;
+        long long cost_ll = static_cast<long long>(remainingSpace) * remainingSpace + dp[j + 1];
+        if (!atoms[j].wordEnd) {
+          cost_ll += HYPHEN_COST;
+        }
+        cost = cost_ll > MAX_COST ? MAX_COST : static_cast<int>(cost_ll);
+      }
+
+      if (cost < dp[i]) {
+        dp[i] = cost;
+        ans[i] = j;
+      }
+    }
+
+    // Handle oversized span: force a single-atom line rather than letting one unbreakable span
+    // poison every earlier start (mirrors the fallback in computeLineBreaks)
+    if (dp[i] == MAX_COST) {
+      ans[i] = i;
+      dp[i] = static_cast<size_t>(i) + 1 < atomCount ? dp[i + 1] : 0;
+    }
+  }
+
+  // Walk the chosen breaks in order, splitting words at mid-word breakpoints as we go. Each split
+  // shifts every later word index by one, and repeated breaks inside one long word need their
+  // offsets rebased onto the remainder produced by the previous split.
+  std::vector<size_t> lineBreakIndices;
+  size_t insertedWords = 0;
+  size_t rebaseWordIndex = std::numeric_limits<size_t>::max();
+  size_t rebaseOffset = 0;
+  size_t atomIndex = 0;
+  while (atomIndex < atomCount) {
+    size_t breakAtom = ans[atomIndex];
+    if (breakAtom < atomIndex) {
+      breakAtom = atomIndex;  // Safety check: never move backwards
+    }
+    const BreakAtom& brk = atoms[breakAtom];
+    const size_t wordIndex = brk.wordIndex + insertedWords;
+    if (brk.wordEnd) {
+      lineBreakIndices.push_back(wordIndex + 1);
+    } else {
+      const size_t offset = brk.wordIndex == rebaseWordIndex ? brk.byteOffset - rebaseOffset : brk.byteOffset;
+      rebaseWordIndex = brk.wordIndex;
+      rebaseOffset = brk.byteOffset;
+      splitWordAt(wordIndex, offset, brk.needsHyphen, renderer, fontId, wordWidths);
+      ++insertedWords;
+      lineBreakIndices.push_back(wordIndex + 1);
+    }
+    atomIndex = breakAtom + 1;
+  }
+
+  return lineBreakIndices;
+}
+
 // Splits words[wordIndex] into prefix (adding a hyphen only when needed) and remainder when a legal breakpoint fits the
 // available width.
 bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availableWidth, const GfxRenderer& renderer,
@@ -274,9 +510,12 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
   const std::string& word = *wordIt;
   const auto style = *styleIt;
 
-  // Collect candidate breakpoints (byte offsets and hyphen requirements).
-  auto breakInfos = Hyphenator::breakOffsets(word, allowFallbackBreaks);
-  if (breakInfos.empty()) {
+  // Collect candidate breakpoints (byte offsets and hyphen requirements) into stack scratch -
+  // this runs once per overflowing word, so no per-call vector churn.
+  constexpr size_t MAX_BREAK_CANDIDATES = 24;
+  Hyphenator::BreakInfo breakInfos[MAX_BREAK_CANDIDATES];
+  const size_t breakCount = Hyphenator::breakOffsetsInto(word, allowFallbackBreaks, breakInfos, MAX_BREAK_CANDIDATES);
+  if (breakCount == 0) {
     return false;
   }
 
@@ -285,7 +524,8 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
   bool chosenNeedsHyphen = true;
 
   // Iterate over each legal breakpoint and retain the widest prefix that still fits.
-  for (const auto& info : breakInfos) {
+  for (size_t breakIdx = 0; breakIdx < breakCount; ++breakIdx) {
+    const auto& info = breakInfos[breakIdx];
     const size_t offset = info.byteOffset;
     if (offset == 0 || offset >= word.size()) {
       continue;
@@ -307,10 +547,26 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
     return false;
   }
 
-  // Split the word at the selected breakpoint and append a hyphen if required.
-  std::string remainder = word.substr(chosenOffset);
-  wordIt->resize(chosenOffset);
-  if (chosenNeedsHyphen) {
+  splitWordAt(wordIndex, chosenOffset, chosenNeedsHyphen, renderer, fontId, wordWidths);
+  return true;
+}
+
+// Splits words[wordIndex] into prefix and remainder at a known breakpoint, appending a hyphen to
+// the prefix when required and updating the cached widths for the new pairing.
+void ParsedText::splitWordAt(const size_t wordIndex, const size_t byteOffset, const bool needsHyphen,
+                             const GfxRenderer& renderer, const int fontId, std::vector<uint16_t>& wordWidths) {
+  auto wordIt = words.begin();
+  auto styleIt = wordStyles.begin();
+  std::advance(wordIt, wordIndex);
+  std::advance(styleIt, wordIndex);
+  if (byteOffset == 0 || byteOffset >= wordIt->size()) {
+    return;
+  }
+  const auto style = *styleIt;
+
+  std::string remainder = wordIt->substr(byteOffset);
+  wordIt->resize(byteOffset);
+  if (needsHyphen) {
     wordIt->push_back('-');
   }
 
@@ -320,11 +576,9 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
   words.insert(insertWordIt, remainder);
   wordStyles.insert(insertStyleIt, style);
 
-  // Update cached widths to reflect the new prefix/remainder pairing.
-  wordWidths[wordIndex] = static_cast<uint16_t>(chosenWidth);
+  wordWidths[wordIndex] = measureWordWidth(renderer, fontId, *wordIt, style);
   const uint16_t remainderWidth = measureWordWidth(renderer, fontId, remainder, style);
   wordWidths.insert(wordWidths.begin() + wordIndex + 1, remainderWidth);
-  return true;
 }
 
 void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const int spaceWidth,
@@ -344,10 +598,14 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
   const int spareSpace = pageWidth - lineWordWidthSum;
 
   int spacing = spaceWidth;
+  int spacingRemainder = 0;
   const bool isLastLine = breakIndex == lineBreakIndices.size() - 1;
 
   if (style == TextBlock::JUSTIFIED && !isLastLine && lineWordCount >= 2) {
+    // Integer word spacing with the remainder pixels spread over the leading gaps,
+    // so the line lands exactly on the right margin
     spacing = spareSpace / (lineWordCount - 1);
+    spacingRemainder = spareSpace % (lineWordCount - 1);
   }
 
   // Calculate initial x position
@@ -359,11 +617,15 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
   }
 
   // Pre-calculate X positions for words
-  std::list<uint16_t> lineXPos;
+  ParseList<uint16_t> lineXPos;
   for (size_t i = lastBreakAt; i < lineBreak; i++) {
     const uint16_t currentWordWidth = wordWidths[i];
     lineXPos.push_back(xpos);
     xpos += currentWordWidth + spacing;
+    if (spacingRemainder > 0) {
+      xpos++;
+      spacingRemainder--;
+    }
   }
 
   // Iterators always start at the beginning as we are moving content with splice below
@@ -373,9 +635,9 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
   std::advance(wordStyleEndIt, lineWordCount);
 
   // *** CRITICAL STEP: CONSUME DATA USING SPLICE ***
-  std::list<std::string> lineWords;
+  ParseList<std::string> lineWords;
   lineWords.splice(lineWords.begin(), words, words.begin(), wordEndIt);
-  std::list<EpdFontFamily::Style> lineWordStyles;
+  ParseList<EpdFontFamily::Style> lineWordStyles;
   lineWordStyles.splice(lineWordStyles.begin(), wordStyles, wordStyles.begin(), wordStyleEndIt);
 
   for (auto& word : lineWords) {
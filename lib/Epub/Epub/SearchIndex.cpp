@@ -0,0 +1,114 @@
+#include "SearchIndex.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <algorithm>
+
+#include "Page.h"
+
+namespace {
+constexpr uint8_t SEARCH_INDEX_VERSION = 1;
+}  // namespace
+
+uint16_t SearchIndex::hashWord(const char* word) {
+  uint32_t hash = 2166136261u;  // FNV-1a offset basis
+  bool any = false;
+  for (const char* p = word; *p; p++) {
+    uint8_t c = static_cast<uint8_t>(*p);
+    if (c < 0x80) {
+      // ASCII: fold case, drop punctuation so "word," and "Word" match "word"
+      if (c >= 'A' && c <= 'Z') {
+        c += 'a' - 'A';
+      } else if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))) {
+        continue;
+      }
+    }
+    hash = (hash ^ c) * 16777619u;
+    any = true;
+  }
+  if (!any) {
+    return 0;
+  }
+  const uint16_t folded = static_cast<uint16_t>(hash ^ (hash >> 16));
+  return folded == 0 ? 1 : folded;
+}
+
+void SearchIndexBuilder::addPage(const Page& page, const uint16_t pageIndex) {
+  page.forEachWord([this, pageIndex](const std::string& word) {
+    const uint16_t hash = SearchIndex::hashWord(word.c_str());
+    if (hash == 0) {
+      return;
+    }
+    postings.push_back(static_cast<uint32_t>(hash) << 16 | pageIndex);
+  });
+}
+
+bool SearchIndexBuilder::writeToFile(const std::string& path) {
+  std::sort(postings.begin(), postings.end());
+  postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("SIX", path, file)) {
+    return false;
+  }
+  serialization::writePod(file, SEARCH_INDEX_VERSION);
+  serialization::writePod(file, static_cast<uint32_t>(postings.size()));
+  const bool ok = file.write(postings.data(), postings.size() * sizeof(uint32_t)) ==
+                  postings.size() * sizeof(uint32_t);
+  file.close();
+  if (!ok) {
+    SdMan.remove(path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool SearchIndex::lookup(const std::string& path, const uint16_t hash, std::vector<uint16_t>& pages) {
+  FsFile file;
+  if (!SdMan.openFileForRead("SIX", path, file)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(file, version);
+  if (version != SEARCH_INDEX_VERSION) {
+    file.close();
+    return false;
+  }
+  uint32_t count;
+  serialization::readPod(file, count);
+  const uint32_t base = file.position();
+
+  // Binary search for the first posting with this hash; records are sorted with the
+  // hash in the high half, so plain integer order works
+  const uint32_t target = static_cast<uint32_t>(hash) << 16;
+  uint32_t lo = 0;
+  uint32_t hi = count;
+  while (lo < hi) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    uint32_t record;
+    file.seek(base + mid * sizeof(uint32_t));
+    serialization::readPod(file, record);
+    if (record < target) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  // The matching run is contiguous; read it sequentially
+  file.seek(base + lo * sizeof(uint32_t));
+  for (uint32_t i = lo; i < count; i++) {
+    uint32_t record;
+    serialization::readPod(file, record);
+    if (record >> 16 != hash) {
+      break;
+    }
+    pages.push_back(static_cast<uint16_t>(record & 0xFFFF));
+  }
+
+  file.close();
+  return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Page;
+
+/**
+ * Compact full-text posting index for one section, built as a side product of the
+ * section build and stored next to the section file (same layout namespace, so page
+ * numbers always match the pages the reader shows).
+ *
+ * Postings are (word hash, page) pairs packed into a sorted uint32 each: the word
+ * hash is FNV-1a folded to 16 bits, which keeps a chapter's index around 10KB at the
+ * cost of rare hash collisions - a collision only surfaces an extra candidate page,
+ * never hides a real match.
+ */
+class SearchIndexBuilder {
+ public:
+  // Record every word on the page as a (hash, page) posting
+  void addPage(const Page& page, uint16_t pageIndex);
+  // Sort, dedupe and persist the postings; returns false on SD failure
+  bool writeToFile(const std::string& path);
+  bool empty() const { return postings.empty(); }
+
+ private:
+  std::vector<uint32_t> postings;  // hash16 << 16 | page, sorted at write time
+};
+
+class SearchIndex {
+ public:
+  // Normalized 16-bit word hash (lowercased ASCII, punctuation stripped). Never 0,
+  // so 0 can mean "no searchable content" to callers.
+  static uint16_t hashWord(const char* word);
+
+  // Collect the pages whose postings match `hash`, in ascending page order.
+  // Returns false if the index file is missing or unreadable (section not built yet).
+  static bool lookup(const std::string& path, uint16_t hash, std::vector<uint16_t>& pages);
+};
@@ -1,63 +1,457 @@
 #include "Section.h"
 
+#include <BufferedFileReader.h>
+#include <BufferedFileWriter.h>
+#include <BufferedPrint.h>
+#include <FileHandleCache.h>
+#include <FsHelpers.h>
+#include <JpegToBmpConverter.h>
+#include <Lz4.h>
 #include <SDCardManager.h>
 #include <Serialization.h>
+#include <Trace.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 #include "Page.h"
+#include "ParseArena.h"
+#include "SearchIndex.h"
 #include "hyphenation/Hyphenator.h"
 #include "parsers/ChapterHtmlSlimParser.h"
 
 namespace {
-constexpr uint8_t SECTION_FILE_VERSION = 10;
+// v13: class-driven styling (sections built before the stylesheet table existed render flat)
+// v14: glyph-run records carry the measured word width (bounding box for hit-testing)
+// v15: LUT entries may carry LUT_COMPRESSED_FLAG marking an LZ4-compressed page record
+constexpr uint8_t SECTION_FILE_VERSION = 15;
+
+// Top bit of a LUT entry: the page record at the offset below it is stored as
+// [uint32 rawSize][uint32 packedSize][LZ4 bytes] instead of a plain serialized page
+constexpr uint32_t LUT_COMPRESSED_FLAG = 0x80000000u;
+// Refuse to inflate records claiming more than this; a healthy page record (32KB image cap plus
+// text) stays well below, so anything bigger is corruption
+constexpr uint32_t MAX_RAW_PAGE_RECORD = 64 * 1024;
 constexpr uint32_t HEADER_SIZE = sizeof(uint8_t) + sizeof(int) + sizeof(float) + sizeof(bool) + sizeof(uint8_t) +
-                                 sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(bool) +
+                                 sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(bool) + sizeof(bool) +
                                  sizeof(uint32_t);
+
+// Anchor map: version byte, uint16 count, then (uint32 FNV-1a id hash, uint16 page) pairs
+constexpr uint8_t ANCHOR_MAP_VERSION = 1;
+
+// Cap on one inline image's packed 2-bit pixel bytes. The element stays resident whenever its
+// page is loaded (plus a second copy when the prefetcher has the page warm), so this bounds the
+// worst case at two images' worth of heap. 32KB is a full-width image roughly a third of a page
+// tall; taller sources just scale down further.
+constexpr uint32_t INLINE_IMAGE_MAX_BYTES = 32 * 1024;
+
+constexpr uint8_t LAYOUT_LRU_VERSION = 1;
+// Cap on section cache bytes per book across all layout namespaces; least-recently-used
+// namespaces are evicted when a build pushes the total past this
+constexpr uint32_t LAYOUT_CACHE_MAX_BYTES = 8 * 1024 * 1024;
+
+// RAM capture of one serialized page record; the codec needs the whole record contiguous
+// before it can see it
+class PageRecordSink final : public Print {
+ public:
+  std::vector<uint8_t> bytes;
+  size_t write(const uint8_t c) override {
+    bytes.push_back(c);
+    return 1;
+  }
+  size_t write(const uint8_t* data, const size_t len) override {
+    bytes.insert(bytes.end(), data, data + len);
+    return len;
+  }
+};
+
+void hashPod(uint32_t& hash, const void* data, const size_t len) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < len; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;  // FNV-1a
+  }
+}
+
+std::string layoutDirName(const uint32_t key) {
+  char buf[9];
+  snprintf(buf, sizeof(buf), "%08lx", static_cast<unsigned long>(key));
+  return std::string(buf);
+}
+
+// Layout keys in most-recently-used-first order, one list per book at sections/layouts.bin
+std::vector<uint32_t> readLayoutLru(const std::string& lruPath) {
+  std::vector<uint32_t> keys;
+  FsFile file;
+  if (!SdMan.openFileForRead("SCT", lruPath, file)) {
+    return keys;
+  }
+  uint8_t version;
+  serialization::readPod(file, version);
+  if (version != LAYOUT_LRU_VERSION) {
+    file.close();
+    return keys;
+  }
+  uint8_t count;
+  serialization::readPod(file, count);
+  for (uint8_t i = 0; i < count; i++) {
+    uint32_t key;
+    serialization::readPod(file, key);
+    keys.push_back(key);
+  }
+  file.close();
+  return keys;
+}
+
+void writeLayoutLru(const std::string& lruPath, const std::vector<uint32_t>& keys) {
+  FsFile file;
+  if (!SdMan.openFileForWrite("SCT", lruPath, file)) {
+    return;
+  }
+  serialization::writePod(file, LAYOUT_LRU_VERSION);
+  serialization::writePod(file, static_cast<uint8_t>(keys.size()));
+  for (const uint32_t key : keys) {
+    serialization::writePod(file, key);
+  }
+  file.close();
+}
+
+void touchLayoutLru(const std::string& lruPath, const uint32_t key) {
+  auto keys = readLayoutLru(lruPath);
+  if (!keys.empty() && keys.front() == key) {
+    return;
+  }
+  keys.erase(std::remove(keys.begin(), keys.end(), key), keys.end());
+  keys.insert(keys.begin(), key);
+  writeLayoutLru(lruPath, keys);
+}
+
+void enforceLayoutCacheCap(const std::string& sectionsDir, const uint32_t activeKey) {
+  struct LayoutDir {
+    uint32_t key;
+    uint32_t bytes;
+  };
+  std::vector<LayoutDir> dirs;
+  uint32_t totalBytes = 0;
+
+  auto root = SdMan.open(sectionsDir.c_str());
+  if (!root || !root.isDirectory()) {
+    return;
+  }
+  char name[32];
+  for (auto entry = root.openNextFile(); entry; entry = root.openNextFile()) {
+    if (!entry.isDirectory()) {
+      // Word caches and the LRU list live flat at the root and are not counted against the cap
+      entry.close();
+      continue;
+    }
+    entry.getName(name, sizeof(name));
+    uint32_t bytes = 0;
+    for (auto file = entry.openNextFile(); file; file = entry.openNextFile()) {
+      bytes += file.size();
+      file.close();
+    }
+    dirs.push_back({static_cast<uint32_t>(strtoul(name, nullptr, 16)), bytes});
+    totalBytes += bytes;
+    entry.close();
+  }
+  root.close();
+
+  if (totalBytes <= LAYOUT_CACHE_MAX_BYTES) {
+    return;
+  }
+
+  const auto lruPath = sectionsDir + "/layouts.bin";
+  auto lru = readLayoutLru(lruPath);
+  // Untracked namespaces rank as oldest, then tracked ones in least-recently-used order
+  const auto rank = [&lru](const uint32_t key) {
+    for (size_t i = 0; i < lru.size(); i++) {
+      if (lru[i] == key) {
+        return i;
+      }
+    }
+    return lru.size();
+  };
+  std::sort(dirs.begin(), dirs.end(),
+            [&rank](const LayoutDir& a, const LayoutDir& b) { return rank(a.key) > rank(b.key); });
+
+  for (const auto& dir : dirs) {
+    if (totalBytes <= LAYOUT_CACHE_MAX_BYTES) {
+      break;
+    }
+    if (dir.key == activeKey) {
+      continue;
+    }
+    const auto dirPath = sectionsDir + "/" + layoutDirName(dir.key);
+    Serial.printf("[%lu] [SCT] Evicting layout cache %s (%lu bytes)\n", millis(), dirPath.c_str(),
+                  static_cast<unsigned long>(dir.bytes));
+    if (SdMan.removeDir(dirPath.c_str())) {
+      totalBytes -= dir.bytes;
+      lru.erase(std::remove(lru.begin(), lru.end(), dir.key), lru.end());
+    }
+  }
+  writeLayoutLru(lruPath, lru);
+}
 }  // namespace
 
+Section::Section(const std::shared_ptr<Epub>& epub, const int spineIndex, GfxRenderer& renderer,
+                 const uint32_t layoutKey)
+    : epub(epub),
+      spineIndex(spineIndex),
+      renderer(renderer),
+      cacheKey(layoutKey),
+      layoutDirPath(epub->getCachePath() + "/sections/" + layoutDirName(layoutKey)),
+      filePath(layoutDirPath + "/" + std::to_string(spineIndex) + ".bin"),
+      wordCachePath(epub->getCachePath() + "/sections/" + std::to_string(spineIndex) + ".words") {}
+
+// Out of line so the unique_ptr<Page> member destructs where Page is a complete type
+Section::~Section() = default;
+
+std::string Section::searchIndexPath(const Epub& epub, const int spineIndex, const uint32_t layoutKey) {
+  return epub.getCachePath() + "/sections/" + layoutDirName(layoutKey) + "/" + std::to_string(spineIndex) + ".srch";
+}
+
+std::string Section::pageTablePath(const Epub& epub, const uint32_t layoutKey) {
+  return epub.getCachePath() + "/sections/" + layoutDirName(layoutKey) + "/pages.bin";
+}
+
+std::string Section::anchorMapPath(const Epub& epub, const int spineIndex, const uint32_t layoutKey) {
+  return epub.getCachePath() + "/sections/" + layoutDirName(layoutKey) + "/" + std::to_string(spineIndex) + ".anch";
+}
+
+void Section::writeAnchorMap(const std::vector<std::pair<std::string, uint16_t>>& anchors) const {
+  const auto path = anchorMapPath(*epub, spineIndex, cacheKey);
+  if (anchors.empty()) {
+    // Most chapters carry no anchors; drop any map left over from a previous build
+    if (SdMan.exists(path.c_str())) {
+      SdMan.remove(path.c_str());
+    }
+    return;
+  }
+
+  FsFile mapFile;
+  if (!SdMan.openFileForWrite("SCT", path, mapFile)) {
+    return;
+  }
+  serialization::writePod(mapFile, ANCHOR_MAP_VERSION);
+  serialization::writePod(mapFile, static_cast<uint16_t>(anchors.size()));
+  for (const auto& anchor : anchors) {
+    uint32_t hash = 2166136261u;
+    hashPod(hash, anchor.first.data(), anchor.first.size());
+    serialization::writePod(mapFile, hash);
+    serialization::writePod(mapFile, anchor.second);
+  }
+  mapFile.close();
+  Serial.printf("[%lu] [SCT] Wrote anchor map: %u anchors\n", millis(), static_cast<unsigned>(anchors.size()));
+}
+
+int Section::lookupAnchorPage(const Epub& epub, const int spineIndex, const uint32_t layoutKey,
+                              const std::string& anchor) {
+  FsFile mapFile;
+  if (!SdMan.openFileForRead("SCT", anchorMapPath(epub, spineIndex, layoutKey), mapFile)) {
+    return -1;
+  }
+
+  uint8_t version;
+  serialization::readPod(mapFile, version);
+  if (version != ANCHOR_MAP_VERSION) {
+    mapFile.close();
+    return -1;
+  }
+
+  uint32_t targetHash = 2166136261u;
+  hashPod(targetHash, anchor.data(), anchor.size());
+
+  uint16_t count;
+  serialization::readPod(mapFile, count);
+  for (uint16_t i = 0; i < count; i++) {
+    uint32_t hash;
+    uint16_t page;
+    serialization::readPod(mapFile, hash);
+    serialization::readPod(mapFile, page);
+    if (hash == targetHash) {
+      mapFile.close();
+      return page;
+    }
+  }
+  mapFile.close();
+  return -1;
+}
+
+uint32_t Section::layoutKey(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
+                            const uint8_t paragraphAlignment, const uint16_t viewportWidth,
+                            const uint16_t viewportHeight, const bool hyphenationEnabled,
+                            const bool optimalLineBreaks) {
+  uint32_t hash = 2166136261u;  // FNV-1a offset basis
+  hashPod(hash, &fontId, sizeof(fontId));
+  hashPod(hash, &lineCompression, sizeof(lineCompression));
+  hashPod(hash, &extraParagraphSpacing, sizeof(extraParagraphSpacing));
+  hashPod(hash, &paragraphAlignment, sizeof(paragraphAlignment));
+  hashPod(hash, &viewportWidth, sizeof(viewportWidth));
+  hashPod(hash, &viewportHeight, sizeof(viewportHeight));
+  hashPod(hash, &hyphenationEnabled, sizeof(hyphenationEnabled));
+  hashPod(hash, &optimalLineBreaks, sizeof(optimalLineBreaks));
+  return hash;
+}
+
+void Section::touchLayoutCache(const bool enforceCap) const {
+  const auto sectionsDir = epub->getCachePath() + "/sections";
+  touchLayoutLru(sectionsDir + "/layouts.bin", cacheKey);
+  if (enforceCap) {
+    enforceLayoutCacheCap(sectionsDir, cacheKey);
+  }
+}
+
+std::shared_ptr<PageImage> Section::buildPageImage(const std::string& src, const uint16_t maxWidth,
+                                                   const uint16_t maxHeight) const {
+  // Resolve the src against the spine item's directory (commonly "../images/fig1.jpg")
+  const auto& itemHref = epub->getSpineItem(spineIndex).href;
+  const auto dirEnd = itemHref.find_last_of('/');
+  const auto resolved =
+      FsHelpers::normalisePath((dirEnd == std::string::npos ? "" : itemHref.substr(0, dirEnd + 1)) + src);
+
+  // Inline images stay JPEG-only (the PNG decoder serves the cover pipeline); other formats
+  // keep the alt-text placeholder
+  const bool isJpeg = (resolved.length() > 4 && resolved.substr(resolved.length() - 4) == ".jpg") ||
+                      (resolved.length() > 5 && resolved.substr(resolved.length() - 5) == ".jpeg");
+  if (!isJpeg) {
+    return nullptr;
+  }
+
+  // Stream the compressed image out of the zip; picojpeg needs a seekable file for its
+  // reduced-decode rewind, so it can't run on the inflate stream directly
+  const auto tmpJpgPath = epub->getCachePath() + "/.tmp_img.jpg";
+  FsFile tmpJpg;
+  if (!SdMan.openFileForWrite("SCT", tmpJpgPath, tmpJpg)) {
+    return nullptr;
+  }
+  BufferedPrint bufferedJpg(tmpJpg, BufferedPrint::FILE_SINK_CAPACITY);
+  const bool streamed = epub->readItemContentsToStream(resolved, bufferedJpg, 1024) && bufferedJpg.flushBuffer();
+  tmpJpg.close();
+  if (!streamed) {
+    SdMan.remove(tmpJpgPath.c_str());
+    return nullptr;
+  }
+
+  // Fit to the viewport, with the height clamped so a worst-case full-width image stays
+  // inside the packed-byte budget
+  uint16_t targetHeight = maxHeight;
+  const uint32_t budgetHeight = INLINE_IMAGE_MAX_BYTES / PageImage::bytesPerRow(maxWidth);
+  if (budgetHeight < targetHeight) {
+    targetHeight = static_cast<uint16_t>(budgetHeight);
+  }
+
+  ImageRowBytes rows;
+  uint16_t imgWidth = 0;
+  uint16_t imgHeight = 0;
+  const JpegToBmpConverter::RowSink sink = {
+      .onDimensions =
+          [&rows, &imgWidth, &imgHeight](const int width, const int height) {
+            imgWidth = width;
+            imgHeight = height;
+            rows.assign(static_cast<size_t>(PageImage::bytesPerRow(width)) * height, 0);
+          },
+      .onRow =
+          [&rows, &imgWidth, &imgHeight](const int y, const uint8_t* packedRow, const int widthPixels) {
+            if (y >= 0 && y < imgHeight && widthPixels == imgWidth) {
+              const uint16_t stride = PageImage::bytesPerRow(imgWidth);
+              memcpy(rows.data() + static_cast<size_t>(y) * stride, packedRow, stride);
+            }
+          }};
+
+  FsFile jpgFile;
+  bool decoded = SdMan.openFileForRead("SCT", tmpJpgPath, jpgFile);
+  if (decoded) {
+    decoded = JpegToBmpConverter::jpegFileToSinkWithSize(jpgFile, sink, maxWidth, targetHeight);
+    jpgFile.close();
+  }
+  SdMan.remove(tmpJpgPath.c_str());
+
+  if (!decoded || imgWidth == 0 || imgHeight == 0 || imgWidth > maxWidth || imgHeight > targetHeight) {
+    return nullptr;
+  }
+
+  Serial.printf("[%lu] [SCT] Inline image %s: %ux%u (%u bytes)\n", millis(), resolved.c_str(), imgWidth, imgHeight,
+                static_cast<unsigned>(rows.size()));
+  return std::allocate_shared<PageImage>(ParseArenaAllocator<PageImage>(), std::move(rows), imgWidth, imgHeight, 0, 0);
+}
+
+#ifdef EPUB_COMPRESS_SECTION_PAGES
+bool Section::compressPageRecords = true;
+#else
+bool Section::compressPageRecords = false;
+#endif
+
 uint32_t Section::onPageComplete(std::unique_ptr<Page> page) {
-  if (!file) {
+  if (!file || !buildWriter) {
     Serial.printf("[%lu] [SCT] File not open for writing page %d\n", millis(), pageCount);
     return 0;
   }
 
-  const uint32_t position = file.position();
-  if (!page->serialize(file)) {
+  // Logical position: the record may still sit (partly) in the writer's buffer, but this is
+  // where it lands on flush, so it is what the LUT must record
+  const uint32_t position = buildWriter->position();
+  uint32_t lutFlags = 0;
+
+  if (compressPageRecords) {
+    // Serialize into RAM, compress, and keep whichever is smaller. Records the codec can't
+    // shrink (image-dominated pages) stay plain, so a compressed file degrades gracefully.
+    PageRecordSink sink;
+    if (!page->serialize(sink)) {
+      Serial.printf("[%lu] [SCT] Failed to serialize page %d\n", millis(), pageCount);
+      return 0;
+    }
+    std::vector<uint8_t> packed(lz4::compressBound(sink.bytes.size()));
+    const size_t packedLen = lz4::compress(sink.bytes.data(), sink.bytes.size(), packed.data(), packed.size());
+    if (packedLen > 0 && packedLen + 2 * sizeof(uint32_t) < sink.bytes.size()) {
+      serialization::writePod(*buildWriter, static_cast<uint32_t>(sink.bytes.size()));
+      serialization::writePod(*buildWriter, static_cast<uint32_t>(packedLen));
+      buildWriter->write(packed.data(), packedLen);
+      lutFlags = LUT_COMPRESSED_FLAG;
+    } else {
+      buildWriter->write(sink.bytes.data(), sink.bytes.size());
+    }
+  } else if (!page->serialize(*buildWriter)) {
     Serial.printf("[%lu] [SCT] Failed to serialize page %d\n", millis(), pageCount);
     return 0;
   }
   Serial.printf("[%lu] [SCT] Page %d processed\n", millis(), pageCount);
 
   pageCount++;
-  return position;
+  return position | lutFlags;
 }
 
 void Section::writeSectionFileHeader(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
                                      const uint8_t paragraphAlignment, const uint16_t viewportWidth,
-                                     const uint16_t viewportHeight, const bool hyphenationEnabled) {
-  if (!file) {
+                                     const uint16_t viewportHeight, const bool hyphenationEnabled,
+                                     const bool optimalLineBreaks) {
+  if (!file || !buildWriter) {
     Serial.printf("[%lu] [SCT] File not open for writing header\n", millis());
     return;
   }
   static_assert(HEADER_SIZE == sizeof(SECTION_FILE_VERSION) + sizeof(fontId) + sizeof(lineCompression) +
                                    sizeof(extraParagraphSpacing) + sizeof(paragraphAlignment) + sizeof(viewportWidth) +
                                    sizeof(viewportHeight) + sizeof(pageCount) + sizeof(hyphenationEnabled) +
-                                   sizeof(uint32_t),
+                                   sizeof(optimalLineBreaks) + sizeof(uint32_t),
                 "Header size mismatch");
-  serialization::writePod(file, SECTION_FILE_VERSION);
-  serialization::writePod(file, fontId);
-  serialization::writePod(file, lineCompression);
-  serialization::writePod(file, extraParagraphSpacing);
-  serialization::writePod(file, paragraphAlignment);
-  serialization::writePod(file, viewportWidth);
-  serialization::writePod(file, viewportHeight);
-  serialization::writePod(file, hyphenationEnabled);
-  serialization::writePod(file, pageCount);  // Placeholder for page count (will be initially 0 when written)
-  serialization::writePod(file, static_cast<uint32_t>(0));  // Placeholder for LUT offset
+  serialization::writePod(*buildWriter, SECTION_FILE_VERSION);
+  serialization::writePod(*buildWriter, fontId);
+  serialization::writePod(*buildWriter, lineCompression);
+  serialization::writePod(*buildWriter, extraParagraphSpacing);
+  serialization::writePod(*buildWriter, paragraphAlignment);
+  serialization::writePod(*buildWriter, viewportWidth);
+  serialization::writePod(*buildWriter, viewportHeight);
+  serialization::writePod(*buildWriter, hyphenationEnabled);
+  serialization::writePod(*buildWriter, optimalLineBreaks);
+  serialization::writePod(*buildWriter, pageCount);  // Placeholder for page count (will be initially 0 when written)
+  serialization::writePod(*buildWriter, static_cast<uint32_t>(0));  // Placeholder for LUT offset
 }
 
 bool Section::loadSectionFile(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
                               const uint8_t paragraphAlignment, const uint16_t viewportWidth,
-                              const uint16_t viewportHeight, const bool hyphenationEnabled) {
+                              const uint16_t viewportHeight, const bool hyphenationEnabled,
+                              const bool optimalLineBreaks) {
   if (!SdMan.openFileForRead("SCT", filePath, file)) {
     return false;
   }
@@ -79,6 +473,7 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
     bool fileExtraParagraphSpacing;
     uint8_t fileParagraphAlignment;
     bool fileHyphenationEnabled;
+    bool fileOptimalLineBreaks;
     serialization::readPod(file, fileFontId);
     serialization::readPod(file, fileLineCompression);
     serialization::readPod(file, fileExtraParagraphSpacing);
@@ -86,11 +481,12 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
     serialization::readPod(file, fileViewportWidth);
     serialization::readPod(file, fileViewportHeight);
     serialization::readPod(file, fileHyphenationEnabled);
+    serialization::readPod(file, fileOptimalLineBreaks);
 
     if (fontId != fileFontId || lineCompression != fileLineCompression ||
         extraParagraphSpacing != fileExtraParagraphSpacing || paragraphAlignment != fileParagraphAlignment ||
         viewportWidth != fileViewportWidth || viewportHeight != fileViewportHeight ||
-        hyphenationEnabled != fileHyphenationEnabled) {
+        hyphenationEnabled != fileHyphenationEnabled || optimalLineBreaks != fileOptimalLineBreaks) {
       file.close();
       Serial.printf("[%lu] [SCT] Deserialization failed: Parameters do not match\n", millis());
       clearCache();
@@ -99,13 +495,58 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
   }
 
   serialization::readPod(file, pageCount);
+  serialization::readPod(file, lutOffset);
   file.close();
+  touchLayoutCache(false);
   Serial.printf("[%lu] [SCT] Deserialization succeeded: %d pages\n", millis(), pageCount);
   return true;
 }
 
+// Write the page LUT, flush the build writer, and back-patch the header with the page count and
+// LUT offset. Expects `file` open for writing with all pages already serialized through
+// `buildWriter`; tears the writer down and closes the file either way.
+bool Section::finalizeSectionFile(const std::vector<uint32_t>& lut) {
+  const uint32_t lutOffset = buildWriter ? buildWriter->position() : file.position();
+  bool hasFailedLutRecords = !buildWriter;
+  // Write LUT
+  for (const uint32_t& pos : lut) {
+    if (pos == 0 || hasFailedLutRecords) {
+      hasFailedLutRecords = true;
+      break;
+    }
+    serialization::writePod(*buildWriter, pos);
+  }
+
+  if (hasFailedLutRecords) {
+    Serial.printf("[%lu] [SCT] Failed to write LUT due to invalid page positions\n", millis());
+    buildWriter.reset();
+    file.close();
+    SdMan.remove(filePath.c_str());
+    return false;
+  }
+
+  // Everything staged must be on the card before the seek below abandons the append position
+  if (!buildWriter->flushBuffer()) {
+    Serial.printf("[%lu] [SCT] Failed to flush section file\n", millis());
+    buildWriter.reset();
+    file.close();
+    SdMan.remove(filePath.c_str());
+    return false;
+  }
+  buildWriter.reset();
+
+  // Go back and write LUT offset
+  file.seek(HEADER_SIZE - sizeof(uint32_t) - sizeof(pageCount));
+  serialization::writePod(file, pageCount);
+  serialization::writePod(file, lutOffset);
+  file.close();
+  this->lutOffset = lutOffset;
+  return true;
+}
+
 // Your updated class method (assuming you are using the 'SD' object, which is a wrapper for a specific filesystem)
 bool Section::clearCache() const {
+  FILE_HANDLES.invalidate(filePath);
   if (!SdMan.exists(filePath.c_str())) {
     Serial.printf("[%lu] [SCT] Cache does not exist, no action needed\n", millis());
     return true;
@@ -123,16 +564,91 @@ bool Section::clearCache() const {
 bool Section::createSectionFile(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
                                 const uint8_t paragraphAlignment, const uint16_t viewportWidth,
                                 const uint16_t viewportHeight, const bool hyphenationEnabled,
-                                const std::function<void()>& progressSetupFn,
-                                const std::function<void(int)>& progressFn) {
+                                const bool optimalLineBreaks, const std::function<void()>& progressSetupFn,
+                                const std::function<void(int)>& progressFn,
+                                const std::function<bool()>& abortFn) {
+  TRACE_SCOPE("Section::createSectionFile");
   constexpr uint32_t MIN_SIZE_FOR_PROGRESS = 50 * 1024;  // 50KB
+  // The build below rewrites (and on failure removes) the section file; drop any handle the
+  // page-turn cache still holds on the old bytes first
+  FILE_HANDLES.invalidate(filePath);
   const auto localPath = epub->getSpineItem(spineIndex).href;
   const auto tmpHtmlPath = epub->getCachePath() + "/.tmp_" + std::to_string(spineIndex) + ".html";
 
-  // Create cache directory if it doesn't exist
+  // All parse-time word/style/position nodes come from this arena and go back to the heap in
+  // one piece when the build finishes, so repeated chapter builds don't fragment the heap.
+  // Declared before the parsers below so it outlives everything allocated from it.
+  ParseArena parseArena;
+  const ParseArena::Scope parseArenaScope(parseArena);
+
+  // Create cache directories if they don't exist (one namespace per layout key)
   {
     const auto sectionsDir = epub->getCachePath() + "/sections";
     SdMan.mkdir(sectionsDir.c_str());
+    SdMan.mkdir(layoutDirPath.c_str());
+
+    // Pre-namespace section files lived flat next to the word caches; drop any leftover
+    const auto legacyPath = sectionsDir + "/" + std::to_string(spineIndex) + ".bin";
+    if (SdMan.exists(legacyPath.c_str())) {
+      SdMan.remove(legacyPath.c_str());
+    }
+  }
+
+  // Fast path: if a previous build left a word cache for this spine item, replay it through the
+  // layout stage instead of re-inflating and re-parsing the HTML. This is what makes layout-only
+  // settings changes (font, line spacing, viewport) cheap.
+  if (SdMan.exists(wordCachePath.c_str())) {
+    if (!SdMan.openFileForWrite("SCT", filePath, file)) {
+      return false;
+    }
+    buildWriter.reset(new BufferedFileWriter(file));
+    pageCount = 0;
+    writeSectionFileHeader(fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
+                           viewportHeight, hyphenationEnabled, optimalLineBreaks);
+    std::vector<uint32_t> lut = {};
+    SearchIndexBuilder searchIndex;
+    ChapterHtmlSlimParser visitor(
+        tmpHtmlPath, renderer, fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
+        viewportHeight, hyphenationEnabled, optimalLineBreaks,
+        [this, &lut, &searchIndex, fontId](std::unique_ptr<Page> page) {
+          // Index words before compile() replaces the lines with glyph runs
+          searchIndex.addPage(*page, pageCount);
+          // Pre-position glyph runs so page turns render with zero layout work
+          page->compile(renderer, fontId);
+          lut.emplace_back(this->onPageComplete(std::move(page)));
+        },
+        progressFn, abortFn);
+    visitor.setWordCachePath(wordCachePath);
+    visitor.setImageElementFn([this, viewportWidth, viewportHeight](const char* src) {
+      return buildPageImage(src, viewportWidth, viewportHeight);
+    });
+    visitor.setClassStyles(&epub->getClassStyles());
+    // Language already resolved at metadata build time; warming the trie here keeps both the
+    // registry lookup and the first flash faults out of the per-word layout loop
+    Hyphenator::setPreferredPrimaryTag(epub->getHyphenationTag());
+    if (hyphenationEnabled) {
+      Hyphenator::preloadPatterns();
+    }
+    if (visitor.buildPagesFromWordCache() && finalizeSectionFile(lut)) {
+      Serial.printf("[%lu] [SCT] Rebuilt section from word cache: %d pages\n", millis(), pageCount);
+      if (!searchIndex.writeToFile(searchIndexPath(*epub, spineIndex, cacheKey))) {
+        Serial.printf("[%lu] [SCT] Failed to write search index\n", millis());
+      }
+      writeAnchorMap(visitor.getAnchorPages());
+      touchLayoutCache(true);
+      return true;
+    }
+
+    // Replay didn't pan out (stale cache, abort, bad record) - clean up and do the full parse
+    buildWriter.reset();
+    if (file) {
+      file.close();
+    }
+    SdMan.remove(filePath.c_str());
+    pageCount = 0;
+    if (abortFn && abortFn()) {
+      return false;
+    }
   }
 
   // Retry logic for SD card timing issues
@@ -153,7 +669,8 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
     if (!SdMan.openFileForWrite("SCT", tmpHtmlPath, tmpHtml)) {
       continue;
     }
-    success = epub->readItemContentsToStream(localPath, tmpHtml, 1024);
+    BufferedPrint bufferedHtml(tmpHtml, BufferedPrint::FILE_SINK_CAPACITY);
+    success = epub->readItemContentsToStream(localPath, bufferedHtml, 1024) && bufferedHtml.flushBuffer();
     fileSize = tmpHtml.size();
     tmpHtml.close();
 
@@ -179,66 +696,191 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
   if (!SdMan.openFileForWrite("SCT", filePath, file)) {
     return false;
   }
+  buildWriter.reset(new BufferedFileWriter(file));
   writeSectionFileHeader(fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
-                         viewportHeight, hyphenationEnabled);
+                         viewportHeight, hyphenationEnabled, optimalLineBreaks);
   std::vector<uint32_t> lut = {};
+  SearchIndexBuilder searchIndex;
 
   ChapterHtmlSlimParser visitor(
       tmpHtmlPath, renderer, fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
-      viewportHeight, hyphenationEnabled,
-      [this, &lut](std::unique_ptr<Page> page) { lut.emplace_back(this->onPageComplete(std::move(page))); },
-      progressFn);
-  Hyphenator::setPreferredLanguage(epub->getLanguage());
+      viewportHeight, hyphenationEnabled, optimalLineBreaks,
+      [this, &lut, &searchIndex](std::unique_ptr<Page> page) {
+        searchIndex.addPage(*page, pageCount);
+        lut.emplace_back(this->onPageComplete(std::move(page)));
+      },
+      progressFn, abortFn);
+  visitor.setWordCachePath(wordCachePath);
+  visitor.setImageElementFn([this, viewportWidth, viewportHeight](const char* src) {
+    return buildPageImage(src, viewportWidth, viewportHeight);
+  });
+  visitor.setClassStyles(&epub->getClassStyles());
+  // As above: tag pre-resolved, trie pre-touched before the layout loop starts
+  Hyphenator::setPreferredPrimaryTag(epub->getHyphenationTag());
+  if (hyphenationEnabled) {
+    Hyphenator::preloadPatterns();
+  }
   success = visitor.parseAndBuildPages();
 
   SdMan.remove(tmpHtmlPath.c_str());
   if (!success) {
     Serial.printf("[%lu] [SCT] Failed to parse XML and build pages\n", millis());
+    buildWriter.reset();
     file.close();
     SdMan.remove(filePath.c_str());
     return false;
   }
 
-  const uint32_t lutOffset = file.position();
-  bool hasFailedLutRecords = false;
-  // Write LUT
-  for (const uint32_t& pos : lut) {
-    if (pos == 0) {
-      hasFailedLutRecords = true;
-      break;
+  if (!finalizeSectionFile(lut)) {
+    return false;
+  }
+  if (!searchIndex.writeToFile(searchIndexPath(*epub, spineIndex, cacheKey))) {
+    Serial.printf("[%lu] [SCT] Failed to write search index\n", millis());
+  }
+  writeAnchorMap(visitor.getAnchorPages());
+  touchLayoutCache(true);
+  return true;
+}
+
+std::unique_ptr<Page> Section::loadPageFromSectionFile() {
+  TRACE_SCOPE("Section::loadPageFromSectionFile");
+  if (preloadedPage && preloadedPageIndex == currentPage) {
+    preloadedPageIndex = -1;
+    return std::move(preloadedPage);
+  }
+
+  // Through the handle cache: the same section file is re-read on every page turn, so
+  // steady-state turns reuse the open handle instead of resolving the path again
+  FsFile* sectionFile = FILE_HANDLES.acquire("SCT", filePath);
+  if (sectionFile == nullptr) {
+    return nullptr;
+  }
+
+  // Static window rather than stack: the display and prefetch tasks run 4KB stacks, and both
+  // hold the rendering mutex while loading, so one shared buffer is safe (see
+  // GlyphCache::packedScratch for the same pattern). Sized to cover a typical serialized page in
+  // one aligned multi-block read.
+  static uint8_t pageReadWindow[8 * 1024];
+  BufferedFileReader reader(*sectionFile, pageReadWindow, sizeof(pageReadWindow));
+
+  uint32_t pagePos;
+  if (manifestPagePosIndex == currentPage && manifestPagePos != 0) {
+    // Offset packed into the resume manifest at close time; skips the LUT read on first paint
+    pagePos = manifestPagePos;
+    manifestPagePosIndex = -1;
+  } else {
+    if (lutOffset == 0) {
+      // Older in-memory state without the cached offset; read it from the header once
+      reader.seek(HEADER_SIZE - sizeof(uint32_t));
+      reader.pod(lutOffset);
+    }
+    reader.seek(lutOffset + sizeof(uint32_t) * currentPage);
+    reader.pod(pagePos);
+  }
+  const bool compressed = (pagePos & LUT_COMPRESSED_FLAG) != 0;
+  pagePos &= ~LUT_COMPRESSED_FLAG;
+  // Pre-fill the window at the page record so the element loop decodes from RAM
+  reader.readAhead(pagePos);
+
+  std::unique_ptr<Page> page;
+  if (compressed) {
+    // Compressed extent: pull the packed bytes in one bulk read, inflate, and decode the
+    // record from RAM through a memory-backed reader
+    uint32_t rawSize = 0;
+    uint32_t packedSize = 0;
+    reader.pod(rawSize);
+    reader.pod(packedSize);
+    if (rawSize == 0 || rawSize > MAX_RAW_PAGE_RECORD || packedSize == 0 || packedSize > MAX_RAW_PAGE_RECORD) {
+      Serial.printf("[%lu] [SCT] Bad compressed page record (raw=%lu packed=%lu)\n", millis(),
+                    static_cast<unsigned long>(rawSize), static_cast<unsigned long>(packedSize));
+      FILE_HANDLES.release(sectionFile);
+      return nullptr;
     }
-    serialization::writePod(file, pos);
+    std::vector<uint8_t> packed(packedSize);
+    std::vector<uint8_t> raw(rawSize);
+    if (reader.read(packed.data(), packedSize) != static_cast<int>(packedSize) ||
+        !lz4::decompress(packed.data(), packedSize, raw.data(), rawSize)) {
+      Serial.printf("[%lu] [SCT] Failed to inflate page %d\n", millis(), currentPage);
+      FILE_HANDLES.release(sectionFile);
+      return nullptr;
+    }
+    BufferedFileReader memReader(raw.data(), rawSize);
+    page = Page::deserialize(memReader);
+  } else {
+    page = Page::deserialize(reader);
   }
+  FILE_HANDLES.release(sectionFile);
+  return page;
+}
 
-  if (hasFailedLutRecords) {
-    Serial.printf("[%lu] [SCT] Failed to write LUT due to invalid page positions\n", millis());
-    file.close();
-    SdMan.remove(filePath.c_str());
+bool Section::preloadPage(const int page) {
+  if (page < 0 || page >= pageCount) {
     return false;
   }
 
-  // Go back and write LUT offset
-  file.seek(HEADER_SIZE - sizeof(uint32_t) - sizeof(pageCount));
-  serialization::writePod(file, pageCount);
-  serialization::writePod(file, lutOffset);
-  file.close();
+  preloadedPage.reset();
+  preloadedPageIndex = -1;
+
+  const int savedPage = currentPage;
+  currentPage = page;
+  auto loaded = loadPageFromSectionFile();
+  currentPage = savedPage;
+
+  if (!loaded) {
+    return false;
+  }
+  preloadedPage = std::move(loaded);
+  preloadedPageIndex = page;
   return true;
 }
 
-std::unique_ptr<Page> Section::loadPageFromSectionFile() {
-  if (!SdMan.openFileForRead("SCT", filePath, file)) {
-    return nullptr;
+uint32_t Section::getPagePosition(const int page) {
+  if (page < 0 || page >= pageCount) {
+    return 0;
   }
 
-  file.seek(HEADER_SIZE - sizeof(uint32_t));
-  uint32_t lutOffset;
-  serialization::readPod(file, lutOffset);
-  file.seek(lutOffset + sizeof(uint32_t) * currentPage);
-  uint32_t pagePos;
-  serialization::readPod(file, pagePos);
-  file.seek(pagePos);
+  FsFile* sectionFile = FILE_HANDLES.acquire("SCT", filePath);
+  if (sectionFile == nullptr) {
+    return 0;
+  }
+  if (lutOffset == 0) {
+    sectionFile->seek(HEADER_SIZE - sizeof(uint32_t));
+    serialization::readPod(*sectionFile, lutOffset);
+  }
+  sectionFile->seek(lutOffset + sizeof(uint32_t) * page);
+  uint32_t pagePos = 0;
+  serialization::readPod(*sectionFile, pagePos);
+  FILE_HANDLES.release(sectionFile);
+  return pagePos;
+}
 
-  auto page = Page::deserialize(file);
-  file.close();
-  return page;
+bool Section::restoreFromManifest(const uint16_t manifestPageCount, const uint32_t manifestLutOffset, const int page,
+                                  const uint32_t pagePos) {
+  if (manifestPageCount == 0 || manifestLutOffset == 0 || !SdMan.exists(filePath.c_str())) {
+    return false;
+  }
+
+  pageCount = manifestPageCount;
+  lutOffset = manifestLutOffset;
+  seekToPage(page);
+  if (pagePos != 0 && currentPage == page) {
+    manifestPagePos = pagePos;
+    manifestPagePosIndex = page;
+  }
+  return true;
+}
+
+void Section::seekToPage(const int page) {
+  if (pageCount == 0) {
+    currentPage = 0;
+    return;
+  }
+
+  if (page < 0) {
+    currentPage = 0;
+  } else if (page >= pageCount) {
+    currentPage = pageCount - 1;
+  } else {
+    currentPage = page;
+  }
 }
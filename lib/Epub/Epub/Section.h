@@ -5,35 +5,103 @@
 #include "Epub.h"
 
 class Page;
+class PageImage;
 class GfxRenderer;
+class BufferedFileWriter;
 
 class Section {
   std::shared_ptr<Epub> epub;
   const int spineIndex;
   GfxRenderer& renderer;
+  // Hash of the layout-affecting settings this section was built for; section files live in a
+  // per-key directory so switching between two known layouts keeps both caches warm
+  const uint32_t cacheKey;
+  std::string layoutDirPath;
   std::string filePath;
+  // Parse product (word stream) cached at the sections root, shared by all layout namespaces;
+  // it survives layout settings changes, so rebuilds can skip decompression and HTML parsing
+  std::string wordCachePath;
   FsFile file;
+  // Coalescing writer wrapped around `file` for the lifetime of a build; page records and the
+  // LUT are emitted as many small field writes, and routing them through the writer turns those
+  // into aligned multi-sector card writes. Reset (after a flush) before any direct seek on
+  // `file` and on every build exit.
+  std::unique_ptr<BufferedFileWriter> buildWriter;
+  // File offset of the page LUT, cached at load/create time so page seeks skip the header read
+  uint32_t lutOffset = 0;
+  // Page image read ahead of time (chapter prefetch); handed out by loadPageFromSectionFile()
+  std::unique_ptr<Page> preloadedPage;
+  int preloadedPageIndex = -1;
+  // Page offset adopted from the reader's resume manifest; consumed by the first
+  // loadPageFromSectionFile() for that page so it can skip the LUT read
+  uint32_t manifestPagePos = 0;
+  int manifestPagePosIndex = -1;
 
   void writeSectionFileHeader(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
-                              uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled);
+                              uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
+                              bool optimalLineBreaks);
   uint32_t onPageComplete(std::unique_ptr<Page> page);
+  bool finalizeSectionFile(const std::vector<uint32_t>& lut);
+  // Persist the (anchor id → page) pairs the parser collected; removes any stale map
+  // when the build produced none
+  void writeAnchorMap(const std::vector<std::pair<std::string, uint16_t>>& anchors) const;
+  // Extract an <img> source from the zip and decode it to a pre-scaled, pre-dithered page
+  // element (build time only; the result is serialized into the section file). Returns nullptr
+  // when the source is missing or not a JPEG - the parser falls back to its alt-text placeholder.
+  std::shared_ptr<PageImage> buildPageImage(const std::string& src, uint16_t maxWidth, uint16_t maxHeight) const;
+  // Mark this section's layout namespace most-recently-used; when enforceCap is set, also evict
+  // least-recently-used namespaces until the per-book section cache fits the byte cap
+  void touchLayoutCache(bool enforceCap) const;
 
  public:
   uint16_t pageCount = 0;
   int currentPage = 0;
+  // Build-time switch: serialize page records through the LZ4 codec, with the LUT top bit
+  // marking compressed extents. Loading handles both forms regardless. Off by default until the
+  // bench page-load-z scenario shows decode+read beating plain read on the deployed card
+  // population; flip with -DEPUB_COMPRESS_SECTION_PAGES (or at runtime before a build, as the
+  // bench runner does).
+  static bool compressPageRecords;
 
-  explicit Section(const std::shared_ptr<Epub>& epub, const int spineIndex, GfxRenderer& renderer)
-      : epub(epub),
-        spineIndex(spineIndex),
-        renderer(renderer),
-        filePath(epub->getCachePath() + "/sections/" + std::to_string(spineIndex) + ".bin") {}
-  ~Section() = default;
+  explicit Section(const std::shared_ptr<Epub>& epub, int spineIndex, GfxRenderer& renderer, uint32_t layoutKey);
+  ~Section();
+  // Stable hash of the layout-affecting settings, used to pick the section cache namespace
+  static uint32_t layoutKey(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
+                            uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
+                            bool optimalLineBreaks);
+  // Path of the search posting index written alongside a section file. Lives in the layout
+  // namespace because its page numbers are only valid for that layout.
+  static std::string searchIndexPath(const Epub& epub, int spineIndex, uint32_t layoutKey);
+  // Path of the whole-book page table for a layout namespace (see BookPageTable)
+  static std::string pageTablePath(const Epub& epub, uint32_t layoutKey);
+  // Path of the anchor map written alongside a section file. Lives in the layout
+  // namespace because its page numbers are only valid for that layout.
+  static std::string anchorMapPath(const Epub& epub, int spineIndex, uint32_t layoutKey);
+  // Resolve a TOC anchor to its page via the persisted anchor map; returns -1 when the
+  // map or anchor is missing (callers fall back to the chapter top)
+  static int lookupAnchorPage(const Epub& epub, int spineIndex, uint32_t layoutKey, const std::string& anchor);
   bool loadSectionFile(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
-                       uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled);
+                       uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
+                       bool optimalLineBreaks);
   bool clearCache() const;
   bool createSectionFile(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                          uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
-                         const std::function<void()>& progressSetupFn = nullptr,
-                         const std::function<void(int)>& progressFn = nullptr);
+                         bool optimalLineBreaks, const std::function<void()>& progressSetupFn = nullptr,
+                         const std::function<void(int)>& progressFn = nullptr,
+                         const std::function<bool()>& abortFn = nullptr);
   std::unique_ptr<Page> loadPageFromSectionFile();
+  // Deserializes the given page into RAM so a later loadPageFromSectionFile() for it skips the SD
+  // read entirely. Used by the reader's idle prefetch to warm the next chapter's first page.
+  bool preloadPage(int page);
+  // Clamp-seek to a page; UINT16_MAX (and anything past the end) lands on the last page
+  void seekToPage(int page);
+  uint32_t getLutOffset() const { return lutOffset; }
+  // The given page's raw LUT word (file offset, top bit flagging a compressed extent), read
+  // from the LUT. Opaque to callers: the reader packs it into its resume manifest at close time
+  // and hands it back via restoreFromManifest(). Returns 0 when unavailable.
+  uint32_t getPagePosition(int page);
+  // Adopt header state captured in a resume manifest instead of reading it back from the section
+  // file, so opening a book skips the header read. The caller is responsible for checking that
+  // the manifest's layout parameters match the current settings.
+  bool restoreFromManifest(uint16_t manifestPageCount, uint32_t manifestLutOffset, int page, uint32_t pagePos);
 };
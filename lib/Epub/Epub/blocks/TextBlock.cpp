@@ -1,5 +1,6 @@
 #include "TextBlock.h"
 
+#include <BufferedFileReader.h>
 #include <GfxRenderer.h>
 #include <Serialization.h>
 
@@ -24,7 +25,28 @@ void TextBlock::render(const GfxRenderer& renderer, const int fontId, const int
   }
 }
 
-bool TextBlock::serialize(FsFile& file) const {
+void TextBlock::forEachWord(
+    const std::function<void(const std::string&, uint16_t, EpdFontFamily::Style)>& visitor) const {
+  if (words.size() != wordXpos.size() || words.size() != wordStyles.size()) {
+    Serial.printf("[%lu] [TXB] forEachWord skipped: size mismatch (words=%u, xpos=%u, styles=%u)\n", millis(),
+                  (uint32_t)words.size(), (uint32_t)wordXpos.size(), (uint32_t)wordStyles.size());
+    return;
+  }
+
+  auto wordIt = words.begin();
+  auto wordStylesIt = wordStyles.begin();
+  auto wordXposIt = wordXpos.begin();
+
+  for (size_t i = 0; i < words.size(); i++) {
+    visitor(*wordIt, *wordXposIt, *wordStylesIt);
+
+    std::advance(wordIt, 1);
+    std::advance(wordStylesIt, 1);
+    std::advance(wordXposIt, 1);
+  }
+}
+
+bool TextBlock::serialize(Print& file) const {
   if (words.size() != wordXpos.size() || words.size() != wordStyles.size()) {
     Serial.printf("[%lu] [TXB] Serialization failed: size mismatch (words=%u, xpos=%u, styles=%u)\n", millis(),
                   words.size(), wordXpos.size(), wordStyles.size());
@@ -43,15 +65,15 @@ bool TextBlock::serialize(FsFile& file) const {
   return true;
 }
 
-std::unique_ptr<TextBlock> TextBlock::deserialize(FsFile& file) {
+std::shared_ptr<TextBlock> TextBlock::deserialize(BufferedFileReader& in) {
   uint16_t wc;
-  std::list<std::string> words;
-  std::list<uint16_t> wordXpos;
-  std::list<EpdFontFamily::Style> wordStyles;
+  ParseList<std::string> words;
+  ParseList<uint16_t> wordXpos;
+  ParseList<EpdFontFamily::Style> wordStyles;
   Style style;
 
   // Word count
-  serialization::readPod(file, wc);
+  in.pod(wc);
 
   // Sanity check: prevent allocation of unreasonably large lists (max 10000 words per block)
   if (wc > 10000) {
@@ -63,12 +85,13 @@ std::unique_ptr<TextBlock> TextBlock::deserialize(FsFile& file) {
   words.resize(wc);
   wordXpos.resize(wc);
   wordStyles.resize(wc);
-  for (auto& w : words) serialization::readString(file, w);
-  for (auto& x : wordXpos) serialization::readPod(file, x);
-  for (auto& s : wordStyles) serialization::readPod(file, s);
+  for (auto& w : words) in.str(w);
+  for (auto& x : wordXpos) in.pod(x);
+  for (auto& s : wordStyles) in.pod(s);
 
   // Block style
-  serialization::readPod(file, style);
+  in.pod(style);
 
-  return std::unique_ptr<TextBlock>(new TextBlock(std::move(words), std::move(wordXpos), std::move(wordStyles), style));
+  return std::allocate_shared<TextBlock>(ParseArenaAllocator<TextBlock>(), std::move(words), std::move(wordXpos),
+                                         std::move(wordStyles), style);
 }
@@ -2,12 +2,16 @@
 #include <EpdFontFamily.h>
 #include <SdFat.h>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
 
+#include "../ParseArena.h"
 #include "Block.h"
 
+class BufferedFileReader;
+
 // Represents a line of text on a page
 class TextBlock final : public Block {
  public:
@@ -19,14 +23,14 @@ class TextBlock final : public Block {
   };
 
  private:
-  std::list<std::string> words;
-  std::list<uint16_t> wordXpos;
-  std::list<EpdFontFamily::Style> wordStyles;
+  ParseList<std::string> words;
+  ParseList<uint16_t> wordXpos;
+  ParseList<EpdFontFamily::Style> wordStyles;
   Style style;
 
  public:
-  explicit TextBlock(std::list<std::string> words, std::list<uint16_t> word_xpos,
-                     std::list<EpdFontFamily::Style> word_styles, const Style style)
+  explicit TextBlock(ParseList<std::string> words, ParseList<uint16_t> word_xpos,
+                     ParseList<EpdFontFamily::Style> word_styles, const Style style)
       : words(std::move(words)), wordXpos(std::move(word_xpos)), wordStyles(std::move(word_styles)), style(style) {}
   ~TextBlock() override = default;
   void setStyle(const Style style) { this->style = style; }
@@ -35,7 +39,12 @@ class TextBlock final : public Block {
   void layout(GfxRenderer& renderer) override {};
   // given a renderer works out where to break the words into lines
   void render(const GfxRenderer& renderer, int fontId, int x, int y) const;
+  // Visit (word, xPos, style) triples in order; used to compile pre-positioned glyph runs
+  void forEachWord(const std::function<void(const std::string&, uint16_t, EpdFontFamily::Style)>& visitor) const;
   BlockType getType() override { return TEXT_BLOCK; }
-  bool serialize(FsFile& file) const;
-  static std::unique_ptr<TextBlock> deserialize(FsFile& file);
+  bool serialize(Print& file) const;
+  // Allocated through the active ParseArena (like the word lists inside), so section-file loads
+  // recycle the reader's page arena instead of churning the heap. Reads come through the page
+  // loader's buffered window rather than per-field FsFile calls.
+  static std::shared_ptr<TextBlock> deserialize(BufferedFileReader& in);
 };
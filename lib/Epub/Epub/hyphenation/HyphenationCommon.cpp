@@ -167,6 +167,12 @@ void trimSurroundingPunctuationAndFootnote(std::vector<CodepointInfo>& cps) {
 
 std::vector<CodepointInfo> collectCodepoints(const std::string& word) {
   std::vector<CodepointInfo> cps;
+  collectCodepointsInto(word, cps);
+  return cps;
+}
+
+void collectCodepointsInto(const std::string& word, std::vector<CodepointInfo>& cps) {
+  cps.clear();
   cps.reserve(word.size());
 
   const unsigned char* base = reinterpret_cast<const unsigned char*>(word.c_str());
@@ -176,6 +182,4 @@ std::vector<CodepointInfo> collectCodepoints(const std::string& word) {
     const uint32_t cp = utf8NextCodepoint(&ptr);
     cps.push_back({cp, static_cast<size_t>(current - base)});
   }
-
-  return cps;
 }
@@ -23,3 +23,5 @@ bool isExplicitHyphen(uint32_t cp);
 bool isSoftHyphen(uint32_t cp);
 void trimSurroundingPunctuationAndFootnote(std::vector<CodepointInfo>& cps);
 std::vector<CodepointInfo> collectCodepoints(const std::string& word);
+// Variant that reuses the caller's buffer so tight loops avoid a fresh allocation per word
+void collectCodepointsInto(const std::string& word, std::vector<CodepointInfo>& cps);
@@ -11,16 +11,7 @@ namespace {
 
 // Maps a BCP-47 language tag to a language-specific hyphenator.
 const LanguageHyphenator* hyphenatorForLanguage(const std::string& langTag) {
-  if (langTag.empty()) return nullptr;
-
-  // Extract primary subtag and normalize to lowercase (e.g., "en-US" -> "en").
-  std::string primary;
-  primary.reserve(langTag.size());
-  for (char c : langTag) {
-    if (c == '-' || c == '_') break;
-    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
-    primary.push_back(c);
-  }
+  const std::string primary = Hyphenator::resolvePrimaryTag(langTag);
   if (primary.empty()) return nullptr;
 
   return getLanguageHyphenatorForPrimaryTag(primary);
@@ -31,67 +22,188 @@ size_t byteOffsetForIndex(const std::vector<CodepointInfo>& cps, const size_t in
   return (index < cps.size()) ? cps[index].byteOffset : (cps.empty() ? 0 : cps.back().byteOffset);
 }
 
-// Builds a vector of break information from explicit hyphen markers in the given codepoints.
-std::vector<Hyphenator::BreakInfo> buildExplicitBreakInfos(const std::vector<CodepointInfo>& cps) {
-  std::vector<Hyphenator::BreakInfo> breaks;
+// Memoizes break points per word so repeated hyphenation attempts during a section build skip
+// the codepoint walk and trie lookups entirely. Same open-addressing convention as the word
+// width cache in ParsedText: entries are keyed by an FNV-1a hash of the word bytes, fallback
+// flag and active language, compared by hash + length, and no word bytes are stored.
+class BreakCache {
+ public:
+  static constexpr size_t MAX_BREAKS = 12;
+
+ private:
+  struct Slot {
+    uint64_t hash = 0;
+    uint8_t len = 0;
+    uint8_t count = 0;
+    bool used = false;
+    uint8_t offsets[MAX_BREAKS] = {};  // Cacheable words are <= 255 bytes, so offsets fit a byte
+    uint8_t needsHyphen[MAX_BREAKS] = {};
+  };
+
+  static constexpr size_t SLOT_COUNT = 256;
+  static constexpr size_t PROBE_DEPTH = 8;
+
+  Slot slots[SLOT_COUNT] = {};
+
+ public:
+  static uint64_t keyHash(const std::string& word, const bool includeFallback, const void* language) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : word) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ull;
+    }
+    hash ^= includeFallback ? 1u : 0u;
+    hash *= 1099511628211ull;
+    hash ^= reinterpret_cast<uintptr_t>(language);
+    hash *= 1099511628211ull;
+    return hash;
+  }
 
-  // Scan every codepoint looking for explicit/soft hyphen markers that are surrounded by letters.
-  for (size_t i = 1; i + 1 < cps.size(); ++i) {
-    const uint32_t cp = cps[i].value;
-    if (!isExplicitHyphen(cp) || !isAlphabetic(cps[i - 1].value) || !isAlphabetic(cps[i + 1].value)) {
-      continue;
+  bool lookup(const uint64_t hash, const size_t len, Hyphenator::BreakInfo* out, const size_t cap,
+              size_t* countOut) const {
+    for (size_t i = 0; i < PROBE_DEPTH; i++) {
+      const Slot& slot = slots[(hash + i) % SLOT_COUNT];
+      if (!slot.used) {
+        return false;
+      }
+      if (slot.hash == hash && slot.len == len) {
+        const size_t count = slot.count < cap ? slot.count : cap;
+        for (size_t j = 0; j < count; j++) {
+          out[j] = {slot.offsets[j], slot.needsHyphen[j] != 0};
+        }
+        *countOut = count;
+        return true;
+      }
     }
-    // Offset points to the next codepoint so rendering starts after the hyphen marker.
-    breaks.push_back({cps[i + 1].byteOffset, isSoftHyphen(cp)});
+    return false;
   }
 
-  return breaks;
-}
+  void insert(const uint64_t hash, const size_t len, const Hyphenator::BreakInfo* breaks, const size_t count) {
+    Slot* target = nullptr;
+    for (size_t i = 0; i < PROBE_DEPTH; i++) {
+      Slot& slot = slots[(hash + i) % SLOT_COUNT];
+      if (!slot.used) {
+        target = &slot;
+        break;
+      }
+      if (!target) {
+        target = &slot;
+      }
+    }
+    target->hash = hash;
+    target->len = static_cast<uint8_t>(len);
+    target->count = static_cast<uint8_t>(count);
+    target->used = true;
+    for (size_t j = 0; j < count; j++) {
+      target->offsets[j] = static_cast<uint8_t>(breaks[j].byteOffset);
+      target->needsHyphen[j] = breaks[j].requiresInsertedHyphen ? 1 : 0;
+    }
+  }
+};
+
+BreakCache breakCache;
 
 }  // namespace
 
 std::vector<Hyphenator::BreakInfo> Hyphenator::breakOffsets(const std::string& word, const bool includeFallback) {
-  if (word.empty()) {
-    return {};
+  BreakInfo buffer[128];
+  const size_t count = breakOffsetsInto(word, includeFallback, buffer, 128);
+  return std::vector<BreakInfo>(buffer, buffer + count);
+}
+
+size_t Hyphenator::breakOffsetsInto(const std::string& word, const bool includeFallback, BreakInfo* out,
+                                    const size_t cap) {
+  if (word.empty() || out == nullptr || cap == 0) {
+    return 0;
   }
 
-  // Convert to codepoints and normalize word boundaries.
-  auto cps = collectCodepoints(word);
-  trimSurroundingPunctuationAndFootnote(cps);
   const auto* hyphenator = cachedHyphenator_;
-
-  // Explicit hyphen markers (soft or hard) take precedence over language breaks.
-  auto explicitBreakInfos = buildExplicitBreakInfos(cps);
-  if (!explicitBreakInfos.empty()) {
-    return explicitBreakInfos;
+  const bool cacheable = word.size() <= UINT8_MAX;
+  uint64_t hash = 0;
+  if (cacheable) {
+    hash = BreakCache::keyHash(word, includeFallback, hyphenator);
+    size_t cachedCount;
+    if (breakCache.lookup(hash, word.size(), out, cap, &cachedCount)) {
+      return cachedCount;
+    }
   }
 
-  // Ask language hyphenator for legal break points.
-  std::vector<size_t> indexes;
-  if (hyphenator) {
-    indexes = hyphenator->breakIndexes(cps);
+  // Convert to codepoints and normalize word boundaries. The scratch buffer is reused across
+  // calls; layout invokes this once per overflowing word under the rendering mutex.
+  static std::vector<CodepointInfo> cps;
+  collectCodepointsInto(word, cps);
+  trimSurroundingPunctuationAndFootnote(cps);
+
+  size_t count = 0;
+  bool truncated = false;
+
+  // Explicit hyphen markers (soft or hard) take precedence over language breaks. The offset
+  // points to the next codepoint so rendering starts after the hyphen marker.
+  for (size_t i = 1; i + 1 < cps.size(); ++i) {
+    const uint32_t cp = cps[i].value;
+    if (!isExplicitHyphen(cp) || !isAlphabetic(cps[i - 1].value) || !isAlphabetic(cps[i + 1].value)) {
+      continue;
+    }
+    if (count == cap) {
+      truncated = true;
+      break;
+    }
+    out[count++] = {cps[i + 1].byteOffset, isSoftHyphen(cp)};
   }
 
-  // Only add fallback breaks if needed
-  if (includeFallback && indexes.empty()) {
-    const size_t minPrefix = hyphenator ? hyphenator->minPrefix() : LiangWordConfig::kDefaultMinPrefix;
-    const size_t minSuffix = hyphenator ? hyphenator->minSuffix() : LiangWordConfig::kDefaultMinSuffix;
-    for (size_t idx = minPrefix; idx + minSuffix <= cps.size(); ++idx) {
-      indexes.push_back(idx);
+  if (count == 0 && !truncated) {
+    // Ask the language hyphenator for legal break points.
+    if (hyphenator) {
+      for (const size_t idx : hyphenator->breakIndexes(cps)) {
+        if (count == cap) {
+          truncated = true;
+          break;
+        }
+        out[count++] = {byteOffsetForIndex(cps, idx), true};
+      }
+    }
+
+    // Only add fallback breaks if needed
+    if (count == 0 && !truncated && includeFallback) {
+      const size_t minPrefix = hyphenator ? hyphenator->minPrefix() : LiangWordConfig::kDefaultMinPrefix;
+      const size_t minSuffix = hyphenator ? hyphenator->minSuffix() : LiangWordConfig::kDefaultMinSuffix;
+      for (size_t idx = minPrefix; idx + minSuffix <= cps.size(); ++idx) {
+        if (count == cap) {
+          truncated = true;
+          break;
+        }
+        out[count++] = {byteOffsetForIndex(cps, idx), true};
+      }
     }
   }
 
-  if (indexes.empty()) {
-    return {};
+  // Negative results (count == 0) are worth caching too - they are the common case for short words
+  if (cacheable && !truncated && count <= BreakCache::MAX_BREAKS) {
+    breakCache.insert(hash, word.size(), out, count);
   }
+  return count;
+}
 
-  std::vector<Hyphenator::BreakInfo> breaks;
-  breaks.reserve(indexes.size());
-  for (const size_t idx : indexes) {
-    breaks.push_back({byteOffsetForIndex(cps, idx), true});
+void Hyphenator::setPreferredLanguage(const std::string& lang) { cachedHyphenator_ = hyphenatorForLanguage(lang); }
+
+std::string Hyphenator::resolvePrimaryTag(const std::string& lang) {
+  // Extract primary subtag and normalize to lowercase (e.g., "en-US" -> "en").
+  std::string primary;
+  primary.reserve(lang.size());
+  for (char c : lang) {
+    if (c == '-' || c == '_') break;
+    if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    primary.push_back(c);
   }
+  return primary;
+}
 
-  return breaks;
+void Hyphenator::setPreferredPrimaryTag(const std::string& primaryTag) {
+  cachedHyphenator_ = primaryTag.empty() ? nullptr : getLanguageHyphenatorForPrimaryTag(primaryTag);
 }
 
-void Hyphenator::setPreferredLanguage(const std::string& lang) { cachedHyphenator_ = hyphenatorForLanguage(lang); }
+void Hyphenator::preloadPatterns() {
+  if (cachedHyphenator_) {
+    cachedHyphenator_->preload();
+  }
+}
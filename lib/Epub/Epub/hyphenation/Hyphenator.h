@@ -16,9 +16,24 @@ class Hyphenator {
   // minimum prefix/suffix constraints are returned even if no language-specific rule matches.
   static std::vector<BreakInfo> breakOffsets(const std::string& word, bool includeFallback);
 
+  // Scratch-buffer variant for the layout hot path: fills `out` with up to `cap` break points and returns the count.
+  // Reuses internal scratch and memoizes results per word, so section builds don't allocate per call.
+  static size_t breakOffsetsInto(const std::string& word, bool includeFallback, BreakInfo* out, size_t cap);
+
   // Provide a publication-level language hint (e.g. "en", "en-US", "ru") used to select hyphenation rules.
   static void setPreferredLanguage(const std::string& lang);
 
+  // Normalize a BCP-47 tag to its lowercase primary subtag (e.g. "en-US" -> "en"). Book caches
+  // persist this at metadata build time so selection at layout time skips the normalization.
+  static std::string resolvePrimaryTag(const std::string& lang);
+
+  // Select rules by an already resolved primary tag (see resolvePrimaryTag)
+  static void setPreferredPrimaryTag(const std::string& primaryTag);
+
+  // Pull the active language's flash-mapped trie pages into cache. Called before a section
+  // build so the first hyphenated word of the layout loop pays no flash fault.
+  static void preloadPatterns();
+
  private:
   static const LanguageHyphenator* cachedHyphenator_;
 };
\ No newline at end of file
@@ -17,6 +17,17 @@ class LanguageHyphenator {
   size_t minPrefix() const { return config_.minPrefix; }
   size_t minSuffix() const { return config_.minSuffix; }
 
+  // Stride-read the serialized patterns so the flash-mapped trie pages are cache-warm
+  // before the layout loop asks for its first break
+  void preload() const {
+    volatile uint32_t sum = 0;
+    for (size_t i = 0; i < patterns_.size; i += 64) {
+      // Plain assignment: compound assignment on a volatile lvalue is deprecated in C++20
+      sum = sum + patterns_.data[i];
+    }
+    (void)sum;
+  }
+
  protected:
   const SerializedHyphenationPatterns& patterns_;
   LiangWordConfig config_;
@@ -1,45 +1,187 @@
 #include "LanguageRegistry.h"
 
-#include <algorithm>
 #include <array>
+#include <cstring>
+#include <memory>
 
 #include "HyphenationCommon.h"
-#include "generated/hyph-de.trie.h"
-#include "generated/hyph-en.trie.h"
-#include "generated/hyph-es.trie.h"
-#include "generated/hyph-fr.trie.h"
-#include "generated/hyph-ru.trie.h"
+
+#ifdef ARDUINO
+#include <HardwareSerial.h>
+#include <esp_partition.h>
+#else
+#include <fstream>
+#include <string>
+#endif
 
 namespace {
 
-// English hyphenation patterns (3/3 minimum prefix/suffix length)
-LanguageHyphenator englishHyphenator(en_us_patterns, isLatinLetter, toLowerLatin, 3, 3);
-LanguageHyphenator frenchHyphenator(fr_patterns, isLatinLetter, toLowerLatin);
-LanguageHyphenator germanHyphenator(de_patterns, isLatinLetter, toLowerLatin);
-LanguageHyphenator russianHyphenator(ru_ru_patterns, isCyrillicLetter, toLowerCyrillic);
-LanguageHyphenator spanishHyphenator(es_patterns, isLatinLetter, toLowerLatin);
-
-using EntryArray = std::array<LanguageEntry, 5>;
-
-const EntryArray& entries() {
-  static const EntryArray kEntries = {{{"english", "en", &englishHyphenator},
-                                       {"french", "fr", &frenchHyphenator},
-                                       {"german", "de", &germanHyphenator},
-                                       {"russian", "ru", &russianHyphenator},
-                                       {"spanish", "es", &spanishHyphenator}}};
-  return kEntries;
+// Language-specific dials. The trie payloads themselves live in the `hyph` flash partition
+// (image built by scripts/generate_hyphenation_trie.py) rather than being linked into the binary.
+struct LanguageConfig {
+  const char* cliName;
+  const char* primaryTag;
+  bool (*isLetter)(uint32_t);
+  uint32_t (*toLower)(uint32_t);
+  size_t minPrefix;
+  size_t minSuffix;
+};
+
+// English keeps the 3/3 minima its patterns were tuned for; the rest use the TeX default 2/2
+constexpr std::array<LanguageConfig, 5> kConfigs = {{
+    {"english", "en", isLatinLetter, toLowerLatin, 3, 3},
+    {"french", "fr", isLatinLetter, toLowerLatin, LiangWordConfig::kDefaultMinPrefix,
+     LiangWordConfig::kDefaultMinSuffix},
+    {"german", "de", isLatinLetter, toLowerLatin, LiangWordConfig::kDefaultMinPrefix,
+     LiangWordConfig::kDefaultMinSuffix},
+    {"russian", "ru", isCyrillicLetter, toLowerCyrillic, LiangWordConfig::kDefaultMinPrefix,
+     LiangWordConfig::kDefaultMinSuffix},
+    {"spanish", "es", isLatinLetter, toLowerLatin, LiangWordConfig::kDefaultMinPrefix,
+     LiangWordConfig::kDefaultMinSuffix},
+}};
+
+// On-flash image layout, mirrored by scripts/generate_hyphenation_trie.py
+struct HyphImageHeader {
+  char magic[4];  // "XHYP"
+  uint8_t version;
+  uint8_t trieCount;
+  uint16_t reserved;
+};
+
+struct HyphImageEntry {
+  char tag[8];
+  uint32_t offset;
+  uint32_t size;
+};
+
+constexpr uint8_t HYPH_IMAGE_VERSION = 1;
+
+#ifdef ARDUINO
+
+// Maps the hyph partition once; the mapping stays live for the firmware's lifetime so
+// LiangHyphenation can walk the tries straight out of flash
+const uint8_t* hyphImage(size_t* imageSize) {
+  static const uint8_t* image = nullptr;
+  static size_t size = 0;
+  static bool attempted = false;
+
+  if (!attempted) {
+    attempted = true;
+    const esp_partition_t* partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "hyph");
+    if (!partition) {
+      Serial.printf("[%lu] [HYP] No hyph partition found, language rules unavailable\n", millis());
+    } else {
+      const void* mapped = nullptr;
+      spi_flash_mmap_handle_t handle;
+      if (esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) == ESP_OK) {
+        image = static_cast<const uint8_t*>(mapped);
+        size = partition->size;
+      } else {
+        Serial.printf("[%lu] [HYP] Failed to map hyph partition\n", millis());
+      }
+    }
+  }
+
+  *imageSize = size;
+  return image;
+}
+
+bool loadTrie(const char* primaryTag, SerializedHyphenationPatterns* out) {
+  size_t imageSize = 0;
+  const uint8_t* image = hyphImage(&imageSize);
+  if (!image || imageSize < sizeof(HyphImageHeader)) {
+    return false;
+  }
+
+  HyphImageHeader header;
+  memcpy(&header, image, sizeof(header));
+  if (memcmp(header.magic, "XHYP", 4) != 0 || header.version != HYPH_IMAGE_VERSION) {
+    Serial.printf("[%lu] [HYP] Invalid hyph partition image\n", millis());
+    return false;
+  }
+
+  for (uint8_t i = 0; i < header.trieCount; i++) {
+    const size_t entryOffset = sizeof(HyphImageHeader) + i * sizeof(HyphImageEntry);
+    if (entryOffset + sizeof(HyphImageEntry) > imageSize) {
+      return false;
+    }
+    HyphImageEntry entry;
+    memcpy(&entry, image + entryOffset, sizeof(entry));
+    if (strncmp(entry.tag, primaryTag, sizeof(entry.tag)) != 0) {
+      continue;
+    }
+    if (entry.offset + entry.size > imageSize) {
+      Serial.printf("[%lu] [HYP] Trie '%s' out of partition bounds\n", millis(), primaryTag);
+      return false;
+    }
+    out->data = image + entry.offset;
+    out->size = entry.size;
+    return true;
+  }
+  return false;
+}
+
+#else
+
+// Host builds (the hyphenation eval harness) read the raw hypher tries from the repo instead of
+// a flash partition; the buffers intentionally stay alive for the process lifetime
+bool loadTrie(const char* primaryTag, SerializedHyphenationPatterns* out) {
+  const std::string path = std::string("lib/Epub/Epub/hyphenation/tries/") + primaryTag + ".bin";
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  const auto size = static_cast<size_t>(file.tellg());
+  auto* buffer = new uint8_t[size];
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size));
+  out->data = buffer;
+  out->size = size;
+  return true;
+}
+
+#endif
+
+// Descriptors and hyphenators for every language whose trie is actually present, built once on
+// first use. LanguageHyphenator keeps a reference to its descriptor, so both arrays live here
+// in static storage.
+class Registry {
+  std::array<SerializedHyphenationPatterns, kConfigs.size()> patterns{};
+  std::array<std::unique_ptr<LanguageHyphenator>, kConfigs.size()> hyphenators;
+  std::array<LanguageEntry, kConfigs.size()> languageEntries{};
+  size_t count = 0;
+
+ public:
+  Registry() {
+    for (const auto& config : kConfigs) {
+      if (!loadTrie(config.primaryTag, &patterns[count])) {
+        continue;
+      }
+      hyphenators[count].reset(new LanguageHyphenator(patterns[count], config.isLetter, config.toLower,
+                                                      config.minPrefix, config.minSuffix));
+      languageEntries[count] = {config.cliName, config.primaryTag, hyphenators[count].get()};
+      count++;
+    }
+  }
+
+  LanguageEntryView view() const { return LanguageEntryView{languageEntries.data(), count}; }
+};
+
+const Registry& registry() {
+  static const Registry kRegistry;
+  return kRegistry;
 }
 
 }  // namespace
 
 const LanguageHyphenator* getLanguageHyphenatorForPrimaryTag(const std::string& primaryTag) {
-  const auto& allEntries = entries();
-  const auto it = std::find_if(allEntries.begin(), allEntries.end(),
-                               [&primaryTag](const LanguageEntry& entry) { return primaryTag == entry.primaryTag; });
-  return (it != allEntries.end()) ? it->hyphenator : nullptr;
+  for (const LanguageEntry& entry : registry().view()) {
+    if (primaryTag == entry.primaryTag) {
+      return entry.hyphenator;
+    }
+  }
+  return nullptr;
 }
 
-LanguageEntryView getLanguageEntries() {
-  const auto& allEntries = entries();
-  return LanguageEntryView{allEntries.data(), allEntries.size()};
-}
+LanguageEntryView getLanguageEntries() { return registry().view(); }
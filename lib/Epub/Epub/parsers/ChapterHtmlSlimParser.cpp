@@ -6,6 +6,8 @@
 #include <expat.h>
 
 #include "../Page.h"
+#include "CssLiteParser.h"
+#include "ExpatArenaSuite.h"
 
 const char* HEADER_TAGS[] = {"h1", "h2", "h3", "h4", "h5", "h6"};
 constexpr int NUM_HEADER_TAGS = sizeof(HEADER_TAGS) / sizeof(HEADER_TAGS[0]);
@@ -28,6 +30,100 @@ constexpr int NUM_IMAGE_TAGS = sizeof(IMAGE_TAGS) / sizeof(IMAGE_TAGS[0]);
 const char* SKIP_TAGS[] = {"head"};
 constexpr int NUM_SKIP_TAGS = sizeof(SKIP_TAGS) / sizeof(SKIP_TAGS[0]);
 
+// Word cache (parse product) file format: version byte, the paragraph alignment the cache was
+// written with, then a flat stream of records. The word stream is independent of font, viewport
+// and layout settings, so it survives every settings change that would invalidate a section file.
+// v4 adds inline image markers so layout-only rebuilds re-decode the images; v5 invalidates
+// caches whose word styles predate class-driven styling
+constexpr uint8_t WORD_CACHE_VERSION = 5;
+constexpr uint8_t WORD_CACHE_TAG_BLOCK = 0x01;   // uint8 block style
+constexpr uint8_t WORD_CACHE_TAG_WORD = 0x02;    // uint8 font style, uint8 length, bytes
+constexpr uint8_t WORD_CACHE_TAG_END = 0x03;     // no payload - marks the cache as complete
+constexpr uint8_t WORD_CACHE_TAG_ANCHOR = 0x04;  // uint8 length, bytes (anchor id)
+constexpr uint8_t WORD_CACHE_TAG_IMAGE = 0x05;   // uint8 length, bytes (image src)
+
+// Builds run for seconds on big chapters; hand the input task a slice this often so buttons
+// queue up instead of going dead, and sync the word cache so a power cut mid-build leaves a
+// cleanly detectable partial file instead of silent garbage
+constexpr uint32_t BUILD_YIELD_INTERVAL_MS = 100;
+
+// Feed expat from SD in large slices; 1KB chunks made the parse loop SD-call bound and
+// fragmented characterData callbacks. 16KB lives in expat's own reusable buffer, allocated
+// once per parse.
+constexpr size_t PARSE_FEED_SIZE = 16 * 1024;
+
+// The named HTML entities that actually occur in EPUB body text. Decoding them before expat
+// sees the bytes keeps characterData from splitting a word at every entity (so "don&rsquo;t"
+// assembles as one word), and rescues books whose XHTML uses them without a DTD declaration,
+// where expat stops with an undefined-entity error. The XML predefined five (&amp; &lt; &gt;
+// &quot; &apos;) are deliberately left for expat - decoding those early would re-introduce
+// raw markup characters into the stream. Every replacement is shorter than its entity, so
+// the rewrite can run in place.
+constexpr struct {
+  const char* name;
+  const char* utf8;
+} NAMED_ENTITIES[] = {
+    {"nbsp", "\xC2\xA0"},   {"shy", "\xC2\xAD"},    {"mdash", "\xE2\x80\x94"}, {"ndash", "\xE2\x80\x93"},
+    {"hellip", "\xE2\x80\xA6"}, {"lsquo", "\xE2\x80\x98"}, {"rsquo", "\xE2\x80\x99"}, {"ldquo", "\xE2\x80\x9C"},
+    {"rdquo", "\xE2\x80\x9D"},  {"copy", "\xC2\xA9"},  {"reg", "\xC2\xAE"},       {"trade", "\xE2\x84\xA2"},
+    {"deg", "\xC2\xB0"},    {"middot", "\xC2\xB7"}, {"laquo", "\xC2\xAB"},     {"raquo", "\xC2\xBB"},
+    {"sect", "\xC2\xA7"},   {"para", "\xC2\xB6"},   {"times", "\xC3\x97"},     {"eacute", "\xC3\xA9"},
+};
+
+// Longest decoded name is "&hellip;" (8 bytes); anything longer passes through untouched
+constexpr size_t MAX_ENTITY_BYTES = 10;
+
+// Rewrites NAMED_ENTITIES in place within buf[0..len) and returns the new length. When the
+// chunk ends inside a possible entity and more input follows, the fragment is moved to
+// `carry` (at most MAX_ENTITY_BYTES - 1 bytes) and excluded from the returned length; the
+// caller prepends it to the next feed.
+size_t decodeCommonEntities(char* buf, const size_t len, const bool atEof, char* carry, size_t& carryLen) {
+  carryLen = 0;
+  char* write = buf;
+  size_t i = 0;
+  while (i < len) {
+    if (buf[i] != '&') {
+      *write++ = buf[i++];
+      continue;
+    }
+
+    // Find the terminating ';' within entity range
+    const size_t scanEnd = len < i + MAX_ENTITY_BYTES ? len : i + MAX_ENTITY_BYTES;
+    size_t semi = i + 1;
+    while (semi < scanEnd && buf[semi] != ';') semi++;
+
+    if (semi >= scanEnd) {
+      if (!atEof && len - i < MAX_ENTITY_BYTES) {
+        // Possibly split across the chunk boundary - hold the tail back for the next feed
+        carryLen = len - i;
+        memcpy(carry, buf + i, carryLen);
+        break;
+      }
+      // '&' with no terminator in range (bare ampersand or a long entity): pass through
+      *write++ = buf[i++];
+      continue;
+    }
+
+    const size_t nameLen = semi - i - 1;
+    const char* replacement = nullptr;
+    for (const auto& entity : NAMED_ENTITIES) {
+      if (strncmp(entity.name, buf + i + 1, nameLen) == 0 && entity.name[nameLen] == '\0') {
+        replacement = entity.utf8;
+        break;
+      }
+    }
+
+    if (replacement) {
+      while (*replacement) *write++ = *replacement++;
+      i = semi + 1;
+    } else {
+      // Unknown or predefined entity: copy through unchanged for expat to handle
+      while (i <= semi) *write++ = buf[i++];
+    }
+  }
+  return write - buf;
+}
+
 bool isWhitespace(const char c) { return c == ' ' || c == '\r' || c == '\n' || c == '\t'; }
 
 // given the start and end of a tag, check to see if it matches a known tag
@@ -53,12 +149,163 @@ void ChapterHtmlSlimParser::flushPartWordBuffer() {
   }
   // flush the buffer
   partWordBuffer[partWordBufferIndex] = '\0';
-  currentTextBlock->addWord(partWordBuffer, fontStyle);
+  emitWord(partWordBuffer, fontStyle);
   partWordBufferIndex = 0;
 }
 
+// add a word to the current text block, teeing it to the word cache when one is being written
+void ChapterHtmlSlimParser::emitWord(const char* word, const EpdFontFamily::Style style) {
+  if (wordCacheFile && !wordCacheWriteFailed) {
+    const size_t len = strlen(word);
+    if (len > 0 && len <= MAX_WORD_SIZE) {
+      const uint8_t record[3] = {WORD_CACHE_TAG_WORD, static_cast<uint8_t>(style), static_cast<uint8_t>(len)};
+      if (wordCacheFile.write(record, sizeof(record)) != sizeof(record) || wordCacheFile.write(word, len) != len) {
+        wordCacheWriteFailed = true;
+      }
+    }
+  }
+  currentTextBlock->addWord(word, style);
+}
+
+void ChapterHtmlSlimParser::writeBlockRecord(const TextBlock::Style style) {
+  if (!wordCacheFile || wordCacheWriteFailed) {
+    return;
+  }
+  const uint8_t record[2] = {WORD_CACHE_TAG_BLOCK, static_cast<uint8_t>(style)};
+  if (wordCacheFile.write(record, sizeof(record)) != sizeof(record)) {
+    wordCacheWriteFailed = true;
+  }
+}
+
+void ChapterHtmlSlimParser::finishWordCacheWrite(const bool success) {
+  if (!wordCacheFile) {
+    return;
+  }
+  if (success && !wordCacheWriteFailed) {
+    // Replay refuses caches without this marker, so an interrupted build can never be
+    // mistaken for a short chapter
+    if (wordCacheFile.write(&WORD_CACHE_TAG_END, 1) != 1) {
+      wordCacheWriteFailed = true;
+    }
+  }
+  wordCacheFile.close();
+  if (!success || wordCacheWriteFailed) {
+    // A partial word cache would replay as a truncated chapter - remove it
+    SdMan.remove(wordCachePath.c_str());
+  }
+}
+
+// Note an anchor id at the current parse position, teeing it to the word cache when one is
+// being written. It resolves to a page when the next laid-out line is committed.
+void ChapterHtmlSlimParser::registerAnchor(const char* id) {
+  const size_t len = strlen(id);
+  if (len == 0 || len > MAX_WORD_SIZE) {
+    return;
+  }
+  if (wordCacheFile && !wordCacheWriteFailed) {
+    const uint8_t record[2] = {WORD_CACHE_TAG_ANCHOR, static_cast<uint8_t>(len)};
+    if (wordCacheFile.write(record, sizeof(record)) != sizeof(record) || wordCacheFile.write(id, len) != len) {
+      wordCacheWriteFailed = true;
+    }
+  }
+  pendingAnchorIds.emplace_back(id, len);
+}
+
+// Decode and place an inline image as its own block, teeing a marker to the word cache so
+// replays reproduce it. Commits everything laid out before the image, then drops it centered
+// at the next position it fits - images never split across pages. Returns false (with all
+// state untouched) when the src can't be decoded, so the caller can emit the placeholder.
+bool ChapterHtmlSlimParser::placeImage(const char* src) {
+  if (!imageElementFn) {
+    return false;
+  }
+  const size_t len = strlen(src);
+  if (len == 0 || len > MAX_WORD_SIZE) {
+    return false;
+  }
+  const std::shared_ptr<PageImage> image = imageElementFn(src);
+  if (!image || image->getWidth() == 0 || image->getHeight() == 0 || image->getWidth() > viewportWidth ||
+      image->getHeight() > viewportHeight) {
+    return false;
+  }
+
+  if (wordCacheFile && !wordCacheWriteFailed) {
+    const uint8_t record[2] = {WORD_CACHE_TAG_IMAGE, static_cast<uint8_t>(len)};
+    if (wordCacheFile.write(record, sizeof(record)) != sizeof(record) || wordCacheFile.write(src, len) != len) {
+      wordCacheWriteFailed = true;
+    }
+  }
+
+  // Lay out everything before the image; the fresh block takes whatever text follows it
+  if (partWordBufferIndex > 0) {
+    flushPartWordBuffer();
+  }
+  startNewTextBlock(static_cast<TextBlock::Style>(paragraphAlignment));
+
+  if (!currentPage) {
+    currentPage.reset(new Page());
+    currentPageNextY = 0;
+  }
+  if (currentPageNextY > 0 && currentPageNextY + image->getHeight() > viewportHeight) {
+    completePageFn(std::move(currentPage));
+    pagesEmitted++;
+    currentPage.reset(new Page());
+    currentPageNextY = 0;
+  }
+
+  // Anchors waiting for content resolve to the image's page
+  if (!pendingAnchorIds.empty()) {
+    for (auto& id : pendingAnchorIds) {
+      anchorPages.emplace_back(std::move(id), pagesEmitted);
+    }
+    pendingAnchorIds.clear();
+  }
+
+  image->xPos = static_cast<int16_t>((viewportWidth - image->getWidth()) / 2);
+  image->yPos = currentPageNextY;
+  currentPage->elements.push_back(image);
+  currentPageNextY += image->getHeight();
+  return true;
+}
+
+// Merge the compiled styles of every class in the element's class attribute (flags accumulate,
+// the last alignment wins - the same cascade the table itself uses)
+CssClassStyle ChapterHtmlSlimParser::resolveClassStyle(const XML_Char** atts) const {
+  CssClassStyle merged;
+  if (classStyles == nullptr || classStyles->empty() || atts == nullptr) {
+    return merged;
+  }
+  const char* classAttr = nullptr;
+  for (int i = 0; atts[i]; i += 2) {
+    if (strcmp(atts[i], "class") == 0) {
+      classAttr = atts[i + 1];
+      break;
+    }
+  }
+  if (classAttr == nullptr) {
+    return merged;
+  }
+  // The attribute is a whitespace-separated class list
+  const char* pos = classAttr;
+  while (*pos) {
+    while (*pos && isWhitespace(*pos)) pos++;
+    const char* start = pos;
+    while (*pos && !isWhitespace(*pos)) pos++;
+    if (pos > start) {
+      if (const CssClassStyle* style = classStyles->lookup(start, pos - start)) {
+        merged.flags |= style->flags;
+        if (style->flags & CssClassStyle::HAS_ALIGNMENT) {
+          merged.alignment = style->alignment;
+        }
+      }
+    }
+  }
+  return merged;
+}
+
 // start a new text block if needed
 void ChapterHtmlSlimParser::startNewTextBlock(const TextBlock::Style style) {
+  writeBlockRecord(style);
   if (currentTextBlock) {
     // already have a text block running and it is empty - just reuse it
     if (currentTextBlock->isEmpty()) {
@@ -68,11 +315,29 @@ void ChapterHtmlSlimParser::startNewTextBlock(const TextBlock::Style style) {
 
     makePages();
   }
-  currentTextBlock.reset(new ParsedText(style, extraParagraphSpacing, hyphenationEnabled));
+  currentTextBlock.reset(new ParsedText(style, extraParagraphSpacing, hyphenationEnabled, optimalLineBreaks));
 }
 
 void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char* name, const XML_Char** atts) {
   auto* self = static_cast<ChapterHtmlSlimParser*>(userData);
+  const bool wasSkipping = self->skipUntilDepth < self->depth;
+
+  // Dispatch first: an element that opens a new block lays out the *previous* block's lines,
+  // and this element's anchors belong to whatever gets placed after that
+  startElementImpl(userData, name, atts);
+
+  if (wasSkipping || atts == nullptr) {
+    return;
+  }
+  for (int i = 0; atts[i]; i += 2) {
+    if (strcmp(atts[i], "id") == 0 || (strcmp(name, "a") == 0 && strcmp(atts[i], "name") == 0)) {
+      self->registerAnchor(atts[i + 1]);
+    }
+  }
+}
+
+void ChapterHtmlSlimParser::startElementImpl(void* userData, const XML_Char* name, const XML_Char** atts) {
+  auto* self = static_cast<ChapterHtmlSlimParser*>(userData);
 
   // Middle of skip
   if (self->skipUntilDepth < self->depth) {
@@ -96,19 +361,32 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
   }
 
   if (matches(name, IMAGE_TAGS, NUM_IMAGE_TAGS)) {
-    // TODO: Start processing image tags
-    std::string alt = "[Image]";
+    const char* src = nullptr;
+    const char* altText = nullptr;
     if (atts != nullptr) {
       for (int i = 0; atts[i]; i += 2) {
-        if (strcmp(atts[i], "alt") == 0) {
-          if (strlen(atts[i + 1]) > 0) {
-            alt = "[Image: " + std::string(atts[i + 1]) + "]";
-          }
-          break;
+        if (strcmp(atts[i], "src") == 0) {
+          src = atts[i + 1];
+        } else if (strcmp(atts[i], "alt") == 0) {
+          altText = atts[i + 1];
         }
       }
     }
 
+    // Decode to a ready-to-blit element at build time; page turns then pay nothing. Sources
+    // that can't be decoded fall through to the alt-text placeholder below.
+    if (src != nullptr && self->placeImage(src)) {
+      // Skip image contents (skip until parent as we pre-advance depth, like tables)
+      self->depth += 1;
+      self->skipUntilDepth = self->depth - 1;
+      return;
+    }
+
+    std::string alt = "[Image]";
+    if (altText != nullptr && strlen(altText) > 0) {
+      alt = "[Image: " + std::string(altText) + "]";
+    }
+
     Serial.printf("[%lu] [EHP] Image alt: %s\n", millis(), alt.c_str());
 
     self->startNewTextBlock(TextBlock::CENTER_ALIGN);
@@ -141,8 +419,20 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
     }
   }
 
+  // Class-driven styling: bold/italic scope to the element's subtree exactly like <b>/<i>,
+  // and an alignment overrides the default for whichever block style is chosen below
+  const CssClassStyle classStyle = self->resolveClassStyle(atts);
+  if (classStyle.flags & CssClassStyle::BOLD) {
+    self->boldUntilDepth = std::min(self->boldUntilDepth, self->depth);
+  }
+  if (classStyle.flags & CssClassStyle::ITALIC) {
+    self->italicUntilDepth = std::min(self->italicUntilDepth, self->depth);
+  }
+
   if (matches(name, HEADER_TAGS, NUM_HEADER_TAGS)) {
-    self->startNewTextBlock(TextBlock::CENTER_ALIGN);
+    self->startNewTextBlock(classStyle.flags & CssClassStyle::HAS_ALIGNMENT
+                                ? static_cast<TextBlock::Style>(classStyle.alignment)
+                                : TextBlock::CENTER_ALIGN);
     self->boldUntilDepth = std::min(self->boldUntilDepth, self->depth);
     self->depth += 1;
     return;
@@ -159,9 +449,11 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
       return;
     }
 
-    self->startNewTextBlock(static_cast<TextBlock::Style>(self->paragraphAlignment));
+    self->startNewTextBlock(classStyle.flags & CssClassStyle::HAS_ALIGNMENT
+                                ? static_cast<TextBlock::Style>(classStyle.alignment)
+                                : static_cast<TextBlock::Style>(self->paragraphAlignment));
     if (strcmp(name, "li") == 0) {
-      self->currentTextBlock->addWord("\xe2\x80\xa2", EpdFontFamily::REGULAR);
+      self->emitWord("\xe2\x80\xa2", EpdFontFamily::REGULAR);
     }
 
     self->depth += 1;
@@ -233,6 +525,7 @@ void XMLCALL ChapterHtmlSlimParser::characterData(void* userData, const XML_Char
     self->currentTextBlock->layoutAndExtractLines(
         self->renderer, self->fontId, self->viewportWidth,
         [self](const std::shared_ptr<TextBlock>& textBlock) { self->addLineToPage(textBlock); }, false);
+    self->placePendingLines();
   }
 }
 
@@ -273,19 +566,35 @@ void XMLCALL ChapterHtmlSlimParser::endElement(void* userData, const XML_Char* n
 }
 
 bool ChapterHtmlSlimParser::parseAndBuildPages() {
+  // Tee the parse product out as we go so later layout-only rebuilds can skip the parse entirely.
+  // Failing to open the cache is not fatal - we just won't have the fast path next time.
+  if (!wordCachePath.empty()) {
+    if (SdMan.openFileForWrite("EHP", wordCachePath, wordCacheFile)) {
+      const uint8_t header[2] = {WORD_CACHE_VERSION, paragraphAlignment};
+      if (wordCacheFile.write(header, sizeof(header)) != sizeof(header)) {
+        wordCacheWriteFailed = true;
+      }
+    }
+  }
+
   startNewTextBlock((TextBlock::Style)this->paragraphAlignment);
 
-  const XML_Parser parser = XML_ParserCreate(nullptr);
+  // Expat's internals join the word/style nodes in the chapter build arena (the Scope in
+  // Section::createSectionFile spans this whole parse), so the entire parse lifetime comes
+  // back to the heap in one piece
+  const XML_Parser parser = XML_ParserCreate_MM(nullptr, parseArenaMemorySuite(), nullptr);
   int done;
 
   if (!parser) {
     Serial.printf("[%lu] [EHP] Couldn't allocate memory for parser\n", millis());
+    finishWordCacheWrite(false);
     return false;
   }
 
   FsFile file;
   if (!SdMan.openFileForRead("EHP", filepath, file)) {
     XML_ParserFree(parser);
+    finishWordCacheWrite(false);
     return false;
   }
 
@@ -293,13 +602,40 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
   const size_t totalSize = file.size();
   size_t bytesRead = 0;
   int lastProgress = -1;
+  uint32_t lastYieldMs = millis();
 
   XML_SetUserData(parser, this);
   XML_SetElementHandler(parser, startElement, endElement);
   XML_SetCharacterDataHandler(parser, characterData);
 
+  // Entity fragment held back when a chunk boundary may have split an "&name;"
+  char entityCarry[MAX_ENTITY_BYTES];
+  size_t entityCarryLen = 0;
+
   do {
-    void* const buf = XML_GetBuffer(parser, 1024);
+    // Time-slice the build: flush the cache prefix to the card, then yield so the input task
+    // can run before the next chunk
+    if (millis() - lastYieldMs >= BUILD_YIELD_INTERVAL_MS) {
+      lastYieldMs = millis();
+      if (wordCacheFile && !wordCacheWriteFailed) {
+        wordCacheFile.sync();
+      }
+      delay(1);
+    }
+
+    // Bail out between chunks if the caller no longer wants this build (e.g. user turned a page)
+    if (abortFn && abortFn()) {
+      Serial.printf("[%lu] [EHP] Parse aborted by caller\n", millis());
+      XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
+      XML_SetElementHandler(parser, nullptr, nullptr);  // Clear callbacks
+      XML_SetCharacterDataHandler(parser, nullptr);
+      XML_ParserFree(parser);
+      file.close();
+      finishWordCacheWrite(false);
+      return false;
+    }
+
+    char* const buf = static_cast<char*>(XML_GetBuffer(parser, PARSE_FEED_SIZE));
     if (!buf) {
       Serial.printf("[%lu] [EHP] Couldn't allocate memory for buffer\n", millis());
       XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
@@ -307,10 +643,13 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
       file.close();
+      finishWordCacheWrite(false);
       return false;
     }
 
-    const size_t len = file.read(buf, 1024);
+    // Re-seed the buffer with any entity fragment held back from the previous chunk
+    memcpy(buf, entityCarry, entityCarryLen);
+    const size_t len = file.read(buf + entityCarryLen, PARSE_FEED_SIZE - entityCarryLen);
 
     if (len == 0 && file.available() > 0) {
       Serial.printf("[%lu] [EHP] File read error\n", millis());
@@ -319,6 +658,7 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
       file.close();
+      finishWordCacheWrite(false);
       return false;
     }
 
@@ -335,7 +675,11 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
 
     done = file.available() == 0;
 
-    if (XML_ParseBuffer(parser, static_cast<int>(len), done) == XML_STATUS_ERROR) {
+    // Pre-pass: decode common named entities in place (shrinks the data, never grows it).
+    // At EOF nothing is held back, so `done` and an empty carry always coincide.
+    const size_t parseLen = decodeCommonEntities(buf, entityCarryLen + len, done, entityCarry, entityCarryLen);
+
+    if (XML_ParseBuffer(parser, static_cast<int>(parseLen), done) == XML_STATUS_ERROR) {
       Serial.printf("[%lu] [EHP] Parse error at line %lu:\n%s\n", millis(), XML_GetCurrentLineNumber(parser),
                     XML_ErrorString(XML_GetErrorCode(parser)));
       XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
@@ -343,6 +687,7 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
       file.close();
+      finishWordCacheWrite(false);
       return false;
     }
   } while (!done);
@@ -357,24 +702,218 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
   if (currentTextBlock) {
     makePages();
     completePageFn(std::move(currentPage));
+    pagesEmitted++;
     currentPage.reset();
     currentTextBlock.reset();
   }
 
+  // Trailing anchors with nothing placed after them resolve to the last page
+  if (!pendingAnchorIds.empty() && pagesEmitted > 0) {
+    for (auto& id : pendingAnchorIds) {
+      anchorPages.emplace_back(std::move(id), static_cast<uint16_t>(pagesEmitted - 1));
+    }
+    pendingAnchorIds.clear();
+  }
+
+  finishWordCacheWrite(true);
   return true;
 }
 
-void ChapterHtmlSlimParser::addLineToPage(std::shared_ptr<TextBlock> line) {
-  const int lineHeight = renderer.getLineHeight(fontId) * lineCompression;
+bool ChapterHtmlSlimParser::buildPagesFromWordCache() {
+  if (wordCachePath.empty()) {
+    return false;
+  }
+
+  FsFile cache;
+  if (!SdMan.openFileForRead("EHP", wordCachePath, cache)) {
+    return false;
+  }
+
+  uint8_t header[2];
+  if (cache.read(header, sizeof(header)) != sizeof(header) || header[0] != WORD_CACHE_VERSION) {
+    cache.close();
+    return false;
+  }
+  const uint8_t cachedAlignment = header[1];
+  // Blocks written with the default paragraph style get remapped to the current setting. If the
+  // cached default collides with the explicit centered style (headers, images) we can't tell the
+  // two apart any more, so force a full parse.
+  if (cachedAlignment != paragraphAlignment && cachedAlignment == TextBlock::CENTER_ALIGN) {
+    cache.close();
+    return false;
+  }
+
+  startNewTextBlock((TextBlock::Style)this->paragraphAlignment);
+
+  char wordBuffer[MAX_WORD_SIZE + 1];
+  bool corrupt = false;
+  bool complete = false;
+  uint32_t lastYieldMs = millis();
+  while (cache.available() > 0) {
+    if (abortFn && abortFn()) {
+      Serial.printf("[%lu] [EHP] Word cache replay aborted by caller\n", millis());
+      cache.close();
+      return false;
+    }
+
+    // Replay lays out every line, so it runs as long as a parse - same time slicing applies
+    if (millis() - lastYieldMs >= BUILD_YIELD_INTERVAL_MS) {
+      lastYieldMs = millis();
+      delay(1);
+    }
+
+    uint8_t tag;
+    if (cache.read(&tag, 1) != 1) {
+      corrupt = true;
+      break;
+    }
+
+    if (tag == WORD_CACHE_TAG_BLOCK) {
+      uint8_t style;
+      if (cache.read(&style, 1) != 1) {
+        corrupt = true;
+        break;
+      }
+      if (style == cachedAlignment) {
+        style = paragraphAlignment;
+      }
+      startNewTextBlock(static_cast<TextBlock::Style>(style));
+    } else if (tag == WORD_CACHE_TAG_WORD) {
+      uint8_t record[2];  // font style, word length
+      if (cache.read(record, sizeof(record)) != sizeof(record) || record[1] == 0 || record[1] > MAX_WORD_SIZE ||
+          cache.read(wordBuffer, record[1]) != record[1]) {
+        corrupt = true;
+        break;
+      }
+      wordBuffer[record[1]] = '\0';
+      currentTextBlock->addWord(wordBuffer, static_cast<EpdFontFamily::Style>(record[0]));
+
+      // Same long-block split as the streaming parser to keep memory bounded
+      if (currentTextBlock->size() > 750) {
+        currentTextBlock->layoutAndExtractLines(
+            renderer, fontId, viewportWidth,
+            [this](const std::shared_ptr<TextBlock>& textBlock) { addLineToPage(textBlock); }, false);
+        placePendingLines();
+      }
+    } else if (tag == WORD_CACHE_TAG_ANCHOR) {
+      uint8_t len;
+      if (cache.read(&len, 1) != 1 || len == 0 || len > MAX_WORD_SIZE || cache.read(wordBuffer, len) != len) {
+        corrupt = true;
+        break;
+      }
+      wordBuffer[len] = '\0';
+      pendingAnchorIds.emplace_back(wordBuffer, len);
+    } else if (tag == WORD_CACHE_TAG_IMAGE) {
+      uint8_t len;
+      if (cache.read(&len, 1) != 1 || len == 0 || len > MAX_WORD_SIZE || cache.read(wordBuffer, len) != len) {
+        corrupt = true;
+        break;
+      }
+      wordBuffer[len] = '\0';
+      if (!placeImage(wordBuffer)) {
+        // The image decoded at parse time but not now (source gone?). Keep a placeholder so
+        // the flow still breaks where it did; the alt text isn't cached, so use the generic one.
+        startNewTextBlock(TextBlock::CENTER_ALIGN);
+        currentTextBlock->addWord("[Image]", EpdFontFamily::ITALIC);
+      }
+    } else if (tag == WORD_CACHE_TAG_END) {
+      complete = true;
+      break;
+    } else {
+      corrupt = true;
+      break;
+    }
+  }
+  cache.close();
+
+  if (corrupt || !complete) {
+    Serial.printf("[%lu] [EHP] Word cache %s, removing: %s\n", millis(), corrupt ? "corrupt" : "incomplete",
+                  wordCachePath.c_str());
+    SdMan.remove(wordCachePath.c_str());
+    return false;
+  }
 
-  if (currentPageNextY + lineHeight > viewportHeight) {
+  // Process last page if there is still text
+  if (currentTextBlock) {
+    makePages();
     completePageFn(std::move(currentPage));
-    currentPage.reset(new Page());
-    currentPageNextY = 0;
+    pagesEmitted++;
+    currentPage.reset();
+    currentTextBlock.reset();
+  }
+
+  // Trailing anchors with nothing placed after them resolve to the last page
+  if (!pendingAnchorIds.empty() && pagesEmitted > 0) {
+    for (auto& id : pendingAnchorIds) {
+      anchorPages.emplace_back(std::move(id), static_cast<uint16_t>(pagesEmitted - 1));
+    }
+    pendingAnchorIds.clear();
+  }
+
+  return true;
+}
+
+void ChapterHtmlSlimParser::addLineToPage(std::shared_ptr<TextBlock> line) {
+  pendingLines.push_back(std::move(line));
+}
+
+// Commit the buffered lines to pages. Breaks avoid stranding a single line of a paragraph on
+// either side of a page boundary (orphan at the bottom, widow at the top) when the paragraph
+// allows it; this runs once at section build time, so page turns pay nothing for it.
+void ChapterHtmlSlimParser::placePendingLines() {
+  if (pendingLines.empty()) {
+    return;
   }
+  const int lineHeight = renderer.getLineHeight(fontId) * lineCompression;
 
-  currentPage->elements.push_back(std::make_shared<PageLine>(line, 0, currentPageNextY));
-  currentPageNextY += lineHeight;
+  size_t index = 0;
+  while (index < pendingLines.size()) {
+    if (!currentPage) {
+      currentPage.reset(new Page());
+      currentPageNextY = 0;
+    }
+
+    const size_t remaining = pendingLines.size() - index;
+    size_t take = lineHeight > 0 ? static_cast<size_t>((viewportHeight - currentPageNextY) / lineHeight) : remaining;
+    if (take >= remaining) {
+      take = remaining;
+    } else {
+      if (remaining - take == 1 && take > 0) {
+        take--;  // Don't strand the paragraph's last line alone on the next page (widow)
+      }
+      if (take == 1 && currentPageNextY > 0) {
+        take = 0;  // Don't leave a lone first line at the bottom of this page (orphan)
+      }
+    }
+
+    if (take == 0) {
+      if (currentPageNextY == 0) {
+        take = 1;  // Line taller than the page; force progress
+      } else {
+        completePageFn(std::move(currentPage));
+        pagesEmitted++;
+        currentPage.reset(new Page());
+        currentPageNextY = 0;
+        continue;
+      }
+    }
+
+    // Anchors registered since the last placement land where this batch starts
+    if (!pendingAnchorIds.empty()) {
+      for (auto& id : pendingAnchorIds) {
+        anchorPages.emplace_back(std::move(id), pagesEmitted);
+      }
+      pendingAnchorIds.clear();
+    }
+
+    for (size_t i = 0; i < take; i++) {
+      currentPage->elements.push_back(
+          std::allocate_shared<PageLine>(ParseArenaAllocator<PageLine>(), pendingLines[index + i], 0, currentPageNextY));
+      currentPageNextY += lineHeight;
+    }
+    index += take;
+  }
+  pendingLines.clear();
 }
 
 void ChapterHtmlSlimParser::makePages() {
@@ -392,6 +931,7 @@ void ChapterHtmlSlimParser::makePages() {
   currentTextBlock->layoutAndExtractLines(
       renderer, fontId, viewportWidth,
       [this](const std::shared_ptr<TextBlock>& textBlock) { addLineToPage(textBlock); });
+  placePendingLines();
   // Extra paragraph spacing if enabled
   if (extraParagraphSpacing) {
     currentPageNextY += lineHeight / 2;
@@ -1,16 +1,21 @@
 #pragma once
 
+#include <SdFat.h>
 #include <expat.h>
 
 #include <climits>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "../ParsedText.h"
 #include "../blocks/TextBlock.h"
 
 class Page;
+class PageImage;
 class GfxRenderer;
+class CssClassStyles;
+struct CssClassStyle;
 
 #define MAX_WORD_SIZE 200
 
@@ -19,6 +24,7 @@ class ChapterHtmlSlimParser {
   GfxRenderer& renderer;
   std::function<void(std::unique_ptr<Page>)> completePageFn;
   std::function<void(int)> progressFn;  // Progress callback (0-100)
+  std::function<bool()> abortFn;        // Optional cancellation check, polled between parse chunks
   int depth = 0;
   int skipUntilDepth = INT_MAX;
   int boldUntilDepth = INT_MAX;
@@ -30,6 +36,9 @@ class ChapterHtmlSlimParser {
   std::unique_ptr<ParsedText> currentTextBlock = nullptr;
   std::unique_ptr<Page> currentPage = nullptr;
   int16_t currentPageNextY = 0;
+  // Laid-out lines buffered between layout and page placement, so page breaks can apply
+  // widow/orphan rules with lookahead before the lines are committed to pages
+  std::vector<std::shared_ptr<TextBlock>> pendingLines;
   int fontId;
   float lineCompression;
   bool extraParagraphSpacing;
@@ -37,12 +46,41 @@ class ChapterHtmlSlimParser {
   uint16_t viewportWidth;
   uint16_t viewportHeight;
   bool hyphenationEnabled;
+  bool optimalLineBreaks;
+  // Optional parse-product cache: the word stream + block markers are teed here during a full
+  // parse and can be replayed to re-run layout without touching expat or the ZIP
+  std::string wordCachePath;
+  FsFile wordCacheFile;
+  bool wordCacheWriteFailed = false;
+  // Optional build-time image decoder (set by Section, which owns the zip access); returns a
+  // ready-to-blit element scaled to fit the viewport, or nullptr when the src can't be decoded
+  std::function<std::shared_ptr<PageImage>(const char* src)> imageElementFn;
+  // Optional class→style table compiled from the book's stylesheets (owned by the Epub);
+  // class attributes resolve through it during tag dispatch
+  const CssClassStyles* classStyles = nullptr;
+  // Anchor ids seen but whose content hasn't been committed to a page yet; resolved
+  // to the page receiving the next placed line
+  std::vector<std::string> pendingAnchorIds;
+  // (anchor id, page) pairs for this build; Section persists them as the anchor map
+  std::vector<std::pair<std::string, uint16_t>> anchorPages;
+  // Pages handed to completePageFn so far; index of the page being built
+  uint16_t pagesEmitted = 0;
 
   void startNewTextBlock(TextBlock::Style style);
+  void registerAnchor(const char* id);
+  // Merge the styles of every class named in the element's class attribute
+  CssClassStyle resolveClassStyle(const XML_Char** atts) const;
+  bool placeImage(const char* src);
   void flushPartWordBuffer();
+  void emitWord(const char* word, EpdFontFamily::Style style);
+  void writeBlockRecord(TextBlock::Style style);
+  void finishWordCacheWrite(bool success);
   void makePages();
   // XML callbacks
   static void XMLCALL startElement(void* userData, const XML_Char* name, const XML_Char** atts);
+  // Tag dispatch body; startElement wraps it so anchors register after any block the
+  // element closes has been laid out (their content starts at the *next* placement)
+  static void startElementImpl(void* userData, const XML_Char* name, const XML_Char** atts);
   static void XMLCALL characterData(void* userData, const XML_Char* s, int len);
   static void XMLCALL endElement(void* userData, const XML_Char* name);
 
@@ -51,8 +89,10 @@ class ChapterHtmlSlimParser {
                                  const float lineCompression, const bool extraParagraphSpacing,
                                  const uint8_t paragraphAlignment, const uint16_t viewportWidth,
                                  const uint16_t viewportHeight, const bool hyphenationEnabled,
+                                 const bool optimalLineBreaks,
                                  const std::function<void(std::unique_ptr<Page>)>& completePageFn,
-                                 const std::function<void(int)>& progressFn = nullptr)
+                                 const std::function<void(int)>& progressFn = nullptr,
+                                 const std::function<bool()>& abortFn = nullptr)
       : filepath(filepath),
         renderer(renderer),
         fontId(fontId),
@@ -62,9 +102,20 @@ class ChapterHtmlSlimParser {
         viewportWidth(viewportWidth),
         viewportHeight(viewportHeight),
         hyphenationEnabled(hyphenationEnabled),
+        optimalLineBreaks(optimalLineBreaks),
         completePageFn(completePageFn),
-        progressFn(progressFn) {}
+        progressFn(progressFn),
+        abortFn(abortFn) {}
   ~ChapterHtmlSlimParser() = default;
+  void setWordCachePath(const std::string& path) { wordCachePath = path; }
+  void setImageElementFn(const std::function<std::shared_ptr<PageImage>(const char*)>& fn) { imageElementFn = fn; }
+  void setClassStyles(const CssClassStyles* styles) { classStyles = styles; }
+  // (anchor id → page) pairs recorded during the build, valid for this layout only
+  const std::vector<std::pair<std::string, uint16_t>>& getAnchorPages() const { return anchorPages; }
   bool parseAndBuildPages();
+  // Layout-only rebuild: replays a previously teed word cache through the same page pipeline.
+  // Returns false (without removing any section output) if the cache is missing or stale.
+  bool buildPagesFromWordCache();
   void addLineToPage(std::shared_ptr<TextBlock> line);
+  void placePendingLines();
 };
@@ -2,8 +2,11 @@
 
 #include <HardwareSerial.h>
 
+#include "ExpatArenaSuite.h"
+
 bool ContainerParser::setup() {
-  parser = XML_ParserCreate(nullptr);
+  const ParseArena::Scope arenaScope(xmlArena);
+  parser = XML_ParserCreate_MM(nullptr, parseArenaMemorySuite(), nullptr);
   if (!parser) {
     Serial.printf("[%lu] [CTR] Couldn't allocate memory for parser\n", millis());
     return false;
@@ -27,6 +30,8 @@ size_t ContainerParser::write(const uint8_t data) { return write(&data, 1); }
 
 size_t ContainerParser::write(const uint8_t* buffer, const size_t size) {
   if (!parser) return 0;
+  // Buffer and pool growth during the parse stays in this parser's arena
+  const ParseArena::Scope arenaScope(xmlArena);
 
   const uint8_t* currentBufferPos = buffer;
   auto remainingInBuffer = size;
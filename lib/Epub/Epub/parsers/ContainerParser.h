@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "../ParseArena.h"
 #include "expat.h"
 
 class ContainerParser final : public Print {
@@ -13,6 +14,8 @@ class ContainerParser final : public Print {
   };
 
   size_t remainingSize;
+  // Backs expat's internals for this parser's lifetime, reclaimed wholesale on destruction
+  ParseArena xmlArena;
   XML_Parser parser = nullptr;
   ParserState state = START;
 
@@ -3,16 +3,22 @@
 #include <FsHelpers.h>
 #include <HardwareSerial.h>
 #include <Serialization.h>
+#include <ZipInflateStream.h>
 
 #include "../BookMetadataCache.h"
+#include "ExpatArenaSuite.h"
 
 namespace {
 constexpr char MEDIA_TYPE_NCX[] = "application/x-dtbncx+xml";
+constexpr char MEDIA_TYPE_CSS[] = "text/css";
 constexpr char itemCacheFile[] = "/.items.bin";
+// More stylesheets than this is generator noise; the first ones carry the book's styling
+constexpr size_t MAX_CSS_SHEETS = 16;
 }  // namespace
 
 bool ContentOpfParser::setup() {
-  parser = XML_ParserCreate(nullptr);
+  const ParseArena::Scope arenaScope(xmlArena);
+  parser = XML_ParserCreate_MM(nullptr, parseArenaMemorySuite(), nullptr);
   if (!parser) {
     Serial.printf("[%lu] [COF] Couldn't allocate memory for parser\n", millis());
     return false;
@@ -43,15 +49,16 @@ ContentOpfParser::~ContentOpfParser() {
   useItemIndex = false;
 }
 
-size_t ContentOpfParser::write(const uint8_t data) { return write(&data, 1); }
+bool ContentOpfParser::parse(ZipInflateStream& in) {
+  if (!parser) return false;
+  // Expat grows its buffers and pools mid-parse; keep them landing in this parser's arena.
+  // The handler callbacks build plain heap strings, so nothing that outlives the parse is
+  // routed here.
+  const ParseArena::Scope arenaScope(xmlArena);
 
-size_t ContentOpfParser::write(const uint8_t* buffer, const size_t size) {
-  if (!parser) return 0;
-
-  const uint8_t* currentBufferPos = buffer;
-  auto remainingInBuffer = size;
-
-  while (remainingInBuffer > 0) {
+  // Inflate straight into the buffer expat hands out, so no intermediate copy of the document is
+  // ever held: peak memory is one chunk plus the inflate window, regardless of manifest size.
+  while (true) {
     void* const buf = XML_GetBuffer(parser, 1024);
 
     if (!buf) {
@@ -61,13 +68,22 @@ size_t ContentOpfParser::write(const uint8_t* buffer, const size_t size) {
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
       parser = nullptr;
-      return 0;
+      return false;
     }
 
-    const auto toRead = remainingInBuffer < 1024 ? remainingInBuffer : 1024;
-    memcpy(buf, currentBufferPos, toRead);
+    const int bytesRead = in.read(static_cast<uint8_t*>(buf), 1024);
+    if (bytesRead < 0) {
+      Serial.printf("[%lu] [COF] Failed to read content.opf from zip\n", millis());
+      XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
+      XML_SetElementHandler(parser, nullptr, nullptr);  // Clear callbacks
+      XML_SetCharacterDataHandler(parser, nullptr);
+      XML_ParserFree(parser);
+      parser = nullptr;
+      return false;
+    }
 
-    if (XML_ParseBuffer(parser, static_cast<int>(toRead), remainingSize == toRead) == XML_STATUS_ERROR) {
+    const bool isFinal = bytesRead == 0 || in.available() == 0;
+    if (XML_ParseBuffer(parser, bytesRead, isFinal) == XML_STATUS_ERROR) {
       Serial.printf("[%lu] [COF] Parse error at line %lu: %s\n", millis(), XML_GetCurrentLineNumber(parser),
                     XML_ErrorString(XML_GetErrorCode(parser)));
       XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
@@ -75,15 +91,13 @@ size_t ContentOpfParser::write(const uint8_t* buffer, const size_t size) {
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
       parser = nullptr;
-      return 0;
+      return false;
     }
 
-    currentBufferPos += toRead;
-    remainingInBuffer -= toRead;
-    remainingSize -= toRead;
+    if (isFinal) {
+      return true;
+    }
   }
-
-  return size;
 }
 
 void XMLCALL ContentOpfParser::startElement(void* userData, const XML_Char* name, const XML_Char** atts) {
@@ -184,7 +198,7 @@ void XMLCALL ContentOpfParser::startElement(void* userData, const XML_Char* name
       if (strcmp(atts[i], "id") == 0) {
         itemId = atts[i + 1];
       } else if (strcmp(atts[i], "href") == 0) {
-        href = FsHelpers::normalisePath(self->baseContentPath + atts[i + 1]);
+        FsHelpers::joinAndNormalise(href, self->baseContentPath, atts[i + 1]);
       } else if (strcmp(atts[i], "media-type") == 0) {
         mediaType = atts[i + 1];
       } else if (strcmp(atts[i], "properties") == 0) {
@@ -209,6 +223,10 @@ void XMLCALL ContentOpfParser::startElement(void* userData, const XML_Char* name
       self->coverItemHref = href;
     }
 
+    if (mediaType == MEDIA_TYPE_CSS && self->cssItemHrefs.size() < MAX_CSS_SHEETS) {
+      self->cssItemHrefs.push_back(href);
+    }
+
     if (mediaType == MEDIA_TYPE_NCX) {
       if (self->tocNcxPath.empty()) {
         self->tocNcxPath = href;
@@ -300,7 +318,7 @@ void XMLCALL ContentOpfParser::startElement(void* userData, const XML_Char* name
           break;
         }
       } else if (strcmp(atts[i], "href") == 0) {
-        textHref = FsHelpers::normalisePath(self->baseContentPath + atts[i + 1]);
+        FsHelpers::joinAndNormalise(textHref, self->baseContentPath, atts[i + 1]);
       }
     }
     if ((type == "text" || (type == "start" && !self->textReferenceHref.empty())) && (textHref.length() > 0)) {
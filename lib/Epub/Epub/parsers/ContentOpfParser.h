@@ -1,15 +1,15 @@
 #pragma once
-#include <Print.h>
-
 #include <algorithm>
 #include <vector>
 
+#include "../ParseArena.h"
 #include "Epub.h"
 #include "expat.h"
 
 class BookMetadataCache;
+class ZipInflateStream;
 
-class ContentOpfParser final : public Print {
+class ContentOpfParser final {
   enum ParserState {
     START,
     IN_PACKAGE,
@@ -24,7 +24,9 @@ class ContentOpfParser final : public Print {
 
   const std::string& cachePath;
   const std::string& baseContentPath;
-  size_t remainingSize;
+  // Backs expat's internals for the lifetime of this parser (via parseArenaMemorySuite());
+  // declared before the XML_Parser it owns the memory of, reclaimed wholesale on destruction
+  ParseArena xmlArena;
   XML_Parser parser = nullptr;
   ParserState state = START;
   BookMetadataCache* cache;
@@ -64,14 +66,16 @@ class ContentOpfParser final : public Print {
   std::string tocNavPath;  // EPUB 3 nav document path
   std::string coverItemHref;
   std::string textReferenceHref;
+  // Manifest items with the CSS media type, in manifest order (compiled into the book's
+  // class→style table after the parse)
+  std::vector<std::string> cssItemHrefs;
 
-  explicit ContentOpfParser(const std::string& cachePath, const std::string& baseContentPath, const size_t xmlSize,
-                            BookMetadataCache* cache)
-      : cachePath(cachePath), baseContentPath(baseContentPath), remainingSize(xmlSize), cache(cache) {}
-  ~ContentOpfParser() override;
+  explicit ContentOpfParser(const std::string& cachePath, const std::string& baseContentPath, BookMetadataCache* cache)
+      : cachePath(cachePath), baseContentPath(baseContentPath), cache(cache) {}
+  ~ContentOpfParser();
 
   bool setup();
 
-  size_t write(uint8_t) override;
-  size_t write(const uint8_t* buffer, size_t size) override;
+  // Drains the OPF through expat in bounded chunks pulled from the zip inflate stream
+  bool parse(ZipInflateStream& in);
 };
@@ -0,0 +1,331 @@
+#include "CssLiteParser.h"
+
+#include <Serialization.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "../blocks/TextBlock.h"
+
+namespace {
+constexpr uint8_t CSS_STYLES_VERSION = 1;
+
+// Caps against pathological sheets: a book's styling vocabulary is a handful of classes, so
+// anything past these limits is machine-generated noise we can safely drop
+constexpr size_t MAX_CLASS_ENTRIES = 512;
+constexpr size_t MAX_CLASS_NAME_LEN = 64;
+
+bool isCssWhitespace(const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f'; }
+
+// Advances pos past whitespace and /* */ comments. Returns false when a comment is left open
+// at the end of the buffer (the caller carries from the rule start in that case).
+bool skipWsAndComments(const char* buf, const size_t len, size_t& pos) {
+  while (pos < len) {
+    if (isCssWhitespace(buf[pos])) {
+      pos++;
+      continue;
+    }
+    if (buf[pos] == '/' && pos + 1 < len && buf[pos + 1] == '*') {
+      size_t end = pos + 2;
+      while (end + 1 < len && !(buf[end] == '*' && buf[end + 1] == '/')) end++;
+      if (end + 1 >= len) {
+        return false;
+      }
+      pos = end + 2;
+      continue;
+    }
+    return true;
+  }
+  return true;
+}
+
+// Case-insensitive keyword match against the trimmed token at s[0..len)
+bool tokenIs(const char* s, const size_t len, const char* keyword) {
+  return strlen(keyword) == len && strncasecmp(s, keyword, len) == 0;
+}
+
+void trim(const char*& s, size_t& len) {
+  while (len > 0 && isCssWhitespace(*s)) {
+    s++;
+    len--;
+  }
+  while (len > 0 && isCssWhitespace(s[len - 1])) len--;
+}
+
+// A font-size large enough to read as a heading. Blocks render at one size, so these get the
+// repo's heading treatment (bold) instead of an actual scale.
+bool isHeadingSize(const char* value, const size_t len) {
+  if (tokenIs(value, len, "large") || tokenIs(value, len, "x-large") || tokenIs(value, len, "xx-large")) {
+    return true;
+  }
+  // strtof needs a terminated string; sizes are short, so bounce through a stack copy
+  char num[16];
+  if (len == 0 || len >= sizeof(num)) {
+    return false;
+  }
+  memcpy(num, value, len);
+  num[len] = '\0';
+  char* unit = nullptr;
+  const float size = strtof(num, &unit);
+  if (unit == num) {
+    return false;
+  }
+  const size_t unitLen = num + len - unit;
+  if (tokenIs(unit, unitLen, "em") || tokenIs(unit, unitLen, "rem")) {
+    return size >= 1.2f;
+  }
+  if (tokenIs(unit, unitLen, "%")) {
+    return size >= 120.0f;
+  }
+  if (tokenIs(unit, unitLen, "px")) {
+    return size >= 24.0f;
+  }
+  if (tokenIs(unit, unitLen, "pt")) {
+    return size >= 18.0f;
+  }
+  return false;
+}
+
+// Scans a declaration block for the recognised properties; returns true when any applied
+bool parseDeclarations(const char* block, const size_t blockLen, CssClassStyle& style) {
+  bool any = false;
+  size_t pos = 0;
+  while (pos < blockLen) {
+    size_t declEnd = pos;
+    while (declEnd < blockLen && block[declEnd] != ';') declEnd++;
+
+    const char* colon = static_cast<const char*>(memchr(block + pos, ':', declEnd - pos));
+    if (colon != nullptr) {
+      const char* prop = block + pos;
+      size_t propLen = colon - prop;
+      trim(prop, propLen);
+      const char* value = colon + 1;
+      size_t valueLen = block + declEnd - value;
+      trim(value, valueLen);
+
+      if (tokenIs(prop, propLen, "font-weight")) {
+        // "normal" can't unwind the depth-scoped style state, so only the bold direction maps
+        if (tokenIs(value, valueLen, "bold") || tokenIs(value, valueLen, "bolder") ||
+            (valueLen == 3 && value[0] >= '6' && value[0] <= '9' && strncmp(value + 1, "00", 2) == 0)) {
+          style.flags |= CssClassStyle::BOLD;
+          any = true;
+        }
+      } else if (tokenIs(prop, propLen, "font-style")) {
+        if (tokenIs(value, valueLen, "italic") || tokenIs(value, valueLen, "oblique")) {
+          style.flags |= CssClassStyle::ITALIC;
+          any = true;
+        }
+      } else if (tokenIs(prop, propLen, "text-align")) {
+        uint8_t alignment = 0;
+        bool matched = true;
+        if (tokenIs(value, valueLen, "left")) {
+          alignment = TextBlock::LEFT_ALIGN;
+        } else if (tokenIs(value, valueLen, "center")) {
+          alignment = TextBlock::CENTER_ALIGN;
+        } else if (tokenIs(value, valueLen, "right")) {
+          alignment = TextBlock::RIGHT_ALIGN;
+        } else if (tokenIs(value, valueLen, "justify")) {
+          alignment = TextBlock::JUSTIFIED;
+        } else {
+          matched = false;
+        }
+        if (matched) {
+          style.flags |= CssClassStyle::HAS_ALIGNMENT;
+          style.alignment = alignment;
+          any = true;
+        }
+      } else if (tokenIs(prop, propLen, "font-size")) {
+        if (isHeadingSize(value, valueLen)) {
+          style.flags |= CssClassStyle::BOLD;
+          any = true;
+        }
+      }
+    }
+    pos = declEnd + 1;
+  }
+  return any;
+}
+
+// Extracts the class name from one simple selector ("  .note" / "p.note"); anything the table
+// can't honour - combinators, pseudo-classes, attribute/id selectors, escapes, multiple
+// classes - is rejected rather than approximated
+bool extractClassName(const char* selector, size_t len, const char*& name, size_t& nameLen) {
+  trim(selector, len);
+  const char* dot = nullptr;
+  for (size_t i = 0; i < len; i++) {
+    const char c = selector[i];
+    if (isCssWhitespace(c) || c == '>' || c == '+' || c == '~' || c == ':' || c == '[' || c == '#' || c == '*' ||
+        c == '\\') {
+      return false;
+    }
+    if (c == '.') {
+      if (dot != nullptr) {
+        return false;
+      }
+      dot = selector + i;
+    }
+  }
+  if (dot == nullptr) {
+    return false;
+  }
+  name = dot + 1;
+  nameLen = selector + len - name;
+  return nameLen > 0 && nameLen <= MAX_CLASS_NAME_LEN;
+}
+}  // namespace
+
+uint32_t CssClassStyles::fnvHash(const char* s, const size_t len) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= static_cast<uint8_t>(s[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+void CssClassStyles::add(const char* name, const size_t len, const CssClassStyle& style) {
+  if (entries.size() >= MAX_CLASS_ENTRIES) {
+    return;
+  }
+  entries.push_back({fnvHash(name, len), style});
+}
+
+void CssClassStyles::finalize() {
+  // Stable sort keeps source order within a hash, so the cascade merge below stays correct
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry& a, const Entry& b) { return a.nameHash < b.nameHash; });
+  size_t write = 0;
+  for (size_t read = 0; read < entries.size(); read++) {
+    if (write > 0 && entries[write - 1].nameHash == entries[read].nameHash) {
+      // Later rules win: flags accumulate (there is no reset direction), alignment is replaced
+      entries[write - 1].style.flags |= entries[read].style.flags;
+      if (entries[read].style.flags & CssClassStyle::HAS_ALIGNMENT) {
+        entries[write - 1].style.alignment = entries[read].style.alignment;
+      }
+    } else {
+      entries[write++] = entries[read];
+    }
+  }
+  entries.resize(write);
+}
+
+const CssClassStyle* CssClassStyles::lookup(const char* name, const size_t len) const {
+  const uint32_t hash = fnvHash(name, len);
+  const auto it = std::lower_bound(entries.begin(), entries.end(), hash,
+                                   [](const Entry& e, const uint32_t h) { return e.nameHash < h; });
+  if (it == entries.end() || it->nameHash != hash) {
+    return nullptr;
+  }
+  return &it->style;
+}
+
+bool CssClassStyles::writeToFile(FsFile& file) const {
+  serialization::writePod(file, CSS_STYLES_VERSION);
+  serialization::writePod(file, static_cast<uint16_t>(entries.size()));
+  for (const auto& entry : entries) {
+    serialization::writePod(file, entry.nameHash);
+    serialization::writePod(file, entry.style.flags);
+    serialization::writePod(file, entry.style.alignment);
+  }
+  return true;
+}
+
+bool CssClassStyles::readFromFile(FsFile& file) {
+  uint8_t version;
+  uint16_t count;
+  serialization::readPod(file, version);
+  serialization::readPod(file, count);
+  if (version != CSS_STYLES_VERSION || count > MAX_CLASS_ENTRIES) {
+    return false;
+  }
+  entries.resize(count);
+  for (auto& entry : entries) {
+    serialization::readPod(file, entry.nameHash);
+    serialization::readPod(file, entry.style.flags);
+    serialization::readPod(file, entry.style.alignment);
+  }
+  // Written sorted; nothing to finalize on load
+  return true;
+}
+
+size_t CssLiteParser::parseRules(const char* buf, const size_t len, const bool atEof, CssClassStyles& out) {
+  size_t pos = 0;
+  while (pos < len) {
+    const size_t ruleStart = pos;
+    if (!skipWsAndComments(buf, len, pos)) {
+      // Comment still open - complete it next feed
+      return atEof ? len : ruleStart;
+    }
+    if (pos >= len) {
+      return len;
+    }
+
+    // At-rules: statement forms (@import, @charset) end at ';', block forms (@media) at the
+    // matching brace. Either way nothing inside is compiled - nested rules are out of scope.
+    if (buf[pos] == '@') {
+      int braceDepth = 0;
+      while (pos < len) {
+        if (!skipWsAndComments(buf, len, pos)) {
+          pos = len;  // Open comment - the rest of this feed is unusable
+          break;
+        }
+        if (pos >= len) {
+          break;
+        }
+        const char c = buf[pos++];
+        if (c == '{') {
+          braceDepth++;
+        } else if (c == '}') {
+          if (--braceDepth <= 0) {
+            break;
+          }
+        } else if (c == ';' && braceDepth == 0) {
+          break;
+        }
+      }
+      if (pos >= len && !atEof) {
+        return ruleStart;
+      }
+      continue;
+    }
+
+    // Selector runs to the '{'; a stray '}' just resynchronises
+    const size_t selectorStart = pos;
+    while (pos < len && buf[pos] != '{' && buf[pos] != '}') pos++;
+    if (pos >= len) {
+      return atEof ? len : ruleStart;
+    }
+    if (buf[pos] == '}') {
+      pos++;
+      continue;
+    }
+    const size_t selectorEnd = pos++;
+
+    const size_t blockStart = pos;
+    while (pos < len && buf[pos] != '}') pos++;
+    if (pos >= len) {
+      return atEof ? len : ruleStart;
+    }
+    const size_t blockEnd = pos++;
+
+    CssClassStyle style;
+    if (!parseDeclarations(buf + blockStart, blockEnd - blockStart, style)) {
+      continue;
+    }
+
+    // Apply to every class-selector in the comma list
+    size_t selPos = selectorStart;
+    while (selPos < selectorEnd) {
+      size_t selEnd = selPos;
+      while (selEnd < selectorEnd && buf[selEnd] != ',') selEnd++;
+      const char* className;
+      size_t classNameLen;
+      if (extractClassName(buf + selPos, selEnd - selPos, className, classNameLen)) {
+        out.add(className, classNameLen, style);
+      }
+      selPos = selEnd + 1;
+    }
+  }
+  return len;
+}
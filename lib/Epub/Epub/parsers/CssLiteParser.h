@@ -0,0 +1,57 @@
+#pragma once
+#include <SdFat.h>
+
+#include <cstdint>
+#include <vector>
+
+// Compiled style for one CSS class: just the properties the layout engine can honour
+// (bold/italic map to font family styles, alignment to the TextBlock styles). Everything
+// else in a declaration block is ignored.
+struct CssClassStyle {
+  static constexpr uint8_t BOLD = 0x01;
+  static constexpr uint8_t ITALIC = 0x02;
+  static constexpr uint8_t HAS_ALIGNMENT = 0x04;
+
+  uint8_t flags = 0;
+  uint8_t alignment = 0;  // a TextBlock::Style value, meaningful only with HAS_ALIGNMENT
+};
+
+// Class-name-hash → style table, compiled once per book from the OPF manifest stylesheets and
+// persisted in the book cache. Lookups run during section builds only, so the table stays
+// small and flat: a sorted vector binary-searched by FNV-1a hash of the class name.
+class CssClassStyles {
+  struct Entry {
+    uint32_t nameHash;
+    CssClassStyle style;
+  };
+  std::vector<Entry> entries;
+
+  static uint32_t fnvHash(const char* s, size_t len);
+
+ public:
+  // Append a class's style; duplicates are merged by finalize() with later additions winning,
+  // matching CSS source-order cascade
+  void add(const char* name, size_t len, const CssClassStyle& style);
+  // Sort and merge duplicate class names; must run before lookup()
+  void finalize();
+  const CssClassStyle* lookup(const char* name, size_t len) const;
+  bool empty() const { return entries.empty(); }
+  size_t size() const { return entries.size(); }
+  bool writeToFile(FsFile& file) const;
+  bool readFromFile(FsFile& file);
+};
+
+// Minimal CSS subset parser for publisher EPUB stylesheets. Only single-class selectors
+// (".note", "p.note") are compiled - the table is keyed by class name alone, so the tag part
+// of "p.note" is accepted but not enforced. Descendant/pseudo/attribute/id selectors and
+// at-rules are skipped whole. Recognised declarations: font-weight, font-style, text-align,
+// and font-size (large sizes get the repo's heading treatment - bold - since blocks render
+// at a single font size).
+class CssLiteParser {
+ public:
+  // Parses the complete rules in buf[0..len) into `out`. Returns the offset of the first
+  // unconsumed byte - the start of a trailing incomplete rule - so a caller draining a
+  // stylesheet in chunks can carry the tail into its next feed. With atEof set everything
+  // is consumed.
+  static size_t parseRules(const char* buf, size_t len, bool atEof, CssClassStyles& out);
+};
@@ -0,0 +1,58 @@
+#include "ExpatArenaSuite.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "../ParseArena.h"
+
+namespace {
+// ParseArena::release() needs the allocation size back and expat's free callback doesn't carry
+// one, so each block is prefixed with its requested size. Eight bytes keeps the pointer
+// alignment the arena hands out.
+constexpr size_t SIZE_PREFIX = 8;
+
+void* suiteMalloc(const size_t size) {
+  uint8_t* base;
+  if (ParseArena* arena = ParseArena::current()) {
+    base = static_cast<uint8_t*>(arena->alloc(SIZE_PREFIX + size));
+  } else {
+    base = static_cast<uint8_t*>(ParseArena::fallbackAlloc(SIZE_PREFIX + size));
+  }
+  if (base == nullptr) {
+    return nullptr;
+  }
+  *reinterpret_cast<size_t*>(base) = size;
+  return base + SIZE_PREFIX;
+}
+
+void suiteFree(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto* base = static_cast<uint8_t*>(ptr) - SIZE_PREFIX;
+  ParseArena::release(base, SIZE_PREFIX + *reinterpret_cast<const size_t*>(base));
+}
+
+void* suiteRealloc(void* ptr, const size_t size) {
+  if (ptr == nullptr) {
+    return suiteMalloc(size);
+  }
+  const size_t oldSize = *reinterpret_cast<const size_t*>(static_cast<uint8_t*>(ptr) - SIZE_PREFIX);
+  if (size <= oldSize) {
+    // Keep the block; release() later gets the recorded (allocated) size, which still matches
+    return ptr;
+  }
+  void* grown = suiteMalloc(size);
+  if (grown == nullptr) {
+    return nullptr;
+  }
+  memcpy(grown, ptr, oldSize);
+  suiteFree(ptr);
+  return grown;
+}
+}  // namespace
+
+const XML_Memory_Handling_Suite* parseArenaMemorySuite() {
+  static const XML_Memory_Handling_Suite suite = {suiteMalloc, suiteRealloc, suiteFree};
+  return &suite;
+}
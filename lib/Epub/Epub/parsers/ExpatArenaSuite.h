@@ -0,0 +1,9 @@
+#pragma once
+#include <expat.h>
+
+// Memory suite handed to XML_ParserCreate_MM so expat's internal structures (hash tables,
+// string pools, input buffers) come out of the active ParseArena instead of interleaving with
+// the rest of the heap. Allocations made while no arena is in scope fall back to the heap, and
+// every block records its owner, so parsers stay correct whichever side of an arena scope they
+// are created, fed and freed on.
+const XML_Memory_Handling_Suite* parseArenaMemorySuite();
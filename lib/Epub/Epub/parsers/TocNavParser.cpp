@@ -4,9 +4,11 @@
 #include <HardwareSerial.h>
 
 #include "../BookMetadataCache.h"
+#include "ExpatArenaSuite.h"
 
 bool TocNavParser::setup() {
-  parser = XML_ParserCreate(nullptr);
+  const ParseArena::Scope arenaScope(xmlArena);
+  parser = XML_ParserCreate_MM(nullptr, parseArenaMemorySuite(), nullptr);
   if (!parser) {
     Serial.printf("[%lu] [NAV] Couldn't allocate memory for parser\n", millis());
     return false;
@@ -32,6 +34,8 @@ size_t TocNavParser::write(const uint8_t data) { return write(&data, 1); }
 
 size_t TocNavParser::write(const uint8_t* buffer, const size_t size) {
   if (!parser) return 0;
+  // Buffer and pool growth during the parse stays in this parser's arena
+  const ParseArena::Scope arenaScope(xmlArena);
 
   const uint8_t* currentBufferPos = buffer;
   auto remainingInBuffer = size;
@@ -141,7 +145,8 @@ void XMLCALL TocNavParser::endElement(void* userData, const XML_Char* name) {
   if (strcmp(name, "a") == 0 && self->state == IN_ANCHOR) {
     // Create TOC entry when closing anchor tag (we have all data now)
     if (!self->currentLabel.empty() && !self->currentHref.empty()) {
-      std::string href = FsHelpers::normalisePath(self->baseContentPath + self->currentHref);
+      std::string href;
+      FsHelpers::joinAndNormalise(href, self->baseContentPath, self->currentHref.c_str());
       std::string anchor;
 
       const size_t pos = href.find('#');
@@ -4,6 +4,8 @@
 
 #include <string>
 
+#include "../ParseArena.h"
+
 class BookMetadataCache;
 
 // Parser for EPUB 3 nav.xhtml navigation documents
@@ -21,6 +23,8 @@ class TocNavParser final : public Print {
 
   const std::string& baseContentPath;
   size_t remainingSize;
+  // Backs expat's internals for this parser's lifetime, reclaimed wholesale on destruction
+  ParseArena xmlArena;
   XML_Parser parser = nullptr;
   ParserState state = START;
   BookMetadataCache* cache;
@@ -4,9 +4,11 @@
 #include <HardwareSerial.h>
 
 #include "../BookMetadataCache.h"
+#include "ExpatArenaSuite.h"
 
 bool TocNcxParser::setup() {
-  parser = XML_ParserCreate(nullptr);
+  const ParseArena::Scope arenaScope(xmlArena);
+  parser = XML_ParserCreate_MM(nullptr, parseArenaMemorySuite(), nullptr);
   if (!parser) {
     Serial.printf("[%lu] [TOC] Couldn't allocate memory for parser\n", millis());
     return false;
@@ -32,6 +34,8 @@ size_t TocNcxParser::write(const uint8_t data) { return write(&data, 1); }
 
 size_t TocNcxParser::write(const uint8_t* buffer, const size_t size) {
   if (!parser) return 0;
+  // Buffer and pool growth during the parse stays in this parser's arena
+  const ParseArena::Scope arenaScope(xmlArena);
 
   const uint8_t* currentBufferPos = buffer;
   auto remainingInBuffer = size;
@@ -160,7 +164,8 @@ void XMLCALL TocNcxParser::endElement(void* userData, const XML_Char* name) {
     // This is the safest place to push the data, assuming <navLabel> always comes before <content>.
     // NCX spec says navLabel comes before content.
     if (!self->currentLabel.empty() && !self->currentSrc.empty()) {
-      std::string href = FsHelpers::normalisePath(self->baseContentPath + self->currentSrc);
+      std::string href;
+      FsHelpers::joinAndNormalise(href, self->baseContentPath, self->currentSrc.c_str());
       std::string anchor;
 
       const size_t pos = href.find('#');
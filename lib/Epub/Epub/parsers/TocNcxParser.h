@@ -4,6 +4,8 @@
 
 #include <string>
 
+#include "../ParseArena.h"
+
 class BookMetadataCache;
 
 class TocNcxParser final : public Print {
@@ -11,6 +13,8 @@ class TocNcxParser final : public Print {
 
   const std::string& baseContentPath;
   size_t remainingSize;
+  // Backs expat's internals for this parser's lifetime, reclaimed wholesale on destruction
+  ParseArena xmlArena;
   XML_Parser parser = nullptr;
   ParserState state = START;
   BookMetadataCache* cache;
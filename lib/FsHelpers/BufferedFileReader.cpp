@@ -0,0 +1,67 @@
+#include "BufferedFileReader.h"
+
+#include <cstring>
+
+int BufferedFileReader::read(void* out, const size_t len) {
+  auto* dst = static_cast<uint8_t*>(out);
+  size_t remaining = len;
+  while (remaining > 0) {
+    if (cursor >= windowStart && cursor < windowStart + windowLen) {
+      const size_t avail = windowStart + windowLen - cursor;
+      const size_t chunk = remaining < avail ? remaining : avail;
+      memcpy(dst, window + (cursor - windowStart), chunk);
+      cursor += chunk;
+      dst += chunk;
+      remaining -= chunk;
+      continue;
+    }
+    // A remainder at least a window long skips the copy: one direct read is already multi-block
+    if (file && remaining >= windowCapacity) {
+      if (!file->seek(cursor)) {
+        break;
+      }
+      const int got = file->read(dst, remaining);
+      if (got <= 0) {
+        break;
+      }
+      cursor += got;
+      dst += got;
+      remaining -= got;
+      if (remaining > 0) {
+        break;
+      }
+      continue;
+    }
+    if (!fill(cursor)) {
+      break;
+    }
+  }
+  return static_cast<int>(len - remaining);
+}
+
+bool BufferedFileReader::str(std::string& out) {
+  uint32_t length = 0;
+  if (!pod(length)) {
+    return false;
+  }
+  out.resize(length);
+  return length == 0 || read(&out[0], length) == static_cast<int>(length);
+}
+
+bool BufferedFileReader::fill(const uint32_t pos) {
+  if (!file) {
+    return false;  // memory mode: everything it will ever have is already in the window
+  }
+  const uint32_t alignedStart = pos & ~(SECTOR_SIZE - 1);
+  windowLen = 0;
+  if (!file->seek(alignedStart)) {
+    return false;
+  }
+  const int got = file->read(window, windowCapacity);
+  if (got <= 0 || alignedStart + static_cast<uint32_t>(got) <= pos) {
+    return false;
+  }
+  windowStart = alignedStart;
+  windowLen = static_cast<size_t>(got);
+  return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <SdFat.h>
+
+#include <cstdint>
+#include <string>
+
+// Sector-aligned read window over an open FsFile. SdFat serves a large aligned read as one
+// multi-block transfer, but the cache layer's field-by-field loads degrade into hundreds of
+// single-sector commands - an order of magnitude slower on SD. The reader fills a caller-owned
+// window (512-byte aligned start, whole sectors) and serves small reads from RAM; reads at least
+// a window long bypass it with one direct transfer. The caller supplies the window so each site
+// can size it to its record run (4-16KB works well) and keep it off the 4KB task stacks.
+//
+// The reader owns the underlying file position while in use; callers going back to direct FsFile
+// reads must seek first.
+class BufferedFileReader {
+ public:
+  static constexpr uint32_t SECTOR_SIZE = 512;
+
+  BufferedFileReader(FsFile& file, uint8_t* window, const size_t windowCapacity)
+      : file(&file), window(window), windowCapacity(windowCapacity) {}
+
+  // Memory-backed mode: the whole "file" is a caller-owned buffer (e.g. a decompressed page
+  // record), so every read is served from RAM and no FsFile is touched. The buffer is never
+  // written to despite the non-const window member shared with the file mode.
+  BufferedFileReader(const uint8_t* data, const size_t len)
+      : file(nullptr), window(const_cast<uint8_t*>(data)), windowCapacity(len), windowLen(len) {}
+  BufferedFileReader(const BufferedFileReader&) = delete;
+  BufferedFileReader& operator=(const BufferedFileReader&) = delete;
+
+  // Reposition the logical cursor; cheap, the window refills lazily on the next read
+  void seek(const uint32_t pos) { cursor = pos; }
+  uint32_t position() const { return cursor; }
+
+  // Hint that a record run starts at `pos`: positions the cursor and pre-fills the window with
+  // the surrounding aligned sectors so the first field reads hit RAM
+  void readAhead(const uint32_t pos) {
+    cursor = pos;
+    fill(pos);
+  }
+
+  // FsFile-compatible bulk read; returns the number of bytes read
+  int read(void* out, size_t len);
+
+  template <typename T>
+  bool pod(T& value) {
+    return read(&value, sizeof(T)) == static_cast<int>(sizeof(T));
+  }
+
+  // Length-prefixed string, matching the serialization::readString layout
+  bool str(std::string& out);
+
+ private:
+  // (Re)fill the window with the aligned sector run containing `pos`
+  bool fill(uint32_t pos);
+
+  FsFile* const file;  // null in memory-backed mode
+  uint8_t* const window;
+  const size_t windowCapacity;
+  uint32_t windowStart = 0;
+  size_t windowLen = 0;
+  uint32_t cursor = 0;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Print.h>
+#include <SdFat.h>
+
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Coalescing writer for FsFile sinks built record-by-record.
+ *
+ * The section and metadata cache builders emit files as a long run of small field writes -
+ * a handful of pods per page record, one short record per spine entry. Each one lands as a
+ * sub-sector FsFile::write, and on slow cards the per-call latency (not bandwidth) dominates
+ * the whole build. This adapter stages those pieces and pushes them to the card in aligned
+ * multi-sector units; writes already at or above the buffer size pass straight through.
+ *
+ * Unlike BufferedPrint it binds an FsFile directly so it can answer position() - the logical
+ * file offset including the staged tail - which the builders record into their LUTs while
+ * writing. The owner must flushBuffer() (and check it) before seeking, patching, or closing
+ * the underlying file: until then the file's own position lags the logical one. When the
+ * buffer allocation fails the adapter degrades to pass-through.
+ */
+class BufferedFileWriter final : public Print {
+  FsFile& file;
+  uint8_t* buffer;
+  const size_t capacity;
+  size_t filled = 0;
+  bool failed = false;
+
+ public:
+  // 16 SD sectors: large enough that the per-call cost disappears into the transfer, small
+  // enough to sit comfortably beside the parser's own working set during a section build
+  static constexpr size_t BUILD_CAPACITY = 8192;
+
+  explicit BufferedFileWriter(FsFile& file, const size_t capacity = BUILD_CAPACITY) : file(file), capacity(capacity) {
+    buffer = static_cast<uint8_t*>(malloc(capacity));
+  }
+  BufferedFileWriter(const BufferedFileWriter&) = delete;
+  BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+  ~BufferedFileWriter() override {
+    flushBuffer();
+    free(buffer);
+  }
+
+  // Logical write position: where the next byte lands once the staged tail is flushed
+  uint32_t position() const { return static_cast<uint32_t>(file.position()) + filled; }
+
+  size_t write(const uint8_t b) override { return write(&b, 1); }
+
+  size_t write(const uint8_t* data, const size_t size) override {
+    if (buffer == nullptr) {
+      return file.write(data, size);
+    }
+    if (failed) {
+      return 0;
+    }
+    size_t written = 0;
+    while (written < size) {
+      // Full-buffer-or-larger writes from an empty buffer skip the staging copy
+      if (filled == 0 && size - written >= capacity) {
+        if (file.write(data + written, size - written) != size - written) {
+          failed = true;
+          return written;
+        }
+        return size;
+      }
+      const size_t space = capacity - filled;
+      const size_t chunk = size - written < space ? size - written : space;
+      memcpy(buffer + filled, data + written, chunk);
+      filled += chunk;
+      written += chunk;
+      if (filled == capacity && !flushBuffer()) {
+        return written - filled;  // the buffered tail never reached the card
+      }
+    }
+    return size;
+  }
+
+  // Push the staged tail to the card; false once any underlying write has failed
+  bool flushBuffer() {
+    if (failed) {
+      return false;
+    }
+    if (filled == 0) {
+      return true;
+    }
+    if (file.write(buffer, filled) != filled) {
+      failed = true;
+      return false;
+    }
+    filled = 0;
+    return true;
+  }
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Print.h>
+
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Coalescing Print adapter for sinks with per-call overhead.
+ *
+ * The inflate loop behind ZipFile::readFileToStream emits output in whatever odd-sized pieces
+ * tinfl produces per input chunk - often a few hundred bytes. Pushed one at a time into an
+ * FsFile those become sub-sector writes, each paying an SdFat call and a read-modify-write of
+ * the sector it lands in. Wrapping the sink in a BufferedPrint aggregates the pieces into
+ * aligned writes of the sink's preferred size; writes already at or above the buffer size pass
+ * straight through with no staging copy.
+ *
+ * The final partial buffer goes out in flushBuffer(), which the owner must call (and should
+ * check) before closing the underlying sink; the destructor flushes as a backstop. When the
+ * buffer allocation fails the adapter degrades to pass-through.
+ */
+class BufferedPrint final : public Print {
+  Print& out;
+  uint8_t* buffer;
+  const size_t capacity;
+  size_t filled = 0;
+  bool failed = false;
+
+ public:
+  // One SD sector multiple: large enough to amortise the SdFat call, small enough to not
+  // matter next to the 32KB inflate dictionary already allocated on this path
+  static constexpr size_t FILE_SINK_CAPACITY = 4096;
+
+  BufferedPrint(Print& out, const size_t capacity) : out(out), capacity(capacity) {
+    buffer = static_cast<uint8_t*>(malloc(capacity));
+  }
+  BufferedPrint(const BufferedPrint&) = delete;
+  BufferedPrint& operator=(const BufferedPrint&) = delete;
+  ~BufferedPrint() override {
+    flushBuffer();
+    free(buffer);
+  }
+
+  size_t write(const uint8_t b) override { return write(&b, 1); }
+
+  size_t write(const uint8_t* data, const size_t size) override {
+    if (buffer == nullptr) {
+      return out.write(data, size);
+    }
+    if (failed) {
+      return 0;
+    }
+    size_t written = 0;
+    while (written < size) {
+      // Full-buffer-or-larger writes from an empty buffer skip the staging copy
+      if (filled == 0 && size - written >= capacity) {
+        if (out.write(data + written, size - written) != size - written) {
+          failed = true;
+          return written;
+        }
+        return size;
+      }
+      const size_t space = capacity - filled;
+      const size_t chunk = size - written < space ? size - written : space;
+      memcpy(buffer + filled, data + written, chunk);
+      filled += chunk;
+      written += chunk;
+      if (filled == capacity && !flushBuffer()) {
+        return written - filled;  // the buffered tail never reached the sink
+      }
+    }
+    return size;
+  }
+
+  // Push the buffered tail to the sink; false once any underlying write has failed
+  bool flushBuffer() {
+    if (failed) {
+      return false;
+    }
+    if (filled == 0) {
+      return true;
+    }
+    if (out.write(buffer, filled) != filled) {
+      failed = true;
+      return false;
+    }
+    filled = 0;
+    return true;
+  }
+};
@@ -0,0 +1,131 @@
+#include "FileHandleCache.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+FileHandleCache FileHandleCache::instance;
+
+FileHandleCache& FileHandleCache::getInstance() { return instance; }
+
+void FileHandleCache::lock() {
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateMutex();
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+void FileHandleCache::unlock() const { xSemaphoreGive(mutex); }
+
+FsFile* FileHandleCache::acquire(const char* tag, const std::string& path) {
+  lock();
+
+  // Hit: hand out the already-open handle, skipping the directory walk entirely
+  for (auto& entry : entries) {
+    if (!entry.busy && entry.file && entry.path == path) {
+      entry.busy = true;
+      entry.lastUse = ++useTick;
+      unlock();
+      return &entry.file;
+    }
+  }
+
+  // Miss: take a free slot, else evict the least-recently-used idle handle
+  Entry* slot = nullptr;
+  for (auto& entry : entries) {
+    if (!entry.busy && !entry.file) {
+      slot = &entry;
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    for (auto& entry : entries) {
+      if (!entry.busy && (slot == nullptr || entry.lastUse < slot->lastUse)) {
+        slot = &entry;
+      }
+    }
+  }
+
+  if (slot == nullptr) {
+    // Every slot is acquired (same path twice, or many concurrent readers): fall back to a
+    // plain uncached open so the caller never blocks on another task's handle
+    unlock();
+    auto* file = new FsFile();
+    if (!SdMan.openFileForRead(tag, path, *file)) {
+      delete file;
+      return nullptr;
+    }
+    return file;
+  }
+
+  if (slot->file) {
+    slot->file.close();
+  }
+  slot->path = path;
+  slot->busy = true;
+  slot->stale = false;
+  slot->lastUse = ++useTick;
+  unlock();
+
+  // The open itself runs outside the lock; the slot is reserved via busy, and openFileForRead
+  // already logs the failure under the caller's tag
+  if (!SdMan.openFileForRead(tag, path, slot->file)) {
+    lock();
+    slot->path.clear();
+    slot->busy = false;
+    unlock();
+    return nullptr;
+  }
+  return &slot->file;
+}
+
+void FileHandleCache::release(FsFile* handle) {
+  if (handle == nullptr) {
+    return;
+  }
+  lock();
+  for (auto& entry : entries) {
+    if (&entry.file == handle) {
+      if (entry.stale) {
+        // The file behind the handle was replaced or removed while we held it
+        entry.file.close();
+        entry.path.clear();
+        entry.stale = false;
+      }
+      entry.busy = false;
+      unlock();
+      return;
+    }
+  }
+  unlock();
+  // Fallback handle from the all-busy path: close and free it
+  handle->close();
+  delete handle;
+}
+
+void FileHandleCache::invalidate(const std::string& path) {
+  lock();
+  for (auto& entry : entries) {
+    if (entry.path == path) {
+      if (entry.busy) {
+        entry.stale = true;  // Closed by release(); the holder already has the handle open
+      } else {
+        entry.file.close();
+        entry.path.clear();
+      }
+    }
+  }
+  unlock();
+}
+
+void FileHandleCache::invalidateAll() {
+  lock();
+  for (auto& entry : entries) {
+    if (entry.busy) {
+      entry.stale = true;
+    } else if (entry.file) {
+      entry.file.close();
+      entry.path.clear();
+    }
+  }
+  unlock();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <SdFat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <string>
+
+/**
+ * Small LRU of open FsFile handles keyed by path.
+ *
+ * SdFat resolves a path by walking the directory chain on every open, and the hot readers pay
+ * that per operation: the section file on each page turn, the zip container on each content
+ * read. Long-lived read paths acquire their handle here instead - a hit hands back the
+ * already-open handle, so steady-state reading performs zero path resolutions.
+ *
+ * A handle is exclusive between acquire() and release(); acquiring a path that is currently
+ * busy (or when every slot is) falls back to a plain uncached open, so callers never block on
+ * each other. Writers must invalidate() a path before replacing or removing the file behind a
+ * potentially cached handle; bulk cache wipes call invalidateAll().
+ */
+class FileHandleCache {
+ public:
+  FileHandleCache(const FileHandleCache&) = delete;
+  FileHandleCache& operator=(const FileHandleCache&) = delete;
+
+  static FileHandleCache& getInstance();
+
+  // Open-or-reuse a read handle for the path. The returned pointer stays valid until
+  // release(); the file position is unspecified, so seek before reading (every caller on the
+  // cached paths already does). nullptr when the open fails, logged under the caller's tag.
+  FsFile* acquire(const char* tag, const std::string& path);
+
+  // Hand the handle back. Cached handles stay open for the next acquire; fallback handles
+  // (and handles invalidated while busy) are closed and freed here.
+  void release(FsFile* handle);
+
+  // Close and drop any cached handle for the path; call before writing to or removing it
+  void invalidate(const std::string& path);
+
+  // Drop every handle not currently acquired (busy ones close on release); for bulk deletes
+  // of whole cache trees where per-path invalidation isn't practical
+  void invalidateAll();
+
+ private:
+  FileHandleCache() = default;
+  static FileHandleCache instance;
+
+  // Zip container + section file + one neighbour under speculation, with a slot to spare
+  static constexpr size_t MAX_HANDLES = 4;
+
+  struct Entry {
+    std::string path;
+    FsFile file;
+    bool busy = false;
+    bool stale = false;  // Invalidated while acquired; closed instead of recycled on release
+    uint32_t lastUse = 0;
+  };
+  Entry entries[MAX_HANDLES];
+  uint32_t useTick = 0;
+
+  // Created on first acquire, which happens on the main task during the first book open
+  SemaphoreHandle_t mutex = nullptr;
+  void lock();
+  void unlock() const;
+};
+
+#define FILE_HANDLES FileHandleCache::getInstance()
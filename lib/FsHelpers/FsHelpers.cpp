@@ -1,39 +1,121 @@
 #include "FsHelpers.h"
 
-#include <vector>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
 
-std::string FsHelpers::normalisePath(const std::string& path) {
-  std::vector<std::string> components;
-  std::string component;
-
-  for (const auto c : path) {
-    if (c == '/') {
-      if (!component.empty()) {
-        if (component == "..") {
-          if (!components.empty()) {
-            components.pop_back();
-          }
-        } else {
-          components.push_back(component);
-        }
-        component.clear();
+void FsHelpers::normalisePathInPlace(std::string& path) {
+  // Two-cursor compaction: output only ever shrinks, so the write cursor never passes the read
+  // cursor and the whole pass runs inside the string's own buffer with no side allocations
+  size_t write = 0;
+  size_t read = 0;
+  const size_t len = path.size();
+
+  while (read < len) {
+    while (read < len && path[read] == '/') {
+      read++;
+    }
+    const size_t start = read;
+    while (read < len && path[read] != '/') {
+      read++;
+    }
+    const size_t componentLen = read - start;
+    if (componentLen == 0) {
+      continue;
+    }
+    if (componentLen == 2 && path[start] == '.' && path[start + 1] == '.') {
+      // Pop the previous component (and its separator); ".." at the root just drops
+      while (write > 0 && path[write - 1] != '/') {
+        write--;
       }
-    } else {
-      component += c;
+      if (write > 0) {
+        write--;
+      }
+      continue;
+    }
+    if (write > 0) {
+      path[write++] = '/';
+    }
+    for (size_t i = 0; i < componentLen; i++) {
+      path[write++] = path[start + i];
     }
   }
 
-  if (!component.empty()) {
-    components.push_back(component);
+  path.resize(write);
+}
+
+std::string FsHelpers::normalisePath(const std::string& path) {
+  std::string result = path;
+  normalisePathInPlace(result);
+  return result;
+}
+
+std::string& FsHelpers::joinAndNormalise(std::string& out, const std::string& base, const char* rel) {
+  out.assign(base);
+  out.append(rel);
+  normalisePathInPlace(out);
+  return out;
+}
+
+namespace {
+// Same time-sliced yield the chapter build uses: long deletions share the core instead of
+// starving the input and display tasks
+constexpr uint32_t DELETE_YIELD_INTERVAL_MS = 100;
+
+bool removeTree(const std::string& path, size_t& removedCount, uint32_t& lastYieldMs,
+                const std::function<void(size_t)>& progressFn) {
+  FsFile dir = SdMan.open(path.c_str());
+  if (!dir || !dir.isDirectory()) {
+    if (dir) {
+      dir.close();
+    }
+    return false;
   }
 
-  std::string result;
-  for (const auto& c : components) {
-    if (!result.empty()) {
-      result += "/";
+  // Children are removed while the parent handle iterates; the directory stream has already
+  // moved past each entry when it is deleted, so the walk never re-opens the parent (the same
+  // pattern SdFat's own rmRfStar relies on)
+  bool ok = true;
+  char name[128];
+  std::string childPath;
+  for (FsFile entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    entry.getName(name, sizeof(name));
+    const bool isDir = entry.isDirectory();
+    entry.close();
+    childPath.assign(path).append("/").append(name);
+
+    if (isDir) {
+      ok &= removeTree(childPath, removedCount, lastYieldMs, progressFn);
+    } else if (SdMan.remove(childPath.c_str())) {
+      removedCount++;
+      if (progressFn) {
+        progressFn(removedCount);
+      }
+    } else {
+      Serial.printf("[%lu] [FSH] Failed to remove: %s\n", millis(), childPath.c_str());
+      ok = false;
+    }
+
+    if (millis() - lastYieldMs >= DELETE_YIELD_INTERVAL_MS) {
+      lastYieldMs = millis();
+      delay(1);
     }
-    result += c;
   }
+  dir.close();
 
-  return result;
+  if (!SdMan.removeDir(path.c_str())) {
+    Serial.printf("[%lu] [FSH] Failed to remove directory: %s\n", millis(), path.c_str());
+    return false;
+  }
+  removedCount++;
+  if (progressFn) {
+    progressFn(removedCount);
+  }
+  return ok;
+}
+}  // namespace
+
+bool FsHelpers::removeDirRecursive(const std::string& path, const std::function<void(size_t)>& progressFn) {
+  uint32_t lastYieldMs = millis();
+  size_t removedCount = 0;
+  return removeTree(path, removedCount, lastYieldMs, progressFn);
 }
@@ -1,7 +1,23 @@
 #pragma once
+#include <functional>
 #include <string>
 
 class FsHelpers {
  public:
   static std::string normalisePath(const std::string& path);
+  // Same normalisation without the return-value allocation: compacts the string's own buffer,
+  // so a caller that already owns the string pays nothing. Parsers that normalise per manifest
+  // item should prefer this (or joinAndNormalise) over normalisePath
+  static void normalisePathInPlace(std::string& path);
+  // base + rel joined into out (whose capacity is reused across calls) and normalised in place;
+  // returns out for call-site convenience
+  static std::string& joinAndNormalise(std::string& out, const std::string& base, const char* rel);
+  // Bulk deletion of a cache tree. The SDK's SdMan.removeDir() walks the tree too, but blocks
+  // whatever task calls it until the whole subtree is gone - minutes on a well-used cache.
+  // This walks each directory with one reused handle, deletes entries as it goes, yields the
+  // task briefly on a fixed interval so the UI keeps breathing, and reports the running count
+  // of removed entries through progressFn. Failures are logged and skipped so one stuck file
+  // doesn't strand the rest of the tree; returns false if anything was left behind.
+  static bool removeDirRecursive(const std::string& path,
+                                 const std::function<void(size_t)>& progressFn = nullptr);
 };
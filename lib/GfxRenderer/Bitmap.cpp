@@ -17,6 +17,8 @@ Bitmap::~Bitmap() {
 
   delete atkinsonDitherer;
   delete fsDitherer;
+
+  free(bandBuffer);
 }
 
 uint16_t Bitmap::readLE16(FsFile& f) {
@@ -57,7 +59,7 @@ const char* Bitmap::errorToString(BmpReaderError err) {
     case BmpReaderError::BadPlanes:
       return "BadPlanes (!= 1)";
     case BmpReaderError::UnsupportedBpp:
-      return "UnsupportedBpp (expected 1, 2, 8, 24, or 32)";
+      return "UnsupportedBpp (expected 1, 2, 4, 8, 24, or 32)";
     case BmpReaderError::UnsupportedCompression:
       return "UnsupportedCompression (expected BI_RGB or BI_BITFIELDS for 32bpp)";
     case BmpReaderError::BadDimensions:
@@ -103,7 +105,7 @@ BmpReaderError Bitmap::parseHeaders() {
   const uint16_t planes = readLE16(file);
   bpp = readLE16(file);
   const uint32_t comp = readLE32(file);
-  const bool validBpp = bpp == 1 || bpp == 2 || bpp == 8 || bpp == 24 || bpp == 32;
+  const bool validBpp = bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8 || bpp == 24 || bpp == 32;
 
   if (planes != 1) return BmpReaderError::BadPlanes;
   if (!validBpp) return BmpReaderError::UnsupportedBpp;
@@ -127,6 +129,17 @@ BmpReaderError Bitmap::parseHeaders() {
   // Pre-calculate Row Bytes to avoid doing this every row
   rowBytes = (width * bpp + 31) / 32 * 4;
 
+  // Stage several source rows per SD read; one transaction per row dominated draw time on
+  // full-screen covers. Very wide rows degrade to a single-row band (same memory as before).
+  bandRowCapacity = static_cast<int>(BAND_TARGET_BYTES) / rowBytes;
+  if (bandRowCapacity < 1) bandRowCapacity = 1;
+  if (bandRowCapacity > height) bandRowCapacity = height;
+  free(bandBuffer);
+  bandBuffer = static_cast<uint8_t*>(malloc(static_cast<size_t>(bandRowCapacity) * rowBytes));
+  if (!bandBuffer) return BmpReaderError::OomRowBuffer;
+  bandRowsFilled = 0;
+  bandRowCursor = 0;
+
   for (int i = 0; i < 256; i++) paletteLum[i] = static_cast<uint8_t>(i);
   if (colorsUsed > 0) {
     for (uint32_t i = 0; i < colorsUsed; i++) {
@@ -136,6 +149,31 @@ BmpReaderError Bitmap::parseHeaders() {
     }
   }
 
+  // 4-bit grayscale covers store raw tones; fold the per-pixel adjust and quantize into a
+  // positional LUT once so readNextRow maps each nibble with a single lookup. Ordered 4x4
+  // Bayer offsets dither between adjacent panel levels (same linear segments as the noise
+  // quantizer), which keeps smooth gradients from banding at 4 output levels.
+  if (bpp == 4) {
+    constexpr uint8_t BAYER4[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+    for (int y = 0; y < 4; y++) {
+      for (int x = 0; x < 4; x++) {
+        const int threshold = BAYER4[y][x] * 16 + 8;
+        for (int n = 0; n < 16; n++) {
+          const int scaled = adjustPixel(paletteLum[n]) * 3;
+          uint8_t level;
+          if (scaled < 255) {
+            level = (scaled + threshold >= 255) ? 1 : 0;
+          } else if (scaled < 510) {
+            level = ((scaled - 255) + threshold >= 255) ? 2 : 1;
+          } else {
+            level = ((scaled - 510) + threshold >= 255) ? 3 : 2;
+          }
+          toneLut4[(y << 6) | (x << 4) | n] = level;
+        }
+      }
+    }
+  }
+
   if (!file.seek(bfOffBits)) {
     return BmpReaderError::SeekPixelDataFailed;
   }
@@ -154,9 +192,16 @@ BmpReaderError Bitmap::parseHeaders() {
 }
 
 // packed 2bpp output, 0 = black, 1 = dark gray, 2 = light gray, 3 = white
-BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
-  // Note: rowBuffer should be pre-allocated by the caller to size 'rowBytes'
-  if (file.read(rowBuffer, rowBytes) != rowBytes) return BmpReaderError::ShortReadRow;
+BmpReaderError Bitmap::readNextRow(uint8_t* data) const {
+  // Refill the band when drained; a short final read just yields a partial band
+  if (bandRowCursor >= bandRowsFilled) {
+    const int got = file.read(bandBuffer, static_cast<size_t>(bandRowCapacity) * rowBytes);
+    bandRowsFilled = got > 0 ? got / rowBytes : 0;
+    bandRowCursor = 0;
+    if (bandRowsFilled == 0) return BmpReaderError::ShortReadRow;
+  }
+  const uint8_t* rowBuffer = bandBuffer + static_cast<size_t>(bandRowCursor) * rowBytes;
+  bandRowCursor++;
 
   prevRowY += 1;
 
@@ -165,7 +210,19 @@ BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
   int bitShift = 6;
   int currentX = 0;
 
-  // Helper lambda to pack 2bpp color into the output stream
+  // Helper lambda to pack an already quantized 2bpp color into the output stream
+  auto packColor = [&](const uint8_t color) {
+    currentOutByte |= (color << bitShift);
+    if (bitShift == 0) {
+      *outPtr++ = currentOutByte;
+      currentOutByte = 0;
+      bitShift = 6;
+    } else {
+      bitShift -= 2;
+    }
+  };
+
+  // Helper lambda to quantize a luminance and pack it
   auto packPixel = [&](const uint8_t lum) {
     uint8_t color;
     if (atkinsonDitherer) {
@@ -181,14 +238,7 @@ BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
         color = static_cast<uint8_t>(lum >> 6);
       }
     }
-    currentOutByte |= (color << bitShift);
-    if (bitShift == 0) {
-      *outPtr++ = currentOutByte;
-      currentOutByte = 0;
-      bitShift = 6;
-    } else {
-      bitShift -= 2;
-    }
+    packColor(color);
     currentX++;
   };
 
@@ -219,6 +269,25 @@ BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
       }
       break;
     }
+    case 4: {
+      if (atkinsonDitherer || fsDitherer) {
+        // Error-diffusion path (custom sleep screens): feed the palette luminance through
+        // the same per-pixel pipeline as the other depths
+        for (int x = 0; x < width; x++) {
+          lum = paletteLum[(rowBuffer[x >> 1] >> ((x & 1) ? 0 : 4)) & 0x0F];
+          packPixel(lum);
+        }
+      } else {
+        // Fast path for the 4-bit cover cache: one positional LUT lookup per nibble instead
+        // of adjust + quantize per pixel
+        const uint8_t* lutRow = &toneLut4[(prevRowY & 3) << 6];
+        for (int x = 0; x < width; x++) {
+          const uint8_t idx = (rowBuffer[x >> 1] >> ((x & 1) ? 0 : 4)) & 0x0F;
+          packColor(lutRow[((x & 3) << 4) | idx]);
+        }
+      }
+      break;
+    }
     case 2: {
       for (int x = 0; x < width; x++) {
         lum = paletteLum[(rowBuffer[x >> 2] >> (6 - ((x & 3) * 2))) & 0x03];
@@ -256,9 +325,15 @@ BmpReaderError Bitmap::rewindToData() const {
     return BmpReaderError::SeekPixelDataFailed;
   }
 
-  // Reset dithering when rewinding
+  // Reset dithering and the staged band when rewinding. The row counter restarts too, so
+  // positional quantization (the 4-bit tone LUT, noise dithering) picks the same level for
+  // every pixel on each pass - the grayscale planes are drawn from separate decodes and
+  // must agree.
   if (fsDitherer) fsDitherer->reset();
   if (atkinsonDitherer) atkinsonDitherer->reset();
+  prevRowY = -1;
+  bandRowsFilled = 0;
+  bandRowCursor = 0;
 
   return BmpReaderError::Ok;
 }
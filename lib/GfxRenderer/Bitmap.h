@@ -35,7 +35,10 @@ class Bitmap {
   explicit Bitmap(FsFile& file, bool dithering = false) : file(file), dithering(dithering) {}
   ~Bitmap();
   BmpReaderError parseHeaders();
-  BmpReaderError readNextRow(uint8_t* data, uint8_t* rowBuffer) const;
+  // Decodes the next scanline into `data` (packed 2bpp). Source rows are pulled from an
+  // internal multi-row band refilled with one bulk SD read, so large images stream at a
+  // fraction of the per-row transaction cost.
+  BmpReaderError readNextRow(uint8_t* data) const;
   BmpReaderError rewindToData() const;
   int getWidth() const { return width; }
   int getHeight() const { return height; }
@@ -59,6 +62,14 @@ class Bitmap {
   int rowBytes = 0;
   uint8_t paletteLum[256] = {};
 
+  // Band buffer: raw source rows staged ahead of decoding. Sized to ~BAND_TARGET_BYTES
+  // (at least one row), so memory stays constant regardless of image size.
+  static constexpr size_t BAND_TARGET_BYTES = 4096;
+  mutable uint8_t* bandBuffer = nullptr;
+  int bandRowCapacity = 0;
+  mutable int bandRowsFilled = 0;
+  mutable int bandRowCursor = 0;
+
   // Floyd-Steinberg dithering state (mutable for const methods)
   mutable int16_t* errorCurRow = nullptr;
   mutable int16_t* errorNextRow = nullptr;
@@ -66,4 +77,10 @@ class Bitmap {
 
   mutable AtkinsonDitherer* atkinsonDitherer = nullptr;
   mutable FloydSteinbergDitherer* fsDitherer = nullptr;
+
+  // 4-bit grayscale tone map, built once in parseHeaders: panel level for every
+  // (row & 3, column & 3, nibble) combination, so the blit loop is one indexed load per
+  // pixel. The 4x4 Bayer offsets dither between adjacent panel levels, which keeps the 16
+  // stored tones from banding when folded down to 4.
+  uint8_t toneLut4[256] = {};
 };
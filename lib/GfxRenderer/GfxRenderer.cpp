@@ -1,41 +1,150 @@
 #include "GfxRenderer.h"
 
+#include <HeapMonitor.h>
 #include <Utf8.h>
 
-void GfxRenderer::insertFont(const int fontId, EpdFontFamily font) { fontMap.insert({fontId, font}); }
+#include <utility>
+
+namespace {
+// Compile-time counterpart of GfxRenderer::rotateCoordinates(): each instantiation folds the
+// orientation branch away, so per-pixel loops reduce to plain address arithmetic
+template <GfxRenderer::Orientation O>
+inline void rotateForOrientation(const int x, const int y, int* rotatedX, int* rotatedY) {
+  if constexpr (O == GfxRenderer::Portrait) {
+    // Logical portrait (480x800) → panel (800x480), rotated 90 degrees clockwise
+    *rotatedX = y;
+    *rotatedY = HalDisplay::DISPLAY_HEIGHT - 1 - x;
+  } else if constexpr (O == GfxRenderer::LandscapeClockwise) {
+    // Logical landscape (800x480) rotated 180 degrees (swap top/bottom and left/right)
+    *rotatedX = HalDisplay::DISPLAY_WIDTH - 1 - x;
+    *rotatedY = HalDisplay::DISPLAY_HEIGHT - 1 - y;
+  } else if constexpr (O == GfxRenderer::PortraitInverted) {
+    // Logical portrait (480x800) → panel (800x480), rotated 90 degrees counter-clockwise
+    *rotatedX = HalDisplay::DISPLAY_WIDTH - 1 - y;
+    *rotatedY = x;
+  } else {
+    // LandscapeCounterClockwise: logical landscape aligned with the panel orientation
+    *rotatedX = x;
+    *rotatedY = y;
+  }
+}
+
+// Logical screen dimensions per orientation (the portrait modes swap the panel axes)
+template <GfxRenderer::Orientation O>
+constexpr int logicalWidth() {
+  return O == GfxRenderer::Portrait || O == GfxRenderer::PortraitInverted ? HalDisplay::DISPLAY_HEIGHT
+                                                                          : HalDisplay::DISPLAY_WIDTH;
+}
+
+template <GfxRenderer::Orientation O>
+constexpr int logicalHeight() {
+  return O == GfxRenderer::Portrait || O == GfxRenderer::PortraitInverted ? HalDisplay::DISPLAY_WIDTH
+                                                                          : HalDisplay::DISPLAY_HEIGHT;
+}
+}  // namespace
+
+void GfxRenderer::insertFont(const int fontId, EpdFontFamily font) {
+  for (const FontSlot& slot : fonts) {
+    if (slot.id == fontId) {
+      return;  // first registration wins, matching the old map::insert semantics
+    }
+  }
+  fonts.push_back({fontId, font});
+  lastFontIdx = -1;  // the vector may have reallocated
+}
+
+const EpdFontFamily* GfxRenderer::findFont(const int fontId) const {
+  if (lastFontIdx >= 0 && fonts[lastFontIdx].id == fontId) {
+    return &fonts[lastFontIdx].family;
+  }
+  for (size_t i = 0; i < fonts.size(); i++) {
+    if (fonts[i].id == fontId) {
+      lastFontIdx = static_cast<int>(i);
+      return &fonts[i].family;
+    }
+  }
+  Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  return nullptr;
+}
+
+// Expands the dirty bounding box by a rectangle in logical coordinates, clamped to the screen
+void GfxRenderer::markDirty(const int x, const int y, const int width, const int height) const {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  const int x0 = x < 0 ? 0 : x;
+  const int y0 = y < 0 ? 0 : y;
+  const int x1 = x + width > getScreenWidth() ? getScreenWidth() - 1 : x + width - 1;
+  const int y1 = y + height > getScreenHeight() ? getScreenHeight() - 1 : y + height - 1;
+  if (x1 < x0 || y1 < y0) {
+    return;
+  }
+  if (!hasDirtyRegion()) {
+    dirtyMinX = x0;
+    dirtyMinY = y0;
+    dirtyMaxX = x1;
+    dirtyMaxY = y1;
+    return;
+  }
+  dirtyMinX = x0 < dirtyMinX ? x0 : dirtyMinX;
+  dirtyMinY = y0 < dirtyMinY ? y0 : dirtyMinY;
+  dirtyMaxX = x1 > dirtyMaxX ? x1 : dirtyMaxX;
+  dirtyMaxY = y1 > dirtyMaxY ? y1 : dirtyMaxY;
+}
+
+void GfxRenderer::markAllDirty() const { markDirty(0, 0, getScreenWidth(), getScreenHeight()); }
+
+void GfxRenderer::setClipRect(const int x, const int y, const int width, const int height) {
+  clipX = x;
+  clipY = y;
+  clipWidth = width;
+  clipHeight = height;
+  clipEnabled = width > 0 && height > 0;
+}
+
+void GfxRenderer::clearClipRect() { clipEnabled = false; }
+
+// Half-open clip bounds intersected with the screen. Without an explicit clip this is just the
+// screen rect, so the rejection in the draw paths doubles as plain offscreen culling.
+void GfxRenderer::getClipBounds(int* left, int* top, int* right, int* bottom) const {
+  *left = 0;
+  *top = 0;
+  *right = getScreenWidth();
+  *bottom = getScreenHeight();
+  if (clipEnabled) {
+    *left = std::max(*left, clipX);
+    *top = std::max(*top, clipY);
+    *right = std::min(*right, clipX + clipWidth);
+    *bottom = std::min(*bottom, clipY + clipHeight);
+  }
+}
+
+void GfxRenderer::clearDirty() const {
+  dirtyMinX = 0;
+  dirtyMinY = 0;
+  dirtyMaxX = -1;
+  dirtyMaxY = -1;
+}
 
 void GfxRenderer::rotateCoordinates(const int x, const int y, int* rotatedX, int* rotatedY) const {
   switch (orientation) {
-    case Portrait: {
-      // Logical portrait (480x800) → panel (800x480)
-      // Rotation: 90 degrees clockwise
-      *rotatedX = y;
-      *rotatedY = HalDisplay::DISPLAY_HEIGHT - 1 - x;
+    case Portrait:
+      rotateForOrientation<Portrait>(x, y, rotatedX, rotatedY);
       break;
-    }
-    case LandscapeClockwise: {
-      // Logical landscape (800x480) rotated 180 degrees (swap top/bottom and left/right)
-      *rotatedX = HalDisplay::DISPLAY_WIDTH - 1 - x;
-      *rotatedY = HalDisplay::DISPLAY_HEIGHT - 1 - y;
+    case LandscapeClockwise:
+      rotateForOrientation<LandscapeClockwise>(x, y, rotatedX, rotatedY);
       break;
-    }
-    case PortraitInverted: {
-      // Logical portrait (480x800) → panel (800x480)
-      // Rotation: 90 degrees counter-clockwise
-      *rotatedX = HalDisplay::DISPLAY_WIDTH - 1 - y;
-      *rotatedY = x;
+    case PortraitInverted:
+      rotateForOrientation<PortraitInverted>(x, y, rotatedX, rotatedY);
       break;
-    }
-    case LandscapeCounterClockwise: {
-      // Logical landscape (800x480) aligned with panel orientation
-      *rotatedX = x;
-      *rotatedY = y;
+    case LandscapeCounterClockwise:
+      rotateForOrientation<LandscapeCounterClockwise>(x, y, rotatedX, rotatedY);
       break;
-    }
   }
 }
 
 void GfxRenderer::drawPixel(const int x, const int y, const bool state) const {
+  markDirty(x, y, 1, 1);
   uint8_t* frameBuffer = display.getFrameBuffer();
 
   // Early return if no framebuffer is set
@@ -66,13 +175,13 @@ void GfxRenderer::drawPixel(const int x, const int y, const bool state) const {
 }
 
 int GfxRenderer::getTextWidth(const int fontId, const char* text, const EpdFontFamily::Style style) const {
-  if (fontMap.count(fontId) == 0) {
-    Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  const EpdFontFamily* font = findFont(fontId);
+  if (font == nullptr) {
     return 0;
   }
 
   int w = 0, h = 0;
-  fontMap.at(fontId).getTextDimensions(text, &w, &h, style);
+  font->getTextDimensions(text, &w, &h, style);
   return w;
 }
 
@@ -92,21 +201,95 @@ void GfxRenderer::drawText(const int fontId, const int x, const int y, const cha
     return;
   }
 
-  if (fontMap.count(fontId) == 0) {
-    Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  const EpdFontFamily* fontPtr = findFont(fontId);
+  if (fontPtr == nullptr) {
     return;
   }
-  const auto font = fontMap.at(fontId);
+  const EpdFontFamily& font = *fontPtr;
 
   // no printable characters
   if (!font.hasPrintableChars(text, style)) {
     return;
   }
 
-  uint32_t cp;
-  while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&text)))) {
-    renderChar(font, cp, &xpos, &yPos, black, style);
+  // Whole-run rejection: a line entirely outside the clip band (or past its right edge) skips
+  // UTF-8 decoding and glyph lookup altogether; per-glyph rejection handles the partial cases
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  if (x >= clipRight || y >= clipBottom || y + getLineHeight(fontId) <= clipTop) {
+    return;
+  }
+
+  utf8ForEachCodepoint(text, [&](const uint32_t cp, uint32_t) { renderChar(font, cp, &xpos, &yPos, black, style); });
+
+  // renderChar blits the framebuffer directly, so mark the text's extent here
+  markDirty(x, y, xpos - x, getLineHeight(fontId));
+}
+
+void GfxRenderer::drawText(const int fontId, const int x, const int y, const EpdShapedRun& run, const bool black,
+                           const EpdFontFamily::Style style) const {
+  if (run.empty()) {
+    return;
+  }
+
+  const EpdFontFamily* fontPtr = findFont(fontId);
+  if (fontPtr == nullptr) {
+    return;
+  }
+  const EpdFontFamily& font = *fontPtr;
+
+  // The shaped run carries its width, so fully offscreen rows reject in constant time
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  if (x >= clipRight || x + run.width <= clipLeft || y >= clipBottom || y + getLineHeight(fontId) <= clipTop) {
+    return;
   }
+
+  // Glyphs were already resolved when the run was shaped; style must match the shaping call
+  const int yPos = y + getFontAscenderSize(fontId);
+  int xpos = x;
+  for (const auto& shaped : run.glyphs) {
+    renderGlyph(font, shaped.cp, shaped.glyph, &xpos, &yPos, black, style);
+  }
+
+  markDirty(x, y, xpos - x, getLineHeight(fontId));
+}
+
+void GfxRenderer::drawGlyphs(const int fontId, const int x, const int y, const uint32_t* cps, const size_t count,
+                             const bool black, const EpdFontFamily::Style style) const {
+  if (cps == nullptr || count == 0) {
+    return;
+  }
+
+  const EpdFontFamily* fontPtr = findFont(fontId);
+  if (fontPtr == nullptr) {
+    return;
+  }
+  const EpdFontFamily& font = *fontPtr;
+
+  // Compiled page records are laid out a line at a time, so vertical rejection alone is enough
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  if (x >= clipRight || y >= clipBottom || y + getLineHeight(fontId) <= clipTop) {
+    return;
+  }
+
+  const int yPos = y + getFontAscenderSize(fontId);
+  int xpos = x;
+  for (size_t i = 0; i < count; i++) {
+    uint32_t cp = cps[i];
+    const EpdGlyph* glyph = font.getGlyph(cp, style);
+    if (!glyph) {
+      cp = REPLACEMENT_GLYPH;
+      glyph = font.getGlyph(cp, style);
+    }
+    if (!glyph) {
+      continue;
+    }
+    renderGlyph(font, cp, glyph, &xpos, &yPos, black, style);
+  }
+
+  markDirty(x, y, xpos - x, getLineHeight(fontId));
 }
 
 void GfxRenderer::drawLine(int x1, int y1, int x2, int y2, const bool state) const {
@@ -138,12 +321,112 @@ void GfxRenderer::drawRect(const int x, const int y, const int width, const int
 }
 
 void GfxRenderer::fillRect(const int x, const int y, const int width, const int height, const bool state) const {
+  markDirty(x, y, width, height);
+  bool filled = false;
+  switch (orientation) {
+    case Portrait:
+      filled = fillRectSpans<Portrait>(x, y, width, height, state);
+      break;
+    case LandscapeClockwise:
+      filled = fillRectSpans<LandscapeClockwise>(x, y, width, height, state);
+      break;
+    case PortraitInverted:
+      filled = fillRectSpans<PortraitInverted>(x, y, width, height, state);
+      break;
+    case LandscapeCounterClockwise:
+      filled = fillRectSpans<LandscapeCounterClockwise>(x, y, width, height, state);
+      break;
+  }
+  if (filled) {
+    return;
+  }
   for (int fillY = y; fillY < y + height; fillY++) {
     drawLine(x, fillY, x + width - 1, fillY, state);
   }
 }
 
+// All four logical-to-panel rotations are axis-aligned, so one logical axis always maps onto a
+// contiguous bit run within a panel row and the fill can run byte-at-a-time with masked edge
+// bytes instead of doing rotation and bit arithmetic per pixel. Returns false if no framebuffer
+// is set.
+template <GfxRenderer::Orientation O>
+bool GfxRenderer::fillRectSpans(int x, int y, int width, int height, const bool state) const {
+  uint8_t* frameBuffer = display.getFrameBuffer();
+  if (!frameBuffer) {
+    return false;
+  }
+
+  // Clip to logical screen bounds
+  if (x < 0) {
+    width += x;
+    x = 0;
+  }
+  if (y < 0) {
+    height += y;
+    y = 0;
+  }
+  if (x + width > logicalWidth<O>()) {
+    width = logicalWidth<O>() - x;
+  }
+  if (y + height > logicalHeight<O>()) {
+    height = logicalHeight<O>() - y;
+  }
+  if (width <= 0 || height <= 0) {
+    return true;
+  }
+
+  // Rotate opposite corners once and normalize into a panel-space rectangle
+  int px0, py0, px1, py1;
+  rotateForOrientation<O>(x, y, &px0, &py0);
+  rotateForOrientation<O>(x + width - 1, y + height - 1, &px1, &py1);
+  if (px0 > px1) {
+    std::swap(px0, px1);
+  }
+  if (py0 > py1) {
+    std::swap(py0, py1);
+  }
+
+  // The panel x span covers bits [px0, px1], MSB first within each byte
+  const int firstByte = px0 / 8;
+  const int lastByte = px1 / 8;
+  uint8_t firstMask = 0xFF >> (px0 % 8);
+  const uint8_t lastMask = 0xFF << (7 - px1 % 8);
+  if (firstByte == lastByte) {
+    firstMask &= lastMask;
+  }
+
+  for (int panelRow = py0; panelRow <= py1; panelRow++) {
+    uint8_t* rowStart = frameBuffer + panelRow * HalDisplay::DISPLAY_WIDTH_BYTES;
+    if (state) {
+      // Black: clear bits
+      rowStart[firstByte] &= ~firstMask;
+      if (lastByte > firstByte) {
+        rowStart[lastByte] &= ~lastMask;
+        if (lastByte - firstByte > 1) {
+          memset(rowStart + firstByte + 1, 0x00, lastByte - firstByte - 1);
+        }
+      }
+    } else {
+      // White: set bits
+      rowStart[firstByte] |= firstMask;
+      if (lastByte > firstByte) {
+        rowStart[lastByte] |= lastMask;
+        if (lastByte - firstByte > 1) {
+          memset(rowStart + firstByte + 1, 0xFF, lastByte - firstByte - 1);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template bool GfxRenderer::fillRectSpans<GfxRenderer::Portrait>(int, int, int, int, bool) const;
+template bool GfxRenderer::fillRectSpans<GfxRenderer::LandscapeClockwise>(int, int, int, int, bool) const;
+template bool GfxRenderer::fillRectSpans<GfxRenderer::PortraitInverted>(int, int, int, int, bool) const;
+template bool GfxRenderer::fillRectSpans<GfxRenderer::LandscapeCounterClockwise>(int, int, int, int, bool) const;
+
 void GfxRenderer::drawImage(const uint8_t bitmap[], const int x, const int y, const int width, const int height) const {
+  markDirty(x, y, width, height);
   int rotatedX = 0;
   int rotatedY = 0;
   rotateCoordinates(x, y, &rotatedX, &rotatedY);
@@ -163,6 +446,21 @@ void GfxRenderer::drawImage(const uint8_t bitmap[], const int x, const int y, co
       break;
   }
   // TODO: Rotate bits
+
+  // Byte-aligned blit straight into the framebuffer: the icon call sites land on byte
+  // boundaries, so the common case is one memcpy per row instead of the SDK's per-pixel path
+  uint8_t* frameBuffer = display.getFrameBuffer();
+  if (frameBuffer && width % 8 == 0 && rotatedX % 8 == 0 && rotatedX >= 0 && rotatedY >= 0 &&
+      rotatedX + width <= HalDisplay::DISPLAY_WIDTH && rotatedY + height <= HalDisplay::DISPLAY_HEIGHT) {
+    const int imageRowBytes = width / 8;
+    uint8_t* dst = frameBuffer + rotatedY * HalDisplay::DISPLAY_WIDTH_BYTES + rotatedX / 8;
+    for (int row = 0; row < height; row++) {
+      memcpy(dst, bitmap + row * imageRowBytes, imageRowBytes);
+      dst += HalDisplay::DISPLAY_WIDTH_BYTES;
+    }
+    return;
+  }
+
   display.drawImage(bitmap, rotatedX, rotatedY, width, height);
 }
 
@@ -195,15 +493,21 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
   // IMPORTANT: Use int, not uint8_t, to avoid overflow for images > 1020 pixels wide
   const int outputRowSize = (bitmap.getWidth() + 3) / 4;
   auto* outputRow = static_cast<uint8_t*>(malloc(outputRowSize));
-  auto* rowBytes = static_cast<uint8_t*>(malloc(bitmap.getRowBytes()));
 
-  if (!outputRow || !rowBytes) {
-    Serial.printf("[%lu] [GFX] !! Failed to allocate BMP row buffers\n", millis());
-    free(outputRow);
-    free(rowBytes);
+  if (!outputRow) {
+    Serial.printf("[%lu] [GFX] !! Failed to allocate BMP row buffer\n", millis());
     return;
   }
 
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  // The X offset and scale are constant across rows, so the first source column that can land
+  // inside the clip resolves once here and clamps every row's loop
+  int bmpXStart = cropPixX;
+  if (clipLeft > x) {
+    bmpXStart += isScaled ? static_cast<int>(std::ceil((clipLeft - x) / scale)) : clipLeft - x;
+  }
+
   for (int bmpY = 0; bmpY < (bitmap.getHeight() - cropPixY); bmpY++) {
     // The BMP's (0, 0) is the bottom-left corner (if the height is positive, top-left if negative).
     // Screen's (0, 0) is the top-left corner.
@@ -212,18 +516,19 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
       screenY = std::floor(screenY * scale);
     }
     screenY += y;  // the offset should not be scaled
-    if (screenY >= getScreenHeight()) {
+    // Rows advance down the screen for top-down BMPs and up it for bottom-up ones; once past
+    // the clip edge in that direction every later row lands further out, so stop reading
+    if (bitmap.isTopDown() ? screenY >= clipBottom : screenY < clipTop) {
       break;
     }
 
-    if (bitmap.readNextRow(outputRow, rowBytes) != BmpReaderError::Ok) {
+    if (bitmap.readNextRow(outputRow) != BmpReaderError::Ok) {
       Serial.printf("[%lu] [GFX] Failed to read row %d from bitmap\n", millis(), bmpY);
       free(outputRow);
-      free(rowBytes);
       return;
     }
 
-    if (screenY < 0) {
+    if (screenY < clipTop || screenY >= clipBottom) {
       continue;
     }
 
@@ -232,16 +537,16 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
       continue;
     }
 
-    for (int bmpX = cropPixX; bmpX < bitmap.getWidth() - cropPixX; bmpX++) {
+    for (int bmpX = bmpXStart; bmpX < bitmap.getWidth() - cropPixX; bmpX++) {
       int screenX = bmpX - cropPixX;
       if (isScaled) {
         screenX = std::floor(screenX * scale);
       }
       screenX += x;  // the offset should not be scaled
-      if (screenX >= getScreenWidth()) {
+      if (screenX >= clipRight) {
         break;
       }
-      if (screenX < 0) {
+      if (screenX < clipLeft) {
         continue;
       }
 
@@ -253,16 +558,46 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
         drawPixel(screenX, screenY, false);
       } else if (renderMode == GRAYSCALE_LSB && val == 1) {
         drawPixel(screenX, screenY, false);
+      } else if (renderMode == GRAYSCALE_2BIT) {
+        setGrayPixel(screenX, screenY, val);
       }
     }
   }
 
   free(outputRow);
-  free(rowBytes);
+}
+
+void GfxRenderer::drawPacked2BitRow(const int x, const int y, const uint8_t* packedRow, const int widthPixels) const {
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  if (y < clipTop || y >= clipBottom) {
+    return;
+  }
+  markDirty(x, y, widthPixels, 1);
+
+  for (int px = std::max(0, clipLeft - x); px < widthPixels; px++) {
+    const int screenX = x + px;
+    if (screenX >= clipRight) {
+      break;
+    }
+
+    const uint8_t val = packedRow[px / 4] >> (6 - ((px * 2) % 8)) & 0x3;
+
+    if (renderMode == BW && val < 3) {
+      drawPixel(screenX, y);
+    } else if (renderMode == GRAYSCALE_MSB && (val == 1 || val == 2)) {
+      drawPixel(screenX, y, false);
+    } else if (renderMode == GRAYSCALE_LSB && val == 1) {
+      drawPixel(screenX, y, false);
+    } else if (renderMode == GRAYSCALE_2BIT) {
+      setGrayPixel(screenX, y, val);
+    }
+  }
 }
 
 void GfxRenderer::drawBitmap1Bit(const Bitmap& bitmap, const int x, const int y, const int maxWidth,
                                  const int maxHeight) const {
+  markDirty(x, y, maxWidth > 0 ? maxWidth : bitmap.getWidth(), maxHeight > 0 ? maxHeight : bitmap.getHeight());
   float scale = 1.0f;
   bool isScaled = false;
   if (maxWidth > 0 && bitmap.getWidth() > maxWidth) {
@@ -277,40 +612,70 @@ void GfxRenderer::drawBitmap1Bit(const Bitmap& bitmap, const int x, const int y,
   // For 1-bit BMP, output is still 2-bit packed (for consistency with readNextRow)
   const int outputRowSize = (bitmap.getWidth() + 3) / 4;
   auto* outputRow = static_cast<uint8_t*>(malloc(outputRowSize));
-  auto* rowBytes = static_cast<uint8_t*>(malloc(bitmap.getRowBytes()));
 
-  if (!outputRow || !rowBytes) {
-    Serial.printf("[%lu] [GFX] !! Failed to allocate 1-bit BMP row buffers\n", millis());
-    free(outputRow);
-    free(rowBytes);
+  if (!outputRow) {
+    Serial.printf("[%lu] [GFX] !! Failed to allocate 1-bit BMP row buffer\n", millis());
     return;
   }
 
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  // First source column that can land inside the clip span, constant across rows
+  int bmpXStart = 0;
+  if (clipLeft > x) {
+    bmpXStart = isScaled ? static_cast<int>(std::ceil((clipLeft - x) / scale)) : clipLeft - x;
+  }
+
   for (int bmpY = 0; bmpY < bitmap.getHeight(); bmpY++) {
-    // Read rows sequentially using readNextRow
-    if (bitmap.readNextRow(outputRow, rowBytes) != BmpReaderError::Ok) {
+    // Rows land monotonically down the screen for top-down BMPs and up it for bottom-up ones;
+    // once past the clip edge in that direction no later row is visible, so stop reading.
+    // Rows that are merely not yet inside the clip still have to be read to keep the
+    // sequential row counter in sync.
+    const int bmpYOffset = bitmap.isTopDown() ? bmpY : bitmap.getHeight() - 1 - bmpY;
+    const int screenY = y + (isScaled ? static_cast<int>(std::floor(bmpYOffset * scale)) : bmpYOffset);
+    if (bitmap.isTopDown() ? screenY >= clipBottom : screenY < clipTop) {
+      break;
+    }
+
+    if (bitmap.readNextRow(outputRow) != BmpReaderError::Ok) {
       Serial.printf("[%lu] [GFX] Failed to read row %d from 1-bit bitmap\n", millis(), bmpY);
       free(outputRow);
-      free(rowBytes);
       return;
     }
 
-    // Calculate screen Y based on whether BMP is top-down or bottom-up
-    const int bmpYOffset = bitmap.isTopDown() ? bmpY : bitmap.getHeight() - 1 - bmpY;
-    int screenY = y + (isScaled ? static_cast<int>(std::floor(bmpYOffset * scale)) : bmpYOffset);
-    if (screenY >= getScreenHeight()) {
-      continue;  // Continue reading to keep row counter in sync
+    if (screenY < clipTop || screenY >= clipBottom) {
+      continue;
     }
-    if (screenY < 0) {
+
+    // Row-granular fast path: in Portrait a logical row is a single panel bit column, so the
+    // mask and byte column stay constant across the whole row
+    uint8_t* frameBuffer = display.getFrameBuffer();
+    if (orientation == Portrait && frameBuffer) {
+      const uint8_t mask = 0x80 >> (screenY & 7);
+      const int colByte = screenY >> 3;
+      for (int bmpX = bmpXStart; bmpX < bitmap.getWidth(); bmpX++) {
+        const int screenX = x + (isScaled ? static_cast<int>(std::floor(bmpX * scale)) : bmpX);
+        if (screenX >= clipRight) {
+          break;
+        }
+        if (screenX < clipLeft) {
+          continue;
+        }
+
+        const uint8_t val = outputRow[bmpX / 4] >> (6 - ((bmpX * 2) % 8)) & 0x3;
+        if (val < 3) {
+          frameBuffer[(HalDisplay::DISPLAY_HEIGHT - 1 - screenX) * HalDisplay::DISPLAY_WIDTH_BYTES + colByte] &= ~mask;
+        }
+      }
       continue;
     }
 
-    for (int bmpX = 0; bmpX < bitmap.getWidth(); bmpX++) {
+    for (int bmpX = bmpXStart; bmpX < bitmap.getWidth(); bmpX++) {
       int screenX = x + (isScaled ? static_cast<int>(std::floor(bmpX * scale)) : bmpX);
-      if (screenX >= getScreenWidth()) {
+      if (screenX >= clipRight) {
         break;
       }
-      if (screenX < 0) {
+      if (screenX < clipLeft) {
         continue;
       }
 
@@ -327,59 +692,108 @@ void GfxRenderer::drawBitmap1Bit(const Bitmap& bitmap, const int x, const int y,
   }
 
   free(outputRow);
-  free(rowBytes);
 }
 
 void GfxRenderer::fillPolygon(const int* xPoints, const int* yPoints, int numPoints, bool state) const {
   if (numPoints < 3) return;
 
-  // Find bounding box
-  int minY = yPoints[0], maxY = yPoints[0];
-  for (int i = 1; i < numPoints; i++) {
-    if (yPoints[i] < minY) minY = yPoints[i];
-    if (yPoints[i] > maxY) maxY = yPoints[i];
+  // Classic edge-table scanline fill: non-horizontal edges sorted by top Y, X intercepts
+  // stepped incrementally in 16.16 fixed point, and each span emitted through fillRect so it
+  // hits the masked byte-run kernel instead of per-pixel rotation arithmetic
+  struct Edge {
+    int yTop;
+    int yBottom;     // exclusive; half-open spans keep the node count even at vertices
+    int32_t x;       // 16.16 intercept at the current scanline
+    int32_t xStep;   // 16.16 per scanline
+  };
+  auto* edges = static_cast<Edge*>(malloc(numPoints * sizeof(Edge)));
+  // Active-edge indices and the per-line node buffer share one allocation
+  auto* scratch = static_cast<int*>(malloc(2 * numPoints * sizeof(int)));
+  if (!edges || !scratch) {
+    Serial.printf("[%lu] [GFX] !! Failed to allocate polygon edge buffers\n", millis());
+    free(edges);
+    free(scratch);
+    return;
+  }
+  int* active = scratch;
+  int* nodeX = scratch + numPoints;
+
+  int numEdges = 0;
+  int minY = getScreenHeight(), maxY = -1;
+  int j = numPoints - 1;
+  for (int i = 0; i < numPoints; i++) {
+    int x0 = xPoints[j], y0 = yPoints[j];
+    int x1 = xPoints[i], y1 = yPoints[i];
+    j = i;
+    if (y0 == y1) continue;  // horizontal edges contribute no crossings
+    if (y0 > y1) {
+      int t = x0;
+      x0 = x1;
+      x1 = t;
+      t = y0;
+      y0 = y1;
+      y1 = t;
+    }
+    Edge& e = edges[numEdges++];
+    e.yTop = y0;
+    e.yBottom = y1;
+    e.x = x0 * 65536;
+    e.xStep = (x1 - x0) * 65536 / (y1 - y0);
+    if (y0 < minY) minY = y0;
+    if (y1 - 1 > maxY) maxY = y1 - 1;
+  }
+
+  // Sort edges by top Y (simple insertion sort, numEdges is small)
+  for (int i = 1; i < numEdges; i++) {
+    const Edge e = edges[i];
+    int k = i - 1;
+    while (k >= 0 && edges[k].yTop > e.yTop) {
+      edges[k + 1] = edges[k];
+      k--;
+    }
+    edges[k + 1] = e;
   }
 
   // Clip to screen
   if (minY < 0) minY = 0;
   if (maxY >= getScreenHeight()) maxY = getScreenHeight() - 1;
 
-  // Allocate node buffer for scanline algorithm
-  auto* nodeX = static_cast<int*>(malloc(numPoints * sizeof(int)));
-  if (!nodeX) {
-    Serial.printf("[%lu] [GFX] !! Failed to allocate polygon node buffer\n", millis());
-    return;
-  }
-
-  // Scanline fill algorithm
+  int nextEdge = 0;
+  int activeCount = 0;
   for (int scanY = minY; scanY <= maxY; scanY++) {
-    int nodes = 0;
-
-    // Find all intersection points with edges
-    int j = numPoints - 1;
-    for (int i = 0; i < numPoints; i++) {
-      if ((yPoints[i] < scanY && yPoints[j] >= scanY) || (yPoints[j] < scanY && yPoints[i] >= scanY)) {
-        // Calculate X intersection using fixed-point to avoid float
-        int dy = yPoints[j] - yPoints[i];
-        if (dy != 0) {
-          nodeX[nodes++] = xPoints[i] + (scanY - yPoints[i]) * (xPoints[j] - xPoints[i]) / dy;
-        }
+    // Retire edges that ended, then admit edges starting on (or clipped above) this line
+    int kept = 0;
+    for (int a = 0; a < activeCount; a++) {
+      if (edges[active[a]].yBottom > scanY) active[kept++] = active[a];
+    }
+    activeCount = kept;
+    while (nextEdge < numEdges && edges[nextEdge].yTop <= scanY) {
+      if (edges[nextEdge].yBottom > scanY) {
+        // Catch the intercept up when the top of the edge was clipped off-screen
+        edges[nextEdge].x += (scanY - edges[nextEdge].yTop) * edges[nextEdge].xStep;
+        active[activeCount++] = nextEdge;
       }
-      j = i;
+      nextEdge++;
     }
 
-    // Sort nodes by X (simple bubble sort, numPoints is small)
+    int nodes = 0;
+    for (int a = 0; a < activeCount; a++) {
+      nodeX[nodes++] = static_cast<int>(edges[active[a]].x >> 16);
+      edges[active[a]].x += edges[active[a]].xStep;
+    }
+
+    // Sort nodes by X (simple bubble sort, nodes is small)
     for (int i = 0; i < nodes - 1; i++) {
       for (int k = i + 1; k < nodes; k++) {
         if (nodeX[i] > nodeX[k]) {
-          int temp = nodeX[i];
+          const int temp = nodeX[i];
           nodeX[i] = nodeX[k];
           nodeX[k] = temp;
         }
       }
     }
 
-    // Fill between pairs of nodes
+    // Fill between pairs of nodes through the span-fill fast path
     for (int i = 0; i < nodes - 1; i += 2) {
       int startX = nodeX[i];
       int endX = nodeX[i + 1];
@@ -387,18 +801,27 @@ void GfxRenderer::fillPolygon(const int* xPoints, const int* yPoints, int numPoi
       // Clip to screen
       if (startX < 0) startX = 0;
       if (endX >= getScreenWidth()) endX = getScreenWidth() - 1;
+      if (startX > endX) continue;
 
-      // Draw horizontal line
-      for (int x = startX; x <= endX; x++) {
-        drawPixel(x, scanY, state);
-      }
+      fillRect(startX, scanY, endX - startX + 1, 1, state);
     }
   }
 
-  free(nodeX);
+  free(edges);
+  free(scratch);
 }
 
-void GfxRenderer::clearScreen(const uint8_t color) const { display.clearScreen(color); }
+void GfxRenderer::clearScreen(const uint8_t color) const {
+  markAllDirty();
+  uint8_t* buffer = display.getFrameBuffer();
+  if (!buffer) {
+    display.clearScreen(color);
+    return;
+  }
+  // memset compiles to word stores; this frames every screen transition, so it stays off the
+  // SDK's byte-at-a-time clear
+  memset(buffer, color, HalDisplay::BUFFER_SIZE);
+}
 
 void GfxRenderer::invertScreen() const {
   uint8_t* buffer = display.getFrameBuffer();
@@ -406,22 +829,151 @@ void GfxRenderer::invertScreen() const {
     Serial.printf("[%lu] [GFX] !! No framebuffer in invertScreen\n", millis());
     return;
   }
-  for (int i = 0; i < HalDisplay::BUFFER_SIZE; i++) {
-    buffer[i] = ~buffer[i];
+  markAllDirty();
+  // The framebuffer is heap-allocated (word-aligned) and its size divides by four, so the
+  // whole buffer inverts in 32-bit strides
+  static_assert(HalDisplay::BUFFER_SIZE % sizeof(uint32_t) == 0, "framebuffer size must be word-divisible");
+  auto* words = reinterpret_cast<uint32_t*>(buffer);
+  for (size_t i = 0; i < HalDisplay::BUFFER_SIZE / sizeof(uint32_t); i++) {
+    words[i] = ~words[i];
   }
 }
 
-void GfxRenderer::displayBuffer(const HalDisplay::RefreshMode refreshMode) const { display.displayBuffer(refreshMode); }
+void GfxRenderer::displayBuffer(const HalDisplay::RefreshMode refreshMode) const {
+  if (skipUnchangedFlush(refreshMode)) {
+    return;
+  }
+  updateFrameShadow();
+  display.displayBuffer(refreshMode);
+  clearDirty();
+}
+
+void GfxRenderer::displayBufferAsync(const HalDisplay::RefreshMode refreshMode) const {
+  if (skipUnchangedFlush(refreshMode)) {
+    return;
+  }
+  // Snapshot before the flush task starts; the framebuffer is quiescent until the flush ends
+  updateFrameShadow();
+  display.displayBufferAsync(refreshMode);
+  clearDirty();
+}
+
+void GfxRenderer::displayDirty(const HalDisplay::RefreshMode preferredMode) const {
+  if (!hasDirtyRegion()) {
+    return;
+  }
+  displayBuffer(planRefreshMode(preferredMode));
+}
+
+HalDisplay::RefreshMode GfxRenderer::planRefreshMode(const HalDisplay::RefreshMode preferredMode) const {
+  if (!hasDirtyRegion()) {
+    return preferredMode;
+  }
+  // The panel has no windowed update path, so the cheapest lever is the waveform: small regions
+  // (a status bar strip, a progress bar tick) get the fast LUT, larger ones keep the caller's
+  // choice so the periodic deghosting refreshes still happen.
+  // With a frame shadow the changed byte count is exact; the dirty box is only a fallback,
+  // since the clear-and-redraw paths mark the whole screen even for a near-identical frame.
+  if (frameShadowEnabled && frameShadowValid) {
+    const size_t changedBytes = frameShadowDiffBytes();
+    if (changedBytes * DIRTY_FAST_REFRESH_FRACTION <= HalDisplay::BUFFER_SIZE) {
+      return HalDisplay::FAST_REFRESH;
+    }
+    return preferredMode;
+  }
+  const int dirtyArea = (dirtyMaxX - dirtyMinX + 1) * (dirtyMaxY - dirtyMinY + 1);
+  const int screenArea = getScreenWidth() * getScreenHeight();
+  if (dirtyArea * DIRTY_FAST_REFRESH_FRACTION <= screenArea) {
+    return HalDisplay::FAST_REFRESH;
+  }
+  return preferredMode;
+}
+
+void GfxRenderer::waitForDisplayFlush() const { display.waitForFlush(); }
+
+namespace {
+// Number of leading glyphs a truncated string always keeps before the ellipsis
+constexpr size_t TRUNCATE_MIN_GLYPHS = 3;
+
+// Largest glyph count whose prefix plus the ellipsis fits in maxWidth
+size_t truncateCut(const EpdShapedRun& run, const EpdShapedRun& ellipsis, const int maxWidth) {
+  size_t cut = run.glyphs.size();
+  while (cut > TRUNCATE_MIN_GLYPHS) {
+    const int prefixAdvance = cut == run.glyphs.size() ? run.advance : run.glyphs[cut].x;
+    if (prefixAdvance + ellipsis.width <= maxWidth) {
+      break;
+    }
+    cut--;
+  }
+  return cut;
+}
+}  // namespace
 
 std::string GfxRenderer::truncatedText(const int fontId, const char* text, const int maxWidth,
                                        const EpdFontFamily::Style style) const {
-  std::string item = text;
-  int itemWidth = getTextWidth(fontId, item.c_str(), style);
-  while (itemWidth > maxWidth && item.length() > 8) {
-    item.replace(item.length() - 5, 5, "...");
-    itemWidth = getTextWidth(fontId, item.c_str(), style);
+  const EpdFontFamily* fontPtr = findFont(fontId);
+  if (fontPtr == nullptr) {
+    return text;
   }
-  return item;
+
+  // Shape once instead of re-measuring the string on every trimming step
+  const EpdFontFamily& font = *fontPtr;
+  const EpdShapedRun run = font.shape(text, style);
+  if (run.width <= maxWidth) {
+    return text;
+  }
+
+  const EpdShapedRun ellipsis = font.shape("...", style);
+  const size_t cut = truncateCut(run, ellipsis, maxWidth);
+  if (cut >= run.glyphs.size()) {
+    return text;
+  }
+  return std::string(text, run.glyphs[cut].byteOffset) + "...";
+}
+
+EpdShapedRun GfxRenderer::shapeText(const int fontId, const char* text, const EpdFontFamily::Style style) const {
+  const EpdFontFamily* font = findFont(fontId);
+  if (font == nullptr) {
+    return {};
+  }
+  return font->shape(text, style);
+}
+
+EpdShapedRun GfxRenderer::shapeTruncatedText(const int fontId, const char* text, const int maxWidth,
+                                             const EpdFontFamily::Style style) const {
+  const EpdFontFamily* fontPtr = findFont(fontId);
+  if (fontPtr == nullptr) {
+    return {};
+  }
+
+  const EpdFontFamily& font = *fontPtr;
+  EpdShapedRun run = font.shape(text, style);
+  if (run.width <= maxWidth) {
+    return run;
+  }
+
+  const EpdShapedRun ellipsis = font.shape("...", style);
+  const size_t cut = truncateCut(run, ellipsis, maxWidth);
+  if (cut >= run.glyphs.size()) {
+    return run;
+  }
+
+  const uint32_t cutByteOffset = run.glyphs[cut].byteOffset;
+  run.glyphs.resize(cut);
+  run.advance = run.glyphs.empty() ? 0 : run.glyphs.back().x + run.glyphs.back().glyph->advanceX;
+  for (const auto& shaped : ellipsis.glyphs) {
+    run.glyphs.push_back({shaped.cp, shaped.glyph, cutByteOffset, run.advance + shaped.x});
+  }
+  run.advance += ellipsis.advance;
+
+  // Recompute the bounds width over the final glyph list
+  int minX = 0, maxX = 0;
+  for (const auto& shaped : run.glyphs) {
+    minX = std::min(minX, shaped.x + shaped.glyph->left);
+    maxX = std::max(maxX, shaped.x + shaped.glyph->left + shaped.glyph->width);
+  }
+  run.width = maxX - minX;
+  return run;
 }
 
 // Note: Internal driver treats screen in command orientation; this library exposes a logical orientation
@@ -454,30 +1006,73 @@ int GfxRenderer::getScreenHeight() const {
 }
 
 int GfxRenderer::getSpaceWidth(const int fontId) const {
-  if (fontMap.count(fontId) == 0) {
-    Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  const EpdFontFamily* font = findFont(fontId);
+  if (font == nullptr) {
     return 0;
   }
 
-  return fontMap.at(fontId).getGlyph(' ', EpdFontFamily::REGULAR)->advanceX;
+  return font->getGlyph(' ', EpdFontFamily::REGULAR)->advanceX;
 }
 
 int GfxRenderer::getFontAscenderSize(const int fontId) const {
-  if (fontMap.count(fontId) == 0) {
-    Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  const EpdFontFamily* font = findFont(fontId);
+  if (font == nullptr) {
     return 0;
   }
 
-  return fontMap.at(fontId).getData(EpdFontFamily::REGULAR)->ascender;
+  return font->getData(EpdFontFamily::REGULAR)->ascender;
 }
 
 int GfxRenderer::getLineHeight(const int fontId) const {
-  if (fontMap.count(fontId) == 0) {
-    Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  const EpdFontFamily* font = findFont(fontId);
+  if (font == nullptr) {
     return 0;
   }
 
-  return fontMap.at(fontId).getData(EpdFontFamily::REGULAR)->advanceY;
+  return font->getData(EpdFontFamily::REGULAR)->advanceY;
+}
+
+size_t GfxRenderer::stampSize(const int w, const int h) {
+  // Worst-case byte-aligned span of h pixels, including alignment slack at both ends
+  return static_cast<size_t>(w) * ((h + 15) / 8);
+}
+
+bool GfxRenderer::captureStamp(const int x, const int y, const int w, const int h, uint8_t* out) const {
+  if (orientation != Portrait || renderMode != BW) {
+    return false;
+  }
+  if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > getScreenWidth() || y + h > getScreenHeight()) {
+    return false;
+  }
+  // Portrait maps screen (x, y) to buffer (y, DISPLAY_HEIGHT-1-x): the y span becomes a
+  // horizontal byte run in the buffer and each screen column is one buffer row
+  const int colByteStart = y / 8;
+  const int spanBytes = (y + h + 7) / 8 - colByteStart;
+  const uint8_t* frameBuffer = getFrameBuffer();
+  for (int i = 0; i < w; i++) {
+    const int bufY = HalDisplay::DISPLAY_HEIGHT - 1 - (x + i);
+    memcpy(out + i * spanBytes, frameBuffer + bufY * HalDisplay::DISPLAY_WIDTH_BYTES + colByteStart, spanBytes);
+  }
+  return true;
+}
+
+bool GfxRenderer::pasteStamp(const int x, const int y, const int w, const int h, const uint8_t* in) const {
+  if (orientation != Portrait || renderMode != BW) {
+    return false;
+  }
+  if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > getScreenWidth() || y + h > getScreenHeight()) {
+    return false;
+  }
+  const int colByteStart = y / 8;
+  const int spanBytes = (y + h + 7) / 8 - colByteStart;
+  uint8_t* frameBuffer = getFrameBuffer();
+  for (int i = 0; i < w; i++) {
+    const int bufY = HalDisplay::DISPLAY_HEIGHT - 1 - (x + i);
+    memcpy(frameBuffer + bufY * HalDisplay::DISPLAY_WIDTH_BYTES + colByteStart, in + i * spanBytes, spanBytes);
+  }
+  // Whole bytes were pasted, so mark the byte-widened span dirty
+  markDirty(x, colByteStart * 8, w, spanBytes * 8);
+  return true;
 }
 
 void GfxRenderer::drawButtonHints(const int fontId, const char* btn1, const char* btn2, const char* btn3,
@@ -493,6 +1088,25 @@ void GfxRenderer::drawButtonHints(const int fontId, const char* btn1, const char
   constexpr int buttonPositions[] = {25, 130, 245, 350};
   const char* labels[] = {btn1, btn2, btn3, btn4};
 
+  // The whole hint row is a fixed-position stamp keyed by the labels; repeat renders with the
+  // same labels paste the cached pixels instead of re-measuring and re-drawing
+  constexpr int stampX = buttonPositions[0];
+  constexpr int stampW = buttonPositions[3] + buttonWidth - buttonPositions[0];
+  const int stampY = pageHeight - buttonY;
+
+  std::string key = std::to_string(fontId);
+  for (const char* label : labels) {
+    key += '\x1f';
+    if (label != nullptr) {
+      key += label;
+    }
+  }
+
+  if (key == hintStampKey && !hintStamp.empty() && pasteStamp(stampX, stampY, stampW, buttonHeight, hintStamp.data())) {
+    setOrientation(orig_orientation);
+    return;
+  }
+
   for (int i = 0; i < 4; i++) {
     // Only draw if the label is non-empty
     if (labels[i] != nullptr && labels[i][0] != '\0') {
@@ -505,6 +1119,14 @@ void GfxRenderer::drawButtonHints(const int fontId, const char* btn1, const char
     }
   }
 
+  hintStamp.resize(stampSize(stampW, buttonHeight));
+  if (captureStamp(stampX, stampY, stampW, buttonHeight, hintStamp.data())) {
+    hintStampKey = std::move(key);
+  } else {
+    hintStamp.clear();
+    hintStampKey.clear();
+  }
+
   setOrientation(orig_orientation);
 }
 
@@ -560,11 +1182,11 @@ void GfxRenderer::drawSideButtonHints(const int fontId, const char* topBtn, cons
 }
 
 int GfxRenderer::getTextHeight(const int fontId) const {
-  if (fontMap.count(fontId) == 0) {
-    Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  const EpdFontFamily* font = findFont(fontId);
+  if (font == nullptr) {
     return 0;
   }
-  return fontMap.at(fontId).getData(EpdFontFamily::REGULAR)->ascender;
+  return font->getData(EpdFontFamily::REGULAR)->ascender;
 }
 
 void GfxRenderer::drawTextRotated90CW(const int fontId, const int x, const int y, const char* text, const bool black,
@@ -574,11 +1196,11 @@ void GfxRenderer::drawTextRotated90CW(const int fontId, const int x, const int y
     return;
   }
 
-  if (fontMap.count(fontId) == 0) {
-    Serial.printf("[%lu] [GFX] Font %d not found\n", millis(), fontId);
+  const EpdFontFamily* fontPtr = findFont(fontId);
+  if (fontPtr == nullptr) {
     return;
   }
-  const auto font = fontMap.at(fontId);
+  const EpdFontFamily& font = *fontPtr;
 
   // No printable characters
   if (!font.hasPrintableChars(text, style)) {
@@ -591,14 +1213,13 @@ void GfxRenderer::drawTextRotated90CW(const int fontId, const int x, const int y
 
   int yPos = y;  // Current Y position (decreases as we draw characters)
 
-  uint32_t cp;
-  while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&text)))) {
+  utf8ForEachCodepoint(text, [&](const uint32_t cp, uint32_t) {
     const EpdGlyph* glyph = font.getGlyph(cp, style);
     if (!glyph) {
       glyph = font.getGlyph(REPLACEMENT_GLYPH, style);
     }
     if (!glyph) {
-      continue;
+      return;
     }
 
     const int is2Bit = font.getData(style)->is2Bit;
@@ -608,7 +1229,9 @@ void GfxRenderer::drawTextRotated90CW(const int fontId, const int x, const int y
     const int left = glyph->left;
     const int top = glyph->top;
 
-    const uint8_t* bitmap = &font.getData(style)->bitmap[offset];
+    // Side hints always use built-in fonts; skip SD-backed fonts with no in-RAM bitmap
+    const uint8_t* bitmap =
+        font.getData(style)->bitmap != nullptr ? &font.getData(style)->bitmap[offset] : nullptr;
 
     if (bitmap != nullptr) {
       for (int glyphY = 0; glyphY < height; glyphY++) {
@@ -632,6 +1255,8 @@ void GfxRenderer::drawTextRotated90CW(const int fontId, const int x, const int y
               drawPixel(screenX, screenY, false);
             } else if (renderMode == GRAYSCALE_LSB && bmpVal == 1) {
               drawPixel(screenX, screenY, false);
+            } else if (renderMode == GRAYSCALE_2BIT) {
+              setGrayPixel(screenX, screenY, bmpVal);
             }
           } else {
             const uint8_t byte = bitmap[pixelPosition / 8];
@@ -647,7 +1272,7 @@ void GfxRenderer::drawTextRotated90CW(const int fontId, const int x, const int y
 
     // Move to next character position (going up, so decrease Y)
     yPos -= glyph->advanceX;
-  }
+  });
 }
 
 uint8_t* GfxRenderer::getFrameBuffer() const { return display.getFrameBuffer(); }
@@ -663,6 +1288,59 @@ void GfxRenderer::copyGrayscaleMsbBuffers() const { display.copyGrayscaleMsbBuff
 
 void GfxRenderer::displayGrayBuffer() const { display.displayGrayBuffer(); }
 
+bool GfxRenderer::beginGrayscalePass() {
+  if (!grayLsbPlane) {
+    grayLsbPlane = static_cast<uint8_t*>(malloc(HalDisplay::BUFFER_SIZE));
+    HEAP_MON.recordAlloc("gfx-gray-plane", HalDisplay::BUFFER_SIZE, grayLsbPlane != nullptr);
+    if (!grayLsbPlane) {
+      Serial.printf("[%lu] [GFX] Gray plane allocation failed, falling back to two-pass grayscale\n", millis());
+      return false;
+    }
+  }
+  memset(grayLsbPlane, 0x00, HalDisplay::BUFFER_SIZE);
+  clearScreen(0x00);
+  renderMode = GRAYSCALE_2BIT;
+  return true;
+}
+
+void GfxRenderer::flushGrayscalePass() {
+  if (renderMode != GRAYSCALE_2BIT || !grayLsbPlane) {
+    return;
+  }
+  display.copyGrayscaleLsbBuffers(grayLsbPlane);
+  display.copyGrayscaleMsbBuffers(display.getFrameBuffer());
+  display.displayGrayBuffer();
+  free(grayLsbPlane);
+  grayLsbPlane = nullptr;
+  renderMode = BW;
+}
+
+// One 2-bit pixel into both planes (framebuffer = MSB, side plane = LSB) for GRAYSCALE_2BIT. A
+// set bit means "apply the gray effect": the MSB plane marks both grays, the LSB dark gray only.
+void GfxRenderer::setGrayPixel(const int x, const int y, const uint8_t val) const {
+  if (val != 1 && val != 2) {
+    return;
+  }
+  uint8_t* frameBuffer = display.getFrameBuffer();
+  if (!frameBuffer || !grayLsbPlane) {
+    return;
+  }
+
+  int rotatedX = 0;
+  int rotatedY = 0;
+  rotateCoordinates(x, y, &rotatedX, &rotatedY);
+  if (rotatedX < 0 || rotatedX >= HalDisplay::DISPLAY_WIDTH || rotatedY < 0 || rotatedY >= HalDisplay::DISPLAY_HEIGHT) {
+    return;
+  }
+
+  const uint16_t byteIndex = rotatedY * HalDisplay::DISPLAY_WIDTH_BYTES + (rotatedX / 8);
+  const uint8_t mask = 1 << (7 - (rotatedX % 8));
+  frameBuffer[byteIndex] |= mask;
+  if (val == 1) {
+    grayLsbPlane[byteIndex] |= mask;
+  }
+}
+
 void GfxRenderer::freeBwBufferChunks() {
   for (auto& bwBufferChunk : bwBufferChunks) {
     if (bwBufferChunk) {
@@ -672,6 +1350,118 @@ void GfxRenderer::freeBwBufferChunks() {
   }
 }
 
+void GfxRenderer::setFrameShadowEnabled(const bool enabled) {
+  if (!enabled) {
+    freeFrameShadowChunks();
+    frameShadowEnabled = false;
+    return;
+  }
+  if (frameShadowEnabled) {
+    return;
+  }
+
+  for (size_t i = 0; i < BW_BUFFER_NUM_CHUNKS; i++) {
+    frameShadowChunks[i] = static_cast<uint8_t*>(malloc(BW_BUFFER_CHUNK_SIZE));
+    HEAP_MON.recordAlloc("gfx-shadow-chunk", BW_BUFFER_CHUNK_SIZE, frameShadowChunks[i] != nullptr);
+    if (!frameShadowChunks[i]) {
+      // Not fatal: flushes just fall back to the dirty-box planner
+      Serial.printf("[%lu] [GFX] Failed to allocate frame shadow chunk %zu, shadow disabled\n", millis(), i);
+      freeFrameShadowChunks();
+      return;
+    }
+  }
+  frameShadowEnabled = true;
+  frameShadowValid = false;
+}
+
+void GfxRenderer::freeFrameShadowChunks() {
+  for (auto& chunk : frameShadowChunks) {
+    if (chunk) {
+      free(chunk);
+      chunk = nullptr;
+    }
+  }
+  frameShadowValid = false;
+}
+
+void GfxRenderer::updateFrameShadow() const {
+  if (!frameShadowEnabled) {
+    return;
+  }
+  const uint8_t* frameBuffer = display.getFrameBuffer();
+  if (!frameBuffer) {
+    return;
+  }
+  for (size_t i = 0; i < BW_BUFFER_NUM_CHUNKS; i++) {
+    memcpy(frameShadowChunks[i], frameBuffer + i * BW_BUFFER_CHUNK_SIZE, BW_BUFFER_CHUNK_SIZE);
+  }
+  frameShadowValid = true;
+}
+
+bool GfxRenderer::frameShadowUnchanged() const {
+  const uint8_t* frameBuffer = display.getFrameBuffer();
+  if (!frameBuffer) {
+    return false;
+  }
+  for (size_t i = 0; i < BW_BUFFER_NUM_CHUNKS; i++) {
+    if (memcmp(frameShadowChunks[i], frameBuffer + i * BW_BUFFER_CHUNK_SIZE, BW_BUFFER_CHUNK_SIZE) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t GfxRenderer::frameShadowDiffBytes() const {
+  const uint8_t* frameBuffer = display.getFrameBuffer();
+  if (!frameBuffer) {
+    return HalDisplay::BUFFER_SIZE;
+  }
+  size_t changed = 0;
+  // Compare in 32-bit words (both sides are heap chunks and the chunk size divides by four);
+  // only words that differ drop to the byte comparison, so the mostly-identical case - the one
+  // the planner actually runs on - scans at a quarter of the loads
+  static_assert(BW_BUFFER_CHUNK_SIZE % sizeof(uint32_t) == 0, "chunk size must be word-divisible");
+  for (size_t i = 0; i < BW_BUFFER_NUM_CHUNKS; i++) {
+    const auto* shadowWords = reinterpret_cast<const uint32_t*>(frameShadowChunks[i]);
+    const auto* currentWords = reinterpret_cast<const uint32_t*>(frameBuffer + i * BW_BUFFER_CHUNK_SIZE);
+    for (size_t w = 0; w < BW_BUFFER_CHUNK_SIZE / sizeof(uint32_t); w++) {
+      if (shadowWords[w] == currentWords[w]) {
+        continue;
+      }
+      const auto* shadowBytes = reinterpret_cast<const uint8_t*>(&shadowWords[w]);
+      const auto* currentBytes = reinterpret_cast<const uint8_t*>(&currentWords[w]);
+      for (size_t b = 0; b < sizeof(uint32_t); b++) {
+        if (shadowBytes[b] != currentBytes[b]) {
+          changed++;
+        }
+      }
+    }
+  }
+  return changed;
+}
+
+size_t GfxRenderer::pendingFlushDiffBytes() const {
+  if (!frameShadowEnabled || !frameShadowValid) {
+    return HalDisplay::BUFFER_SIZE;
+  }
+  return frameShadowDiffBytes();
+}
+
+bool GfxRenderer::skipUnchangedFlush(const HalDisplay::RefreshMode refreshMode) const {
+  // Only fast/turbo flushes may be elided; explicit HALF/FULL requests are deghosting passes
+  // that must reach the glass even when the content is identical
+  if ((refreshMode != HalDisplay::FAST_REFRESH && refreshMode != HalDisplay::TURBO_REFRESH) || !frameShadowEnabled ||
+      !frameShadowValid) {
+    return false;
+  }
+  if (!frameShadowUnchanged()) {
+    return false;
+  }
+  Serial.printf("[%lu] [GFX] Frame unchanged since last push, skipping refresh\n", millis());
+  clearDirty();
+  return true;
+}
+
 /**
  * This should be called before grayscale buffers are populated.
  * A `restoreBwBuffer` call should always follow the grayscale render if this method was called.
@@ -697,6 +1487,7 @@ bool GfxRenderer::storeBwBuffer() {
 
     const size_t offset = i * BW_BUFFER_CHUNK_SIZE;
     bwBufferChunks[i] = static_cast<uint8_t*>(malloc(BW_BUFFER_CHUNK_SIZE));
+    HEAP_MON.recordAlloc("gfx-bw-chunk", BW_BUFFER_CHUNK_SIZE, bwBufferChunks[i] != nullptr);
 
     if (!bwBufferChunks[i]) {
       Serial.printf("[%lu] [GFX] !! Failed to allocate BW buffer chunk %zu (%zu bytes)\n", millis(), i,
@@ -772,9 +1563,11 @@ void GfxRenderer::cleanupGrayscaleWithFrameBuffer() const {
 
 void GfxRenderer::renderChar(const EpdFontFamily& fontFamily, const uint32_t cp, int* x, const int* y,
                              const bool pixelState, const EpdFontFamily::Style style) const {
-  const EpdGlyph* glyph = fontFamily.getGlyph(cp, style);
+  uint32_t renderCp = cp;
+  const EpdGlyph* glyph = fontFamily.getGlyph(renderCp, style);
   if (!glyph) {
-    glyph = fontFamily.getGlyph(REPLACEMENT_GLYPH, style);
+    renderCp = REPLACEMENT_GLYPH;
+    glyph = fontFamily.getGlyph(renderCp, style);
   }
 
   // no glyph?
@@ -783,19 +1576,68 @@ void GfxRenderer::renderChar(const EpdFontFamily& fontFamily, const uint32_t cp,
     return;
   }
 
-  const int is2Bit = fontFamily.getData(style)->is2Bit;
+  renderGlyph(fontFamily, renderCp, glyph, x, y, pixelState, style);
+}
+
+void GfxRenderer::renderGlyph(const EpdFontFamily& fontFamily, const uint32_t cp, const EpdGlyph* glyph, int* x,
+                              const int* y, const bool pixelState, const EpdFontFamily::Style style) const {
+  const uint32_t renderCp = cp;
+  const EpdFontData* fontData = fontFamily.getData(style);
+  const int is2Bit = fontData->is2Bit;
   const uint32_t offset = glyph->dataOffset;
   const uint8_t width = glyph->width;
   const uint8_t height = glyph->height;
   const int left = glyph->left;
 
-  const uint8_t* bitmap = nullptr;
-  bitmap = &fontFamily.getData(style)->bitmap[offset];
+  // Per-glyph rejection: a glyph whose bounding box misses the clip rect advances the cursor
+  // and nothing else - no cache expansion, no bit plucking. This is what keeps partially
+  // visible rows proportional to their visible glyphs.
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  const int glyphScreenLeft = *x + left;
+  const int glyphScreenTop = *y - glyph->top;
+  if (glyphScreenLeft >= clipRight || glyphScreenLeft + width <= clipLeft || glyphScreenTop >= clipBottom ||
+      glyphScreenTop + height <= clipTop) {
+    *x += glyph->advanceX;
+    return;
+  }
+
+  // Fast path: blit from the expanded (1 byte/pixel) glyph cache, no per-pixel bit plucking.
+  // Dispatch on orientation once per glyph; each kernel instantiation folds the rotation away.
+  if (const uint8_t* expanded = glyphCache.get(fontData, renderCp, glyph)) {
+    if (display.getFrameBuffer() != nullptr) {
+      switch (orientation) {
+        case Portrait:
+          renderGlyphBlit<Portrait>(fontData, glyph, expanded, *x, *y, pixelState);
+          break;
+        case LandscapeClockwise:
+          renderGlyphBlit<LandscapeClockwise>(fontData, glyph, expanded, *x, *y, pixelState);
+          break;
+        case PortraitInverted:
+          renderGlyphBlit<PortraitInverted>(fontData, glyph, expanded, *x, *y, pixelState);
+          break;
+        case LandscapeCounterClockwise:
+          renderGlyphBlit<LandscapeCounterClockwise>(fontData, glyph, expanded, *x, *y, pixelState);
+          break;
+      }
+    }
+    *x += glyph->advanceX;
+    return;
+  }
+
+  // SD-backed fonts have no in-RAM bitmap; they render only through the cache path above, so an
+  // uncacheable (oversized or read-failed) glyph just advances the cursor
+  const uint8_t* bitmap = fontData->bitmap != nullptr ? &fontData->bitmap[offset] : nullptr;
 
   if (bitmap != nullptr) {
-    for (int glyphY = 0; glyphY < height; glyphY++) {
+    // Clamp the glyph-space loops to the clipped span once instead of testing every pixel
+    const int glyphYStart = std::max(0, clipTop - glyphScreenTop);
+    const int glyphYEnd = std::min<int>(height, clipBottom - glyphScreenTop);
+    const int glyphXStart = std::max(0, clipLeft - glyphScreenLeft);
+    const int glyphXEnd = std::min<int>(width, clipRight - glyphScreenLeft);
+    for (int glyphY = glyphYStart; glyphY < glyphYEnd; glyphY++) {
       const int screenY = *y - glyph->top + glyphY;
-      for (int glyphX = 0; glyphX < width; glyphX++) {
+      for (int glyphX = glyphXStart; glyphX < glyphXEnd; glyphX++) {
         const int pixelPosition = glyphY * width + glyphX;
         const int screenX = *x + left + glyphX;
 
@@ -817,6 +1659,9 @@ void GfxRenderer::renderChar(const EpdFontFamily& fontFamily, const uint32_t cp,
           } else if (renderMode == GRAYSCALE_LSB && bmpVal == 1) {
             // Dark gray
             drawPixel(screenX, screenY, false);
+          } else if (renderMode == GRAYSCALE_2BIT) {
+            // One-pass mode: both planes at once
+            setGrayPixel(screenX, screenY, bmpVal);
           }
         } else {
           const uint8_t byte = bitmap[pixelPosition / 8];
@@ -833,6 +1678,86 @@ void GfxRenderer::renderChar(const EpdFontFamily& fontFamily, const uint32_t cp,
   *x += glyph->advanceX;
 }
 
+// Orientation-specialized blit for cache-expanded glyphs. The coordinate transform is a
+// compile-time constant, so the inner loop is straight-line address arithmetic; in the portrait
+// modes the rotated x depends only on the glyph row, so the compiler hoists the bit mask and
+// byte column out of the loop the way the old hand-written Portrait path did.
+template <GfxRenderer::Orientation O>
+void GfxRenderer::renderGlyphBlit(const EpdFontData* fontData, const EpdGlyph* glyph, const uint8_t* expanded,
+                                  const int x, const int y, const bool pixelState) const {
+  uint8_t* frameBuffer = display.getFrameBuffer();
+  const int is2Bit = fontData->is2Bit;
+  const uint8_t width = glyph->width;
+  const uint8_t height = glyph->height;
+  const int left = glyph->left;
+
+  // Loop bounds clamped to the clip rect (the screen rect when no clip is set) once per glyph,
+  // so the inner loop carries no per-pixel bounds checks
+  int clipLeft, clipTop, clipRight, clipBottom;
+  getClipBounds(&clipLeft, &clipTop, &clipRight, &clipBottom);
+  const int glyphYStart = std::max(0, clipTop - (y - glyph->top));
+  const int glyphYEnd = std::min<int>(height, clipBottom - (y - glyph->top));
+  const int glyphXStart = std::max(0, clipLeft - (x + left));
+  const int glyphXEnd = std::min<int>(width, clipRight - (x + left));
+
+  for (int glyphY = glyphYStart; glyphY < glyphYEnd; glyphY++) {
+    const int screenY = y - glyph->top + glyphY;
+    const uint8_t* row = expanded + glyphY * width;
+    for (int glyphX = glyphXStart; glyphX < glyphXEnd; glyphX++) {
+      const int screenX = x + left + glyphX;
+      const uint8_t bmpVal = row[glyphX];
+
+      bool draw = false;
+      bool value = pixelState;
+      bool markLsbPlane = false;
+      if (is2Bit) {
+        if (renderMode == BW && bmpVal < 3) {
+          draw = true;
+        } else if (renderMode == GRAYSCALE_MSB && (bmpVal == 1 || bmpVal == 2)) {
+          draw = true;
+          value = false;
+        } else if (renderMode == GRAYSCALE_LSB && bmpVal == 1) {
+          draw = true;
+          value = false;
+        } else if (renderMode == GRAYSCALE_2BIT && (bmpVal == 1 || bmpVal == 2)) {
+          // One-pass mode: the framebuffer write below is the MSB plane; dark gray is
+          // mirrored into the LSB plane at the same offset
+          draw = true;
+          value = false;
+          markLsbPlane = bmpVal == 1 && grayLsbPlane != nullptr;
+        }
+      } else if (bmpVal) {
+        draw = true;
+      }
+      if (!draw) {
+        continue;
+      }
+
+      int rotatedX, rotatedY;
+      rotateForOrientation<O>(screenX, screenY, &rotatedX, &rotatedY);
+      const size_t byteOffset = rotatedY * HalDisplay::DISPLAY_WIDTH_BYTES + (rotatedX >> 3);
+      const uint8_t mask = 0x80 >> (rotatedX & 7);
+      if (value) {
+        frameBuffer[byteOffset] &= ~mask;
+      } else {
+        frameBuffer[byteOffset] |= mask;
+        if (markLsbPlane) {
+          grayLsbPlane[byteOffset] |= mask;
+        }
+      }
+    }
+  }
+}
+
+template void GfxRenderer::renderGlyphBlit<GfxRenderer::Portrait>(const EpdFontData*, const EpdGlyph*, const uint8_t*,
+                                                                  int, int, bool) const;
+template void GfxRenderer::renderGlyphBlit<GfxRenderer::LandscapeClockwise>(const EpdFontData*, const EpdGlyph*,
+                                                                            const uint8_t*, int, int, bool) const;
+template void GfxRenderer::renderGlyphBlit<GfxRenderer::PortraitInverted>(const EpdFontData*, const EpdGlyph*,
+                                                                          const uint8_t*, int, int, bool) const;
+template void GfxRenderer::renderGlyphBlit<GfxRenderer::LandscapeCounterClockwise>(const EpdFontData*, const EpdGlyph*,
+                                                                                   const uint8_t*, int, int, bool) const;
+
 void GfxRenderer::getOrientedViewableTRBL(int* outTop, int* outRight, int* outBottom, int* outLeft) const {
   switch (orientation) {
     case Portrait:
@@ -3,13 +3,17 @@
 #include <EpdFontFamily.h>
 #include <HalDisplay.h>
 
-#include <map>
+#include <string>
+#include <vector>
 
 #include "Bitmap.h"
+#include "GlyphCache.h"
 
 class GfxRenderer {
  public:
-  enum RenderMode { BW, GRAYSCALE_LSB, GRAYSCALE_MSB };
+  // GRAYSCALE_2BIT is the one-pass mode set up by beginGrayscalePass(); the LSB/MSB modes remain
+  // as the fallback double pass when the side plane cannot be allocated
+  enum RenderMode { BW, GRAYSCALE_LSB, GRAYSCALE_MSB, GRAYSCALE_2BIT };
 
   // Logical screen orientation from the perspective of callers
   enum Orientation {
@@ -29,15 +33,76 @@ class GfxRenderer {
   RenderMode renderMode;
   Orientation orientation;
   uint8_t* bwBufferChunks[BW_BUFFER_NUM_CHUNKS] = {nullptr};
-  std::map<int, EpdFontFamily> fontMap;
+  // Previous-frame shadow for differential flushes: a copy of the framebuffer as of the last
+  // panel push, chunked like the BW store. Mutable because flushing is a const operation.
+  mutable uint8_t* frameShadowChunks[BW_BUFFER_NUM_CHUNKS] = {nullptr};
+  bool frameShadowEnabled = false;
+  mutable bool frameShadowValid = false;
+  void freeFrameShadowChunks();
+  void updateFrameShadow() const;
+  // True when the framebuffer is byte-identical to the last pushed frame (early-exit compare)
+  bool frameShadowUnchanged() const;
+  // Exact number of bytes that differ from the last pushed frame (full scan)
+  size_t frameShadowDiffBytes() const;
+  // Skips the panel push when the shadow proves nothing changed; returns true if skipped
+  bool skipUnchangedFlush(HalDisplay::RefreshMode refreshMode) const;
+  // Dirty bounding box (logical coordinates) accumulated since the last flush; feeds the refresh
+  // planner. Mutable because the drawing entry points are const.
+  mutable int dirtyMinX = 0, dirtyMinY = 0, dirtyMaxX = -1, dirtyMaxY = -1;
+  // Dirty regions at most this fraction of the screen qualify for a fast-LUT refresh in the planner
+  static constexpr int DIRTY_FAST_REFRESH_FRACTION = 8;
+  void markDirty(int x, int y, int width, int height) const;
+  void markAllDirty() const;
+  void clearDirty() const;
+  // Flat font registry: a dozen-odd families registered once at startup, looked up on every
+  // text call. Ids are FNV hashes (not dense), so lookup is a linear scan over the slots with
+  // a last-hit cache in front - the cache is the active reading font in practice, making the
+  // innermost render loops a compare and a load instead of a red-black tree walk.
+  struct FontSlot {
+    int id;
+    EpdFontFamily family;
+  };
+  std::vector<FontSlot> fonts;
+  mutable int lastFontIdx = -1;  // index of the last slot hit; reset when the registry grows
+  // Registered family for the id, or null (with a log) when the id is unknown
+  const EpdFontFamily* findFont(int fontId) const;
+  // Stamp cache for drawButtonHints, which redraws identical chrome on nearly every screen
+  std::string hintStampKey;
+  std::vector<uint8_t> hintStamp;
+  // Expanded-glyph cache for the text blit hot path (renderChar is const, the cache is warm state)
+  mutable GlyphCache glyphCache;
   void renderChar(const EpdFontFamily& fontFamily, uint32_t cp, int* x, const int* y, bool pixelState,
                   EpdFontFamily::Style style) const;
+  void renderGlyph(const EpdFontFamily& fontFamily, uint32_t cp, const EpdGlyph* glyph, int* x, const int* y,
+                   bool pixelState, EpdFontFamily::Style style) const;
+  // Side plane for the one-pass grayscale mode: the framebuffer doubles as the MSB plane and
+  // dark-gray pixels are mirrored in here (contiguous because HalDisplay takes the plane whole)
+  uint8_t* grayLsbPlane = nullptr;
+  void setGrayPixel(int x, int y, uint8_t val) const;
   void freeBwBufferChunks();
   void rotateCoordinates(int x, int y, int* rotatedX, int* rotatedY) const;
+  // Orientation-specialized raster kernels: templated on the logical orientation so the per-pixel
+  // coordinate transform resolves at compile time to straight-line address arithmetic instead of
+  // a switch per pixel. Defined in GfxRenderer.cpp and explicitly instantiated for all four
+  // orientations; the public entry points dispatch once per draw call.
+  template <Orientation O>
+  bool fillRectSpans(int x, int y, int width, int height, bool state) const;
+  template <Orientation O>
+  void renderGlyphBlit(const EpdFontData* fontData, const EpdGlyph* glyph, const uint8_t* expanded, int x, int y,
+                       bool pixelState) const;
+  // Active clip rectangle in logical coordinates; empty width/height means no clip (full screen)
+  int clipX = 0, clipY = 0, clipWidth = 0, clipHeight = 0;
+  bool clipEnabled = false;
+  // Clip intersected with the screen as half-open bounds; the screen rect when no clip is set
+  void getClipBounds(int* left, int* top, int* right, int* bottom) const;
 
  public:
   explicit GfxRenderer(HalDisplay& halDisplay) : display(halDisplay), renderMode(BW), orientation(Portrait) {}
-  ~GfxRenderer() { freeBwBufferChunks(); }
+  ~GfxRenderer() {
+    freeBwBufferChunks();
+    freeFrameShadowChunks();
+    free(grayLsbPlane);
+  }
 
   static constexpr int VIEWABLE_MARGIN_TOP = 9;
   static constexpr int VIEWABLE_MARGIN_RIGHT = 3;
@@ -47,6 +112,10 @@ class GfxRenderer {
   // Setup
   void insertFont(int fontId, EpdFontFamily font);
 
+  // Drop the expanded-glyph cache (memory-pressure shedding); it refills on subsequent draws.
+  // Callers must hold whatever mutex guards their rendering, like any other draw entry point.
+  void clearGlyphCache() const { glyphCache.clear(); }
+
   // Orientation control (affects logical width/height and coordinate transforms)
   void setOrientation(const Orientation o) { orientation = o; }
   Orientation getOrientation() const { return orientation; }
@@ -55,11 +124,54 @@ class GfxRenderer {
   int getScreenWidth() const;
   int getScreenHeight() const;
   void displayBuffer(HalDisplay::RefreshMode refreshMode = HalDisplay::FAST_REFRESH) const;
-  // EXPERIMENTAL: Windowed update - display only a rectangular region
-  void displayWindow(int x, int y, int width, int height) const;
+  // Flush on a background task so the caller can overlap work with the e-ink refresh; call
+  // waitForDisplayFlush() before writing to the framebuffer again (HalDisplay entry points wait
+  // on their own)
+  void displayBufferAsync(HalDisplay::RefreshMode refreshMode = HalDisplay::FAST_REFRESH) const;
+  void waitForDisplayFlush() const;
+  // Refresh planner: flushes with the cheapest mode for what actually changed since the last
+  // flush. Nothing dirty skips the panel refresh entirely; a small dirty region (status bar,
+  // progress bar) uses the fast LUT; anything larger uses the caller's preferred mode.
+  void displayDirty(HalDisplay::RefreshMode preferredMode = HalDisplay::FAST_REFRESH) const;
+  // Mode the planner would pick, for callers that flush through displayBuffer/Async themselves
+  HalDisplay::RefreshMode planRefreshMode(HalDisplay::RefreshMode preferredMode) const;
+  // Bytes of the BW framebuffer differing from the last flushed frame - the ghosting a fast
+  // flush of the current frame would accrue. BUFFER_SIZE when no shadow is available, so
+  // callers without a shadow fall back to their most conservative behaviour
+  size_t pendingFlushDiffBytes() const;
+  bool hasDirtyRegion() const { return dirtyMaxX >= dirtyMinX && dirtyMaxY >= dirtyMinY; }
+  // For full-screen blits written straight into getFrameBuffer() (cover buffer restores, XTC
+  // page blits): records the whole screen dirty so the refresh planner stays truthful
+  void markFullScreenDirty() const { markAllDirty(); }
+  // Screen-space rectangle stamps for cached chrome (battery icon, button hints): capture the
+  // rendered region once, then paste it on later screens instead of re-running text measurement
+  // and vector drawing. Portrait BW only; the y span is widened to byte boundaries internally,
+  // so stamped components should sit on cleared background. Both return false when the mode or
+  // bounds don't allow a stamp, in which case callers just render normally.
+  static size_t stampSize(int w, int h);
+  bool captureStamp(int x, int y, int w, int h, uint8_t* out) const;
+  bool pasteStamp(int x, int y, int w, int h, const uint8_t* in) const;
+  // Differential flush support: keeps a copy of the last frame pushed to the panel, so a flush
+  // of an unchanged frame is skipped outright and the refresh planner sees how much actually
+  // changed (the clear-and-redraw render paths mark the whole screen dirty even when the
+  // result is nearly identical). Costs 48KB of heap while enabled; the reader activities turn
+  // it on for the page-turn flow and off again on exit. Degrades to the old behaviour when the
+  // allocation fails or the shadow is disabled.
+  void setFrameShadowEnabled(bool enabled);
+  bool isFrameShadowEnabled() const { return frameShadowEnabled; }
   void invertScreen() const;
   void clearScreen(uint8_t color = 0xFF) const;
 
+  // Rect clipping for partial redraws (patched list rows, windowed refreshes): while a clip is
+  // set, the text paths reject glyphs outside it before any cache expansion or decode and the
+  // bitmap paths clamp their row/column loops to the visible span, so a partially visible row
+  // costs in proportion to its visible pixels. Logical coordinates, intersected with the
+  // screen. The rect persists across draw calls - pair every setClipRect with clearClipRect.
+  // Even without an explicit clip, the same rejection runs against the screen rect, so fully
+  // offscreen glyphs never cost a decode.
+  void setClipRect(int x, int y, int width, int height);
+  void clearClipRect();
+
   // Drawing
   void drawPixel(int x, int y, bool state = true) const;
   void drawLine(int x1, int y1, int x2, int y2, bool state = true) const;
@@ -69,6 +181,9 @@ class GfxRenderer {
   void drawBitmap(const Bitmap& bitmap, int x, int y, int maxWidth, int maxHeight, float cropX = 0,
                   float cropY = 0) const;
   void drawBitmap1Bit(const Bitmap& bitmap, int x, int y, int maxWidth, int maxHeight) const;
+  // Blit one pre-dithered row packed at 2 bits per pixel MSB-first (the layout
+  // Bitmap::readNextRow and JpegToBmpConverter row sinks produce), clipped to the screen
+  void drawPacked2BitRow(int x, int y, const uint8_t* packedRow, int widthPixels) const;
   void fillPolygon(const int* xPoints, const int* yPoints, int numPoints, bool state = true) const;
 
   // Text
@@ -82,6 +197,19 @@ class GfxRenderer {
   int getLineHeight(int fontId) const;
   std::string truncatedText(int fontId, const char* text, int maxWidth,
                             EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  // Shaped-run API: resolve a string to glyphs once, then reuse the run for both width queries
+  // (run.width) and drawText below. Saves re-shaping when the same string is measured at layout
+  // time and drawn again, as in list row renders.
+  EpdShapedRun shapeText(int fontId, const char* text, EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  // Shape and truncate to maxWidth in one pass, appending "..." when the text doesn't fit
+  EpdShapedRun shapeTruncatedText(int fontId, const char* text, int maxWidth,
+                                  EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  void drawText(int fontId, int x, int y, const EpdShapedRun& run, bool black = true,
+                EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  // Draw pre-resolved codepoints as one run starting at (x, y); no UTF-8 decoding or
+  // measurement pass. Used by compiled page records.
+  void drawGlyphs(int fontId, int x, int y, const uint32_t* cps, size_t count, bool black = true,
+                  EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
 
   // UI Components
   void drawButtonHints(int fontId, const char* btn1, const char* btn2, const char* btn3, const char* btn4);
@@ -99,6 +227,13 @@ class GfxRenderer {
   void copyGrayscaleLsbBuffers() const;
   void copyGrayscaleMsbBuffers() const;
   void displayGrayBuffer() const;
+  // One-pass grayscale: clears the framebuffer (which doubles as the MSB plane) and a side LSB
+  // plane, then switches to GRAYSCALE_2BIT so drawing writes both planes in a single traversal;
+  // flushGrayscalePass() hands the planes to the panel and drops back to BW. Halves the scene
+  // cost against the LSB-then-MSB double pass. Returns false (mode untouched) when the 48KB
+  // plane allocation fails - callers keep the double pass as their fallback.
+  bool beginGrayscalePass();
+  void flushGrayscalePass();
   bool storeBwBuffer();    // Returns true if buffer was stored successfully
   void restoreBwBuffer();  // Restore and free the stored buffer
   void cleanupGrayscaleWithFrameBuffer() const;
@@ -0,0 +1,141 @@
+#include "GlyphCache.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+// Scratch for demand-paged fonts: packed bytes for a MAX_GLYPH_BYTES glyph at 2 bits per pixel.
+// Static rather than stack because the render tasks run on 4KB stacks; the cache is only ever
+// driven from under the owning activity's rendering mutex, so there is no concurrent use.
+uint8_t packedScratch[512];
+
+// Expand packed glyph data to one byte per pixel.
+// 2-bit fonts keep the renderer's swapped scale (0 black .. 3 white); 1-bit fonts store 1 for
+// set pixels and 0 for clear so the caller can branch on bitness exactly as before.
+// Returns false when an SD-backed font (null bitmap pointer) fails the demand read.
+bool expandGlyph(const EpdFontData* data, const EpdGlyph* glyph, uint8_t* out) {
+  const uint8_t* bitmap;
+  if (data->bitmap) {
+    bitmap = &data->bitmap[glyph->dataOffset];
+  } else {
+    // SD-backed font: page the packed bytes in through the font's read hook
+    if (!data->readBitmap || glyph->dataLength > sizeof(packedScratch) ||
+        !data->readBitmap(data->readCtx, glyph->dataOffset, glyph->dataLength, packedScratch)) {
+      return false;
+    }
+    bitmap = packedScratch;
+  }
+  const int pixelCount = glyph->width * glyph->height;
+
+  if (data->is2Bit) {
+    for (int pixelPosition = 0; pixelPosition < pixelCount; pixelPosition++) {
+      const uint8_t byte = bitmap[pixelPosition / 4];
+      const uint8_t bit_index = (3 - pixelPosition % 4) * 2;
+      out[pixelPosition] = 3 - (byte >> bit_index) & 0x3;
+    }
+  } else {
+    for (int pixelPosition = 0; pixelPosition < pixelCount; pixelPosition++) {
+      const uint8_t byte = bitmap[pixelPosition / 8];
+      const uint8_t bit_index = 7 - (pixelPosition % 8);
+      out[pixelPosition] = (byte >> bit_index) & 1;
+    }
+  }
+  return true;
+}
+
+size_t slotHash(const EpdFontData* data, const uint32_t cp) {
+  // Mix the font pointer and codepoint; glyph runs are mostly sequential codepoints
+  return (reinterpret_cast<uintptr_t>(data) >> 4) * 31 + cp;
+}
+}  // namespace
+
+GlyphCache::~GlyphCache() { clear(); }
+
+void GlyphCache::evictSlot(Slot& slot) {
+  if (slot.expanded) {
+    free(slot.expanded);
+    slot.expanded = nullptr;
+    totalBytes -= slot.size;
+  }
+  slot.data = nullptr;
+  slot.cp = 0;
+  slot.size = 0;
+  slot.lastUsed = 0;
+}
+
+void GlyphCache::evictLru() {
+  Slot* victim = nullptr;
+  for (auto& slot : slots) {
+    if (!slot.expanded) {
+      continue;
+    }
+    if (!victim || slot.lastUsed < victim->lastUsed) {
+      victim = &slot;
+    }
+  }
+  if (victim) {
+    evictSlot(*victim);
+  }
+}
+
+const uint8_t* GlyphCache::get(const EpdFontData* data, const uint32_t cp, const EpdGlyph* glyph) {
+  const size_t size = static_cast<size_t>(glyph->width) * glyph->height;
+  if (size == 0 || size > MAX_GLYPH_BYTES) {
+    return nullptr;
+  }
+
+  const size_t baseIndex = slotHash(data, cp);
+  tick++;
+
+  // Probe a short run of slots for a hit
+  for (size_t i = 0; i < PROBE_DEPTH; i++) {
+    Slot& slot = slots[(baseIndex + i) % SLOT_COUNT];
+    if (slot.expanded && slot.data == data && slot.cp == cp) {
+      slot.lastUsed = tick;
+      return slot.expanded;
+    }
+  }
+
+  // Miss: pick the least recently used slot within the probe run
+  Slot* victim = &slots[baseIndex % SLOT_COUNT];
+  for (size_t i = 1; i < PROBE_DEPTH; i++) {
+    Slot& slot = slots[(baseIndex + i) % SLOT_COUNT];
+    if (!slot.expanded) {
+      victim = &slot;
+      break;
+    }
+    if (slot.lastUsed < victim->lastUsed) {
+      victim = &slot;
+    }
+  }
+  evictSlot(*victim);
+
+  // Stay within the overall byte budget
+  while (totalBytes + size > MAX_TOTAL_BYTES && totalBytes > 0) {
+    evictLru();
+  }
+
+  victim->expanded = static_cast<uint8_t*>(malloc(size));
+  if (!victim->expanded) {
+    // Heap pressure - not fatal, the caller decodes the packed bitmap instead
+    return nullptr;
+  }
+
+  if (!expandGlyph(data, glyph, victim->expanded)) {
+    free(victim->expanded);
+    victim->expanded = nullptr;
+    return nullptr;
+  }
+  victim->data = data;
+  victim->cp = cp;
+  victim->size = static_cast<uint16_t>(size);
+  victim->lastUsed = tick;
+  totalBytes += size;
+  return victim->expanded;
+}
+
+void GlyphCache::clear() {
+  for (auto& slot : slots) {
+    evictSlot(slot);
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <EpdFontFamily.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// LRU cache of glyph bitmaps expanded to one byte per pixel.
+//
+// The packed 1-bit/2-bit decode in the text renderer costs shifts, masks and a modulo per pixel;
+// for the hot ASCII range of the current reading font that work repeats on every draw. Entries
+// are keyed by (font data, codepoint) - the EpdFontData pointer uniquely identifies both the
+// font id and the style variant - and hold the glyph rows as plain values so the blit loop is a
+// straight byte read. For SD-backed fonts (null bitmap pointer) the cache doubles as the demand
+// pager: a miss reads the packed glyph bytes from the card through the font's read hook, so the
+// hot glyph range renders at built-in speed once warm.
+class GlyphCache {
+  struct Slot {
+    const EpdFontData* data = nullptr;  // key: font + style variant
+    uint32_t cp = 0;                    // key: codepoint
+    uint8_t* expanded = nullptr;        // width * height bytes, one pixel value per byte
+    uint16_t size = 0;
+    uint32_t lastUsed = 0;
+  };
+
+  static constexpr size_t SLOT_COUNT = 128;
+  static constexpr size_t PROBE_DEPTH = 4;
+  // Oversized glyphs (large CJK faces) aren't worth the budget; decode those directly
+  static constexpr size_t MAX_GLYPH_BYTES = 2048;
+  // Overall expanded-bitmap budget across all slots
+  static constexpr size_t MAX_TOTAL_BYTES = 32 * 1024;
+
+  Slot slots[SLOT_COUNT] = {};
+  size_t totalBytes = 0;
+  uint32_t tick = 0;
+
+  void evictSlot(Slot& slot);
+  void evictLru();
+
+ public:
+  ~GlyphCache();
+  // Returns the expanded bitmap for the glyph (filling the cache on miss), or nullptr if the
+  // glyph is uncacheable - callers must then fall back to decoding the packed bitmap
+  const uint8_t* get(const EpdFontData* data, uint32_t cp, const EpdGlyph* glyph);
+  void clear();
+};
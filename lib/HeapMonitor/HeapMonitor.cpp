@@ -0,0 +1,231 @@
+#include "HeapMonitor.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+HeapMonitor HeapMonitor::instance;
+
+namespace {
+HeapMonitor::Site sites[HeapMonitor::MAX_SITES];
+size_t siteCount = 0;
+
+HeapMonitor::Sample samples[HeapMonitor::SAMPLE_COUNT];
+size_t sampleHead = 0;
+bool samplesWrapped = false;
+
+// recordAlloc runs on whichever task is allocating; the web server reads from its own
+portMUX_TYPE monitorMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct Reclaimer {
+  const char* name = nullptr;
+  std::function<size_t(HeapMonitor::Pressure)> fn;
+};
+Reclaimer reclaimers[HeapMonitor::MAX_RECLAIMERS];
+size_t reclaimerCount = 0;
+// Real mutex (not the spinlock above): reclaim callbacks free memory and take their own locks,
+// which is illegal inside a critical section. Created on first registration, which happens on
+// the main task during setup or an activity's onEnter.
+SemaphoreHandle_t reclaimMutex = nullptr;
+
+HeapMonitor::Pressure lastReportedLevel = HeapMonitor::Pressure::NONE;
+unsigned long lastTrimMs = 0;
+
+const char* pressureName(const HeapMonitor::Pressure level) {
+  switch (level) {
+    case HeapMonitor::Pressure::ELEVATED:
+      return "elevated";
+    case HeapMonitor::Pressure::CRITICAL:
+      return "critical";
+    default:
+      return "none";
+  }
+}
+
+HeapMonitor::Site* findOrAddSite(const char* name) {
+  for (size_t i = 0; i < siteCount; i++) {
+    if (sites[i].name == name) {
+      return &sites[i];
+    }
+  }
+  if (siteCount >= HeapMonitor::MAX_SITES) {
+    return nullptr;
+  }
+  sites[siteCount].name = name;
+  return &sites[siteCount++];
+}
+}  // namespace
+
+void HeapMonitor::recordAlloc(const char* name, const size_t bytes, const bool success) {
+  portENTER_CRITICAL(&monitorMux);
+  Site* site = findOrAddSite(name);
+  if (site) {
+    if (success) {
+      site->count++;
+      site->totalBytes += bytes;
+    } else {
+      site->failures++;
+      site->lastFailBytes = bytes;
+    }
+    if (bytes > site->largestBytes) {
+      site->largestBytes = bytes;
+    }
+  }
+  portEXIT_CRITICAL(&monitorMux);
+
+  if (!success) {
+    Serial.printf("[%lu] [HEAP] Allocation of %u bytes failed at %s (free: %u, largest block: %u)\n", millis(), bytes,
+                  name, ESP.getFreeHeap(), ESP.getMaxAllocHeap());
+  }
+}
+
+void HeapMonitor::sample() {
+  Sample s;
+  s.uptimeSeconds = millis() / 1000;
+  s.freeHeap = ESP.getFreeHeap();
+  s.largestFreeBlock = ESP.getMaxAllocHeap();
+  s.minFreeHeap = ESP.getMinFreeHeap();
+
+  portENTER_CRITICAL(&monitorMux);
+  samples[sampleHead] = s;
+  sampleHead = (sampleHead + 1) % SAMPLE_COUNT;
+  if (sampleHead == 0) {
+    samplesWrapped = true;
+  }
+  portEXIT_CRITICAL(&monitorMux);
+}
+
+void HeapMonitor::forEachSite(const std::function<void(const Site&)>& visitor) const {
+  portENTER_CRITICAL(&monitorMux);
+  const size_t count = siteCount;
+  portEXIT_CRITICAL(&monitorMux);
+  for (size_t i = 0; i < count; i++) {
+    // Copy under the lock so a concurrent recordAlloc can't tear the counters
+    portENTER_CRITICAL(&monitorMux);
+    const Site copy = sites[i];
+    portEXIT_CRITICAL(&monitorMux);
+    visitor(copy);
+  }
+}
+
+void HeapMonitor::registerReclaimer(const char* name, std::function<size_t(Pressure)> fn) {
+  if (reclaimMutex == nullptr) {
+    reclaimMutex = xSemaphoreCreateMutex();
+  }
+  xSemaphoreTake(reclaimMutex, portMAX_DELAY);
+  Reclaimer* slot = nullptr;
+  for (size_t i = 0; i < reclaimerCount; i++) {
+    // Re-registering replaces; a slot vacated by unregisterReclaimer is reused
+    if (reclaimers[i].name == name || reclaimers[i].name == nullptr) {
+      slot = &reclaimers[i];
+      break;
+    }
+  }
+  if (slot == nullptr && reclaimerCount < MAX_RECLAIMERS) {
+    slot = &reclaimers[reclaimerCount++];
+  }
+  if (slot != nullptr) {
+    slot->name = name;
+    slot->fn = std::move(fn);
+  } else {
+    Serial.printf("[%lu] [HEAP] Reclaimer table full, dropping %s\n", millis(), name);
+  }
+  xSemaphoreGive(reclaimMutex);
+}
+
+void HeapMonitor::unregisterReclaimer(const char* name) {
+  if (reclaimMutex == nullptr) {
+    return;
+  }
+  // Also serializes against a trim in flight, so the callback can't run after this returns
+  xSemaphoreTake(reclaimMutex, portMAX_DELAY);
+  for (size_t i = 0; i < reclaimerCount; i++) {
+    if (reclaimers[i].name == name) {
+      reclaimers[i].name = nullptr;
+      reclaimers[i].fn = nullptr;
+      break;
+    }
+  }
+  xSemaphoreGive(reclaimMutex);
+}
+
+HeapMonitor::Pressure HeapMonitor::pressureLevel() const {
+  const uint32_t freeHeap = ESP.getFreeHeap();
+  const uint32_t largestBlock = ESP.getMaxAllocHeap();
+  if (freeHeap < CRITICAL_FREE_HEAP || largestBlock < CRITICAL_LARGEST_BLOCK) {
+    return Pressure::CRITICAL;
+  }
+  if (freeHeap < ELEVATED_FREE_HEAP || largestBlock < ELEVATED_LARGEST_BLOCK) {
+    return Pressure::ELEVATED;
+  }
+  return Pressure::NONE;
+}
+
+size_t HeapMonitor::trim(const Pressure level) {
+  if (level == Pressure::NONE || reclaimMutex == nullptr) {
+    return 0;
+  }
+  // Bounded wait: a trim already running on another task is doing the work anyway
+  if (xSemaphoreTake(reclaimMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+    return 0;
+  }
+  size_t totalFreed = 0;
+  for (size_t i = 0; i < reclaimerCount; i++) {
+    if (reclaimers[i].name == nullptr || !reclaimers[i].fn) {
+      continue;
+    }
+    const size_t freed = reclaimers[i].fn(level);
+    if (freed > 0) {
+      Serial.printf("[%lu] [HEAP] Trim (%s): %s freed %u bytes\n", millis(), pressureName(level), reclaimers[i].name,
+                    freed);
+    }
+    totalFreed += freed;
+  }
+  xSemaphoreGive(reclaimMutex);
+  return totalFreed;
+}
+
+bool HeapMonitor::demand(const size_t bytes) {
+  if (ESP.getMaxAllocHeap() >= bytes + DEMAND_HEADROOM) {
+    return true;
+  }
+  trim(Pressure::ELEVATED);
+  if (ESP.getMaxAllocHeap() >= bytes + DEMAND_HEADROOM) {
+    return true;
+  }
+  trim(Pressure::CRITICAL);
+  // Headroom waived as the last resort; a tight fit beats a failed allocation
+  return ESP.getMaxAllocHeap() >= bytes;
+}
+
+void HeapMonitor::checkPressure() {
+  const Pressure level = pressureLevel();
+  if (level != lastReportedLevel) {
+    Serial.printf("[%lu] [HEAP] Pressure %s -> %s (free: %u, largest block: %u)\n", millis(),
+                  pressureName(lastReportedLevel), pressureName(level), ESP.getFreeHeap(), ESP.getMaxAllocHeap());
+    lastReportedLevel = level;
+    lastTrimMs = 0;  // shed immediately on entering a tier
+  }
+  if (level == Pressure::NONE) {
+    return;
+  }
+  // Re-trim while the tier persists: prefetch and caches repopulate between checks
+  if (lastTrimMs != 0 && millis() - lastTrimMs < 30000) {
+    return;
+  }
+  lastTrimMs = millis();
+  trim(level);
+}
+
+void HeapMonitor::forEachSample(const std::function<void(const Sample&)>& visitor) const {
+  portENTER_CRITICAL(&monitorMux);
+  const size_t count = samplesWrapped ? SAMPLE_COUNT : sampleHead;
+  const size_t start = samplesWrapped ? sampleHead : 0;
+  portEXIT_CRITICAL(&monitorMux);
+  for (size_t i = 0; i < count; i++) {
+    portENTER_CRITICAL(&monitorMux);
+    const Sample copy = samples[(start + i) % SAMPLE_COUNT];
+    portEXIT_CRITICAL(&monitorMux);
+    visitor(copy);
+  }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Always-on heap health tracking for chasing fragmentation in the field. Three halves:
+//
+//  - per-site allocation accounting: the large-buffer allocation sites in the Epub/Zip/Gfx
+//    subsystems report each attempt via recordAlloc(), so failures can be pinned to a site
+//    instead of guessed at from the free-heap number;
+//  - a sampled history of free heap vs largest free block (the gap between the two IS the
+//    fragmentation), filled by the main loop alongside its periodic MEM print;
+//  - a memory budget: subsystems register reclaimable caches (reader prefetch, glyph cache)
+//    and pressure is shed through them in tiers, so when the web server and a big book
+//    collide the reader degrades predictably instead of random allocations failing.
+//
+// The first two are exposed through CrossPointWebServer's /api/heap debug endpoint. Costs a few
+// counters and a pointer compare per tracked allocation, so it stays on in release builds.
+class HeapMonitor {
+ public:
+  struct Site {
+    const char* name = nullptr;  // string literal; identity is the pointer, not the contents
+    uint32_t count = 0;          // successful allocations
+    uint32_t failures = 0;       // attempts that returned nullptr
+    uint32_t totalBytes = 0;     // cumulative bytes successfully allocated
+    uint32_t largestBytes = 0;   // biggest single request seen (failed or not)
+    uint32_t lastFailBytes = 0;  // size of the most recent failed request
+  };
+
+  struct Sample {
+    uint32_t uptimeSeconds = 0;
+    uint32_t freeHeap = 0;
+    uint32_t largestFreeBlock = 0;
+    uint32_t minFreeHeap = 0;
+  };
+
+  // Pressure tiers, judged from free heap and largest free block. ELEVATED sheds cheap caches
+  // (prefetched neighbour sections); CRITICAL sheds everything reclaimable (glyph cache too).
+  enum class Pressure : uint8_t { NONE = 0, ELEVATED = 1, CRITICAL = 2 };
+
+  static constexpr size_t MAX_SITES = 16;
+  static constexpr size_t SAMPLE_COUNT = 72;  // 12 minutes of history at the 10s sample cadence
+  static constexpr size_t MAX_RECLAIMERS = 8;
+
+  static HeapMonitor& getInstance() { return instance; }
+
+  // Record one allocation attempt. `name` must be a string literal (sites are matched by
+  // pointer). Safe to call from any task.
+  void recordAlloc(const char* name, size_t bytes, bool success);
+
+  // Take one fragmentation sample; the main loop calls this on its MEM print cadence
+  void sample();
+
+  // Snapshot accessors for the web debug page; visitors run outside the internal lock
+  void forEachSite(const std::function<void(const Site&)>& visitor) const;
+  void forEachSample(const std::function<void(const Sample&)>& visitor) const;
+
+  // Register a reclaimable cache. `name` must be a string literal (matched by pointer, like
+  // sites). The callback is invoked from whichever task hits pressure and returns the bytes it
+  // freed, so it must do its own locking - and must not block long (skip the trim rather than
+  // stall the caller). Activity-scoped caches unregister on exit.
+  void registerReclaimer(const char* name, std::function<size_t(Pressure)> fn);
+  void unregisterReclaimer(const char* name);
+
+  // Current pressure tier from free heap / largest free block
+  Pressure pressureLevel() const;
+
+  // Walk the registered reclaimers at the given tier; returns total bytes freed
+  size_t trim(Pressure level);
+
+  // Called by big-buffer sites before allocating: trims caches until the request (plus working
+  // headroom) fits in the largest free block. Returns false when it still won't fit - the
+  // caller's allocation would fail, so it can bail before fragmenting the heap further.
+  bool demand(size_t bytes);
+
+  // Periodic pressure check for the main loop (same cadence as sample()): logs tier
+  // transitions and trims on entry to a tier, re-trimming while it persists
+  void checkPressure();
+
+ private:
+  HeapMonitor() = default;
+  ~HeapMonitor() = default;
+
+  static HeapMonitor instance;
+
+  // Thresholds chosen against the ~80KB the firmware idles with while serving the web UI with
+  // a book open; below these, readFileToMemory of a typical chapter starts failing
+  static constexpr uint32_t ELEVATED_FREE_HEAP = 40 * 1024;
+  static constexpr uint32_t ELEVATED_LARGEST_BLOCK = 16 * 1024;
+  static constexpr uint32_t CRITICAL_FREE_HEAP = 24 * 1024;
+  static constexpr uint32_t CRITICAL_LARGEST_BLOCK = 8 * 1024;
+  // Kept allocatable beyond a demand() request so the trim doesn't hand the whole heap to one
+  // buffer
+  static constexpr uint32_t DEMAND_HEADROOM = 8 * 1024;
+};
+
+// Helper macro to access the shared monitor
+#define HEAP_MON HeapMonitor::getInstance()
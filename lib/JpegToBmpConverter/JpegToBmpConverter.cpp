@@ -8,6 +8,7 @@
 #include <cstring>
 
 #include "BitmapHelpers.h"
+#include "BmpWriter.h"
 
 // Context structure for picojpeg callback
 struct JpegReadContext {
@@ -25,146 +26,154 @@ constexpr bool USE_8BIT_OUTPUT = false;  // true: 8-bit grayscale (no quantizati
 constexpr bool USE_ATKINSON = true;          // Atkinson dithering (cleaner than F-S, less error diffusion)
 constexpr bool USE_FLOYD_STEINBERG = false;  // Floyd-Steinberg error diffusion (can cause "worm" artifacts)
 constexpr bool USE_NOISE_DITHERING = false;  // Hash-based noise dithering (good for downsampling)
+// 1-bit output at or below this size (thumbnails, list images) uses ordered Bayer
+// dithering instead of error diffusion; above it the crosshatch would show
+constexpr int ORDERED_DITHER_MAX_DIM = 400;
 // Pre-resize to target display size (CRITICAL: avoids dithering artifacts from post-downsampling)
-constexpr bool USE_PRESCALE = true;     // true: scale image to target size before dithering
-constexpr int TARGET_MAX_WIDTH = 480;   // Max width for cover images (portrait display width)
-constexpr int TARGET_MAX_HEIGHT = 800;  // Max height for cover images (portrait display height)
+constexpr bool USE_PRESCALE = true;  // true: scale image to target size before dithering
 // ============================================================================
 
-inline void write16(Print& out, const uint16_t value) {
-  out.write(value & 0xFF);
-  out.write((value >> 8) & 0xFF);
-}
+namespace {
+// Most variants one decode pass can emit (the cover pipeline needs three)
+constexpr int MAX_OUTPUT_PLANES = 4;
+
+// Per-output state for one variant of a combined decode: that variant's dimensions, scaler
+// accumulators, ditherers and packed row buffer. Every plane consumes the same decoded MCU
+// row stream.
+struct OutputPlane {
+  const JpegToBmpConverter::Output* spec = nullptr;
+  int outWidth = 0;
+  int outHeight = 0;
+  float scale = 1.0f;
+  // Fixed-point (16.16) source-pixels-per-output-pixel factors for the area-averaging scaler
+  uint32_t scaleX_fp = 65536;
+  uint32_t scaleY_fp = 65536;
+  bool needsScaling = false;
+  int bytesPerRow = 0;
+  uint8_t* rowBuffer = nullptr;
+  uint32_t* rowAccum = nullptr;  // Accumulator for each output X (32-bit for larger sums)
+  uint16_t* rowCount = nullptr;  // Count of source pixels accumulated per output X
+  int currentOutY = 0;
+  uint32_t nextOutY_srcStart = 0;  // Source Y where the next output row starts (16.16)
+  AtkinsonDitherer* atkinsonDitherer = nullptr;
+  FloydSteinbergDitherer* fsDitherer = nullptr;
+  Atkinson1BitDitherer* atkinson1BitDitherer = nullptr;
+  Bayer1BitDitherer* bayer1BitDitherer = nullptr;
+};
 
-inline void write32(Print& out, const uint32_t value) {
-  out.write(value & 0xFF);
-  out.write((value >> 8) & 0xFF);
-  out.write((value >> 16) & 0xFF);
-  out.write((value >> 24) & 0xFF);
+// Hand a finished output row to whichever destinations the plane requested
+void emitPlaneRow(const OutputPlane& plane, const int rowY) {
+  if (plane.spec->bmpOut) plane.spec->bmpOut->write(plane.rowBuffer, plane.bytesPerRow);
+  if (plane.spec->sink && plane.spec->sink->onRow) plane.spec->sink->onRow(rowY, plane.rowBuffer, plane.outWidth);
 }
 
-inline void write32Signed(Print& out, const int32_t value) {
-  out.write(value & 0xFF);
-  out.write((value >> 8) & 0xFF);
-  out.write((value >> 16) & 0xFF);
-  out.write((value >> 24) & 0xFF);
-}
+// Pack one output row for a plane from per-x gray values and advance its ditherers
+template <typename GrayFn>
+void packPlaneRow(OutputPlane& plane, const GrayFn& grayAt, const int ditherY) {
+  memset(plane.rowBuffer, 0, plane.bytesPerRow);
 
-// Helper function: Write BMP header with 8-bit grayscale (256 levels)
-void writeBmpHeader8bit(Print& bmpOut, const int width, const int height) {
-  // Calculate row padding (each row must be multiple of 4 bytes)
-  const int bytesPerRow = (width + 3) / 4 * 4;  // 8 bits per pixel, padded
-  const int imageSize = bytesPerRow * height;
-  const uint32_t paletteSize = 256 * 4;  // 256 colors * 4 bytes (BGRA)
-  const uint32_t fileSize = 14 + 40 + paletteSize + imageSize;
-
-  // BMP File Header (14 bytes)
-  bmpOut.write('B');
-  bmpOut.write('M');
-  write32(bmpOut, fileSize);
-  write32(bmpOut, 0);                      // Reserved
-  write32(bmpOut, 14 + 40 + paletteSize);  // Offset to pixel data
-
-  // DIB Header (BITMAPINFOHEADER - 40 bytes)
-  write32(bmpOut, 40);
-  write32Signed(bmpOut, width);
-  write32Signed(bmpOut, -height);  // Negative height = top-down bitmap
-  write16(bmpOut, 1);              // Color planes
-  write16(bmpOut, 8);              // Bits per pixel (8 bits)
-  write32(bmpOut, 0);              // BI_RGB (no compression)
-  write32(bmpOut, imageSize);
-  write32(bmpOut, 2835);  // xPixelsPerMeter (72 DPI)
-  write32(bmpOut, 2835);  // yPixelsPerMeter (72 DPI)
-  write32(bmpOut, 256);   // colorsUsed
-  write32(bmpOut, 256);   // colorsImportant
-
-  // Color Palette (256 grayscale entries x 4 bytes = 1024 bytes)
-  for (int i = 0; i < 256; i++) {
-    bmpOut.write(static_cast<uint8_t>(i));  // Blue
-    bmpOut.write(static_cast<uint8_t>(i));  // Green
-    bmpOut.write(static_cast<uint8_t>(i));  // Red
-    bmpOut.write(static_cast<uint8_t>(0));  // Reserved
+  if (USE_8BIT_OUTPUT && !plane.spec->oneBit) {
+    for (int x = 0; x < plane.outWidth; x++) {
+      plane.rowBuffer[x] = adjustPixel(grayAt(x));
+    }
+  } else if (plane.spec->oneBit) {
+    // 1-bit output: ordered Bayer for small images, Atkinson otherwise
+    PackedRowWriter packer(plane.rowBuffer, 1);
+    for (int x = 0; x < plane.outWidth; x++) {
+      const uint8_t gray = grayAt(x);
+      packer.push(plane.bayer1BitDitherer      ? plane.bayer1BitDitherer->processPixel(gray, x)
+                  : plane.atkinson1BitDitherer ? plane.atkinson1BitDitherer->processPixel(gray, x)
+                                               : quantize1bit(gray, x, ditherY));
+    }
+    packer.flush();
+    if (plane.bayer1BitDitherer) plane.bayer1BitDitherer->nextRow();
+    if (plane.atkinson1BitDitherer) plane.atkinson1BitDitherer->nextRow();
+  } else if (plane.spec->fourBit) {
+    // 4-bit grayscale: round to the nearest of 16 raw tone levels, no dithering or
+    // adjustment here. Tone mapping to the panel's levels happens at blit time, where a
+    // per-file LUT keeps it to one lookup per pixel.
+    PackedRowWriter packer(plane.rowBuffer, 4);
+    for (int x = 0; x < plane.outWidth; x++) {
+      packer.push(static_cast<uint8_t>((grayAt(x) * 15 + 127) / 255));
+    }
+    packer.flush();
+  } else {
+    // 2-bit output
+    PackedRowWriter packer(plane.rowBuffer, 2);
+    for (int x = 0; x < plane.outWidth; x++) {
+      const uint8_t gray = adjustPixel(grayAt(x));
+      uint8_t twoBit;
+      if (plane.atkinsonDitherer) {
+        twoBit = plane.atkinsonDitherer->processPixel(gray, x);
+      } else if (plane.fsDitherer) {
+        twoBit = plane.fsDitherer->processPixel(gray, x);
+      } else {
+        twoBit = quantize(gray, x, ditherY);
+      }
+      packer.push(twoBit);
+    }
+    packer.flush();
+    if (plane.atkinsonDitherer)
+      plane.atkinsonDitherer->nextRow();
+    else if (plane.fsDitherer)
+      plane.fsDitherer->nextRow();
   }
 }
 
-// Helper function: Write BMP header with 1-bit color depth (black and white)
-static void writeBmpHeader1bit(Print& bmpOut, const int width, const int height) {
-  // Calculate row padding (each row must be multiple of 4 bytes)
-  const int bytesPerRow = (width + 31) / 32 * 4;  // 1 bit per pixel, round up to 4-byte boundary
-  const int imageSize = bytesPerRow * height;
-  const uint32_t fileSize = 62 + imageSize;  // 14 (file header) + 40 (DIB header) + 8 (palette) + image
-
-  // BMP File Header (14 bytes)
-  bmpOut.write('B');
-  bmpOut.write('M');
-  write32(bmpOut, fileSize);  // File size
-  write32(bmpOut, 0);         // Reserved
-  write32(bmpOut, 62);        // Offset to pixel data (14 + 40 + 8)
-
-  // DIB Header (BITMAPINFOHEADER - 40 bytes)
-  write32(bmpOut, 40);
-  write32Signed(bmpOut, width);
-  write32Signed(bmpOut, -height);  // Negative height = top-down bitmap
-  write16(bmpOut, 1);              // Color planes
-  write16(bmpOut, 1);              // Bits per pixel (1 bit)
-  write32(bmpOut, 0);              // BI_RGB (no compression)
-  write32(bmpOut, imageSize);
-  write32(bmpOut, 2835);  // xPixelsPerMeter (72 DPI)
-  write32(bmpOut, 2835);  // yPixelsPerMeter (72 DPI)
-  write32(bmpOut, 2);     // colorsUsed
-  write32(bmpOut, 2);     // colorsImportant
-
-  // Color Palette (2 colors x 4 bytes = 8 bytes)
-  // Format: Blue, Green, Red, Reserved (BGRA)
-  // Note: In 1-bit BMP, palette index 0 = black, 1 = white
-  uint8_t palette[8] = {
-      0x00, 0x00, 0x00, 0x00,  // Color 0: Black
-      0xFF, 0xFF, 0xFF, 0x00   // Color 1: White
-  };
-  for (const uint8_t i : palette) {
-    bmpOut.write(i);
+// Feed one decoded source row into a plane: direct pack at 1:1, or accumulate into the
+// area-averaging scaler and emit whenever the source crosses an output row boundary
+void feedSourceRow(OutputPlane& plane, const uint8_t* srcRow, const int srcWidth, const int y) {
+  if (!plane.needsScaling) {
+    // No scaling - direct output (1:1 mapping)
+    packPlaneRow(plane, [&](const int x) { return srcRow[x]; }, y);
+    emitPlaneRow(plane, y);
+    return;
   }
-}
 
-// Helper function: Write BMP header with 2-bit color depth
-static void writeBmpHeader2bit(Print& bmpOut, const int width, const int height) {
-  // Calculate row padding (each row must be multiple of 4 bytes)
-  const int bytesPerRow = (width * 2 + 31) / 32 * 4;  // 2 bits per pixel, round up
-  const int imageSize = bytesPerRow * height;
-  const uint32_t fileSize = 70 + imageSize;  // 14 (file header) + 40 (DIB header) + 16 (palette) + image
-
-  // BMP File Header (14 bytes)
-  bmpOut.write('B');
-  bmpOut.write('M');
-  write32(bmpOut, fileSize);  // File size
-  write32(bmpOut, 0);         // Reserved
-  write32(bmpOut, 70);        // Offset to pixel data
-
-  // DIB Header (BITMAPINFOHEADER - 40 bytes)
-  write32(bmpOut, 40);
-  write32Signed(bmpOut, width);
-  write32Signed(bmpOut, -height);  // Negative height = top-down bitmap
-  write16(bmpOut, 1);              // Color planes
-  write16(bmpOut, 2);              // Bits per pixel (2 bits)
-  write32(bmpOut, 0);              // BI_RGB (no compression)
-  write32(bmpOut, imageSize);
-  write32(bmpOut, 2835);  // xPixelsPerMeter (72 DPI)
-  write32(bmpOut, 2835);  // yPixelsPerMeter (72 DPI)
-  write32(bmpOut, 4);     // colorsUsed
-  write32(bmpOut, 4);     // colorsImportant
-
-  // Color Palette (4 colors x 4 bytes = 16 bytes)
-  // Format: Blue, Green, Red, Reserved (BGRA)
-  uint8_t palette[16] = {
-      0x00, 0x00, 0x00, 0x00,  // Color 0: Black
-      0x55, 0x55, 0x55, 0x00,  // Color 1: Dark gray (85)
-      0xAA, 0xAA, 0xAA, 0x00,  // Color 2: Light gray (170)
-      0xFF, 0xFF, 0xFF, 0x00   // Color 3: White
-  };
-  for (const uint8_t i : palette) {
-    bmpOut.write(i);
+  // Fixed-point area averaging for exact fit scaling. Consecutive output pixels cover
+  // adjacent source ranges, so carry the range end forward instead of recomputing both
+  // bounds per pixel.
+  int srcXStart = 0;
+  for (int outX = 0; outX < plane.outWidth; outX++) {
+    int srcXEnd = (static_cast<uint32_t>(outX + 1) * plane.scaleX_fp) >> 16;
+    if (srcXEnd > srcWidth) srcXEnd = srcWidth;
+
+    // Accumulate all source pixels in this range (word-at-a-time)
+    int sum;
+    int count = srcXEnd - srcXStart;
+    if (count > 0) {
+      sum = sumPixelSpan(srcRow, srcXStart, srcXEnd);
+    } else if (srcXStart < srcWidth) {
+      // Edge case: no pixels in range, use nearest
+      sum = srcRow[srcXStart];
+      count = 1;
+    } else {
+      sum = 0;
+      count = 0;
+    }
+
+    plane.rowAccum[outX] += sum;
+    plane.rowCount[outX] += count;
+    if (srcXEnd > srcXStart) srcXStart = srcXEnd;
+  }
+
+  // Output a row when the source Y crosses the next output row boundary
+  const uint32_t srcY_fp = static_cast<uint32_t>(y + 1) << 16;
+  if (srcY_fp >= plane.nextOutY_srcStart && plane.currentOutY < plane.outHeight) {
+    packPlaneRow(
+        plane,
+        [&](const int x) { return static_cast<uint8_t>(plane.rowCount[x] > 0 ? plane.rowAccum[x] / plane.rowCount[x] : 0); },
+        plane.currentOutY);
+    emitPlaneRow(plane, plane.currentOutY);
+    plane.currentOutY++;
+
+    // Reset accumulators for the next output row
+    memset(plane.rowAccum, 0, plane.outWidth * sizeof(uint32_t));
+    memset(plane.rowCount, 0, plane.outWidth * sizeof(uint16_t));
+    plane.nextOutY_srcStart = static_cast<uint32_t>(plane.currentOutY + 1) * plane.scaleY_fp;
   }
 }
+}  // namespace
 
 // Callback function for picojpeg to read JPEG data
 unsigned char JpegToBmpConverter::jpegReadCallback(unsigned char* pBuf, const unsigned char buf_size,
@@ -198,11 +207,13 @@ unsigned char JpegToBmpConverter::jpegReadCallback(unsigned char* pBuf, const un
   return 0;  // Success
 }
 
-// Internal implementation with configurable target size and bit depth
-bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bmpOut, int targetWidth, int targetHeight,
-                                                     bool oneBit, bool crop) {
-  Serial.printf("[%lu] [JPG] Converting JPEG to %s BMP (target: %dx%d)\n", millis(), oneBit ? "1-bit" : "2-bit",
-                targetWidth, targetHeight);
+// Combined conversion pass: one JPEG decode feeding any number of output variants, each with
+// its own scaler, ditherers and destinations
+bool JpegToBmpConverter::jpegFileToBmpStreams(FsFile& jpegFile, const Output* outputs, const int outputCount) {
+  if (outputCount < 1 || outputCount > MAX_OUTPUT_PLANES) {
+    return false;
+  }
+  Serial.printf("[%lu] [JPG] Converting JPEG to %d BMP variant(s)\n", millis(), outputCount);
 
   // Setup context for picojpeg callback
   JpegReadContext context = {.file = jpegFile, .bufferPos = 0, .bufferFilled = 0};
@@ -223,122 +234,173 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
   constexpr int MAX_IMAGE_HEIGHT = 3072;
   constexpr int MAX_MCU_ROW_BYTES = 65536;
 
-  if (imageInfo.m_width > MAX_IMAGE_WIDTH || imageInfo.m_height > MAX_IMAGE_HEIGHT) {
+  // Work out each variant's scale first: the reduced decode below is shared by every plane,
+  // so it can only kick in when even the least downscaled output stays at or below 1/8
+  OutputPlane planes[MAX_OUTPUT_PLANES];
+  float maxScale = 0.0f;
+  for (int p = 0; p < outputCount; p++) {
+    OutputPlane& plane = planes[p];
+    const Output& out = outputs[p];
+    plane.spec = &out;
+
+    if (out.targetMaxWidth > 0 && out.targetMaxHeight > 0 &&
+        (imageInfo.m_width > out.targetMaxWidth || imageInfo.m_height > out.targetMaxHeight)) {
+      // Calculate scale to fit within target dimensions while maintaining aspect ratio
+      const float scaleToFitWidth = static_cast<float>(out.targetMaxWidth) / imageInfo.m_width;
+      const float scaleToFitHeight = static_cast<float>(out.targetMaxHeight) / imageInfo.m_height;
+      // We scale to the smaller dimension, so we can potentially crop later.
+      if (out.crop) {  // if we will crop, scale to the smaller dimension
+        plane.scale = (scaleToFitWidth > scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
+      } else {  // else, scale to the larger dimension to fit
+        plane.scale = (scaleToFitWidth < scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
+      }
+      plane.needsScaling = true;
+    }
+    if (plane.scale > maxScale) maxScale = plane.scale;
+  }
+
+  // Source dimensions as decoded; divided by 8 when the reduced decode kicks in
+  int srcWidth = imageInfo.m_width;
+  int srcHeight = imageInfo.m_height;
+  bool reduce = false;
+
+  // When every variant downscales past 8x, have picojpeg skip the AC coefficients and hand
+  // back one DC pixel per 8x8 block; the area-averaging passes below then run on a 64x
+  // smaller source. Needs the header re-parsed with the reduce flag set.
+  if (maxScale <= 0.125f) {
+    jpegFile.seekSet(0);
+    context.bufferPos = 0;
+    context.bufferFilled = 0;
+    if (pjpeg_decode_init(&imageInfo, jpegReadCallback, &context, 1) != 0) {
+      Serial.printf("[%lu] [JPG] JPEG reduced decode init failed\n", millis());
+      return false;
+    }
+    srcWidth = (imageInfo.m_width + 7) / 8;
+    srcHeight = (imageInfo.m_height + 7) / 8;
+    reduce = true;
+    Serial.printf("[%lu] [JPG] Using DC-only reduced decode (%dx%d source)\n", millis(), srcWidth, srcHeight);
+  }
+
+  // The dimension cap bounds the full-decode MCU row buffer; a reduced decode's buffer is
+  // 64x smaller, so oversized images are fine there (the row buffer check below still guards)
+  if (!reduce && (imageInfo.m_width > MAX_IMAGE_WIDTH || imageInfo.m_height > MAX_IMAGE_HEIGHT)) {
     Serial.printf("[%lu] [JPG] Image too large (%dx%d), max supported: %dx%d\n", millis(), imageInfo.m_width,
                   imageInfo.m_height, MAX_IMAGE_WIDTH, MAX_IMAGE_HEIGHT);
     return false;
   }
 
-  // Calculate output dimensions (pre-scale to fit display exactly)
-  int outWidth = imageInfo.m_width;
-  int outHeight = imageInfo.m_height;
-  // Use fixed-point scaling (16.16) for sub-pixel accuracy
-  uint32_t scaleX_fp = 65536;  // 1.0 in 16.16 fixed point
-  uint32_t scaleY_fp = 65536;
-  bool needsScaling = false;
-
-  if (targetWidth > 0 && targetHeight > 0 && (imageInfo.m_width > targetWidth || imageInfo.m_height > targetHeight)) {
-    // Calculate scale to fit within target dimensions while maintaining aspect ratio
-    const float scaleToFitWidth = static_cast<float>(targetWidth) / imageInfo.m_width;
-    const float scaleToFitHeight = static_cast<float>(targetHeight) / imageInfo.m_height;
-    // We scale to the smaller dimension, so we can potentially crop later.
-    float scale = 1.0;
-    if (crop) {  // if we will crop, scale to the smaller dimension
-      scale = (scaleToFitWidth > scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
-    } else {  // else, scale to the larger dimension to fit
-      scale = (scaleToFitWidth < scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
+  // Resolve output dimensions and fixed-point scale factors per plane
+  for (int p = 0; p < outputCount; p++) {
+    OutputPlane& plane = planes[p];
+    if (plane.needsScaling) {
+      plane.outWidth = static_cast<int>(imageInfo.m_width * plane.scale);
+      plane.outHeight = static_cast<int>(imageInfo.m_height * plane.scale);
+      // Ensure at least 1 pixel
+      if (plane.outWidth < 1) plane.outWidth = 1;
+      if (plane.outHeight < 1) plane.outHeight = 1;
+      // Fixed-point scale factors (source pixels per output pixel)
+      plane.scaleX_fp = (static_cast<uint32_t>(srcWidth) << 16) / plane.outWidth;
+      plane.scaleY_fp = (static_cast<uint32_t>(srcHeight) << 16) / plane.outHeight;
+      plane.nextOutY_srcStart = plane.scaleY_fp;  // First boundary (source Y for outY=1)
+      Serial.printf("[%lu] [JPG] Pre-scaling %dx%d -> %dx%d (fit to %dx%d)\n", millis(), imageInfo.m_width,
+                    imageInfo.m_height, plane.outWidth, plane.outHeight, plane.spec->targetMaxWidth,
+                    plane.spec->targetMaxHeight);
+    } else {
+      plane.outWidth = imageInfo.m_width;
+      plane.outHeight = imageInfo.m_height;
     }
+  }
 
-    outWidth = static_cast<int>(imageInfo.m_width * scale);
-    outHeight = static_cast<int>(imageInfo.m_height * scale);
+  // Release whatever per-plane buffers and ditherers were allocated so far
+  const auto releasePlanes = [&] {
+    for (int p = 0; p < outputCount; p++) {
+      free(planes[p].rowBuffer);
+      delete[] planes[p].rowAccum;
+      delete[] planes[p].rowCount;
+      delete planes[p].atkinsonDitherer;
+      delete planes[p].fsDitherer;
+      delete planes[p].atkinson1BitDitherer;
+      delete planes[p].bayer1BitDitherer;
+    }
+  };
 
-    // Ensure at least 1 pixel
-    if (outWidth < 1) outWidth = 1;
-    if (outHeight < 1) outHeight = 1;
+  // Write BMP headers, announce dimensions, and set up each plane's buffers and ditherers
+  for (int p = 0; p < outputCount; p++) {
+    OutputPlane& plane = planes[p];
+    const Output& out = outputs[p];
+
+    if (USE_8BIT_OUTPUT && !out.oneBit) {
+      if (out.bmpOut) writeBmpHeader8bit(*out.bmpOut, plane.outWidth, plane.outHeight);
+      plane.bytesPerRow = (plane.outWidth + 3) / 4 * 4;
+    } else if (out.oneBit) {
+      if (out.bmpOut) writeBmpHeader1bit(*out.bmpOut, plane.outWidth, plane.outHeight);
+      plane.bytesPerRow = (plane.outWidth + 31) / 32 * 4;  // 1 bit per pixel
+    } else if (out.fourBit) {
+      if (out.bmpOut) writeBmpHeader4bit(*out.bmpOut, plane.outWidth, plane.outHeight);
+      plane.bytesPerRow = (plane.outWidth * 4 + 31) / 32 * 4;
+    } else {
+      if (out.bmpOut) writeBmpHeader2bit(*out.bmpOut, plane.outWidth, plane.outHeight);
+      plane.bytesPerRow = (plane.outWidth * 2 + 31) / 32 * 4;
+    }
 
-    // Calculate fixed-point scale factors (source pixels per output pixel)
-    // scaleX_fp = (srcWidth << 16) / outWidth
-    scaleX_fp = (static_cast<uint32_t>(imageInfo.m_width) << 16) / outWidth;
-    scaleY_fp = (static_cast<uint32_t>(imageInfo.m_height) << 16) / outHeight;
-    needsScaling = true;
+    if (out.sink && out.sink->onDimensions) {
+      out.sink->onDimensions(plane.outWidth, plane.outHeight);
+    }
 
-    Serial.printf("[%lu] [JPG] Pre-scaling %dx%d -> %dx%d (fit to %dx%d)\n", millis(), imageInfo.m_width,
-                  imageInfo.m_height, outWidth, outHeight, targetWidth, targetHeight);
-  }
+    plane.rowBuffer = static_cast<uint8_t*>(malloc(plane.bytesPerRow));
+    if (!plane.rowBuffer) {
+      Serial.printf("[%lu] [JPG] Failed to allocate row buffer\n", millis());
+      releasePlanes();
+      return false;
+    }
 
-  // Write BMP header with output dimensions
-  int bytesPerRow;
-  if (USE_8BIT_OUTPUT && !oneBit) {
-    writeBmpHeader8bit(bmpOut, outWidth, outHeight);
-    bytesPerRow = (outWidth + 3) / 4 * 4;
-  } else if (oneBit) {
-    writeBmpHeader1bit(bmpOut, outWidth, outHeight);
-    bytesPerRow = (outWidth + 31) / 32 * 4;  // 1 bit per pixel
-  } else {
-    writeBmpHeader2bit(bmpOut, outWidth, outHeight);
-    bytesPerRow = (outWidth * 2 + 31) / 32 * 4;
-  }
+    if (plane.needsScaling) {
+      plane.rowAccum = new uint32_t[plane.outWidth]();
+      plane.rowCount = new uint16_t[plane.outWidth]();
+    }
 
-  // Allocate row buffer
-  auto* rowBuffer = static_cast<uint8_t*>(malloc(bytesPerRow));
-  if (!rowBuffer) {
-    Serial.printf("[%lu] [JPG] Failed to allocate row buffer\n", millis());
-    return false;
+    // Ditherers work on OUTPUT dimensions (after prescaling)
+    if (out.oneBit) {
+      if (plane.outWidth <= ORDERED_DITHER_MAX_DIM && plane.outHeight <= ORDERED_DITHER_MAX_DIM) {
+        // Thumbnails and list images take the ordered-dither fast path: no error rows to
+        // carry, one compare per pixel, and the Bayer crosshatch is invisible at this scale
+        plane.bayer1BitDitherer = new Bayer1BitDitherer();
+      } else {
+        // Larger 1-bit output keeps error diffusion for quality
+        plane.atkinson1BitDitherer = new Atkinson1BitDitherer(plane.outWidth);
+      }
+    } else if (!USE_8BIT_OUTPUT && !out.fourBit) {
+      if (USE_ATKINSON) {
+        plane.atkinsonDitherer = new AtkinsonDitherer(plane.outWidth);
+      } else if (USE_FLOYD_STEINBERG) {
+        plane.fsDitherer = new FloydSteinbergDitherer(plane.outWidth);
+      }
+    }
   }
 
   // Allocate a buffer for one MCU row worth of grayscale pixels
   // This is the minimal memory needed for streaming conversion
-  const int mcuPixelHeight = imageInfo.m_MCUHeight;
-  const int mcuRowPixels = imageInfo.m_width * mcuPixelHeight;
+  // In reduce mode each 8x8 block decodes to a single DC pixel
+  const int mcuPixelHeight = reduce ? imageInfo.m_MCUHeight / 8 : imageInfo.m_MCUHeight;
+  const int mcuRowPixels = srcWidth * mcuPixelHeight;
 
   // Validate MCU row buffer size before allocation
   if (mcuRowPixels > MAX_MCU_ROW_BYTES) {
     Serial.printf("[%lu] [JPG] MCU row buffer too large (%d bytes), max: %d\n", millis(), mcuRowPixels,
                   MAX_MCU_ROW_BYTES);
-    free(rowBuffer);
+    releasePlanes();
     return false;
   }
 
   auto* mcuRowBuffer = static_cast<uint8_t*>(malloc(mcuRowPixels));
   if (!mcuRowBuffer) {
     Serial.printf("[%lu] [JPG] Failed to allocate MCU row buffer (%d bytes)\n", millis(), mcuRowPixels);
-    free(rowBuffer);
+    releasePlanes();
     return false;
   }
 
-  // Create ditherer if enabled
-  // Use OUTPUT dimensions for dithering (after prescaling)
-  AtkinsonDitherer* atkinsonDitherer = nullptr;
-  FloydSteinbergDitherer* fsDitherer = nullptr;
-  Atkinson1BitDitherer* atkinson1BitDitherer = nullptr;
-
-  if (oneBit) {
-    // For 1-bit output, use Atkinson dithering for better quality
-    atkinson1BitDitherer = new Atkinson1BitDitherer(outWidth);
-  } else if (!USE_8BIT_OUTPUT) {
-    if (USE_ATKINSON) {
-      atkinsonDitherer = new AtkinsonDitherer(outWidth);
-    } else if (USE_FLOYD_STEINBERG) {
-      fsDitherer = new FloydSteinbergDitherer(outWidth);
-    }
-  }
-
-  // For scaling: accumulate source rows into scaled output rows
-  // We need to track which source Y maps to which output Y
-  // Using fixed-point: srcY_fp = outY * scaleY_fp (gives source Y in 16.16 format)
-  uint32_t* rowAccum = nullptr;    // Accumulator for each output X (32-bit for larger sums)
-  uint16_t* rowCount = nullptr;    // Count of source pixels accumulated per output X
-  int currentOutY = 0;             // Current output row being accumulated
-  uint32_t nextOutY_srcStart = 0;  // Source Y where next output row starts (16.16 fixed point)
-
-  if (needsScaling) {
-    rowAccum = new uint32_t[outWidth]();
-    rowCount = new uint16_t[outWidth]();
-    nextOutY_srcStart = scaleY_fp;  // First boundary is at scaleY_fp (source Y for outY=1)
-  }
-
-  // Process MCUs row-by-row and write to BMP as we go (top-down)
-  const int mcuPixelWidth = imageInfo.m_MCUWidth;
+  // Process MCUs row-by-row; every decoded source row feeds all planes (top-down)
+  const int mcuPixelWidth = reduce ? imageInfo.m_MCUWidth / 8 : imageInfo.m_MCUWidth;
 
   for (int mcuY = 0; mcuY < imageInfo.m_MCUSPerCol; mcuY++) {
     // Clear the MCU row buffer
@@ -355,7 +417,7 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
                         mcuStatus);
         }
         free(mcuRowBuffer);
-        free(rowBuffer);
+        releasePlanes();
         return false;
       }
 
@@ -364,16 +426,22 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
       for (int blockY = 0; blockY < mcuPixelHeight; blockY++) {
         for (int blockX = 0; blockX < mcuPixelWidth; blockX++) {
           const int pixelX = mcuX * mcuPixelWidth + blockX;
-          if (pixelX >= imageInfo.m_width) continue;
+          if (pixelX >= srcWidth) continue;
 
           // Calculate proper block offset for picojpeg buffer
-          const int blockCol = blockX / 8;
-          const int blockRow = blockY / 8;
-          const int localX = blockX % 8;
-          const int localY = blockY % 8;
-          const int blocksPerRow = mcuPixelWidth / 8;
-          const int blockIndex = blockRow * blocksPerRow + blockCol;
-          const int pixelOffset = blockIndex * 64 + localY * 8 + localX;
+          const int blocksPerRow = imageInfo.m_MCUWidth / 8;
+          int pixelOffset;
+          if (reduce) {
+            // Reduced decode: the single DC pixel sits at each block's buffer start
+            pixelOffset = (blockY * blocksPerRow + blockX) * 64;
+          } else {
+            const int blockCol = blockX / 8;
+            const int blockRow = blockY / 8;
+            const int localX = blockX % 8;
+            const int localY = blockY % 8;
+            const int blockIndex = blockRow * blocksPerRow + blockCol;
+            pixelOffset = blockIndex * 64 + localY * 8 + localX;
+          }
 
           uint8_t gray;
           if (imageInfo.m_comps == 1) {
@@ -385,169 +453,26 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
             gray = (r * 25 + g * 50 + b * 25) / 100;
           }
 
-          mcuRowBuffer[blockY * imageInfo.m_width + pixelX] = gray;
+          mcuRowBuffer[blockY * srcWidth + pixelX] = gray;
         }
       }
     }
 
-    // Process source rows from this MCU row
+    // Feed the source rows from this MCU row to every plane
     const int startRow = mcuY * mcuPixelHeight;
     const int endRow = (mcuY + 1) * mcuPixelHeight;
 
-    for (int y = startRow; y < endRow && y < imageInfo.m_height; y++) {
-      const int bufferY = y - startRow;
-
-      if (!needsScaling) {
-        // No scaling - direct output (1:1 mapping)
-        memset(rowBuffer, 0, bytesPerRow);
-
-        if (USE_8BIT_OUTPUT && !oneBit) {
-          for (int x = 0; x < outWidth; x++) {
-            const uint8_t gray = mcuRowBuffer[bufferY * imageInfo.m_width + x];
-            rowBuffer[x] = adjustPixel(gray);
-          }
-        } else if (oneBit) {
-          // 1-bit output with Atkinson dithering for better quality
-          for (int x = 0; x < outWidth; x++) {
-            const uint8_t gray = mcuRowBuffer[bufferY * imageInfo.m_width + x];
-            const uint8_t bit =
-                atkinson1BitDitherer ? atkinson1BitDitherer->processPixel(gray, x) : quantize1bit(gray, x, y);
-            // Pack 1-bit value: MSB first, 8 pixels per byte
-            const int byteIndex = x / 8;
-            const int bitOffset = 7 - (x % 8);
-            rowBuffer[byteIndex] |= (bit << bitOffset);
-          }
-          if (atkinson1BitDitherer) atkinson1BitDitherer->nextRow();
-        } else {
-          // 2-bit output
-          for (int x = 0; x < outWidth; x++) {
-            const uint8_t gray = adjustPixel(mcuRowBuffer[bufferY * imageInfo.m_width + x]);
-            uint8_t twoBit;
-            if (atkinsonDitherer) {
-              twoBit = atkinsonDitherer->processPixel(gray, x);
-            } else if (fsDitherer) {
-              twoBit = fsDitherer->processPixel(gray, x);
-            } else {
-              twoBit = quantize(gray, x, y);
-            }
-            const int byteIndex = (x * 2) / 8;
-            const int bitOffset = 6 - ((x * 2) % 8);
-            rowBuffer[byteIndex] |= (twoBit << bitOffset);
-          }
-          if (atkinsonDitherer)
-            atkinsonDitherer->nextRow();
-          else if (fsDitherer)
-            fsDitherer->nextRow();
-        }
-        bmpOut.write(rowBuffer, bytesPerRow);
-      } else {
-        // Fixed-point area averaging for exact fit scaling
-        // For each output pixel X, accumulate source pixels that map to it
-        // srcX range for outX: [outX * scaleX_fp >> 16, (outX+1) * scaleX_fp >> 16)
-        const uint8_t* srcRow = mcuRowBuffer + bufferY * imageInfo.m_width;
-
-        for (int outX = 0; outX < outWidth; outX++) {
-          // Calculate source X range for this output pixel
-          const int srcXStart = (static_cast<uint32_t>(outX) * scaleX_fp) >> 16;
-          const int srcXEnd = (static_cast<uint32_t>(outX + 1) * scaleX_fp) >> 16;
-
-          // Accumulate all source pixels in this range
-          int sum = 0;
-          int count = 0;
-          for (int srcX = srcXStart; srcX < srcXEnd && srcX < imageInfo.m_width; srcX++) {
-            sum += srcRow[srcX];
-            count++;
-          }
-
-          // Handle edge case: if no pixels in range, use nearest
-          if (count == 0 && srcXStart < imageInfo.m_width) {
-            sum = srcRow[srcXStart];
-            count = 1;
-          }
-
-          rowAccum[outX] += sum;
-          rowCount[outX] += count;
-        }
-
-        // Check if we've crossed into the next output row
-        // Current source Y in fixed point: y << 16
-        const uint32_t srcY_fp = static_cast<uint32_t>(y + 1) << 16;
-
-        // Output row when source Y crosses the boundary
-        if (srcY_fp >= nextOutY_srcStart && currentOutY < outHeight) {
-          memset(rowBuffer, 0, bytesPerRow);
-
-          if (USE_8BIT_OUTPUT && !oneBit) {
-            for (int x = 0; x < outWidth; x++) {
-              const uint8_t gray = (rowCount[x] > 0) ? (rowAccum[x] / rowCount[x]) : 0;
-              rowBuffer[x] = adjustPixel(gray);
-            }
-          } else if (oneBit) {
-            // 1-bit output with Atkinson dithering for better quality
-            for (int x = 0; x < outWidth; x++) {
-              const uint8_t gray = (rowCount[x] > 0) ? (rowAccum[x] / rowCount[x]) : 0;
-              const uint8_t bit = atkinson1BitDitherer ? atkinson1BitDitherer->processPixel(gray, x)
-                                                       : quantize1bit(gray, x, currentOutY);
-              // Pack 1-bit value: MSB first, 8 pixels per byte
-              const int byteIndex = x / 8;
-              const int bitOffset = 7 - (x % 8);
-              rowBuffer[byteIndex] |= (bit << bitOffset);
-            }
-            if (atkinson1BitDitherer) atkinson1BitDitherer->nextRow();
-          } else {
-            // 2-bit output
-            for (int x = 0; x < outWidth; x++) {
-              const uint8_t gray = adjustPixel((rowCount[x] > 0) ? (rowAccum[x] / rowCount[x]) : 0);
-              uint8_t twoBit;
-              if (atkinsonDitherer) {
-                twoBit = atkinsonDitherer->processPixel(gray, x);
-              } else if (fsDitherer) {
-                twoBit = fsDitherer->processPixel(gray, x);
-              } else {
-                twoBit = quantize(gray, x, currentOutY);
-              }
-              const int byteIndex = (x * 2) / 8;
-              const int bitOffset = 6 - ((x * 2) % 8);
-              rowBuffer[byteIndex] |= (twoBit << bitOffset);
-            }
-            if (atkinsonDitherer)
-              atkinsonDitherer->nextRow();
-            else if (fsDitherer)
-              fsDitherer->nextRow();
-          }
-
-          bmpOut.write(rowBuffer, bytesPerRow);
-          currentOutY++;
-
-          // Reset accumulators for next output row
-          memset(rowAccum, 0, outWidth * sizeof(uint32_t));
-          memset(rowCount, 0, outWidth * sizeof(uint16_t));
-
-          // Update boundary for next output row
-          nextOutY_srcStart = static_cast<uint32_t>(currentOutY + 1) * scaleY_fp;
-        }
+    for (int y = startRow; y < endRow && y < srcHeight; y++) {
+      const uint8_t* srcRow = mcuRowBuffer + (y - startRow) * srcWidth;
+      for (int p = 0; p < outputCount; p++) {
+        feedSourceRow(planes[p], srcRow, srcWidth, y);
       }
     }
   }
 
   // Clean up
-  if (rowAccum) {
-    delete[] rowAccum;
-  }
-  if (rowCount) {
-    delete[] rowCount;
-  }
-  if (atkinsonDitherer) {
-    delete atkinsonDitherer;
-  }
-  if (fsDitherer) {
-    delete fsDitherer;
-  }
-  if (atkinson1BitDitherer) {
-    delete atkinson1BitDitherer;
-  }
   free(mcuRowBuffer);
-  free(rowBuffer);
+  releasePlanes();
 
   Serial.printf("[%lu] [JPG] Successfully converted JPEG to BMP\n", millis());
   return true;
@@ -555,17 +480,65 @@ bool JpegToBmpConverter::jpegFileToBmpStreamInternal(FsFile& jpegFile, Print& bm
 
 // Core function: Convert JPEG file to 2-bit BMP (uses default target size)
 bool JpegToBmpConverter::jpegFileToBmpStream(FsFile& jpegFile, Print& bmpOut, bool crop) {
-  return jpegFileToBmpStreamInternal(jpegFile, bmpOut, TARGET_MAX_WIDTH, TARGET_MAX_HEIGHT, false, crop);
+  Output out;
+  out.bmpOut = &bmpOut;
+  out.targetMaxWidth = COVER_TARGET_WIDTH;
+  out.targetMaxHeight = COVER_TARGET_HEIGHT;
+  out.crop = crop;
+  return jpegFileToBmpStreams(jpegFile, &out, 1);
+}
+
+// Convert to a 4-bit grayscale BMP at display size: the cover cache variant, holding raw
+// tones that the Bitmap reader tone-maps to panel levels at blit time
+bool JpegToBmpConverter::jpegFileTo4BitBmpStream(FsFile& jpegFile, Print& bmpOut, bool crop) {
+  Output out;
+  out.bmpOut = &bmpOut;
+  out.targetMaxWidth = COVER_TARGET_WIDTH;
+  out.targetMaxHeight = COVER_TARGET_HEIGHT;
+  out.fourBit = true;
+  out.crop = crop;
+  return jpegFileToBmpStreams(jpegFile, &out, 1);
 }
 
 // Convert with custom target size (for thumbnails, 2-bit)
 bool JpegToBmpConverter::jpegFileToBmpStreamWithSize(FsFile& jpegFile, Print& bmpOut, int targetMaxWidth,
                                                      int targetMaxHeight) {
-  return jpegFileToBmpStreamInternal(jpegFile, bmpOut, targetMaxWidth, targetMaxHeight, false);
+  Output out;
+  out.bmpOut = &bmpOut;
+  out.targetMaxWidth = targetMaxWidth;
+  out.targetMaxHeight = targetMaxHeight;
+  return jpegFileToBmpStreams(jpegFile, &out, 1);
 }
 
 // Convert to 1-bit BMP (black and white only, no grays) for fast home screen rendering
 bool JpegToBmpConverter::jpegFileTo1BitBmpStreamWithSize(FsFile& jpegFile, Print& bmpOut, int targetMaxWidth,
                                                          int targetMaxHeight) {
-  return jpegFileToBmpStreamInternal(jpegFile, bmpOut, targetMaxWidth, targetMaxHeight, true);
+  Output out;
+  out.bmpOut = &bmpOut;
+  out.targetMaxWidth = targetMaxWidth;
+  out.targetMaxHeight = targetMaxHeight;
+  out.oneBit = true;
+  return jpegFileToBmpStreams(jpegFile, &out, 1);
+}
+
+// Decode straight to a row sink at display size, optionally teeing the BMP to bmpOut so the
+// on-disk cache can be populated in the same pass
+bool JpegToBmpConverter::jpegFileToBmpStreamWithSink(FsFile& jpegFile, Print* bmpOut, const RowSink& sink, bool crop) {
+  Output out;
+  out.bmpOut = bmpOut;
+  out.sink = &sink;
+  out.targetMaxWidth = COVER_TARGET_WIDTH;
+  out.targetMaxHeight = COVER_TARGET_HEIGHT;
+  out.crop = crop;
+  return jpegFileToBmpStreams(jpegFile, &out, 1);
+}
+
+// Decode straight to a row sink at a custom fit-to size, with no BMP written anywhere
+bool JpegToBmpConverter::jpegFileToSinkWithSize(FsFile& jpegFile, const RowSink& sink, int targetMaxWidth,
+                                                int targetMaxHeight) {
+  Output out;
+  out.sink = &sink;
+  out.targetMaxWidth = targetMaxWidth;
+  out.targetMaxHeight = targetMaxHeight;
+  return jpegFileToBmpStreams(jpegFile, &out, 1);
 }
@@ -1,19 +1,61 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+
 class FsFile;
 class Print;
 class ZipFile;
 
 class JpegToBmpConverter {
-  static unsigned char jpegReadCallback(unsigned char* pBuf, unsigned char buf_size,
-                                        unsigned char* pBytes_actually_read, void* pCallback_data);
-  static bool jpegFileToBmpStreamInternal(class FsFile& jpegFile, Print& bmpOut, int targetWidth, int targetHeight,
-                                          bool oneBit, bool crop = true);
-
  public:
+  // Direct-to-renderer sink: receives each output row as it decodes, after scaling and
+  // dithering, top-down. Rows are packed at 2 bits per pixel MSB-first (the same layout
+  // Bitmap::readNextRow produces), so callers can blit them straight to the display and skip
+  // the BMP round-trip through the SD card.
+  struct RowSink {
+    std::function<void(int width, int height)> onDimensions;
+    std::function<void(int y, const uint8_t* packedRow, int widthPixels)> onRow;
+  };
+
+  // One output variant of a combined decode: its own target size, bit depth, fit/crop policy
+  // and destinations (either destination may be null)
+  struct Output {
+    Print* bmpOut = nullptr;
+    const RowSink* sink = nullptr;
+    int targetMaxWidth = 0;
+    int targetMaxHeight = 0;
+    bool oneBit = false;   // 1-bit output (thumbnails) instead of 2-bit
+    bool fourBit = false;  // 4-bit grayscale output (cover caches, tone-mapped at blit time)
+    bool crop = false;     // Scale to fill the target (caller crops the overhang) instead of fit
+  };
+
+  // Display-size target used by the cover conversions (portrait panel size)
+  static constexpr int COVER_TARGET_WIDTH = 480;
+  static constexpr int COVER_TARGET_HEIGHT = 800;
+
   static bool jpegFileToBmpStream(FsFile& jpegFile, Print& bmpOut, bool crop = true);
+  // Convert to a 4-bit grayscale BMP at display size (the cover cache variant). Stores 16 raw
+  // tone levels instead of pre-dithered panel values; Bitmap folds the nibble-to-panel-level
+  // mapping into a LUT at blit time, so displaying stays cheap while the file keeps enough
+  // tone for the grayscale sleep-screen passes
+  static bool jpegFileTo4BitBmpStream(FsFile& jpegFile, Print& bmpOut, bool crop = true);
   // Convert with custom target size (for thumbnails)
   static bool jpegFileToBmpStreamWithSize(FsFile& jpegFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight);
   // Convert to 1-bit BMP (black and white only, no grays) for fast home screen rendering
   static bool jpegFileTo1BitBmpStreamWithSize(FsFile& jpegFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight);
+  // Decode to a row sink, optionally teeing the BMP to bmpOut at the same time (pass nullptr to
+  // skip the file entirely). Uses the display-size target like jpegFileToBmpStream.
+  static bool jpegFileToBmpStreamWithSink(FsFile& jpegFile, Print* bmpOut, const RowSink& sink, bool crop = true);
+  // Decode to a row sink at a caller-chosen target size with no BMP output (for inline chapter
+  // images, where the rows are captured rather than cached as a BMP)
+  static bool jpegFileToSinkWithSize(FsFile& jpegFile, const RowSink& sink, int targetMaxWidth, int targetMaxHeight);
+  // Decode the JPEG once and emit every requested variant (different scales, crops and bit
+  // depths) from the same MCU-row stream; the cover / cropped-cover / thumbnail trio shares a
+  // single decode this way instead of paying one each
+  static bool jpegFileToBmpStreams(FsFile& jpegFile, const Output* outputs, int outputCount);
+
+ private:
+  static unsigned char jpegReadCallback(unsigned char* pBuf, unsigned char buf_size,
+                                        unsigned char* pBytes_actually_read, void* pCallback_data);
 };
@@ -0,0 +1,554 @@
+#include "PngToBmpConverter.h"
+
+#include <HardwareSerial.h>
+#include <SdFat.h>
+#include <miniz.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include "BitmapHelpers.h"
+#include "BmpWriter.h"
+
+namespace {
+// Same display-fit targets and dither selection as the JPEG converter
+constexpr int TARGET_MAX_WIDTH = 480;
+constexpr int TARGET_MAX_HEIGHT = 800;
+constexpr int ORDERED_DITHER_MAX_DIM = 400;
+
+// Same safety caps as the JPEG path. There is no PNG equivalent of picojpeg's DC-only reduced
+// decode, so oversized images are rejected outright.
+constexpr int MAX_IMAGE_WIDTH = 2048;
+constexpr int MAX_IMAGE_HEIGHT = 3072;
+
+constexpr uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+// PNG color types
+constexpr uint8_t COLOR_GRAY = 0;
+constexpr uint8_t COLOR_RGB = 2;
+constexpr uint8_t COLOR_PALETTE = 3;
+constexpr uint8_t COLOR_GRAY_ALPHA = 4;
+constexpr uint8_t COLOR_RGBA = 6;
+
+bool readBe32(FsFile& file, uint32_t& value) {
+  uint8_t b[4];
+  if (file.read(b, 4) != 4) {
+    return false;
+  }
+  value = (static_cast<uint32_t>(b[0]) << 24) | (static_cast<uint32_t>(b[1]) << 16) |
+          (static_cast<uint32_t>(b[2]) << 8) | b[3];
+  return true;
+}
+
+// Pulls decompressed IDAT bytes through miniz one scanline's worth at a time. Mirrors
+// ZipInflateStream's circular-dictionary pattern, with two differences: the compressed bytes
+// arrive split across consecutive IDAT chunks (each with its own length and trailing CRC),
+// and the stream is zlib-wrapped rather than raw deflate.
+class PngIdatReader {
+  FsFile& file;
+  tinfl_decompressor* inflator = nullptr;
+  uint8_t* dictBuffer = nullptr;  // TINFL_LZ_DICT_SIZE circular output window
+  uint8_t inBuffer[512];
+  size_t inFilled = 0;
+  size_t inCursor = 0;
+  size_t chunkRemaining;     // compressed bytes left in the current IDAT chunk
+  bool noMoreChunks = false;
+  size_t dictCursor = 0;
+  size_t pendingStart = 0;  // decompressed-but-undelivered bytes in the dictionary
+  size_t pendingBytes = 0;
+  bool inflateDone = false;
+
+  // Refills the input buffer, hopping the CRC + header between consecutive IDAT chunks.
+  // Returns false when the IDAT sequence is exhausted.
+  bool fillInput() {
+    if (inCursor < inFilled) {
+      return true;
+    }
+    while (chunkRemaining == 0) {
+      if (noMoreChunks) {
+        return false;
+      }
+      file.seekCur(4);  // this chunk's CRC
+      uint32_t length;
+      uint8_t type[4];
+      if (!readBe32(file, length) || file.read(type, 4) != 4 || memcmp(type, "IDAT", 4) != 0) {
+        // IEND (or anything else) ends the compressed stream
+        noMoreChunks = true;
+        return false;
+      }
+      chunkRemaining = length;
+    }
+    const size_t toRead = chunkRemaining < sizeof(inBuffer) ? chunkRemaining : sizeof(inBuffer);
+    inFilled = file.read(inBuffer, toRead);
+    inCursor = 0;
+    if (inFilled == 0) {
+      noMoreChunks = true;
+      return false;
+    }
+    chunkRemaining -= inFilled;
+    return true;
+  }
+
+  bool inflateStep() {
+    // A final zero-input call with the more-input flag clear lets the decompressor flush its
+    // buffered tail and report DONE, so running out of chunks is not itself a failure
+    const bool haveInput = fillInput();
+
+    size_t inBytes = haveInput ? inFilled - inCursor : 0;
+    size_t outBytes = TINFL_LZ_DICT_SIZE - dictCursor;
+    const tinfl_status status =
+        tinfl_decompress(inflator, inBuffer + inCursor, &inBytes, dictBuffer, dictBuffer + dictCursor, &outBytes,
+                         TINFL_FLAG_PARSE_ZLIB_HEADER | (noMoreChunks ? 0 : TINFL_FLAG_HAS_MORE_INPUT));
+    inCursor += inBytes;
+
+    if (outBytes > 0) {
+      pendingStart = dictCursor;
+      pendingBytes = outBytes;
+      dictCursor = (dictCursor + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+    }
+
+    if (status == TINFL_STATUS_DONE) {
+      inflateDone = true;
+    } else if (status < TINFL_STATUS_DONE) {
+      Serial.printf("[%lu] [PNG] Inflate failed with status %d\n", millis(), status);
+      return false;
+    } else if (!haveInput && outBytes == 0) {
+      Serial.printf("[%lu] [PNG] Compressed stream ended prematurely\n", millis());
+      return false;
+    }
+    return true;
+  }
+
+ public:
+  PngIdatReader(FsFile& file, const size_t firstChunkLength) : file(file), chunkRemaining(firstChunkLength) {}
+
+  ~PngIdatReader() {
+    if (inflator) free(inflator);
+    if (dictBuffer) free(dictBuffer);
+  }
+
+  PngIdatReader(const PngIdatReader&) = delete;
+  PngIdatReader& operator=(const PngIdatReader&) = delete;
+
+  bool init() {
+    inflator = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
+    dictBuffer = static_cast<uint8_t*>(malloc(TINFL_LZ_DICT_SIZE));
+    if (!inflator || !dictBuffer) {
+      Serial.printf("[%lu] [PNG] Failed to allocate inflate buffers\n", millis());
+      return false;
+    }
+    memset(inflator, 0, sizeof(tinfl_decompressor));
+    tinfl_init(inflator);
+    return true;
+  }
+
+  // Reads exactly len decompressed bytes; anything less is a truncated or corrupt stream
+  bool readFully(uint8_t* buf, const size_t len) {
+    size_t copied = 0;
+    while (copied < len) {
+      if (pendingBytes > 0) {
+        const size_t take = pendingBytes < len - copied ? pendingBytes : len - copied;
+        memcpy(buf + copied, dictBuffer + pendingStart, take);
+        pendingStart += take;
+        pendingBytes -= take;
+        copied += take;
+        continue;
+      }
+      if (inflateDone || !inflateStep()) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+int paeth(const int a, const int b, const int c) {
+  const int p = a + b - c;
+  const int pa = abs(p - a);
+  const int pb = abs(p - b);
+  const int pc = abs(p - c);
+  if (pa <= pb && pa <= pc) return a;
+  if (pb <= pc) return b;
+  return c;
+}
+
+// Reverses the scanline filter in place; prevRow is the unfiltered previous scanline (all
+// zeroes for the first), bpp the bytes per pixel
+bool unfilterRow(const uint8_t filter, uint8_t* row, const uint8_t* prevRow, const size_t rowBytes, const int bpp) {
+  switch (filter) {
+    case 0:  // None
+      return true;
+    case 1:  // Sub
+      for (size_t i = bpp; i < rowBytes; i++) row[i] += row[i - bpp];
+      return true;
+    case 2:  // Up
+      for (size_t i = 0; i < rowBytes; i++) row[i] += prevRow[i];
+      return true;
+    case 3:  // Average
+      for (size_t i = 0; i < static_cast<size_t>(bpp) && i < rowBytes; i++) row[i] += prevRow[i] / 2;
+      for (size_t i = bpp; i < rowBytes; i++) row[i] += (row[i - bpp] + prevRow[i]) / 2;
+      return true;
+    case 4:  // Paeth
+      for (size_t i = 0; i < static_cast<size_t>(bpp) && i < rowBytes; i++) row[i] += paeth(0, prevRow[i], 0);
+      for (size_t i = bpp; i < rowBytes; i++) row[i] += paeth(row[i - bpp], prevRow[i], prevRow[i - bpp]);
+      return true;
+    default:
+      Serial.printf("[%lu] [PNG] Unknown scanline filter %u\n", millis(), filter);
+      return false;
+  }
+}
+
+// Collapses one unfiltered scanline to 8-bit grayscale, compositing alpha over white (covers
+// render on white paper). Same RGB weights as the JPEG converter.
+void rowToGray(const uint8_t* row, uint8_t* gray, const int width, const uint8_t colorType,
+               const uint8_t* paletteGray) {
+  switch (colorType) {
+    case COLOR_GRAY:
+      memcpy(gray, row, width);
+      break;
+    case COLOR_RGB:
+      for (int x = 0; x < width; x++) {
+        const uint8_t* px = row + x * 3;
+        gray[x] = (px[0] * 25 + px[1] * 50 + px[2] * 25) / 100;
+      }
+      break;
+    case COLOR_PALETTE:
+      for (int x = 0; x < width; x++) gray[x] = paletteGray[row[x]];
+      break;
+    case COLOR_GRAY_ALPHA:
+      for (int x = 0; x < width; x++) {
+        const uint8_t* px = row + x * 2;
+        gray[x] = (px[0] * px[1] + 255 * (255 - px[1])) / 255;
+      }
+      break;
+    case COLOR_RGBA:
+    default:
+      for (int x = 0; x < width; x++) {
+        const uint8_t* px = row + x * 4;
+        const uint8_t g = (px[0] * 25 + px[1] * 50 + px[2] * 25) / 100;
+        gray[x] = (g * px[3] + 255 * (255 - px[3])) / 255;
+      }
+      break;
+  }
+}
+}  // namespace
+
+bool PngToBmpConverter::pngFileToBmpStreamInternal(FsFile& pngFile, Print* bmpOut, int targetWidth, int targetHeight,
+                                                   const bool oneBit, const bool fourBit, const bool crop,
+                                                   const RowSink* sink) {
+  Serial.printf("[%lu] [PNG] Converting PNG to %s BMP (target: %dx%d)\n", millis(),
+                oneBit ? "1-bit" : fourBit ? "4-bit" : "2-bit", targetWidth, targetHeight);
+
+  uint8_t signature[8];
+  if (pngFile.read(signature, 8) != 8 || memcmp(signature, PNG_SIGNATURE, 8) != 0) {
+    Serial.printf("[%lu] [PNG] Not a PNG file\n", millis());
+    return false;
+  }
+
+  // Walk the chunk list up to the first IDAT, picking up IHDR and the palette on the way
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint8_t bitDepth = 0;
+  uint8_t colorType = 0;
+  bool haveIhdr = false;
+  uint8_t paletteGray[256];
+  memset(paletteGray, 0, sizeof(paletteGray));
+  size_t firstIdatLength = 0;
+
+  while (true) {
+    uint32_t length;
+    uint8_t type[4];
+    if (!readBe32(pngFile, length) || pngFile.read(type, 4) != 4) {
+      Serial.printf("[%lu] [PNG] Truncated chunk stream\n", millis());
+      return false;
+    }
+
+    if (memcmp(type, "IHDR", 4) == 0) {
+      uint8_t ihdr[13];
+      if (length != 13 || pngFile.read(ihdr, 13) != 13) {
+        Serial.printf("[%lu] [PNG] Bad IHDR\n", millis());
+        return false;
+      }
+      width = (static_cast<uint32_t>(ihdr[0]) << 24) | (ihdr[1] << 16) | (ihdr[2] << 8) | ihdr[3];
+      height = (static_cast<uint32_t>(ihdr[4]) << 24) | (ihdr[5] << 16) | (ihdr[6] << 8) | ihdr[7];
+      bitDepth = ihdr[8];
+      colorType = ihdr[9];
+      const uint8_t interlace = ihdr[12];
+      haveIhdr = true;
+
+      if (interlace != 0) {
+        Serial.printf("[%lu] [PNG] Adam7 interlaced PNG not supported (needs full-image buffer)\n", millis());
+        return false;
+      }
+      if (bitDepth != 8 || (colorType != COLOR_GRAY && colorType != COLOR_RGB && colorType != COLOR_PALETTE &&
+                            colorType != COLOR_GRAY_ALPHA && colorType != COLOR_RGBA)) {
+        Serial.printf("[%lu] [PNG] Unsupported format (bit depth %u, color type %u)\n", millis(), bitDepth, colorType);
+        return false;
+      }
+      if (width == 0 || height == 0 ||
+          (static_cast<int>(width) > MAX_IMAGE_WIDTH || static_cast<int>(height) > MAX_IMAGE_HEIGHT)) {
+        Serial.printf("[%lu] [PNG] Image too large (%ux%u), max supported: %dx%d\n", millis(), width, height,
+                      MAX_IMAGE_WIDTH, MAX_IMAGE_HEIGHT);
+        return false;
+      }
+      pngFile.seekCur(4);  // CRC
+    } else if (memcmp(type, "PLTE", 4) == 0) {
+      uint8_t rgb[3];
+      const uint32_t paletteEntries = length / 3 < 256 ? length / 3 : 256;
+      for (uint32_t i = 0; i < paletteEntries; i++) {
+        if (pngFile.read(rgb, 3) != 3) {
+          Serial.printf("[%lu] [PNG] Truncated palette\n", millis());
+          return false;
+        }
+        paletteGray[i] = (rgb[0] * 25 + rgb[1] * 50 + rgb[2] * 25) / 100;
+      }
+      pngFile.seekCur(length - paletteEntries * 3 + 4);  // leftover entries + CRC
+    } else if (memcmp(type, "IDAT", 4) == 0) {
+      firstIdatLength = length;
+      break;
+    } else if (memcmp(type, "IEND", 4) == 0) {
+      Serial.printf("[%lu] [PNG] No IDAT before IEND\n", millis());
+      return false;
+    } else {
+      pngFile.seekCur(length + 4);  // ancillary chunk + CRC
+    }
+  }
+
+  if (!haveIhdr) {
+    Serial.printf("[%lu] [PNG] IDAT before IHDR\n", millis());
+    return false;
+  }
+
+  const int channels = colorType == COLOR_RGB          ? 3
+                       : colorType == COLOR_GRAY_ALPHA ? 2
+                       : colorType == COLOR_RGBA       ? 4
+                                                       : 1;
+
+  Serial.printf("[%lu] [PNG] PNG dimensions: %ux%u, color type: %u\n", millis(), width, height, colorType);
+
+  // Calculate output dimensions (pre-scale to fit display exactly) - same fixed-point area
+  // averaging as the JPEG converter
+  const int srcWidth = static_cast<int>(width);
+  const int srcHeight = static_cast<int>(height);
+  int outWidth = srcWidth;
+  int outHeight = srcHeight;
+  uint32_t scaleX_fp = 65536;
+  uint32_t scaleY_fp = 65536;
+  bool needsScaling = false;
+
+  if (targetWidth > 0 && targetHeight > 0 && (srcWidth > targetWidth || srcHeight > targetHeight)) {
+    const float scaleToFitWidth = static_cast<float>(targetWidth) / srcWidth;
+    const float scaleToFitHeight = static_cast<float>(targetHeight) / srcHeight;
+    float scale;
+    if (crop) {  // if we will crop, scale to the smaller dimension
+      scale = (scaleToFitWidth > scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
+    } else {  // else, scale to the larger dimension to fit
+      scale = (scaleToFitWidth < scaleToFitHeight) ? scaleToFitWidth : scaleToFitHeight;
+    }
+
+    outWidth = static_cast<int>(srcWidth * scale);
+    outHeight = static_cast<int>(srcHeight * scale);
+    if (outWidth < 1) outWidth = 1;
+    if (outHeight < 1) outHeight = 1;
+
+    scaleX_fp = (static_cast<uint32_t>(srcWidth) << 16) / outWidth;
+    scaleY_fp = (static_cast<uint32_t>(srcHeight) << 16) / outHeight;
+    needsScaling = true;
+
+    Serial.printf("[%lu] [PNG] Pre-scaling %dx%d -> %dx%d (fit to %dx%d)\n", millis(), srcWidth, srcHeight, outWidth,
+                  outHeight, targetWidth, targetHeight);
+  }
+
+  // Write BMP header with output dimensions
+  int bytesPerRow;
+  if (oneBit) {
+    if (bmpOut) writeBmpHeader1bit(*bmpOut, outWidth, outHeight);
+    bytesPerRow = (outWidth + 31) / 32 * 4;  // 1 bit per pixel
+  } else if (fourBit) {
+    if (bmpOut) writeBmpHeader4bit(*bmpOut, outWidth, outHeight);
+    bytesPerRow = (outWidth * 4 + 31) / 32 * 4;
+  } else {
+    if (bmpOut) writeBmpHeader2bit(*bmpOut, outWidth, outHeight);
+    bytesPerRow = (outWidth * 2 + 31) / 32 * 4;
+  }
+
+  if (sink && sink->onDimensions) {
+    sink->onDimensions(outWidth, outHeight);
+  }
+
+  PngIdatReader idat(pngFile, firstIdatLength);
+  if (!idat.init()) {
+    return false;
+  }
+
+  // Scanline working set: the current and previous raw scanlines for unfiltering, one
+  // grayscale source row, and one packed output row
+  const size_t rawRowBytes = static_cast<size_t>(srcWidth) * channels;
+  auto* curRow = static_cast<uint8_t*>(malloc(rawRowBytes));
+  auto* prevRow = static_cast<uint8_t*>(calloc(rawRowBytes, 1));
+  auto* grayRow = static_cast<uint8_t*>(malloc(srcWidth));
+  auto* rowBuffer = static_cast<uint8_t*>(malloc(bytesPerRow));
+  // Averaged source pixels for the output row being accumulated (scaling only)
+  uint8_t* outGrayRow = nullptr;
+  uint32_t* rowAccum = nullptr;
+  uint16_t* rowCount = nullptr;
+  if (needsScaling) {
+    outGrayRow = static_cast<uint8_t*>(malloc(outWidth));
+    rowAccum = new uint32_t[outWidth]();
+    rowCount = new uint16_t[outWidth]();
+  }
+
+  AtkinsonDitherer* atkinsonDitherer = nullptr;
+  Atkinson1BitDitherer* atkinson1BitDitherer = nullptr;
+  Bayer1BitDitherer* bayer1BitDitherer = nullptr;
+  if (oneBit) {
+    if (outWidth <= ORDERED_DITHER_MAX_DIM && outHeight <= ORDERED_DITHER_MAX_DIM) {
+      bayer1BitDitherer = new Bayer1BitDitherer();
+    } else {
+      atkinson1BitDitherer = new Atkinson1BitDitherer(outWidth);
+    }
+  } else if (!fourBit) {
+    atkinsonDitherer = new AtkinsonDitherer(outWidth);
+  }
+
+  const auto cleanup = [&] {
+    free(curRow);
+    free(prevRow);
+    free(grayRow);
+    free(rowBuffer);
+    free(outGrayRow);
+    delete[] rowAccum;
+    delete[] rowCount;
+    delete atkinsonDitherer;
+    delete atkinson1BitDitherer;
+    delete bayer1BitDitherer;
+  };
+
+  if (!curRow || !prevRow || !grayRow || !rowBuffer || (needsScaling && (!outGrayRow || !rowAccum || !rowCount))) {
+    Serial.printf("[%lu] [PNG] Failed to allocate scanline buffers\n", millis());
+    cleanup();
+    return false;
+  }
+
+  // Dither, pack and emit one outWidth-wide grayscale row
+  const auto outputRow = [&](const uint8_t* gray, const int outY) {
+    memset(rowBuffer, 0, bytesPerRow);
+    if (oneBit) {
+      PackedRowWriter packer(rowBuffer, 1);
+      for (int x = 0; x < outWidth; x++) {
+        packer.push(bayer1BitDitherer ? bayer1BitDitherer->processPixel(gray[x], x)
+                                      : atkinson1BitDitherer->processPixel(gray[x], x));
+      }
+      packer.flush();
+      if (bayer1BitDitherer) bayer1BitDitherer->nextRow();
+      if (atkinson1BitDitherer) atkinson1BitDitherer->nextRow();
+    } else if (fourBit) {
+      // Raw 16-level tones, same contract as the JPEG converter's 4-bit planes: the panel
+      // tone mapping happens at blit time
+      PackedRowWriter packer(rowBuffer, 4);
+      for (int x = 0; x < outWidth; x++) {
+        packer.push(static_cast<uint8_t>((gray[x] * 15 + 127) / 255));
+      }
+      packer.flush();
+    } else {
+      PackedRowWriter packer(rowBuffer, 2);
+      for (int x = 0; x < outWidth; x++) {
+        packer.push(atkinsonDitherer->processPixel(adjustPixel(gray[x]), x));
+      }
+      packer.flush();
+      atkinsonDitherer->nextRow();
+    }
+    if (bmpOut) bmpOut->write(rowBuffer, bytesPerRow);
+    if (sink && sink->onRow) sink->onRow(outY, rowBuffer, outWidth);
+  };
+
+  int currentOutY = 0;
+  uint32_t nextOutY_srcStart = scaleY_fp;  // First boundary is at scaleY_fp (source Y for outY=1)
+
+  for (int y = 0; y < srcHeight; y++) {
+    uint8_t filter;
+    if (!idat.readFully(&filter, 1) || !idat.readFully(curRow, rawRowBytes)) {
+      Serial.printf("[%lu] [PNG] Truncated image data at row %d\n", millis(), y);
+      cleanup();
+      return false;
+    }
+    if (!unfilterRow(filter, curRow, prevRow, rawRowBytes, channels)) {
+      cleanup();
+      return false;
+    }
+    rowToGray(curRow, grayRow, srcWidth, colorType, paletteGray);
+
+    if (!needsScaling) {
+      outputRow(grayRow, y);
+    } else {
+      // Accumulate this source row into the current output row (word-at-a-time span sums,
+      // carrying the range end forward like the JPEG path)
+      int srcXStart = 0;
+      for (int outX = 0; outX < outWidth; outX++) {
+        int srcXEnd = (static_cast<uint32_t>(outX + 1) * scaleX_fp) >> 16;
+        if (srcXEnd > srcWidth) srcXEnd = srcWidth;
+
+        int sum;
+        int count = srcXEnd - srcXStart;
+        if (count > 0) {
+          sum = sumPixelSpan(grayRow, srcXStart, srcXEnd);
+        } else if (srcXStart < srcWidth) {
+          sum = grayRow[srcXStart];
+          count = 1;
+        } else {
+          sum = 0;
+          count = 0;
+        }
+
+        rowAccum[outX] += sum;
+        rowCount[outX] += count;
+        if (srcXEnd > srcXStart) srcXStart = srcXEnd;
+      }
+
+      // Output row when source Y crosses the boundary
+      const uint32_t srcY_fp = static_cast<uint32_t>(y + 1) << 16;
+      if (srcY_fp >= nextOutY_srcStart && currentOutY < outHeight) {
+        for (int x = 0; x < outWidth; x++) {
+          outGrayRow[x] = (rowCount[x] > 0) ? (rowAccum[x] / rowCount[x]) : 0;
+        }
+        outputRow(outGrayRow, currentOutY);
+        currentOutY++;
+        memset(rowAccum, 0, outWidth * sizeof(uint32_t));
+        memset(rowCount, 0, outWidth * sizeof(uint16_t));
+        nextOutY_srcStart = static_cast<uint32_t>(currentOutY + 1) * scaleY_fp;
+      }
+    }
+
+    // The unfiltered row becomes the predictor for the next one
+    uint8_t* swap = prevRow;
+    prevRow = curRow;
+    curRow = swap;
+  }
+
+  cleanup();
+  Serial.printf("[%lu] [PNG] Successfully converted PNG to BMP\n", millis());
+  return true;
+}
+
+// Core function: Convert PNG file to 2-bit BMP (uses default target size)
+bool PngToBmpConverter::pngFileToBmpStream(FsFile& pngFile, Print& bmpOut, bool crop) {
+  return pngFileToBmpStreamInternal(pngFile, &bmpOut, TARGET_MAX_WIDTH, TARGET_MAX_HEIGHT, false, false, crop, nullptr);
+}
+
+// Convert to a 4-bit grayscale BMP at display size: the cover cache variant, holding raw
+// tones that the Bitmap reader tone-maps to panel levels at blit time
+bool PngToBmpConverter::pngFileTo4BitBmpStream(FsFile& pngFile, Print& bmpOut, bool crop) {
+  return pngFileToBmpStreamInternal(pngFile, &bmpOut, TARGET_MAX_WIDTH, TARGET_MAX_HEIGHT, false, true, crop, nullptr);
+}
+
+// Convert to 1-bit BMP (black and white only, no grays) for fast home screen rendering
+bool PngToBmpConverter::pngFileTo1BitBmpStreamWithSize(FsFile& pngFile, Print& bmpOut, int targetMaxWidth,
+                                                       int targetMaxHeight) {
+  return pngFileToBmpStreamInternal(pngFile, &bmpOut, targetMaxWidth, targetMaxHeight, true, false, false, nullptr);
+}
+
+// Decode straight to a row sink at display size, optionally teeing the BMP to bmpOut so the
+// on-disk cache can be populated in the same pass
+bool PngToBmpConverter::pngFileToBmpStreamWithSink(FsFile& pngFile, Print* bmpOut, const RowSink& sink, bool crop) {
+  return pngFileToBmpStreamInternal(pngFile, bmpOut, TARGET_MAX_WIDTH, TARGET_MAX_HEIGHT, false, false, crop, &sink);
+}
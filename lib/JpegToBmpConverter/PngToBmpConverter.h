@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "JpegToBmpConverter.h"
+
+class FsFile;
+class Print;
+
+// Streaming PNG → BMP converter, the PNG counterpart to JpegToBmpConverter and held to the
+// same bounded-memory standard: the IDAT stream inflates through the vendored miniz one
+// scanline at a time (a fixed 32KB inflate window plus two raw scanlines), never a
+// full-image buffer. Output goes through the same scale/dither/BMP pipeline, so covers and
+// thumbnails cache identically whichever format the book ships.
+//
+// Supported: non-interlaced, 8-bit-depth PNGs in grayscale, RGB, palette, and alpha variants
+// (alpha composites over white). Adam7 interlacing needs the whole image resident to
+// de-interleave, so those fail with a log line rather than blowing the heap.
+class PngToBmpConverter {
+ public:
+  // Same row sink contract as the JPEG converter (packed 2-bit rows, top-down)
+  using RowSink = JpegToBmpConverter::RowSink;
+
+  static bool pngFileToBmpStream(FsFile& pngFile, Print& bmpOut, bool crop = true);
+  // Convert to a 4-bit grayscale BMP at display size (the cover cache variant); same raw-tone
+  // contract as JpegToBmpConverter::jpegFileTo4BitBmpStream
+  static bool pngFileTo4BitBmpStream(FsFile& pngFile, Print& bmpOut, bool crop = true);
+  // Convert to 1-bit BMP at a custom target size (for thumbnails)
+  static bool pngFileTo1BitBmpStreamWithSize(FsFile& pngFile, Print& bmpOut, int targetMaxWidth, int targetMaxHeight);
+  // Decode to a row sink, optionally teeing the BMP to bmpOut at the same time (pass nullptr to
+  // skip the file entirely). Uses the display-size target like pngFileToBmpStream.
+  static bool pngFileToBmpStreamWithSink(FsFile& pngFile, Print* bmpOut, const RowSink& sink, bool crop = true);
+
+ private:
+  static bool pngFileToBmpStreamInternal(FsFile& pngFile, Print* bmpOut, int targetWidth, int targetHeight, bool oneBit,
+                                         bool fourBit, bool crop, const RowSink* sink);
+};
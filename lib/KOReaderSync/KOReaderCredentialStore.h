@@ -20,6 +20,7 @@ class KOReaderCredentialStore {
   std::string password;
   std::string serverUrl;                                            // Custom sync server URL (empty = default)
   DocumentMatchMethod matchMethod = DocumentMatchMethod::FILENAME;  // Default to filename for compatibility
+  bool loaded = false;                                              // Set once loadFromFile has run
 
   // Private constructor for singleton
   KOReaderCredentialStore() = default;
@@ -39,6 +40,14 @@ class KOReaderCredentialStore {
   bool saveToFile() const;
   bool loadFromFile();
 
+  // Lazy bring-up: first credential check loads the file, keeping the SD read
+  // off the boot path (most boots never touch the sync server)
+  void ensureLoaded() {
+    if (!loaded) {
+      loadFromFile();
+    }
+  }
+
   // Credential management
   void setCredentials(const std::string& user, const std::string& pass);
   const std::string& getUsername() const { return username; }
@@ -48,7 +57,7 @@ class KOReaderCredentialStore {
   std::string getMd5Password() const;
 
   // Check if credentials are set
-  bool hasCredentials() const;
+  bool hasCredentials();
 
   // Clear credentials
   void clearCredentials();
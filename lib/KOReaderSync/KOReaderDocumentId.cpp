@@ -3,8 +3,15 @@
 #include <HardwareSerial.h>
 #include <MD5Builder.h>
 #include <SDCardManager.h>
+#include <Serialization.h>
 
 namespace {
+// Cached document ID format version
+constexpr uint8_t KOID_FILE_VERSION = 1;
+
+// Cached document ID filename (inside the book's cache directory)
+constexpr char KOID_FILE[] = "/koid.bin";
+
 // Extract filename from path (everything after last '/')
 std::string getFilename(const std::string& path) {
   const size_t pos = path.rfind('/');
@@ -41,25 +48,18 @@ size_t KOReaderDocumentId::getOffset(int i) {
   return CHUNK_SIZE << (2 * i);
 }
 
-std::string KOReaderDocumentId::calculate(const std::string& filePath) {
-  FsFile file;
-  if (!SdMan.openFileForRead("KODoc", filePath, file)) {
-    Serial.printf("[%lu] [KODoc] Failed to open file: %s\n", millis(), filePath.c_str());
-    return "";
-  }
-
+std::string KOReaderDocumentId::hashFile(FsFile& file) {
   const size_t fileSize = file.fileSize();
-  Serial.printf("[%lu] [KODoc] Calculating hash for file: %s (size: %zu)\n", millis(), filePath.c_str(), fileSize);
 
   // Initialize MD5 builder
   MD5Builder md5;
   md5.begin();
 
-  // Buffer for reading chunks
-  uint8_t buffer[CHUNK_SIZE];
+  // The offsets are ascending, so this is a single forward pass; adjacent
+  // chunks (offsets 0 and 1024) are coalesced into one doubled read
+  uint8_t buffer[CHUNK_SIZE * 2];
   size_t totalBytesRead = 0;
 
-  // Read from each offset (i = -1 to 10)
   for (int i = -1; i < OFFSET_COUNT - 1; i++) {
     const size_t offset = getOffset(i);
 
@@ -68,24 +68,25 @@ std::string KOReaderDocumentId::calculate(const std::string& filePath) {
       continue;
     }
 
+    size_t bytesToRead = std::min(CHUNK_SIZE, fileSize - offset);
+    if (i + 1 < OFFSET_COUNT - 1 && getOffset(i + 1) == offset + CHUNK_SIZE && offset + CHUNK_SIZE < fileSize) {
+      bytesToRead = std::min(CHUNK_SIZE * 2, fileSize - offset);
+      i++;
+    }
+
     // Seek to offset
     if (!file.seekSet(offset)) {
       Serial.printf("[%lu] [KODoc] Failed to seek to offset %zu\n", millis(), offset);
       continue;
     }
 
-    // Read up to CHUNK_SIZE bytes
-    const size_t bytesToRead = std::min(CHUNK_SIZE, fileSize - offset);
     const size_t bytesRead = file.read(buffer, bytesToRead);
-
     if (bytesRead > 0) {
       md5.add(buffer, bytesRead);
       totalBytesRead += bytesRead;
     }
   }
 
-  file.close();
-
   // Calculate final hash
   md5.calculate();
   std::string result = md5.toString().c_str();
@@ -94,3 +95,77 @@ std::string KOReaderDocumentId::calculate(const std::string& filePath) {
 
   return result;
 }
+
+std::string KOReaderDocumentId::calculate(const std::string& filePath) {
+  FsFile file;
+  if (!SdMan.openFileForRead("KODoc", filePath, file)) {
+    Serial.printf("[%lu] [KODoc] Failed to open file: %s\n", millis(), filePath.c_str());
+    return "";
+  }
+
+  Serial.printf("[%lu] [KODoc] Calculating hash for file: %s (size: %zu)\n", millis(), filePath.c_str(),
+                static_cast<size_t>(file.fileSize()));
+
+  std::string result = hashFile(file);
+  file.close();
+  return result;
+}
+
+std::string KOReaderDocumentId::calculateCached(const std::string& filePath, const std::string& cacheDir) {
+  if (cacheDir.empty()) {
+    return calculate(filePath);
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForRead("KODoc", filePath, file)) {
+    Serial.printf("[%lu] [KODoc] Failed to open file: %s\n", millis(), filePath.c_str());
+    return "";
+  }
+
+  const uint32_t fileSize = file.fileSize();
+  uint16_t modDate = 0;
+  uint16_t modTime = 0;
+  file.getModifyDateTime(&modDate, &modTime);
+
+  const std::string idPath = cacheDir + KOID_FILE;
+
+  // Try the cached ID first; it's invalidated when size or mtime changes
+  FsFile idFile;
+  if (SdMan.openFileForRead("KODoc", idPath, idFile)) {
+    uint8_t version = 0;
+    uint32_t cachedSize = 0;
+    uint16_t cachedDate = 0;
+    uint16_t cachedTime = 0;
+    std::string cachedHash;
+    serialization::readPod(idFile, version);
+    serialization::readPod(idFile, cachedSize);
+    serialization::readPod(idFile, cachedDate);
+    serialization::readPod(idFile, cachedTime);
+    serialization::readString(idFile, cachedHash);
+    idFile.close();
+
+    if (version == KOID_FILE_VERSION && cachedSize == fileSize && cachedDate == modDate && cachedTime == modTime &&
+        cachedHash.length() == 32) {
+      file.close();
+      return cachedHash;
+    }
+    Serial.printf("[%lu] [KODoc] Cached ID is stale, re-hashing\n", millis());
+  }
+
+  const std::string result = hashFile(file);
+  file.close();
+  if (result.empty()) {
+    return result;
+  }
+
+  if (SdMan.openFileForWrite("KODoc", idPath, idFile)) {
+    serialization::writePod(idFile, KOID_FILE_VERSION);
+    serialization::writePod(idFile, fileSize);
+    serialization::writePod(idFile, modDate);
+    serialization::writePod(idFile, modTime);
+    serialization::writeString(idFile, result);
+    idFile.close();
+  }
+
+  return result;
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include <SdFat.h>
+
 #include <string>
 
 /**
@@ -24,6 +26,17 @@ class KOReaderDocumentId {
    */
   static std::string calculate(const std::string& filePath);
 
+  /**
+   * Like calculate(), but persists the result as koid.bin in the book's cache
+   * directory, keyed by the file's size and modify time, so repeated syncs of
+   * the same book skip the hashing pass entirely.
+   *
+   * @param filePath Path to the file (typically an EPUB)
+   * @param cacheDir The book's cache directory (Epub::getCachePath())
+   * @return 32-character lowercase hex string, or empty string on failure
+   */
+  static std::string calculateCached(const std::string& filePath, const std::string& cacheDir);
+
   /**
    * Calculate document hash from filename only (filename-based sync mode).
    * This is simpler and works when files have the same name across devices.
@@ -42,4 +55,7 @@ class KOReaderDocumentId {
 
   // Calculate offset for index i: 1024 << (2*i)
   static size_t getOffset(int i);
+
+  // Single ascending pass over the offset chunks of an already-open file
+  static std::string hashFile(FsFile& file);
 };
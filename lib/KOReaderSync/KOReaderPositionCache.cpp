@@ -0,0 +1,135 @@
+#include "KOReaderPositionCache.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <algorithm>
+
+// Initialize the static instance
+KOReaderPositionCache KOReaderPositionCache::instance;
+
+namespace {
+// File format version
+constexpr uint8_t KOSYNC_POSITIONS_FILE_VERSION = 1;
+
+// Cached remote positions file path
+constexpr char KOSYNC_POSITIONS_FILE[] = "/.crosspoint/kosync-positions.bin";
+
+// Plenty for one entry per recently-read book; oldest entries drop first
+constexpr size_t MAX_CACHE_ENTRIES = 16;
+}  // namespace
+
+bool KOReaderPositionCache::loadFromFile() {
+  loaded = true;  // A missing or bad file still counts as loaded (empty cache)
+  FsFile file;
+  if (!SdMan.openFileForRead("KPC", KOSYNC_POSITIONS_FILE, file)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(file, version);
+  if (version != KOSYNC_POSITIONS_FILE_VERSION) {
+    Serial.printf("[%lu] [KPC] Unknown file version: %u\n", millis(), version);
+    file.close();
+    return false;
+  }
+
+  uint8_t count;
+  serialization::readPod(file, count);
+
+  entries.clear();
+  entries.reserve(count);
+  for (uint8_t i = 0; i < count; i++) {
+    KOReaderProgress entry;
+    serialization::readString(file, entry.document);
+    serialization::readString(file, entry.progress);
+    serialization::readPod(file, entry.percentage);
+    serialization::readString(file, entry.device);
+    serialization::readPod(file, entry.timestamp);
+    entries.push_back(std::move(entry));
+  }
+
+  file.close();
+  Serial.printf("[%lu] [KPC] Loaded %d cached position(s)\n", millis(), entries.size());
+  return true;
+}
+
+bool KOReaderPositionCache::saveToFile() const {
+  if (entries.empty()) {
+    // Nothing cached; drop the file so boot skips the load
+    SdMan.remove(KOSYNC_POSITIONS_FILE);
+    return true;
+  }
+
+  // Make sure the directory exists
+  SdMan.mkdir("/.crosspoint");
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("KPC", KOSYNC_POSITIONS_FILE, file)) {
+    return false;
+  }
+
+  serialization::writePod(file, KOSYNC_POSITIONS_FILE_VERSION);
+  serialization::writePod(file, static_cast<uint8_t>(entries.size()));
+  for (const auto& entry : entries) {
+    serialization::writeString(file, entry.document);
+    serialization::writeString(file, entry.progress);
+    serialization::writePod(file, entry.percentage);
+    serialization::writeString(file, entry.device);
+    serialization::writePod(file, entry.timestamp);
+  }
+
+  file.close();
+  return true;
+}
+
+bool KOReaderPositionCache::get(const std::string& document, KOReaderProgress& out) {
+  if (document.empty()) {
+    return false;
+  }
+  ensureLoaded();
+
+  const auto it = std::find_if(entries.begin(), entries.end(),
+                               [&](const KOReaderProgress& entry) { return entry.document == document; });
+  if (it == entries.end()) {
+    return false;
+  }
+  out = *it;
+  return true;
+}
+
+void KOReaderPositionCache::put(const KOReaderProgress& progress) {
+  if (progress.document.empty()) {
+    return;
+  }
+  ensureLoaded();
+
+  // Only the latest known position per document matters
+  const auto it = std::find_if(entries.begin(), entries.end(),
+                               [&](const KOReaderProgress& entry) { return entry.document == progress.document; });
+  if (it != entries.end()) {
+    entries.erase(it);
+  }
+  entries.push_back(progress);
+
+  if (entries.size() > MAX_CACHE_ENTRIES) {
+    entries.erase(entries.begin());
+  }
+
+  saveToFile();
+  Serial.printf("[%lu] [KPC] Cached position %.2f%% for %s\n", millis(), progress.percentage * 100,
+                progress.document.c_str());
+}
+
+void KOReaderPositionCache::remove(const std::string& document) {
+  ensureLoaded();
+
+  const auto it = std::find_if(entries.begin(), entries.end(),
+                               [&](const KOReaderProgress& entry) { return entry.document == document; });
+  if (it == entries.end()) {
+    return;
+  }
+  entries.erase(it);
+  saveToFile();
+}
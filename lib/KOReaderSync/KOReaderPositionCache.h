@@ -0,0 +1,63 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "KOReaderSyncClient.h"
+
+/**
+ * Local cache of the last-known remote position per document.
+ *
+ * The sync activity's comparison screen used to be blank until WiFi came up
+ * and the server answered. Caching each successful pull (and our own pushes,
+ * which are last-writer-wins on the server) lets the screen render instantly
+ * from the previous answer while the real fetch revalidates in the background.
+ * Entries survive reboots via /.crosspoint/kosync-positions.bin.
+ */
+class KOReaderPositionCache {
+ public:
+  // Delete copy constructor and assignment
+  KOReaderPositionCache(const KOReaderPositionCache&) = delete;
+  KOReaderPositionCache& operator=(const KOReaderPositionCache&) = delete;
+
+  static KOReaderPositionCache& getInstance() { return instance; }
+
+  bool loadFromFile();
+  bool saveToFile() const;
+
+  /**
+   * Look up the cached remote position for a document hash.
+   * @return true and fills out on a hit, false on a miss
+   */
+  bool get(const std::string& document, KOReaderProgress& out);
+
+  /**
+   * Record the latest known remote position for a document. Newest wins and
+   * the file is rewritten immediately (it is tiny and sleep can happen at
+   * any time).
+   */
+  void put(const KOReaderProgress& progress);
+
+  /**
+   * Drop a document's entry — the server no longer has progress for it, so
+   * a cached comparison would be a lie.
+   */
+  void remove(const std::string& document);
+
+ private:
+  static KOReaderPositionCache instance;
+  std::vector<KOReaderProgress> entries;
+  bool loaded = false;  // Set once loadFromFile has run
+
+  KOReaderPositionCache() = default;
+
+  // Lazy bring-up, keeping the SD read off the boot path. Must run before any
+  // put: a save from an unloaded cache would clobber persisted entries.
+  void ensureLoaded() {
+    if (!loaded) {
+      loadFromFile();
+    }
+  }
+};
+
+// Helper macro to access the position cache
+#define KOSYNC_POSITIONS KOReaderPositionCache::getInstance()
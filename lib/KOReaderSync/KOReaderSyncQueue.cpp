@@ -0,0 +1,147 @@
+#include "KOReaderSyncQueue.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+#include <WiFi.h>
+
+#include <algorithm>
+#include <ctime>
+
+#include "KOReaderCredentialStore.h"
+#include "KOReaderPositionCache.h"
+#include "KOReaderSyncClient.h"
+
+// Initialize the static instance
+KOReaderSyncQueue KOReaderSyncQueue::instance;
+
+namespace {
+// File format version
+constexpr uint8_t KOSYNC_QUEUE_FILE_VERSION = 1;
+
+// Pending uploads file path
+constexpr char KOSYNC_QUEUE_FILE[] = "/.crosspoint/kosync-queue.bin";
+
+// Plenty for one entry per recently-read book; oldest entries drop first
+constexpr size_t MAX_QUEUE_ENTRIES = 16;
+}  // namespace
+
+bool KOReaderSyncQueue::loadFromFile() {
+  loaded = true;  // A missing or bad file still counts as loaded (empty queue)
+  FsFile file;
+  if (!SdMan.openFileForRead("KSQ", KOSYNC_QUEUE_FILE, file)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(file, version);
+  if (version != KOSYNC_QUEUE_FILE_VERSION) {
+    Serial.printf("[%lu] [KSQ] Unknown file version: %u\n", millis(), version);
+    file.close();
+    return false;
+  }
+
+  uint8_t count;
+  serialization::readPod(file, count);
+
+  entries.clear();
+  entries.reserve(count);
+  for (uint8_t i = 0; i < count; i++) {
+    PendingSync entry;
+    serialization::readString(file, entry.document);
+    serialization::readString(file, entry.xpath);
+    serialization::readPod(file, entry.percentage);
+    entries.push_back(std::move(entry));
+  }
+
+  file.close();
+  Serial.printf("[%lu] [KSQ] Loaded %d pending sync(s)\n", millis(), entries.size());
+  return true;
+}
+
+bool KOReaderSyncQueue::saveToFile() const {
+  if (entries.empty()) {
+    // Nothing pending; drop the file so boot skips the load
+    SdMan.remove(KOSYNC_QUEUE_FILE);
+    return true;
+  }
+
+  // Make sure the directory exists
+  SdMan.mkdir("/.crosspoint");
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("KSQ", KOSYNC_QUEUE_FILE, file)) {
+    return false;
+  }
+
+  serialization::writePod(file, KOSYNC_QUEUE_FILE_VERSION);
+  serialization::writePod(file, static_cast<uint8_t>(entries.size()));
+  for (const auto& entry : entries) {
+    serialization::writeString(file, entry.document);
+    serialization::writeString(file, entry.xpath);
+    serialization::writePod(file, entry.percentage);
+  }
+
+  file.close();
+  return true;
+}
+
+void KOReaderSyncQueue::enqueue(const std::string& document, const std::string& xpath, const float percentage) {
+  if (document.empty()) {
+    return;
+  }
+  ensureLoaded();
+
+  // Only the latest position per document matters
+  auto it = std::find_if(entries.begin(), entries.end(),
+                         [&](const PendingSync& entry) { return entry.document == document; });
+  if (it != entries.end()) {
+    entries.erase(it);
+  }
+  entries.push_back({document, xpath, percentage});
+
+  if (entries.size() > MAX_QUEUE_ENTRIES) {
+    entries.erase(entries.begin());
+  }
+
+  saveToFile();
+  Serial.printf("[%lu] [KSQ] Queued progress %.2f%% for %s (%d pending)\n", millis(), percentage * 100,
+                document.c_str(), entries.size());
+}
+
+int KOReaderSyncQueue::flush() {
+  ensureLoaded();
+  if (entries.empty() || !KOREADER_STORE.hasCredentials() || WiFi.status() != WL_CONNECTED) {
+    return 0;
+  }
+
+  Serial.printf("[%lu] [KSQ] Flushing %d pending sync(s)\n", millis(), entries.size());
+
+  int pushed = 0;
+  auto it = entries.begin();
+  while (it != entries.end()) {
+    KOReaderProgress progress;
+    progress.document = it->document;
+    progress.progress = it->xpath;
+    progress.percentage = it->percentage;
+
+    const auto result = KOReaderSyncClient::updateProgress(progress);
+    if (result == KOReaderSyncClient::OK) {
+      // Pushes are last-writer-wins, so this is now the server's position;
+      // the sync activity's cached comparison should reflect it
+      progress.timestamp = time(nullptr);
+      KOSYNC_POSITIONS.put(progress);
+      it = entries.erase(it);
+      pushed++;
+      continue;
+    }
+
+    Serial.printf("[%lu] [KSQ] Flush stopped: %s\n", millis(), KOReaderSyncClient::errorString(result));
+    break;
+  }
+
+  if (pushed > 0) {
+    saveToFile();
+  }
+  return pushed;
+}
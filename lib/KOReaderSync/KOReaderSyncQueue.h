@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Persistent queue of pending progress uploads for the KOReader sync server.
+ *
+ * Progress updates are appended locally (one entry per document, newest wins)
+ * and flushed opportunistically whenever WiFi happens to be up — e.g. while
+ * browsing OPDS catalogs — so the common upload case no longer needs the
+ * blocking sync activity. Entries survive reboots via /.crosspoint/kosync-queue.bin.
+ *
+ * Like KOReader's own sync, pushes are last-writer-wins; the sync activity's
+ * fetch flow remains the place where local and remote progress are compared.
+ */
+class KOReaderSyncQueue {
+ public:
+  struct PendingSync {
+    std::string document;  // Document hash (from KOReaderDocumentId)
+    std::string xpath;     // XPath-like progress string
+    float percentage;      // Progress percentage (0.0 to 1.0)
+  };
+
+  // Delete copy constructor and assignment
+  KOReaderSyncQueue(const KOReaderSyncQueue&) = delete;
+  KOReaderSyncQueue& operator=(const KOReaderSyncQueue&) = delete;
+
+  static KOReaderSyncQueue& getInstance() { return instance; }
+
+  bool loadFromFile();
+  bool saveToFile() const;
+
+  /**
+   * Record the latest position for a document. Coalesces with any queued
+   * entry for the same document and persists immediately (the file is tiny
+   * and sleep can happen at any time).
+   */
+  void enqueue(const std::string& document, const std::string& xpath, float percentage);
+
+  bool hasPending() {
+    ensureLoaded();
+    return !entries.empty();
+  }
+  size_t size() {
+    ensureLoaded();
+    return entries.size();
+  }
+
+  /**
+   * Push queued entries to the sync server. Requires WiFi to be connected
+   * and credentials to be configured; successful entries are removed, the
+   * pass aborts on the first network/auth failure so the rest retry later.
+   * @return number of entries successfully pushed
+   */
+  int flush();
+
+ private:
+  static KOReaderSyncQueue instance;
+  std::vector<PendingSync> entries;
+  bool loaded = false;  // Set once loadFromFile has run
+
+  KOReaderSyncQueue() = default;
+
+  // Lazy bring-up, keeping the SD read off the boot path. Must run before any
+  // enqueue: a save from an unloaded queue would clobber persisted entries.
+  void ensureLoaded() {
+    if (!loaded) {
+      loadFromFile();
+    }
+  }
+};
+
+// Helper macro to access the sync queue
+#define KOSYNC_QUEUE KOReaderSyncQueue::getInstance()
@@ -2,69 +2,79 @@
 
 #include <HardwareSerial.h>
 
+#include <algorithm>
 #include <cmath>
 
-KOReaderPosition ProgressMapper::toKOReader(const std::shared_ptr<Epub>& epub, const CrossPointPosition& pos) {
-  KOReaderPosition result;
-
-  // Calculate page progress within current spine item
-  float intraSpineProgress = 0.0f;
-  if (pos.totalPages > 0) {
-    intraSpineProgress = static_cast<float>(pos.pageNumber) / static_cast<float>(pos.totalPages);
+ProgressMapper::SpineFractionTable ProgressMapper::buildTable(const std::shared_ptr<Epub>& epub) {
+  SpineFractionTable table;
+  const int spineCount = epub->getSpineItemsCount();
+  table.cumulativeSizes.reserve(spineCount);
+  for (int i = 0; i < spineCount; i++) {
+    table.cumulativeSizes.push_back(epub->getCumulativeSpineItemSize(i));
   }
+  table.bookSize = spineCount > 0 ? table.cumulativeSizes.back() : 0;
+  return table;
+}
 
-  // Calculate overall book progress (0.0-1.0)
-  result.percentage = epub->calculateProgress(pos.spineIndex, intraSpineProgress);
+KOReaderPosition ProgressMapper::toKOReader(const SpineFractionTable& table, const CrossPointPosition& pos) {
+  KOReaderPosition result;
+  result.percentage = 0.0f;
 
   // Generate XPath with estimated paragraph position based on page
   result.xpath = generateXPath(pos.spineIndex, pos.pageNumber, pos.totalPages);
 
-  // Get chapter info for logging
-  const int tocIndex = epub->getTocIndexForSpineIndex(pos.spineIndex);
-  const std::string chapterName = (tocIndex >= 0) ? epub->getTocItem(tocIndex).title : "unknown";
+  if (!table.empty() && pos.spineIndex >= 0 && pos.spineIndex < static_cast<int>(table.cumulativeSizes.size())) {
+    // Calculate page progress within current spine item
+    float intraSpineProgress = 0.0f;
+    if (pos.totalPages > 0) {
+      intraSpineProgress = static_cast<float>(pos.pageNumber) / static_cast<float>(pos.totalPages);
+    }
+
+    // Calculate overall book progress (0.0-1.0)
+    const size_t prevChapterSize = (pos.spineIndex >= 1) ? table.cumulativeSizes[pos.spineIndex - 1] : 0;
+    const size_t curChapterSize = table.cumulativeSizes[pos.spineIndex] - prevChapterSize;
+    const float totalProgress =
+        static_cast<float>(prevChapterSize) + intraSpineProgress * static_cast<float>(curChapterSize);
+    result.percentage = totalProgress / static_cast<float>(table.bookSize);
+  }
 
-  Serial.printf("[%lu] [ProgressMapper] CrossPoint -> KOReader: chapter='%s', page=%d/%d -> %.2f%% at %s\n", millis(),
-                chapterName.c_str(), pos.pageNumber, pos.totalPages, result.percentage * 100, result.xpath.c_str());
+  Serial.printf("[%lu] [ProgressMapper] CrossPoint -> KOReader: spine=%d, page=%d/%d -> %.2f%% at %s\n", millis(),
+                pos.spineIndex, pos.pageNumber, pos.totalPages, result.percentage * 100, result.xpath.c_str());
 
   return result;
 }
 
-CrossPointPosition ProgressMapper::toCrossPoint(const std::shared_ptr<Epub>& epub, const KOReaderPosition& koPos,
-                                                int totalPagesInSpine) {
+CrossPointPosition ProgressMapper::toCrossPoint(const SpineFractionTable& table, const KOReaderPosition& koPos,
+                                                const int totalPagesInSpine) {
   CrossPointPosition result;
   result.spineIndex = 0;
   result.pageNumber = 0;
   result.totalPages = totalPagesInSpine;
 
-  const size_t bookSize = epub->getBookSize();
-  if (bookSize == 0) {
+  if (table.empty()) {
     return result;
   }
+  const int spineCount = static_cast<int>(table.cumulativeSizes.size());
 
   // First, try to get spine index from XPath (DocFragment)
-  int xpathSpineIndex = parseDocFragmentIndex(koPos.xpath);
-  if (xpathSpineIndex >= 0 && xpathSpineIndex < epub->getSpineItemsCount()) {
+  const int xpathSpineIndex = parseDocFragmentIndex(koPos.xpath);
+  if (xpathSpineIndex >= 0 && xpathSpineIndex < spineCount) {
     result.spineIndex = xpathSpineIndex;
     // When we have XPath, go to page 0 of the spine - byte-based page calculation is unreliable
     result.pageNumber = 0;
   } else {
     // Fall back to percentage-based lookup for both spine and page
-    const size_t targetBytes = static_cast<size_t>(bookSize * koPos.percentage);
-
-    // Find the spine item that contains this byte position
-    for (int i = 0; i < epub->getSpineItemsCount(); i++) {
-      const size_t cumulativeSize = epub->getCumulativeSpineItemSize(i);
-      if (cumulativeSize >= targetBytes) {
-        result.spineIndex = i;
-        break;
-      }
-    }
+    const size_t targetBytes = static_cast<size_t>(table.bookSize * koPos.percentage);
+
+    // First spine item whose cumulative size covers the target byte position
+    const auto it = std::lower_bound(table.cumulativeSizes.begin(), table.cumulativeSizes.end(), targetBytes);
+    result.spineIndex =
+        it != table.cumulativeSizes.end() ? static_cast<int>(it - table.cumulativeSizes.begin()) : spineCount - 1;
 
     // Estimate page number within the spine item using percentage (only when no XPath)
-    if (totalPagesInSpine > 0 && result.spineIndex < epub->getSpineItemsCount()) {
-      const size_t prevCumSize = (result.spineIndex > 0) ? epub->getCumulativeSpineItemSize(result.spineIndex - 1) : 0;
-      const size_t currentCumSize = epub->getCumulativeSpineItemSize(result.spineIndex);
-      const size_t spineSize = currentCumSize - prevCumSize;
+    if (totalPagesInSpine > 0) {
+      const size_t prevCumSize = (result.spineIndex > 0) ? table.cumulativeSizes[result.spineIndex - 1] : 0;
+      const size_t spineSize = table.cumulativeSizes[result.spineIndex] - prevCumSize;
 
       if (spineSize > 0) {
         const size_t bytesIntoSpine = (targetBytes > prevCumSize) ? (targetBytes - prevCumSize) : 0;
@@ -82,6 +92,15 @@ CrossPointPosition ProgressMapper::toCrossPoint(const std::shared_ptr<Epub>& epu
   return result;
 }
 
+KOReaderPosition ProgressMapper::toKOReader(const std::shared_ptr<Epub>& epub, const CrossPointPosition& pos) {
+  return toKOReader(buildTable(epub), pos);
+}
+
+CrossPointPosition ProgressMapper::toCrossPoint(const std::shared_ptr<Epub>& epub, const KOReaderPosition& koPos,
+                                                const int totalPagesInSpine) {
+  return toCrossPoint(buildTable(epub), koPos, totalPagesInSpine);
+}
+
 std::string ProgressMapper::generateXPath(int spineIndex, int pageNumber, int totalPages) {
   // KOReader uses 1-based DocFragment indices
   // Use a simple xpath pointing to the DocFragment - KOReader will use the percentage for fine positioning
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 /**
  * CrossPoint position representation.
@@ -34,25 +35,57 @@ struct KOReaderPosition {
 class ProgressMapper {
  public:
   /**
-   * Convert CrossPoint position to KOReader format.
+   * Cumulative spine byte sizes snapshotted once per book.
    *
-   * @param epub The EPUB book
+   * Both conversion directions need the spine size prefix sums; building them
+   * once at book open turns the percentage <-> spine mapping into a binary
+   * search over a flat array instead of an accessor walk per conversion.
+   */
+  struct SpineFractionTable {
+    std::vector<size_t> cumulativeSizes;  // cumulativeSizes[i] = bytes up to and including spine item i
+    size_t bookSize = 0;
+
+    bool empty() const { return cumulativeSizes.empty() || bookSize == 0; }
+  };
+
+  /**
+   * Snapshot the spine size prefix sums for a book. Build once when the book
+   * (or the sync screen) opens and reuse for every conversion.
+   */
+  static SpineFractionTable buildTable(const std::shared_ptr<Epub>& epub);
+
+  /**
+   * Convert CrossPoint position to KOReader format using a precomputed table.
+   *
+   * @param table Spine fraction table from buildTable()
    * @param pos CrossPoint position
    * @return KOReader position
    */
-  static KOReaderPosition toKOReader(const std::shared_ptr<Epub>& epub, const CrossPointPosition& pos);
+  static KOReaderPosition toKOReader(const SpineFractionTable& table, const CrossPointPosition& pos);
 
   /**
-   * Convert KOReader position to CrossPoint format.
+   * Convert KOReader position to CrossPoint format using a precomputed table.
    *
    * Note: The returned pageNumber may be approximate since different
    * rendering settings produce different page counts.
    *
-   * @param epub The EPUB book
+   * @param table Spine fraction table from buildTable()
    * @param koPos KOReader position
    * @param totalPagesInSpine Total pages in the target spine item (for page estimation)
    * @return CrossPoint position
    */
+  static CrossPointPosition toCrossPoint(const SpineFractionTable& table, const KOReaderPosition& koPos,
+                                         int totalPagesInSpine = 0);
+
+  /**
+   * Convenience overload for one-off conversions (e.g. queueing the final
+   * position on reader exit); builds a throwaway table.
+   */
+  static KOReaderPosition toKOReader(const std::shared_ptr<Epub>& epub, const CrossPointPosition& pos);
+
+  /**
+   * Convenience overload for one-off conversions; builds a throwaway table.
+   */
   static CrossPointPosition toCrossPoint(const std::shared_ptr<Epub>& epub, const KOReaderPosition& koPos,
                                          int totalPagesInSpine = 0);
 
@@ -0,0 +1,181 @@
+#include "Lz4.h"
+
+#include <cstring>
+
+namespace {
+constexpr size_t HASH_BITS = 12;
+constexpr size_t MIN_MATCH = 4;
+// Block-format safety margins: the last 5 bytes are always literals, and no match may start
+// within the last 12 bytes (lets compatible decoders use wild copies)
+constexpr size_t LAST_LITERALS = 5;
+constexpr size_t MF_LIMIT = 12;
+constexpr size_t MAX_OFFSET = 65535;
+
+uint32_t read32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+uint32_t hash32(const uint32_t v) { return (v * 2654435761u) >> (32 - HASH_BITS); }
+
+// Emit a 15-saturated length with 255-run extension bytes; returns the advanced output cursor
+uint8_t* putLength(uint8_t* op, size_t len) {
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = static_cast<uint8_t>(len);
+  return op;
+}
+}  // namespace
+
+namespace lz4 {
+
+size_t compress(const uint8_t* src, const size_t srcLen, uint8_t* dst, const size_t dstCap) {
+  if (srcLen == 0 || srcLen > MAX_INPUT_LEN || dstCap < compressBound(0)) {
+    return 0;
+  }
+
+  // Static rather than stack: callers run on 4KB task stacks (see Section's pageReadWindow for
+  // the same pattern). Positions are stored +1 so 0 means "empty slot".
+  static uint16_t table[1 << HASH_BITS];
+  memset(table, 0, sizeof(table));
+
+  const uint8_t* ip = src;
+  const uint8_t* anchor = src;
+  const uint8_t* const iend = src + srcLen;
+  const uint8_t* const mfLimit = srcLen > MF_LIMIT ? iend - MF_LIMIT : src;
+  const uint8_t* const matchEndLimit = iend - LAST_LITERALS;
+  uint8_t* op = dst;
+  uint8_t* const oend = dst + dstCap;
+
+  while (ip < mfLimit) {
+    // Probe the table for a 4-byte match within the offset range
+    const uint32_t h = hash32(read32(ip));
+    const uint16_t slot = table[h];
+    table[h] = static_cast<uint16_t>(ip - src + 1);
+    const uint8_t* match = src + slot - 1;
+    if (slot == 0 || static_cast<size_t>(ip - match) > MAX_OFFSET || read32(match) != read32(ip)) {
+      ip++;
+      continue;
+    }
+
+    size_t matchLen = MIN_MATCH;
+    while (ip + matchLen < matchEndLimit && ip[matchLen] == match[matchLen]) {
+      matchLen++;
+    }
+
+    // Worst-case sequence size: token + literal run + literals + offset + match run
+    const size_t litLen = ip - anchor;
+    if (op + 1 + litLen + litLen / 255 + 1 + 2 + matchLen / 255 + 1 > oend) {
+      return 0;
+    }
+
+    uint8_t* const token = op++;
+    if (litLen >= 15) {
+      *token = 15 << 4;
+      op = putLength(op, litLen - 15);
+    } else {
+      *token = static_cast<uint8_t>(litLen << 4);
+    }
+    memcpy(op, anchor, litLen);
+    op += litLen;
+
+    const size_t offset = ip - match;
+    *op++ = static_cast<uint8_t>(offset);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    if (matchLen - MIN_MATCH >= 15) {
+      *token |= 15;
+      op = putLength(op, matchLen - MIN_MATCH - 15);
+    } else {
+      *token |= static_cast<uint8_t>(matchLen - MIN_MATCH);
+    }
+
+    ip += matchLen;
+    anchor = ip;
+  }
+
+  // Trailing literals-only sequence
+  const size_t litLen = iend - anchor;
+  if (op + 1 + litLen + litLen / 255 + 1 > oend) {
+    return 0;
+  }
+  uint8_t* const token = op++;
+  if (litLen >= 15) {
+    *token = 15 << 4;
+    op = putLength(op, litLen - 15);
+  } else {
+    *token = static_cast<uint8_t>(litLen << 4);
+  }
+  memcpy(op, anchor, litLen);
+  op += litLen;
+
+  return static_cast<size_t>(op - dst);
+}
+
+bool decompress(const uint8_t* src, const size_t srcLen, uint8_t* dst, const size_t dstLen) {
+  const uint8_t* ip = src;
+  const uint8_t* const iend = src + srcLen;
+  uint8_t* op = dst;
+  uint8_t* const oend = dst + dstLen;
+
+  while (ip < iend) {
+    const uint8_t token = *ip++;
+
+    size_t litLen = token >> 4;
+    if (litLen == 15) {
+      uint8_t run;
+      do {
+        if (ip >= iend) {
+          return false;
+        }
+        run = *ip++;
+        litLen += run;
+      } while (run == 255);
+    }
+    if (ip + litLen > iend || op + litLen > oend) {
+      return false;
+    }
+    memcpy(op, ip, litLen);
+    ip += litLen;
+    op += litLen;
+
+    if (ip >= iend) {
+      break;  // final sequence carries no match
+    }
+
+    if (ip + 2 > iend) {
+      return false;
+    }
+    const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    const uint8_t* match = op - offset;
+    if (offset == 0 || match < dst) {
+      return false;
+    }
+
+    size_t matchLen = (token & 15) + MIN_MATCH;
+    if ((token & 15) == 15) {
+      uint8_t run;
+      do {
+        if (ip >= iend) {
+          return false;
+        }
+        run = *ip++;
+        matchLen += run;
+      } while (run == 255);
+    }
+    if (op + matchLen > oend) {
+      return false;
+    }
+    // Byte copy: overlapping matches (offset < matchLen) are how LZ4 encodes runs
+    while (matchLen--) {
+      *op++ = *match++;
+    }
+  }
+
+  return op == oend && ip == iend;
+}
+
+}  // namespace lz4
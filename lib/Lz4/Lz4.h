@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Minimal LZ4 block codec (standard LZ4 block format, greedy matcher).
+//
+// Exists because miniz's deflate side needs a ~300KB tdefl_compressor, which does not fit this
+// device's heap; LZ4 needs an 8KB hash table to encode and nothing but the output buffer to
+// decode, and its decode speed is what the section page-record path actually cares about.
+// Inputs are capped at 64KB so match positions fit in 16 bits - far above any page record.
+namespace lz4 {
+
+// Largest input compress() accepts. (Not MAX_INPUT: glibc's <limits.h> defines that as a
+// macro, which breaks the host-native build whenever it is included first.)
+constexpr size_t MAX_INPUT_LEN = 64 * 1024 - 1;
+
+// Worst-case compressed size for srcLen input bytes (incompressible data expands slightly)
+constexpr size_t compressBound(const size_t srcLen) { return srcLen + srcLen / 255 + 16; }
+
+/**
+ * Compress src into dst. Returns the compressed size, or 0 when the input is empty, larger than
+ * MAX_INPUT_LEN, or the output does not fit dstCap (callers store such records uncompressed).
+ * Not reentrant: the encoder's hash table is a shared static (single-writer build paths only).
+ */
+size_t compress(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstCap);
+
+/**
+ * Decompress src into dst, which must be sized to the exact original length.
+ * Returns false on malformed input or a length mismatch.
+ */
+bool decompress(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen);
+
+}  // namespace lz4
@@ -0,0 +1,49 @@
+#include "OpdsFeedArena.h"
+
+#include <cstring>
+
+namespace {
+// Grow the pool in coarse steps so a long feed does a handful of reallocations
+// instead of one per entry
+constexpr size_t POOL_GROW_BYTES = 4096;
+}  // namespace
+
+uint32_t OpdsFeedArena::intern(const char* s, const uint32_t len) {
+  if (len == 0) {
+    return 0;  // shared "" at offset 0
+  }
+  if (pool.size() + len + 1 > pool.capacity()) {
+    pool.reserve(((pool.size() + len + 1) / POOL_GROW_BYTES + 1) * POOL_GROW_BYTES);
+  }
+  const uint32_t offset = static_cast<uint32_t>(pool.size());
+  pool.insert(pool.end(), s, s + len);
+  pool.push_back('\0');
+  return offset;
+}
+
+void OpdsFeedArena::add(const OpdsEntry& entry) {
+  add(entry.type, entry.title.data(), static_cast<uint32_t>(entry.title.size()), entry.author.data(),
+      static_cast<uint32_t>(entry.author.size()), entry.href.data(), static_cast<uint32_t>(entry.href.size()),
+      entry.id.data(), static_cast<uint32_t>(entry.id.size()), entry.thumbHref.data(),
+      static_cast<uint32_t>(entry.thumbHref.size()));
+}
+
+void OpdsFeedArena::add(const OpdsEntryType type, const char* title, const uint32_t titleLen, const char* author,
+                        const uint32_t authorLen, const char* href, const uint32_t hrefLen, const char* id,
+                        const uint32_t idLen, const char* thumbHref, const uint32_t thumbHrefLen) {
+  OpdsEntryRef ref;
+  ref.type = type;
+  ref.title = intern(title, titleLen);
+  ref.author = intern(author, authorLen);
+  ref.href = intern(href, hrefLen);
+  ref.id = intern(id, idLen);
+  ref.thumbHref = intern(thumbHref, thumbHrefLen);
+  refs.push_back(ref);
+}
+
+void OpdsFeedArena::clear() {
+  // swap() instead of clear() so the capacity actually goes back to the heap
+  std::vector<OpdsEntryRef>().swap(refs);
+  std::vector<char>().swap(pool);
+  pool.push_back('\0');
+}
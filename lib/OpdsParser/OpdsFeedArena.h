@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "OpdsParser.h"
+
+/**
+ * POD entry record: each field is a byte offset into the owning arena's shared
+ * string pool, where the text lives NUL-terminated.
+ */
+struct OpdsEntryRef {
+  OpdsEntryType type = OpdsEntryType::NAVIGATION;
+  uint32_t title = 0;
+  uint32_t author = 0;
+  uint32_t href = 0;
+  uint32_t id = 0;
+  uint32_t thumbHref = 0;
+};
+
+/**
+ * Borrowed, NUL-terminated views into an arena's string pool. Valid until the
+ * next add() or clear() on the arena that produced it; copy fields you need
+ * to outlive the feed into std::strings before navigating away.
+ */
+struct OpdsEntryView {
+  OpdsEntryType type;
+  const char* title;
+  const char* author;
+  const char* href;
+  const char* id;
+  const char* thumbHref;
+};
+
+/**
+ * Per-feed storage for parsed OPDS entries: POD records over a single shared
+ * string pool instead of a std::string-heavy vector. A large Calibre catalog
+ * costs two growing allocations (records + pool) rather than four small heap
+ * blocks per entry, so parsing a feed right before a big download no longer
+ * fragments the heap. clear() releases both blocks wholesale on navigation.
+ */
+class OpdsFeedArena {
+ public:
+  OpdsFeedArena() { pool.push_back('\0'); }  // offset 0 is the shared ""
+
+  /** Copy a parsed entry's strings into the pool and append its record. */
+  void add(const OpdsEntry& entry);
+
+  /** Append an entry from raw field bytes (cache deserialisation path). */
+  void add(OpdsEntryType type, const char* title, uint32_t titleLen, const char* author, uint32_t authorLen,
+           const char* href, uint32_t hrefLen, const char* id, uint32_t idLen, const char* thumbHref = nullptr,
+           uint32_t thumbHrefLen = 0);
+
+  OpdsEntryView operator[](size_t i) const {
+    const OpdsEntryRef& ref = refs[i];
+    return {ref.type,
+            pool.data() + ref.title,
+            pool.data() + ref.author,
+            pool.data() + ref.href,
+            pool.data() + ref.id,
+            pool.data() + ref.thumbHref};
+  }
+
+  size_t size() const { return refs.size(); }
+  bool empty() const { return refs.empty(); }
+
+  /** Drop all entries and return the pool memory to the heap in one go. */
+  void clear();
+
+ private:
+  uint32_t intern(const char* s, uint32_t len);
+
+  std::vector<char> pool;
+  std::vector<OpdsEntryRef> refs;
+};
@@ -78,6 +78,7 @@ bool OpdsParser::error() const { return errorOccured; }
 
 void OpdsParser::clear() {
   entries.clear();
+  nextHref.clear();
   currentEntry = OpdsEntry{};
   currentText.clear();
   inEntry = false;
@@ -116,7 +117,17 @@ void XMLCALL OpdsParser::startElement(void* userData, const XML_Char* name, cons
     return;
   }
 
-  if (!self->inEntry) return;
+  if (!self->inEntry) {
+    // Feed-level pagination link (rel="next" lives outside any entry)
+    if (strcmp(name, "link") == 0 || strstr(name, ":link") != nullptr) {
+      const char* rel = findAttribute(atts, "rel");
+      const char* href = findAttribute(atts, "href");
+      if (rel && href && strcmp(rel, "next") == 0) {
+        self->nextHref = href;
+      }
+    }
+    return;
+  }
 
   // Check for title element
   if (strcmp(name, "title") == 0 || strstr(name, ":title") != nullptr) {
@@ -166,6 +177,12 @@ void XMLCALL OpdsParser::startElement(void* userData, const XML_Char* name, cons
           self->currentEntry.href = href;
         }
       }
+      // Cover art: prefer the dedicated thumbnail rendition, fall back to the full image
+      else if (rel && strstr(rel, "opds-spec.org/image") != nullptr) {
+        if (strstr(rel, "image/thumbnail") != nullptr || self->currentEntry.thumbHref.empty()) {
+          self->currentEntry.thumbHref = href;
+        }
+      }
     }
   }
 }
@@ -177,7 +194,11 @@ void XMLCALL OpdsParser::endElement(void* userData, const XML_Char* name) {
   if (strcmp(name, "entry") == 0 || strstr(name, ":entry") != nullptr) {
     // Only add entry if it has required fields (title and href)
     if (!self->currentEntry.title.empty() && !self->currentEntry.href.empty()) {
-      self->entries.push_back(self->currentEntry);
+      if (self->entryCallback) {
+        self->entryCallback(self->currentEntry);
+      } else {
+        self->entries.push_back(self->currentEntry);
+      }
     }
     self->inEntry = false;
     self->currentEntry = OpdsEntry{};
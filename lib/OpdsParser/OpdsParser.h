@@ -2,6 +2,7 @@
 #include <Print.h>
 #include <expat.h>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -20,8 +21,9 @@ struct OpdsEntry {
   OpdsEntryType type = OpdsEntryType::NAVIGATION;
   std::string title;
   std::string author;  // Only for books
-  std::string href;    // Navigation URL or epub download URL
+  std::string href;       // Navigation URL or epub download URL
   std::string id;
+  std::string thumbHref;  // Cover thumbnail URL (books only, empty when the feed has none)
 };
 
 // Legacy alias for backward compatibility
@@ -61,6 +63,14 @@ class OpdsParser final : public Print {
 
   operator bool() { return !error(); }
 
+  /**
+   * Register a callback invoked as each complete entry is parsed. When set,
+   * entries are handed to the callback instead of accumulated internally, so
+   * callers can render incrementally while the feed is still streaming in.
+   */
+  using EntryCallback = std::function<void(const OpdsEntry& entry)>;
+  void setEntryCallback(EntryCallback callback) { entryCallback = std::move(callback); }
+
   /**
    * Get the parsed entries (both navigation and book entries).
    * @return Vector of OpdsEntry entries
@@ -74,6 +84,12 @@ class OpdsParser final : public Print {
    */
   std::vector<OpdsEntry> getBooks() const;
 
+  /**
+   * Feed-level rel="next" pagination link, or empty when the feed has no
+   * further pages. Available once the element has streamed through.
+   */
+  const std::string& getNextLink() const { return nextHref; }
+
   /**
    * Clear all parsed entries.
    */
@@ -89,7 +105,9 @@ class OpdsParser final : public Print {
   static const char* findAttribute(const XML_Char** atts, const char* name);
 
   XML_Parser parser = nullptr;
+  EntryCallback entryCallback;
   std::vector<OpdsEntry> entries;
+  std::string nextHref;
   OpdsEntry currentEntry;
   std::string currentText;
 
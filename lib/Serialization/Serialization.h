@@ -1,7 +1,10 @@
 #pragma once
 #include <SdFat.h>
 
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace serialization {
 template <typename T>
@@ -14,6 +17,13 @@ static void writePod(FsFile& file, const T& value) {
   file.write(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
 }
 
+// Print overload for sinks that aren't files (e.g. a RAM page-record buffer); FsFile arguments
+// still bind to the exact-match overload above
+template <typename T>
+static void writePod(Print& out, const T& value) {
+  out.write(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+}
+
 template <typename T>
 static void readPod(std::istream& is, T& value) {
   is.read(reinterpret_cast<char*>(&value), sizeof(T));
@@ -36,6 +46,12 @@ static void writeString(FsFile& file, const std::string& s) {
   file.write(reinterpret_cast<const uint8_t*>(s.data()), len);
 }
 
+static void writeString(Print& out, const std::string& s) {
+  const uint32_t len = s.size();
+  writePod<uint32_t>(out, len);
+  out.write(reinterpret_cast<const uint8_t*>(s.data()), len);
+}
+
 static void readString(std::istream& is, std::string& s) {
   uint32_t len;
   readPod(is, len);
@@ -49,4 +65,113 @@ static void readString(FsFile& file, std::string& s) {
   s.resize(len);
   file.read(&s[0], len);
 }
+
+// One-read record blobs. The field-by-field helpers above cost one FsFile call per field, which
+// dominates multi-field entry loads on SdFat; a record blob is length-prefixed and contiguous,
+// so a reader pulls the whole record with a single bulk read and decodes the fields in place
+// from RAM. Strings are stored inline as length + bytes inside the blob.
+class RecordWriter {
+ public:
+  template <typename T>
+  void pod(const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  void str(const std::string& s) {
+    pod(static_cast<uint32_t>(s.size()));
+    buffer.insert(buffer.end(), s.begin(), s.end());
+  }
+
+  // Pointer variant for sources that aren't std::strings (e.g. arena pools)
+  void str(const char* s, const uint32_t len) {
+    pod(len);
+    buffer.insert(buffer.end(), s, s + len);
+  }
+
+  // Write the length-prefixed blob; returns the file position of the record start. Works over
+  // any FsFile-shaped sink with a position() (e.g. BufferedFileWriter).
+  template <typename File>
+  uint32_t writeTo(File& file) const {
+    const uint32_t pos = file.position();
+    const uint32_t size = buffer.size();
+    writePod(file, size);
+    file.write(buffer.data(), size);
+    return pos;
+  }
+
+  void clear() { buffer.clear(); }
+
+  // Raw blob access for sinks that aren't files (e.g. an NVS value)
+  const uint8_t* data() const { return buffer.data(); }
+  size_t size() const { return buffer.size(); }
+
+ private:
+  std::vector<uint8_t> buffer;
+};
+
+class RecordView {
+ public:
+  // One length read plus one bulk read; false on a truncated or implausibly large record. The
+  // backing buffer keeps its capacity across calls, so reusing one view in an entry loop does
+  // not reallocate per record. Works over any FsFile-shaped source (e.g. BufferedFileReader).
+  template <typename File>
+  bool readFrom(File& file, const uint32_t maxSize = 64 * 1024) {
+    cursor = 0;
+    uint32_t size = 0;
+    if (file.read(reinterpret_cast<uint8_t*>(&size), sizeof(size)) != static_cast<int>(sizeof(size))) {
+      buffer.clear();
+      return false;
+    }
+    if (size == 0 || size > maxSize) {
+      buffer.clear();
+      return false;
+    }
+    buffer.resize(size);
+    return file.read(buffer.data(), size) == static_cast<int>(size);
+  }
+
+  // Decode a blob already in RAM (e.g. read back from NVS), no length prefix
+  bool loadFrom(const uint8_t* data, const size_t len) {
+    cursor = 0;
+    buffer.assign(data, data + len);
+    return !buffer.empty();
+  }
+
+  template <typename T>
+  bool pod(T& value) {
+    if (cursor + sizeof(T) > buffer.size()) {
+      return false;
+    }
+    memcpy(&value, buffer.data() + cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+  }
+
+  // In-place view; the pointer stays valid until the next readFrom()
+  bool str(const char*& outData, uint32_t& outLen) {
+    uint32_t len = 0;
+    if (!pod(len) || cursor + len > buffer.size()) {
+      return false;
+    }
+    outData = reinterpret_cast<const char*>(buffer.data()) + cursor;
+    outLen = len;
+    cursor += len;
+    return true;
+  }
+
+  bool str(std::string& out) {
+    const char* data = nullptr;
+    uint32_t len = 0;
+    if (!str(data, len)) {
+      return false;
+    }
+    out.assign(data, len);
+    return true;
+  }
+
+ private:
+  std::vector<uint8_t> buffer;
+  size_t cursor = 0;
+};
 }  // namespace serialization
@@ -0,0 +1,86 @@
+#include "Trace.h"
+
+#ifdef CROSSPOINT_TRACE
+
+#include <Arduino.h>
+#include <CrashLog.h>
+#include <SDCardManager.h>
+
+namespace {
+// Flight recorder: newest events overwrite the oldest, so the flush always holds the last
+// ~RING_SIZE events before sleep. 1024 entries keeps the ring under 16KB of static RAM.
+constexpr size_t RING_SIZE = 1024;
+constexpr const char* TRACE_LOG_PATH = "/trace.log";
+
+struct Event {
+  const char* name;    // string literal; the pointer stays valid for the process lifetime
+  uint32_t timestamp;  // micros() at emit time
+  void* task;          // FreeRTOS task handle, used only as an opaque lane id by the renderer
+  bool isBegin;
+};
+
+Event ring[RING_SIZE];
+size_t head = 0;
+bool wrapped = false;
+// Events come from the display flush task and background workers as well as the main loop
+portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+}  // namespace
+
+namespace trace {
+
+void event(const char* name, const bool isBegin) {
+  const uint32_t now = micros();
+  void* task = xTaskGetCurrentTaskHandle();
+  // Mirror begin events into the crash log's RTC region so a watchdog reset can tell us what
+  // was running when it bit
+  if (isBegin) {
+    CRASH_LOG.noteEvent(name);
+  }
+  portENTER_CRITICAL(&ringMux);
+  ring[head] = {name, now, task, isBegin};
+  head = (head + 1) % RING_SIZE;
+  if (head == 0) {
+    wrapped = true;
+  }
+  portEXIT_CRITICAL(&ringMux);
+}
+
+bool flushToSd() {
+  // Snapshot the bounds, then read outside the critical section; written entries never change
+  portENTER_CRITICAL(&ringMux);
+  const size_t count = wrapped ? RING_SIZE : head;
+  const size_t start = wrapped ? head : 0;
+  portEXIT_CRITICAL(&ringMux);
+
+  if (count == 0) {
+    return true;
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("TRC", TRACE_LOG_PATH, file)) {
+    return false;
+  }
+
+  char line[96];
+  for (size_t i = 0; i < count; i++) {
+    const Event& e = ring[(start + i) % RING_SIZE];
+    const int len = snprintf(line, sizeof(line), "%lu %p %c %s\n", static_cast<unsigned long>(e.timestamp), e.task,
+                             e.isBegin ? 'B' : 'E', e.name);
+    if (len > 0) {
+      file.write(reinterpret_cast<const uint8_t*>(line), len);
+    }
+  }
+  file.close();
+
+  portENTER_CRITICAL(&ringMux);
+  head = 0;
+  wrapped = false;
+  portEXIT_CRITICAL(&ringMux);
+
+  Serial.printf("[%lu] [TRC] Flushed %u trace events to %s\n", millis(), count, TRACE_LOG_PATH);
+  return true;
+}
+
+}  // namespace trace
+
+#endif  // CROSSPOINT_TRACE
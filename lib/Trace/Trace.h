@@ -0,0 +1,43 @@
+#pragma once
+
+// Compile-out-able hot-path tracing. env:trace defines CROSSPOINT_TRACE; every other build sees
+// empty macros and pays nothing. Begin/end events carry a microsecond timestamp and the emitting
+// task handle into a fixed RAM ring, which SleepActivity flushes to /trace.log on the way down.
+// Render the log into a flame-style report with scripts/render_trace.py.
+
+#ifdef CROSSPOINT_TRACE
+
+namespace trace {
+// Record one begin or end event. `name` must be a string literal (the ring stores the pointer).
+void event(const char* name, bool isBegin);
+// Write the ring to /trace.log oldest-first and reset it. Returns false if the SD write failed.
+bool flushToSd();
+
+// RAII begin/end pair covering a lexical scope
+class Scope {
+ public:
+  explicit Scope(const char* name) : name(name) { event(name, true); }
+  ~Scope() { event(name, false); }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  const char* name;
+};
+}  // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) const trace::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_BEGIN(name) trace::event(name, true)
+#define TRACE_END(name) trace::event(name, false)
+#define TRACE_FLUSH_TO_SD() trace::flushToSd()
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_FLUSH_TO_SD() ((void)0)
+
+#endif  // CROSSPOINT_TRACE
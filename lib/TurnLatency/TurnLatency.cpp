@@ -0,0 +1,142 @@
+#include "TurnLatency.h"
+
+#include <Arduino.h>
+#include <Trace.h>
+
+#include <algorithm>
+
+// Initialize the static instance
+TurnLatencyMonitor TurnLatencyMonitor::instance;
+
+namespace {
+// Stage notes come from the main loop, the display task and the flush task
+portMUX_TYPE latencyMux = portMUX_INITIALIZER_UNLOCKED;
+
+// An edge nobody accepted within this window was pressed on a screen that doesn't turn pages
+// (or inside a sub-activity); the chain restarts at the accept instead of blaming the queue
+constexpr unsigned long EDGE_STALE_MS = 2000;
+
+uint16_t clampMs(const unsigned long ms) {
+  return ms > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(ms);
+}
+}  // namespace
+
+void TurnLatencyMonitor::noteInputEdge(const unsigned long atMs) {
+  // Zero-width marker: begin/end at the same instant keeps render_trace's per-task stacks
+  // balanced while the raw log carries the stage timestamp
+  TRACE_BEGIN("turn.edge");
+  TRACE_END("turn.edge");
+  portENTER_CRITICAL(&latencyMux);
+  edgeAt = atMs;
+  stage = Stage::EDGE;
+  portEXIT_CRITICAL(&latencyMux);
+}
+
+void TurnLatencyMonitor::noteTurnAccepted() {
+  TRACE_BEGIN("turn.accept");
+  TRACE_END("turn.accept");
+  const unsigned long now = millis();
+  portENTER_CRITICAL(&latencyMux);
+  // Release-mode turns and front-button turns never queue an edge; those chains start here
+  // with a zero queue stage
+  if (stage != Stage::EDGE || now - edgeAt > EDGE_STALE_MS) {
+    edgeAt = now;
+  }
+  acceptedAt = now;
+  stage = Stage::ACCEPTED;
+  portEXIT_CRITICAL(&latencyMux);
+}
+
+void TurnLatencyMonitor::notePageLoaded() {
+  const unsigned long now = millis();
+  bool inTurn = false;
+  portENTER_CRITICAL(&latencyMux);
+  if (stage == Stage::ACCEPTED) {
+    loadedAt = now;
+    stage = Stage::LOADED;
+    inTurn = true;
+  }
+  portEXIT_CRITICAL(&latencyMux);
+  if (inTurn) {
+    TRACE_BEGIN("turn.loaded");
+    TRACE_END("turn.loaded");
+  }
+}
+
+void TurnLatencyMonitor::noteRenderDone() {
+  const unsigned long now = millis();
+  bool inTurn = false;
+  portENTER_CRITICAL(&latencyMux);
+  if (stage == Stage::LOADED) {
+    renderedAt = now;
+    stage = Stage::RENDERED;
+    inTurn = true;
+  }
+  portEXIT_CRITICAL(&latencyMux);
+  if (inTurn) {
+    TRACE_BEGIN("turn.rendered");
+    TRACE_END("turn.rendered");
+  }
+}
+
+void TurnLatencyMonitor::noteRefreshComplete() {
+  const unsigned long now = millis();
+  Sample sample = {};
+  bool completed = false;
+  portENTER_CRITICAL(&latencyMux);
+  if (stage == Stage::RENDERED) {
+    sample.queueMs = clampMs(acceptedAt - edgeAt);
+    sample.loadMs = clampMs(loadedAt - acceptedAt);
+    sample.renderMs = clampMs(renderedAt - loadedAt);
+    sample.flushMs = clampMs(now - renderedAt);
+    sample.totalMs = clampMs(now - edgeAt);
+    ring[head] = sample;
+    head = (head + 1) % SAMPLE_RING_SIZE;
+    if (count < SAMPLE_RING_SIZE) {
+      count++;
+    }
+    stage = Stage::IDLE;
+    completed = true;
+  }
+  portEXIT_CRITICAL(&latencyMux);
+  if (completed) {
+    TRACE_BEGIN("turn.photon");
+    TRACE_END("turn.photon");
+    Serial.printf("[%lu] [TLM] Turn %ums (queue %u, load %u, render %u, flush %u)\n", millis(), sample.totalMs,
+                  sample.queueMs, sample.loadMs, sample.renderMs, sample.flushMs);
+  }
+}
+
+int TurnLatencyMonitor::getSampleCount() const {
+  portENTER_CRITICAL(&latencyMux);
+  const int n = count;
+  portEXIT_CRITICAL(&latencyMux);
+  return n;
+}
+
+TurnLatencyMonitor::Sample TurnLatencyMonitor::getLastSample() const {
+  portENTER_CRITICAL(&latencyMux);
+  const Sample sample = count > 0 ? ring[(head + SAMPLE_RING_SIZE - 1) % SAMPLE_RING_SIZE] : Sample{};
+  portEXIT_CRITICAL(&latencyMux);
+  return sample;
+}
+
+uint16_t TurnLatencyMonitor::getTotalPercentileMs(const uint8_t percentile) const {
+  uint16_t totals[SAMPLE_RING_SIZE];
+  portENTER_CRITICAL(&latencyMux);
+  const int n = count;
+  for (int i = 0; i < n; i++) {
+    totals[i] = ring[i].totalMs;
+  }
+  portEXIT_CRITICAL(&latencyMux);
+  if (n == 0) {
+    return 0;
+  }
+  std::sort(totals, totals + n);
+  // Nearest-rank: the smallest total with at least `percentile` percent of samples at or below it
+  int rank = (n * percentile + 99) / 100;
+  if (rank < 1) {
+    rank = 1;
+  }
+  return totals[rank - 1];
+}
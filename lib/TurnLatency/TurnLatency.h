@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+// Input-to-photon latency rig for page turns. The chain it measures:
+//
+//   GPIO edge observed → reader accepts the turn → page bytes in RAM → framebuffer drawn
+//   → B/W waveform finished (the text is readable)
+//
+// Each stage is noted by the component that owns it (MappedInputManager, the reader
+// activities, HalDisplay); notes arriving out of pipeline order are ignored, so renders
+// that aren't page turns and flushes from other screens cost one branch and record
+// nothing. Completed turns land in a small ring, from which the reader's diagnostics
+// overlay derives live p50/p95. Every stage boundary is also dropped into the trace
+// recorder as a zero-width marker, so a trace build lines the stages up against the
+// surrounding spans.
+class TurnLatencyMonitor {
+ public:
+  // Per-stage durations of one completed turn, in milliseconds
+  struct Sample {
+    uint16_t queueMs;   // GPIO edge observed → reader accepted the turn
+    uint16_t loadMs;    // accept → page bytes in RAM
+    uint16_t renderMs;  // page load → framebuffer drawn
+    uint16_t flushMs;   // framebuffer → B/W waveform done
+    uint16_t totalMs;
+  };
+
+  static constexpr int SAMPLE_RING_SIZE = 32;
+
+  // Get singleton instance
+  static TurnLatencyMonitor& getInstance() { return instance; }
+
+  // Stage notes, in pipeline order. The edge note carries the millis() timestamp at which the
+  // polled press was observed; the rest timestamp themselves.
+  void noteInputEdge(unsigned long atMs);
+  void noteTurnAccepted();
+  void notePageLoaded();
+  void noteRenderDone();
+  void noteRefreshComplete();
+
+  int getSampleCount() const;
+  Sample getLastSample() const;
+  // Nearest-rank percentile (e.g. 50, 95) over the recent turn totals; 0 with no samples
+  uint16_t getTotalPercentileMs(uint8_t percentile) const;
+
+ private:
+  TurnLatencyMonitor() = default;
+
+  // Static instance
+  static TurnLatencyMonitor instance;
+
+  enum class Stage : uint8_t { IDLE, EDGE, ACCEPTED, LOADED, RENDERED };
+
+  // In-flight turn; written by three tasks (main loop, display task, flush task) under the
+  // mux in the translation unit
+  Stage stage = Stage::IDLE;
+  unsigned long edgeAt = 0;
+  unsigned long acceptedAt = 0;
+  unsigned long loadedAt = 0;
+  unsigned long renderedAt = 0;
+
+  Sample ring[SAMPLE_RING_SIZE] = {};
+  uint8_t head = 0;
+  uint8_t count = 0;
+};
+
+// Helper macro to access the turn latency monitor
+#define TURN_LATENCY TurnLatencyMonitor::getInstance()
@@ -2,12 +2,177 @@
 
 #include <FsHelpers.h>
 #include <JpegToBmpConverter.h>
+#include <Serialization.h>
+#include <Utf8.h>
+
+namespace {
+constexpr uint8_t ENCODING_MARKER_VERSION = 1;
+constexpr char ENCODING_MARKER_NAME[] = "/enc.bin";
+constexpr char SHADOW_NAME[] = "/utf8.txt";
+
+enum class TxtEncoding : uint8_t {
+  UTF8 = 0,    // Source is valid UTF-8 (or plain ASCII); read it directly
+  CP1251 = 1,  // Cyrillic single-byte; served from the shadow copy
+  LATIN1 = 2,  // Western single-byte; served from the shadow copy
+};
+
+// CP1251 0x80-0xBF to Unicode (0xC0-0xFF maps contiguously onto U+0410..U+044F)
+constexpr uint16_t CP1251_HIGH[64] = {
+    0x0402, 0x0403, 0x201A, 0x0453, 0x201E, 0x2026, 0x2020, 0x2021, 0x20AC, 0x2030, 0x0409, 0x2039, 0x040A,
+    0x040C, 0x040B, 0x040F, 0x0452, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0xFFFD, 0x2122,
+    0x0459, 0x203A, 0x045A, 0x045C, 0x045B, 0x045F, 0x00A0, 0x040E, 0x045E, 0x0408, 0x00A4, 0x0490, 0x00A6,
+    0x00A7, 0x0401, 0x00A9, 0x0404, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x0407, 0x00B0, 0x00B1, 0x0406, 0x0456,
+    0x0491, 0x00B5, 0x00B6, 0x00B7, 0x0451, 0x2116, 0x0454, 0x00BB, 0x0458, 0x0405, 0x0455, 0x0457,
+};
+
+uint32_t decodeByte(const uint8_t byte, const TxtEncoding encoding) {
+  if (byte < 0x80) {
+    return byte;
+  }
+  if (encoding == TxtEncoding::LATIN1) {
+    return byte;  // Latin-1 maps 1:1 onto the first 256 codepoints
+  }
+  return byte < 0xC0 ? CP1251_HIGH[byte - 0x80] : 0x0410 + (byte - 0xC0);
+}
+}  // namespace
 
 Txt::Txt(std::string path, std::string cacheBasePath)
     : filepath(std::move(path)), cacheBasePath(std::move(cacheBasePath)) {
   // Generate cache path from file path hash
   const size_t hash = std::hash<std::string>{}(filepath);
   cachePath = this->cacheBasePath + "/txt_" + std::to_string(hash);
+  contentPath = filepath;
+}
+
+bool Txt::ensureUtf8Content() {
+  const std::string markerPath = cachePath + ENCODING_MARKER_NAME;
+  const std::string shadowPath = cachePath + SHADOW_NAME;
+
+  // Fast path: a previous open already classified this file (marker keyed on source size so a
+  // replaced file re-detects)
+  FsFile marker;
+  if (SdMan.openFileForRead("TXT", markerPath, marker)) {
+    uint8_t version = 0, encoding = 0;
+    uint32_t sourceSize = 0;
+    serialization::readPod(marker, version);
+    serialization::readPod(marker, encoding);
+    serialization::readPod(marker, sourceSize);
+    marker.close();
+    if (version == ENCODING_MARKER_VERSION && sourceSize == fileSize) {
+      if (encoding == static_cast<uint8_t>(TxtEncoding::UTF8)) {
+        return true;
+      }
+      FsFile shadow;
+      if (SdMan.openFileForRead("TXT", shadowPath, shadow)) {
+        contentPath = shadowPath;
+        fileSize = shadow.size();
+        shadow.close();
+        return true;
+      }
+    }
+  }
+
+  FsFile src;
+  if (!SdMan.openFileForRead("TXT", filepath, src)) {
+    return false;
+  }
+
+  // Single sequential scan: UTF-8 validity (continuation-byte state machine) plus a high-byte
+  // census for the single-byte-encoding guess
+  const uint32_t sourceSize = fileSize;
+  uint8_t buffer[1024];
+  int pendingContinuations = 0;
+  bool validUtf8 = true;
+  size_t highBytes = 0;
+  while (src.available()) {
+    const size_t bytesRead = src.read(buffer, sizeof(buffer));
+    for (size_t i = 0; i < bytesRead; i++) {
+      const uint8_t byte = buffer[i];
+      if (byte >= 0x80) {
+        highBytes++;
+      }
+      if (pendingContinuations > 0) {
+        if ((byte & 0xC0) != 0x80) {
+          validUtf8 = false;
+          break;
+        }
+        pendingContinuations--;
+      } else if (byte >= 0x80) {
+        if ((byte >> 5) == 0x6) {
+          pendingContinuations = 1;
+        } else if ((byte >> 4) == 0xE) {
+          pendingContinuations = 2;
+        } else if ((byte >> 3) == 0x1E) {
+          pendingContinuations = 3;
+        } else {
+          validUtf8 = false;
+          break;
+        }
+      }
+    }
+    if (!validUtf8) {
+      break;
+    }
+  }
+  src.close();
+  validUtf8 = validUtf8 && pendingContinuations == 0;
+
+  setupCacheDir();
+
+  if (validUtf8) {
+    // Persist the verdict so later opens skip the scan entirely
+    FsFile out;
+    if (SdMan.openFileForWrite("TXT", markerPath, out)) {
+      serialization::writePod(out, ENCODING_MARKER_VERSION);
+      serialization::writePod(out, static_cast<uint8_t>(TxtEncoding::UTF8));
+      serialization::writePod(out, sourceSize);
+      out.close();
+    }
+    return true;
+  }
+
+  // Not UTF-8: pick the single-byte encoding. Cyrillic text is nearly all high bytes while
+  // accented Western text is mostly ASCII, so the high-byte density separates the two.
+  const TxtEncoding encoding = highBytes * 3 > sourceSize ? TxtEncoding::CP1251 : TxtEncoding::LATIN1;
+  Serial.printf("[%lu] [TXT] Not UTF-8 (%zu high bytes in %u); transcoding as %s\n", millis(), highBytes, sourceSize,
+                encoding == TxtEncoding::CP1251 ? "CP1251" : "Latin-1");
+
+  if (!SdMan.openFileForRead("TXT", filepath, src)) {
+    return false;
+  }
+  FsFile shadow;
+  if (!SdMan.openFileForWrite("TXT", shadowPath, shadow)) {
+    src.close();
+    return false;
+  }
+  const uint32_t startMs = millis();
+  std::string outBuffer;
+  outBuffer.reserve(2048);
+  while (src.available()) {
+    const size_t bytesRead = src.read(buffer, sizeof(buffer));
+    for (size_t i = 0; i < bytesRead; i++) {
+      utf8AppendCodepoint(outBuffer, decodeByte(buffer[i], encoding));
+    }
+    shadow.write(reinterpret_cast<const uint8_t*>(outBuffer.data()), outBuffer.size());
+    outBuffer.clear();
+  }
+  const size_t shadowSize = shadow.size();
+  shadow.close();
+  src.close();
+
+  FsFile out;
+  if (SdMan.openFileForWrite("TXT", markerPath, out)) {
+    serialization::writePod(out, ENCODING_MARKER_VERSION);
+    serialization::writePod(out, static_cast<uint8_t>(encoding));
+    serialization::writePod(out, sourceSize);
+    out.close();
+  }
+
+  contentPath = shadowPath;
+  fileSize = shadowSize;
+  Serial.printf("[%lu] [TXT] Transcoded %u -> %zu bytes in %lums\n", millis(), sourceSize, shadowSize,
+                millis() - startMs);
+  return true;
 }
 
 bool Txt::load() {
@@ -29,6 +194,13 @@ bool Txt::load() {
   fileSize = file.size();
   file.close();
 
+  // Serve non-UTF-8 files from a one-time transcoded shadow copy; on failure fall back to the
+  // raw bytes rather than refusing to open the book
+  if (!ensureUtf8Content()) {
+    Serial.printf("[%lu] [TXT] Encoding check failed; reading raw bytes\n", millis());
+    contentPath = filepath;
+  }
+
   loaded = true;
   Serial.printf("[%lu] [TXT] Loaded TXT file: %s (%zu bytes)\n", millis(), filepath.c_str(), fileSize);
   return true;
@@ -151,7 +323,8 @@ bool Txt::generateCoverBmp() const {
       coverJpg.close();
       return false;
     }
-    const bool success = JpegToBmpConverter::jpegFileToBmpStream(coverJpg, coverBmp);
+    // Same 4-bit raw-tone cover cache as the EPUB path
+    const bool success = JpegToBmpConverter::jpegFileTo4BitBmpStream(coverJpg, coverBmp);
     coverJpg.close();
     coverBmp.close();
 
@@ -175,7 +348,7 @@ bool Txt::readContent(uint8_t* buffer, size_t offset, size_t length) const {
   }
 
   FsFile file;
-  if (!SdMan.openFileForRead("TXT", filepath, file)) {
+  if (!SdMan.openFileForRead("TXT", contentPath, file)) {
     return false;
   }
 
@@ -9,9 +9,17 @@ class Txt {
   std::string filepath;
   std::string cacheBasePath;
   std::string cachePath;
+  // Where readContent() actually reads from: the source file for UTF-8/ASCII books, or the
+  // transcoded shadow copy in the cache dir for CP1251/Latin-1 ones
+  std::string contentPath;
   bool loaded = false;
   size_t fileSize = 0;
 
+  // Detect the file's encoding on first open and, when it isn't UTF-8, write a UTF-8 transcoded
+  // shadow copy into the cache dir. The verdict is persisted so later opens skip the scan; the
+  // cost is paid exactly once per book.
+  bool ensureUtf8Content();
+
  public:
   explicit Txt(std::string path, std::string cacheBasePath);
 
@@ -1,7 +1,52 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string>
 
 #define REPLACEMENT_GLYPH 0xFFFD
 
 uint32_t utf8NextCodepoint(const unsigned char** string);
+
+// Append a codepoint to `out` as UTF-8 (the inverse of utf8NextCodepoint)
+void utf8AppendCodepoint(std::string& out, uint32_t cp);
+
+// Calls callback(cp, byteOffset) for every codepoint in the NUL-terminated string. Library text
+// is overwhelmingly ASCII, so once the cursor is word-aligned whole 4-byte words are classified
+// at a time: a word with no high bit and no zero byte is four ASCII codepoints that bypass the
+// decoder entirely. Multibyte lead bytes (and the unaligned prefix) fall back to
+// utf8NextCodepoint.
+template <typename Callback>
+void utf8ForEachCodepoint(const char* string, Callback&& callback) {
+  if (string == nullptr) {
+    return;
+  }
+  const auto* start = reinterpret_cast<const uint8_t*>(string);
+  const uint8_t* cursor = start;
+
+  while (*cursor) {
+    if ((reinterpret_cast<uintptr_t>(cursor) & 3) == 0) {
+      uint32_t word;
+      memcpy(&word, cursor, sizeof(word));
+      // Zero-byte test: (word - 0x01010101) borrows into the high bit of any zero byte
+      while ((word & 0x80808080u) == 0 && ((word - 0x01010101u) & ~word & 0x80808080u) == 0) {
+        callback(static_cast<uint32_t>(cursor[0]), static_cast<uint32_t>(cursor - start));
+        callback(static_cast<uint32_t>(cursor[1]), static_cast<uint32_t>(cursor + 1 - start));
+        callback(static_cast<uint32_t>(cursor[2]), static_cast<uint32_t>(cursor + 2 - start));
+        callback(static_cast<uint32_t>(cursor[3]), static_cast<uint32_t>(cursor + 3 - start));
+        cursor += 4;
+        memcpy(&word, cursor, sizeof(word));
+      }
+      if (*cursor == 0) {
+        return;
+      }
+    }
+
+    const auto byteOffset = static_cast<uint32_t>(cursor - start);
+    const uint32_t cp = utf8NextCodepoint(&cursor);
+    if (cp == 0) {
+      return;
+    }
+    callback(cp, byteOffset);
+  }
+}
@@ -7,6 +7,8 @@
 
 #include "Xtc.h"
 
+#include <FsHelpers.h>
+#include <GfxRenderer.h>
 #include <HardwareSerial.h>
 #include <SDCardManager.h>
 
@@ -35,7 +37,7 @@ bool Xtc::clearCache() const {
     return true;
   }
 
-  if (!SdMan.removeDir(cachePath.c_str())) {
+  if (!FsHelpers::removeDirRecursive(cachePath)) {
     Serial.printf("[%lu] [XTC] Failed to clear cache\n", millis());
     return false;
   }
@@ -110,6 +112,13 @@ const std::vector<xtc::ChapterInfo>& Xtc::getChapters() const {
   return parser->getChapters();
 }
 
+std::string Xtc::getChapterName(size_t index) const {
+  if (!loaded || !parser) {
+    return "";
+  }
+  return parser->getChapterName(index);
+}
+
 std::string Xtc::getCoverBmpPath() const { return cachePath + "/cover.bmp"; }
 
 bool Xtc::generateCoverBmp() const {
@@ -597,6 +606,94 @@ size_t Xtc::loadPage(uint32_t pageIndex, uint8_t* buffer, size_t bufferSize) con
   return const_cast<xtc::XtcParser*>(parser.get())->loadPage(pageIndex, buffer, bufferSize);
 }
 
+bool Xtc::blitPageToBuffer(GfxRenderer& renderer, const uint8_t* pageData, const PagePass pass) const {
+  if (!loaded || !parser || !pageData) {
+    return false;
+  }
+
+  // The fast path relies on the logical-portrait to panel mapping (panel row r holds logical
+  // column width-1-r, panel bit p holds logical row p), so only exactly panel-sized pages in
+  // the default Portrait orientation qualify
+  if (renderer.getOrientation() != GfxRenderer::Portrait) {
+    return false;
+  }
+  const int width = getPageWidth();
+  const int height = getPageHeight();
+  if (width != HalDisplay::DISPLAY_HEIGHT || height != HalDisplay::DISPLAY_WIDTH) {
+    return false;
+  }
+  uint8_t* frameBuffer = renderer.getFrameBuffer();
+  if (!frameBuffer) {
+    return false;
+  }
+
+  constexpr size_t outRowBytes = HalDisplay::DISPLAY_WIDTH_BYTES;
+
+  if (getBitDepth() == 2) {
+    // XTH: two column-major bit planes, right-to-left columns with 8 vertical pixels per byte.
+    // Page column width-1-x lands on panel row r = width-1-x with identical bit order, so each
+    // framebuffer row is one byte-wise merge of the matching plane runs. Framebuffer bit set =
+    // white; pixel value = (bit1 << 1) | bit2 with 0 = white.
+    const size_t planeSize = (static_cast<size_t>(width) * height + 7) / 8;
+    const size_t colBytes = (height + 7) / 8;
+    if (colBytes != outRowBytes) {
+      return false;
+    }
+    const uint8_t* plane1 = pageData;
+    const uint8_t* plane2 = pageData + planeSize;
+
+    for (int r = 0; r < width; r++) {
+      const uint8_t* b1 = plane1 + r * colBytes;
+      const uint8_t* b2 = plane2 + r * colBytes;
+      uint8_t* out = frameBuffer + r * outRowBytes;
+      switch (pass) {
+        case PagePass::BW:  // black where value >= 1
+          for (size_t i = 0; i < outRowBytes; i++) {
+            out[i] = ~(b1[i] | b2[i]);
+          }
+          break;
+        case PagePass::GRAY_LSB:  // bits set where value == 1 (dark grey)
+          for (size_t i = 0; i < outRowBytes; i++) {
+            out[i] = static_cast<uint8_t>(~b1[i]) & b2[i];
+          }
+          break;
+        case PagePass::GRAY_MSB:  // bits set where value is 1 or 2 (either grey)
+          for (size_t i = 0; i < outRowBytes; i++) {
+            out[i] = b1[i] ^ b2[i];
+          }
+          break;
+      }
+    }
+  } else {
+    // XTG: row-major 1-bit, 8 pixels per byte MSB first, 0 = black. A panel row reads one fixed
+    // source column (fixed byte offset and mask), gathering 8 source rows per output byte.
+    if (pass != PagePass::BW) {
+      return false;
+    }
+    const size_t srcRowBytes = (width + 7) / 8;
+
+    for (int r = 0; r < width; r++) {
+      const int srcX = width - 1 - r;
+      const uint8_t mask = 0x80 >> (srcX & 7);
+      const uint8_t* src = pageData + (srcX >> 3);
+      uint8_t* out = frameBuffer + r * outRowBytes;
+      for (size_t b = 0; b < outRowBytes; b++) {
+        uint8_t packed = 0;
+        for (int j = 0; j < 8; j++) {
+          if (*src & mask) {
+            packed |= 0x80 >> j;  // source 1 = white = framebuffer bit set
+          }
+          src += srcRowBytes;
+        }
+        out[b] = packed;
+      }
+    }
+  }
+
+  renderer.markFullScreenDirty();
+  return true;
+}
+
 xtc::XtcError Xtc::loadPageStreaming(uint32_t pageIndex,
                                      std::function<void(const uint8_t* data, size_t size, size_t offset)> callback,
                                      size_t chunkSize) const {
@@ -14,6 +14,8 @@
 #include "Xtc/XtcParser.h"
 #include "Xtc/XtcTypes.h"
 
+class GfxRenderer;
+
 /**
  * XTC Ebook Handler
  *
@@ -59,6 +61,8 @@ class Xtc {
   std::string getAuthor() const;
   bool hasChapters() const;
   const std::vector<xtc::ChapterInfo>& getChapters() const;
+  // Titles are read from the file on demand; fetch only visible entries
+  std::string getChapterName(size_t index) const;
 
   // Cover image support (for sleep screen)
   std::string getCoverBmpPath() const;
@@ -82,6 +86,30 @@ class Xtc {
    */
   size_t loadPage(uint32_t pageIndex, uint8_t* buffer, size_t bufferSize) const;
 
+  /**
+   * Which framebuffer image to produce from a page blob; the grayscale passes mirror the
+   * LSB/MSB buffer semantics of the reader's 2-bit render flow
+   */
+  enum class PagePass : uint8_t {
+    BW,        // composite black/white: any non-white pixel rendered black
+    GRAY_LSB,  // 2-bit pages only: bits set where the pixel is dark grey (value 1)
+    GRAY_MSB,  // 2-bit pages only: bits set where the pixel is either grey (value 1 or 2)
+  };
+
+  /**
+   * Decode a loaded page blob straight into the renderer's framebuffer. XTC pages are exactly
+   * panel-sized, and both the XTG row-major and XTH column-major layouts line up with the
+   * panel's native orientation, so this is byte operations instead of the per-pixel
+   * transform/bounds-check path through drawPixel().
+   *
+   * @param renderer Target renderer (Portrait orientation only)
+   * @param pageData Page blob from loadPage()
+   * @param pass Which image to produce (grayscale passes require a 2-bit page)
+   * @return false when the page or orientation doesn't fit the fast path; the caller should
+   *         fall back to per-pixel rendering
+   */
+  bool blitPageToBuffer(GfxRenderer& renderer, const uint8_t* pageData, PagePass pass = PagePass::BW) const;
+
   /**
    * Load page with streaming callback
    * @param pageIndex Page index
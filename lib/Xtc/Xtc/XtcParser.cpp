@@ -268,18 +268,16 @@ XtcError XtcParser::readChapters() {
       return XtcError::READ_ERROR;
     }
 
-    char nameBuf[81];
-    memcpy(nameBuf, chapterBuf.data(), 80);
-    nameBuf[80] = '\0';
-    const size_t nameLen = strnlen(nameBuf, 80);
-    std::string name(nameBuf, nameLen);
+    // Only note where the name lives; getChapterName() reads it on demand
+    const size_t nameLen = strnlen(reinterpret_cast<const char*>(chapterBuf.data()), 80);
+    const uint32_t nameOffset = static_cast<uint32_t>(chapterOffset + i * chapterSize);
 
     uint16_t startPage = 0;
     uint16_t endPage = 0;
     memcpy(&startPage, chapterBuf.data() + 0x50, sizeof(startPage));
     memcpy(&endPage, chapterBuf.data() + 0x52, sizeof(endPage));
 
-    if (name.empty() && startPage == 0 && endPage == 0) {
+    if (nameLen == 0 && startPage == 0 && endPage == 0) {
       break;
     }
 
@@ -302,8 +300,8 @@ XtcError XtcParser::readChapters() {
       continue;
     }
 
-    ChapterInfo chapter{std::move(name), startPage, endPage};
-    m_chapters.push_back(std::move(chapter));
+    ChapterInfo chapter{nameOffset, startPage, endPage};
+    m_chapters.push_back(chapter);
   }
 
   m_hasChapters = !m_chapters.empty();
@@ -311,6 +309,20 @@ XtcError XtcParser::readChapters() {
   return XtcError::OK;
 }
 
+std::string XtcParser::getChapterName(size_t chapterIndex) {
+  if (!m_isOpen || chapterIndex >= m_chapters.size()) {
+    return "";
+  }
+
+  if (!m_file.seek(m_chapters[chapterIndex].nameOffset)) {
+    return "";
+  }
+
+  char nameBuf[81] = {0};
+  m_file.read(nameBuf, 80);
+  return std::string(nameBuf, strnlen(nameBuf, 80));
+}
+
 bool XtcParser::getPageInfo(uint32_t pageIndex, PageInfo& info) const {
   if (pageIndex >= m_pageTable.size()) {
     return false;
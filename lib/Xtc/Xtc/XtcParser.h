@@ -74,6 +74,17 @@ class XtcParser {
   bool hasChapters() const { return m_hasChapters; }
   const std::vector<ChapterInfo>& getChapters() const { return m_chapters; }
 
+  /**
+   * Read a chapter title from the file on demand
+   *
+   * Titles are not kept resident; callers should fetch only the entries
+   * they are about to display.
+   *
+   * @param chapterIndex Index into getChapters()
+   * @return Title string, empty on error or unnamed chapter
+   */
+  std::string getChapterName(size_t chapterIndex);
+
   // Validation
   static bool isValidXtcFile(const char* filepath);
 
@@ -13,7 +13,7 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
+#include <cstring>
 
 namespace xtc {
 
@@ -96,11 +96,14 @@ struct PageInfo {
   uint8_t padding;   // Alignment padding
 };  // 16 bytes total
 
+// Compact chapter index entry. Titles stay in the fixed 96-byte chapter
+// records on disk and are read on demand via XtcParser::getChapterName(),
+// so an open file only pays 8 bytes of RAM per chapter.
 struct ChapterInfo {
-  std::string name;
-  uint16_t startPage;
-  uint16_t endPage;
-};
+  uint32_t nameOffset;  // File offset of the chapter's 80-byte name field
+  uint16_t startPage;   // First page of chapter (0-based)
+  uint16_t endPage;     // Last page of chapter (0-based)
+};  // 8 bytes total
 
 // Error codes
 enum class XtcError {
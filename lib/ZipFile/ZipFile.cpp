@@ -1,11 +1,29 @@
 #include "ZipFile.h"
 
+#include <FileHandleCache.h>
 #include <HardwareSerial.h>
+#include <HeapMonitor.h>
 #include <SDCardManager.h>
+#include <Trace.h>
 #include <miniz.h>
 
+#include <Serialization.h>
+
 #include <algorithm>
 
+namespace {
+// v2: entries carry the central-dir headerSkip for the local-header trust fast path
+constexpr uint8_t STAT_CACHE_VERSION = 2;
+// Guard against pathological archives blowing the heap (32 bytes per entry)
+constexpr uint16_t STAT_CACHE_MAX_ENTRIES = 2048;
+
+// Central-dir name+extra lengths combined, clamped to the uint16 field (0 = unknown)
+uint16_t combinedHeaderSkip(const uint16_t nameLen, const uint16_t extraLen) {
+  const uint32_t skip = static_cast<uint32_t>(nameLen) + extraLen;
+  return skip <= UINT16_MAX ? static_cast<uint16_t>(skip) : 0;
+}
+}  // namespace
+
 bool inflateOneShot(const uint8_t* inputBuf, const size_t deflatedSize, uint8_t* outputBuf, const size_t inflatedSize) {
   // Setup inflator
   const auto inflator = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
@@ -43,37 +61,38 @@ bool ZipFile::loadAllFileStatSlims() {
     return false;
   }
 
-  file.seek(zipDetails.centralDirOffset);
+  file->seek(zipDetails.centralDirOffset);
 
   uint32_t sig;
   char itemName[256];
   fileStatSlimCache.clear();
   fileStatSlimCache.reserve(zipDetails.totalEntries);
 
-  while (file.available()) {
-    file.read(&sig, 4);
+  while (file->available()) {
+    file->read(&sig, 4);
     if (sig != 0x02014b50) break;  // End of list
 
     FileStatSlim fileStat = {};
 
-    file.seekCur(6);
-    file.read(&fileStat.method, 2);
-    file.seekCur(8);
-    file.read(&fileStat.compressedSize, 4);
-    file.read(&fileStat.uncompressedSize, 4);
+    file->seekCur(6);
+    file->read(&fileStat.method, 2);
+    file->seekCur(8);
+    file->read(&fileStat.compressedSize, 4);
+    file->read(&fileStat.uncompressedSize, 4);
     uint16_t nameLen, m, k;
-    file.read(&nameLen, 2);
-    file.read(&m, 2);
-    file.read(&k, 2);
-    file.seekCur(8);
-    file.read(&fileStat.localHeaderOffset, 4);
-    file.read(itemName, nameLen);
+    file->read(&nameLen, 2);
+    file->read(&m, 2);
+    file->read(&k, 2);
+    file->seekCur(8);
+    file->read(&fileStat.localHeaderOffset, 4);
+    fileStat.headerSkip = combinedHeaderSkip(nameLen, m);
+    file->read(itemName, nameLen);
     itemName[nameLen] = '\0';
 
     fileStatSlimCache.emplace(itemName, fileStat);
 
     // Skip the rest of this entry (extra field + comment)
-    file.seekCur(m + k);
+    file->seekCur(m + k);
   }
 
   // Set cursor to start of central directory for sequential access
@@ -96,6 +115,26 @@ bool ZipFile::loadFileStatSlim(const char* filename, FileStatSlim* fileStat) {
     return false;
   }
 
+  // Restored central-dir index: binary search in RAM, no SD access at all
+  if (statIndexLoaded) {
+    const size_t nameLen = strlen(filename);
+    const uint64_t hash = fnvHash64(filename, nameLen);
+    const StatCacheEntry key = {hash, static_cast<uint16_t>(nameLen), 0, 0, 0, 0};
+    const auto it =
+        std::lower_bound(statIndex.begin(), statIndex.end(), key, [](const StatCacheEntry& a, const StatCacheEntry& b) {
+          return a.hash < b.hash || (a.hash == b.hash && a.len < b.len);
+        });
+    if (it != statIndex.end() && it->hash == hash && it->len == nameLen) {
+      fileStat->method = it->method;
+      fileStat->compressedSize = it->compressedSize;
+      fileStat->uncompressedSize = it->uncompressedSize;
+      fileStat->localHeaderOffset = it->localHeaderOffset;
+      fileStat->headerSkip = it->headerSkip;
+      return true;
+    }
+    return false;
+  }
+
   const bool wasOpen = isOpen();
   if (!wasOpen && !open()) {
     return false;
@@ -114,19 +153,19 @@ bool ZipFile::loadFileStatSlim(const char* filename, FileStatSlim* fileStat) {
   bool wrapped = false;
   bool found = false;
 
-  file.seek(startPos);
+  file->seek(startPos);
 
   uint32_t sig;
   char itemName[256];
 
   while (true) {
-    uint32_t entryStart = file.position();
+    uint32_t entryStart = file->position();
 
-    if (file.read(&sig, 4) != 4 || sig != 0x02014b50) {
+    if (file->read(&sig, 4) != 4 || sig != 0x02014b50) {
       // End of central directory
       if (!wrapped && lastCentralDirPosValid && startPos != zipDetails.centralDirOffset) {
         // Wrap around to beginning
-        file.seek(zipDetails.centralDirOffset);
+        file->seek(zipDetails.centralDirOffset);
         wrapped = true;
         continue;
       }
@@ -138,37 +177,38 @@ bool ZipFile::loadFileStatSlim(const char* filename, FileStatSlim* fileStat) {
       break;
     }
 
-    file.seekCur(6);
-    file.read(&fileStat->method, 2);
-    file.seekCur(8);
-    file.read(&fileStat->compressedSize, 4);
-    file.read(&fileStat->uncompressedSize, 4);
+    file->seekCur(6);
+    file->read(&fileStat->method, 2);
+    file->seekCur(8);
+    file->read(&fileStat->compressedSize, 4);
+    file->read(&fileStat->uncompressedSize, 4);
     uint16_t nameLen, m, k;
-    file.read(&nameLen, 2);
-    file.read(&m, 2);
-    file.read(&k, 2);
-    file.seekCur(8);
-    file.read(&fileStat->localHeaderOffset, 4);
+    file->read(&nameLen, 2);
+    file->read(&m, 2);
+    file->read(&k, 2);
+    file->seekCur(8);
+    file->read(&fileStat->localHeaderOffset, 4);
+    fileStat->headerSkip = combinedHeaderSkip(nameLen, m);
 
     if (nameLen < 256) {
-      file.read(itemName, nameLen);
+      file->read(itemName, nameLen);
       itemName[nameLen] = '\0';
 
       if (strcmp(itemName, filename) == 0) {
         // Found it! Update cursor to next entry
-        file.seekCur(m + k);
-        lastCentralDirPos = file.position();
+        file->seekCur(m + k);
+        lastCentralDirPos = file->position();
         lastCentralDirPosValid = true;
         found = true;
         break;
       }
     } else {
       // Name too long, skip it
-      file.seekCur(nameLen);
+      file->seekCur(nameLen);
     }
 
     // Skip extra field + comment
-    file.seekCur(m + k);
+    file->seekCur(m + k);
   }
 
   if (!wasOpen) {
@@ -178,18 +218,24 @@ bool ZipFile::loadFileStatSlim(const char* filename, FileStatSlim* fileStat) {
 }
 
 long ZipFile::getDataOffset(const FileStatSlim& fileStat) {
+  constexpr auto localHeaderSize = 30;
+
+  // Trusted archive: the central-dir lengths are known to match the local headers, so the
+  // data offset is pure arithmetic - no seek, no read
+  if (localHeaderTrust == HeaderTrust::TRUSTED && fileStat.headerSkip != 0) {
+    return static_cast<long>(fileStat.localHeaderOffset) + localHeaderSize + fileStat.headerSkip;
+  }
+
   const bool wasOpen = isOpen();
   if (!wasOpen && !open()) {
     return -1;
   }
 
-  constexpr auto localHeaderSize = 30;
-
   uint8_t pLocalHeader[localHeaderSize];
   const uint64_t fileOffset = fileStat.localHeaderOffset;
 
-  file.seek(fileOffset);
-  const size_t read = file.read(pLocalHeader, localHeaderSize);
+  file->seek(fileOffset);
+  const size_t read = file->read(pLocalHeader, localHeaderSize);
   if (!wasOpen) {
     close();
   }
@@ -207,7 +253,20 @@ long ZipFile::getDataOffset(const FileStatSlim& fileStat) {
 
   const uint16_t filenameLength = pLocalHeader[26] + (pLocalHeader[27] << 8);
   const uint16_t extraOffset = pLocalHeader[28] + (pLocalHeader[29] << 8);
-  return fileOffset + localHeaderSize + filenameLength + extraOffset;
+  const long dataOffset = fileOffset + localHeaderSize + filenameLength + extraOffset;
+
+  // First use verifies whether this archive's writer kept the local and central-dir lengths in
+  // sync (Python zipfile and most epub tools do; Info-ZIP pads the local extra field and does
+  // not). Match means every later entry skips this seek+read.
+  if (localHeaderTrust == HeaderTrust::UNTESTED && fileStat.headerSkip != 0) {
+    const long predicted = static_cast<long>(fileStat.localHeaderOffset) + localHeaderSize + fileStat.headerSkip;
+    localHeaderTrust = predicted == dataOffset ? HeaderTrust::TRUSTED : HeaderTrust::UNTRUSTED;
+    if (localHeaderTrust == HeaderTrust::UNTRUSTED) {
+      Serial.printf("[%lu] [ZIP] Local headers differ from central dir, keeping per-entry reads\n", millis());
+    }
+  }
+
+  return dataOffset;
 }
 
 bool ZipFile::loadZipDetails() {
@@ -220,7 +279,7 @@ bool ZipFile::loadZipDetails() {
     return false;
   }
 
-  const size_t fileSize = file.size();
+  const size_t fileSize = file->size();
   if (fileSize < 22) {
     Serial.printf("[%lu] [ZIP] File too small to be a valid zip\n", millis());
     if (!wasOpen) {
@@ -241,8 +300,8 @@ bool ZipFile::loadZipDetails() {
     return false;
   }
 
-  file.seek(fileSize - scanRange);
-  file.read(buffer, scanRange);
+  file->seek(fileSize - scanRange);
+  file->read(buffer, scanRange);
 
   // Scan backwards for the signature
   int foundOffset = -1;
@@ -279,21 +338,200 @@ bool ZipFile::loadZipDetails() {
 }
 
 bool ZipFile::open() {
-  if (!SdMan.openFileForRead("ZIP", filePath, file)) {
-    return false;
+  if (file != nullptr) {
+    return true;
   }
-  return true;
+  // Through the handle cache: steady-state re-opens of the same container skip the SdFat
+  // directory walk and reuse the already-open handle
+  file = FILE_HANDLES.acquire("ZIP", filePath);
+  return file != nullptr;
 }
 
 bool ZipFile::close() {
-  if (file) {
-    file.close();
+  if (file != nullptr) {
+    FILE_HANDLES.release(file);
+    file = nullptr;
   }
   lastCentralDirPos = 0;
   lastCentralDirPosValid = false;
   return true;
 }
 
+bool ZipFile::loadStatCache(const std::string& cacheFilePath) {
+  if (statIndexLoaded) {
+    return true;
+  }
+
+  FsFile cacheFile;
+  if (!SdMan.openFileForRead("ZIP", cacheFilePath, cacheFile)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(cacheFile, version);
+  if (version != STAT_CACHE_VERSION) {
+    Serial.printf("[%lu] [ZIP] Stat cache version mismatch: expected %u, got %u\n", millis(), STAT_CACHE_VERSION,
+                  version);
+    cacheFile.close();
+    return false;
+  }
+
+  uint32_t cachedZipSize;
+  uint16_t cachedModDate, cachedModTime;
+  serialization::readPod(cacheFile, cachedZipSize);
+  serialization::readPod(cacheFile, cachedModDate);
+  serialization::readPod(cacheFile, cachedModTime);
+
+  // Key the cache on the zip's size and modify time so edits on the card invalidate it
+  const bool wasOpen = isOpen();
+  if (!wasOpen && !open()) {
+    cacheFile.close();
+    return false;
+  }
+  const uint32_t zipSize = file->size();
+  uint16_t modDate = 0, modTime = 0;
+  file->getModifyDateTime(&modDate, &modTime);
+  if (!wasOpen) {
+    close();
+  }
+
+  if (cachedZipSize != zipSize || cachedModDate != modDate || cachedModTime != modTime) {
+    Serial.printf("[%lu] [ZIP] Stat cache stale, ignoring\n", millis());
+    cacheFile.close();
+    return false;
+  }
+
+  uint16_t entryCount;
+  serialization::readPod(cacheFile, entryCount);
+  if (entryCount == 0 || entryCount > STAT_CACHE_MAX_ENTRIES) {
+    cacheFile.close();
+    return false;
+  }
+
+  statIndex.resize(entryCount);
+  const size_t tableSize = static_cast<size_t>(entryCount) * sizeof(StatCacheEntry);
+  if (cacheFile.read(statIndex.data(), tableSize) != tableSize) {
+    Serial.printf("[%lu] [ZIP] Stat cache truncated, ignoring\n", millis());
+    statIndex.clear();
+    statIndex.shrink_to_fit();
+    cacheFile.close();
+    return false;
+  }
+  cacheFile.close();
+
+  statIndexLoaded = true;
+  Serial.printf("[%lu] [ZIP] Restored stat cache with %u entries\n", millis(), entryCount);
+  return true;
+}
+
+bool ZipFile::saveStatCache(const std::string& cacheFilePath) {
+  const bool wasOpen = isOpen();
+  if (!wasOpen && !open()) {
+    return false;
+  }
+
+  if (!loadZipDetails()) {
+    if (!wasOpen) {
+      close();
+    }
+    return false;
+  }
+
+  if (zipDetails.totalEntries == 0 || zipDetails.totalEntries > STAT_CACHE_MAX_ENTRIES) {
+    Serial.printf("[%lu] [ZIP] Not persisting stat cache for %u entries\n", millis(), zipDetails.totalEntries);
+    if (!wasOpen) {
+      close();
+    }
+    return false;
+  }
+
+  const uint32_t zipSize = file->size();
+  uint16_t modDate = 0, modTime = 0;
+  file->getModifyDateTime(&modDate, &modTime);
+
+  // Walk the central directory once, collecting fixed-width hash-keyed records
+  std::vector<StatCacheEntry> entries;
+  entries.reserve(zipDetails.totalEntries);
+  file->seek(zipDetails.centralDirOffset);
+
+  uint32_t sig;
+  char itemName[256];
+  while (file->available()) {
+    file->read(&sig, 4);
+    if (sig != 0x02014b50) break;  // End of list
+
+    StatCacheEntry entry = {};
+    file->seekCur(6);
+    file->read(&entry.method, 2);
+    file->seekCur(8);
+    file->read(&entry.compressedSize, 4);
+    file->read(&entry.uncompressedSize, 4);
+    uint16_t nameLen, m, k;
+    file->read(&nameLen, 2);
+    file->read(&m, 2);
+    file->read(&k, 2);
+    file->seekCur(8);
+    file->read(&entry.localHeaderOffset, 4);
+    entry.headerSkip = combinedHeaderSkip(nameLen, m);
+
+    if (nameLen < 256) {
+      file->read(itemName, nameLen);
+      entry.hash = fnvHash64(itemName, nameLen);
+      entry.len = nameLen;
+      entries.push_back(entry);
+    } else {
+      file->seekCur(nameLen);
+    }
+
+    file->seekCur(m + k);
+  }
+
+  if (!wasOpen) {
+    close();
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const StatCacheEntry& a, const StatCacheEntry& b) {
+    return a.hash < b.hash || (a.hash == b.hash && a.len < b.len);
+  });
+
+  FsFile cacheFile;
+  if (!SdMan.openFileForWrite("ZIP", cacheFilePath, cacheFile)) {
+    return false;
+  }
+
+  serialization::writePod(cacheFile, STAT_CACHE_VERSION);
+  serialization::writePod(cacheFile, zipSize);
+  serialization::writePod(cacheFile, modDate);
+  serialization::writePod(cacheFile, modTime);
+  serialization::writePod(cacheFile, static_cast<uint16_t>(entries.size()));
+  const size_t tableSize = entries.size() * sizeof(StatCacheEntry);
+  const bool writeOk = cacheFile.write(entries.data(), tableSize) == tableSize;
+  cacheFile.close();
+
+  if (!writeOk) {
+    Serial.printf("[%lu] [ZIP] Failed to write stat cache\n", millis());
+    SdMan.remove(cacheFilePath.c_str());
+    return false;
+  }
+
+  Serial.printf("[%lu] [ZIP] Persisted stat cache with %u entries\n", millis(), entries.size());
+  return true;
+}
+
+bool ZipFile::resolveEntry(const char* filename, FileStatSlim* fileStat, long* dataOffset) {
+  if (!loadFileStatSlim(filename, fileStat)) {
+    return false;
+  }
+
+  const long offset = getDataOffset(*fileStat);
+  if (offset < 0) {
+    return false;
+  }
+
+  *dataOffset = offset;
+  return true;
+}
+
 bool ZipFile::getInflatedFileSize(const char* filename, size_t* size) {
   FileStatSlim fileStat = {};
   if (!loadFileStatSlim(filename, &fileStat)) {
@@ -309,6 +547,30 @@ int ZipFile::fillUncompressedSizes(std::vector<SizeTarget>& targets, std::vector
     return 0;
   }
 
+  // Restored central-dir index: both sides are sorted by (hash, len), so a merge walk fills
+  // every target from RAM without touching the SD central directory at all
+  if (statIndexLoaded) {
+    int matched = 0;
+    auto target = targets.begin();
+    for (const auto& entry : statIndex) {
+      while (target != targets.end() &&
+             (target->hash < entry.hash || (target->hash == entry.hash && target->len < entry.len))) {
+        ++target;
+      }
+      while (target != targets.end() && target->hash == entry.hash && target->len == entry.len) {
+        if (target->index < sizes.size()) {
+          sizes[target->index] = entry.uncompressedSize;
+          matched++;
+        }
+        ++target;
+      }
+      if (target == targets.end()) {
+        break;
+      }
+    }
+    return matched;
+  }
+
   const bool wasOpen = isOpen();
   if (!wasOpen && !open()) {
     return 0;
@@ -321,33 +583,33 @@ int ZipFile::fillUncompressedSizes(std::vector<SizeTarget>& targets, std::vector
     return 0;
   }
 
-  file.seek(zipDetails.centralDirOffset);
+  file->seek(zipDetails.centralDirOffset);
 
   int matched = 0;
   uint32_t sig;
   char itemName[256];
 
-  while (file.available()) {
-    file.read(&sig, 4);
+  while (file->available()) {
+    file->read(&sig, 4);
     if (sig != 0x02014b50) break;
 
-    file.seekCur(6);
+    file->seekCur(6);
     uint16_t method;
-    file.read(&method, 2);
-    file.seekCur(8);
+    file->read(&method, 2);
+    file->seekCur(8);
     uint32_t compressedSize, uncompressedSize;
-    file.read(&compressedSize, 4);
-    file.read(&uncompressedSize, 4);
+    file->read(&compressedSize, 4);
+    file->read(&uncompressedSize, 4);
     uint16_t nameLen, m, k;
-    file.read(&nameLen, 2);
-    file.read(&m, 2);
-    file.read(&k, 2);
-    file.seekCur(8);
+    file->read(&nameLen, 2);
+    file->read(&m, 2);
+    file->read(&k, 2);
+    file->seekCur(8);
     uint32_t localHeaderOffset;
-    file.read(&localHeaderOffset, 4);
+    file->read(&localHeaderOffset, 4);
 
     if (nameLen < 256) {
-      file.read(itemName, nameLen);
+      file->read(itemName, nameLen);
       itemName[nameLen] = '\0';
 
       uint64_t hash = fnvHash64(itemName, nameLen);
@@ -365,10 +627,10 @@ int ZipFile::fillUncompressedSizes(std::vector<SizeTarget>& targets, std::vector
         ++it;
       }
     } else {
-      file.seekCur(nameLen);
+      file->seekCur(nameLen);
     }
 
-    file.seekCur(m + k);
+    file->seekCur(m + k);
   }
 
   if (!wasOpen) {
@@ -379,6 +641,7 @@ int ZipFile::fillUncompressedSizes(std::vector<SizeTarget>& targets, std::vector
 }
 
 uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const bool trailingNullByte) {
+  TRACE_SCOPE("ZipFile::readFileToMemory");
   const bool wasOpen = isOpen();
   if (!wasOpen && !open()) {
     return nullptr;
@@ -400,12 +663,16 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
     return nullptr;
   }
 
-  file.seek(fileOffset);
+  file->seek(fileOffset);
 
   const auto deflatedDataSize = fileStat.compressedSize;
   const auto inflatedDataSize = fileStat.uncompressedSize;
   const auto dataSize = trailingNullByte ? inflatedDataSize + 1 : inflatedDataSize;
+  // Give registered caches a chance to shed before this allocation can fail; the deflated path
+  // needs both buffers live at once
+  HEAP_MON.demand(fileStat.method == MZ_DEFLATED ? dataSize + deflatedDataSize : dataSize);
   const auto data = static_cast<uint8_t*>(malloc(dataSize));
+  HEAP_MON.recordAlloc("zip-inflated", dataSize, data != nullptr);
   if (data == nullptr) {
     Serial.printf("[%lu] [ZIP] Failed to allocate memory for output buffer (%zu bytes)\n", millis(), dataSize);
     if (!wasOpen) {
@@ -416,7 +683,7 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
 
   if (fileStat.method == MZ_NO_COMPRESSION) {
     // no deflation, just read content
-    const size_t dataRead = file.read(data, inflatedDataSize);
+    const size_t dataRead = file->read(data, inflatedDataSize);
     if (!wasOpen) {
       close();
     }
@@ -431,6 +698,7 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
   } else if (fileStat.method == MZ_DEFLATED) {
     // Read out deflated content from file
     const auto deflatedData = static_cast<uint8_t*>(malloc(deflatedDataSize));
+    HEAP_MON.recordAlloc("zip-deflated", deflatedDataSize, deflatedData != nullptr);
     if (deflatedData == nullptr) {
       Serial.printf("[%lu] [ZIP] Failed to allocate memory for decompression buffer\n", millis());
       if (!wasOpen) {
@@ -439,7 +707,7 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
       return nullptr;
     }
 
-    const size_t dataRead = file.read(deflatedData, deflatedDataSize);
+    const size_t dataRead = file->read(deflatedData, deflatedDataSize);
     if (!wasOpen) {
       close();
     }
@@ -475,6 +743,7 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
 }
 
 bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t chunkSize) {
+  TRACE_SCOPE("ZipFile::readFileToStream");
   const bool wasOpen = isOpen();
   if (!wasOpen && !open()) {
     return false;
@@ -490,13 +759,18 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
     return false;
   }
 
-  file.seek(fileOffset);
+  file->seek(fileOffset);
   const auto deflatedDataSize = fileStat.compressedSize;
   const auto inflatedDataSize = fileStat.uncompressedSize;
 
   if (fileStat.method == MZ_NO_COMPRESSION) {
-    // no deflation, just read content
-    const auto buffer = static_cast<uint8_t*>(malloc(chunkSize));
+    // No inflate scaffolding for stored entries: bounded direct reads. The caller's chunk size
+    // is tuned against the deflated path's inflater + 32KB dictionary; none of that is allocated
+    // here, so larger multi-sector reads cost nothing extra and cut the SdFat call count on
+    // exactly the biggest items (stored images)
+    constexpr size_t STORED_CHUNK_SIZE = 8 * 1024;
+    const size_t bufferSize = std::max(chunkSize, std::min(static_cast<size_t>(inflatedDataSize), STORED_CHUNK_SIZE));
+    const auto buffer = static_cast<uint8_t*>(malloc(bufferSize));
     if (!buffer) {
       Serial.printf("[%lu] [ZIP] Failed to allocate memory for buffer\n", millis());
       if (!wasOpen) {
@@ -507,7 +781,7 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
 
     size_t remaining = inflatedDataSize;
     while (remaining > 0) {
-      const size_t dataRead = file.read(buffer, remaining < chunkSize ? remaining : chunkSize);
+      const size_t dataRead = file->read(buffer, remaining < bufferSize ? remaining : bufferSize);
       if (dataRead == 0) {
         Serial.printf("[%lu] [ZIP] Could not read more bytes\n", millis());
         free(buffer);
@@ -579,7 +853,7 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
         }
 
         fileReadBufferFilledBytes =
-            file.read(fileReadBuffer, fileRemainingBytes < chunkSize ? fileRemainingBytes : chunkSize);
+            file->read(fileReadBuffer, fileRemainingBytes < chunkSize ? fileRemainingBytes : chunkSize);
         fileRemainingBytes -= fileReadBufferFilledBytes;
         fileReadBufferCursor = 0;
 
@@ -12,6 +12,7 @@ class ZipFile {
     uint32_t compressedSize;     // Compressed size
     uint32_t uncompressedSize;   // Uncompressed size
     uint32_t localHeaderOffset;  // Offset of local file header
+    uint16_t headerSkip;         // Central-dir name+extra lengths for the data-offset fast path; 0 = unknown
   };
 
   struct ZipDetails {
@@ -20,6 +21,18 @@ class ZipFile {
     bool isSet;
   };
 
+  // Persisted central-directory index entry. Fixed width so the whole table restores with one
+  // contiguous read, and hash-keyed so we never hold entry names in RAM.
+  struct StatCacheEntry {
+    uint64_t hash;  // FNV-1a 64-bit hash of entry path
+    uint16_t len;   // Length of path for collision reduction
+    uint16_t method;
+    uint32_t compressedSize;
+    uint32_t uncompressedSize;
+    uint32_t localHeaderOffset;
+    uint16_t headerSkip;  // Central-dir name+extra lengths; 0 = unknown
+  };
+
   // Target for batch uncompressed size lookup (sorted by hash, then len)
   struct SizeTarget {
     uint64_t hash;   // FNV-1a 64-bit hash of normalized path
@@ -39,7 +52,8 @@ class ZipFile {
 
  private:
   const std::string& filePath;
-  FsFile file;
+  // Borrowed from FileHandleCache between open() and close(); nullptr when closed
+  FsFile* file = nullptr;
   ZipDetails zipDetails = {0, 0, false};
   std::unordered_map<std::string, FileStatSlim> fileStatSlimCache;
 
@@ -47,20 +61,39 @@ class ZipFile {
   uint32_t lastCentralDirPos = 0;
   bool lastCentralDirPosValid = false;
 
+  // Sorted (hash, len) index restored from a persisted central-dir cache file
+  std::vector<StatCacheEntry> statIndex;
+  bool statIndexLoaded = false;
+
+  // Local-header trust mode: the first getDataOffset() reads the local header as usual and
+  // checks it against the central directory's name+extra lengths. If they agree, the archive's
+  // writer kept both copies consistent and later lookups compute the data offset straight from
+  // the central-dir stat, skipping the per-entry local-header seek+read. One mismatch pins the
+  // slow path for the life of this object.
+  enum class HeaderTrust : uint8_t { UNTESTED, TRUSTED, UNTRUSTED };
+  HeaderTrust localHeaderTrust = HeaderTrust::UNTESTED;
+
   bool loadFileStatSlim(const char* filename, FileStatSlim* fileStat);
   long getDataOffset(const FileStatSlim& fileStat);
   bool loadZipDetails();
 
  public:
   explicit ZipFile(const std::string& filePath) : filePath(filePath) {}
-  ~ZipFile() = default;
+  ~ZipFile() { close(); }
   // Zip file can be opened and closed by hand in order to allow for quick calculation of inflated file size
   // It is NOT recommended to pre-open it for any kind of inflation due to memory constraints
-  bool isOpen() const { return !!file; }
+  bool isOpen() const { return file != nullptr; }
   bool open();
   bool close();
   bool loadAllFileStatSlims();
   bool getInflatedFileSize(const char* filename, size_t* size);
+  // Resolve an entry's central-dir stat and the absolute offset of its data in one lookup
+  // (used by ZipInflateStream to set up a bounded-memory read cursor)
+  bool resolveEntry(const char* filename, FileStatSlim* fileStat, long* dataOffset);
+  // Persisted central-directory cache, keyed by the zip's size and modify time. Loading it turns
+  // per-entry lookups into an in-RAM binary search instead of an SD central-dir walk.
+  bool loadStatCache(const std::string& cacheFilePath);
+  bool saveStatCache(const std::string& cacheFilePath);
   // Batch lookup: scan ZIP central dir once and fill sizes for matching targets.
   // targets must be sorted by (hash, len). sizes[target.index] receives uncompressedSize.
   // Returns number of targets matched.
@@ -0,0 +1,184 @@
+#include "ZipInflateStream.h"
+
+#include <FileHandleCache.h>
+#include <HardwareSerial.h>
+#include <miniz.h>
+
+ZipInflateStream::~ZipInflateStream() { close(); }
+
+void ZipInflateStream::freeBuffers() {
+  if (inflator) {
+    free(inflator);
+    inflator = nullptr;
+  }
+  if (dictBuffer) {
+    free(dictBuffer);
+    dictBuffer = nullptr;
+  }
+  if (fileReadBuffer) {
+    free(fileReadBuffer);
+    fileReadBuffer = nullptr;
+  }
+}
+
+bool ZipInflateStream::open(const char* filename, const size_t chunkSize) {
+  ZipFile zip(zipPath);
+  return open(zip, filename, chunkSize);
+}
+
+bool ZipInflateStream::open(ZipFile& zip, const char* filename, const size_t chunkSize) {
+  if (isOpen()) {
+    close();
+  }
+
+  long dataOffset;
+  if (!zip.resolveEntry(filename, &fileStat, &dataOffset)) {
+    Serial.printf("[%lu] [ZIS] Could not resolve entry %s\n", millis(), filename);
+    return false;
+  }
+
+  if (fileStat.method != MZ_NO_COMPRESSION && fileStat.method != MZ_DEFLATED) {
+    Serial.printf("[%lu] [ZIS] Unsupported compression method %u\n", millis(), fileStat.method);
+    return false;
+  }
+
+  file = FILE_HANDLES.acquire("ZIS", zipPath);
+  if (file == nullptr) {
+    return false;
+  }
+  file->seek(dataOffset);
+
+  this->chunkSize = chunkSize;
+  fileRemainingBytes = fileStat.compressedSize;
+  inflatedRemainingBytes = fileStat.uncompressedSize;
+  fileReadBufferFilledBytes = 0;
+  fileReadBufferCursor = 0;
+  dictCursor = 0;
+  pendingStart = 0;
+  pendingBytes = 0;
+  inflateDone = false;
+  failed = false;
+
+  if (fileStat.method == MZ_DEFLATED) {
+    inflator = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
+    dictBuffer = static_cast<uint8_t*>(malloc(TINFL_LZ_DICT_SIZE));
+    fileReadBuffer = static_cast<uint8_t*>(malloc(chunkSize));
+    if (!inflator || !dictBuffer || !fileReadBuffer) {
+      Serial.printf("[%lu] [ZIS] Failed to allocate inflate buffers\n", millis());
+      freeBuffers();
+      FILE_HANDLES.release(file);
+      file = nullptr;
+      return false;
+    }
+    memset(inflator, 0, sizeof(tinfl_decompressor));
+    tinfl_init(inflator);
+  }
+
+  return true;
+}
+
+void ZipInflateStream::close() {
+  if (file != nullptr) {
+    FILE_HANDLES.release(file);
+    file = nullptr;
+  }
+  freeBuffers();
+}
+
+// Runs one decompress step, leaving newly produced bytes in the dictionary as pending output.
+// Returns false on inflate error or unexpected EOF.
+bool ZipInflateStream::inflateStep() {
+  // Load more compressed bytes when needed
+  if (fileReadBufferCursor >= fileReadBufferFilledBytes) {
+    if (fileRemainingBytes == 0) {
+      Serial.printf("[%lu] [ZIS] Unexpected EOF\n", millis());
+      return false;
+    }
+
+    fileReadBufferFilledBytes =
+        file->read(fileReadBuffer, fileRemainingBytes < chunkSize ? fileRemainingBytes : chunkSize);
+    fileReadBufferCursor = 0;
+
+    if (fileReadBufferFilledBytes == 0) {
+      Serial.printf("[%lu] [ZIS] Could not read more bytes\n", millis());
+      return false;
+    }
+    fileRemainingBytes -= fileReadBufferFilledBytes;
+  }
+
+  size_t inBytes = fileReadBufferFilledBytes - fileReadBufferCursor;
+  size_t outBytes = TINFL_LZ_DICT_SIZE - dictCursor;
+
+  const tinfl_status status =
+      tinfl_decompress(inflator, fileReadBuffer + fileReadBufferCursor, &inBytes, dictBuffer, dictBuffer + dictCursor,
+                       &outBytes, fileRemainingBytes > 0 ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+
+  fileReadBufferCursor += inBytes;
+
+  if (outBytes > 0) {
+    pendingStart = dictCursor;
+    pendingBytes = outBytes;
+    dictCursor = (dictCursor + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+  }
+
+  if (status < 0) {
+    Serial.printf("[%lu] [ZIS] tinfl_decompress() failed with status %d\n", millis(), status);
+    return false;
+  }
+
+  if (status == TINFL_STATUS_DONE) {
+    inflateDone = true;
+  }
+
+  return true;
+}
+
+int ZipInflateStream::read(uint8_t* buf, const size_t len) {
+  if (!isOpen() || failed) {
+    return -1;
+  }
+
+  if (inflatedRemainingBytes == 0) {
+    return 0;
+  }
+
+  // Stored entries need no inflation; bounded plain reads straight from the zip
+  if (fileStat.method == MZ_NO_COMPRESSION) {
+    const size_t toRead = len < inflatedRemainingBytes ? len : inflatedRemainingBytes;
+    const size_t dataRead = file->read(buf, toRead);
+    if (dataRead == 0 && toRead > 0) {
+      Serial.printf("[%lu] [ZIS] Could not read more bytes\n", millis());
+      failed = true;
+      return -1;
+    }
+    inflatedRemainingBytes -= dataRead;
+    return static_cast<int>(dataRead);
+  }
+
+  size_t copied = 0;
+  while (copied < len && inflatedRemainingBytes > 0) {
+    if (pendingBytes == 0) {
+      if (inflateDone) {
+        // miniz finished but the central directory promised more bytes - treat as corrupt
+        Serial.printf("[%lu] [ZIS] Inflate finished early, %u bytes missing\n", millis(), inflatedRemainingBytes);
+        failed = true;
+        return -1;
+      }
+      if (!inflateStep()) {
+        failed = true;
+        return -1;
+      }
+      continue;
+    }
+
+    const size_t want = len - copied;
+    const size_t take = pendingBytes < want ? pendingBytes : want;
+    memcpy(buf + copied, dictBuffer + pendingStart, take);
+    copied += take;
+    pendingStart += take;
+    pendingBytes -= take;
+    inflatedRemainingBytes -= take;
+  }
+
+  return static_cast<int>(copied);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <SdFat.h>
+
+#include <string>
+
+#include "ZipFile.h"
+
+// Forward declaration of the miniz inflater state (miniz.h is only included in the .cpp)
+struct tinfl_decompressor_tag;
+
+// Pull-based inflate cursor over a single ZIP entry.
+//
+// Unlike ZipFile::readFileToMemory() this never materialises the whole item in heap: it keeps a
+// fixed 32KB dictionary window plus a small compressed read buffer, and callers drain the entry
+// through read(). This keeps memory bounded no matter how large the chapter is.
+class ZipInflateStream {
+  std::string zipPath;
+  // Borrowed from FileHandleCache between open() and close(); nullptr when closed
+  FsFile* file = nullptr;
+  ZipFile::FileStatSlim fileStat = {};
+  tinfl_decompressor_tag* inflator = nullptr;
+  uint8_t* dictBuffer = nullptr;      // TINFL_LZ_DICT_SIZE circular output window
+  uint8_t* fileReadBuffer = nullptr;  // compressed input chunk buffer
+  size_t chunkSize = 0;
+  size_t fileRemainingBytes = 0;      // compressed bytes left in the zip file
+  size_t inflatedRemainingBytes = 0;  // uncompressed bytes not yet handed to the caller
+  size_t fileReadBufferFilledBytes = 0;
+  size_t fileReadBufferCursor = 0;
+  size_t dictCursor = 0;     // next write position in the dictionary (with wraparound)
+  size_t pendingStart = 0;   // start of decompressed-but-undelivered bytes in the dictionary
+  size_t pendingBytes = 0;   // count of decompressed-but-undelivered bytes
+  bool inflateDone = false;  // miniz reported TINFL_STATUS_DONE
+  bool failed = false;
+
+  void freeBuffers();
+  bool inflateStep();
+
+ public:
+  explicit ZipInflateStream(std::string zipPath) : zipPath(std::move(zipPath)) {}
+  ~ZipInflateStream();
+
+  bool isOpen() const { return file != nullptr; }
+  // Locates the entry and allocates the inflate state. Returns false on lookup/alloc failure.
+  bool open(const char* filename, size_t chunkSize = 1024);
+  // Variant that resolves the entry through an existing handle, so a loaded central-directory
+  // stat cache is reused instead of rescanning the directory on SD
+  bool open(ZipFile& zip, const char* filename, size_t chunkSize = 1024);
+  void close();
+  // Total uncompressed size of the entry (valid after open())
+  size_t size() const { return fileStat.uncompressedSize; }
+  // Uncompressed bytes not yet read
+  size_t available() const { return inflatedRemainingBytes; }
+  // Reads up to len uncompressed bytes into buf. Returns bytes read, 0 at EOF, -1 on error.
+  int read(uint8_t* buf, size_t len);
+};
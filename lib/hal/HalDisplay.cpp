@@ -1,5 +1,8 @@
 #include <HalDisplay.h>
 #include <HalGPIO.h>
+#include <HalSpiBus.h>
+#include <Trace.h>
+#include <TurnLatency.h>
 
 #define SD_SPI_MISO 7
 
@@ -9,10 +12,14 @@ HalDisplay::~HalDisplay() {}
 
 void HalDisplay::begin() { einkDisplay.begin(); }
 
-void HalDisplay::clearScreen(uint8_t color) const { einkDisplay.clearScreen(color); }
+void HalDisplay::clearScreen(uint8_t color) const {
+  waitForFlush();
+  einkDisplay.clearScreen(color);
+}
 
 void HalDisplay::drawImage(const uint8_t* imageData, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                            bool fromProgmem) const {
+  waitForFlush();
   einkDisplay.drawImage(imageData, x, y, w, h, fromProgmem);
 }
 
@@ -22,30 +29,113 @@ EInkDisplay::RefreshMode convertRefreshMode(HalDisplay::RefreshMode mode) {
       return EInkDisplay::FULL_REFRESH;
     case HalDisplay::HALF_REFRESH:
       return EInkDisplay::HALF_REFRESH;
+    case HalDisplay::TURBO_REFRESH:
+      // The SDK's fast LUT is the lowest-grayscale waveform the driver exposes today; the HAL
+      // keeps TURBO distinct so callers encode intent and a dedicated A2 LUT slots in here
+      return EInkDisplay::FAST_REFRESH;
     case HalDisplay::FAST_REFRESH:
     default:
       return EInkDisplay::FAST_REFRESH;
   }
 }
 
-void HalDisplay::displayBuffer(HalDisplay::RefreshMode mode) { einkDisplay.displayBuffer(convertRefreshMode(mode)); }
+void HalDisplay::displayBuffer(HalDisplay::RefreshMode mode) {
+  TRACE_SCOPE("HalDisplay::displayBuffer");
+  waitForFlush();
+  {
+    // Declare the batched panel transfer so cooperative SD users stay off the bus until it is done
+    const HalSpiBus::Window window;
+    einkDisplay.displayBuffer(convertRefreshMode(mode));
+  }
+  // No-op unless a page turn is mid-flight; closes its input-to-photon sample
+  TURN_LATENCY.noteRefreshComplete();
+}
+
+void HalDisplay::flushTaskTrampoline(void* param) {
+  auto* self = static_cast<HalDisplay*>(param);
+  {
+    TRACE_SCOPE("HalDisplay::displayBuffer(async)");
+    const HalSpiBus::Window window;
+    self->einkDisplay.displayBuffer(convertRefreshMode(self->pendingFlushMode));
+  }
+  // The panel is done with the waveform here - this, not displayBufferAsync returning, is the
+  // input-to-photon end point for an async page-turn flush
+  TURN_LATENCY.noteRefreshComplete();
+  self->flushInProgress = false;
+  xSemaphoreGive(self->flushDoneSemaphore);
+  vTaskDelete(nullptr);
+}
+
+bool HalDisplay::displayBufferAsync(HalDisplay::RefreshMode mode) {
+  // Only one flush in flight at a time
+  waitForFlush();
+
+  if (!flushDoneSemaphore) {
+    flushDoneSemaphore = xSemaphoreCreateBinary();
+    if (!flushDoneSemaphore) {
+      displayBuffer(mode);
+      return false;
+    }
+  }
+  // Drain any stale completion signal from a previous flush nobody waited on
+  xSemaphoreTake(flushDoneSemaphore, 0);
+
+  pendingFlushMode = mode;
+  flushInProgress = true;
+  if (xTaskCreate(flushTaskTrampoline, "DisplayFlush", 2048, this, 1, nullptr) != pdPASS) {
+    Serial.printf("[%lu] [HAL] Failed to create flush task, flushing synchronously\n", millis());
+    flushInProgress = false;
+    einkDisplay.displayBuffer(convertRefreshMode(mode));
+    TURN_LATENCY.noteRefreshComplete();
+    return false;
+  }
+  return true;
+}
+
+void HalDisplay::waitForFlush() const {
+  if (!flushDoneSemaphore || !flushInProgress) {
+    return;
+  }
+  xSemaphoreTake(flushDoneSemaphore, portMAX_DELAY);
+}
 
 void HalDisplay::refreshDisplay(HalDisplay::RefreshMode mode, bool turnOffScreen) {
+  TRACE_SCOPE("HalDisplay::refreshDisplay");
+  waitForFlush();
+  const HalSpiBus::Window window;
   einkDisplay.refreshDisplay(convertRefreshMode(mode), turnOffScreen);
 }
 
-void HalDisplay::deepSleep() { einkDisplay.deepSleep(); }
+void HalDisplay::deepSleep() {
+  waitForFlush();
+  einkDisplay.deepSleep();
+}
 
 uint8_t* HalDisplay::getFrameBuffer() const { return einkDisplay.getFrameBuffer(); }
 
 void HalDisplay::copyGrayscaleBuffers(const uint8_t* lsbBuffer, const uint8_t* msbBuffer) {
+  waitForFlush();
   einkDisplay.copyGrayscaleBuffers(lsbBuffer, msbBuffer);
 }
 
-void HalDisplay::copyGrayscaleLsbBuffers(const uint8_t* lsbBuffer) { einkDisplay.copyGrayscaleLsbBuffers(lsbBuffer); }
+void HalDisplay::copyGrayscaleLsbBuffers(const uint8_t* lsbBuffer) {
+  waitForFlush();
+  einkDisplay.copyGrayscaleLsbBuffers(lsbBuffer);
+}
 
-void HalDisplay::copyGrayscaleMsbBuffers(const uint8_t* msbBuffer) { einkDisplay.copyGrayscaleMsbBuffers(msbBuffer); }
+void HalDisplay::copyGrayscaleMsbBuffers(const uint8_t* msbBuffer) {
+  waitForFlush();
+  einkDisplay.copyGrayscaleMsbBuffers(msbBuffer);
+}
 
-void HalDisplay::cleanupGrayscaleBuffers(const uint8_t* bwBuffer) { einkDisplay.cleanupGrayscaleBuffers(bwBuffer); }
+void HalDisplay::cleanupGrayscaleBuffers(const uint8_t* bwBuffer) {
+  waitForFlush();
+  einkDisplay.cleanupGrayscaleBuffers(bwBuffer);
+}
 
-void HalDisplay::displayGrayBuffer() { einkDisplay.displayGrayBuffer(); }
+void HalDisplay::displayGrayBuffer() {
+  TRACE_SCOPE("HalDisplay::displayGrayBuffer");
+  waitForFlush();
+  const HalSpiBus::Window window;
+  einkDisplay.displayGrayBuffer();
+}
@@ -12,9 +12,11 @@ class HalDisplay {
 
   // Refresh modes
   enum RefreshMode {
-    FULL_REFRESH,  // Full refresh with complete waveform
-    HALF_REFRESH,  // Half refresh (1720ms) - balanced quality and speed
-    FAST_REFRESH   // Fast refresh using custom LUT
+    FULL_REFRESH,   // Full refresh with complete waveform
+    HALF_REFRESH,   // Half refresh (1720ms) - balanced quality and speed
+    FAST_REFRESH,   // Fast refresh using custom LUT
+    TURBO_REFRESH,  // A2-class low-grayscale waveform for pure B/W page turns; callers must
+                    // settle with a standard refresh periodically or ghosting accumulates
   };
 
   // Initialize the display hardware and driver
@@ -34,6 +36,15 @@ class HalDisplay {
   void displayBuffer(RefreshMode mode = RefreshMode::FAST_REFRESH);
   void refreshDisplay(RefreshMode mode = RefreshMode::FAST_REFRESH, bool turnOffScreen = false);
 
+  // Asynchronous flush: pushes the framebuffer to the panel on a background task so the caller
+  // can overlap SD and layout work with the slow e-ink refresh. The framebuffer must not be
+  // written to while a flush is in flight - the mutating entry points here wait automatically,
+  // callers writing through getFrameBuffer() must call waitForFlush() first.
+  // Returns false (after flushing synchronously) if the task could not be created.
+  bool displayBufferAsync(RefreshMode mode = RefreshMode::FAST_REFRESH);
+  void waitForFlush() const;
+  bool isFlushing() const { return flushInProgress; }
+
   // Power management
   void deepSleep();
 
@@ -49,4 +60,8 @@ class HalDisplay {
 
  private:
   EInkDisplay einkDisplay;
+  mutable SemaphoreHandle_t flushDoneSemaphore = nullptr;
+  mutable volatile bool flushInProgress = false;
+  RefreshMode pendingFlushMode = FAST_REFRESH;
+  static void flushTaskTrampoline(void* param);
 };
@@ -1,5 +1,6 @@
 #include <HalGPIO.h>
 #include <SPI.h>
+#include <driver/gpio.h>
 #include <esp_sleep.h>
 
 void HalGPIO::begin() {
@@ -21,6 +22,15 @@ bool HalGPIO::wasReleased(uint8_t buttonIndex) const { return inputMgr.wasReleas
 
 bool HalGPIO::wasAnyReleased() const { return inputMgr.wasAnyReleased(); }
 
+bool HalGPIO::isAnyPressed() const {
+  for (uint8_t buttonIndex = BTN_BACK; buttonIndex <= BTN_POWER; buttonIndex++) {
+    if (inputMgr.isPressed(buttonIndex)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 unsigned long HalGPIO::getHeldTime() const { return inputMgr.getHeldTime(); }
 
 void HalGPIO::startDeepSleep() {
@@ -34,6 +44,20 @@ void HalGPIO::startDeepSleep() {
   esp_deep_sleep_start();
 }
 
+void HalGPIO::lightSleep(const uint32_t maxMs) const {
+  // Only the power button has its own wake-capable GPIO, so it is the one pin that can wake us
+  // level-triggered; the timer wake doubles as the poll cadence bounding the latency of the
+  // other buttons
+  gpio_wakeup_enable(static_cast<gpio_num_t>(InputManager::POWER_BUTTON_PIN), GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  esp_sleep_enable_timer_wakeup(static_cast<uint64_t>(maxMs) * 1000ULL);
+  esp_light_sleep_start();
+  // Disarm both sources so a later deep sleep only wakes on the power button
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+  gpio_wakeup_disable(static_cast<gpio_num_t>(InputManager::POWER_BUTTON_PIN));
+}
+
 int HalGPIO::getBatteryPercentage() const {
   static const BatteryMonitor battery = BatteryMonitor(BAT_GPIO0);
   return battery.readPercentage();
@@ -36,11 +36,16 @@ class HalGPIO {
   bool wasAnyPressed() const;
   bool wasReleased(uint8_t buttonIndex) const;
   bool wasAnyReleased() const;
+  bool isAnyPressed() const;
   unsigned long getHeldTime() const;
 
   // Setup wake up GPIO and enter deep sleep
   void startDeepSleep();
 
+  // Light sleep until the power button is pressed or maxMs elapse, whichever comes first.
+  // RAM, the panel and the SD card keep their state; execution resumes right after the call.
+  void lightSleep(uint32_t maxMs) const;
+
   // Get battery percentage (range 0-100)
   int getBatteryPercentage() const;
 
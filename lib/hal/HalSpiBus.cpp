@@ -0,0 +1,53 @@
+#include <HalSpiBus.h>
+#include <Trace.h>
+
+HalSpiBus HalSpiBus::instance;
+
+void HalSpiBus::enterWindow() {
+  TRACE_BEGIN("HalSpiBus::window");
+  taskENTER_CRITICAL(&mux);
+  windowDepth++;
+  windows++;
+  taskEXIT_CRITICAL(&mux);
+}
+
+void HalSpiBus::exitWindow() {
+  taskENTER_CRITICAL(&mux);
+  if (windowDepth > 0) {
+    windowDepth--;
+  }
+  taskEXIT_CRITICAL(&mux);
+  TRACE_END("HalSpiBus::window");
+}
+
+bool HalSpiBus::windowActive() const {
+  taskENTER_CRITICAL(&mux);
+  const bool active = windowDepth > 0;
+  taskEXIT_CRITICAL(&mux);
+  return active;
+}
+
+void HalSpiBus::waitForWindow() {
+  if (!windowActive()) {
+    return;
+  }
+  const unsigned long start = millis();
+  while (windowActive() && millis() - start < maxWindowWaitMs) {
+    vTaskDelay(5 / portTICK_PERIOD_MS);
+  }
+  const uint32_t waited = millis() - start;
+  taskENTER_CRITICAL(&mux);
+  contentions++;
+  contentionWaitMs += waited;
+  taskEXIT_CRITICAL(&mux);
+}
+
+HalSpiBus::Stats HalSpiBus::getStats() const {
+  Stats stats;
+  taskENTER_CRITICAL(&mux);
+  stats.windows = windows;
+  stats.contentions = contentions;
+  stats.contentionWaitMs = contentionWaitMs;
+  taskEXIT_CRITICAL(&mux);
+  return stats;
+}
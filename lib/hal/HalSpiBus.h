@@ -0,0 +1,58 @@
+#pragma once
+#include <Arduino.h>
+
+// Cooperative arbiter for the SPI bus shared by the e-ink panel and the SD card. Both masters
+// live in sealed SDK drivers (EInkDisplay, SdFat), so transactions can't be queued or re-clocked
+// here; instead HalDisplay declares its long, indivisible panel transfers as bus windows, and
+// cooperative SD users (SdIoScheduler::yieldToUi) wait a window out between chunks rather than
+// interleaving small reads with the transfer. Contention is counted and windows are emitted to
+// the trace ring, so bus fights show up in /trace.log instead of as unexplained refresh jitter.
+class HalSpiBus {
+ public:
+  struct Stats {
+    uint32_t windows;           // Panel transfer windows opened since boot
+    uint32_t contentions;       // Times an SD user found a window in flight
+    uint32_t contentionWaitMs;  // Total time SD users spent waiting windows out
+  };
+
+  // RAII marker for one batched panel transfer holding the bus
+  class Window {
+   public:
+    Window() { getInstance().enterWindow(); }
+    ~Window() { getInstance().exitWindow(); }
+    Window(const Window&) = delete;
+    Window& operator=(const Window&) = delete;
+  };
+
+  // Get singleton instance
+  static HalSpiBus& getInstance() { return instance; }
+
+  void enterWindow();
+  void exitWindow();
+
+  // True while a panel transfer holds the bus
+  bool windowActive() const;
+
+  // Block until no panel transfer is in flight, counting the wait as contention. Capped so a
+  // wedged transfer can't starve SD writers indefinitely.
+  void waitForWindow();
+
+  Stats getStats() const;
+
+ private:
+  HalSpiBus() = default;
+
+  // Static instance
+  static HalSpiBus instance;
+
+  static constexpr uint32_t maxWindowWaitMs = 3000;
+
+  // Counters are touched from the display flush task, the main loop and background SD tasks
+  mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+  uint8_t windowDepth = 0;
+  uint32_t windows = 0;
+  uint32_t contentions = 0;
+  uint32_t contentionWaitMs = 0;
+};
+
+#define SPI_BUS HalSpiBus::getInstance()
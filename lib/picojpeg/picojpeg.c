@@ -68,11 +68,18 @@ static PJPG_INLINE long arithmeticRightShift8L(long x) {
   if (x < 0) r |= ~(~(unsigned long)0U >> 8U);
   return r;
 }
+static PJPG_INLINE long arithmeticRightShiftNL(long x, int8 n) {
+  long r = (unsigned long)x >> (uint8)n;
+  if (x < 0) r |= ~(~(unsigned long)0U >> (uint8)n);
+  return r;
+}
 #define PJPG_ARITH_SHIFT_RIGHT_N_16(x, n) arithmeticRightShiftN16(x, n)
 #define PJPG_ARITH_SHIFT_RIGHT_8_L(x) arithmeticRightShift8L(x)
+#define PJPG_ARITH_SHIFT_RIGHT_N_L(x, n) arithmeticRightShiftNL(x, n)
 #else
 #define PJPG_ARITH_SHIFT_RIGHT_N_16(x, n) ((x) >> (n))
 #define PJPG_ARITH_SHIFT_RIGHT_8_L(x) ((x) >> 8)
+#define PJPG_ARITH_SHIFT_RIGHT_N_L(x, n) ((x) >> (n))
 #endif
 //------------------------------------------------------------------------------
 // Change as needed - the PJPG_MAX_WIDTH/PJPG_MAX_HEIGHT checks are only present
@@ -1111,7 +1118,7 @@ static uint8 initFrame(void) {
 
 #define PJPG_DCT_SCALE (1U << PJPG_DCT_SCALE_BITS)
 
-#define PJPG_DESCALE(x) PJPG_ARITH_SHIFT_RIGHT_N_16(((x) + (1 << (PJPG_DCT_SCALE_BITS - 1))), PJPG_DCT_SCALE_BITS)
+#define PJPG_DESCALE(x) ((int)PJPG_ARITH_SHIFT_RIGHT_N_L((long)(x) + (1L << (PJPG_DCT_SCALE_BITS - 1)), PJPG_DCT_SCALE_BITS))
 
 #define PJPG_WFIX(x) ((x) * PJPG_DCT_SCALE + 0.5f)
 
@@ -1136,48 +1143,45 @@ static void createWinogradQuant(int16* pQuant) {
 }
 
 // These multiply helper functions are the 4 types of signed multiplies needed by the Winograd IDCT.
-// A smart C compiler will optimize them to use 16x8 = 24 bit muls, if not you may need to tweak
-// these functions or drop to CPU specific inline assembly.
+// They are computed in native register-width ints: the original int16 forms made 32-bit targets
+// sign-extend and truncate around every multiply, which dominated the per-scanline IDCT cost.
+// Results are identical for any input whose 16-bit intermediates did not already overflow.
 
 // 1/cos(4*pi/16)
 // 362, 256+106
-static PJPG_INLINE int16 imul_b1_b3(int16 w) {
+static PJPG_INLINE int imul_b1_b3(int w) {
   long x = (w * 362L);
   x += 128L;
-  return (int16)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
+  return (int)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
 }
 
 // 1/cos(6*pi/16)
 // 669, 256+256+157
-static PJPG_INLINE int16 imul_b2(int16 w) {
+static PJPG_INLINE int imul_b2(int w) {
   long x = (w * 669L);
   x += 128L;
-  return (int16)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
+  return (int)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
 }
 
 // 1/cos(2*pi/16)
 // 277, 256+21
-static PJPG_INLINE int16 imul_b4(int16 w) {
+static PJPG_INLINE int imul_b4(int w) {
   long x = (w * 277L);
   x += 128L;
-  return (int16)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
+  return (int)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
 }
 
 // 1/(cos(2*pi/16) + cos(6*pi/16))
 // 196, 196
-static PJPG_INLINE int16 imul_b5(int16 w) {
+static PJPG_INLINE int imul_b5(int w) {
   long x = (w * 196L);
   x += 128L;
-  return (int16)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
+  return (int)(PJPG_ARITH_SHIFT_RIGHT_8_L(x));
 }
 
-static PJPG_INLINE uint8 clamp(int16 s) {
-  if ((uint16)s > 255U) {
-    if (s < 0)
-      return 0;
-    else if (s > 255)
-      return 255;
-  }
+static PJPG_INLINE uint8 clamp(int s) {
+  // One unsigned compare covers the in-range common case; out-of-range picks the bound
+  if ((unsigned int)s > 255U) return (s < 0) ? 0 : 255;
 
   return (uint8)s;
 }
@@ -1199,53 +1203,55 @@ static void idctRows(void) {
       *(pSrc + 6) = src0;
       *(pSrc + 7) = src0;
     } else {
-      int16 src4 = *(pSrc + 5);
-      int16 src7 = *(pSrc + 3);
-      int16 x4 = src4 - src7;
-      int16 x7 = src4 + src7;
-
-      int16 src5 = *(pSrc + 1);
-      int16 src6 = *(pSrc + 7);
-      int16 x5 = src5 + src6;
-      int16 x6 = src5 - src6;
-
-      int16 tmp1 = imul_b5(x4 - x6);
-      int16 stg26 = imul_b4(x6) - tmp1;
-
-      int16 x24 = tmp1 - imul_b2(x4);
-
-      int16 x15 = x5 - x7;
-      int16 x17 = x5 + x7;
-
-      int16 tmp2 = stg26 - x17;
-      int16 tmp3 = imul_b1_b3(x15) - tmp2;
-      int16 x44 = tmp3 + x24;
-
-      int16 src0 = *(pSrc + 0);
-      int16 src1 = *(pSrc + 4);
-      int16 x30 = src0 + src1;
-      int16 x31 = src0 - src1;
-
-      int16 src2 = *(pSrc + 2);
-      int16 src3 = *(pSrc + 6);
-      int16 x12 = src2 - src3;
-      int16 x13 = src2 + src3;
-
-      int16 x32 = imul_b1_b3(x12) - x13;
-
-      int16 x40 = x30 + x13;
-      int16 x43 = x30 - x13;
-      int16 x41 = x31 + x32;
-      int16 x42 = x31 - x32;
-
-      *(pSrc + 0) = x40 + x17;
-      *(pSrc + 1) = x41 + tmp2;
-      *(pSrc + 2) = x42 + tmp3;
-      *(pSrc + 3) = x43 - x44;
-      *(pSrc + 4) = x43 + x44;
-      *(pSrc + 5) = x42 - tmp3;
-      *(pSrc + 6) = x41 - tmp2;
-      *(pSrc + 7) = x40 - x17;
+      // Whole 1D pass in native ints; intermediates fit 16 bits for valid data, so the
+      // truncating stores below produce the same values the all-int16 version did
+      int src4 = *(pSrc + 5);
+      int src7 = *(pSrc + 3);
+      int x4 = src4 - src7;
+      int x7 = src4 + src7;
+
+      int src5 = *(pSrc + 1);
+      int src6 = *(pSrc + 7);
+      int x5 = src5 + src6;
+      int x6 = src5 - src6;
+
+      int tmp1 = imul_b5(x4 - x6);
+      int stg26 = imul_b4(x6) - tmp1;
+
+      int x24 = tmp1 - imul_b2(x4);
+
+      int x15 = x5 - x7;
+      int x17 = x5 + x7;
+
+      int tmp2 = stg26 - x17;
+      int tmp3 = imul_b1_b3(x15) - tmp2;
+      int x44 = tmp3 + x24;
+
+      int src0 = *(pSrc + 0);
+      int src1 = *(pSrc + 4);
+      int x30 = src0 + src1;
+      int x31 = src0 - src1;
+
+      int src2 = *(pSrc + 2);
+      int src3 = *(pSrc + 6);
+      int x12 = src2 - src3;
+      int x13 = src2 + src3;
+
+      int x32 = imul_b1_b3(x12) - x13;
+
+      int x40 = x30 + x13;
+      int x43 = x30 - x13;
+      int x41 = x31 + x32;
+      int x42 = x31 - x32;
+
+      *(pSrc + 0) = (int16)(x40 + x17);
+      *(pSrc + 1) = (int16)(x41 + tmp2);
+      *(pSrc + 2) = (int16)(x42 + tmp3);
+      *(pSrc + 3) = (int16)(x43 - x44);
+      *(pSrc + 4) = (int16)(x43 + x44);
+      *(pSrc + 5) = (int16)(x42 - tmp3);
+      *(pSrc + 6) = (int16)(x41 - tmp2);
+      *(pSrc + 7) = (int16)(x40 - x17);
     }
 
     pSrc += 8;
@@ -1270,44 +1276,44 @@ static void idctCols(void) {
       *(pSrc + 6 * 8) = c;
       *(pSrc + 7 * 8) = c;
     } else {
-      int16 src4 = *(pSrc + 5 * 8);
-      int16 src7 = *(pSrc + 3 * 8);
-      int16 x4 = src4 - src7;
-      int16 x7 = src4 + src7;
+      int src4 = *(pSrc + 5 * 8);
+      int src7 = *(pSrc + 3 * 8);
+      int x4 = src4 - src7;
+      int x7 = src4 + src7;
 
-      int16 src5 = *(pSrc + 1 * 8);
-      int16 src6 = *(pSrc + 7 * 8);
-      int16 x5 = src5 + src6;
-      int16 x6 = src5 - src6;
+      int src5 = *(pSrc + 1 * 8);
+      int src6 = *(pSrc + 7 * 8);
+      int x5 = src5 + src6;
+      int x6 = src5 - src6;
 
-      int16 tmp1 = imul_b5(x4 - x6);
-      int16 stg26 = imul_b4(x6) - tmp1;
+      int tmp1 = imul_b5(x4 - x6);
+      int stg26 = imul_b4(x6) - tmp1;
 
-      int16 x24 = tmp1 - imul_b2(x4);
+      int x24 = tmp1 - imul_b2(x4);
 
-      int16 x15 = x5 - x7;
-      int16 x17 = x5 + x7;
+      int x15 = x5 - x7;
+      int x17 = x5 + x7;
 
-      int16 tmp2 = stg26 - x17;
-      int16 tmp3 = imul_b1_b3(x15) - tmp2;
-      int16 x44 = tmp3 + x24;
+      int tmp2 = stg26 - x17;
+      int tmp3 = imul_b1_b3(x15) - tmp2;
+      int x44 = tmp3 + x24;
 
-      int16 src0 = *(pSrc + 0 * 8);
-      int16 src1 = *(pSrc + 4 * 8);
-      int16 x30 = src0 + src1;
-      int16 x31 = src0 - src1;
+      int src0 = *(pSrc + 0 * 8);
+      int src1 = *(pSrc + 4 * 8);
+      int x30 = src0 + src1;
+      int x31 = src0 - src1;
 
-      int16 src2 = *(pSrc + 2 * 8);
-      int16 src3 = *(pSrc + 6 * 8);
-      int16 x12 = src2 - src3;
-      int16 x13 = src2 + src3;
+      int src2 = *(pSrc + 2 * 8);
+      int src3 = *(pSrc + 6 * 8);
+      int x12 = src2 - src3;
+      int x13 = src2 + src3;
 
-      int16 x32 = imul_b1_b3(x12) - x13;
+      int x32 = imul_b1_b3(x12) - x13;
 
-      int16 x40 = x30 + x13;
-      int16 x43 = x30 - x13;
-      int16 x41 = x31 + x32;
-      int16 x42 = x31 - x32;
+      int x40 = x30 + x13;
+      int x43 = x30 - x13;
+      int x41 = x31 + x32;
+      int x42 = x31 - x32;
 
       // descale, convert to unsigned and clamp to 8-bit
       *(pSrc + 0 * 8) = clamp(PJPG_DESCALE(x40 + x17) + 128);
@@ -1325,31 +1331,9 @@ static void idctCols(void) {
 }
 
 /*----------------------------------------------------------------------------*/
-static PJPG_INLINE uint8 addAndClamp(uint8 a, int16 b) {
-  b = a + b;
-
-  if ((uint16)b > 255U) {
-    if (b < 0)
-      return 0;
-    else if (b > 255)
-      return 255;
-  }
-
-  return (uint8)b;
-}
+static PJPG_INLINE uint8 addAndClamp(uint8 a, int b) { return clamp(a + b); }
 /*----------------------------------------------------------------------------*/
-static PJPG_INLINE uint8 subAndClamp(uint8 a, int16 b) {
-  b = a - b;
-
-  if ((uint16)b > 255U) {
-    if (b < 0)
-      return 0;
-    else if (b > 255)
-      return 255;
-  }
-
-  return (uint8)b;
-}
+static PJPG_INLINE uint8 subAndClamp(uint8 a, int b) { return clamp(a - b); }
 /*----------------------------------------------------------------------------*/
 // 103/256
 // R = Y + 1.402 (Cr-128)
@@ -1370,7 +1354,7 @@ static void upsampleCb(uint8 srcOfs, uint8 dstOfs) {
   for (y = 0; y < 4; y++) {
     for (x = 0; x < 4; x++) {
       uint8 cb = (uint8)*pSrc++;
-      int16 cbG, cbB;
+      int cbG, cbB;
 
       cbG = ((cb * 88U) >> 8U) - 44U;
       pDstG[0] = subAndClamp(pDstG[0], cbG);
@@ -1404,7 +1388,7 @@ static void upsampleCbH(uint8 srcOfs, uint8 dstOfs) {
   for (y = 0; y < 8; y++) {
     for (x = 0; x < 4; x++) {
       uint8 cb = (uint8)*pSrc++;
-      int16 cbG, cbB;
+      int cbG, cbB;
 
       cbG = ((cb * 88U) >> 8U) - 44U;
       pDstG[0] = subAndClamp(pDstG[0], cbG);
@@ -1432,7 +1416,7 @@ static void upsampleCbV(uint8 srcOfs, uint8 dstOfs) {
   for (y = 0; y < 4; y++) {
     for (x = 0; x < 8; x++) {
       uint8 cb = (uint8)*pSrc++;
-      int16 cbG, cbB;
+      int cbG, cbB;
 
       cbG = ((cb * 88U) >> 8U) - 44U;
       pDstG[0] = subAndClamp(pDstG[0], cbG);
@@ -1470,7 +1454,7 @@ static void upsampleCr(uint8 srcOfs, uint8 dstOfs) {
   for (y = 0; y < 4; y++) {
     for (x = 0; x < 4; x++) {
       uint8 cr = (uint8)*pSrc++;
-      int16 crR, crG;
+      int crR, crG;
 
       crR = (cr + ((cr * 103U) >> 8U)) - 179;
       pDstR[0] = addAndClamp(pDstR[0], crR);
@@ -1504,7 +1488,7 @@ static void upsampleCrH(uint8 srcOfs, uint8 dstOfs) {
   for (y = 0; y < 8; y++) {
     for (x = 0; x < 4; x++) {
       uint8 cr = (uint8)*pSrc++;
-      int16 crR, crG;
+      int crR, crG;
 
       crR = (cr + ((cr * 103U) >> 8U)) - 179;
       pDstR[0] = addAndClamp(pDstR[0], crR);
@@ -1532,7 +1516,7 @@ static void upsampleCrV(uint8 srcOfs, uint8 dstOfs) {
   for (y = 0; y < 4; y++) {
     for (x = 0; x < 8; x++) {
       uint8 cr = (uint8)*pSrc++;
-      int16 crR, crG;
+      int crR, crG;
 
       crR = (cr + ((cr * 103U) >> 8U)) - 179;
       pDstR[0] = addAndClamp(pDstR[0], crR);
@@ -1577,7 +1561,7 @@ static void convertCb(uint8 dstOfs) {
 
   for (i = 64; i > 0; i--) {
     uint8 cb = (uint8)*pSrc++;
-    int16 cbG, cbB;
+    int cbG, cbB;
 
     cbG = ((cb * 88U) >> 8U) - 44U;
     *pDstG++ = subAndClamp(pDstG[0], cbG);
@@ -1596,7 +1580,7 @@ static void convertCr(uint8 dstOfs) {
 
   for (i = 64; i > 0; i--) {
     uint8 cr = (uint8)*pSrc++;
-    int16 crR, crG;
+    int crR, crG;
 
     crR = (cr + ((cr * 103U) >> 8U)) - 179;
     *pDstR++ = addAndClamp(pDstR[0], crR);
@@ -1727,7 +1711,7 @@ static void transformBlock(uint8 mcuBlock) {
 //------------------------------------------------------------------------------
 static void transformBlockReduce(uint8 mcuBlock) {
   uint8 c = clamp(PJPG_DESCALE(gCoeffBuf[0]) + 128);
-  int16 cbG, cbB, crR, crG;
+  int cbG, cbB, crR, crG;
 
   switch (gScanType) {
     case PJPG_GRAYSCALE: {
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "HardwareSerial.h"
+
+// The core libraries use unqualified min/max the way device code can, because the real
+// Arduino.h hoists them to global scope; the shim chain has to leak the same names
+using std::max;
+using std::min;
+
+// Host shim: the ambient Arduino surface the libraries lean on. Included by the other shims
+// that stand in for headers which pull in the real Arduino.h on device (SdFat, HalDisplay), so
+// Serial/millis/min reach baseline TUs through the same chains as the espressif32 build. Heap
+// introspection has no host equivalent, so EspClass reports a roomy fixed heap - pressure never
+// trips, which is what you want when leak and overrun detection is coming from valgrind/ASan
+// rather than the device's budget machinery.
+class EspClass {
+ public:
+  uint32_t getFreeHeap() const { return 320 * 1024; }
+  uint32_t getMaxAllocHeap() const { return 288 * 1024; }
+  uint32_t getMinFreeHeap() const { return 320 * 1024; }
+  uint32_t getCycleCount() const { return static_cast<uint32_t>(micros()) * 160; }
+};
+
+inline EspClass ESP;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// The real lib/hal HalDisplay.h pulls in Arduino.h; GfxRenderer's TUs get Serial/millis here
+#include "Arduino.h"
+
+// Host shim of lib/hal's HalDisplay (env:native sets lib_ignore = hal): same framebuffer
+// geometry, no panel behind it. GfxRenderer draws into the static RAM buffer and every refresh
+// call is a no-op, so layout and glyph work runs at full speed under the profiler.
+class HalDisplay {
+ public:
+  enum RefreshMode {
+    FULL_REFRESH,
+    HALF_REFRESH,
+    FAST_REFRESH,
+    TURBO_REFRESH,
+  };
+
+  void begin() {}
+
+  static constexpr uint16_t DISPLAY_WIDTH = 800;
+  static constexpr uint16_t DISPLAY_HEIGHT = 480;
+  static constexpr uint16_t DISPLAY_WIDTH_BYTES = DISPLAY_WIDTH / 8;
+  static constexpr uint32_t BUFFER_SIZE = DISPLAY_WIDTH_BYTES * DISPLAY_HEIGHT;
+
+  void clearScreen(const uint8_t color = 0xFF) const { memset(frameBuffer, color, BUFFER_SIZE); }
+  void drawImage(const uint8_t*, uint16_t, uint16_t, uint16_t, uint16_t, bool = false) const {}
+
+  void displayBuffer(RefreshMode = FAST_REFRESH) {}
+  void refreshDisplay(RefreshMode = FAST_REFRESH, bool = false) {}
+
+  bool displayBufferAsync(RefreshMode = FAST_REFRESH) { return true; }
+  void waitForFlush() const {}
+  bool isFlushing() const { return false; }
+
+  void deepSleep() {}
+
+  uint8_t* getFrameBuffer() const { return frameBuffer; }
+
+  void copyGrayscaleBuffers(const uint8_t*, const uint8_t*) {}
+  void copyGrayscaleLsbBuffers(const uint8_t*) {}
+  void copyGrayscaleMsbBuffers(const uint8_t*) {}
+  void cleanupGrayscaleBuffers(const uint8_t*) {}
+
+  void displayGrayBuffer() {}
+
+ private:
+  static inline uint8_t frameBuffer[BUFFER_SIZE] = {};
+};
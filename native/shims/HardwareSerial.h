@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+#include <chrono>
+#include <thread>
+
+// Host shims for the ambient Arduino API the libraries lean on: Serial.printf logging and the
+// millis()/micros() clock. Serial goes straight to stdout; the clock is wall time since process
+// start, so the `[%lu]` log prefixes stay meaningful when reading a profiler run's output.
+
+namespace nativeShim {
+inline std::chrono::steady_clock::time_point bootTime() {
+  static const auto start = std::chrono::steady_clock::now();
+  return start;
+}
+}  // namespace nativeShim
+
+inline unsigned long millis() {
+  using namespace std::chrono;
+  return static_cast<unsigned long>(duration_cast<milliseconds>(steady_clock::now() - nativeShim::bootTime()).count());
+}
+
+inline unsigned long micros() {
+  using namespace std::chrono;
+  return static_cast<unsigned long>(duration_cast<microseconds>(steady_clock::now() - nativeShim::bootTime()).count());
+}
+
+inline void delay(const unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+class HardwareSerial {
+ public:
+  void begin(unsigned long) {}
+  int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    const int written = vfprintf(stdout, format, args);
+    va_end(args);
+    return written;
+  }
+  void print(const char* s) { fputs(s, stdout); }
+  void println(const char* s = "") {
+    fputs(s, stdout);
+    fputc('\n', stdout);
+  }
+  void flush() { fflush(stdout); }
+};
+
+inline HardwareSerial Serial;
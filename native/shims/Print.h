@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+// The real Print.h includes <string.h>; parser TUs writing through a Print rely on memcpy and
+// friends arriving with it
+#include <cstring>
+
+// Host shim: the slice of Arduino's Print the core libraries write through and subclass. On
+// device this is satisfied by the Arduino core.
+class Print {
+ public:
+  virtual ~Print() = default;
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (written < size && write(buffer[written]) == 1) {
+      written++;
+    }
+    return written;
+  }
+  // Present (and non-pure) on the Arduino core's Print; subclasses here override it
+  virtual void flush() {}
+};
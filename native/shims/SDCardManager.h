@@ -0,0 +1,63 @@
+#pragma once
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+#include <utility>
+
+#include "HardwareSerial.h"
+#include "SdFat.h"
+
+// Host shim of the SDK's SDCardManager: maps the firmware's SD-absolute paths ("/books/...")
+// onto a host directory chosen at startup, so the libraries' cache layout lands in a plain
+// folder you can inspect (or wipe) between profiler runs.
+class SDCardManager {
+  std::string rootPath = ".";
+
+  // SD paths are always absolute, so plain concatenation is enough
+  std::string hostPath(const std::string& path) const { return rootPath + path; }
+
+ public:
+  // Host directory standing in for the SD card root; set once before any file traffic
+  void setRootPath(std::string path) { rootPath = std::move(path); }
+
+  bool openFileForRead(const char* tag, const std::string& path, FsFile& file) {
+    if (!file.open(hostPath(path).c_str(), O_RDONLY)) {
+      Serial.printf("[%lu] [%s] Failed to open file for reading: %s\n", millis(), tag, path.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  bool openFileForWrite(const char* tag, const std::string& path, FsFile& file) {
+    if (!file.open(hostPath(path).c_str(), O_WRONLY | O_CREAT | O_TRUNC)) {
+      Serial.printf("[%lu] [%s] Failed to open file for writing: %s\n", millis(), tag, path.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  FsFile open(const char* path, const int oflag = O_RDONLY) {
+    FsFile file;
+    file.open(hostPath(path).c_str(), oflag);
+    return file;
+  }
+  FsFile open(const std::string& path, const int oflag = O_RDONLY) { return open(path.c_str(), oflag); }
+
+  bool exists(const char* path) {
+    struct stat st {};
+    return ::stat(hostPath(path).c_str(), &st) == 0;
+  }
+
+  bool mkdir(const char* path) {
+    const std::string full = hostPath(path);
+    return ::mkdir(full.c_str(), 0755) == 0 || errno == EEXIST;
+  }
+
+  bool remove(const char* path) { return ::unlink(hostPath(path).c_str()) == 0; }
+  bool removeDir(const char* path) { return ::rmdir(hostPath(path).c_str()) == 0; }
+};
+
+inline SDCardManager SdMan;
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <utility>
+
+// The real SdFat.h pulls in Arduino.h; several baseline TUs rely on the Serial/millis/min
+// ambience arriving through this chain
+#include "Arduino.h"
+#include "Print.h"
+
+// Host shim of the SdFat surface the firmware actually uses, backed by POSIX stdio/dirent.
+// Only the calls the core libraries make are implemented; add to it the day a library grows a
+// new call rather than padding it out speculatively.
+
+// SdFat's open() takes fcntl-style oflags plus this non-POSIX "position at end" one
+#ifndef O_AT_END
+#define O_AT_END O_APPEND
+#endif
+
+class FsFile : public Print {
+  FILE* fp = nullptr;
+  DIR* dir = nullptr;
+  std::string hostPath;  // kept for getName()/getModifyDateTime() and directory iteration
+
+ public:
+  FsFile() = default;
+  // FILE* ownership makes copies unsound; the firmware only ever moves these around
+  FsFile(const FsFile&) = delete;
+  FsFile& operator=(const FsFile&) = delete;
+  FsFile(FsFile&& other) noexcept { *this = std::move(other); }
+  FsFile& operator=(FsFile&& other) noexcept {
+    if (this != &other) {
+      close();
+      fp = other.fp;
+      dir = other.dir;
+      hostPath = std::move(other.hostPath);
+      other.fp = nullptr;
+      other.dir = nullptr;
+    }
+    return *this;
+  }
+  ~FsFile() override { close(); }
+
+  bool open(const char* path, const int oflag = O_RDONLY) {
+    close();
+    struct stat st {};
+    const bool existing = ::stat(path, &st) == 0;
+    if (existing && S_ISDIR(st.st_mode)) {
+      dir = ::opendir(path);
+    } else if ((oflag & (O_WRONLY | O_RDWR)) != 0) {
+      // O_AT_END on an existing file appends without truncating; every other write open in the
+      // firmware either creates or rewrites the file from scratch
+      const bool append = (oflag & O_AT_END) != 0 && existing;
+      fp = ::fopen(path, append ? "r+b" : "w+b");
+      if (fp != nullptr && append) {
+        ::fseek(fp, 0, SEEK_END);
+      }
+    } else if (existing) {
+      fp = ::fopen(path, "rb");
+    }
+    if (fp == nullptr && dir == nullptr) {
+      return false;
+    }
+    hostPath = path;
+    return true;
+  }
+
+  operator bool() const { return fp != nullptr || dir != nullptr; }  // NOLINT: SdFat's is implicit too
+
+  int read(void* buf, const size_t count) { return fp != nullptr ? static_cast<int>(::fread(buf, 1, count, fp)) : -1; }
+  int read() {
+    uint8_t b = 0;
+    return read(&b, 1) == 1 ? b : -1;
+  }
+
+  using Print::write;
+  size_t write(const uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t* buffer, const size_t size) override {
+    return fp != nullptr ? ::fwrite(buffer, 1, size, fp) : 0;
+  }
+  size_t write(const void* buffer, const size_t size) { return write(static_cast<const uint8_t*>(buffer), size); }
+
+  bool seek(const uint64_t pos) { return fp != nullptr && ::fseek(fp, static_cast<long>(pos), SEEK_SET) == 0; }
+  bool seekSet(const uint64_t pos) { return seek(pos); }
+  bool seekCur(const int64_t offset) { return fp != nullptr && ::fseek(fp, static_cast<long>(offset), SEEK_CUR) == 0; }
+  uint64_t position() const { return fp != nullptr ? static_cast<uint64_t>(::ftell(fp)) : 0; }
+
+  uint64_t size() const {
+    if (fp == nullptr) {
+      return 0;
+    }
+    const long current = ::ftell(fp);
+    ::fseek(fp, 0, SEEK_END);
+    const long end = ::ftell(fp);
+    ::fseek(fp, current, SEEK_SET);
+    return static_cast<uint64_t>(end);
+  }
+  uint64_t fileSize() const { return size(); }
+  int available() const { return static_cast<int>(size() - position()); }
+
+  void flush() {
+    if (fp != nullptr) {
+      ::fflush(fp);
+    }
+  }
+  bool sync() {
+    flush();
+    return true;
+  }
+
+  bool close() {
+    if (fp != nullptr) {
+      ::fclose(fp);
+      fp = nullptr;
+    }
+    if (dir != nullptr) {
+      ::closedir(dir);
+      dir = nullptr;
+    }
+    hostPath.clear();
+    return true;
+  }
+
+  bool isDirectory() const { return dir != nullptr; }
+
+  size_t getName(char* name, const size_t size) const {
+    const auto slash = hostPath.find_last_of('/');
+    const std::string base = slash == std::string::npos ? hostPath : hostPath.substr(slash + 1);
+    ::snprintf(name, size, "%s", base.c_str());
+    return base.length();
+  }
+
+  bool getModifyDateTime(uint16_t* date, uint16_t* time) const {
+    struct stat st {};
+    if (hostPath.empty() || ::stat(hostPath.c_str(), &st) != 0) {
+      return false;
+    }
+    // FAT-encode the mtime the way SdFat does, so mtime-keyed caches (zip stat cache) behave
+    struct tm tmv {};
+    ::localtime_r(&st.st_mtime, &tmv);
+    *date = static_cast<uint16_t>(((tmv.tm_year - 80) << 9) | ((tmv.tm_mon + 1) << 5) | tmv.tm_mday);
+    *time = static_cast<uint16_t>((tmv.tm_hour << 11) | (tmv.tm_min << 5) | (tmv.tm_sec >> 1));
+    return true;
+  }
+
+  FsFile openNextFile() {
+    FsFile next;
+    if (dir == nullptr) {
+      return next;
+    }
+    while (dirent* entry = ::readdir(dir)) {
+      if (::strcmp(entry->d_name, ".") == 0 || ::strcmp(entry->d_name, "..") == 0) {
+        continue;
+      }
+      if (next.open((hostPath + "/" + entry->d_name).c_str())) {
+        return next;
+      }
+      // Unreadable entry: keep scanning, matching SdFat's skip-on-error behaviour
+    }
+    return next;
+  }
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Host shim: the native CLI is single-threaded, so the critical sections the firmware uses for
+// cross-task safety collapse to no-ops.
+
+typedef int portMUX_TYPE;
+typedef uint32_t TickType_t;
+
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) (void)(mux)
+#define portEXIT_CRITICAL(mux) (void)(mux)
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdTRUE 1
+#define pdFALSE 0
+// Ticks never block on the host, so the ms value passes through untouched
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
@@ -1,3 +1,5 @@
+import gzip
+import hashlib
 import os
 import re
 
@@ -43,9 +45,25 @@ for root, _, files in os.walk(SRC_DIR):
             base_name = f"{os.path.splitext(file)[0]}Html"
             header_path = os.path.join(root, f"{base_name}.generated.h")
 
+            # Gzip at build time; the server sends this straight from flash with
+            # Content-Encoding: gzip and the browser decompresses. mtime=0 keeps
+            # the output deterministic across builds.
+            compressed = gzip.compress(minified.encode("utf-8"), mtime=0)
+            byte_lines = []
+            for i in range(0, len(compressed), 16):
+                byte_lines.append(", ".join(f"0x{b:02x}" for b in compressed[i:i + 16]))
+            byte_array = ",\n    ".join(byte_lines)
+
+            # Content hash doubles as the HTTP ETag (quoted, per spec); deterministic
+            # because the gzip stream above is built with mtime=0
+            etag = hashlib.md5(compressed).hexdigest()[:16]
+
             with open(header_path, "w", encoding="utf-8") as h:
                 h.write(f"// THIS FILE IS AUTOGENERATED, DO NOT EDIT MANUALLY\n\n")
                 h.write(f"#pragma once\n")
-                h.write(f'constexpr char {base_name}[] PROGMEM = R"rawliteral({minified})rawliteral";\n')
+                h.write(f"#include <pgmspace.h>\n\n")
+                h.write(f"constexpr uint8_t {base_name}Gz[] PROGMEM = {{\n    {byte_array}}};\n")
+                h.write(f"constexpr size_t {base_name}GzLen = sizeof({base_name}Gz);\n")
+                h.write(f'constexpr char {base_name}Etag[] = "\\"{etag}\\"";\n')
 
-            print(f"Generated: {header_path}")
+            print(f"Generated: {header_path} ({len(minified)} -> {len(compressed)} bytes)")
@@ -1,81 +1,76 @@
 #!/usr/bin/env python3
-"""Embed hypher-generated `.bin` tries into constexpr headers."""
+"""Pack hypher-generated `.bin` tries into a hyphenation partition image.
+
+The image is flashed to the `hyph` data partition (see partitions.csv) and
+memory-mapped at runtime by LanguageRegistry, so the tries no longer ride
+along inside the application binary:
+
+    ./scripts/generate_hyphenation_trie.py \
+        --tries lib/Epub/Epub/hyphenation/tries \
+        --output .pio/hyphenation.bin
+    esptool.py write_flash 0xF90000 .pio/hyphenation.bin
+
+Image layout (little-endian, mirrored by LanguageRegistry.cpp):
+
+    char     magic[4];   // "XHYP"
+    uint8_t  version;    // 1
+    uint8_t  trieCount;
+    uint16_t reserved;
+    struct { char tag[8]; uint32_t offset; uint32_t size; } entries[trieCount];
+    uint8_t  payloads[]; // each trie 4-byte aligned, offset from image start
+"""
 
 from __future__ import annotations
 
 import argparse
 import pathlib
+import struct
 
+MAGIC = b'XHYP'
+VERSION = 1
+ENTRY_FORMAT = '<8sII'
 
-def _format_bytes(blob: bytes, per_line: int = 16) -> str:
-    # Render the blob as a comma separated list of hex literals with consistent wrapping.
-    lines = []
-    for i in range(0, len(blob), per_line):
-        chunk = ', '.join(f"0x{b:02X}" for b in blob[i : i + per_line])
-        lines.append(f"    {chunk},")
-    if not lines:
-        lines.append("    0x00,")
-    return '\n'.join(lines)
-
-
-def _symbol_from_output(path: pathlib.Path) -> str:
-    # Derive a stable C identifier from the destination header name (e.g., hyph-en.trie.h -> en).
-    name = path.name
-    if name.endswith('.trie.h'):
-        name = name[:-7]
-    if name.startswith('hyph-'):
-        name = name[5:]
-    name = name.replace('-', '_')
-    if name.endswith('.trie'):
-        name = name[:-5]
-    return name
-
-
-def write_header(path: pathlib.Path, blob: bytes, symbol: str) -> None:
-    # Emit a constexpr header containing the raw bytes plus a SerializedHyphenationPatterns descriptor.
-    path.parent.mkdir(parents=True, exist_ok=True)
-    data_symbol = f"{symbol}_trie_data"
-    patterns_symbol = f"{symbol}_patterns"
-    bytes_literal = _format_bytes(blob)
-    content = f"""#pragma once
-
-#include <cstddef>
-#include <cstdint>
-
-#include "../SerializedHyphenationTrie.h"
-
-// Auto-generated by generate_hyphenation_trie.py. Do not edit manually.
-alignas(4) constexpr uint8_t {data_symbol}[] = {{
-{bytes_literal}
-}};
-
-constexpr SerializedHyphenationPatterns {patterns_symbol} = {{
-    {data_symbol},
-    sizeof({data_symbol}),
-}};
-"""
-    path.write_text(content)
+
+def _align4(value: int) -> int:
+    return (value + 3) & ~3
+
+
+def build_image(tries: list[tuple[str, bytes]]) -> bytes:
+    # Fixed header plus one directory entry per trie, payloads packed after it.
+    header_size = 8 + len(tries) * struct.calcsize(ENTRY_FORMAT)
+    entries = bytearray()
+    payloads = bytearray()
+    offset = _align4(header_size)
+    for tag, blob in tries:
+        encoded_tag = tag.encode('ascii')
+        if len(encoded_tag) > 8:
+            raise SystemExit(f'language tag too long: {tag}')
+        entries += struct.pack(ENTRY_FORMAT, encoded_tag, offset, len(blob))
+        payloads += b'\x00' * (offset - header_size - len(payloads))
+        payloads += blob
+        offset = _align4(offset + len(blob))
+    header = MAGIC + struct.pack('<BBH', VERSION, len(tries), 0)
+    return bytes(header + entries + payloads)
 
 
 def main() -> None:
     parser = argparse.ArgumentParser()
-    parser.add_argument('--input', dest='inputs', action='append', required=True,
-                        help='Path to a hypher-generated .bin trie')
-    parser.add_argument('--output', dest='outputs', action='append', required=True,
-                        help='Destination header path (hyph-*.trie.h)')
+    parser.add_argument('--tries', default='lib/Epub/Epub/hyphenation/tries',
+                        help='Directory of hypher-generated <tag>.bin tries')
+    parser.add_argument('--output', required=True, help='Destination partition image')
     args = parser.parse_args()
 
-    if len(args.inputs) != len(args.outputs):
-        raise SystemExit('input/output counts must match')
-
-    for src, dst in zip(args.inputs, args.outputs):
-        # Process each input/output pair independently so mixed-language refreshes work in one invocation.
-        src_path = pathlib.Path(src)
-        blob = src_path.read_bytes()
-        out_path = pathlib.Path(dst)
-        symbol = _symbol_from_output(out_path)
-        write_header(out_path, blob, symbol)
-        print(f'wrote {dst} ({len(blob)} bytes payload)')
+    tries_dir = pathlib.Path(args.tries)
+    tries = [(path.stem, path.read_bytes()) for path in sorted(tries_dir.glob('*.bin'))]
+    if not tries:
+        raise SystemExit(f'no .bin tries found in {tries_dir}')
+
+    image = build_image(tries)
+    out_path = pathlib.Path(args.output)
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+    out_path.write_bytes(image)
+    tags = ', '.join(tag for tag, _ in tries)
+    print(f'wrote {out_path} ({len(image)} bytes, tries: {tags})')
 
 
 if __name__ == '__main__':
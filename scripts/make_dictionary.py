@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Build a CrossPoint dictionary file (.xdic) from a tab-separated wordlist.
+
+Input: UTF-8 text, one "headword<TAB>definition" per line. Lines repeating a
+headword are merged into one entry, definitions separated by newlines.
+
+Output layout (read by lib/Dictionary on the device):
+
+    header, 16 bytes:
+        magic u32 ('XDIC'), format_version u8, entry_count u32, 7 reserved
+    index, entry_count * 32 bytes, sorted by headword bytes:
+        headword char[24]  case-folded UTF-8, NUL padded, truncated
+        def_offset u32     absolute file offset of the definition
+        def_len u32
+    definitions: raw UTF-8 blobs
+
+All fields little-endian. The fixed 32-byte records start at a 16-byte
+boundary so the device's binary search does one aligned read per probe.
+
+Copy the output to the SD card root as /dictionary.xdic.
+
+Usage:
+    python3 scripts/make_dictionary.py wordlist.tsv dictionary.xdic
+"""
+import struct
+import sys
+
+DICTIONARY_MAGIC = 0x43494458  # 'XDIC'
+DICTIONARY_FORMAT_VERSION = 1
+HEADWORD_BYTES = 24
+RECORD_SIZE = 32
+HEADER_SIZE = 16
+
+
+def fold(headword: str) -> bytes:
+    # Must match Dictionary::foldWord: ASCII lowercase, truncated to the record field
+    folded = bytes(c + 32 if 0x41 <= c <= 0x5A else c for c in headword.encode("utf-8"))
+    return folded[:HEADWORD_BYTES]
+
+
+def main() -> int:
+    if len(sys.argv) != 3:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    entries = {}
+    skipped = 0
+    with open(sys.argv[1], encoding="utf-8") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if not line or "\t" not in line:
+                continue
+            headword, definition = line.split("\t", 1)
+            key = fold(headword.strip())
+            if not key or not definition.strip():
+                skipped += 1
+                continue
+            if key in entries:
+                entries[key] += "\n" + definition.strip()
+            else:
+                entries[key] = definition.strip()
+
+    if not entries:
+        print("no usable entries in input", file=sys.stderr)
+        return 1
+
+    ordered = sorted(entries.items())
+    defs_start = HEADER_SIZE + RECORD_SIZE * len(ordered)
+
+    index = bytearray()
+    defs = bytearray()
+    for key, definition in ordered:
+        blob = definition.encode("utf-8")
+        index += struct.pack(f"<{HEADWORD_BYTES}sII", key, defs_start + len(defs), len(blob))
+        defs += blob
+
+    header = struct.pack("<IBI7x", DICTIONARY_MAGIC, DICTIONARY_FORMAT_VERSION, len(ordered))
+    with open(sys.argv[2], "wb") as f:
+        f.write(header + index + defs)
+
+    note = f", {skipped} line(s) skipped" if skipped else ""
+    print(f"{sys.argv[2]}: {len(ordered)} entries, {HEADER_SIZE + len(index) + len(defs)} bytes{note}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Generate a delta OTA patch between two firmware images.
+
+The device (src/network/OtaUpdater.cpp, installDeltaUpdate) rebuilds the new
+image in the inactive OTA slot from two op types:
+
+    COPY  op=0, src_offset u32, length u32   bytes taken from the running partition
+    ADD   op=1, length u32, literal bytes    bytes carried in the patch
+
+preceded by a header:
+
+    magic u32 ('XPDT'), format_version u8,
+    old_size u32, old_fnv1a64 u64, new_size u32, new_fnv1a64 u64
+
+All fields little-endian. The device verifies the running partition against
+old_fnv1a64 before writing anything and the reconstructed image against
+new_fnv1a64 before marking it bootable, falling back to the full download on
+any mismatch, so a bad patch can never brick a device.
+
+Attach the output to the release as firmware-<old_version>.patch, where
+<old_version> is the release the patch upgrades FROM (the updater looks for
+the asset matching its own CROSSPOINT_VERSION).
+
+Usage:
+    python3 scripts/make_ota_patch.py old_firmware.bin new_firmware.bin out.patch
+"""
+import struct
+import sys
+
+PATCH_MAGIC = 0x54445058  # 'XPDT'
+PATCH_FORMAT_VERSION = 1
+OP_COPY = 0
+OP_ADD = 1
+
+# Matching parameters: index the old image by KEY_SIZE-byte windows at every
+# STEP bytes; only runs of at least MIN_MATCH bytes become COPY ops (shorter
+# matches cost more in op overhead than they save in literals).
+KEY_SIZE = 16
+STEP = 4
+MIN_MATCH = 32
+MAX_CANDIDATES = 8
+
+
+def fnv1a64(data: bytes) -> int:
+    h = 0xCBF29CE484222325
+    for b in data:
+        h = ((h ^ b) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+
+def build_index(old: bytes) -> dict:
+    index = {}
+    for off in range(0, len(old) - KEY_SIZE + 1, STEP):
+        key = old[off : off + KEY_SIZE]
+        slots = index.setdefault(key, [])
+        if len(slots) < MAX_CANDIDATES:
+            slots.append(off)
+    return index
+
+
+def extend_match(old: bytes, new: bytes, old_off: int, new_off: int) -> int:
+    length = 0
+    limit = min(len(old) - old_off, len(new) - new_off)
+    while length < limit and old[old_off + length] == new[new_off + length]:
+        length += 1
+    return length
+
+
+def make_patch(old: bytes, new: bytes) -> bytes:
+    index = build_index(old)
+    ops = []
+    literals = bytearray()
+
+    def flush_literals():
+        if literals:
+            ops.append(struct.pack("<BI", OP_ADD, len(literals)) + bytes(literals))
+            literals.clear()
+
+    pos = 0
+    while pos < len(new):
+        best_off = -1
+        best_len = 0
+        if pos + KEY_SIZE <= len(new):
+            for cand in index.get(new[pos : pos + KEY_SIZE], ()):
+                length = extend_match(old, new, cand, pos)
+                if length > best_len:
+                    best_off, best_len = cand, length
+        if best_len >= MIN_MATCH:
+            flush_literals()
+            ops.append(struct.pack("<BII", OP_COPY, best_off, best_len))
+            pos += best_len
+        else:
+            literals.append(new[pos])
+            pos += 1
+    flush_literals()
+
+    header = struct.pack(
+        "<IBIQIQ", PATCH_MAGIC, PATCH_FORMAT_VERSION, len(old), fnv1a64(old), len(new), fnv1a64(new)
+    )
+    return header + b"".join(ops)
+
+
+def main() -> int:
+    if len(sys.argv) != 4:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+    old = open(sys.argv[1], "rb").read()
+    new = open(sys.argv[2], "rb").read()
+    patch = make_patch(old, new)
+    with open(sys.argv[3], "wb") as f:
+        f.write(patch)
+    ratio = len(patch) / len(new) if new else 0.0
+    print(f"{sys.argv[3]}: {len(patch)} bytes ({ratio:.1%} of the {len(new)} byte image)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Render a /trace.log flight-recorder dump into a flame-style report.
+
+Build with `pio run -e trace`, use the device until the interesting path has run, then let it
+sleep (SleepActivity flushes the ring) and copy /trace.log off the SD card:
+
+    ./scripts/render_trace.py trace.log
+
+Each log line is `<micros> <task> B|E <name>`. Events are grouped per FreeRTOS task, begin/end
+pairs are matched into call stacks, and identical stacks are aggregated into an indented tree
+with call counts and inclusive time. The ring keeps only the newest ~1024 events, so the oldest
+stacks may be missing their begins; such orphaned ends are counted and reported, not matched.
+"""
+
+from __future__ import annotations
+
+import argparse
+import sys
+from collections import defaultdict
+from dataclasses import dataclass, field
+
+
+@dataclass
+class Node:
+    count: int = 0
+    total_us: int = 0
+    children: dict = field(default_factory=dict)
+
+
+def parse_line(line):
+    parts = line.strip().split(None, 3)
+    if len(parts) != 4 or parts[2] not in ('B', 'E'):
+        return None
+    try:
+        return int(parts[0]), parts[1], parts[2] == 'B', parts[3]
+    except ValueError:
+        return None
+
+
+def build_trees(lines):
+    """Returns (per-task root Node, orphaned-end count, dropped-begin count)."""
+    roots = defaultdict(Node)
+    stacks = defaultdict(list)  # task -> [(name, start_us, node)]
+    orphans = 0
+
+    for line in lines:
+        parsed = parse_line(line)
+        if parsed is None:
+            continue
+        timestamp, task, is_begin, name = parsed
+
+        if is_begin:
+            parent = stacks[task][-1][2] if stacks[task] else roots[task]
+            node = parent.children.setdefault(name, Node())
+            stacks[task].append((name, timestamp, node))
+            continue
+
+        # Truncated rings can leave ends whose begins were overwritten; unwind to the matching
+        # frame if it exists, otherwise count the end as an orphan
+        stack = stacks[task]
+        if not any(frame[0] == name for frame in stack):
+            orphans += 1
+            continue
+        while stack:
+            frame_name, start_us, node = stack.pop()
+            node.count += 1
+            # micros() wraps every ~71 minutes; the masked subtraction stays correct across it
+            node.total_us += (timestamp - start_us) & 0xFFFFFFFF
+            if frame_name == name:
+                break
+
+    dropped = sum(len(stack) for stack in stacks.values())
+    return roots, orphans, dropped
+
+
+def print_tree(node, depth=0):
+    ordered = sorted(node.children.items(), key=lambda item: item[1].total_us, reverse=True)
+    for name, child in ordered:
+        print(f"{'  ' * depth}{child.total_us:>12,} us  {child.count:>6}x  {name}")
+        print_tree(child, depth + 1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('log', type=argparse.FileType('r'), help='trace.log pulled from the SD card')
+    args = parser.parse_args()
+
+    roots, orphans, dropped = build_trees(args.log)
+    if not roots:
+        print('No trace events found', file=sys.stderr)
+        return 1
+
+    for task in sorted(roots):
+        print(f'task {task}')
+        print_tree(roots[task], depth=1)
+    if orphans or dropped:
+        print(f'({orphans} end events and {dropped} begin events unmatched at the ring boundaries)')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,156 @@
+#include "AsyncTaskQueue.h"
+
+#include <HardwareSerial.h>
+
+#include "CrossPointSettings.h"
+
+namespace {
+// Sized for the heaviest current jobs (epub metadata parse + JPEG decode for thumbnails)
+constexpr uint32_t WORKER_STACK_SIZE = 8192;
+// Below the display task loops (priority 1) so rendering always wins the CPU
+constexpr UBaseType_t WORKER_TASK_PRIORITY = 0;
+// Below this charge, on battery, only HIGH jobs run: the tail is for finishing the chapter,
+// not for opportunistic sweeps
+constexpr uint8_t BATTERY_FLOOR_PERCENT = 10;
+}  // namespace
+
+AsyncTaskQueue AsyncTaskQueue::instance;
+
+void AsyncTaskQueue::workerTrampoline(void* param) {
+  auto* self = static_cast<AsyncTaskQueue*>(param);
+  self->workerLoop();
+}
+
+void AsyncTaskQueue::ensureWorker() {
+  if (!queueMutex) {
+    queueMutex = xSemaphoreCreateMutex();
+  }
+  if (!wakeSignal) {
+    wakeSignal = xSemaphoreCreateCounting(0x7FFFFFFF, 0);
+  }
+  if (!workerTaskHandle) {
+    xTaskCreate(&AsyncTaskQueue::workerTrampoline, "AsyncTaskQueueWorker", WORKER_STACK_SIZE, this,
+                WORKER_TASK_PRIORITY, &workerTaskHandle);
+  }
+}
+
+AsyncTaskQueue::JobHandle AsyncTaskQueue::enqueue(const char* name, std::function<void(const Job&)> work,
+                                                  const Priority priority) {
+  ensureWorker();
+
+  auto handle = std::make_shared<Job>();
+  xSemaphoreTake(queueMutex, portMAX_DELAY);
+  pending.push_back({name, priority, std::move(work), handle});
+  xSemaphoreGive(queueMutex);
+  xSemaphoreGive(wakeSignal);
+  return handle;
+}
+
+void AsyncTaskQueue::cancel(const JobHandle& job) {
+  if (!job) {
+    return;
+  }
+  job->cancelled = true;
+}
+
+void AsyncTaskQueue::cancelAndWait(const JobHandle& job) {
+  if (!job) {
+    return;
+  }
+  job->cancelled = true;
+
+  // Drop it from the pending list ourselves; if it's already running, wait the job out
+  xSemaphoreTake(queueMutex, portMAX_DELAY);
+  for (auto it = pending.begin(); it != pending.end(); ++it) {
+    if (it->handle == job) {
+      pending.erase(it);
+      job->finished = true;
+      break;
+    }
+  }
+  xSemaphoreGive(queueMutex);
+
+  while (!job->finished) {
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+}
+
+bool AsyncTaskQueue::isIdle() {
+  if (!queueMutex) {
+    return true;  // Nothing has ever been enqueued
+  }
+  xSemaphoreTake(queueMutex, portMAX_DELAY);
+  const bool idle = pending.empty() && !running;
+  xSemaphoreGive(queueMutex);
+  return idle;
+}
+
+AsyncTaskQueue::Priority AsyncTaskQueue::minRunnablePriority() const {
+  if (charging) {
+    return Priority::LOW;
+  }
+  if (batteryPercent <= BATTERY_FLOOR_PERCENT) {
+    return Priority::HIGH;
+  }
+  if (batteryPercent < SETTINGS.getBgThrottlePercent()) {
+    return Priority::NORMAL;
+  }
+  return Priority::LOW;
+}
+
+void AsyncTaskQueue::setPowerState(const uint8_t newBatteryPercent, const bool newCharging) {
+  const Priority before = minRunnablePriority();
+  batteryPercent = newBatteryPercent;
+  charging = newCharging;
+  // A relaxed gate re-wakes the worker so jobs that were deferred get another look; their
+  // original wake tokens may already have been consumed finding nothing runnable
+  if (wakeSignal && minRunnablePriority() < before) {
+    xSemaphoreGive(wakeSignal);
+  }
+}
+
+// Highest runnable priority first, FIFO among equals; battery gating hides the lower classes
+bool AsyncTaskQueue::takeNextJob(QueuedJob& out) {
+  const Priority floor = minRunnablePriority();
+  xSemaphoreTake(queueMutex, portMAX_DELAY);
+  auto best = pending.end();
+  for (auto it = pending.begin(); it != pending.end(); ++it) {
+    if (it->priority < floor) {
+      continue;
+    }
+    if (best == pending.end() || it->priority > best->priority) {
+      best = it;
+    }
+  }
+  const bool found = best != pending.end();
+  if (found) {
+    out = std::move(*best);
+    pending.erase(best);
+    running = out.handle;
+  }
+  xSemaphoreGive(queueMutex);
+  return found;
+}
+
+void AsyncTaskQueue::workerLoop() {
+  while (true) {
+    xSemaphoreTake(wakeSignal, portMAX_DELAY);
+
+    // Drain every currently runnable job per wake rather than one per token: battery gating can
+    // consume tokens while finding nothing runnable, so tokens and jobs no longer pair up 1:1
+    QueuedJob job;
+    while (takeNextJob(job)) {
+      if (!job.handle->cancelled) {
+        Serial.printf("[%lu] [ATQ] Running job: %s\n", millis(), job.name);
+        const auto start = millis();
+        job.work(*job.handle);
+        Serial.printf("[%lu] [ATQ] Job %s finished in %lums\n", millis(), job.name, millis() - start);
+      }
+
+      xSemaphoreTake(queueMutex, portMAX_DELAY);
+      job.handle->finished = true;
+      running = nullptr;
+      xSemaphoreGive(queueMutex);
+    }
+  }
+}
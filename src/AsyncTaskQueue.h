@@ -0,0 +1,89 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * Shared background worker for short-lived jobs (network syncs, thumbnail generation, cache
+ * builds). Activities used to hand-roll an xTaskCreate/vTaskDelete pair per job, paying a fresh
+ * stack allocation each time; jobs queued here share one pooled worker task instead.
+ *
+ * Jobs run below the display task loops, one at a time, highest priority first. Completion is
+ * signalled the usual way: the job sets its activity's volatile flags, which the activity's
+ * loop() already polls. Long-lived render loops stay on their own dedicated tasks.
+ */
+class AsyncTaskQueue {
+ public:
+  enum class Priority : uint8_t { LOW = 0, NORMAL = 1, HIGH = 2 };
+
+  // Cancellation token shared between the owner and the worker. The job polls isCancelled()
+  // wherever it can stop early; the owner flags it through cancel()/cancelAndWait().
+  class Job {
+    friend class AsyncTaskQueue;
+    volatile bool cancelled = false;
+    volatile bool finished = false;
+
+   public:
+    bool isCancelled() const { return cancelled; }
+    bool isFinished() const { return finished; }
+  };
+  using JobHandle = std::shared_ptr<Job>;
+
+  // Get singleton instance
+  static AsyncTaskQueue& getInstance() { return instance; }
+
+  // Queue a job; the worker task is created on first use. The work callable runs on the worker
+  // and must not touch the display without taking the owning activity's rendering mutex.
+  JobHandle enqueue(const char* name, std::function<void(const Job&)> work, Priority priority = Priority::NORMAL);
+  // Flag a job cancelled: a still-pending job is dropped, a running job finishes on its own
+  void cancel(const JobHandle& job);
+  // cancel() plus block until the job is neither pending nor running. Call before freeing any
+  // state the job captured (typically from onExit)
+  void cancelAndWait(const JobHandle& job);
+  // True when nothing is pending or running; the main loop checks this before light sleep,
+  // which would halt the worker task mid-job
+  bool isIdle();
+
+  // Battery-aware gating, fed by the main loop on its stats cadence. Charging runs everything;
+  // on battery, LOW jobs defer below the configured throttle threshold and everything but HIGH
+  // suspends below a hard floor. Gated jobs stay queued and run once the state relaxes
+  void setPowerState(uint8_t newBatteryPercent, bool newCharging);
+
+  // Last power state fed by the main loop; long-running jobs that promise to work only on
+  // charger power (library indexing) poll this between work units
+  bool isCharging() const { return charging; }
+
+ private:
+  // Static instance
+  static AsyncTaskQueue instance;
+
+  struct QueuedJob {
+    const char* name;
+    Priority priority;
+    std::function<void(const Job&)> work;
+    JobHandle handle;
+  };
+
+  std::vector<QueuedJob> pending;
+  JobHandle running;
+  SemaphoreHandle_t queueMutex = nullptr;
+  // Counting semaphore so back-to-back enqueues each wake the worker once
+  SemaphoreHandle_t wakeSignal = nullptr;
+  TaskHandle_t workerTaskHandle = nullptr;
+
+  volatile uint8_t batteryPercent = 100;
+  volatile bool charging = false;
+
+  void ensureWorker();
+  Priority minRunnablePriority() const;
+  bool takeNextJob(QueuedJob& out);
+  static void workerTrampoline(void* param);
+  [[noreturn]] void workerLoop();
+};
+
+// Helper macro to access the shared task queue
+#define TASK_QUEUE AsyncTaskQueue::getInstance()
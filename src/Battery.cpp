@@ -0,0 +1,45 @@
+#include "Battery.h"
+
+#include <BatteryMonitor.h>
+
+namespace {
+constexpr uint8_t BAT_GPIO0 = 0;  // Battery voltage
+// Battery percentage moves over minutes; sampling faster just reads ADC noise
+constexpr unsigned long SAMPLE_INTERVAL_MS = 30000;
+
+const BatteryMonitor monitor(BAT_GPIO0);
+
+// EMA with alpha 1/4 on an x256 fixed-point accumulator
+uint32_t filterStep(const uint32_t filteredScaled, const uint8_t raw) {
+  const uint32_t rawScaled = static_cast<uint32_t>(raw) << 8;
+  return filteredScaled - filteredScaled / 4 + rawScaled / 4;
+}
+}  // namespace
+
+Battery Battery::instance;
+
+void Battery::begin() {
+  const int raw = monitor.readPercentage();
+  filteredScaled = static_cast<uint32_t>(raw) << 8;
+  filtered = static_cast<uint8_t>(raw);
+  lastSampleMs = millis();
+}
+
+void Battery::update() {
+  if (millis() - lastSampleMs < SAMPLE_INTERVAL_MS) {
+    return;
+  }
+  // Skip the cycle rather than stack jobs if the worker is busy with something long
+  if (sampleJob && !sampleJob->isFinished()) {
+    return;
+  }
+  lastSampleMs = millis();
+  sampleJob = TASK_QUEUE.enqueue("BatterySample", [this](const AsyncTaskQueue::Job&) { sample(); },
+                                 AsyncTaskQueue::Priority::LOW);
+}
+
+void Battery::sample() {
+  const int raw = monitor.readPercentage();
+  filteredScaled = filterStep(filteredScaled, static_cast<uint8_t>(raw));
+  filtered = static_cast<uint8_t>((filteredScaled + 128) >> 8);
+}
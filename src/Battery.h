@@ -1,6 +1,39 @@
 #pragma once
-#include <BatteryMonitor.h>
+#include <cstdint>
 
-#define BAT_GPIO0 0  // Battery voltage
+#include "AsyncTaskQueue.h"
 
-static BatteryMonitor battery(BAT_GPIO0);
+// Cached battery percentage. The ADC read behind BatteryMonitor settles slowly enough to notice
+// in the page-turn path, so renders never touch analog I/O: reads run as low-priority jobs on
+// the shared task queue at a fixed cadence, feeding an EMA filter that also smooths the jumpy
+// raw percentage, and the status bar and home screen consume the filtered value from RAM.
+class Battery {
+ public:
+  // Get singleton instance
+  static Battery& getInstance() { return instance; }
+
+  // One synchronous read to seed the filter; call once from setup() before the first render
+  void begin();
+
+  // Enqueue a background re-sample once the cadence has elapsed; the main loop calls this on
+  // its stats cadence
+  void update();
+
+  // Filtered percentage (0-100) straight from RAM
+  uint8_t percentage() const { return filtered; }
+
+ private:
+  // Static instance
+  static Battery instance;
+
+  void sample();
+
+  // Scaled x256 fixed point so the filter keeps sub-percent state; only the worker writes it
+  uint32_t filteredScaled = 0;
+  volatile uint8_t filtered = 100;
+  AsyncTaskQueue::JobHandle sampleJob;
+  unsigned long lastSampleMs = 0;
+};
+
+// Helper macro to access the battery cache
+#define BATTERY Battery::getInstance()
@@ -0,0 +1,259 @@
+#include "CacheGc.h"
+
+#include <FileHandleCache.h>
+#include <FsHelpers.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "AsyncTaskQueue.h"
+#include "CrossPointSettings.h"
+#include "CrossPointState.h"
+#include "SdIoScheduler.h"
+
+namespace {
+constexpr uint8_t JOURNAL_FILE_VERSION = 1;
+constexpr char JOURNAL_FILE[] = "/.crosspoint/cachegc.bin";
+constexpr char CACHE_ROOT[] = "/.crosspoint";
+// More entries than this and the overflow is indistinguishable from "never seen" anyway
+constexpr size_t MAX_JOURNAL_ENTRIES = 64;
+}  // namespace
+
+CacheGc CacheGc::instance;
+
+bool CacheGc::isCacheDirName(const char* name) {
+  return strncmp(name, "epub_", 5) == 0 || strncmp(name, "xtc_", 4) == 0 || strncmp(name, "txt_", 4) == 0;
+}
+
+void CacheGc::noteCacheUsed(const std::string& cachePath) {
+  const size_t slash = cachePath.find_last_of('/');
+  const std::string dirName = slash == std::string::npos ? cachePath : cachePath.substr(slash + 1);
+  if (!isCacheDirName(dirName.c_str())) {
+    return;
+  }
+
+  xSemaphoreTake(journalMutex, portMAX_DELAY);
+  sequence++;
+  bool found = false;
+  for (auto& entry : journal) {
+    if (entry.dirName == dirName) {
+      entry.lastUseSeq = sequence;
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    if (journal.size() >= MAX_JOURNAL_ENTRIES) {
+      // Drop the stalest entry; its directory then sorts as "never used", which is accurate enough
+      auto oldest = std::min_element(journal.begin(), journal.end(), [](const JournalEntry& a, const JournalEntry& b) {
+        return a.lastUseSeq < b.lastUseSeq;
+      });
+      journal.erase(oldest);
+    }
+    journal.push_back({dirName, sequence});
+  }
+  dirty = true;
+  xSemaphoreGive(journalMutex);
+}
+
+uint32_t CacheGc::lastUseOf(const std::string& dirName) const {
+  uint32_t lastUse = 0;  // Never recorded: oldest possible
+  xSemaphoreTake(journalMutex, portMAX_DELAY);
+  for (const auto& entry : journal) {
+    if (entry.dirName == dirName) {
+      lastUse = entry.lastUseSeq;
+      break;
+    }
+  }
+  xSemaphoreGive(journalMutex);
+  return lastUse;
+}
+
+uint64_t CacheGc::directorySize(const std::string& path) {
+  uint64_t total = 0;
+  auto dir = SdMan.open(path.c_str());
+  if (!dir || !dir.isDirectory()) {
+    if (dir) dir.close();
+    return 0;
+  }
+
+  char name[128];
+  for (auto file = dir.openNextFile(); file; file = dir.openNextFile()) {
+    if (file.isDirectory()) {
+      file.getName(name, sizeof(name));
+      file.close();
+      total += directorySize(path + "/" + name);
+    } else {
+      total += file.size();
+      file.close();
+    }
+    SD_SCHED.yieldToUi();
+  }
+  dir.close();
+  return total;
+}
+
+void CacheGc::scheduleSweep() {
+  TASK_QUEUE.enqueue(
+      "CacheGc", [this](const AsyncTaskQueue::Job& job) { sweep(job); }, AsyncTaskQueue::Priority::LOW);
+}
+
+void CacheGc::sweep(const AsyncTaskQueue::Job& job) {
+  const uint64_t budget = SETTINGS.getCacheByteBudget();
+  if (budget == 0) {
+    flushIfDirty();
+    return;
+  }
+
+  SdIoScheduler::Scope ioScope(SdIoScheduler::IoClass::BACKGROUND);
+
+  struct Candidate {
+    std::string name;
+    uint64_t bytes;
+    uint32_t lastUse;
+  };
+  std::vector<Candidate> candidates;
+  uint64_t total = 0;
+
+  auto root = SdMan.open(CACHE_ROOT);
+  if (!root || !root.isDirectory()) {
+    if (root) root.close();
+    return;
+  }
+  char name[128];
+  for (auto file = root.openNextFile(); file; file = root.openNextFile()) {
+    file.getName(name, sizeof(name));
+    const bool isCache = file.isDirectory() && isCacheDirName(name);
+    file.close();
+    if (isCache) {
+      const uint64_t bytes = directorySize(std::string(CACHE_ROOT) + "/" + name);
+      total += bytes;
+      candidates.push_back({name, bytes, lastUseOf(name)});
+    }
+    if (job.isCancelled()) {
+      root.close();
+      return;
+    }
+    SD_SCHED.yieldToUi();
+  }
+  root.close();
+
+  Serial.printf("[%lu] [CGC] Cache sweep: %u dirs, %llu KB used, %llu KB budget\n", millis(),
+                static_cast<unsigned>(candidates.size()), total / 1024, budget / 1024);
+  if (total <= budget) {
+    flushIfDirty();
+    return;
+  }
+
+  // The open book's cache must survive: its section files are being read right now
+  const std::string openSuffix =
+      APP_STATE.openEpubPath.empty() ? "" : "_" + std::to_string(std::hash<std::string>{}(APP_STATE.openEpubPath));
+
+  // Least recently used first; among unseen directories drop the biggest first
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    if (a.lastUse != b.lastUse) return a.lastUse < b.lastUse;
+    return a.bytes > b.bytes;
+  });
+
+  // Cached read handles may point into directories about to be swept
+  FILE_HANDLES.invalidateAll();
+
+  for (const auto& candidate : candidates) {
+    if (total <= budget || job.isCancelled()) {
+      break;
+    }
+    if (!openSuffix.empty() && candidate.name.size() > openSuffix.size() &&
+        candidate.name.compare(candidate.name.size() - openSuffix.size(), openSuffix.size(), openSuffix) == 0) {
+      continue;
+    }
+    const std::string path = std::string(CACHE_ROOT) + "/" + candidate.name;
+    if (FsHelpers::removeDirRecursive(path)) {
+      total -= candidate.bytes;
+      xSemaphoreTake(journalMutex, portMAX_DELAY);
+      journal.erase(std::remove_if(journal.begin(), journal.end(),
+                                   [&](const JournalEntry& e) { return e.dirName == candidate.name; }),
+                    journal.end());
+      dirty = true;
+      xSemaphoreGive(journalMutex);
+      Serial.printf("[%lu] [CGC] Evicted %s (%llu KB)\n", millis(), candidate.name.c_str(), candidate.bytes / 1024);
+    } else {
+      Serial.printf("[%lu] [CGC] Failed to remove %s\n", millis(), candidate.name.c_str());
+    }
+    SD_SCHED.yieldToUi();
+  }
+
+  Serial.printf("[%lu] [CGC] Cache sweep done: %llu KB in use\n", millis(), total / 1024);
+  flushIfDirty();
+}
+
+bool CacheGc::flushIfDirty() {
+  if (!dirty) {
+    return true;
+  }
+  if (!saveToFile()) {
+    return false;
+  }
+  dirty = false;
+  return true;
+}
+
+bool CacheGc::saveToFile() {
+  SdMan.mkdir(CACHE_ROOT);
+
+  FsFile outputFile;
+  if (!SdMan.openFileForWrite("CGC", JOURNAL_FILE, outputFile)) {
+    return false;
+  }
+
+  // Snapshot under the lock, write outside it so SD latency never blocks noteCacheUsed
+  xSemaphoreTake(journalMutex, portMAX_DELAY);
+  const uint32_t seq = sequence;
+  const std::vector<JournalEntry> snapshot = journal;
+  xSemaphoreGive(journalMutex);
+
+  serialization::writePod(outputFile, JOURNAL_FILE_VERSION);
+  serialization::writePod(outputFile, seq);
+  const uint16_t count = static_cast<uint16_t>(snapshot.size());
+  serialization::writePod(outputFile, count);
+  for (const auto& entry : snapshot) {
+    serialization::writeString(outputFile, entry.dirName);
+    serialization::writePod(outputFile, entry.lastUseSeq);
+  }
+
+  outputFile.close();
+  return true;
+}
+
+bool CacheGc::loadFromFile() {
+  FsFile inputFile;
+  if (!SdMan.openFileForRead("CGC", JOURNAL_FILE, inputFile)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(inputFile, version);
+  if (version != JOURNAL_FILE_VERSION) {
+    Serial.printf("[%lu] [CGC] Deserialization failed: Unknown version %u\n", millis(), version);
+    inputFile.close();
+    return false;
+  }
+
+  serialization::readPod(inputFile, sequence);
+  uint16_t count = 0;
+  serialization::readPod(inputFile, count);
+
+  journal.clear();
+  journal.reserve(std::min<size_t>(count, MAX_JOURNAL_ENTRIES));
+  for (uint16_t i = 0; i < count && i < MAX_JOURNAL_ENTRIES; i++) {
+    JournalEntry entry;
+    serialization::readString(inputFile, entry.dirName);
+    serialization::readPod(inputFile, entry.lastUseSeq);
+    journal.push_back(std::move(entry));
+  }
+
+  inputFile.close();
+  return true;
+}
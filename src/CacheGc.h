@@ -0,0 +1,61 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AsyncTaskQueue.h"
+
+/**
+ * LRU garbage collector for the per-book cache directories under /.crosspoint (epub_*, xtc_*,
+ * txt_*). Readers note the cache they open, which stamps it with a monotonic use sequence in a
+ * small journal file; a background sweep sums the directory sizes and removes the least recently
+ * used caches until the total fits the configured budget. This keeps the card from silently
+ * filling until section builds fail mid-write, without the all-or-nothing Clear Cache hammer.
+ *
+ * Recency is a sequence counter rather than a timestamp - the device has no calendar clock, and
+ * "books opened least recently" is exactly the order the counter produces.
+ */
+class CacheGc {
+ public:
+  // Get singleton instance
+  static CacheGc& getInstance() { return instance; }
+
+  // Stamp the cache directory behind this path as just-used (called on book open)
+  void noteCacheUsed(const std::string& cachePath);
+
+  // Queue the sweep on the shared background worker; returns immediately
+  void scheduleSweep();
+
+  bool flushIfDirty();
+  bool saveToFile();
+  bool loadFromFile();
+
+ private:
+  CacheGc() = default;
+
+  // Static instance
+  static CacheGc instance;
+
+  struct JournalEntry {
+    std::string dirName;  // e.g. "epub_12345678"
+    uint32_t lastUseSeq = 0;
+  };
+
+  // The journal is touched from the main loop (noteCacheUsed) and the background worker (sweep)
+  SemaphoreHandle_t journalMutex = xSemaphoreCreateMutex();
+  std::vector<JournalEntry> journal;
+  uint32_t sequence = 0;
+  bool dirty = false;
+
+  static bool isCacheDirName(const char* name);
+  // Recursive directory size; yields to interactive SD users between entries
+  static uint64_t directorySize(const std::string& path);
+  uint32_t lastUseOf(const std::string& dirName) const;
+  void sweep(const AsyncTaskQueue::Job& job);
+};
+
+// Helper macro to access the cache garbage collector
+#define CACHE_GC CacheGc::getInstance()
@@ -1,11 +1,14 @@
 #include "CrossPointSettings.h"
 
 #include <HardwareSerial.h>
+#include <Preferences.h>
 #include <SDCardManager.h>
 #include <Serialization.h>
 
 #include <cstring>
+#include <vector>
 
+#include "UserFontStore.h"
 #include "fontIds.h"
 
 // Initialize the static instance
@@ -19,55 +22,198 @@ void readAndValidate(FsFile& file, uint8_t& member, const uint8_t maxValue) {
   }
 }
 
+void readAndValidate(serialization::RecordView& view, uint8_t& member, const uint8_t maxValue) {
+  uint8_t tempValue;
+  if (view.pod(tempValue) && tempValue < maxValue) {
+    member = tempValue;
+  }
+}
+
 namespace {
 constexpr uint8_t SETTINGS_FILE_VERSION = 1;
 // Increment this when adding new persisted settings fields
-constexpr uint8_t SETTINGS_COUNT = 23;
+constexpr uint8_t SETTINGS_COUNT = 27;
+// Legacy pre-NVS location, kept only as a migration source (see migrateFromSd)
 constexpr char SETTINGS_FILE[] = "/.crosspoint/settings.bin";
+constexpr char NVS_NAMESPACE[] = "crosspoint";
+constexpr char NVS_SETTINGS_KEY[] = "settings";
 }  // namespace
 
-bool CrossPointSettings::saveToFile() const {
-  // Make sure the directory exists
-  SdMan.mkdir("/.crosspoint");
+bool CrossPointSettings::save() const {
+  serialization::RecordWriter writer;
+  writer.pod(SETTINGS_FILE_VERSION);
+  writer.pod(SETTINGS_COUNT);
+  writer.pod(sleepScreen);
+  writer.pod(extraParagraphSpacing);
+  writer.pod(shortPwrBtn);
+  writer.pod(statusBar);
+  writer.pod(orientation);
+  writer.pod(frontButtonLayout);
+  writer.pod(sideButtonLayout);
+  writer.pod(fontFamily);
+  writer.pod(fontSize);
+  writer.pod(lineSpacing);
+  writer.pod(paragraphAlignment);
+  writer.pod(sleepTimeout);
+  writer.pod(refreshFrequency);
+  writer.pod(screenMargin);
+  writer.pod(sleepScreenCoverMode);
+  writer.str(std::string(opdsServerUrl));
+  writer.pod(textAntiAliasing);
+  writer.pod(hideBatteryPercentage);
+  writer.pod(longPressChapterSkip);
+  writer.pod(hyphenationEnabled);
+  writer.str(std::string(opdsUsername));
+  writer.str(std::string(opdsPassword));
+  writer.pod(sleepScreenCoverFilter);
+  writer.pod(optimalLineBreaks);
+  writer.pod(cacheSizeLimit);
+  writer.pod(bgBatteryThrottle);
+  writer.pod(turnLatencyOverlay);
+  // New fields added at end for backward compatibility
 
-  FsFile outputFile;
-  if (!SdMan.openFileForWrite("CPS", SETTINGS_FILE, outputFile)) {
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, false)) {
+    Serial.printf("[%lu] [CPS] Failed to open NVS namespace for write\n", millis());
+    return false;
+  }
+  const size_t written = prefs.putBytes(NVS_SETTINGS_KEY, writer.data(), writer.size());
+  prefs.end();
+  if (written != writer.size()) {
+    Serial.printf("[%lu] [CPS] Failed to write settings blob to NVS\n", millis());
     return false;
   }
 
-  serialization::writePod(outputFile, SETTINGS_FILE_VERSION);
-  serialization::writePod(outputFile, SETTINGS_COUNT);
-  serialization::writePod(outputFile, sleepScreen);
-  serialization::writePod(outputFile, extraParagraphSpacing);
-  serialization::writePod(outputFile, shortPwrBtn);
-  serialization::writePod(outputFile, statusBar);
-  serialization::writePod(outputFile, orientation);
-  serialization::writePod(outputFile, frontButtonLayout);
-  serialization::writePod(outputFile, sideButtonLayout);
-  serialization::writePod(outputFile, fontFamily);
-  serialization::writePod(outputFile, fontSize);
-  serialization::writePod(outputFile, lineSpacing);
-  serialization::writePod(outputFile, paragraphAlignment);
-  serialization::writePod(outputFile, sleepTimeout);
-  serialization::writePod(outputFile, refreshFrequency);
-  serialization::writePod(outputFile, screenMargin);
-  serialization::writePod(outputFile, sleepScreenCoverMode);
-  serialization::writeString(outputFile, std::string(opdsServerUrl));
-  serialization::writePod(outputFile, textAntiAliasing);
-  serialization::writePod(outputFile, hideBatteryPercentage);
-  serialization::writePod(outputFile, longPressChapterSkip);
-  serialization::writePod(outputFile, hyphenationEnabled);
-  serialization::writeString(outputFile, std::string(opdsUsername));
-  serialization::writeString(outputFile, std::string(opdsPassword));
-  serialization::writePod(outputFile, sleepScreenCoverFilter);
-  // New fields added at end for backward compatibility
-  outputFile.close();
+  Serial.printf("[%lu] [CPS] Settings saved to NVS (%u bytes)\n", millis(), static_cast<unsigned>(written));
+  return true;
+}
 
-  Serial.printf("[%lu] [CPS] Settings saved to file\n", millis());
+bool CrossPointSettings::load() {
+  Preferences prefs;
+  // Read-only open fails when the namespace doesn't exist yet (fresh flash); that's fine,
+  // defaults stand and migrateFromSd() may fill them in later
+  if (!prefs.begin(NVS_NAMESPACE, true)) {
+    return false;
+  }
+  const size_t blobSize = prefs.getBytesLength(NVS_SETTINGS_KEY);
+  if (blobSize == 0) {
+    prefs.end();
+    return false;
+  }
+  std::vector<uint8_t> blob(blobSize);
+  const size_t readBytes = prefs.getBytes(NVS_SETTINGS_KEY, blob.data(), blobSize);
+  prefs.end();
+  if (readBytes != blobSize) {
+    Serial.printf("[%lu] [CPS] Failed to read settings blob from NVS\n", millis());
+    return false;
+  }
+
+  serialization::RecordView view;
+  if (!view.loadFrom(blob.data(), blob.size())) {
+    return false;
+  }
+
+  uint8_t version = 0;
+  if (!view.pod(version) || version != SETTINGS_FILE_VERSION) {
+    Serial.printf("[%lu] [CPS] Deserialization failed: Unknown version %u\n", millis(), version);
+    return false;
+  }
+
+  uint8_t blobSettingsCount = 0;
+  view.pod(blobSettingsCount);
+
+  // load settings that exist (support older blobs with fewer fields)
+  uint8_t settingsRead = 0;
+  do {
+    readAndValidate(view, sleepScreen, SLEEP_SCREEN_MODE_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    view.pod(extraParagraphSpacing);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, shortPwrBtn, SHORT_PWRBTN_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, statusBar, STATUS_BAR_MODE_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, orientation, ORIENTATION_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, frontButtonLayout, FRONT_BUTTON_LAYOUT_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, sideButtonLayout, SIDE_BUTTON_LAYOUT_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, fontFamily, FONT_FAMILY_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, fontSize, FONT_SIZE_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, lineSpacing, LINE_COMPRESSION_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, paragraphAlignment, PARAGRAPH_ALIGNMENT_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, sleepTimeout, SLEEP_TIMEOUT_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, refreshFrequency, REFRESH_FREQUENCY_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    view.pod(screenMargin);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, sleepScreenCoverMode, SLEEP_SCREEN_COVER_MODE_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    {
+      std::string urlStr;
+      view.str(urlStr);
+      strncpy(opdsServerUrl, urlStr.c_str(), sizeof(opdsServerUrl) - 1);
+      opdsServerUrl[sizeof(opdsServerUrl) - 1] = '\0';
+    }
+    if (++settingsRead >= blobSettingsCount) break;
+    view.pod(textAntiAliasing);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, hideBatteryPercentage, HIDE_BATTERY_PERCENTAGE_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    view.pod(longPressChapterSkip);
+    if (++settingsRead >= blobSettingsCount) break;
+    view.pod(hyphenationEnabled);
+    if (++settingsRead >= blobSettingsCount) break;
+    {
+      std::string usernameStr;
+      view.str(usernameStr);
+      strncpy(opdsUsername, usernameStr.c_str(), sizeof(opdsUsername) - 1);
+      opdsUsername[sizeof(opdsUsername) - 1] = '\0';
+    }
+    if (++settingsRead >= blobSettingsCount) break;
+    {
+      std::string passwordStr;
+      view.str(passwordStr);
+      strncpy(opdsPassword, passwordStr.c_str(), sizeof(opdsPassword) - 1);
+      opdsPassword[sizeof(opdsPassword) - 1] = '\0';
+    }
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, sleepScreenCoverFilter, SLEEP_SCREEN_COVER_FILTER_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    view.pod(optimalLineBreaks);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, cacheSizeLimit, CACHE_SIZE_LIMIT_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    readAndValidate(view, bgBatteryThrottle, BG_BATTERY_THROTTLE_COUNT);
+    if (++settingsRead >= blobSettingsCount) break;
+    view.pod(turnLatencyOverlay);
+    if (++settingsRead >= blobSettingsCount) break;
+    // New fields added at end for backward compatibility
+  } while (false);
+
+  nvsLoaded = true;
+  Serial.printf("[%lu] [CPS] Settings loaded from NVS\n", millis());
   return true;
 }
 
-bool CrossPointSettings::loadFromFile() {
+bool CrossPointSettings::migrateFromSd() {
+  if (nvsLoaded) {
+    return false;
+  }
+  if (!loadLegacyFile()) {
+    return false;
+  }
+  Serial.printf("[%lu] [CPS] Migrating legacy settings file to NVS\n", millis());
+  return save();
+}
+
+bool CrossPointSettings::loadLegacyFile() {
   FsFile inputFile;
   if (!SdMan.openFileForRead("CPS", SETTINGS_FILE, inputFile)) {
     return false;
@@ -148,11 +294,17 @@ bool CrossPointSettings::loadFromFile() {
     if (++settingsRead >= fileSettingsCount) break;
     readAndValidate(inputFile, sleepScreenCoverFilter, SLEEP_SCREEN_COVER_FILTER_COUNT);
     if (++settingsRead >= fileSettingsCount) break;
+    serialization::readPod(inputFile, optimalLineBreaks);
+    if (++settingsRead >= fileSettingsCount) break;
+    readAndValidate(inputFile, cacheSizeLimit, CACHE_SIZE_LIMIT_COUNT);
+    if (++settingsRead >= fileSettingsCount) break;
+    readAndValidate(inputFile, bgBatteryThrottle, BG_BATTERY_THROTTLE_COUNT);
+    if (++settingsRead >= fileSettingsCount) break;
     // New fields added at end for backward compatibility
   } while (false);
 
   inputFile.close();
-  Serial.printf("[%lu] [CPS] Settings loaded from file\n", millis());
+  Serial.printf("[%lu] [CPS] Settings loaded from legacy file\n", millis());
   return true;
 }
 
@@ -224,8 +376,43 @@ int CrossPointSettings::getRefreshFrequency() const {
   }
 }
 
+uint64_t CrossPointSettings::getCacheByteBudget() const {
+  switch (cacheSizeLimit) {
+    case CACHE_64_MB:
+      return 64ULL * 1024 * 1024;
+    case CACHE_128_MB:
+      return 128ULL * 1024 * 1024;
+    case CACHE_256_MB:
+    default:
+      return 256ULL * 1024 * 1024;
+    case CACHE_UNLIMITED:
+      return 0;
+  }
+}
+
+uint8_t CrossPointSettings::getBgThrottlePercent() const {
+  switch (bgBatteryThrottle) {
+    case BG_ALWAYS_RUN:
+      return 0;
+    case BG_BELOW_15:
+      return 15;
+    case BG_BELOW_25:
+    default:
+      return 25;
+    case BG_BELOW_40:
+      return 40;
+  }
+}
+
 int CrossPointSettings::getReaderFontId() const {
   switch (fontFamily) {
+    case USER:
+      // The one user font file carries a single size; fall back to the default family when no
+      // valid .cpf has been registered from the card
+      if (USER_FONTS.getFontId() != 0) {
+        return USER_FONTS.getFontId();
+      }
+      [[fallthrough]];
     case BOOKERLY:
     default:
       switch (fontSize) {
@@ -10,6 +10,11 @@ class CrossPointSettings {
   // Static instance
   static CrossPointSettings instance;
 
+  // True once load() found a blob in NVS; gates the legacy SD migration
+  bool nvsLoaded = false;
+
+  bool loadLegacyFile();
+
  public:
   // Delete copy constructor and assignment
   CrossPointSettings(const CrossPointSettings&) = delete;
@@ -58,8 +63,8 @@ class CrossPointSettings {
   // Swapped: Next, Previous
   enum SIDE_BUTTON_LAYOUT { PREV_NEXT = 0, NEXT_PREV = 1, SIDE_BUTTON_LAYOUT_COUNT };
 
-  // Font family options
-  enum FONT_FAMILY { BOOKERLY = 0, NOTOSANS = 1, OPENDYSLEXIC = 2, FONT_FAMILY_COUNT };
+  // Font family options; USER is the first .cpf font found on the SD card (see UserFontStore)
+  enum FONT_FAMILY { BOOKERLY = 0, NOTOSANS = 1, OPENDYSLEXIC = 2, USER = 3, FONT_FAMILY_COUNT };
   // Font size options
   enum FONT_SIZE { SMALL = 0, MEDIUM = 1, LARGE = 2, EXTRA_LARGE = 3, FONT_SIZE_COUNT };
   enum LINE_COMPRESSION { TIGHT = 0, NORMAL = 1, WIDE = 2, LINE_COMPRESSION_COUNT };
@@ -94,9 +99,29 @@ class CrossPointSettings {
   // Short power button press actions
   enum SHORT_PWRBTN { IGNORE = 0, SLEEP = 1, PAGE_TURN = 2, SHORT_PWRBTN_COUNT };
 
+  // Byte budget for the per-book cache directories, enforced by the background LRU sweep
+  enum CACHE_SIZE_LIMIT {
+    CACHE_64_MB = 0,
+    CACHE_128_MB = 1,
+    CACHE_256_MB = 2,
+    CACHE_UNLIMITED = 3,
+    CACHE_SIZE_LIMIT_COUNT
+  };
+
   // Hide battery percentage
   enum HIDE_BATTERY_PERCENTAGE { HIDE_NEVER = 0, HIDE_READER = 1, HIDE_ALWAYS = 2, HIDE_BATTERY_PERCENTAGE_COUNT };
 
+  // Battery level below which low-priority background jobs (thumbnail sweeps, cache builds) are
+  // deferred. Charging lifts the throttle, and everything but high-priority work suspends below
+  // a hard floor regardless (see AsyncTaskQueue)
+  enum BG_BATTERY_THROTTLE {
+    BG_ALWAYS_RUN = 0,
+    BG_BELOW_15 = 1,
+    BG_BELOW_25 = 2,
+    BG_BELOW_40 = 3,
+    BG_BATTERY_THROTTLE_COUNT
+  };
+
   // Sleep screen settings
   uint8_t sleepScreen = DARK;
   // Sleep screen cover mode settings
@@ -126,6 +151,9 @@ class CrossPointSettings {
   // E-ink refresh frequency (default 15 pages)
   uint8_t refreshFrequency = REFRESH_15;
   uint8_t hyphenationEnabled = 0;
+  // Optimal-fit (Knuth-Plass style) line breaking over hyphenation points; pricier section builds
+  // in exchange for more even lines, free at page-turn time since layout is cached
+  uint8_t optimalLineBreaks = 0;
 
   // Reader screen margin settings
   uint8_t screenMargin = 5;
@@ -137,6 +165,12 @@ class CrossPointSettings {
   uint8_t hideBatteryPercentage = HIDE_NEVER;
   // Long-press chapter skip on side buttons
   uint8_t longPressChapterSkip = 1;
+  // Cache size limit (see CacheGc)
+  uint8_t cacheSizeLimit = CACHE_256_MB;
+  // Battery throttle for background jobs (see BG_BATTERY_THROTTLE)
+  uint8_t bgBatteryThrottle = BG_BELOW_25;
+  // Diagnostics overlay in the reader showing live p50/p95 page-turn latency (see TurnLatency)
+  uint8_t turnLatencyOverlay = 0;
 
   ~CrossPointSettings() = default;
 
@@ -148,12 +182,23 @@ class CrossPointSettings {
   }
   int getReaderFontId() const;
 
-  bool saveToFile() const;
-  bool loadFromFile();
+  // Settings persist as one versioned blob in NVS flash, so they load before the SD card
+  // mounts and survive card swaps. The blob reuses the append-only version + count + field
+  // scheme the old settings.bin used.
+  bool save() const;
+  bool load();
+  // One-time import of a legacy /.crosspoint/settings.bin into NVS; call after SD init.
+  // No-op once NVS holds a blob. The card file is left in place so a firmware rollback
+  // still finds it.
+  bool migrateFromSd();
 
   float getReaderLineCompression() const;
   unsigned long getSleepTimeoutMs() const;
   int getRefreshFrequency() const;
+  // 0 means unlimited
+  uint64_t getCacheByteBudget() const;
+  // 0 means never throttle
+  uint8_t getBgThrottlePercent() const;
 };
 
 // Helper macro to access settings
@@ -5,34 +5,123 @@
 #include <Serialization.h>
 
 namespace {
-constexpr uint8_t STATE_FILE_VERSION = 2;
-constexpr char STATE_FILE[] = "/.crosspoint/state.bin";
+constexpr uint8_t STATE_FILE_VERSION = 3;
+// Pre-v3 single-file format, read once for migration
+constexpr char LEGACY_STATE_FILE[] = "/.crosspoint/state.bin";
+constexpr const char* SLOT_FILES[2] = {"/.crosspoint/state0.bin", "/.crosspoint/state1.bin"};
 }  // namespace
 
 CrossPointState CrossPointState::instance;
 
-bool CrossPointState::saveToFile() const {
+uint32_t CrossPointState::checksum(const uint32_t seq, const std::string& epubPath, const uint8_t sleepImage) {
+  // FNV-1a 32-bit over the slot payload; catches torn writes within a slot
+  uint32_t hash = 2166136261u;
+  const auto mix = [&hash](const uint8_t b) {
+    hash ^= b;
+    hash *= 16777619u;
+  };
+  for (int i = 0; i < 4; i++) {
+    mix((seq >> (i * 8)) & 0xFF);
+  }
+  for (const char c : epubPath) {
+    mix(static_cast<uint8_t>(c));
+  }
+  mix(sleepImage);
+  return hash;
+}
+
+void CrossPointState::markDirty() {
+  if (!dirty) {
+    dirty = true;
+    dirtySinceMs = millis();
+  }
+}
+
+void CrossPointState::flushIfDirty() {
+  if (!dirty || millis() - dirtySinceMs < FLUSH_DEBOUNCE_MS) {
+    return;
+  }
+  saveToFile();
+}
+
+bool CrossPointState::flush() { return !dirty || saveToFile(); }
+
+bool CrossPointState::saveToFile() {
+  const uint8_t slot = nextSlot;
   FsFile outputFile;
-  if (!SdMan.openFileForWrite("CPS", STATE_FILE, outputFile)) {
+  if (!SdMan.openFileForWrite("CPS", SLOT_FILES[slot], outputFile)) {
     return false;
   }
 
+  const uint32_t seq = sequence + 1;
   serialization::writePod(outputFile, STATE_FILE_VERSION);
+  serialization::writePod(outputFile, seq);
   serialization::writeString(outputFile, openEpubPath);
   serialization::writePod(outputFile, lastSleepImage);
+  serialization::writePod(outputFile, checksum(seq, openEpubPath, lastSleepImage));
   outputFile.close();
+
+  sequence = seq;
+  nextSlot = slot ^ 1;
+  dirty = false;
+  return true;
+}
+
+bool CrossPointState::readSlot(const char* path, uint32_t& seq, std::string& epubPath, uint8_t& sleepImage) const {
+  FsFile inputFile;
+  if (!SdMan.openFileForRead("CPS", path, inputFile)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(inputFile, version);
+  if (version != STATE_FILE_VERSION) {
+    Serial.printf("[%lu] [CPS] Ignoring slot %s: unknown version %u\n", millis(), path, version);
+    inputFile.close();
+    return false;
+  }
+
+  serialization::readPod(inputFile, seq);
+  serialization::readString(inputFile, epubPath);
+  serialization::readPod(inputFile, sleepImage);
+  uint32_t storedSum = 0;
+  serialization::readPod(inputFile, storedSum);
+  inputFile.close();
+
+  if (storedSum != checksum(seq, epubPath, sleepImage)) {
+    Serial.printf("[%lu] [CPS] Ignoring slot %s: checksum mismatch (torn write?)\n", millis(), path);
+    return false;
+  }
   return true;
 }
 
 bool CrossPointState::loadFromFile() {
+  uint32_t seqs[2] = {0, 0};
+  std::string paths[2];
+  uint8_t images[2] = {0, 0};
+  const bool valid0 = readSlot(SLOT_FILES[0], seqs[0], paths[0], images[0]);
+  const bool valid1 = readSlot(SLOT_FILES[1], seqs[1], paths[1], images[1]);
+
+  if (valid0 || valid1) {
+    const int newest = valid1 && (!valid0 || seqs[1] > seqs[0]) ? 1 : 0;
+    openEpubPath = paths[newest];
+    lastSleepImage = images[newest];
+    sequence = seqs[newest];
+    nextSlot = newest ^ 1;  // Overwrite the older slot on the next write
+    dirty = false;
+    return true;
+  }
+
+  // Fall back to the pre-v3 single-file format; marking dirty migrates it to the
+  // slots on the next flush
   FsFile inputFile;
-  if (!SdMan.openFileForRead("CPS", STATE_FILE, inputFile)) {
+  if (!SdMan.openFileForRead("CPS", LEGACY_STATE_FILE, inputFile)) {
     return false;
   }
 
   uint8_t version;
   serialization::readPod(inputFile, version);
-  if (version > STATE_FILE_VERSION) {
+  if (version > 2) {
     Serial.printf("[%lu] [CPS] Deserialization failed: Unknown version %u\n", millis(), version);
     inputFile.close();
     return false;
@@ -46,5 +135,6 @@ bool CrossPointState::loadFromFile() {
   }
 
   inputFile.close();
+  markDirty();
   return true;
 }
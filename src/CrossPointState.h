@@ -1,11 +1,35 @@
 #pragma once
-#include <iosfwd>
+#include <cstdint>
 #include <string>
 
+/**
+ * App-level state (last open book, sleep image rotation) persisted across deep sleep.
+ *
+ * Persistence is write-behind: mutate the public fields, call markDirty(), and the main
+ * loop's flushIfDirty() does the SD write a few seconds later, off the interactive path.
+ * enterDeepSleep() flushes before powering down, so at most the debounce window of state
+ * can be lost to a hard crash.
+ *
+ * On disk the record is double-buffered: two alternating slot files, each carrying a
+ * sequence number and checksum. A torn write only corrupts the slot being replaced;
+ * loadFromFile() picks the valid slot with the highest sequence.
+ */
 class CrossPointState {
   // Static instance
   static CrossPointState instance;
 
+  bool dirty = false;
+  unsigned long dirtySinceMs = 0;
+  // Sequence number of the newest valid slot on disk; the next write stamps seq+1 on the other slot
+  uint32_t sequence = 0;
+  uint8_t nextSlot = 0;
+
+  // Coalesces bursts of changes (e.g. book open updating several fields) into one write
+  static constexpr unsigned long FLUSH_DEBOUNCE_MS = 3000;
+
+  static uint32_t checksum(uint32_t seq, const std::string& epubPath, uint8_t sleepImage);
+  bool readSlot(const char* path, uint32_t& seq, std::string& epubPath, uint8_t& sleepImage) const;
+
  public:
   std::string openEpubPath;
   uint8_t lastSleepImage;
@@ -14,7 +38,18 @@ class CrossPointState {
   // Get singleton instance
   static CrossPointState& getInstance() { return instance; }
 
-  bool saveToFile() const;
+  // Record that the fields changed; the write happens on a later flush
+  void markDirty();
+
+  // Debounced write-behind flush, polled from the main loop; cheap no-op while clean
+  void flushIfDirty();
+
+  // Write now if dirty (sleep path - last chance before power-down)
+  bool flush();
+
+  // Unconditional synchronous write (boot-loop recovery needs the cleared state on disk
+  // before the epub open is attempted)
+  bool saveToFile();
 
   bool loadFromFile();
 };
@@ -0,0 +1,67 @@
+#include "HomeFrameCache.h"
+
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <cstring>
+
+#include "CrossPointSettings.h"
+#include "CrossPointState.h"
+
+namespace {
+constexpr char CACHE_FILE[] = "/.crosspoint/homeframe.bin";
+constexpr uint32_t CACHE_MAGIC = 0x484D4650;  // 'HMFP'
+constexpr uint8_t CACHE_VERSION = 1;
+}  // namespace
+
+std::string HomeFrameCache::currentKey() {
+  // The open book drives the Continue Reading card; the OPDS URL toggles a menu tile.
+  // Everything else on the frame (battery icon aside) is derived from these.
+  std::string key = APP_STATE.openEpubPath;
+  key += '\x1f';
+  key += strlen(SETTINGS.opdsServerUrl) > 0 ? '1' : '0';
+  return key;
+}
+
+bool HomeFrameCache::restore(const GfxRenderer& renderer, const std::string& key) {
+  FsFile file;
+  if (!SdMan.openFileForRead("HMF", CACHE_FILE, file)) {
+    return false;
+  }
+  uint32_t magic = 0;
+  uint8_t version = 0;
+  std::string storedKey;
+  serialization::readPod(file, magic);
+  serialization::readPod(file, version);
+  serialization::readString(file, storedKey);
+  bool ok = magic == CACHE_MAGIC && version == CACHE_VERSION && storedKey == key;
+  if (ok) {
+    const size_t bufferSize = GfxRenderer::getBufferSize();
+    ok = file.read(renderer.getFrameBuffer(), bufferSize) == static_cast<int>(bufferSize);
+  }
+  file.close();
+  if (!ok) {
+    Serial.printf("[%lu] [HMF] Cached home frame stale or invalid, skipping blit\n", millis());
+  }
+  return ok;
+}
+
+bool HomeFrameCache::save(const GfxRenderer& renderer, const std::string& key) {
+  FsFile file;
+  if (!SdMan.openFileForWrite("HMF", CACHE_FILE, file)) {
+    return false;
+  }
+  serialization::writePod(file, CACHE_MAGIC);
+  serialization::writePod(file, CACHE_VERSION);
+  serialization::writeString(file, key);
+  const size_t written = file.write(renderer.getFrameBuffer(), GfxRenderer::getBufferSize());
+  file.close();
+  if (written != GfxRenderer::getBufferSize()) {
+    Serial.printf("[%lu] [HMF] Short home frame write, dropping it\n", millis());
+    SdMan.remove(CACHE_FILE);
+    return false;
+  }
+  return true;
+}
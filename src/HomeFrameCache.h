@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+class GfxRenderer;
+
+// Composed-home-frame cache. A cold boot that lands on the home screen pays for recent-book
+// lookups, a possible thumbnail load and the full menu layout before anything reaches the
+// glass. The last frame HomeActivity composed is stored on SD keyed by what shaped it; on the
+// next cold boot the frame is blitted straight back (tagged as refreshing) while the real
+// render rebuilds it behind. Like the sleep-frame cache this is keyed and reusable, not
+// consume-once: it stays valid until the key changes.
+namespace HomeFrameCache {
+
+// Key for the current home composition, cheap to build from already-loaded state
+std::string currentKey();
+
+// Load the cached frame into the framebuffer when its key matches; false on any mismatch
+bool restore(const GfxRenderer& renderer, const std::string& key);
+
+// Write the current framebuffer under the given key; drops the file on a short write
+bool save(const GfxRenderer& renderer, const std::string& key);
+
+}  // namespace HomeFrameCache
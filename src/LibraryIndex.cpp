@@ -0,0 +1,282 @@
+#include "LibraryIndex.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <algorithm>
+
+#include "RecentBooksStore.h"
+#include "util/StringUtils.h"
+
+namespace {
+// v2: each record carries denormalized title/author strings after the name
+constexpr uint8_t LIBRARY_INDEX_VERSION = 2;
+constexpr char LIBRARY_INDEX_FILE[] = "/.crosspoint/libindex.bin";
+
+// Directories first, then case-insensitive by name (same order the Files tab always used)
+bool entryLess(const std::string& str1, const std::string& str2) {
+  if (str1.back() == '/' && str2.back() != '/') return true;
+  if (str1.back() != '/' && str2.back() == '/') return false;
+  return lexicographical_compare(begin(str1), end(str1), begin(str2), end(str2),
+                                 [](const char& char1, const char& char2) { return tolower(char1) < tolower(char2); });
+}
+
+// Case-folded substring match (ASCII fold, same as the sort order above)
+bool foldedContains(const std::string& haystack, const std::string& needle) {
+  const auto it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(),
+                              [](const char& char1, const char& char2) { return tolower(char1) == tolower(char2); });
+  return it != haystack.end();
+}
+
+// Full path of an entry inside the indexed directory
+std::string entryPath(const std::string& dir, const std::string& name) {
+  if (dir == "/") {
+    return "/" + name;
+  }
+  return dir + "/" + name;
+}
+}  // namespace
+
+LibraryIndex LibraryIndex::instance;
+
+bool LibraryIndex::isListedFile(const std::string& name) {
+  return StringUtils::checkFileExtension(name, ".epub") || StringUtils::checkFileExtension(name, ".xtch") ||
+         StringUtils::checkFileExtension(name, ".xtc") || StringUtils::checkFileExtension(name, ".txt") ||
+         StringUtils::checkFileExtension(name, ".md");
+}
+
+int LibraryIndex::open(const std::string& dir) {
+  if (dir == indexedDir) {
+    return count;
+  }
+
+  // Scan the directory once and persist the sorted listing
+  auto root = SdMan.open(dir.c_str());
+  if (!root || !root.isDirectory()) {
+    if (root) root.close();
+    return -1;
+  }
+
+  root.rewindDirectory();
+
+  std::vector<std::string> names;
+  char name[500];
+  for (auto file = root.openNextFile(); file; file = root.openNextFile()) {
+    file.getName(name, sizeof(name));
+    if (name[0] == '.' || strcmp(name, "System Volume Information") == 0) {
+      file.close();
+      continue;
+    }
+
+    if (file.isDirectory()) {
+      names.emplace_back(std::string(name) + "/");
+    } else {
+      auto filename = std::string(name);
+      if (isListedFile(filename)) {
+        names.emplace_back(filename);
+      }
+    }
+    file.close();
+  }
+  root.close();
+
+  std::sort(names.begin(), names.end(), entryLess);
+
+  if (!writeIndexFile(dir, names)) {
+    return -1;
+  }
+  Serial.printf("[%lu] [LIX] Rebuilt index for %s (%d entries)\n", millis(), dir.c_str(), count);
+  return count;
+}
+
+bool LibraryIndex::writeIndexFile(const std::string& dir, const std::vector<std::string>& names) {
+  // Make sure the directory exists
+  SdMan.mkdir("/.crosspoint");
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("LIX", LIBRARY_INDEX_FILE, file)) {
+    return false;
+  }
+
+  serialization::writePod(file, LIBRARY_INDEX_VERSION);
+  serialization::writeString(file, dir);
+  serialization::writePod(file, static_cast<uint16_t>(names.size()));
+  const uint32_t lutFieldPos = file.position();
+  serialization::writePod(file, static_cast<uint32_t>(0));  // Placeholder for LUT offset
+
+  std::vector<uint32_t> lut;
+  lut.reserve(names.size());
+  for (const auto& entry : names) {
+    lut.emplace_back(file.position());
+    serialization::writeString(file, entry);
+
+    // Denormalized metadata, filled from the recent-books store when the book has been
+    // opened before (a RAM lookup - rebuilding must never open every book on the card)
+    const RecentBook* known =
+        entry.back() == '/' ? nullptr : RECENT_BOOKS.findBook(entryPath(dir, entry));
+    serialization::writeString(file, known ? known->title : std::string());
+    serialization::writeString(file, known ? known->author : std::string());
+  }
+
+  const uint32_t newLutOffset = file.position();
+  for (const uint32_t& pos : lut) {
+    serialization::writePod(file, pos);
+  }
+
+  file.seek(lutFieldPos);
+  serialization::writePod(file, newLutOffset);
+  file.close();
+
+  indexedDir = dir;
+  count = static_cast<uint16_t>(names.size());
+  lutOffset = newLutOffset;
+  return true;
+}
+
+bool LibraryIndex::readEntries(const int startIndex, const int maxCount, std::vector<std::string>& out) const {
+  if (indexedDir.empty() || startIndex < 0 || startIndex >= count) {
+    return false;
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForRead("LIX", LIBRARY_INDEX_FILE, file)) {
+    return false;
+  }
+
+  const int endIndex = std::min(startIndex + maxCount, static_cast<int>(count));
+  for (int i = startIndex; i < endIndex; i++) {
+    file.seek(lutOffset + sizeof(uint32_t) * i);
+    uint32_t pos;
+    serialization::readPod(file, pos);
+    file.seek(pos);
+    std::string entry;
+    serialization::readString(file, entry);
+    out.emplace_back(std::move(entry));
+  }
+  file.close();
+  return true;
+}
+
+int LibraryIndex::indexOf(const std::string& name) const {
+  std::vector<std::string> names;
+  if (!readAllNames(names)) {
+    return -1;
+  }
+  for (size_t i = 0; i < names.size(); i++) {
+    if (names[i] == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool LibraryIndex::readAllNames(std::vector<std::string>& names) const {
+  if (indexedDir.empty()) {
+    return false;
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForRead("LIX", LIBRARY_INDEX_FILE, file)) {
+    return false;
+  }
+
+  // Skip the header; records follow it back to back
+  uint8_t version;
+  serialization::readPod(file, version);
+  std::string dir;
+  serialization::readString(file, dir);
+  uint16_t fileCount;
+  serialization::readPod(file, fileCount);
+  uint32_t fileLutOffset;
+  serialization::readPod(file, fileLutOffset);
+
+  names.reserve(fileCount);
+  for (uint16_t i = 0; i < fileCount; i++) {
+    std::string entry;
+    serialization::readString(file, entry);
+    names.emplace_back(std::move(entry));
+    std::string skip;
+    serialization::readString(file, skip);  // title
+    serialization::readString(file, skip);  // author
+  }
+  file.close();
+  return true;
+}
+
+bool LibraryIndex::search(const std::string& query, const size_t maxResults, std::vector<SearchResult>& out) const {
+  if (indexedDir.empty() || query.empty()) {
+    return false;
+  }
+
+  FsFile file;
+  if (!SdMan.openFileForRead("LIX", LIBRARY_INDEX_FILE, file)) {
+    return false;
+  }
+
+  // Skip the header; records follow it back to back
+  uint8_t version;
+  serialization::readPod(file, version);
+  std::string dir;
+  serialization::readString(file, dir);
+  uint16_t fileCount;
+  serialization::readPod(file, fileCount);
+  uint32_t fileLutOffset;
+  serialization::readPod(file, fileLutOffset);
+
+  for (uint16_t i = 0; i < fileCount && out.size() < maxResults; i++) {
+    SearchResult entry;
+    serialization::readString(file, entry.name);
+    serialization::readString(file, entry.title);
+    serialization::readString(file, entry.author);
+    if (entry.name.back() == '/') {
+      continue;  // Directories aren't books
+    }
+    if (foldedContains(entry.name, query) || foldedContains(entry.title, query) ||
+        foldedContains(entry.author, query)) {
+      out.emplace_back(std::move(entry));
+    }
+  }
+  file.close();
+  return true;
+}
+
+bool LibraryIndex::addEntry(const std::string& path) {
+  const size_t lastSlash = path.find_last_of('/');
+  if (lastSlash == std::string::npos) {
+    return false;
+  }
+  std::string dir = path.substr(0, lastSlash);
+  if (dir.empty()) {
+    dir = "/";
+  }
+  const std::string name = path.substr(lastSlash + 1);
+  if (name.empty() || name[0] == '.' || !isListedFile(name)) {
+    return false;
+  }
+
+  // Only the currently indexed directory can be patched in place; any other
+  // directory gets rescanned when it is next opened
+  if (dir != indexedDir) {
+    return false;
+  }
+
+  std::vector<std::string> names;
+  if (!readAllNames(names)) {
+    invalidate();
+    return false;
+  }
+
+  const auto it = std::lower_bound(names.begin(), names.end(), name, entryLess);
+  if (it != names.end() && *it == name) {
+    return true;  // Overwritten file, already listed
+  }
+  names.insert(it, name);
+
+  if (!writeIndexFile(dir, names)) {
+    invalidate();
+    return false;
+  }
+  Serial.printf("[%lu] [LIX] Added %s to index (%d entries)\n", millis(), name.c_str(), count);
+  return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Persistent, sorted index of the book listing for one directory, so MyLibraryActivity can show
+// a page of entries without re-enumerating the SD card directory on every visit. The index file
+// carries a page LUT, so reads are O(visible entries) rather than O(directory size).
+//
+// The index is trusted only after it has been (re)built this boot - files added from a PC while
+// the device was off are picked up by the first rebuild. In-session writers (web uploads, OPDS
+// downloads) keep it current through addEntry()/invalidate().
+//
+// Each record also denormalizes the book's title and author (taken from the recent-books store
+// at write time - never by opening the book), which makes search() a single sequential read.
+class LibraryIndex {
+ public:
+  // One search hit: the entry name plus the denormalized metadata stored with it.
+  // Title/author are empty for books the device has never opened.
+  struct SearchResult {
+    std::string name;
+    std::string title;
+    std::string author;
+  };
+
+ private:
+  // Static instance
+  static LibraryIndex instance;
+
+  // Directory the on-disk index covers and has been validated for this boot ("" = stale)
+  std::string indexedDir;
+  uint16_t count = 0;
+  uint32_t lutOffset = 0;
+
+  bool writeIndexFile(const std::string& dir, const std::vector<std::string>& names);
+  bool readAllNames(std::vector<std::string>& names) const;
+
+ public:
+  ~LibraryIndex() = default;
+
+  // Get singleton instance
+  static LibraryIndex& getInstance() { return instance; }
+
+  // Ensure the index covers `dir`, scanning and rebuilding it if needed.
+  // Returns the entry count, or -1 on failure.
+  int open(const std::string& dir);
+
+  int getCount() const { return count; }
+
+  // Directory the current index covers ("" until the first open() this boot)
+  const std::string& getIndexedDir() const { return indexedDir; }
+
+  // Read up to maxCount entries starting at startIndex (sorted order, directories end with '/')
+  bool readEntries(int startIndex, int maxCount, std::vector<std::string>& out) const;
+
+  // Index of an entry name in sorted order, or -1 if absent
+  int indexOf(const std::string& name) const;
+
+  // Case-folded substring scan over name/title/author of every file entry in the index
+  // (one sequential read of the compact index file, no directory traversal). Stops after
+  // maxResults hits. Returns false when no index is open this boot.
+  bool search(const std::string& query, size_t maxResults, std::vector<SearchResult>& out) const;
+
+  // Incrementally insert a newly written book file without rescanning the directory.
+  // No-op when the file's directory isn't the one currently indexed.
+  bool addEntry(const std::string& path);
+
+  // Drop the index; the next open() rescans (used after deletes/renames)
+  void invalidate() { indexedDir.clear(); }
+
+  // True when `name` is a file the library listing would show
+  static bool isListedFile(const std::string& name);
+};
+
+// Helper macro to access the library index
+#define LIBRARY_INDEX LibraryIndex::getInstance()
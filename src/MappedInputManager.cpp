@@ -1,5 +1,7 @@
 #include "MappedInputManager.h"
 
+#include <TurnLatency.h>
+
 #include "CrossPointSettings.h"
 
 namespace {
@@ -30,6 +32,15 @@ constexpr SideLayoutMap kSideLayouts[] = {
     {HalGPIO::BTN_UP, HalGPIO::BTN_DOWN},
     {HalGPIO::BTN_DOWN, HalGPIO::BTN_UP},
 };
+
+// Hold-to-repeat cadence for press-to-turn mode: first repeat after the initial delay, then one
+// turn per interval
+constexpr unsigned long kRepeatDelayMs = 700;
+constexpr unsigned long kRepeatIntervalMs = 400;
+// Queued turns nobody drained within this window are stale (pressed inside a sub-activity that
+// shares the buttons) and are dropped instead of causing phantom jumps later
+constexpr unsigned long kStaleTurnMs = 500;
+constexpr uint8_t kMaxQueuedTurns = 5;
 }  // namespace
 
 bool MappedInputManager::mapButton(const Button button, bool (HalGPIO::*fn)(uint8_t) const) const {
@@ -74,6 +85,56 @@ bool MappedInputManager::wasAnyReleased() const { return gpio.wasAnyReleased();
 
 unsigned long MappedInputManager::getHeldTime() const { return gpio.getHeldTime(); }
 
+void MappedInputManager::update() {
+  // With long-press chapter skip enabled a held page button means "skip chapter", so the queue
+  // stays out of the way; readers keep reading the raw release edges in that mode
+  if (SETTINGS.longPressChapterSkip) {
+    pageBackQueue = PageTurnQueue();
+    pageForwardQueue = PageTurnQueue();
+    return;
+  }
+  trackPageButton(Button::PageBack, pageBackQueue);
+  trackPageButton(Button::PageForward, pageForwardQueue);
+}
+
+void MappedInputManager::trackPageButton(const Button button, PageTurnQueue& queue) {
+  const unsigned long now = millis();
+  if (wasPressed(button)) {
+    if (queue.pending < kMaxQueuedTurns) {
+      queue.pending++;
+    }
+    queue.held = true;
+    queue.nextRepeatAt = now + kRepeatDelayMs;
+    queue.lastEventAt = now;
+    // First point the firmware can see the press; the latency rig measures the chain from here
+    TURN_LATENCY.noteInputEdge(now);
+  } else if (!isPressed(button)) {
+    queue.held = false;
+  } else if (queue.held && now >= queue.nextRepeatAt) {
+    if (queue.pending < kMaxQueuedTurns) {
+      queue.pending++;
+    }
+    queue.nextRepeatAt = now + kRepeatIntervalMs;
+    queue.lastEventAt = now;
+    TURN_LATENCY.noteInputEdge(now);
+  }
+}
+
+uint8_t MappedInputManager::takePageTurns(const Button button) {
+  PageTurnQueue* queue = nullptr;
+  if (button == Button::PageBack) {
+    queue = &pageBackQueue;
+  } else if (button == Button::PageForward) {
+    queue = &pageForwardQueue;
+  }
+  if (!queue || queue->pending == 0) {
+    return 0;
+  }
+  const uint8_t pending = millis() - queue->lastEventAt <= kStaleTurnMs ? queue->pending : 0;
+  queue->pending = 0;
+  return pending;
+}
+
 MappedInputManager::Labels MappedInputManager::mapLabels(const char* back, const char* confirm, const char* previous,
                                                          const char* next) const {
   const auto layout = static_cast<CrossPointSettings::FRONT_BUTTON_LAYOUT>(SETTINGS.frontButtonLayout);
@@ -23,8 +23,28 @@ class MappedInputManager {
   unsigned long getHeldTime() const;
   Labels mapLabels(const char* back, const char* confirm, const char* previous, const char* next) const;
 
+  // Page-turn event queue: call once per main loop right after HalGPIO::update(). Records
+  // timestamped presses of the two page buttons and, in press-to-turn mode, synthesizes repeats
+  // at a fixed cadence while a button stays held - so holding skims pages at a predictable rate
+  // no matter how long each render takes. Queued events a reader hasn't consumed yet coalesce:
+  // N turns drain as one jump of N instead of N separate renders.
+  void update();
+  // Coalesced count of queued turns for PageBack/PageForward (0 for any other button); draining
+  // resets the queue
+  uint8_t takePageTurns(Button button);
+
  private:
+  struct PageTurnQueue {
+    uint8_t pending = 0;
+    bool held = false;
+    unsigned long nextRepeatAt = 0;
+    unsigned long lastEventAt = 0;
+  };
+
   HalGPIO& gpio;
+  PageTurnQueue pageBackQueue;
+  PageTurnQueue pageForwardQueue;
 
   bool mapButton(Button button, bool (HalGPIO::*fn)(uint8_t) const) const;
+  void trackPageButton(Button button, PageTurnQueue& queue);
 };
@@ -0,0 +1,89 @@
+#include "PowerGovernor.h"
+
+PowerGovernor PowerGovernor::instance;
+
+void PowerGovernor::begin() {
+  taskENTER_CRITICAL(&mux);
+  armed = true;
+  taskEXIT_CRITICAL(&mux);
+  applyClock(idleMhz);
+  Serial.printf("[%lu] [PGV] Governor armed: %lu MHz idle, %lu MHz boosted\n", millis(),
+                static_cast<unsigned long>(idleMhz), static_cast<unsigned long>(boostMhz));
+}
+
+void PowerGovernor::acquire() {
+  bool boost = false;
+  taskENTER_CRITICAL(&mux);
+  leaseDepth++;
+  lastDemandMs = millis();
+  if (armed && !boosted) {
+    boosted = true;
+    boosts++;
+    boostStartMs = lastDemandMs;
+    boost = true;
+  }
+  taskEXIT_CRITICAL(&mux);
+  if (boost) {
+    applyClock(boostMhz);
+  }
+}
+
+void PowerGovernor::release() {
+  taskENTER_CRITICAL(&mux);
+  if (leaseDepth > 0) {
+    leaseDepth--;
+  }
+  // The drop back to the idle clock happens in update() once the hold expires, so bursts of
+  // short scopes (a build per chapter, a row per decode chunk) don't toggle the PLL constantly
+  lastDemandMs = millis();
+  taskEXIT_CRITICAL(&mux);
+}
+
+void PowerGovernor::kick() {
+  bool boost = false;
+  taskENTER_CRITICAL(&mux);
+  lastDemandMs = millis();
+  if (armed && !boosted) {
+    boosted = true;
+    boosts++;
+    boostStartMs = lastDemandMs;
+    boost = true;
+  }
+  taskEXIT_CRITICAL(&mux);
+  if (boost) {
+    applyClock(boostMhz);
+  }
+}
+
+void PowerGovernor::update() {
+  bool drop = false;
+  taskENTER_CRITICAL(&mux);
+  if (armed && boosted && leaseDepth == 0 && millis() - lastDemandMs >= kickHoldMs) {
+    boosted = false;
+    boostedMs += millis() - boostStartMs;
+    drop = true;
+  }
+  taskEXIT_CRITICAL(&mux);
+  if (drop) {
+    applyClock(idleMhz);
+  }
+}
+
+void PowerGovernor::applyClock(const uint32_t mhz) {
+  if (getCpuFrequencyMhz() != mhz) {
+    setCpuFrequencyMhz(mhz);
+  }
+}
+
+PowerGovernor::Stats PowerGovernor::getStats() const {
+  Stats stats;
+  taskENTER_CRITICAL(&mux);
+  stats.boosts = boosts;
+  stats.boostedMs = boostedMs;
+  if (boosted) {
+    stats.boostedMs += millis() - boostStartMs;
+  }
+  stats.activeLeases = leaseDepth;
+  taskEXIT_CRITICAL(&mux);
+  return stats;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <Arduino.h>
+
+#include <cstdint>
+
+// Workload-phase CPU governor. The ESP32-C3 otherwise runs at its boot clock whether it is
+// paginating a chapter or sitting in an Activity::loop() waiting for a button, so the idle
+// baseline drops to 80MHz (the floor that keeps WiFi and the USB CDC console happy) and the
+// CPU-bound phases declare themselves:
+//
+//  - hot paths (section builds, JPEG cover decodes, TLS handshakes) hold a scoped Lease, which
+//    boosts to 160MHz for exactly the work that benefits from it;
+//  - button presses kick() the governor so interactive rendering runs boosted without every
+//    activity being instrumented, with a short hold so a page turn's back-to-back work doesn't
+//    thrash the clock.
+//
+// The main loop calls update() to drop back to the idle clock once leases are gone and the
+// interactive hold has expired.
+class PowerGovernor {
+ public:
+  struct Stats {
+    uint32_t boosts;      // Transitions from idle to boosted
+    uint32_t boostedMs;   // Total time spent at the boost clock
+    uint8_t activeLeases;
+  };
+
+  // RAII marker for a CPU-bound section; holds the boost clock for the scope's lifetime
+  class Lease {
+   public:
+    Lease() { getInstance().acquire(); }
+    ~Lease() { getInstance().release(); }
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+  };
+
+  // Get singleton instance
+  static PowerGovernor& getInstance() { return instance; }
+
+  // Arms the governor and drops to the idle clock; called at the end of setup() so the boot
+  // sequence itself runs at the full boot clock. Before this every acquire/release is a no-op.
+  void begin();
+
+  void acquire();
+  void release();
+
+  // Interactive activity (button press); boosts and holds for kickHoldMs
+  void kick();
+
+  // Called from the main loop; returns to the idle clock when nothing needs the boost anymore
+  void update();
+
+  Stats getStats() const;
+
+ private:
+  PowerGovernor() = default;
+
+  void applyClock(uint32_t mhz);
+
+  // Static instance
+  static PowerGovernor instance;
+
+  static constexpr uint32_t boostMhz = 160;
+  static constexpr uint32_t idleMhz = 80;
+  // How long after the last lease/kick the boost clock lingers; covers the gap between a button
+  // press and the work it triggers on the display task
+  static constexpr uint32_t kickHoldMs = 750;
+
+  // State is touched from the main loop, the display tasks and background workers
+  mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+  bool armed = false;
+  bool boosted = false;
+  uint8_t leaseDepth = 0;
+  uint32_t lastDemandMs = 0;
+  uint32_t boostStartMs = 0;
+  uint32_t boosts = 0;
+  uint32_t boostedMs = 0;
+};
+
+#define PGOV PowerGovernor::getInstance()
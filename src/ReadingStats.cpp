@@ -0,0 +1,258 @@
+#include "ReadingStats.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <ctime>
+
+namespace {
+constexpr uint8_t STATS_FILE_VERSION = 1;
+constexpr char STATS_FILE[] = "/.crosspoint/stats.bin";
+constexpr uint32_t SECONDS_PER_DAY = 24 * 60 * 60;
+}  // namespace
+
+ReadingStatsStore ReadingStatsStore::instance;
+
+uint64_t ReadingStatsStore::fnvHash64(const std::string& s) {
+  // FNV-1a 64-bit; 32 bits would risk collisions across a large library
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : s) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+uint32_t ReadingStatsStore::nowSeconds() {
+  // System clock: restored from the RTC across deep sleep, zeroed on cold boot
+  return static_cast<uint32_t>(time(nullptr));
+}
+
+ReadingStatsStore::BookRow* ReadingStatsStore::findOrAddBookRow(const uint64_t pathHash) {
+  for (int i = 0; i < bookRowCount; i++) {
+    if (bookRows[i].pathHash == pathHash) {
+      return &bookRows[i];
+    }
+  }
+  if (bookRowCount < MAX_BOOK_ROWS) {
+    bookRows[bookRowCount] = {pathHash, 0, 0, 0};
+    return &bookRows[bookRowCount++];
+  }
+  // Table full: recycle the least-read row so active books keep their totals
+  BookRow* victim = &bookRows[0];
+  for (int i = 1; i < MAX_BOOK_ROWS; i++) {
+    if (bookRows[i].readSeconds < victim->readSeconds) {
+      victim = &bookRows[i];
+    }
+  }
+  *victim = {pathHash, 0, 0, 0};
+  return victim;
+}
+
+ReadingStatsStore::DayRow& ReadingStatsStore::currentDayRow() {
+  const uint32_t dayIndex = nowSeconds() / SECONDS_PER_DAY;
+  if (dayCount > 0 && dayRing[dayHead].dayIndex == dayIndex) {
+    return dayRing[dayHead];
+  }
+  // New 24h window (or the clock restarted): take the next ring slot
+  if (dayCount > 0) {
+    dayHead = (dayHead + 1) % DAY_RING_SIZE;
+  }
+  if (dayCount < DAY_RING_SIZE) {
+    dayCount++;
+  }
+  dayRing[dayHead] = {dayIndex, 0, 0};
+  return dayRing[dayHead];
+}
+
+void ReadingStatsStore::creditActiveTime() {
+  const uint32_t now = nowSeconds();
+  uint32_t gap = now > sessionLastEventSec ? now - sessionLastEventSec : 0;
+  if (gap > ACTIVE_GAP_CAP_SECONDS) {
+    gap = ACTIVE_GAP_CAP_SECONDS;
+  }
+  sessionActiveSeconds += gap;
+  sessionLastEventSec = now;
+}
+
+void ReadingStatsStore::beginSession(const std::string& bookPath) {
+  if (sessionOpen) {
+    endSession();
+  }
+  sessionOpen = true;
+  sessionBookHash = fnvHash64(bookPath);
+  sessionLastEventSec = nowSeconds();
+  sessionActiveSeconds = 0;
+  sessionPageTurns = 0;
+}
+
+void ReadingStatsStore::notePageTurn() {
+  if (!sessionOpen) {
+    return;
+  }
+  creditActiveTime();
+  sessionPageTurns++;
+}
+
+void ReadingStatsStore::endSession() {
+  if (!sessionOpen) {
+    return;
+  }
+  sessionOpen = false;
+  // Time spent on the final page counts too, under the same idle cap
+  creditActiveTime();
+  if (sessionPageTurns == 0 && sessionActiveSeconds == 0) {
+    return;
+  }
+
+  BookRow* book = findOrAddBookRow(sessionBookHash);
+  book->readSeconds += sessionActiveSeconds;
+  book->pageTurns += sessionPageTurns;
+  book->sessions++;
+
+  DayRow& day = currentDayRow();
+  day.readSeconds += sessionActiveSeconds;
+  day.pageTurns += sessionPageTurns;
+
+  totalReadSeconds += sessionActiveSeconds;
+  totalPageTurns += sessionPageTurns;
+  dirty = true;
+}
+
+uint32_t ReadingStatsStore::getPagesPerHour() const {
+  if (totalReadSeconds == 0) {
+    return 0;
+  }
+  return static_cast<uint32_t>(static_cast<uint64_t>(totalPageTurns) * 3600 / totalReadSeconds);
+}
+
+int ReadingStatsStore::getStreakDays() const {
+  if (dayCount == 0) {
+    return 0;
+  }
+  const uint32_t today = nowSeconds() / SECONDS_PER_DAY;
+  // A streak is only alive if the newest recorded day is today or yesterday
+  if (today > dayRing[dayHead].dayIndex + 1) {
+    return 0;
+  }
+
+  int streak = 0;
+  uint32_t expected = dayRing[dayHead].dayIndex;
+  for (int i = 0; i < dayCount; i++) {
+    const DayRow& row = dayRing[(dayHead + DAY_RING_SIZE - i) % DAY_RING_SIZE];
+    if (row.dayIndex != expected || row.readSeconds == 0) {
+      break;
+    }
+    streak++;
+    if (expected == 0) {
+      break;
+    }
+    expected--;
+  }
+  return streak;
+}
+
+ReadingStatsStore::DayRow ReadingStatsStore::getToday() const {
+  const uint32_t today = nowSeconds() / SECONDS_PER_DAY;
+  if (dayCount > 0 && dayRing[dayHead].dayIndex == today) {
+    return dayRing[dayHead];
+  }
+  return {today, 0, 0};
+}
+
+bool ReadingStatsStore::flushIfDirty() {
+  if (!dirty) {
+    return true;
+  }
+  if (!saveToFile()) {
+    return false;
+  }
+  dirty = false;
+  return true;
+}
+
+bool ReadingStatsStore::saveToFile() {
+  // Make sure the directory exists
+  SdMan.mkdir("/.crosspoint");
+
+  FsFile outputFile;
+  if (!SdMan.openFileForWrite("STATS", STATS_FILE, outputFile)) {
+    return false;
+  }
+
+  serialization::writePod(outputFile, STATS_FILE_VERSION);
+  serialization::writePod(outputFile, totalReadSeconds);
+  serialization::writePod(outputFile, totalPageTurns);
+
+  serialization::writePod(outputFile, bookRowCount);
+  for (int i = 0; i < bookRowCount; i++) {
+    serialization::writePod(outputFile, bookRows[i].pathHash);
+    serialization::writePod(outputFile, bookRows[i].readSeconds);
+    serialization::writePod(outputFile, bookRows[i].pageTurns);
+    serialization::writePod(outputFile, bookRows[i].sessions);
+  }
+
+  serialization::writePod(outputFile, dayCount);
+  serialization::writePod(outputFile, dayHead);
+  for (int i = 0; i < DAY_RING_SIZE; i++) {
+    serialization::writePod(outputFile, dayRing[i].dayIndex);
+    serialization::writePod(outputFile, dayRing[i].readSeconds);
+    serialization::writePod(outputFile, dayRing[i].pageTurns);
+  }
+
+  outputFile.close();
+  Serial.printf("[%lu] [STATS] Reading stats saved (%u books, %u days)\n", millis(), bookRowCount, dayCount);
+  return true;
+}
+
+bool ReadingStatsStore::loadFromFile() {
+  FsFile inputFile;
+  if (!SdMan.openFileForRead("STATS", STATS_FILE, inputFile)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(inputFile, version);
+  if (version != STATS_FILE_VERSION) {
+    Serial.printf("[%lu] [STATS] Deserialization failed: Unknown version %u\n", millis(), version);
+    inputFile.close();
+    return false;
+  }
+
+  serialization::readPod(inputFile, totalReadSeconds);
+  serialization::readPod(inputFile, totalPageTurns);
+
+  serialization::readPod(inputFile, bookRowCount);
+  if (bookRowCount > MAX_BOOK_ROWS) {
+    Serial.printf("[%lu] [STATS] Deserialization failed: Bad book row count %u\n", millis(), bookRowCount);
+    bookRowCount = 0;
+    inputFile.close();
+    return false;
+  }
+  for (int i = 0; i < bookRowCount; i++) {
+    serialization::readPod(inputFile, bookRows[i].pathHash);
+    serialization::readPod(inputFile, bookRows[i].readSeconds);
+    serialization::readPod(inputFile, bookRows[i].pageTurns);
+    serialization::readPod(inputFile, bookRows[i].sessions);
+  }
+
+  serialization::readPod(inputFile, dayCount);
+  serialization::readPod(inputFile, dayHead);
+  if (dayCount > DAY_RING_SIZE || dayHead >= DAY_RING_SIZE) {
+    Serial.printf("[%lu] [STATS] Deserialization failed: Bad day ring header\n", millis());
+    dayCount = 0;
+    dayHead = 0;
+    inputFile.close();
+    return false;
+  }
+  for (int i = 0; i < DAY_RING_SIZE; i++) {
+    serialization::readPod(inputFile, dayRing[i].dayIndex);
+    serialization::readPod(inputFile, dayRing[i].readSeconds);
+    serialization::readPod(inputFile, dayRing[i].pageTurns);
+  }
+
+  inputFile.close();
+  Serial.printf("[%lu] [STATS] Reading stats loaded (%u books, %u days)\n", millis(), bookRowCount, dayCount);
+  return true;
+}
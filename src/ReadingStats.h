@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * Reading statistics with constant memory and O(1) update cost. The reader feeds one in-RAM
+ * session accumulator on page turns; endSession() folds it into fixed-size per-book rows and
+ * a fixed ring of daily rows, and the store flushes like the other write-behind stores
+ * (reader exit, sleep path). Nothing is appended: the file is a fixed-layout snapshot, so
+ * the stats screen renders from pre-aggregated rows with no history to parse.
+ *
+ * "Days" are 24h windows of the system clock, which the ESP32 restores from the RTC across
+ * deep sleep but loses on a full power-down; streaks are therefore measured since the last
+ * cold boot rather than the calendar - the device has no battery-backed calendar or time
+ * sync to anchor real dates.
+ */
+class ReadingStatsStore {
+ public:
+  struct BookRow {
+    uint64_t pathHash = 0;  // FNV-1a 64-bit hash of the book path
+    uint32_t readSeconds = 0;
+    uint32_t pageTurns = 0;
+    uint16_t sessions = 0;
+  };
+
+  struct DayRow {
+    uint32_t dayIndex = 0;  // 24h windows of the system clock (see header comment)
+    uint32_t readSeconds = 0;
+    uint32_t pageTurns = 0;
+  };
+
+  static constexpr int MAX_BOOK_ROWS = 32;
+  static constexpr int DAY_RING_SIZE = 30;
+  // A pause longer than this between page turns doesn't count as reading time
+  static constexpr uint32_t ACTIVE_GAP_CAP_SECONDS = 5 * 60;
+
+ private:
+  // Static instance
+  static ReadingStatsStore instance;
+
+  BookRow bookRows[MAX_BOOK_ROWS];
+  uint16_t bookRowCount = 0;
+  DayRow dayRing[DAY_RING_SIZE];
+  uint8_t dayCount = 0;
+  uint8_t dayHead = 0;  // Slot holding the newest day (valid when dayCount > 0)
+  uint32_t totalReadSeconds = 0;
+  uint32_t totalPageTurns = 0;
+  bool dirty = false;
+
+  // In-RAM accumulator for the currently open book
+  bool sessionOpen = false;
+  uint64_t sessionBookHash = 0;
+  uint32_t sessionLastEventSec = 0;
+  uint32_t sessionActiveSeconds = 0;
+  uint32_t sessionPageTurns = 0;
+
+  static uint64_t fnvHash64(const std::string& s);
+  static uint32_t nowSeconds();
+  BookRow* findOrAddBookRow(uint64_t pathHash);
+  DayRow& currentDayRow();
+  void creditActiveTime();
+
+ public:
+  ~ReadingStatsStore() = default;
+
+  // Get singleton instance
+  static ReadingStatsStore& getInstance() { return instance; }
+
+  // Session accumulator, driven by the reader activities
+  void beginSession(const std::string& bookPath);
+  // O(1): count the turn and credit the capped time since the last event
+  void notePageTurn();
+  // Fold the accumulator into the per-book and daily rows and mark the store dirty
+  void endSession();
+
+  // Pre-aggregated accessors for the stats screen
+  uint32_t getTotalReadSeconds() const { return totalReadSeconds; }
+  uint32_t getTotalPageTurns() const { return totalPageTurns; }
+  int getBookRowCount() const { return bookRowCount; }
+  // Pages per hour over all recorded reading; 0 until something is recorded
+  uint32_t getPagesPerHour() const;
+  // Consecutive 24h windows with reading ending today or yesterday; 0 otherwise
+  int getStreakDays() const;
+  // Today's daily row (zeros when nothing was read today)
+  DayRow getToday() const;
+
+  // Persist only if a session was folded in since the last save
+  bool flushIfDirty();
+
+  bool saveToFile();
+
+  bool loadFromFile();
+};
+
+// Helper macro to access the reading stats store
+#define READING_STATS ReadingStatsStore::getInstance()
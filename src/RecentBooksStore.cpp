@@ -5,32 +5,200 @@
 #include <Serialization.h>
 
 #include <algorithm>
+#include <cstring>
 
 namespace {
-constexpr uint8_t RECENT_BOOKS_FILE_VERSION = 2;
+// v5: fixed 512-byte slots patched in place. A progress or thumbnail update is one aligned
+// single-sector write instead of a full-file rewrite, and recency lives in per-slot sequence
+// numbers so a move-to-front also touches only the moved slot. v4 and older (length-prefixed
+// record blobs) are still readable and get rewritten in the new layout on the next flush.
+constexpr uint8_t RECENT_BOOKS_FILE_VERSION = 5;
 constexpr char RECENT_BOOKS_FILE[] = "/.crosspoint/recent.bin";
 constexpr int MAX_RECENT_BOOKS = 10;
+
+// One SD sector; slot writes stay aligned so the card controller never read-modify-writes
+constexpr uint32_t SLOT_BYTES = 512;
+
+// On-disk slot layout. Strings are NUL-terminated and truncated to fit; FAT paths on this
+// device are comfortably short of the path field
+struct SlotRecord {
+  uint8_t used;
+  uint8_t progressPercent;
+  uint16_t reserved;
+  uint32_t sequence;
+  char path[252];
+  char title[128];
+  char author[64];
+  char thumbBmpPath[60];
+};
+static_assert(sizeof(SlotRecord) == SLOT_BYTES, "SlotRecord must fill one sector");
+
+uint32_t slotOffset(const uint8_t slot) {
+  // Block 0 is the header (version + slot count); slots follow, one sector each
+  return SLOT_BYTES * (static_cast<uint32_t>(slot) + 1);
+}
+
+void fillSlot(SlotRecord& record, const RecentBook& book) {
+  memset(&record, 0, sizeof(record));
+  record.used = 1;
+  record.progressPercent = book.progressPercent;
+  record.sequence = book.sequence;
+  strlcpy(record.path, book.path.c_str(), sizeof(record.path));
+  strlcpy(record.title, book.title.c_str(), sizeof(record.title));
+  strlcpy(record.author, book.author.c_str(), sizeof(record.author));
+  strlcpy(record.thumbBmpPath, book.thumbBmpPath.c_str(), sizeof(record.thumbBmpPath));
+}
 }  // namespace
 
 RecentBooksStore RecentBooksStore::instance;
 
+uint8_t RecentBooksStore::allocateSlot() const {
+  bool taken[MAX_RECENT_BOOKS] = {};
+  for (const auto& book : recentBooks) {
+    if (book.slot < MAX_RECENT_BOOKS) {
+      taken[book.slot] = true;
+    }
+  }
+  for (uint8_t slot = 0; slot < MAX_RECENT_BOOKS; slot++) {
+    if (!taken[slot]) {
+      return slot;
+    }
+  }
+  // Unreachable while the list is trimmed to MAX_RECENT_BOOKS before allocation
+  return 0;
+}
+
 void RecentBooksStore::addBook(const std::string& path, const std::string& title, const std::string& author) {
-  // Remove existing entry if present
   auto it =
       std::find_if(recentBooks.begin(), recentBooks.end(), [&](const RecentBook& book) { return book.path == path; });
+
   if (it != recentBooks.end()) {
+    // Re-opened: move to front, keeping thumb/progress and refreshing metadata if it changed
+    RecentBook book = std::move(*it);
+    if (!title.empty() && book.title != title) {
+      book.title = title;
+      book.slotDirty = true;
+      dirty = true;
+    }
+    if (!author.empty() && book.author != author) {
+      book.author = author;
+      book.slotDirty = true;
+      dirty = true;
+    }
+    if (it != recentBooks.begin()) {
+      // Recency is a per-slot sequence number, so the reorder costs one slot write
+      book.sequence = nextSequence++;
+      book.slotDirty = true;
+      dirty = true;
+    }
     recentBooks.erase(it);
+    recentBooks.insert(recentBooks.begin(), std::move(book));
+    return;
+  }
+
+  // Evict the oldest first so its slot is free for the newcomer
+  if (recentBooks.size() >= MAX_RECENT_BOOKS) {
+    while (recentBooks.size() >= MAX_RECENT_BOOKS) {
+      if (recentBooks.back().slot < MAX_RECENT_BOOKS) {
+        freedSlots.push_back(recentBooks.back().slot);
+      }
+      recentBooks.pop_back();
+    }
   }
 
   // Add to front
-  recentBooks.insert(recentBooks.begin(), {path, title, author});
+  RecentBook book{path, title, author, "", 0};
+  book.slot = allocateSlot();
+  book.sequence = nextSequence++;
+  book.slotDirty = true;
+  recentBooks.insert(recentBooks.begin(), std::move(book));
+  dirty = true;
+}
 
-  // Trim to max size
-  if (recentBooks.size() > MAX_RECENT_BOOKS) {
-    recentBooks.resize(MAX_RECENT_BOOKS);
+void RecentBooksStore::updateProgress(const std::string& path, const uint8_t progressPercent) {
+  auto it =
+      std::find_if(recentBooks.begin(), recentBooks.end(), [&](const RecentBook& book) { return book.path == path; });
+  if (it != recentBooks.end() && it->progressPercent != progressPercent) {
+    it->progressPercent = progressPercent;
+    it->slotDirty = true;
+    dirty = true;
   }
+}
 
-  saveToFile();
+void RecentBooksStore::updateThumb(const std::string& path, const std::string& thumbBmpPath) {
+  auto it =
+      std::find_if(recentBooks.begin(), recentBooks.end(), [&](const RecentBook& book) { return book.path == path; });
+  if (it != recentBooks.end() && it->thumbBmpPath != thumbBmpPath) {
+    it->thumbBmpPath = thumbBmpPath;
+    it->slotDirty = true;
+    dirty = true;
+  }
+}
+
+const RecentBook* RecentBooksStore::findBook(const std::string& path) const {
+  auto it =
+      std::find_if(recentBooks.begin(), recentBooks.end(), [&](const RecentBook& book) { return book.path == path; });
+  return it != recentBooks.end() ? &(*it) : nullptr;
+}
+
+bool RecentBooksStore::flushIfDirty() {
+  if (!dirty) {
+    return true;
+  }
+  if (fullRewrite) {
+    if (!saveToFile()) {
+      return false;
+    }
+    fullRewrite = false;
+  } else if (!writeDirtySlots()) {
+    // Fall back to a full rewrite next time rather than leaving the file half-patched
+    fullRewrite = true;
+    return false;
+  }
+  for (auto& book : recentBooks) {
+    book.slotDirty = false;
+  }
+  freedSlots.clear();
+  dirty = false;
+  return true;
+}
+
+bool RecentBooksStore::writeDirtySlots() {
+  FsFile file = SdMan.open(RECENT_BOOKS_FILE, O_RDWR);
+  if (!file) {
+    // Nothing on disk yet (or the card was swapped); build the file from scratch
+    file.close();
+    return saveToFile();
+  }
+
+  SlotRecord record;
+  int slotsWritten = 0;
+
+  // Zero vacated slots first, in case an eviction's slot was immediately reused below
+  for (const uint8_t slot : freedSlots) {
+    memset(&record, 0, sizeof(record));
+    if (!file.seekSet(slotOffset(slot)) || file.write(&record, sizeof(record)) != sizeof(record)) {
+      file.close();
+      return false;
+    }
+    slotsWritten++;
+  }
+
+  for (const auto& book : recentBooks) {
+    if (!book.slotDirty) {
+      continue;
+    }
+    fillSlot(record, book);
+    if (!file.seekSet(slotOffset(book.slot)) || file.write(&record, sizeof(record)) != sizeof(record)) {
+      file.close();
+      return false;
+    }
+    slotsWritten++;
+  }
+
+  file.close();
+  Serial.printf("[%lu] [RBS] Patched %d recent book slot(s) in place\n", millis(), slotsWritten);
+  return true;
 }
 
 bool RecentBooksStore::saveToFile() const {
@@ -42,65 +210,133 @@ bool RecentBooksStore::saveToFile() const {
     return false;
   }
 
-  serialization::writePod(outputFile, RECENT_BOOKS_FILE_VERSION);
-  const uint8_t count = static_cast<uint8_t>(recentBooks.size());
-  serialization::writePod(outputFile, count);
+  uint8_t header[SLOT_BYTES] = {};
+  header[0] = RECENT_BOOKS_FILE_VERSION;
+  header[1] = MAX_RECENT_BOOKS;
+  if (outputFile.write(header, sizeof(header)) != sizeof(header)) {
+    outputFile.close();
+    return false;
+  }
 
+  // Lay the slots out by index so later in-place patches land where load() expects them
+  SlotRecord slots[MAX_RECENT_BOOKS] = {};
   for (const auto& book : recentBooks) {
-    serialization::writeString(outputFile, book.path);
-    serialization::writeString(outputFile, book.title);
-    serialization::writeString(outputFile, book.author);
+    if (book.slot < MAX_RECENT_BOOKS) {
+      fillSlot(slots[book.slot], book);
+    }
+  }
+  for (const auto& slot : slots) {
+    if (outputFile.write(&slot, sizeof(slot)) != sizeof(slot)) {
+      outputFile.close();
+      return false;
+    }
   }
 
   outputFile.close();
-  Serial.printf("[%lu] [RBS] Recent books saved to file (%d entries)\n", millis(), count);
+  Serial.printf("[%lu] [RBS] Recent books saved to file (%d entries)\n", millis(),
+                static_cast<int>(recentBooks.size()));
   return true;
 }
 
 bool RecentBooksStore::loadFromFile() {
   FsFile inputFile;
   if (!SdMan.openFileForRead("RBS", RECENT_BOOKS_FILE, inputFile)) {
+    // First boot: the next flush creates the file
+    fullRewrite = true;
     return false;
   }
 
   uint8_t version;
   serialization::readPod(inputFile, version);
-  if (version != RECENT_BOOKS_FILE_VERSION) {
-    if (version == 1) {
-      // Old version, just read paths
-      uint8_t count;
-      serialization::readPod(inputFile, count);
-      recentBooks.clear();
-      recentBooks.reserve(count);
-      for (uint8_t i = 0; i < count; i++) {
-        std::string path;
-        serialization::readString(inputFile, path);
-        // Title and author will be empty, they will be filled when the book is
-        // opened again
-        recentBooks.push_back({path, "", ""});
+  if (version > RECENT_BOOKS_FILE_VERSION || version < 1) {
+    Serial.printf("[%lu] [RBS] Deserialization failed: Unknown version %u\n", millis(), version);
+    inputFile.close();
+    fullRewrite = true;
+    return false;
+  }
+
+  recentBooks.clear();
+
+  if (version >= 5) {
+    uint8_t slotCount = 0;
+    serialization::readPod(inputFile, slotCount);
+    slotCount = std::min<uint8_t>(slotCount, MAX_RECENT_BOOKS);
+
+    SlotRecord record;
+    for (uint8_t slot = 0; slot < slotCount; slot++) {
+      if (!inputFile.seekSet(slotOffset(slot)) ||
+          inputFile.read(&record, sizeof(record)) != static_cast<int>(sizeof(record))) {
+        break;
       }
-    } else {
-      Serial.printf("[%lu] [RBS] Deserialization failed: Unknown version %u\n", millis(), version);
-      inputFile.close();
-      return false;
+      if (!record.used) {
+        continue;
+      }
+      // Defensive NUL termination against a torn write
+      record.thumbBmpPath[sizeof(record.thumbBmpPath) - 1] = '\0';
+      RecentBook book;
+      book.path.assign(record.path, strnlen(record.path, sizeof(record.path)));
+      book.title.assign(record.title, strnlen(record.title, sizeof(record.title)));
+      book.author.assign(record.author, strnlen(record.author, sizeof(record.author)));
+      book.thumbBmpPath.assign(record.thumbBmpPath, strnlen(record.thumbBmpPath, sizeof(record.thumbBmpPath)));
+      book.progressPercent = record.progressPercent;
+      book.slot = slot;
+      book.sequence = record.sequence;
+      recentBooks.push_back(std::move(book));
+      nextSequence = std::max(nextSequence, record.sequence + 1);
     }
+    // Most recent first; sequence numbers replace on-disk ordering
+    std::sort(recentBooks.begin(), recentBooks.end(),
+              [](const RecentBook& a, const RecentBook& b) { return a.sequence > b.sequence; });
   } else {
+    // Legacy variable-length formats; read once, then rewrite in the slot layout on next flush
     uint8_t count;
     serialization::readPod(inputFile, count);
-
-    recentBooks.clear();
     recentBooks.reserve(count);
 
+    serialization::RecordView record;
     for (uint8_t i = 0; i < count; i++) {
-      std::string path, title, author;
-      serialization::readString(inputFile, path);
-      serialization::readString(inputFile, title);
-      serialization::readString(inputFile, author);
-      recentBooks.push_back({path, title, author});
+      RecentBook book;
+      if (version >= 4) {
+        // One bulk read per record
+        if (!record.readFrom(inputFile)) {
+          Serial.printf("[%lu] [RBS] Bad record %u, dropping the rest of the file\n", millis(), i);
+          break;
+        }
+        record.str(book.path);
+        record.str(book.title);
+        record.str(book.author);
+        record.str(book.thumbBmpPath);
+        record.pod(book.progressPercent);
+      } else {
+        serialization::readString(inputFile, book.path);
+        if (version >= 2) {
+          serialization::readString(inputFile, book.title);
+          serialization::readString(inputFile, book.author);
+        }
+        if (version >= 3) {
+          serialization::readString(inputFile, book.thumbBmpPath);
+          serialization::readPod(inputFile, book.progressPercent);
+        }
+      }
+      // Fields missing from older versions stay empty and get backfilled as books are opened
+      recentBooks.push_back(std::move(book));
+      if (recentBooks.size() >= MAX_RECENT_BOOKS) {
+        break;
+      }
+    }
+
+    // Assign slots by list position; stored order was most recent first
+    for (size_t i = 0; i < recentBooks.size(); i++) {
+      recentBooks[i].slot = static_cast<uint8_t>(i);
+      recentBooks[i].sequence = static_cast<uint32_t>(recentBooks.size() - i);
     }
+    nextSequence = static_cast<uint32_t>(recentBooks.size()) + 1;
+    fullRewrite = true;
+    dirty = true;
   }
 
   inputFile.close();
-  Serial.printf("[%lu] [RBS] Recent books loaded from file (%d entries)\n", millis(), recentBooks.size());
+  Serial.printf("[%lu] [RBS] Recent books loaded from file (%d entries)\n", millis(),
+                static_cast<int>(recentBooks.size()));
   return true;
 }
@@ -1,11 +1,23 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 
+// Denormalized record for one recently opened book. Carries everything the home screen and the
+// Recent tab need to render (title, author, progress, thumbnail path), so neither has to
+// instantiate an Epub/Xtc just to show a list row or the Continue Reading card.
 struct RecentBook {
   std::string path;
   std::string title;
   std::string author;
+  std::string thumbBmpPath;    // Set once the cover thumbnail has been generated
+  uint8_t progressPercent = 0;  // Last known reading progress (0-100)
+
+  // Managed by RecentBooksStore: fixed-record file slot, recency sequence (higher = more
+  // recent) and whether the slot needs rewriting on the next flush
+  uint8_t slot = 0xFF;
+  uint32_t sequence = 0;
+  bool slotDirty = false;
 
   bool operator==(const RecentBook& other) const { return path == other.path; }
 };
@@ -15,6 +27,19 @@ class RecentBooksStore {
   static RecentBooksStore instance;
 
   std::vector<RecentBook> recentBooks;
+  // Write-behind: mutators only touch RAM and set this; flushIfDirty() persists when something
+  // actually changed (readers flush on exit, SleepActivity flushes before power-down)
+  bool dirty = false;
+  // Set when the on-disk file can't be patched in place (missing or legacy-format file); the
+  // next flush rewrites the whole store instead of individual slots
+  bool fullRewrite = false;
+  // Recency counter; the newest record carries the highest value
+  uint32_t nextSequence = 1;
+  // Slots vacated by evictions, zeroed on the next flush so stale records don't resurrect
+  std::vector<uint8_t> freedSlots;
+
+  uint8_t allocateSlot() const;
+  bool writeDirtySlots();
 
  public:
   ~RecentBooksStore() = default;
@@ -22,15 +47,29 @@ class RecentBooksStore {
   // Get singleton instance
   static RecentBooksStore& getInstance() { return instance; }
 
-  // Add a book to the recent list (moves to front if already exists)
+  // Add a book to the recent list (moves to front if already exists, preserving the
+  // denormalized fields the caller doesn't supply)
   void addBook(const std::string& path, const std::string& title, const std::string& author);
 
+  // Update denormalized fields on an existing record; no-ops when nothing changes
+  void updateProgress(const std::string& path, uint8_t progressPercent);
+  void updateThumb(const std::string& path, const std::string& thumbBmpPath);
+
+  // Look up a record by path; nullptr when the book isn't in the list
+  const RecentBook* findBook(const std::string& path) const;
+
   // Get the list of recent books (most recent first)
   const std::vector<RecentBook>& getBooks() const { return recentBooks; }
 
   // Get the count of recent books
   int getCount() const { return static_cast<int>(recentBooks.size()); }
 
+  // Persist only if a mutator changed something since the last save. The common case (progress
+  // bump, thumbnail backfill, move-to-front) patches just the changed 512-byte slots in place;
+  // a full rewrite only happens for a fresh or legacy-format file
+  bool flushIfDirty();
+
+  // Full rewrite of the fixed-record file (header block plus every slot)
   bool saveToFile() const;
 
   bool loadFromFile();
@@ -8,10 +8,27 @@
 #include "Battery.h"
 #include "fontIds.h"
 
+namespace {
+// Stamp cache for the battery chrome, which nearly every screen redraws identically.
+// The region covers the icon plus the widest percentage text ("100%").
+constexpr int BATTERY_STAMP_W = 64;
+constexpr int BATTERY_STAMP_H = 22;
+std::string batteryStampKey;
+std::vector<uint8_t> batteryStamp;
+}  // namespace
+
 void ScreenComponents::drawBattery(const GfxRenderer& renderer, const int left, const int top,
                                    const bool showPercentage) {
-  // Left aligned battery icon and percentage
-  const uint16_t percentage = battery.readPercentage();
+  // Left aligned battery icon and percentage, from the background-sampled cache
+  const uint16_t percentage = BATTERY.percentage();
+
+  const std::string stampKey = std::to_string(percentage) + (showPercentage ? "%" : "") + "@" + std::to_string(left) +
+                               "," + std::to_string(top);
+  if (stampKey == batteryStampKey && !batteryStamp.empty() &&
+      renderer.pasteStamp(left, top, BATTERY_STAMP_W, BATTERY_STAMP_H, batteryStamp.data())) {
+    return;
+  }
+
   const auto percentageText = showPercentage ? std::to_string(percentage) + "%" : "";
   renderer.drawText(SMALL_FONT_ID, left + 20, top, percentageText.c_str());
 
@@ -40,6 +57,14 @@ void ScreenComponents::drawBattery(const GfxRenderer& renderer, const int left,
   }
 
   renderer.fillRect(x + 2, y + 2, filledWidth, batteryHeight - 4);
+
+  batteryStamp.resize(GfxRenderer::stampSize(BATTERY_STAMP_W, BATTERY_STAMP_H));
+  if (renderer.captureStamp(left, top, BATTERY_STAMP_W, BATTERY_STAMP_H, batteryStamp.data())) {
+    batteryStampKey = stampKey;
+  } else {
+    batteryStamp.clear();
+    batteryStampKey.clear();
+  }
 }
 
 void ScreenComponents::drawBookProgressBar(const GfxRenderer& renderer, const size_t bookProgress) {
@@ -0,0 +1,62 @@
+#include "SdIoScheduler.h"
+
+#include <HalSpiBus.h>
+
+SdIoScheduler SdIoScheduler::instance;
+
+void SdIoScheduler::enter(IoClass ioClass) {
+  const uint8_t idx = static_cast<uint8_t>(ioClass);
+  taskENTER_CRITICAL(&mux);
+  activeDepth[idx]++;
+  if (activeDepth[idx] > maxDepth[idx]) {
+    maxDepth[idx] = activeDepth[idx];
+  }
+  taskEXIT_CRITICAL(&mux);
+}
+
+void SdIoScheduler::exit(IoClass ioClass) {
+  const uint8_t idx = static_cast<uint8_t>(ioClass);
+  taskENTER_CRITICAL(&mux);
+  if (activeDepth[idx] > 0) {
+    activeDepth[idx]--;
+  }
+  taskEXIT_CRITICAL(&mux);
+}
+
+bool SdIoScheduler::uiActive() const {
+  taskENTER_CRITICAL(&mux);
+  const bool active = activeDepth[static_cast<uint8_t>(IoClass::UI)] > 0;
+  taskEXIT_CRITICAL(&mux);
+  return active;
+}
+
+void SdIoScheduler::yieldToUi() {
+  // Wait out any batched panel transfer first so bulk SD reads get a contiguous bus window
+  // instead of interleaving with the display's SPI traffic
+  SPI_BUS.waitForWindow();
+  if (!uiActive()) {
+    return;
+  }
+  const unsigned long start = millis();
+  while (uiActive() && millis() - start < maxYieldWaitMs) {
+    vTaskDelay(5 / portTICK_PERIOD_MS);
+  }
+  const uint32_t waited = millis() - start;
+  taskENTER_CRITICAL(&mux);
+  yields++;
+  yieldWaitMs += waited;
+  taskEXIT_CRITICAL(&mux);
+}
+
+SdIoScheduler::Stats SdIoScheduler::getStats() const {
+  Stats stats;
+  taskENTER_CRITICAL(&mux);
+  for (uint8_t i = 0; i < NUM_CLASSES; i++) {
+    stats.activeDepth[i] = activeDepth[i];
+    stats.maxDepth[i] = maxDepth[i];
+  }
+  stats.yields = yields;
+  stats.yieldWaitMs = yieldWaitMs;
+  taskEXIT_CRITICAL(&mux);
+  return stats;
+}
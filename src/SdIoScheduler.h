@@ -0,0 +1,67 @@
+#pragma once
+#include <Arduino.h>
+
+#include <cstdint>
+
+// Cooperative SD access scheduler. SdFat call sites are synchronous and SDCardManager is an SDK
+// library, so there is no request queue to reorder; instead the users are classified. Interactive
+// sections (page renders) declare themselves with a Scope, and long-running lower-class writers
+// (upload flush, thumbnail pre-generation, pre-pagination) call yieldToUi() between chunks, so a
+// page turn never queues behind hundreds of milliseconds of background SD traffic.
+class SdIoScheduler {
+ public:
+  // Ordered by priority: UI-blocking work beats speculative prefetch beats background jobs
+  enum class IoClass : uint8_t { UI = 0, PREFETCH = 1, BACKGROUND = 2 };
+  static constexpr uint8_t NUM_CLASSES = 3;
+
+  struct Stats {
+    uint8_t activeDepth[NUM_CLASSES];  // Sections currently in flight per class
+    uint8_t maxDepth[NUM_CLASSES];     // High-water marks since boot
+    uint32_t yields;                   // Times a lower class gave way to the UI
+    uint32_t yieldWaitMs;              // Total time spent giving way
+  };
+
+  // RAII marker for a section of SD access; holds its class active for the scope's lifetime
+  class Scope {
+    const IoClass ioClass;
+
+   public:
+    explicit Scope(IoClass ioClass) : ioClass(ioClass) { getInstance().enter(ioClass); }
+    ~Scope() { getInstance().exit(ioClass); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  // Get singleton instance
+  static SdIoScheduler& getInstance() { return instance; }
+
+  void enter(IoClass ioClass);
+  void exit(IoClass ioClass);
+
+  // True while a UI-class section is in flight
+  bool uiActive() const;
+
+  // For PREFETCH/BACKGROUND loops: block between chunks while a UI-class section is active or a
+  // panel transfer holds the shared SPI bus (see HalSpiBus). Capped so a wedged interactive
+  // section can't starve a writer indefinitely.
+  void yieldToUi();
+
+  Stats getStats() const;
+
+ private:
+  SdIoScheduler() = default;
+
+  // Static instance
+  static SdIoScheduler instance;
+
+  static constexpr uint32_t maxYieldWaitMs = 2000;
+
+  // Counters are touched from the main loop, the display tasks and background tasks
+  mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+  uint8_t activeDepth[NUM_CLASSES] = {0, 0, 0};
+  uint8_t maxDepth[NUM_CLASSES] = {0, 0, 0};
+  uint32_t yields = 0;
+  uint32_t yieldWaitMs = 0;
+};
+
+#define SD_SCHED SdIoScheduler::getInstance()
@@ -0,0 +1,53 @@
+#include "SleepFrameCache.h"
+
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+namespace {
+constexpr char CACHE_FILE[] = "/.crosspoint/sleepframe.bin";
+constexpr uint32_t CACHE_MAGIC = 0x534C4650;  // 'SLFP'
+constexpr uint8_t CACHE_VERSION = 1;
+}  // namespace
+
+bool SleepFrameCache::restore(const GfxRenderer& renderer, const std::string& key) {
+  FsFile file;
+  if (!SdMan.openFileForRead("SLF", CACHE_FILE, file)) {
+    return false;
+  }
+  uint32_t magic = 0;
+  uint8_t version = 0;
+  std::string storedKey;
+  serialization::readPod(file, magic);
+  serialization::readPod(file, version);
+  serialization::readString(file, storedKey);
+  bool ok = magic == CACHE_MAGIC && version == CACHE_VERSION && storedKey == key;
+  if (ok) {
+    const size_t bufferSize = GfxRenderer::getBufferSize();
+    ok = file.read(renderer.getFrameBuffer(), bufferSize) == static_cast<int>(bufferSize);
+  }
+  file.close();
+  if (!ok) {
+    Serial.printf("[%lu] [SLF] Cached sleep frame stale or invalid, recomposing\n", millis());
+  }
+  return ok;
+}
+
+bool SleepFrameCache::save(const GfxRenderer& renderer, const std::string& key) {
+  FsFile file;
+  if (!SdMan.openFileForWrite("SLF", CACHE_FILE, file)) {
+    return false;
+  }
+  serialization::writePod(file, CACHE_MAGIC);
+  serialization::writePod(file, CACHE_VERSION);
+  serialization::writeString(file, key);
+  const size_t written = file.write(renderer.getFrameBuffer(), GfxRenderer::getBufferSize());
+  file.close();
+  if (written != GfxRenderer::getBufferSize()) {
+    Serial.printf("[%lu] [SLF] Short sleep frame write, dropping it\n", millis());
+    SdMan.remove(CACHE_FILE);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+class GfxRenderer;
+
+// Composed-sleep-frame cache. Building the cover sleep screen costs an EPUB load, a JPEG
+// decode, scaling and dithering - all spent while the user is waiting for the device to power
+// down. The finished BW frame is stored on SD keyed by what composed it (book path plus the
+// sleep-screen settings); when the key still matches on the next sleep, the frame is blitted
+// straight into the framebuffer and entering sleep is a single buffer push. Unlike the wake
+// snapshot this is a cache, not consume-once: it stays valid until the key changes.
+namespace SleepFrameCache {
+
+// Load the cached frame into the framebuffer when its key matches; false on any mismatch
+bool restore(const GfxRenderer& renderer, const std::string& key);
+
+// Write the current framebuffer under the given key; drops the file on a short write
+bool save(const GfxRenderer& renderer, const std::string& key);
+
+}  // namespace SleepFrameCache
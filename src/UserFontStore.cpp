@@ -0,0 +1,60 @@
+#include "UserFontStore.h"
+
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+#include "util/StringUtils.h"
+
+UserFontStore UserFontStore::instance;
+
+namespace {
+constexpr const char* FONTS_DIR = "/fonts";
+// Pinned glyph tables cost a few KB each; cap how many we keep resident
+constexpr size_t MAX_USER_FONTS = 4;
+
+// Same FNV-1a the font id generator uses for the built-ins, so ids are stable across sessions
+// as long as the filename doesn't change
+int fontIdForName(const std::string& name) {
+  uint32_t hash = 2166136261u;
+  for (const char c : name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return static_cast<int>(hash);
+}
+}  // namespace
+
+void UserFontStore::ensureRegistered(GfxRenderer& renderer) {
+  if (scanned) {
+    return;
+  }
+  scanned = true;
+
+  FsFile dir = SdMan.open(FONTS_DIR);
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+
+  char name[256];
+  FsFile entry = dir.openNextFile();
+  while (entry && fonts.size() < MAX_USER_FONTS) {
+    entry.getName(name, sizeof(name));
+    entry.close();
+    const std::string fileName = name;
+    if (fileName[0] != '.' && StringUtils::checkFileExtension(fileName, ".cpf")) {
+      auto font = std::unique_ptr<SdFont>(new SdFont());
+      if (font->load(std::string(FONTS_DIR) + "/" + fileName)) {
+        const int fontId = fontIdForName(fileName);
+        renderer.insertFont(fontId, font->getFamily());
+        fontIds.push_back(fontId);
+        fonts.push_back(std::move(font));
+      }
+    }
+    entry = dir.openNextFile();
+  }
+  dir.close();
+
+  if (!fonts.empty()) {
+    Serial.printf("[%lu] [FNT] Registered %u user font(s)\n", millis(), static_cast<unsigned>(fonts.size()));
+  }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <SdFont.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class GfxRenderer;
+
+// Registry of user fonts loaded from /fonts/*.cpf on the SD card. Fonts are SD-backed (see
+// SdFont): only their glyph tables are pinned, bitmaps are demand-paged through the renderer's
+// glyph cache. Scanning and registration happen lazily the first time a reader needs the list,
+// keeping the boot path free of SD reads; the SdFont instances live for the rest of the session
+// because the renderer's font map holds pointers into them.
+class UserFontStore {
+  static UserFontStore instance;
+
+  std::vector<std::unique_ptr<SdFont>> fonts;
+  std::vector<int> fontIds;
+  bool scanned = false;
+
+ public:
+  ~UserFontStore() = default;
+
+  static UserFontStore& getInstance() { return instance; }
+
+  // Scan /fonts and register every valid .cpf with the renderer; no-op after the first call
+  void ensureRegistered(GfxRenderer& renderer);
+
+  // Font id of the first registered user font, or 0 when none is present (callers fall back to
+  // a built-in family). Only meaningful after ensureRegistered() has run.
+  int getFontId() const { return fontIds.empty() ? 0 : fontIds.front(); }
+};
+
+#define USER_FONTS UserFontStore::getInstance()
@@ -0,0 +1,52 @@
+#include "WakeSnapshot.h"
+
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+namespace {
+constexpr char SNAPSHOT_FILE[] = "/.crosspoint/wake.bin";
+constexpr uint32_t SNAPSHOT_MAGIC = 0x57414B45;  // 'WAKE'
+constexpr uint8_t SNAPSHOT_VERSION = 1;
+constexpr size_t SNAPSHOT_SIZE = sizeof(SNAPSHOT_MAGIC) + sizeof(SNAPSHOT_VERSION) + HalDisplay::BUFFER_SIZE;
+}  // namespace
+
+bool WakeSnapshot::save(const GfxRenderer& renderer) {
+  FsFile file;
+  if (!SdMan.openFileForWrite("WKS", SNAPSHOT_FILE, file)) {
+    return false;
+  }
+  serialization::writePod(file, SNAPSHOT_MAGIC);
+  serialization::writePod(file, SNAPSHOT_VERSION);
+  const size_t written = file.write(renderer.getFrameBuffer(), GfxRenderer::getBufferSize());
+  file.close();
+  if (written != GfxRenderer::getBufferSize()) {
+    Serial.printf("[%lu] [WKS] Short snapshot write, dropping it\n", millis());
+    SdMan.remove(SNAPSHOT_FILE);
+    return false;
+  }
+  return true;
+}
+
+bool WakeSnapshot::restore(const GfxRenderer& renderer) {
+  FsFile file;
+  if (!SdMan.openFileForRead("WKS", SNAPSHOT_FILE, file)) {
+    return false;
+  }
+  uint32_t magic = 0;
+  uint8_t version = 0;
+  serialization::readPod(file, magic);
+  serialization::readPod(file, version);
+  bool ok = magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION && file.size() == SNAPSHOT_SIZE;
+  if (ok) {
+    const size_t bufferSize = GfxRenderer::getBufferSize();
+    ok = file.read(renderer.getFrameBuffer(), bufferSize) == static_cast<int>(bufferSize);
+  }
+  file.close();
+  SdMan.remove(SNAPSHOT_FILE);
+  if (!ok) {
+    Serial.printf("[%lu] [WKS] Ignoring snapshot with unknown version or bad length\n", millis());
+  }
+  return ok;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+class GfxRenderer;
+
+// Last-screen snapshot for fast perceived wake. SleepActivity dumps the framebuffer to SD right
+// before the sleep screen replaces it; BootActivity blits it back on wake instead of the boot
+// screen, so the last page is on glass again while the rest of the stack (SD-heavy book load,
+// section open) initializes behind it. Consume-once like the reader's resume manifest: the file
+// is removed as soon as it is read, so a stale snapshot can never outlive the state it reflects.
+namespace WakeSnapshot {
+
+// Write the current framebuffer to SD; false (and no file left behind) on a short write
+bool save(const GfxRenderer& renderer);
+
+// Restore the snapshot into the framebuffer and delete it; true when there is something to flush
+bool restore(const GfxRenderer& renderer);
+
+}  // namespace WakeSnapshot
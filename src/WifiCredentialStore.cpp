@@ -4,12 +4,15 @@
 #include <SDCardManager.h>
 #include <Serialization.h>
 
+#include <cstring>
+
 // Initialize the static instance
 WifiCredentialStore WifiCredentialStore::instance;
 
 namespace {
-// File format version
-constexpr uint8_t WIFI_FILE_VERSION = 1;
+// File format version. Version 2 appended the last-connection fast-reconnect
+// record; version 1 files (credentials only) still load.
+constexpr uint8_t WIFI_FILE_VERSION = 2;
 
 // WiFi credentials file path
 constexpr char WIFI_FILE[] = "/.crosspoint/wifi.bin";
@@ -53,6 +56,19 @@ bool WifiCredentialStore::saveToFile() const {
     serialization::writeString(file, obfuscatedPwd);
   }
 
+  // Write the fast-reconnect hint (version 2)
+  const uint8_t hasLast = hasLastConnection() ? 1 : 0;
+  serialization::writePod(file, hasLast);
+  if (hasLast) {
+    serialization::writeString(file, lastConnection.ssid);
+    file.write(lastConnection.bssid, sizeof(lastConnection.bssid));
+    serialization::writePod(file, lastConnection.channel);
+    serialization::writePod(file, lastConnection.ip);
+    serialization::writePod(file, lastConnection.gateway);
+    serialization::writePod(file, lastConnection.subnet);
+    serialization::writePod(file, lastConnection.dns);
+  }
+
   file.close();
   Serial.printf("[%lu] [WCS] Saved %zu WiFi credentials to file\n", millis(), credentials.size());
   return true;
@@ -64,10 +80,10 @@ bool WifiCredentialStore::loadFromFile() {
     return false;
   }
 
-  // Read and verify version
+  // Read and verify version (version 1 lacks the fast-reconnect record)
   uint8_t version;
   serialization::readPod(file, version);
-  if (version != WIFI_FILE_VERSION) {
+  if (version != 1 && version != WIFI_FILE_VERSION) {
     Serial.printf("[%lu] [WCS] Unknown file version: %u\n", millis(), version);
     file.close();
     return false;
@@ -95,6 +111,24 @@ bool WifiCredentialStore::loadFromFile() {
     credentials.push_back(cred);
   }
 
+  // Read the fast-reconnect hint (version 2 onwards)
+  lastConnection = WifiLastConnection{};
+  if (version >= 2) {
+    uint8_t hasLast = 0;
+    serialization::readPod(file, hasLast);
+    if (hasLast) {
+      serialization::readString(file, lastConnection.ssid);
+      file.read(lastConnection.bssid, sizeof(lastConnection.bssid));
+      serialization::readPod(file, lastConnection.channel);
+      serialization::readPod(file, lastConnection.ip);
+      serialization::readPod(file, lastConnection.gateway);
+      serialization::readPod(file, lastConnection.subnet);
+      serialization::readPod(file, lastConnection.dns);
+      Serial.printf("[%lu] [WCS] Loaded fast-reconnect hint for %s (channel %u)\n", millis(),
+                    lastConnection.ssid.c_str(), lastConnection.channel);
+    }
+  }
+
   file.close();
   Serial.printf("[%lu] [WCS] Loaded %zu WiFi credentials from file\n", millis(), credentials.size());
   return true;
@@ -146,6 +180,29 @@ const WifiCredential* WifiCredentialStore::findCredential(const std::string& ssi
 
 bool WifiCredentialStore::hasSavedCredential(const std::string& ssid) const { return findCredential(ssid) != nullptr; }
 
+bool WifiCredentialStore::setLastConnection(const WifiLastConnection& info) {
+  // Avoid rewriting the file when nothing changed (every write hits the SD card)
+  if (info.ssid == lastConnection.ssid && info.channel == lastConnection.channel &&
+      memcmp(info.bssid, lastConnection.bssid, sizeof(info.bssid)) == 0 && info.ip == lastConnection.ip &&
+      info.gateway == lastConnection.gateway && info.subnet == lastConnection.subnet && info.dns == lastConnection.dns) {
+    return true;
+  }
+
+  lastConnection = info;
+  Serial.printf("[%lu] [WCS] Recorded fast-reconnect hint for %s (channel %u)\n", millis(),
+                lastConnection.ssid.c_str(), lastConnection.channel);
+  return saveToFile();
+}
+
+void WifiCredentialStore::clearLastConnection() {
+  if (!hasLastConnection()) {
+    return;
+  }
+  lastConnection = WifiLastConnection{};
+  saveToFile();
+  Serial.printf("[%lu] [WCS] Cleared fast-reconnect hint\n", millis());
+}
+
 void WifiCredentialStore::clearAll() {
   credentials.clear();
   saveToFile();
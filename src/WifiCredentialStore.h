@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -7,6 +8,19 @@ struct WifiCredential {
   std::string password;  // Stored obfuscated in file
 };
 
+// Fast-reconnect hint captured after a successful association. Targeting the
+// last AP by BSSID/channel skips the full scan, and reusing the last DHCP
+// lease as a static hint skips the DHCP exchange.
+struct WifiLastConnection {
+  std::string ssid;
+  uint8_t bssid[6] = {0};
+  uint8_t channel = 0;
+  uint32_t ip = 0;  // Last lease (network byte order, as IPAddress stores it)
+  uint32_t gateway = 0;
+  uint32_t subnet = 0;
+  uint32_t dns = 0;
+};
+
 /**
  * Singleton class for storing WiFi credentials on the SD card.
  * Credentials are stored in /sd/.crosspoint/wifi.bin with basic
@@ -16,6 +30,7 @@ class WifiCredentialStore {
  private:
   static WifiCredentialStore instance;
   std::vector<WifiCredential> credentials;
+  WifiLastConnection lastConnection;
 
   static constexpr size_t MAX_NETWORKS = 8;
 
@@ -48,6 +63,12 @@ class WifiCredentialStore {
   // Check if a network is saved
   bool hasSavedCredential(const std::string& ssid) const;
 
+  // Fast-reconnect hint (persisted alongside credentials)
+  bool hasLastConnection() const { return !lastConnection.ssid.empty() && lastConnection.channel != 0; }
+  const WifiLastConnection& getLastConnection() const { return lastConnection; }
+  bool setLastConnection(const WifiLastConnection& info);
+  void clearLastConnection();
+
   // Clear all credentials
   void clearAll();
 };
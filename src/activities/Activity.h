@@ -1,5 +1,6 @@
 #pragma once
 
+#include <CrashLog.h>
 #include <HardwareSerial.h>
 
 #include <string>
@@ -18,9 +19,18 @@ class Activity {
   explicit Activity(std::string name, GfxRenderer& renderer, MappedInputManager& mappedInput)
       : name(std::move(name)), renderer(renderer), mappedInput(mappedInput) {}
   virtual ~Activity() = default;
-  virtual void onEnter() { Serial.printf("[%lu] [ACT] Entering activity: %s\n", millis(), name.c_str()); }
+  virtual void onEnter() {
+    Serial.printf("[%lu] [ACT] Entering activity: %s\n", millis(), name.c_str());
+    // The activity name makes a natural crash-log checkpoint: it narrows a watchdog reset down
+    // to whatever the user was doing
+    CRASH_LOG.note(name.c_str());
+  }
   virtual void onExit() { Serial.printf("[%lu] [ACT] Exiting activity: %s\n", millis(), name.c_str()); }
   virtual void loop() {}
   virtual bool skipLoopDelay() { return false; }
   virtual bool preventAutoSleep() { return false; }
+  // Declare that the activity has nothing to do beyond waiting for input, so the main loop may
+  // light-sleep between polls. Light sleep halts every FreeRTOS task, so anything with an async
+  // render or background build in flight must keep returning false until it settles. Opt-in.
+  virtual bool isIdle() { return false; }
 };
@@ -1,13 +1,101 @@
 #include "ActivityWithSubactivity.h"
 
+#include <GfxRenderer.h>
+
+namespace {
+// Snapshot budget: list and menu screens RLE-compress way below this; a frame that does not
+// fit (dense cover art) is not worth holding in heap just to skip one re-render
+constexpr size_t SNAPSHOT_MAX_BYTES = 12 * 1024;
+}  // namespace
+
+void ActivityWithSubactivity::captureScreenSnapshot() {
+  dropScreenSnapshot();
+  const uint8_t* frameBuffer = renderer.getFrameBuffer();
+  if (!frameBuffer) {
+    return;
+  }
+  renderer.waitForDisplayFlush();
+  const size_t bufferSize = GfxRenderer::getBufferSize();
+
+  // First pass sizes the run-length encoding so the allocation is exact
+  size_t compressedSize = 0;
+  for (size_t i = 0; i < bufferSize;) {
+    size_t run = 1;
+    while (run < 255 && i + run < bufferSize && frameBuffer[i + run] == frameBuffer[i]) {
+      run++;
+    }
+    compressedSize += 2;
+    i += run;
+  }
+  if (compressedSize > SNAPSHOT_MAX_BYTES) {
+    Serial.printf("[%lu] [ACT] Screen too dense to snapshot (%zu bytes RLE), will re-render on pop\n", millis(),
+                  compressedSize);
+    return;
+  }
+
+  screenSnapshot = static_cast<uint8_t*>(malloc(compressedSize));
+  if (!screenSnapshot) {
+    Serial.printf("[%lu] [ACT] Failed to allocate %zu byte screen snapshot\n", millis(), compressedSize);
+    return;
+  }
+  size_t out = 0;
+  for (size_t i = 0; i < bufferSize;) {
+    size_t run = 1;
+    while (run < 255 && i + run < bufferSize && frameBuffer[i + run] == frameBuffer[i]) {
+      run++;
+    }
+    screenSnapshot[out++] = static_cast<uint8_t>(run);
+    screenSnapshot[out++] = frameBuffer[i];
+    i += run;
+  }
+  screenSnapshotSize = compressedSize;
+}
+
+bool ActivityWithSubactivity::restoreScreenSnapshot() {
+  if (!screenSnapshot) {
+    return false;
+  }
+  uint8_t* frameBuffer = renderer.getFrameBuffer();
+  if (!frameBuffer) {
+    dropScreenSnapshot();
+    return false;
+  }
+  renderer.waitForDisplayFlush();
+  const size_t bufferSize = GfxRenderer::getBufferSize();
+  size_t out = 0;
+  for (size_t i = 0; i + 1 < screenSnapshotSize && out < bufferSize; i += 2) {
+    size_t run = screenSnapshot[i];
+    if (run > bufferSize - out) {
+      run = bufferSize - out;
+    }
+    memset(frameBuffer + out, screenSnapshot[i + 1], run);
+    out += run;
+  }
+  dropScreenSnapshot();
+  renderer.markFullScreenDirty();
+  renderer.displayBuffer();
+  return true;
+}
+
+void ActivityWithSubactivity::dropScreenSnapshot() {
+  free(screenSnapshot);
+  screenSnapshot = nullptr;
+  screenSnapshotSize = 0;
+}
+
 void ActivityWithSubactivity::exitActivity() {
   if (subActivity) {
     subActivity->onExit();
     subActivity.reset();
+    // Blit the parent's screen back immediately; the parent's own re-render (if it schedules
+    // one) lands over this and usually gets elided by the frame shadow as unchanged
+    restoreScreenSnapshot();
   }
+  dropScreenSnapshot();
 }
 
 void ActivityWithSubactivity::enterNewActivity(Activity* activity) {
+  captureScreenSnapshot();
   subActivity.reset(activity);
   subActivity->onEnter();
 }
@@ -20,5 +108,10 @@ void ActivityWithSubactivity::loop() {
 
 void ActivityWithSubactivity::onExit() {
   Activity::onExit();
-  exitActivity();
+  // The parent is leaving too: tear the subactivity down without restoring its screen
+  if (subActivity) {
+    subActivity->onExit();
+    subActivity.reset();
+  }
+  dropScreenSnapshot();
 }
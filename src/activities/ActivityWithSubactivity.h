@@ -14,4 +14,16 @@ class ActivityWithSubactivity : public Activity {
       : Activity(std::move(name), renderer, mappedInput) {}
   void loop() override;
   void onExit() override;
+  bool isIdle() override { return subActivity && subActivity->isIdle(); }
+
+ private:
+  // Framebuffer snapshot captured when a subactivity is pushed: the parent's screen is
+  // run-length encoded into a small heap block and blitted back with a fast refresh on pop,
+  // so back-navigation shows instantly instead of waiting for the parent's full re-render.
+  // Dropped (never restored) when the parent itself exits or the screen compresses poorly.
+  uint8_t* screenSnapshot = nullptr;
+  size_t screenSnapshotSize = 0;
+  void captureScreenSnapshot();
+  bool restoreScreenSnapshot();
+  void dropScreenSnapshot();
 };
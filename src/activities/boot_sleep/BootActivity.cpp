@@ -2,12 +2,21 @@
 
 #include <GfxRenderer.h>
 
+#include "WakeSnapshot.h"
 #include "fontIds.h"
 #include "images/CrossLarge.h"
 
 void BootActivity::onEnter() {
   Activity::onEnter();
 
+  // Wake fast path: blit the pre-sleep snapshot instead of the boot screen, so the last screen
+  // is back on glass while the reader stack loads behind it
+  if (WakeSnapshot::restore(renderer)) {
+    renderer.markFullScreenDirty();
+    renderer.displayBuffer();
+    return;
+  }
+
   const auto pageWidth = renderer.getScreenWidth();
   const auto pageHeight = renderer.getScreenHeight();
 
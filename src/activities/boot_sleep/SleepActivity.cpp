@@ -3,17 +3,29 @@
 #include <Epub.h>
 #include <GfxRenderer.h>
 #include <SDCardManager.h>
+#include <Trace.h>
 #include <Txt.h>
 #include <Xtc.h>
 
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
+#include "PowerGovernor.h"
+#include "RecentBooksStore.h"
+#include "SleepFrameCache.h"
+#include "WakeSnapshot.h"
 #include "fontIds.h"
 #include "images/CrossLarge.h"
 #include "util/StringUtils.h"
 
 void SleepActivity::onEnter() {
   Activity::onEnter();
+  // Last chance to persist the trace ring; the SD card powers down with the rest of the board
+  TRACE_FLUSH_TO_SD();
+  // Same for any recent-books changes still pending their write-behind flush
+  RECENT_BOOKS.flushIfDirty();
+  // The framebuffer still holds the last screen the user saw; snapshot it before the popup and
+  // sleep screen replace it, so the next boot can blit it back immediately
+  WakeSnapshot::save(renderer);
   renderPopup("Entering Sleep...");
 
   if (SETTINGS.sleepScreen == CrossPointSettings::SLEEP_SCREEN_MODE::BLANK) {
@@ -87,7 +99,8 @@ void SleepActivity::renderCustomSleepScreen() const {
         randomFileIndex = random(numFiles);
       }
       APP_STATE.lastSleepImage = randomFileIndex;
-      APP_STATE.saveToFile();
+      // Picked up by the flush in enterDeepSleep() once the panel is done
+      APP_STATE.markDirty();
       const auto filename = "/sleep/" + files[randomFileIndex];
       FsFile file;
       if (SdMan.openFileForRead("SLP", filename, file)) {
@@ -136,7 +149,7 @@ void SleepActivity::renderDefaultSleepScreen() const {
   renderer.displayBuffer(HalDisplay::HALF_REFRESH);
 }
 
-void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
+bool SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
   int x, y;
   const auto pageWidth = renderer.getScreenWidth();
   const auto pageHeight = renderer.getScreenHeight();
@@ -192,21 +205,63 @@ void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
   renderer.displayBuffer(HalDisplay::HALF_REFRESH);
 
   if (hasGreyscale) {
-    bitmap.rewindToData();
-    renderer.clearScreen(0x00);
-    renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
-    renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
-    renderer.copyGrayscaleLsbBuffers();
-
-    bitmap.rewindToData();
-    renderer.clearScreen(0x00);
-    renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
-    renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
-    renderer.copyGrayscaleMsbBuffers();
-
-    renderer.displayGrayBuffer();
-    renderer.setRenderMode(GfxRenderer::BW);
+    if (renderer.beginGrayscalePass()) {
+      // One decode pass writes both gray planes
+      bitmap.rewindToData();
+      renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
+      renderer.flushGrayscalePass();
+    } else {
+      bitmap.rewindToData();
+      renderer.clearScreen(0x00);
+      renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
+      renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
+      renderer.copyGrayscaleLsbBuffers();
+
+      bitmap.rewindToData();
+      renderer.clearScreen(0x00);
+      renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
+      renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
+      renderer.copyGrayscaleMsbBuffers();
+
+      renderer.displayGrayBuffer();
+      renderer.setRenderMode(GfxRenderer::BW);
+    }
   }
+
+  return !hasGreyscale;
+}
+
+bool SleepActivity::renderStreamedCoverSleepScreen(const Epub& epub, const bool cropped) const {
+  // Stream the cover decode straight to the framebuffer while the BMP cache is written, so the
+  // first sleep after opening a book skips reading the freshly written file back off the SD card.
+  // The converter pre-scales to the display size, so rows land 1:1; in crop mode one dimension
+  // can overshoot the screen and drawPacked2BitRow clips it, which centers the crop.
+  int offsetX = 0, offsetY = 0;
+  const JpegToBmpConverter::RowSink sink = {
+      .onDimensions =
+          [&](const int width, const int height) {
+            offsetX = (renderer.getScreenWidth() - width) / 2;
+            offsetY = (renderer.getScreenHeight() - height) / 2;
+            Serial.printf("[%lu] [SLP] Streaming %dx%d cover to %d x %d\n", millis(), width, height, offsetX, offsetY);
+            renderer.clearScreen();
+          },
+      .onRow =
+          [&](const int y, const uint8_t* packedRow, const int widthPixels) {
+            renderer.drawPacked2BitRow(offsetX, offsetY + y, packedRow, widthPixels);
+          },
+  };
+
+  if (!epub.generateCoverBmp(cropped, &sink)) {
+    Serial.println("[SLP] Failed to generate cover bmp");
+    return false;
+  }
+
+  if (SETTINGS.sleepScreenCoverFilter == CrossPointSettings::SLEEP_SCREEN_COVER_FILTER::INVERTED_BLACK_AND_WHITE) {
+    renderer.invertScreen();
+  }
+
+  renderer.displayBuffer(HalDisplay::HALF_REFRESH);
+  return true;
 }
 
 void SleepActivity::renderCoverSleepScreen() const {
@@ -214,9 +269,24 @@ void SleepActivity::renderCoverSleepScreen() const {
     return renderDefaultSleepScreen();
   }
 
+  // Race to sleep: the JPEG decode behind a cache miss is CPU-bound, so finish it boosted
+  const PowerGovernor::Lease powerLease;
+
   std::string coverBmpPath;
   bool cropped = SETTINGS.sleepScreenCoverMode == CrossPointSettings::SLEEP_SCREEN_COVER_MODE::CROP;
 
+  // Key covers everything that shapes the composed frame; a hit makes entering sleep a single
+  // buffer push instead of a book load plus cover decode
+  const std::string frameKey = APP_STATE.openEpubPath + '\x1f' +
+                               std::to_string(static_cast<int>(SETTINGS.sleepScreenCoverMode)) + '\x1f' +
+                               std::to_string(static_cast<int>(SETTINGS.sleepScreenCoverFilter));
+  if (SleepFrameCache::restore(renderer, frameKey)) {
+    Serial.printf("[%lu] [SLP] Blitting cached sleep frame\n", millis());
+    renderer.markFullScreenDirty();
+    renderer.displayBuffer(HalDisplay::HALF_REFRESH);
+    return;
+  }
+
   // Check if the current book is XTC, TXT, or EPUB
   if (StringUtils::checkFileExtension(APP_STATE.openEpubPath, ".xtc") ||
       StringUtils::checkFileExtension(APP_STATE.openEpubPath, ".xtch")) {
@@ -255,6 +325,17 @@ void SleepActivity::renderCoverSleepScreen() const {
       return renderDefaultSleepScreen();
     }
 
+    // When the cover BMP cache is missing and the filter needs no grayscale passes, decode
+    // straight to the screen (the BMP is still written for subsequent sleeps)
+    if (SETTINGS.sleepScreenCoverFilter != CrossPointSettings::SLEEP_SCREEN_COVER_FILTER::NO_FILTER &&
+        !SdMan.exists(lastEpub.getCoverBmpPath(cropped).c_str())) {
+      if (renderStreamedCoverSleepScreen(lastEpub, cropped)) {
+        SleepFrameCache::save(renderer, frameKey);
+        return;
+      }
+      return renderDefaultSleepScreen();
+    }
+
     if (!lastEpub.generateCoverBmp(cropped)) {
       Serial.println("[SLP] Failed to generate cover bmp");
       return renderDefaultSleepScreen();
@@ -270,7 +351,11 @@ void SleepActivity::renderCoverSleepScreen() const {
     Bitmap bitmap(file);
     if (bitmap.parseHeaders() == BmpReaderError::Ok) {
       Serial.printf("[SLP] Rendering sleep cover: %s\n", coverBmpPath);
-      renderBitmapSleepScreen(bitmap);
+      if (renderBitmapSleepScreen(bitmap)) {
+        // Pure BW frame: reusable as-is next sleep. Grayscale results span two planes and are
+        // recomposed instead.
+        SleepFrameCache::save(renderer, frameKey);
+      }
       return;
     }
   }
@@ -2,6 +2,7 @@
 #include "../Activity.h"
 
 class Bitmap;
+class Epub;
 
 class SleepActivity final : public Activity {
  public:
@@ -14,6 +15,8 @@ class SleepActivity final : public Activity {
   void renderDefaultSleepScreen() const;
   void renderCustomSleepScreen() const;
   void renderCoverSleepScreen() const;
-  void renderBitmapSleepScreen(const Bitmap& bitmap) const;
+  bool renderStreamedCoverSleepScreen(const Epub& epub, bool cropped) const;
+  // Returns true when the composed frame is pure BW (safe to cache); grayscale passes are not
+  bool renderBitmapSleepScreen(const Bitmap& bitmap) const;
   void renderBlankSleepScreen() const;
 };
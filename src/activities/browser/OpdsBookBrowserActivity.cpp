@@ -1,23 +1,37 @@
 #include "OpdsBookBrowserActivity.h"
 
+#include <Bitmap.h>
 #include <Epub.h>
 #include <GfxRenderer.h>
 #include <HardwareSerial.h>
+#include <KOReaderCredentialStore.h>
+#include <KOReaderSyncQueue.h>
 #include <OpdsStream.h>
 #include <WiFi.h>
 
 #include "CrossPointSettings.h"
+#include "LibraryIndex.h"
 #include "MappedInputManager.h"
 #include "ScreenComponents.h"
 #include "activities/network/WifiSelectionActivity.h"
 #include "fontIds.h"
+#include "network/DownloadQueue.h"
 #include "network/HttpDownloader.h"
+#include "network/OpdsCoverCache.h"
+#include "network/OpdsFeedCache.h"
+#include "network/WifiFastConnect.h"
 #include "util/StringUtils.h"
 #include "util/UrlUtils.h"
 
 namespace {
 constexpr int PAGE_ITEMS = 23;
 constexpr int SKIP_PAGE_MS = 700;
+// Render the list as soon as this many entries have streamed in
+constexpr size_t FIRST_RENDER_ENTRIES = 10;
+// Covers only fetch once the selector has sat still this long, so scrolling stays snappy
+constexpr unsigned long COVER_FETCH_IDLE_MS = 600;
+// How long a failed cover fetch (offline, flaky server) pauses further attempts
+constexpr unsigned long COVER_FETCH_BACKOFF_MS = 30000;
 }  // namespace
 
 void OpdsBookBrowserActivity::taskTrampoline(void* param) {
@@ -34,6 +48,8 @@ void OpdsBookBrowserActivity::onEnter() {
   navigationHistory.clear();
   currentPath = "";  // Root path - user provides full URL in settings
   selectorIndex = 0;
+  syncFlushAttempted = false;
+  queueDrainAttempted = false;
   errorMessage.clear();
   statusMessage = "Checking WiFi...";
   updateRequired = true;
@@ -52,7 +68,19 @@ void OpdsBookBrowserActivity::onEnter() {
 void OpdsBookBrowserActivity::onExit() {
   ActivityWithSubactivity::onExit();
 
+  // The flush job needs the network; let it finish before WiFi goes down.
+  // The download drain aborts mid-transfer and keeps its partial file for next time.
+  TASK_QUEUE.cancelAndWait(prefetchJob);
+  prefetchJob = nullptr;
+  TASK_QUEUE.cancelAndWait(coverJob);
+  coverJob = nullptr;
+  TASK_QUEUE.cancelAndWait(bulkDownloadJob);
+  bulkDownloadJob = nullptr;
+  TASK_QUEUE.cancelAndWait(syncFlushJob);
+  syncFlushJob = nullptr;
+
   // Turn off WiFi when exiting
+  HttpDownloader::closeConnection();
   WiFi.mode(WIFI_OFF);
 
   xSemaphoreTake(renderingMutex, portMAX_DELAY);
@@ -118,6 +146,25 @@ void OpdsBookBrowserActivity::loop() {
 
   // Handle browsing state
   if (state == BrowserState::BROWSING) {
+    // WiFi is up anyway: push any queued KOReader progress in the background, once per visit
+    if (!syncFlushAttempted) {
+      syncFlushAttempted = true;
+      if (KOSYNC_QUEUE.hasPending() && KOREADER_STORE.hasCredentials()) {
+        syncFlushJob = TASK_QUEUE.enqueue("KOSyncFlush", [](const AsyncTaskQueue::Job&) { KOSYNC_QUEUE.flush(); });
+      }
+    }
+
+    // Likewise resume any downloads left over from an earlier session
+    if (!queueDrainAttempted) {
+      queueDrainAttempted = true;
+      if (DOWNLOAD_QUEUE.hasPending()) {
+        startQueueDrain();
+      }
+    }
+
+    // Pull in any missing visible cover thumbnails while the list is idle
+    startCoverFetch();
+
     const bool prevReleased = mappedInput.wasReleased(MappedInputManager::Button::Up) ||
                               mappedInput.wasReleased(MappedInputManager::Button::Left);
     const bool nextReleased = mappedInput.wasReleased(MappedInputManager::Button::Down) ||
@@ -126,9 +173,14 @@ void OpdsBookBrowserActivity::loop() {
 
     if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
       if (!entries.empty()) {
-        const auto& entry = entries[selectorIndex];
+        const OpdsEntryView entry = entries[selectorIndex];
         if (entry.type == OpdsEntryType::BOOK) {
-          downloadBook(entry);
+          if (skipPage) {
+            // Held Confirm: queue the book in the background and keep browsing
+            queueBookDownload(entry);
+          } else {
+            downloadBook(entry);
+          }
         } else {
           navigateToEntry(entry);
         }
@@ -141,6 +193,7 @@ void OpdsBookBrowserActivity::loop() {
       } else {
         selectorIndex = (selectorIndex + entries.size() - 1) % entries.size();
       }
+      lastNavInputAt = millis();
       updateRequired = true;
     } else if (nextReleased && !entries.empty()) {
       if (skipPage) {
@@ -148,6 +201,7 @@ void OpdsBookBrowserActivity::loop() {
       } else {
         selectorIndex = (selectorIndex + 1) % entries.size();
       }
+      lastNavInputAt = millis();
       updateRequired = true;
     }
   }
@@ -157,9 +211,15 @@ void OpdsBookBrowserActivity::displayTaskLoop() {
   while (true) {
     if (updateRequired) {
       updateRequired = false;
+      coverPatchPending = false;  // the full render paints every cached cover anyway
       xSemaphoreTake(renderingMutex, portMAX_DELAY);
       render();
       xSemaphoreGive(renderingMutex);
+    } else if (coverPatchPending) {
+      coverPatchPending = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      patchCoverRows();
+      xSemaphoreGive(renderingMutex);
     }
     vTaskDelay(10 / portTICK_PERIOD_MS);
   }
@@ -221,6 +281,14 @@ void OpdsBookBrowserActivity::render() const {
   const auto labels = mappedInput.mapLabels("« Back", confirmLabel, "", "");
   renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
 
+  // Background download queue status, tucked next to the title
+  const size_t queuedCount = DOWNLOAD_QUEUE.size();
+  if (queuedCount > 0) {
+    char queued[24];
+    snprintf(queued, sizeof(queued), "%u queued", static_cast<unsigned>(queuedCount));
+    renderer.drawText(UI_10_FONT_ID, pageWidth - renderer.getTextWidth(UI_10_FONT_ID, queued) - 10, 15, queued);
+  }
+
   if (entries.empty()) {
     renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, "No entries found");
     renderer.displayBuffer();
@@ -231,29 +299,116 @@ void OpdsBookBrowserActivity::render() const {
   renderer.fillRect(0, 60 + (selectorIndex % PAGE_ITEMS) * 30 - 2, pageWidth - 1, 30);
 
   for (size_t i = pageStartIndex; i < entries.size() && i < static_cast<size_t>(pageStartIndex + PAGE_ITEMS); i++) {
-    const auto& entry = entries[i];
+    const OpdsEntryView entry = entries[i];
 
     // Format display text with type indicator
     std::string displayText;
     if (entry.type == OpdsEntryType::NAVIGATION) {
-      displayText = "> " + entry.title;  // Folder/navigation indicator
+      displayText = "> ";  // Folder/navigation indicator
+      displayText += entry.title;
     } else {
       // Book: "Title - Author" or just "Title"
       displayText = entry.title;
-      if (!entry.author.empty()) {
-        displayText += " - " + entry.author;
+      if (entry.author[0] != '\0') {
+        displayText += " - ";
+        displayText += entry.author;
       }
     }
 
-    auto item = renderer.truncatedText(UI_10_FONT_ID, displayText.c_str(), renderer.getScreenWidth() - 40);
-    renderer.drawText(UI_10_FONT_ID, 20, 60 + (i % PAGE_ITEMS) * 30, item.c_str(),
-                      i != static_cast<size_t>(selectorIndex));
+    // Shape once; the run feeds both the truncation width check and the draw
+    const auto item = renderer.shapeTruncatedText(UI_10_FONT_ID, displayText.c_str(), renderer.getScreenWidth() - 40);
+    renderer.drawText(UI_10_FONT_ID, 20, 60 + (i % PAGE_ITEMS) * 30, item, i != static_cast<size_t>(selectorIndex));
+    // Mini-cover in the left margin, for books whose thumbnail the background job has cached
+    drawCoverThumb(entry, 60 + (i % PAGE_ITEMS) * 30);
   }
 
   renderer.displayBuffer();
 }
 
-void OpdsBookBrowserActivity::fetchFeed(const std::string& path) {
+// Draw the cached mini-cover for a book row into the left selector margin. Skips silently
+// when the entry has no thumbnail link, the fetch hasn't landed yet, or the cache file is a
+// failed-decode marker (zero bytes, so the header parse fails).
+void OpdsBookBrowserActivity::drawCoverThumb(const OpdsEntryView& entry, const int rowY) const {
+  if (entry.type != OpdsEntryType::BOOK || entry.thumbHref[0] == '\0') {
+    return;
+  }
+  const std::string url = UrlUtils::buildUrl(SETTINGS.opdsServerUrl, entry.thumbHref);
+  FsFile file;
+  if (!SdMan.openFileForRead("OPDS", OpdsCoverCache::bmpPath(url), file)) {
+    return;
+  }
+  Bitmap bitmap(file);
+  if (bitmap.parseHeaders() == BmpReaderError::Ok && bitmap.getWidth() > 0 && bitmap.getHeight() > 0) {
+    // Centre the (aspect-fit, so possibly narrower) thumb in the 20px margin and the 30px row
+    const int x = (20 - bitmap.getWidth()) / 2;
+    const int y = rowY - 2 + (30 - bitmap.getHeight()) / 2;
+    renderer.drawBitmap(bitmap, x, y, OpdsCoverCache::THUMB_WIDTH, OpdsCoverCache::THUMB_HEIGHT);
+  }
+  file.close();
+}
+
+// Windowed refresh when a fetched cover lands: paint it into the rows already on screen and
+// push just the changed region through the dirty-region planner - no full list re-flash
+void OpdsBookBrowserActivity::patchCoverRows() const {
+  if (state != BrowserState::BROWSING || entries.empty()) {
+    return;
+  }
+  const auto pageStartIndex = selectorIndex / PAGE_ITEMS * PAGE_ITEMS;
+  for (size_t i = pageStartIndex; i < entries.size() && i < static_cast<size_t>(pageStartIndex + PAGE_ITEMS); i++) {
+    drawCoverThumb(entries[i], 60 + (i % PAGE_ITEMS) * 30);
+  }
+  renderer.displayDirty();
+}
+
+// Kick off at most one cover fetch, and only while the list sits still: scrolling defers the
+// scan by the idle window, a failed fetch backs off, and navigation cancels the job outright
+// in fetchFeed(). The worker runs below the display task, so browsing never waits on it.
+void OpdsBookBrowserActivity::startCoverFetch() {
+  if (coverJob && !coverJob->isFinished()) {
+    return;
+  }
+  const unsigned long now = millis();
+  if (now - lastNavInputAt < COVER_FETCH_IDLE_MS || now < coverBackoffUntil) {
+    return;
+  }
+  const int pageStartIndex = selectorIndex / PAGE_ITEMS * PAGE_ITEMS;
+  if (pageStartIndex == coverScanCleanWindow) {
+    return;  // every visible cover is already cached (or marked undecodable)
+  }
+  std::string url;
+  for (size_t i = pageStartIndex; i < entries.size() && i < static_cast<size_t>(pageStartIndex + PAGE_ITEMS); i++) {
+    const OpdsEntryView entry = entries[i];
+    if (entry.type != OpdsEntryType::BOOK || entry.thumbHref[0] == '\0') {
+      continue;
+    }
+    std::string coverUrl = UrlUtils::buildUrl(SETTINGS.opdsServerUrl, entry.thumbHref);
+    if (!OpdsCoverCache::exists(coverUrl)) {
+      url = std::move(coverUrl);
+      break;
+    }
+  }
+  if (url.empty()) {
+    coverScanCleanWindow = pageStartIndex;
+    return;
+  }
+  coverJob = TASK_QUEUE.enqueue(
+      "OpdsCoverFetch",
+      [this, url](const AsyncTaskQueue::Job& job) {
+        if (job.isCancelled()) {
+          return;
+        }
+        if (OpdsCoverCache::fetchAndConvert(url)) {
+          coverPatchPending = true;
+        } else if (!OpdsCoverCache::exists(url)) {
+          // No marker left behind means the download itself failed; hold off so an offline
+          // session doesn't retry the same cover every loop pass
+          coverBackoffUntil = millis() + COVER_FETCH_BACKOFF_MS;
+        }
+      },
+      AsyncTaskQueue::Priority::LOW);
+}
+
+void OpdsBookBrowserActivity::fetchFeed(const std::string& path, bool preferCached) {
   const char* serverUrl = SETTINGS.opdsServerUrl;
   if (strlen(serverUrl) == 0) {
     state = BrowserState::ERROR;
@@ -265,11 +420,66 @@ void OpdsBookBrowserActivity::fetchFeed(const std::string& path) {
   std::string url = UrlUtils::buildUrl(serverUrl, path);
   Serial.printf("[%lu] [OPDS] Fetching: %s\n", millis(), url.c_str());
 
+  // HttpDownloader's pooled connection is single-user; let any prefetch finish
+  // first. A page the prefetcher already landed is served straight from cache.
+  TASK_QUEUE.cancelAndWait(prefetchJob);
+  prefetchJob = nullptr;
+  // Covers belong to the page being left; the new page schedules its own
+  TASK_QUEUE.cancelAndWait(coverJob);
+  coverJob = nullptr;
+  coverPatchPending = false;
+  coverScanCleanWindow = -1;
+  if (!preferCached && path == prefetchedPath) {
+    preferCached = true;
+  }
+  prefetchedPath.clear();
+
+  // A cached copy lets back-navigation skip the network entirely, and gives
+  // fresh visits the validators for a conditional GET instead of a full fetch
+  OpdsFeedArena cachedEntries;
+  std::string etag;
+  std::string lastModified;
+  std::string cachedNextHref;
+  const bool haveCache = OpdsFeedCache::load(url, cachedEntries, etag, lastModified, cachedNextHref);
+
+  if (preferCached && haveCache) {
+    Serial.printf("[%lu] [OPDS] Using cached feed (%d entries)\n", millis(), cachedEntries.size());
+    showEntries(std::move(cachedEntries));
+    nextPagePath = cachedNextHref;
+    appendNextPageEntry();
+    startNextPagePrefetch();
+    return;
+  }
+
   OpdsParser parser;
 
+  // Emit entries as they parse so the first screenful renders while the rest
+  // of the feed is still streaming in. The display task iterates `entries`
+  // under the rendering mutex, so pushes are locked too.
+  parser.setEntryCallback([this](const OpdsEntry& entry) {
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    entries.add(entry);
+    const size_t count = entries.size();
+    xSemaphoreGive(renderingMutex);
+
+    if (count == FIRST_RENDER_ENTRIES) {
+      state = BrowserState::BROWSING;
+      updateRequired = true;
+    }
+  });
+
+  bool notModified = false;
   {
     OpdsParserStream stream{parser};
-    if (!HttpDownloader::fetchUrl(url, stream)) {
+    if (!HttpDownloader::fetchUrl(url, stream, etag, lastModified, notModified)) {
+      if (haveCache) {
+        // Offline or flaky server - the stale copy beats an error screen
+        Serial.printf("[%lu] [OPDS] Fetch failed, falling back to cached feed\n", millis());
+        showEntries(std::move(cachedEntries));
+        nextPagePath = cachedNextHref;
+        appendNextPageEntry();
+        return;
+      }
       state = BrowserState::ERROR;
       errorMessage = "Failed to fetch feed";
       updateRequired = true;
@@ -277,6 +487,15 @@ void OpdsBookBrowserActivity::fetchFeed(const std::string& path) {
     }
   }
 
+  if (notModified) {
+    Serial.printf("[%lu] [OPDS] Feed unchanged (304), replaying %d cached entries\n", millis(), cachedEntries.size());
+    showEntries(std::move(cachedEntries));
+    nextPagePath = cachedNextHref;
+    appendNextPageEntry();
+    startNextPagePrefetch();
+    return;
+  }
+
   if (!parser) {
     state = BrowserState::ERROR;
     errorMessage = "Failed to parse feed";
@@ -284,7 +503,6 @@ void OpdsBookBrowserActivity::fetchFeed(const std::string& path) {
     return;
   }
 
-  entries = std::move(parser).getEntries();
   Serial.printf("[%lu] [OPDS] Found %d entries\n", millis(), entries.size());
   selectorIndex = 0;
 
@@ -295,12 +513,97 @@ void OpdsBookBrowserActivity::fetchFeed(const std::string& path) {
     return;
   }
 
+  // Persist the parsed page so the next visit is a conditional GET at most
+  nextPagePath = parser.getNextLink();
+  OpdsFeedCache::save(url, entries, etag, lastModified, nextPagePath);
+  appendNextPageEntry();
+
+  // Re-render with the final entry count (also covers feeds shorter than the
+  // early-render threshold)
   state = BrowserState::BROWSING;
   updateRequired = true;
+
+  // Pull the following page into the cache while the user reads this one
+  startNextPagePrefetch();
 }
 
-void OpdsBookBrowserActivity::navigateToEntry(const OpdsEntry& entry) {
-  // Push current path to history before navigating
+// Paginated feeds get a selectable trailing entry leading to the next page; the synthetic
+// entry is display-only (appended after the cache save, so cached pages stay pure)
+void OpdsBookBrowserActivity::appendNextPageEntry() {
+  if (nextPagePath.empty()) {
+    return;
+  }
+  static constexpr char NEXT_TITLE[] = "Next page";
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  entries.add(OpdsEntryType::NAVIGATION, NEXT_TITLE, sizeof(NEXT_TITLE) - 1, nullptr, 0,
+              nextPagePath.c_str(), static_cast<uint32_t>(nextPagePath.size()), nullptr, 0);
+  xSemaphoreGive(renderingMutex);
+}
+
+void OpdsBookBrowserActivity::startNextPagePrefetch() {
+  if (nextPagePath.empty() || nextPagePath == prefetchedPath) {
+    return;
+  }
+  if (prefetchJob && !prefetchJob->isFinished()) {
+    return;
+  }
+  const std::string path = nextPagePath;
+  prefetchJob = TASK_QUEUE.enqueue(
+      "OpdsPrefetch",
+      [this, path](const AsyncTaskQueue::Job& job) {
+        const std::string url = UrlUtils::buildUrl(SETTINGS.opdsServerUrl, path);
+        OpdsFeedArena cached;
+        std::string etag;
+        std::string lastModified;
+        std::string nextHref;
+        if (OpdsFeedCache::load(url, cached, etag, lastModified, nextHref)) {
+          prefetchedPath = path;
+          return;
+        }
+        if (job.isCancelled()) {
+          return;
+        }
+        Serial.printf("[%lu] [OPDS] Prefetching next page: %s\n", millis(), url.c_str());
+        // Stream straight into a local arena rather than the parser's own
+        // entry vector; the whole page is freed in one go when the job ends
+        OpdsFeedArena pageEntries;
+        OpdsParser parser;
+        parser.setEntryCallback([&pageEntries](const OpdsEntry& entry) { pageEntries.add(entry); });
+        bool notModified = false;
+        {
+          OpdsParserStream stream{parser};
+          if (!HttpDownloader::fetchUrl(url, stream, etag, lastModified, notModified)) {
+            return;
+          }
+        }
+        if (!parser || pageEntries.empty()) {
+          return;
+        }
+        OpdsFeedCache::save(url, pageEntries, etag, lastModified, parser.getNextLink());
+        prefetchedPath = path;
+        Serial.printf("[%lu] [OPDS] Next page cached (%d entries)\n", millis(), pageEntries.size());
+      },
+      AsyncTaskQueue::Priority::LOW);
+}
+
+void OpdsBookBrowserActivity::showEntries(OpdsFeedArena&& newEntries) {
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  entries = std::move(newEntries);
+  xSemaphoreGive(renderingMutex);
+  selectorIndex = 0;
+
+  if (entries.empty()) {
+    state = BrowserState::ERROR;
+    errorMessage = "No entries found";
+  } else {
+    state = BrowserState::BROWSING;
+  }
+  updateRequired = true;
+}
+
+void OpdsBookBrowserActivity::navigateToEntry(const OpdsEntryView& entry) {
+  // Push current path to history before navigating. The view borrows from the
+  // arena, so copy href out before the clear below frees the pool.
   navigationHistory.push_back(currentPath);
   currentPath = entry.href;
 
@@ -328,11 +631,16 @@ void OpdsBookBrowserActivity::navigateBack() {
     selectorIndex = 0;
     updateRequired = true;
 
-    fetchFeed(currentPath);
+    // We just came from this page; the cached copy makes going back instant
+    fetchFeed(currentPath, true);
   }
 }
 
-void OpdsBookBrowserActivity::downloadBook(const OpdsEntry& book) {
+void OpdsBookBrowserActivity::downloadBook(const OpdsEntryView& book) {
+  // The cover job shares the pooled HTTP connection; get it out of the way first
+  TASK_QUEUE.cancelAndWait(coverJob);
+  coverJob = nullptr;
+
   state = BrowserState::DOWNLOADING;
   statusMessage = book.title;
   downloadProgress = 0;
@@ -344,8 +652,9 @@ void OpdsBookBrowserActivity::downloadBook(const OpdsEntry& book) {
 
   // Create sanitized filename: "Title - Author.epub" or just "Title.epub" if no author
   std::string baseName = book.title;
-  if (!book.author.empty()) {
-    baseName += " - " + book.author;
+  if (book.author[0] != '\0') {
+    baseName += " - ";
+    baseName += book.author;
   }
   std::string filename = "/" + StringUtils::sanitizeFilename(baseName) + ".epub";
 
@@ -366,6 +675,9 @@ void OpdsBookBrowserActivity::downloadBook(const OpdsEntry& book) {
     epub.clearCache();
     Serial.printf("[%lu] [OPDS] Cleared cache for: %s\n", millis(), filename.c_str());
 
+    // Keep the library listing current without a directory rescan
+    LIBRARY_INDEX.addEntry(filename);
+
     state = BrowserState::BROWSING;
     updateRequired = true;
   } else {
@@ -375,6 +687,32 @@ void OpdsBookBrowserActivity::downloadBook(const OpdsEntry& book) {
   }
 }
 
+void OpdsBookBrowserActivity::queueBookDownload(const OpdsEntryView& book) {
+  // Same URL and filename scheme as the foreground path
+  std::string downloadUrl = UrlUtils::buildUrl(SETTINGS.opdsServerUrl, book.href);
+
+  std::string baseName = book.title;
+  if (book.author[0] != '\0') {
+    baseName += " - ";
+    baseName += book.author;
+  }
+  std::string filename = "/" + StringUtils::sanitizeFilename(baseName) + ".epub";
+
+  DOWNLOAD_QUEUE.enqueue(downloadUrl, filename, book.title);
+  startQueueDrain();
+  updateRequired = true;  // Refresh the queue count next to the title
+}
+
+void OpdsBookBrowserActivity::startQueueDrain() {
+  if (bulkDownloadJob && !bulkDownloadJob->isFinished()) {
+    return;  // A drain is already working through the queue
+  }
+  bulkDownloadJob = TASK_QUEUE.enqueue("OpdsBulkDownload", [this](const AsyncTaskQueue::Job& job) {
+    DOWNLOAD_QUEUE.drain([&job] { return job.isCancelled(); }, [this] { updateRequired = true; });
+    updateRequired = true;
+  });
+}
+
 void OpdsBookBrowserActivity::checkAndConnectWifi() {
   // Already connected? Verify connection is valid by checking IP
   if (WiFi.status() == WL_CONNECTED && WiFi.localIP() != IPAddress(0, 0, 0, 0)) {
@@ -385,7 +723,41 @@ void OpdsBookBrowserActivity::checkAndConnectWifi() {
     return;
   }
 
-  // Not connected - launch WiFi selection screen directly
+  // Not connected - try a targeted reconnect to the last AP before scanning.
+  // SD card read needs the lock as we use SPI for both.
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  const bool fastConnectStarted = WifiFastConnect::begin();
+  xSemaphoreGive(renderingMutex);
+  if (fastConnectStarted) {
+    statusMessage = "Connecting to WiFi...";
+    updateRequired = true;
+
+    const unsigned long start = millis();
+    while (millis() - start < WifiFastConnect::TIMEOUT_MS) {
+      const wl_status_t status = WiFi.status();
+      if (status == WL_CONNECTED) {
+        Serial.printf("[%lu] [OPDS] Fast reconnect succeeded in %lums\n", millis(), millis() - start);
+        xSemaphoreTake(renderingMutex, portMAX_DELAY);
+        WifiFastConnect::noteConnected();
+        xSemaphoreGive(renderingMutex);
+        state = BrowserState::LOADING;
+        statusMessage = "Loading...";
+        updateRequired = true;
+        fetchFeed(currentPath);
+        return;
+      }
+      if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL) {
+        break;
+      }
+      delay(100);
+    }
+
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    WifiFastConnect::noteFailed();
+    xSemaphoreGive(renderingMutex);
+  }
+
+  // Launch WiFi selection screen
   launchWifiSelection();
 }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include <OpdsFeedArena.h>
 #include <OpdsParser.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
@@ -9,6 +10,7 @@
 #include <vector>
 
 #include "../ActivityWithSubactivity.h"
+#include "AsyncTaskQueue.h"
 
 /**
  * Activity for browsing and downloading books from an OPDS server.
@@ -40,7 +42,9 @@ class OpdsBookBrowserActivity final : public ActivityWithSubactivity {
   bool updateRequired = false;
 
   BrowserState state = BrowserState::LOADING;
-  std::vector<OpdsEntry> entries;
+  // Entry PODs over one string pool; the whole feed is released wholesale on
+  // navigation, so the heap profile stays flat however big the catalog is
+  OpdsFeedArena entries;
   std::vector<std::string> navigationHistory;  // Stack of previous feed paths for back navigation
   std::string currentPath;                     // Current feed path being displayed
   int selectorIndex = 0;
@@ -48,6 +52,24 @@ class OpdsBookBrowserActivity final : public ActivityWithSubactivity {
   std::string statusMessage;
   size_t downloadProgress = 0;
   size_t downloadTotal = 0;
+  // Opportunistic KOReader sync flush: WiFi is up anyway, so push queued progress once per visit
+  bool syncFlushAttempted = false;
+  AsyncTaskQueue::JobHandle syncFlushJob = nullptr;
+  // Background drain of the persistent download queue (long-press Confirm queues books)
+  bool queueDrainAttempted = false;
+  AsyncTaskQueue::JobHandle bulkDownloadJob = nullptr;
+  // Next-page prefetch: the feed's rel="next" page is pulled into the feed cache while the
+  // user reads the current list, so paging forward costs no round trip
+  AsyncTaskQueue::JobHandle prefetchJob = nullptr;
+  std::string nextPagePath;    // rel="next" of the page on screen (empty on the last page)
+  std::string prefetchedPath;  // page the prefetch job has landed in the cache
+  // Lazy cover thumbnails: a LOW-priority job fetches one missing visible cover at a time,
+  // deferred while the user is scrolling and cancelled outright on navigation
+  AsyncTaskQueue::JobHandle coverJob = nullptr;
+  volatile bool coverPatchPending = false;       // a new cover landed; patch the visible rows
+  volatile unsigned long coverBackoffUntil = 0;  // a failed fetch holds off retries for a while
+  unsigned long lastNavInputAt = 0;              // last scroll press, for the idle gate
+  int coverScanCleanWindow = -1;                 // page window whose covers are all cached already
 
   const std::function<void()> onGoHome;
 
@@ -58,8 +80,16 @@ class OpdsBookBrowserActivity final : public ActivityWithSubactivity {
   void checkAndConnectWifi();
   void launchWifiSelection();
   void onWifiSelectionComplete(bool connected);
-  void fetchFeed(const std::string& path);
-  void navigateToEntry(const OpdsEntry& entry);
+  void fetchFeed(const std::string& path, bool preferCached = false);
+  void appendNextPageEntry();
+  void startNextPagePrefetch();
+  void showEntries(OpdsFeedArena&& newEntries);
+  void navigateToEntry(const OpdsEntryView& entry);
   void navigateBack();
-  void downloadBook(const OpdsEntry& book);
+  void downloadBook(const OpdsEntryView& book);
+  void queueBookDownload(const OpdsEntryView& book);
+  void startQueueDrain();
+  void startCoverFetch();
+  void patchCoverRows() const;
+  void drawCoverThumb(const OpdsEntryView& entry, int rowY) const;
 };
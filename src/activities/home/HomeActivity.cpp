@@ -12,11 +12,19 @@
 #include "Battery.h"
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
+#include "HomeFrameCache.h"
+#include "LibraryIndex.h"
 #include "MappedInputManager.h"
+#include "RecentBooksStore.h"
 #include "ScreenComponents.h"
+#include "SdIoScheduler.h"
 #include "fontIds.h"
 #include "util/StringUtils.h"
 
+namespace {
+constexpr unsigned long thumbPregenIdleMs = 2000;
+}  // namespace
+
 void HomeActivity::taskTrampoline(void* param) {
   auto* self = static_cast<HomeActivity*>(param);
   self->displayTaskLoop();
@@ -48,8 +56,16 @@ void HomeActivity::onEnter() {
       lastBookTitle = lastBookTitle.substr(lastSlash + 1);
     }
 
-    // If epub, try to load the metadata for title/author and cover
-    if (StringUtils::checkFileExtension(lastBookTitle, ".epub")) {
+    // Fast path: the recent-books record already carries title/author/thumb, so the card
+    // renders without instantiating an Epub/Xtc (which would load the metadata cache per book)
+    const RecentBook* recent = RECENT_BOOKS.findBook(APP_STATE.openEpubPath);
+    if (recent && !recent->title.empty() && !recent->thumbBmpPath.empty() &&
+        SdMan.exists(recent->thumbBmpPath.c_str())) {
+      lastBookTitle = recent->title;
+      lastBookAuthor = recent->author;
+      coverBmpPath = recent->thumbBmpPath;
+      hasCoverImage = true;
+    } else if (StringUtils::checkFileExtension(lastBookTitle, ".epub")) {
       Epub epub(APP_STATE.openEpubPath, "/.crosspoint");
       epub.load(false);
       if (!epub.getTitle().empty()) {
@@ -87,6 +103,11 @@ void HomeActivity::onEnter() {
         lastBookTitle.resize(lastBookTitle.length() - 4);
       }
     }
+
+    // Backfill the record so the next home entry takes the fast path
+    if (hasCoverImage) {
+      RECENT_BOOKS.updateThumb(APP_STATE.openEpubPath, coverBmpPath);
+    }
   }
 
   selectorIndex = 0;
@@ -100,12 +121,24 @@ void HomeActivity::onEnter() {
               1,                  // Priority
               &displayTaskHandle  // Task handle
   );
+
+  // Low-priority job that generates missing thumbnails while the user sits on the home screen
+  thumbPregenJob = TASK_QUEUE.enqueue(
+      "ThumbPregen", [this](const AsyncTaskQueue::Job& job) { runThumbPregen(job); }, AsyncTaskQueue::Priority::LOW);
 }
 
 void HomeActivity::onExit() {
   Activity::onExit();
 
-  // Wait until not rendering to delete task to avoid killing mid-instruction to EPD
+  // The pregen job captures `this`; let it wind down before teardown. Must happen before we
+  // hold the rendering mutex, which the job takes while working on a book.
+  TASK_QUEUE.cancelAndWait(thumbPregenJob);
+  thumbPregenJob = nullptr;
+
+  // Persist any recent-books changes accumulated while on the home screen
+  RECENT_BOOKS.flushIfDirty();
+
+  // Wait until not rendering to delete tasks to avoid killing mid-instruction to EPD
   xSemaphoreTake(renderingMutex, portMAX_DELAY);
   if (displayTaskHandle) {
     vTaskDelete(displayTaskHandle);
@@ -118,6 +151,75 @@ void HomeActivity::onExit() {
   freeCoverBuffer();
 }
 
+void HomeActivity::generateMissingThumb(const std::string& path) {
+  if (StringUtils::checkFileExtension(path, ".epub")) {
+    Epub epub(path, "/.crosspoint");
+    if (SdMan.exists(epub.getThumbBmpPath().c_str())) {
+      return;
+    }
+    Serial.printf("[%lu] [HOME] Pre-generating thumbnail for %s\n", millis(), path.c_str());
+    if (epub.load()) {
+      epub.generateThumbBmp();
+    }
+  } else if (StringUtils::checkFileExtension(path, ".xtch") || StringUtils::checkFileExtension(path, ".xtc")) {
+    Xtc xtc(path, "/.crosspoint");
+    if (SdMan.exists(xtc.getThumbBmpPath().c_str())) {
+      return;
+    }
+    Serial.printf("[%lu] [HOME] Pre-generating thumbnail for %s\n", millis(), path.c_str());
+    if (xtc.load()) {
+      xtc.generateThumbBmp();
+    }
+  }
+}
+
+void HomeActivity::runThumbPregen(const AsyncTaskQueue::Job& job) {
+  // Let the home screen settle first; wait in slices so cancellation isn't stuck behind it
+  const unsigned long idleStart = millis();
+  while (millis() - idleStart < thumbPregenIdleMs) {
+    if (job.isCancelled()) {
+      return;
+    }
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+  }
+
+  // Recently opened books first - those are the covers the Continue Reading card and the
+  // Recent tab actually show - then every book the library index already knows about
+  std::vector<std::string> paths;
+  for (const auto& book : RECENT_BOOKS.getBooks()) {
+    paths.emplace_back(book.path);
+  }
+  const std::string& indexedDir = LIBRARY_INDEX.getIndexedDir();
+  if (!indexedDir.empty()) {
+    std::vector<std::string> entries;
+    if (LIBRARY_INDEX.readEntries(0, LIBRARY_INDEX.getCount(), entries)) {
+      for (const auto& entry : entries) {
+        if (!entry.empty() && entry.back() != '/') {
+          paths.emplace_back(indexedDir == "/" ? "/" + entry : indexedDir + "/" + entry);
+        }
+      }
+    }
+  }
+
+  for (const auto& path : paths) {
+    if (job.isCancelled()) {
+      break;
+    }
+    // Serialize against the display task; each book holds the mutex only while it works
+    SD_SCHED.yieldToUi();
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    if (!job.isCancelled()) {
+      const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::BACKGROUND);
+      generateMissingThumb(path);
+    }
+    xSemaphoreGive(renderingMutex);
+    vTaskDelay(50 / portTICK_PERIOD_MS);
+  }
+
+  // One pass covers everything we know about; new books get picked up next time the home
+  // screen is entered
+}
+
 bool HomeActivity::storeCoverBuffer() {
   uint8_t* frameBuffer = renderer.getFrameBuffer();
   if (!frameBuffer) {
@@ -210,6 +312,7 @@ void HomeActivity::displayTaskLoop() {
 }
 
 void HomeActivity::render() {
+  const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::UI);
   // If we have a stored cover buffer, restore it instead of clearing
   const bool bufferRestored = coverBufferStored && restoreCoverBuffer();
   if (!bufferRestored) {
@@ -550,10 +653,17 @@ void HomeActivity::render() {
   const bool showBatteryPercentage =
       SETTINGS.hideBatteryPercentage != CrossPointSettings::HIDE_BATTERY_PERCENTAGE::HIDE_ALWAYS;
   // get percentage so we can align text properly
-  const uint16_t percentage = battery.readPercentage();
+  const uint16_t percentage = BATTERY.percentage();
   const auto percentageText = showBatteryPercentage ? std::to_string(percentage) + "%" : "";
   const auto batteryX = pageWidth - 25 - renderer.getTextWidth(SMALL_FONT_ID, percentageText.c_str());
   ScreenComponents::drawBattery(renderer, batteryX, 10, showBatteryPercentage);
 
   renderer.displayBuffer();
+
+  // Persist the composed frame once per entry so the next cold boot can blit it before this
+  // render re-runs. Only the initial selection state is worth keeping - that's what a fresh
+  // boot would compose.
+  if (!homeFrameSaved && selectorIndex == 0) {
+    homeFrameSaved = HomeFrameCache::save(renderer, HomeFrameCache::currentKey());
+  }
 }
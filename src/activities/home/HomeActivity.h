@@ -6,10 +6,12 @@
 #include <functional>
 
 #include "../Activity.h"
+#include "AsyncTaskQueue.h"
 
 class HomeActivity final : public Activity {
   TaskHandle_t displayTaskHandle = nullptr;
   SemaphoreHandle_t renderingMutex = nullptr;
+  AsyncTaskQueue::JobHandle thumbPregenJob;
   int selectorIndex = 0;
   bool updateRequired = false;
   bool hasContinueReading = false;
@@ -17,6 +19,7 @@ class HomeActivity final : public Activity {
   bool hasCoverImage = false;
   bool coverRendered = false;      // Track if cover has been rendered once
   bool coverBufferStored = false;  // Track if cover buffer is stored
+  bool homeFrameSaved = false;     // Composed frame persisted for the cold-boot blit this entry
   uint8_t* coverBuffer = nullptr;  // HomeActivity's own buffer for cover image
   std::string lastBookTitle;
   std::string lastBookAuthor;
@@ -29,6 +32,8 @@ class HomeActivity final : public Activity {
 
   static void taskTrampoline(void* param);
   [[noreturn]] void displayTaskLoop();
+  void runThumbPregen(const AsyncTaskQueue::Job& job);
+  void generateMissingThumb(const std::string& path);
   void render();
   int getMenuItemCount() const;
   bool storeCoverBuffer();    // Store frame buffer for cover image
@@ -49,4 +54,6 @@ class HomeActivity final : public Activity {
   void onEnter() override;
   void onExit() override;
   void loop() override;
+  // Thumb pre-generation runs on the shared task queue, which the main loop gates on separately
+  bool isIdle() override { return !updateRequired; }
 };
@@ -3,13 +3,13 @@
 #include <GfxRenderer.h>
 #include <SDCardManager.h>
 
-#include <algorithm>
-
+#include "LibraryIndex.h"
 #include "MappedInputManager.h"
 #include "RecentBooksStore.h"
 #include "ScreenComponents.h"
+#include "activities/util/KeyboardEntryActivity.h"
 #include "fontIds.h"
-#include "util/StringUtils.h"
+#include "network/DownloadQueue.h"
 
 namespace {
 // Layout constants
@@ -24,15 +24,8 @@ constexpr int RIGHT_MARGIN = 40;  // Extra space for scroll indicator
 constexpr int SKIP_PAGE_MS = 700;
 constexpr unsigned long GO_HOME_MS = 1000;
 
-void sortFileList(std::vector<std::string>& strs) {
-  std::sort(begin(strs), end(strs), [](const std::string& str1, const std::string& str2) {
-    if (str1.back() == '/' && str2.back() != '/') return true;
-    if (str1.back() != '/' && str2.back() == '/') return false;
-    return lexicographical_compare(
-        begin(str1), end(str1), begin(str2), end(str2),
-        [](const char& char1, const char& char2) { return tolower(char1) < tolower(char2); });
-  });
-}
+// Search hits kept in memory at once; the scan stops early past this
+constexpr size_t MAX_SEARCH_RESULTS = 200;
 }  // namespace
 
 int MyLibraryActivity::getPageItems() const {
@@ -50,7 +43,10 @@ int MyLibraryActivity::getCurrentItemCount() const {
   if (currentTab == Tab::Recent) {
     return static_cast<int>(recentBooks.size());
   }
-  return static_cast<int>(files.size());
+  if (searchActive) {
+    return static_cast<int>(searchResults.size());
+  }
+  return fileCount;
 }
 
 int MyLibraryActivity::getTotalPages() const {
@@ -80,45 +76,83 @@ void MyLibraryActivity::loadRecentBooks() {
 }
 
 void MyLibraryActivity::loadFiles() {
-  files.clear();
+  fileWindow.clear();
+  fileWindowStart = -1;
+  // Any open search was against the previous directory's index
+  searchActive = false;
+  searchResults.clear();
+  const int loadedCount = LIBRARY_INDEX.open(basepath);
+  fileCount = loadedCount < 0 ? 0 : loadedCount;
+}
+
+void MyLibraryActivity::launchSearchKeyboard() {
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  enterNewActivity(new KeyboardEntryActivity(
+      renderer, mappedInput, "Search library", searchQuery,
+      10,     // startY
+      64,     // maxLength
+      false,  // not password
+      [this](const std::string& entered) {
+        exitActivity();
+        searchQuery = entered;
+        // Run from loop() rather than inside the keyboard's callback stack
+        pendingSearch = true;
+      },
+      [this] {
+        exitActivity();
+        updateRequired = true;
+      }));
+  xSemaphoreGive(renderingMutex);
+}
 
-  auto root = SdMan.open(basepath.c_str());
-  if (!root || !root.isDirectory()) {
-    if (root) root.close();
+void MyLibraryActivity::runSearch() {
+  searchResults.clear();
+  if (searchQuery.empty()) {
+    clearSearch();
     return;
   }
+  LIBRARY_INDEX.search(searchQuery, MAX_SEARCH_RESULTS, searchResults);
+  Serial.printf("[%lu] [LIB] Search \"%s\": %d matches\n", millis(), searchQuery.c_str(),
+                static_cast<int>(searchResults.size()));
+  searchActive = true;
+  selectorIndex = 0;
+  updateRequired = true;
+}
 
-  root.rewindDirectory();
+void MyLibraryActivity::clearSearch() {
+  // The query is kept so the next keyboard launch starts from it
+  searchActive = false;
+  searchResults.clear();
+  selectorIndex = 0;
+  updateRequired = true;
+}
 
-  char name[500];
-  for (auto file = root.openNextFile(); file; file = root.openNextFile()) {
-    file.getName(name, sizeof(name));
-    if (name[0] == '.' || strcmp(name, "System Volume Information") == 0) {
-      file.close();
-      continue;
-    }
+size_t MyLibraryActivity::findEntry(const std::string& name) const {
+  const int index = LIBRARY_INDEX.indexOf(name);
+  return index < 0 ? 0 : static_cast<size_t>(index);
+}
 
-    if (file.isDirectory()) {
-      files.emplace_back(std::string(name) + "/");
-    } else {
-      auto filename = std::string(name);
-      if (StringUtils::checkFileExtension(filename, ".epub") || StringUtils::checkFileExtension(filename, ".xtch") ||
-          StringUtils::checkFileExtension(filename, ".xtc") || StringUtils::checkFileExtension(filename, ".txt") ||
-          StringUtils::checkFileExtension(filename, ".md")) {
-        files.emplace_back(filename);
-      }
-    }
-    file.close();
+// Make sure the in-memory window holds the page of entries starting at pageStartIndex
+void MyLibraryActivity::ensureFileWindow(const int pageStartIndex) const {
+  if (fileWindowStart == pageStartIndex) {
+    return;
+  }
+  fileWindow.clear();
+  if (LIBRARY_INDEX.readEntries(pageStartIndex, getPageItems(), fileWindow)) {
+    fileWindowStart = pageStartIndex;
+  } else {
+    fileWindowStart = -1;
   }
-  root.close();
-  sortFileList(files);
 }
 
-size_t MyLibraryActivity::findEntry(const std::string& name) const {
-  for (size_t i = 0; i < files.size(); i++) {
-    if (files[i] == name) return i;
+std::string MyLibraryActivity::selectedFileEntry() const {
+  const int pageItems = getPageItems();
+  ensureFileWindow(selectorIndex / pageItems * pageItems);
+  const int offset = selectorIndex - fileWindowStart;
+  if (fileWindowStart < 0 || offset < 0 || offset >= static_cast<int>(fileWindow.size())) {
+    return "";
   }
-  return 0;
+  return fileWindow[offset];
 }
 
 void MyLibraryActivity::taskTrampoline(void* param) {
@@ -127,7 +161,7 @@ void MyLibraryActivity::taskTrampoline(void* param) {
 }
 
 void MyLibraryActivity::onEnter() {
-  Activity::onEnter();
+  ActivityWithSubactivity::onEnter();
 
   renderingMutex = xSemaphoreCreateMutex();
 
@@ -147,7 +181,7 @@ void MyLibraryActivity::onEnter() {
 }
 
 void MyLibraryActivity::onExit() {
-  Activity::onExit();
+  ActivityWithSubactivity::onExit();
 
   // Wait until not rendering to delete task to avoid killing mid-instruction to
   // EPD
@@ -159,10 +193,22 @@ void MyLibraryActivity::onExit() {
   vSemaphoreDelete(renderingMutex);
   renderingMutex = nullptr;
 
-  files.clear();
+  fileWindow.clear();
+  fileWindowStart = -1;
 }
 
 void MyLibraryActivity::loop() {
+  if (subActivity) {
+    subActivity->loop();
+    return;
+  }
+
+  if (pendingSearch) {
+    pendingSearch = false;
+    runSearch();
+    return;
+  }
+
   const int itemCount = getCurrentItemCount();
   const int pageItems = getPageItems();
 
@@ -185,25 +231,40 @@ void MyLibraryActivity::loop() {
 
   const bool skipPage = mappedInput.getHeldTime() > SKIP_PAGE_MS;
 
-  // Confirm button - open selected item
+  // Confirm button - open selected item; a long press in the Files tab opens search
   if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
+    if (currentTab == Tab::Files && skipPage) {
+      launchSearchKeyboard();
+      return;
+    }
+    if (currentTab == Tab::Files && searchActive) {
+      if (!searchResults.empty() && selectorIndex < static_cast<int>(searchResults.size())) {
+        std::string path = basepath;
+        if (path.back() != '/') path += "/";
+        onSelectBook(path + searchResults[selectorIndex].name, currentTab);
+      }
+      return;
+    }
     if (currentTab == Tab::Recent) {
       if (!recentBooks.empty() && selectorIndex < static_cast<int>(recentBooks.size())) {
         onSelectBook(recentBooks[selectorIndex].path, currentTab);
       }
     } else {
       // Files tab
-      if (!files.empty() && selectorIndex < static_cast<int>(files.size())) {
-        if (basepath.back() != '/') basepath += "/";
-        if (files[selectorIndex].back() == '/') {
-          // Enter directory
-          basepath += files[selectorIndex].substr(0, files[selectorIndex].length() - 1);
-          loadFiles();
-          selectorIndex = 0;
-          updateRequired = true;
-        } else {
-          // Open file
-          onSelectBook(basepath + files[selectorIndex], currentTab);
+      if (fileCount > 0 && selectorIndex < fileCount) {
+        const std::string entry = selectedFileEntry();
+        if (!entry.empty()) {
+          if (basepath.back() != '/') basepath += "/";
+          if (entry.back() == '/') {
+            // Enter directory
+            basepath += entry.substr(0, entry.length() - 1);
+            loadFiles();
+            selectorIndex = 0;
+            updateRequired = true;
+          } else {
+            // Open file
+            onSelectBook(basepath + entry, currentTab);
+          }
         }
       }
     }
@@ -213,7 +274,10 @@ void MyLibraryActivity::loop() {
   // Back button
   if (mappedInput.wasReleased(MappedInputManager::Button::Back)) {
     if (mappedInput.getHeldTime() < GO_HOME_MS) {
-      if (currentTab == Tab::Files && basepath != "/") {
+      if (currentTab == Tab::Files && searchActive) {
+        // Drop back to the plain directory listing
+        clearSearch();
+      } else if (currentTab == Tab::Files && basepath != "/") {
         // Go up one directory, remembering the directory we came from
         const std::string oldPath = basepath;
         basepath.replace(basepath.find_last_of('/'), std::string::npos, "");
@@ -255,17 +319,19 @@ void MyLibraryActivity::loop() {
   if (prevReleased && itemCount > 0) {
     if (skipPage) {
       selectorIndex = ((selectorIndex / pageItems - 1) * pageItems + itemCount) % itemCount;
+      updateRequired = true;
     } else {
       selectorIndex = (selectorIndex + itemCount - 1) % itemCount;
+      selectorOnlyUpdate = true;
     }
-    updateRequired = true;
   } else if (nextReleased && itemCount > 0) {
     if (skipPage) {
       selectorIndex = ((selectorIndex / pageItems + 1) * pageItems) % itemCount;
+      updateRequired = true;
     } else {
       selectorIndex = (selectorIndex + 1) % itemCount;
+      selectorOnlyUpdate = true;
     }
-    updateRequired = true;
   }
 }
 
@@ -273,9 +339,15 @@ void MyLibraryActivity::displayTaskLoop() {
   while (true) {
     if (updateRequired) {
       updateRequired = false;
+      selectorOnlyUpdate = false;
       xSemaphoreTake(renderingMutex, portMAX_DELAY);
       render();
       xSemaphoreGive(renderingMutex);
+    } else if (selectorOnlyUpdate) {
+      selectorOnlyUpdate = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      renderSelectorMove();
+      xSemaphoreGive(renderingMutex);
     }
     vTaskDelay(10 / portTICK_PERIOD_MS);
   }
@@ -288,6 +360,26 @@ void MyLibraryActivity::render() const {
   std::vector<TabInfo> tabs = {{"Recent", currentTab == Tab::Recent}, {"Files", currentTab == Tab::Files}};
   ScreenComponents::drawTabBar(renderer, TAB_BAR_Y, tabs);
 
+  // Active search query takes the top-right corner; otherwise show the download queue badge
+  if (searchActive && currentTab == Tab::Files) {
+    std::string label = "Search: " + searchQuery;
+    if (label.length() > 24) {
+      label.replace(21, label.length() - 21, "...");
+    }
+    renderer.drawText(UI_10_FONT_ID,
+                      renderer.getScreenWidth() - renderer.getTextWidth(UI_10_FONT_ID, label.c_str()) - 10, TAB_BAR_Y,
+                      label.c_str());
+  }
+
+  // Books still queued for download (picked up next time the OPDS browser runs)
+  const size_t queuedDownloads = DOWNLOAD_QUEUE.size();
+  if (queuedDownloads > 0 && !(searchActive && currentTab == Tab::Files)) {
+    char queued[32];
+    snprintf(queued, sizeof(queued), "%u queued", static_cast<unsigned>(queuedDownloads));
+    renderer.drawText(UI_10_FONT_ID, renderer.getScreenWidth() - renderer.getTextWidth(UI_10_FONT_ID, queued) - 10,
+                      TAB_BAR_Y, queued);
+  }
+
   // Draw content based on current tab
   if (currentTab == Tab::Recent) {
     renderRecentTab();
@@ -305,10 +397,42 @@ void MyLibraryActivity::render() const {
   renderer.drawSideButtonHints(UI_10_FONT_ID, ">", "<");
 
   // Draw bottom button hints
-  const auto labels = mappedInput.mapLabels("« Back", "Open", "<", ">");
+  const auto labels = searchActive && currentTab == Tab::Files ? mappedInput.mapLabels("« Clear", "Open", "<", ">")
+                                                               : mappedInput.mapLabels("« Back", "Open", "<", ">");
   renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
 
   renderer.displayBuffer();
+  lastRenderedSelectorIndex = selectorIndex;
+}
+
+// Selector moved within an already rendered page: repaint just the two affected rows and let
+// the refresh planner flush the small dirty bands instead of re-rendering the whole screen
+void MyLibraryActivity::renderSelectorMove() const {
+  const int pageItems = getPageItems();
+  // Fall back to a full render before the first paint or when the move crossed a page boundary
+  if (lastRenderedSelectorIndex < 0 || lastRenderedSelectorIndex == selectorIndex ||
+      lastRenderedSelectorIndex / pageItems != selectorIndex / pageItems) {
+    render();
+    return;
+  }
+
+  const auto pageWidth = renderer.getScreenWidth();
+  const int lineHeight = currentTab == Tab::Recent ? RECENTS_LINE_HEIGHT : LINE_HEIGHT;
+  const int rows[2] = {lastRenderedSelectorIndex, selectorIndex};
+  for (const int i : rows) {
+    const bool isSelected = i == selectorIndex;
+    const int y = CONTENT_START_Y + (i % pageItems) * lineHeight;
+    renderer.fillRect(0, y - 2, pageWidth - RIGHT_MARGIN, lineHeight, isSelected);
+    if (currentTab == Tab::Recent) {
+      drawRecentRow(i, y, isSelected);
+    } else if (searchActive) {
+      drawSearchRow(i, y, isSelected);
+    } else {
+      drawFileRow(i, y, isSelected);
+    }
+  }
+  lastRenderedSelectorIndex = selectorIndex;
+  renderer.displayDirty();
 }
 
 void MyLibraryActivity::renderRecentTab() const {
@@ -329,39 +453,55 @@ void MyLibraryActivity::renderRecentTab() const {
 
   // Draw items
   for (int i = pageStartIndex; i < bookCount && i < pageStartIndex + pageItems; i++) {
-    const auto& book = recentBooks[i];
-    const int y = CONTENT_START_Y + (i % pageItems) * RECENTS_LINE_HEIGHT;
-
-    // Line 1: Title
-    std::string title = book.title;
-    if (title.empty()) {
-      // Fallback for older entries or files without metadata
-      title = book.path;
-      const size_t lastSlash = title.find_last_of('/');
-      if (lastSlash != std::string::npos) {
-        title = title.substr(lastSlash + 1);
-      }
-      const size_t dot = title.find_last_of('.');
-      if (dot != std::string::npos) {
-        title.resize(dot);
-      }
+    drawRecentRow(i, CONTENT_START_Y + (i % pageItems) * RECENTS_LINE_HEIGHT, i == selectorIndex);
+  }
+}
+
+void MyLibraryActivity::drawRecentRow(const int i, const int y, const bool isSelected) const {
+  const auto pageWidth = renderer.getScreenWidth();
+  const auto& book = recentBooks[i];
+
+  // Line 1: Title
+  std::string title = book.title;
+  if (title.empty()) {
+    // Fallback for older entries or files without metadata
+    title = book.path;
+    const size_t lastSlash = title.find_last_of('/');
+    if (lastSlash != std::string::npos) {
+      title = title.substr(lastSlash + 1);
     }
-    auto truncatedTitle = renderer.truncatedText(UI_12_FONT_ID, title.c_str(), pageWidth - LEFT_MARGIN - RIGHT_MARGIN);
-    renderer.drawText(UI_12_FONT_ID, LEFT_MARGIN, y + 2, truncatedTitle.c_str(), i != selectorIndex);
-
-    // Line 2: Author
-    if (!book.author.empty()) {
-      auto truncatedAuthor =
-          renderer.truncatedText(UI_10_FONT_ID, book.author.c_str(), pageWidth - LEFT_MARGIN - RIGHT_MARGIN);
-      renderer.drawText(UI_10_FONT_ID, LEFT_MARGIN, y + 32, truncatedAuthor.c_str(), i != selectorIndex);
+    const size_t dot = title.find_last_of('.');
+    if (dot != std::string::npos) {
+      title.resize(dot);
     }
   }
+  // Shape once per row; the run feeds both the truncation width check and the draw
+  const auto titleRun = renderer.shapeTruncatedText(UI_12_FONT_ID, title.c_str(), pageWidth - LEFT_MARGIN - RIGHT_MARGIN);
+  renderer.drawText(UI_12_FONT_ID, LEFT_MARGIN, y + 2, titleRun, !isSelected);
+
+  // Line 2: Author, with the stored reading progress right-aligned
+  int authorMaxWidth = pageWidth - LEFT_MARGIN - RIGHT_MARGIN;
+  if (book.progressPercent > 0) {
+    char progressStr[8];
+    snprintf(progressStr, sizeof(progressStr), "%u%%", book.progressPercent);
+    const int progressWidth = renderer.getTextWidth(SMALL_FONT_ID, progressStr);
+    renderer.drawText(SMALL_FONT_ID, pageWidth - RIGHT_MARGIN - progressWidth, y + 32, progressStr, !isSelected);
+    authorMaxWidth -= progressWidth + 10;
+  }
+  if (!book.author.empty()) {
+    const auto authorRun = renderer.shapeTruncatedText(UI_10_FONT_ID, book.author.c_str(), authorMaxWidth);
+    renderer.drawText(UI_10_FONT_ID, LEFT_MARGIN, y + 32, authorRun, !isSelected);
+  }
 }
 
 void MyLibraryActivity::renderFilesTab() const {
   const auto pageWidth = renderer.getScreenWidth();
   const int pageItems = getPageItems();
-  const int fileCount = static_cast<int>(files.size());
+
+  if (searchActive) {
+    renderSearchResults();
+    return;
+  }
 
   if (fileCount == 0) {
     renderer.drawText(UI_10_FONT_ID, LEFT_MARGIN, CONTENT_START_Y, "No books found");
@@ -369,15 +509,63 @@ void MyLibraryActivity::renderFilesTab() const {
   }
 
   const auto pageStartIndex = selectorIndex / pageItems * pageItems;
+  ensureFileWindow(pageStartIndex);
 
   // Draw selection highlight
   renderer.fillRect(0, CONTENT_START_Y + (selectorIndex % pageItems) * LINE_HEIGHT - 2, pageWidth - RIGHT_MARGIN,
                     LINE_HEIGHT);
 
-  // Draw items
+  // Draw items (only the visible page is in memory)
   for (int i = pageStartIndex; i < fileCount && i < pageStartIndex + pageItems; i++) {
-    auto item = renderer.truncatedText(UI_10_FONT_ID, files[i].c_str(), pageWidth - LEFT_MARGIN - RIGHT_MARGIN);
-    renderer.drawText(UI_10_FONT_ID, LEFT_MARGIN, CONTENT_START_Y + (i % pageItems) * LINE_HEIGHT, item.c_str(),
-                      i != selectorIndex);
+    const int windowOffset = i - fileWindowStart;
+    if (fileWindowStart < 0 || windowOffset >= static_cast<int>(fileWindow.size())) {
+      break;
+    }
+    drawFileRow(i, CONTENT_START_Y + (i % pageItems) * LINE_HEIGHT, i == selectorIndex);
+  }
+}
+
+void MyLibraryActivity::drawFileRow(const int i, const int y, const bool isSelected) const {
+  const int windowOffset = i - fileWindowStart;
+  if (fileWindowStart < 0 || windowOffset < 0 || windowOffset >= static_cast<int>(fileWindow.size())) {
+    return;
+  }
+  const auto pageWidth = renderer.getScreenWidth();
+  const auto item = renderer.shapeTruncatedText(UI_10_FONT_ID, fileWindow[windowOffset].c_str(),
+                                                pageWidth - LEFT_MARGIN - RIGHT_MARGIN);
+  renderer.drawText(UI_10_FONT_ID, LEFT_MARGIN, y, item, !isSelected);
+}
+
+void MyLibraryActivity::renderSearchResults() const {
+  const auto pageWidth = renderer.getScreenWidth();
+  const int pageItems = getPageItems();
+  const int resultCount = static_cast<int>(searchResults.size());
+
+  if (resultCount == 0) {
+    const std::string msg = "No matches for \"" + searchQuery + "\"";
+    renderer.drawText(UI_10_FONT_ID, LEFT_MARGIN, CONTENT_START_Y, msg.c_str());
+    return;
+  }
+
+  const auto pageStartIndex = selectorIndex / pageItems * pageItems;
+
+  // Draw selection highlight
+  renderer.fillRect(0, CONTENT_START_Y + (selectorIndex % pageItems) * LINE_HEIGHT - 2, pageWidth - RIGHT_MARGIN,
+                    LINE_HEIGHT);
+
+  // Draw items: denormalized title/author when the index has them, filename otherwise
+  for (int i = pageStartIndex; i < resultCount && i < pageStartIndex + pageItems; i++) {
+    drawSearchRow(i, CONTENT_START_Y + (i % pageItems) * LINE_HEIGHT, i == selectorIndex);
+  }
+}
+
+void MyLibraryActivity::drawSearchRow(const int i, const int y, const bool isSelected) const {
+  const auto pageWidth = renderer.getScreenWidth();
+  const auto& result = searchResults[i];
+  std::string label = result.title.empty() ? result.name : result.title;
+  if (!result.author.empty()) {
+    label += " - " + result.author;
   }
+  const auto item = renderer.shapeTruncatedText(UI_10_FONT_ID, label.c_str(), pageWidth - LEFT_MARGIN - RIGHT_MARGIN);
+  renderer.drawText(UI_10_FONT_ID, LEFT_MARGIN, y, item, !isSelected);
 }
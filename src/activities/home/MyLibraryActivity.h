@@ -7,10 +7,11 @@
 #include <string>
 #include <vector>
 
-#include "../Activity.h"
+#include "../ActivityWithSubactivity.h"
+#include "LibraryIndex.h"
 #include "RecentBooksStore.h"
 
-class MyLibraryActivity final : public Activity {
+class MyLibraryActivity final : public ActivityWithSubactivity {
  public:
   enum class Tab { Recent, Files };
 
@@ -21,13 +22,29 @@ class MyLibraryActivity final : public Activity {
   Tab currentTab = Tab::Recent;
   int selectorIndex = 0;
   bool updateRequired = false;
+  // Selector moved within the rendered page: repaint just the two affected rows and flush
+  // them through the refresh planner instead of a full-screen refresh
+  bool selectorOnlyUpdate = false;
+  // Item the last paint left highlighted (-1 before the first full render)
+  mutable int lastRenderedSelectorIndex = -1;
 
   // Recent tab state
   std::vector<RecentBook> recentBooks;
 
-  // Files tab state (from FileSelectionActivity)
+  // Files tab state, backed by the persistent library index; only the entries for the
+  // currently visible page are held in memory (the render path refills the window)
   std::string basepath = "/";
-  std::vector<std::string> files;
+  int fileCount = 0;
+  mutable int fileWindowStart = -1;
+  mutable std::vector<std::string> fileWindow;
+
+  // Search state (Files tab): while active the list shows index search hits instead of the
+  // directory listing; Back clears it. The query is kept so re-opening the keyboard
+  // (long-press Confirm) edits the previous search instead of starting over.
+  bool searchActive = false;
+  bool pendingSearch = false;
+  std::string searchQuery;
+  std::vector<LibraryIndex::SearchResult> searchResults;
 
   // Callbacks
   const std::function<void()> onGoHome;
@@ -42,7 +59,12 @@ class MyLibraryActivity final : public Activity {
   // Data loading
   void loadRecentBooks();
   void loadFiles();
+  void launchSearchKeyboard();
+  void runSearch();
+  void clearSearch();
   size_t findEntry(const std::string& name) const;
+  void ensureFileWindow(int pageStartIndex) const;
+  std::string selectedFileEntry() const;
 
   // Rendering
   static void taskTrampoline(void* param);
@@ -50,13 +72,20 @@ class MyLibraryActivity final : public Activity {
   void render() const;
   void renderRecentTab() const;
   void renderFilesTab() const;
+  void renderSearchResults() const;
+  // Per-row draw helpers (text only, no selector band); shared by the full renders and the
+  // selector-only repaint
+  void drawRecentRow(int i, int y, bool isSelected) const;
+  void drawFileRow(int i, int y, bool isSelected) const;
+  void drawSearchRow(int i, int y, bool isSelected) const;
+  void renderSelectorMove() const;
 
  public:
   explicit MyLibraryActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
                              const std::function<void()>& onGoHome,
                              const std::function<void(const std::string& path, Tab fromTab)>& onSelectBook,
                              Tab initialTab = Tab::Recent, std::string initialPath = "/")
-      : Activity("MyLibrary", renderer, mappedInput),
+      : ActivityWithSubactivity("MyLibrary", renderer, mappedInput),
         currentTab(initialTab),
         basepath(initialPath.empty() ? "/" : std::move(initialPath)),
         onGoHome(onGoHome),
@@ -64,4 +93,7 @@ class MyLibraryActivity final : public Activity {
   void onEnter() override;
   void onExit() override;
   void loop() override;
+  bool isIdle() override {
+    return subActivity ? subActivity->isIdle() : !updateRequired && !selectorOnlyUpdate && !pendingSearch;
+  }
 };
@@ -1,19 +1,13 @@
 #include "CalibreConnectActivity.h"
 
-#include <ESPmDNS.h>
 #include <GfxRenderer.h>
 #include <WiFi.h>
-#include <esp_task_wdt.h>
 
 #include "MappedInputManager.h"
 #include "ScreenComponents.h"
 #include "WifiSelectionActivity.h"
 #include "fontIds.h"
 
-namespace {
-constexpr const char* HOSTNAME = "crosspoint";
-}  // namespace
-
 void CalibreConnectActivity::taskTrampoline(void* param) {
   auto* self = static_cast<CalibreConnectActivity*>(param);
   self->displayTaskLoop();
@@ -27,7 +21,6 @@ void CalibreConnectActivity::onEnter() {
   state = CalibreConnectState::WIFI_SELECTION;
   connectedIP.clear();
   connectedSSID.clear();
-  lastHandleClientTime = 0;
   lastProgressReceived = 0;
   lastProgressTotal = 0;
   currentUploadName.clear();
@@ -56,7 +49,6 @@ void CalibreConnectActivity::onExit() {
   ActivityWithSubactivity::onExit();
 
   stopWebServer();
-  MDNS.end();
 
   delay(50);
   WiFi.disconnect(false);
@@ -94,11 +86,6 @@ void CalibreConnectActivity::startWebServer() {
   state = CalibreConnectState::SERVER_STARTING;
   updateRequired = true;
 
-  if (MDNS.begin(HOSTNAME)) {
-    // mDNS is optional for the Calibre plugin but still helpful for users.
-    Serial.printf("[%lu] [CAL] mDNS started: http://%s.local/\n", millis(), HOSTNAME);
-  }
-
   webServer.reset(new CrossPointWebServer());
   webServer->begin();
 
@@ -129,28 +116,7 @@ void CalibreConnectActivity::loop() {
   }
 
   if (webServer && webServer->isRunning()) {
-    const unsigned long timeSinceLastHandleClient = millis() - lastHandleClientTime;
-    if (lastHandleClientTime > 0 && timeSinceLastHandleClient > 100) {
-      Serial.printf("[%lu] [CAL] WARNING: %lu ms gap since last handleClient\n", millis(), timeSinceLastHandleClient);
-    }
-
-    esp_task_wdt_reset();
-    constexpr int MAX_ITERATIONS = 80;
-    for (int i = 0; i < MAX_ITERATIONS && webServer->isRunning(); i++) {
-      webServer->handleClient();
-      if ((i & 0x07) == 0x07) {
-        esp_task_wdt_reset();
-      }
-      if ((i & 0x0F) == 0x0F) {
-        yield();
-        if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
-          exitRequested = true;
-          break;
-        }
-      }
-    }
-    lastHandleClientTime = millis();
-
+    // Client handling runs on the web server's own task; just consume the status mailbox
     const auto status = webServer->getWsUploadStatus();
     bool changed = false;
     if (status.inProgress) {
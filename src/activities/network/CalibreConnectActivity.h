@@ -26,7 +26,6 @@ class CalibreConnectActivity final : public ActivityWithSubactivity {
   std::unique_ptr<CrossPointWebServer> webServer;
   std::string connectedIP;
   std::string connectedSSID;
-  unsigned long lastHandleClientTime = 0;
   size_t lastProgressReceived = 0;
   size_t lastProgressTotal = 0;
   std::string currentUploadName;
@@ -1,10 +1,8 @@
 #include "CrossPointWebServerActivity.h"
 
 #include <DNSServer.h>
-#include <ESPmDNS.h>
 #include <GfxRenderer.h>
 #include <WiFi.h>
-#include <esp_task_wdt.h>
 #include <qrcode.h>
 
 #include <cstddef>
@@ -13,6 +11,7 @@
 #include "NetworkModeSelectionActivity.h"
 #include "WifiSelectionActivity.h"
 #include "activities/network/CalibreConnectActivity.h"
+#include "activities/network/DeviceTransferActivity.h"
 #include "fontIds.h"
 
 namespace {
@@ -46,7 +45,6 @@ void CrossPointWebServerActivity::onEnter() {
   isApMode = false;
   connectedIP.clear();
   connectedSSID.clear();
-  lastHandleClientTime = 0;
   updateRequired = true;
 
   xTaskCreate(&CrossPointWebServerActivity::taskTrampoline, "WebServerActivityTask",
@@ -74,9 +72,6 @@ void CrossPointWebServerActivity::onExit() {
   // Stop the web server first (before disconnecting WiFi)
   stopWebServer();
 
-  // Stop mDNS
-  MDNS.end();
-
   // Stop DNS server if running (AP mode)
   if (dnsServer) {
     Serial.printf("[%lu] [WEBACT] Stopping DNS server...\n", millis());
@@ -131,6 +126,8 @@ void CrossPointWebServerActivity::onNetworkModeSelected(const NetworkMode mode)
     modeName = "Connect to Calibre";
   } else if (mode == NetworkMode::CREATE_HOTSPOT) {
     modeName = "Create Hotspot";
+  } else if (mode == NetworkMode::DEVICE_TRANSFER) {
+    modeName = "Device to Device";
   }
   Serial.printf("[%lu] [WEBACT] Network mode selected: %s\n", millis(), modeName);
 
@@ -152,6 +149,18 @@ void CrossPointWebServerActivity::onNetworkModeSelected(const NetworkMode mode)
     return;
   }
 
+  if (mode == NetworkMode::DEVICE_TRANSFER) {
+    exitActivity();
+    enterNewActivity(new DeviceTransferActivity(renderer, mappedInput, [this] {
+      exitActivity();
+      state = WebServerActivityState::MODE_SELECTION;
+      enterNewActivity(new NetworkModeSelectionActivity(
+          renderer, mappedInput, [this](const NetworkMode nextMode) { onNetworkModeSelected(nextMode); },
+          [this]() { onGoBack(); }));
+    }));
+    return;
+  }
+
   if (mode == NetworkMode::JOIN_NETWORK) {
     // STA mode - launch WiFi selection
     Serial.printf("[%lu] [WEBACT] Turning on WiFi (STA mode)...\n", millis());
@@ -180,11 +189,6 @@ void CrossPointWebServerActivity::onWifiSelectionComplete(const bool connected)
 
     exitActivity();
 
-    // Start mDNS for hostname resolution
-    if (MDNS.begin(AP_HOSTNAME)) {
-      Serial.printf("[%lu] [WEBACT] mDNS started: http://%s.local/\n", millis(), AP_HOSTNAME);
-    }
-
     // Start the web server
     startWebServer();
   } else {
@@ -233,13 +237,6 @@ void CrossPointWebServerActivity::startAccessPoint() {
   Serial.printf("[%lu] [WEBACT] SSID: %s\n", millis(), AP_SSID);
   Serial.printf("[%lu] [WEBACT] IP: %s\n", millis(), connectedIP.c_str());
 
-  // Start mDNS for hostname resolution
-  if (MDNS.begin(AP_HOSTNAME)) {
-    Serial.printf("[%lu] [WEBACT] mDNS started: http://%s.local/\n", millis(), AP_HOSTNAME);
-  } else {
-    Serial.printf("[%lu] [WEBACT] WARNING: mDNS failed to start\n", millis());
-  }
-
   // Start DNS server for captive portal behavior
   // This redirects all DNS queries to our IP, making any domain typed resolve to us
   dnsServer = new DNSServer();
@@ -322,42 +319,9 @@ void CrossPointWebServerActivity::loop() {
       }
     }
 
-    // Handle web server requests - maximize throughput with watchdog safety
-    if (webServer && webServer->isRunning()) {
-      const unsigned long timeSinceLastHandleClient = millis() - lastHandleClientTime;
-
-      // Log if there's a significant gap between handleClient calls (>100ms)
-      if (lastHandleClientTime > 0 && timeSinceLastHandleClient > 100) {
-        Serial.printf("[%lu] [WEBACT] WARNING: %lu ms gap since last handleClient\n", millis(),
-                      timeSinceLastHandleClient);
-      }
+    // Client handling runs on the web server's own task; this loop only does UI housekeeping
 
-      // Reset watchdog BEFORE processing - HTTP header parsing can be slow
-      esp_task_wdt_reset();
-
-      // Process HTTP requests in tight loop for maximum throughput
-      // More iterations = more data processed per main loop cycle
-      constexpr int MAX_ITERATIONS = 500;
-      for (int i = 0; i < MAX_ITERATIONS && webServer->isRunning(); i++) {
-        webServer->handleClient();
-        // Reset watchdog every 32 iterations
-        if ((i & 0x1F) == 0x1F) {
-          esp_task_wdt_reset();
-        }
-        // Yield and check for exit button every 64 iterations
-        if ((i & 0x3F) == 0x3F) {
-          yield();
-          // Check for exit button inside loop for responsiveness
-          if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
-            onGoBack();
-            return;
-          }
-        }
-      }
-      lastHandleClientTime = millis();
-    }
-
-    // Handle exit on Back button (also check outside loop)
+    // Handle exit on Back button
     if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
       onGoBack();
       return;
@@ -392,25 +356,71 @@ void CrossPointWebServerActivity::render() const {
   }
 }
 
+namespace {
+// Cached QR module matrices: generation (Reed-Solomon over the payload) dominates drawQRCode,
+// and the same payloads re-render on every status pass while the server is handling clients.
+// Two slots because the AP screen draws the WiFi-config and URL codes back to back.
+constexpr uint8_t QR_VERSION = 4;
+constexpr int QR_MAX_SIZE = 33;  // version 4 is 33x33 modules
+struct QrModuleCache {
+  std::string payload;
+  uint8_t size = 0;
+  uint8_t modules[(QR_MAX_SIZE * QR_MAX_SIZE + 7) / 8] = {};
+};
+QrModuleCache qrCacheSlots[2];
+int qrCacheNextSlot = 0;
+}  // namespace
+
 void drawQRCode(const GfxRenderer& renderer, const int x, const int y, const std::string& data) {
-  // Implementation of QR code calculation
-  // The structure to manage the QR code
-  QRCode qrcode;
-  uint8_t qrcodeBytes[qrcode_getBufferSize(4)];
-  Serial.printf("[%lu] [WEBACT] QR Code (%lu): %s\n", millis(), data.length(), data.c_str());
+  QrModuleCache* cached = nullptr;
+  for (auto& slot : qrCacheSlots) {
+    if (slot.size != 0 && slot.payload == data) {
+      cached = &slot;
+      break;
+    }
+  }
+
+  if (!cached) {
+    QRCode qrcode;
+    uint8_t qrcodeBytes[qrcode_getBufferSize(QR_VERSION)];
+    Serial.printf("[%lu] [WEBACT] QR Code (%lu): %s\n", millis(), data.length(), data.c_str());
+    qrcode_initText(&qrcode, qrcodeBytes, QR_VERSION, ECC_LOW, data.c_str());
+
+    cached = &qrCacheSlots[qrCacheNextSlot];
+    qrCacheNextSlot = (qrCacheNextSlot + 1) % 2;
+    cached->payload = data;
+    cached->size = qrcode.size;
+    memset(cached->modules, 0, sizeof(cached->modules));
+    for (uint8_t cy = 0; cy < qrcode.size; cy++) {
+      for (uint8_t cx = 0; cx < qrcode.size; cx++) {
+        if (qrcode_getModule(&qrcode, cx, cy)) {
+          const int bit = cy * qrcode.size + cx;
+          cached->modules[bit / 8] |= 0x80 >> (bit % 8);
+        }
+      }
+    }
+  }
 
-  qrcode_initText(&qrcode, qrcodeBytes, 4, ECC_LOW, data.c_str());
+  // Block-blit: build one packed 2bpp row per module row (each module is a px-wide square) and
+  // stamp it px times; white modules stay transparent like the old per-module fillRect path
   const uint8_t px = 6;  // pixels per module
-  for (uint8_t cy = 0; cy < qrcode.size; cy++) {
-    for (uint8_t cx = 0; cx < qrcode.size; cx++) {
-      if (qrcode_getModule(&qrcode, cx, cy)) {
-        // Serial.print("**");
-        renderer.fillRect(x + px * cx, y + px * cy, px, px, true);
-      } else {
-        // Serial.print("  ");
+  const int widthPixels = cached->size * px;
+  uint8_t packedRow[(QR_MAX_SIZE * 6 + 3) / 4];
+  for (int cy = 0; cy < cached->size; cy++) {
+    memset(packedRow, 0xFF, sizeof(packedRow));  // all white
+    for (int cx = 0; cx < cached->size; cx++) {
+      const int bit = cy * cached->size + cx;
+      if (!(cached->modules[bit / 8] & (0x80 >> (bit % 8)))) {
+        continue;
       }
+      for (int i = 0; i < px; i++) {
+        const int p = cx * px + i;
+        packedRow[p / 4] &= ~(0x3 << (6 - (p % 4) * 2));  // black
+      }
+    }
+    for (int i = 0; i < px; i++) {
+      renderer.drawPacked2BitRow(x, y + cy * px + i, packedRow, widthPixels);
     }
-    // Serial.print("\n");
   }
 }
 
@@ -48,9 +48,6 @@ class CrossPointWebServerActivity final : public ActivityWithSubactivity {
   std::string connectedIP;
   std::string connectedSSID;  // For STA mode: network name, For AP mode: AP name
 
-  // Performance monitoring
-  unsigned long lastHandleClientTime = 0;
-
   static void taskTrampoline(void* param);
   [[noreturn]] void displayTaskLoop();
   void render() const;
@@ -0,0 +1,374 @@
+#include "DeviceTransferActivity.h"
+
+#include <GfxRenderer.h>
+#include <WiFi.h>
+
+#include "MappedInputManager.h"
+#include "ScreenComponents.h"
+#include "fontIds.h"
+
+namespace {
+// Dedicated hotspot for transfers, so the receiver can join without any user-entered
+// credentials; open like the file-transfer AP
+constexpr const char* TRANSFER_SSID = "CrossPoint-Transfer";
+constexpr uint8_t TRANSFER_CHANNEL = 1;
+
+// The sender's hotspot takes a few seconds to appear; give the join a generous window
+constexpr unsigned long CONNECT_TIMEOUT_MS = 30000;
+
+constexpr int ROLE_COUNT = 2;
+const char* ROLE_ITEMS[ROLE_COUNT] = {"Send library", "Receive library"};
+const char* ROLE_DESCRIPTIONS[ROLE_COUNT] = {
+    "Share this device's books and caches",
+    "Pull everything from another CrossPoint",
+};
+
+std::string truncateName(std::string name, const size_t maxLen) {
+  if (name.length() > maxLen) {
+    name.replace(maxLen - 3, name.length() - (maxLen - 3), "...");
+  }
+  return name;
+}
+}  // namespace
+
+void DeviceTransferActivity::taskTrampoline(void* param) {
+  auto* self = static_cast<DeviceTransferActivity*>(param);
+  self->displayTaskLoop();
+}
+
+void DeviceTransferActivity::onEnter() {
+  Activity::onEnter();
+
+  renderingMutex = xSemaphoreCreateMutex();
+  state = DeviceTransferState::ROLE_SELECTION;
+  selectedIndex = 0;
+  serverStatus = DeviceTransferServer::Status();
+  clientStatus = DeviceTransferClient::Status();
+  errorMessage.clear();
+  updateRequired = true;
+
+  xTaskCreate(&DeviceTransferActivity::taskTrampoline, "DeviceTransferTask",
+              2048,               // Stack size
+              this,               // Parameters
+              1,                  // Priority
+              &displayTaskHandle  // Task handle
+  );
+}
+
+void DeviceTransferActivity::onExit() {
+  Activity::onExit();
+
+  shutdownTransfer();
+
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  if (displayTaskHandle) {
+    vTaskDelete(displayTaskHandle);
+    displayTaskHandle = nullptr;
+  }
+  vSemaphoreDelete(renderingMutex);
+  renderingMutex = nullptr;
+}
+
+void DeviceTransferActivity::startSending() {
+  state = DeviceTransferState::SEND_STARTING;
+  updateRequired = true;
+
+  Serial.printf("[%lu] [DTACT] Starting transfer hotspot...\n", millis());
+  WiFi.mode(WIFI_AP);
+  delay(100);
+  if (!WiFi.softAP(TRANSFER_SSID, nullptr, TRANSFER_CHANNEL)) {
+    Serial.printf("[%lu] [DTACT] ERROR: Failed to start transfer hotspot\n", millis());
+    errorMessage = "Could not start hotspot";
+    state = DeviceTransferState::ERROR;
+    updateRequired = true;
+    return;
+  }
+  delay(100);  // Wait for AP to fully initialize
+
+  server.reset(new DeviceTransferServer());
+  server->begin();
+  if (!server->isRunning()) {
+    errorMessage = "Could not start transfer server";
+    state = DeviceTransferState::ERROR;
+    updateRequired = true;
+    return;
+  }
+  state = DeviceTransferState::SEND_RUNNING;
+  updateRequired = true;
+}
+
+void DeviceTransferActivity::startReceiving() {
+  Serial.printf("[%lu] [DTACT] Joining transfer hotspot...\n", millis());
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(TRANSFER_SSID);
+  connectStartedAt = millis();
+  state = DeviceTransferState::RECEIVE_CONNECTING;
+  updateRequired = true;
+}
+
+void DeviceTransferActivity::shutdownTransfer() {
+  if (client) {
+    client->stop();
+    client.reset();
+  }
+  if (server) {
+    server->stop();
+    server.reset();
+  }
+
+  // Brief wait for LWIP stack to flush pending packets
+  delay(50);
+  if (WiFi.getMode() == WIFI_AP) {
+    WiFi.softAPdisconnect(true);
+  } else {
+    WiFi.disconnect(false);
+  }
+  delay(30);
+  WiFi.mode(WIFI_OFF);
+  delay(30);
+}
+
+void DeviceTransferActivity::loop() {
+  const bool backPressed = mappedInput.wasPressed(MappedInputManager::Button::Back);
+
+  switch (state) {
+    case DeviceTransferState::ROLE_SELECTION: {
+      if (backPressed) {
+        onComplete();
+        return;
+      }
+      if (mappedInput.wasPressed(MappedInputManager::Button::Confirm)) {
+        if (selectedIndex == 0) {
+          startSending();
+        } else {
+          startReceiving();
+        }
+        return;
+      }
+      const bool prevPressed = mappedInput.wasPressed(MappedInputManager::Button::Up) ||
+                               mappedInput.wasPressed(MappedInputManager::Button::Left);
+      const bool nextPressed = mappedInput.wasPressed(MappedInputManager::Button::Down) ||
+                               mappedInput.wasPressed(MappedInputManager::Button::Right);
+      if (prevPressed || nextPressed) {
+        selectedIndex = (selectedIndex + 1) % ROLE_COUNT;
+        updateRequired = true;
+      }
+      break;
+    }
+
+    case DeviceTransferState::SEND_STARTING:
+      break;
+
+    case DeviceTransferState::SEND_RUNNING: {
+      if (backPressed) {
+        onComplete();
+        return;
+      }
+      static unsigned long lastPoll = 0;
+      if (millis() - lastPoll >= 500) {
+        lastPoll = millis();
+        const auto fresh = server->getStatus();
+        if (fresh.clientConnected != serverStatus.clientConnected || fresh.filesSent != serverStatus.filesSent ||
+            fresh.currentFile != serverStatus.currentFile) {
+          serverStatus = fresh;
+          updateRequired = true;
+        }
+      }
+      break;
+    }
+
+    case DeviceTransferState::RECEIVE_CONNECTING: {
+      if (backPressed) {
+        onComplete();
+        return;
+      }
+      if (WiFi.status() == WL_CONNECTED) {
+        // The sender is the gateway of its own hotspot
+        const std::string host = WiFi.gatewayIP().toString().c_str();
+        Serial.printf("[%lu] [DTACT] Joined hotspot, pulling from %s\n", millis(), host.c_str());
+        client.reset(new DeviceTransferClient());
+        client->begin(host);
+        state = DeviceTransferState::RECEIVING;
+        updateRequired = true;
+      } else if (millis() - connectStartedAt > CONNECT_TIMEOUT_MS) {
+        errorMessage = "Sender's hotspot not found";
+        state = DeviceTransferState::ERROR;
+        updateRequired = true;
+      }
+      break;
+    }
+
+    case DeviceTransferState::RECEIVING: {
+      if (backPressed) {
+        // Stop after the file in flight so nothing is left half-written
+        client->cancel();
+      }
+      static unsigned long lastPoll = 0;
+      if (millis() - lastPoll >= 500) {
+        lastPoll = millis();
+        const auto fresh = client->getStatus();
+        if (fresh.state != clientStatus.state || fresh.filesDone != clientStatus.filesDone ||
+            fresh.bytesDone != clientStatus.bytesDone || fresh.currentFile != clientStatus.currentFile) {
+          clientStatus = fresh;
+          updateRequired = true;
+        }
+        if (fresh.state == DeviceTransferClient::State::DONE) {
+          state = DeviceTransferState::COMPLETE;
+          updateRequired = true;
+        } else if (fresh.state == DeviceTransferClient::State::FAILED) {
+          errorMessage = fresh.error;
+          state = DeviceTransferState::ERROR;
+          updateRequired = true;
+        }
+      }
+      break;
+    }
+
+    case DeviceTransferState::COMPLETE:
+    case DeviceTransferState::ERROR: {
+      if (backPressed || mappedInput.wasPressed(MappedInputManager::Button::Confirm)) {
+        onComplete();
+        return;
+      }
+      break;
+    }
+  }
+}
+
+void DeviceTransferActivity::displayTaskLoop() {
+  while (true) {
+    if (updateRequired) {
+      updateRequired = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      render();
+      xSemaphoreGive(renderingMutex);
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+}
+
+void DeviceTransferActivity::render() const {
+  renderer.clearScreen();
+  renderer.drawCenteredText(UI_12_FONT_ID, 15, "Device to Device", true, EpdFontFamily::BOLD);
+
+  const auto pageHeight = renderer.getScreenHeight();
+  switch (state) {
+    case DeviceTransferState::ROLE_SELECTION:
+      renderRoleSelection();
+      break;
+    case DeviceTransferState::SEND_STARTING:
+      renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 20, "Starting hotspot...");
+      break;
+    case DeviceTransferState::SEND_RUNNING:
+      renderSending();
+      break;
+    case DeviceTransferState::RECEIVE_CONNECTING:
+      renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 40, "Looking for the sender...");
+      renderer.drawCenteredText(SMALL_FONT_ID, pageHeight / 2 - 10,
+                                "Choose \"Send library\" on the other device first");
+      break;
+    case DeviceTransferState::RECEIVING:
+      renderReceiving();
+      break;
+    case DeviceTransferState::COMPLETE: {
+      renderer.drawCenteredText(UI_12_FONT_ID, pageHeight / 2 - 40, "Transfer complete", true, EpdFontFamily::BOLD);
+      char summary[96];
+      snprintf(summary, sizeof(summary), "%lu files pulled, %lu already present",
+               static_cast<unsigned long>(clientStatus.filesDone),
+               static_cast<unsigned long>(clientStatus.filesSkipped));
+      renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 5, summary);
+      break;
+    }
+    case DeviceTransferState::ERROR:
+      renderer.drawCenteredText(UI_12_FONT_ID, pageHeight / 2 - 40, "Transfer failed", true, EpdFontFamily::BOLD);
+      if (!errorMessage.empty()) {
+        renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 5, errorMessage.c_str());
+      }
+      break;
+  }
+
+  const bool selecting = state == DeviceTransferState::ROLE_SELECTION;
+  const auto labels = mappedInput.mapLabels("« Back", selecting ? "Select" : "", "", "");
+  renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+  renderer.displayBuffer();
+}
+
+void DeviceTransferActivity::renderRoleSelection() const {
+  const auto pageWidth = renderer.getScreenWidth();
+  const auto pageHeight = renderer.getScreenHeight();
+
+  renderer.drawCenteredText(UI_10_FONT_ID, 50, "Move a library between two CrossPoints");
+
+  constexpr int itemHeight = 50;
+  const int startY = (pageHeight - (ROLE_COUNT * itemHeight)) / 2 + 10;
+  for (int i = 0; i < ROLE_COUNT; i++) {
+    const int itemY = startY + i * itemHeight;
+    const bool isSelected = (i == selectedIndex);
+    if (isSelected) {
+      renderer.fillRect(20, itemY - 2, pageWidth - 40, itemHeight - 6);
+    }
+    renderer.drawText(UI_10_FONT_ID, 30, itemY, ROLE_ITEMS[i], /*black=*/!isSelected);
+    renderer.drawText(SMALL_FONT_ID, 30, itemY + 22, ROLE_DESCRIPTIONS[i], /*black=*/!isSelected);
+  }
+}
+
+void DeviceTransferActivity::renderSending() const {
+  constexpr int LINE_SPACING = 28;
+  int y = 70;
+
+  renderer.drawCenteredText(UI_10_FONT_ID, y, "Sharing this library", true, EpdFontFamily::BOLD);
+  y += LINE_SPACING;
+  renderer.drawCenteredText(SMALL_FONT_ID, y, "On the other device choose \"Receive library\"");
+  y += LINE_SPACING * 2;
+
+  if (serverStatus.clientConnected) {
+    renderer.drawCenteredText(UI_10_FONT_ID, y, "Receiver connected");
+    y += LINE_SPACING;
+    if (!serverStatus.currentFile.empty()) {
+      const std::string line = "Sending: " + truncateName(serverStatus.currentFile, 34);
+      renderer.drawCenteredText(SMALL_FONT_ID, y, line.c_str());
+      y += LINE_SPACING;
+    }
+    char sent[64];
+    snprintf(sent, sizeof(sent), "%lu files, %llu KB sent", static_cast<unsigned long>(serverStatus.filesSent),
+             serverStatus.bytesSent / 1024);
+    renderer.drawCenteredText(SMALL_FONT_ID, y, sent);
+  } else {
+    renderer.drawCenteredText(UI_10_FONT_ID, y, "Waiting for a receiver...");
+  }
+}
+
+void DeviceTransferActivity::renderReceiving() const {
+  constexpr int LINE_SPACING = 28;
+  int y = 70;
+
+  if (clientStatus.state == DeviceTransferClient::State::CONNECTING ||
+      clientStatus.state == DeviceTransferClient::State::INDEXING) {
+    renderer.drawCenteredText(UI_10_FONT_ID, y, "Reading the sender's library...");
+    return;
+  }
+
+  renderer.drawCenteredText(UI_10_FONT_ID, y, "Receiving library", true, EpdFontFamily::BOLD);
+  y += LINE_SPACING;
+  char progress[96];
+  snprintf(progress, sizeof(progress), "%lu of %lu files (%lu already present)",
+           static_cast<unsigned long>(clientStatus.filesDone), static_cast<unsigned long>(clientStatus.filesTotal),
+           static_cast<unsigned long>(clientStatus.filesSkipped));
+  renderer.drawCenteredText(SMALL_FONT_ID, y, progress);
+  y += LINE_SPACING;
+
+  if (!clientStatus.currentFile.empty()) {
+    const std::string line = truncateName(clientStatus.currentFile, 36);
+    renderer.drawCenteredText(SMALL_FONT_ID, y, line.c_str());
+    y += LINE_SPACING;
+  }
+
+  if (clientStatus.bytesTotal > 0) {
+    constexpr int barWidth = 300;
+    constexpr int barHeight = 16;
+    constexpr int barX = (480 - barWidth) / 2;
+    ScreenComponents::drawProgressBar(renderer, barX, y + 6, barWidth, barHeight,
+                                      static_cast<size_t>(clientStatus.bytesDone / 1024),
+                                      static_cast<size_t>(clientStatus.bytesTotal / 1024));
+  }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "activities/Activity.h"
+#include "network/DeviceTransferClient.h"
+#include "network/DeviceTransferServer.h"
+
+enum class DeviceTransferState {
+  ROLE_SELECTION,      // Choosing between sending and receiving
+  SEND_STARTING,       // Bringing up the transfer hotspot
+  SEND_RUNNING,        // Serving the library, waiting for / feeding a receiver
+  RECEIVE_CONNECTING,  // Joining the sender's hotspot
+  RECEIVING,           // Pulling the library
+  COMPLETE,            // Pull finished (receiver only)
+  ERROR
+};
+
+/**
+ * DeviceTransferActivity moves a library directly between two CrossPoints.
+ *
+ * The sending device creates a dedicated open hotspot and serves its library (books plus warm
+ * cache directories) over DeviceTransferServer's raw TCP protocol; the receiving device joins
+ * that hotspot and pulls everything it is missing via DeviceTransferClient. No PC, phone or
+ * SD card shuffling involved.
+ */
+class DeviceTransferActivity final : public Activity {
+  TaskHandle_t displayTaskHandle = nullptr;
+  SemaphoreHandle_t renderingMutex = nullptr;
+  bool updateRequired = false;
+  DeviceTransferState state = DeviceTransferState::ROLE_SELECTION;
+  int selectedIndex = 0;
+  const std::function<void()> onComplete;
+
+  std::unique_ptr<DeviceTransferServer> server;
+  std::unique_ptr<DeviceTransferClient> client;
+
+  // Last status snapshots, compared in loop() to avoid redundant e-ink refreshes
+  DeviceTransferServer::Status serverStatus;
+  DeviceTransferClient::Status clientStatus;
+
+  unsigned long connectStartedAt = 0;
+  std::string errorMessage;
+
+  static void taskTrampoline(void* param);
+  [[noreturn]] void displayTaskLoop();
+  void render() const;
+  void renderRoleSelection() const;
+  void renderSending() const;
+  void renderReceiving() const;
+
+  void startSending();
+  void startReceiving();
+  void shutdownTransfer();
+
+ public:
+  explicit DeviceTransferActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
+                                  const std::function<void()>& onComplete)
+      : Activity("DeviceTransfer", renderer, mappedInput), onComplete(onComplete) {}
+  void onEnter() override;
+  void onExit() override;
+  void loop() override;
+  bool preventAutoSleep() override {
+    return state != DeviceTransferState::ROLE_SELECTION && state != DeviceTransferState::COMPLETE &&
+           state != DeviceTransferState::ERROR;
+  }
+};
@@ -8,13 +8,14 @@
 #include "../Activity.h"
 
 // Enum for network mode selection
-enum class NetworkMode { JOIN_NETWORK, CONNECT_CALIBRE, CREATE_HOTSPOT };
+enum class NetworkMode { JOIN_NETWORK, CONNECT_CALIBRE, CREATE_HOTSPOT, DEVICE_TRANSFER };
 
 /**
  * NetworkModeSelectionActivity presents the user with a choice:
  * - "Join a Network" - Connect to an existing WiFi network (STA mode)
  * - "Connect to Calibre" - Use Calibre wireless device transfers
  * - "Create Hotspot" - Create an Access Point that others can connect to (AP mode)
+ * - "Device to Device" - Move a library directly to/from another CrossPoint
  *
  * The onModeSelected callback is called with the user's choice.
  * The onCancel callback is called if the user presses back.
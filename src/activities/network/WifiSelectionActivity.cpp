@@ -9,6 +9,7 @@
 #include "WifiCredentialStore.h"
 #include "activities/util/KeyboardEntryActivity.h"
 #include "fontIds.h"
+#include "network/WifiFastConnect.h"
 
 void WifiSelectionActivity::taskTrampoline(void* param) {
   auto* self = static_cast<WifiSelectionActivity*>(param);
@@ -29,6 +30,7 @@ void WifiSelectionActivity::onEnter() {
   selectedNetworkIndex = 0;
   networks.clear();
   state = WifiSelectionState::SCANNING;
+  backgroundRescan = false;
   selectedSSID.clear();
   connectedIP.clear();
   connectionError.clear();
@@ -45,7 +47,15 @@ void WifiSelectionActivity::onEnter() {
            mac[5]);
   cachedMacAddress = std::string(macStr);
 
-  // Trigger first update to show scanning message
+  // If a scan completed recently, show its results immediately instead of a blank
+  // "Scanning..." screen; startWifiScan() below still refreshes the list in the background
+  if (WifiScanCache::isFresh()) {
+    networks = WifiScanCache::get();
+    state = WifiSelectionState::NETWORK_LIST;
+    Serial.printf("[%lu] [WIFI] Showing %zu cached networks while rescanning\n", millis(), networks.size());
+  }
+
+  // Trigger first update to show scanning message (or the cached list)
   updateRequired = true;
 
   xTaskCreate(&WifiSelectionActivity::taskTrampoline, "WifiSelectionTask",
@@ -95,8 +105,13 @@ void WifiSelectionActivity::onExit() {
 }
 
 void WifiSelectionActivity::startWifiScan() {
-  state = WifiSelectionState::SCANNING;
-  networks.clear();
+  // When a cached list is already on screen, rescan quietly behind it instead of
+  // blanking back to the "Scanning..." screen
+  backgroundRescan = state == WifiSelectionState::NETWORK_LIST && !networks.empty();
+  if (!backgroundRescan) {
+    state = WifiSelectionState::SCANNING;
+    networks.clear();
+  }
   updateRequired = true;
 
   // Set WiFi mode to station
@@ -117,6 +132,8 @@ void WifiSelectionActivity::processWifiScanResults() {
   }
 
   if (scanResult == WIFI_SCAN_FAILED) {
+    // On a failed background rescan, keep showing the cached list
+    backgroundRescan = false;
     state = WifiSelectionState::NETWORK_LIST;
     updateRequired = true;
     return;
@@ -165,8 +182,17 @@ void WifiSelectionActivity::processWifiScanResults() {
   });
 
   WiFi.scanDelete();
+  WifiScanCache::store(networks);
   state = WifiSelectionState::NETWORK_LIST;
-  selectedNetworkIndex = 0;
+  if (backgroundRescan) {
+    // Keep the user's position in the (refreshed) list rather than jumping to the top
+    backgroundRescan = false;
+    if (selectedNetworkIndex >= static_cast<int>(networks.size())) {
+      selectedNetworkIndex = networks.empty() ? 0 : static_cast<int>(networks.size()) - 1;
+    }
+  } else {
+    selectedNetworkIndex = 0;
+  }
   updateRequired = true;
 }
 
@@ -251,6 +277,11 @@ void WifiSelectionActivity::checkConnectionStatus() {
     snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
     connectedIP = ipStr;
 
+    // Record the fast-reconnect hint - SD card write needs the lock as we use SPI for both
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    WifiFastConnect::noteConnected();
+    xSemaphoreGive(renderingMutex);
+
     // If we entered a new password, ask if user wants to save it
     // Otherwise, immediately complete so parent can start web server
     if (!usedSavedPassword && !enteredPassword.empty()) {
@@ -403,6 +434,11 @@ void WifiSelectionActivity::loop() {
 
   // Handle network list state
   if (state == WifiSelectionState::NETWORK_LIST) {
+    // Poll the background rescan while the cached list stays interactive
+    if (backgroundRescan) {
+      processWifiScanResults();
+    }
+
     // Check for Back button to exit (cancel)
     if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
       onComplete(false);
@@ -574,9 +610,10 @@ void WifiSelectionActivity::renderNetworkList() const {
       renderer.drawText(SMALL_FONT_ID, pageWidth - 15, startY + maxVisibleNetworks * lineHeight, "v");
     }
 
-    // Show network count
-    char countStr[32];
-    snprintf(countStr, sizeof(countStr), "%zu networks found", networks.size());
+    // Show network count (and whether a background rescan is still refreshing it)
+    char countStr[48];
+    snprintf(countStr, sizeof(countStr), "%zu networks found%s", networks.size(),
+             backgroundRescan ? " - rescanning..." : "");
     renderer.drawText(SMALL_FONT_ID, 20, pageHeight - 90, countStr);
   }
 
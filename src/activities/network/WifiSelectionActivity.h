@@ -10,14 +10,7 @@
 #include <vector>
 
 #include "activities/ActivityWithSubactivity.h"
-
-// Structure to hold WiFi network information
-struct WifiNetworkInfo {
-  std::string ssid;
-  int32_t rssi;
-  bool isEncrypted;
-  bool hasSavedPassword;  // Whether we have saved credentials for this network
-};
+#include "network/WifiScanCache.h"
 
 // WiFi selection states
 enum class WifiSelectionState {
@@ -47,6 +40,8 @@ class WifiSelectionActivity final : public ActivityWithSubactivity {
   SemaphoreHandle_t renderingMutex = nullptr;
   bool updateRequired = false;
   WifiSelectionState state = WifiSelectionState::SCANNING;
+  // True while a rescan runs behind an already-displayed (cached) network list
+  bool backgroundRescan = false;
   int selectedNetworkIndex = 0;
   std::vector<WifiNetworkInfo> networks;
   const std::function<void(bool connected)> onComplete;
@@ -0,0 +1,230 @@
+#include "DictionaryLookupActivity.h"
+
+#include <Dictionary.h>
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+
+#include <algorithm>
+
+#include "MappedInputManager.h"
+#include "activities/util/KeyboardEntryActivity.h"
+#include "fontIds.h"
+
+namespace {
+// Time threshold for treating a long press as a page-up/page-down
+constexpr int SKIP_PAGE_MS = 700;
+constexpr int CONTENT_START_Y = 60;
+constexpr int LINE_HEIGHT = 26;
+constexpr int SIDE_MARGIN = 20;
+}  // namespace
+
+int DictionaryLookupActivity::getPageLines() const {
+  const int endY = renderer.getScreenHeight() - 60;  // Space for button hints
+  const int lines = (endY - CONTENT_START_Y) / LINE_HEIGHT;
+  return lines < 1 ? 1 : lines;
+}
+
+void DictionaryLookupActivity::taskTrampoline(void* param) {
+  auto* self = static_cast<DictionaryLookupActivity*>(param);
+  self->displayTaskLoop();
+}
+
+void DictionaryLookupActivity::onEnter() {
+  ActivityWithSubactivity::onEnter();
+
+  renderingMutex = xSemaphoreCreateMutex();
+  state = LookupState::WORD_ENTRY;
+  updateRequired = true;
+
+  xTaskCreate(&DictionaryLookupActivity::taskTrampoline, "DictionaryLookupTask",
+              4096,               // Stack size
+              this,               // Parameters
+              1,                  // Priority
+              &displayTaskHandle  // Task handle
+  );
+
+  launchKeyboard();
+}
+
+void DictionaryLookupActivity::onExit() {
+  ActivityWithSubactivity::onExit();
+
+  // Wait until not rendering to delete task to avoid killing mid-instruction to EPD
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  if (displayTaskHandle) {
+    vTaskDelete(displayTaskHandle);
+    displayTaskHandle = nullptr;
+  }
+  vSemaphoreDelete(renderingMutex);
+  renderingMutex = nullptr;
+}
+
+void DictionaryLookupActivity::launchKeyboard() {
+  state = LookupState::WORD_ENTRY;
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  exitActivity();
+  enterNewActivity(new KeyboardEntryActivity(
+      renderer, mappedInput, "Dictionary", word,
+      10,     // startY
+      48,     // maxLength
+      false,  // not password
+      [this](const std::string& entered) {
+        exitActivity();
+        word = entered;
+        // Look up from loop() rather than inside the keyboard's callback stack
+        pendingLookup = true;
+      },
+      [this] {
+        exitActivity();
+        onGoBack();
+      }));
+  xSemaphoreGive(renderingMutex);
+}
+
+void DictionaryLookupActivity::runLookup() {
+  state = LookupState::RESULT;
+  definition.clear();
+  wrappedLines.clear();
+  scrollLine = 0;
+  entryFound = !word.empty() && DICTIONARY.lookup(word, definition);
+  if (entryFound) {
+    wrapDefinition();
+  }
+  updateRequired = true;
+}
+
+// Greedy word wrap of the definition into content-width lines; embedded
+// newlines (sense separators from the build script) start a fresh line
+void DictionaryLookupActivity::wrapDefinition() {
+  const int maxWidth = renderer.getScreenWidth() - SIDE_MARGIN * 2;
+  std::string line;
+  std::string token;
+  const auto flushLine = [&] {
+    wrappedLines.push_back(line);
+    line.clear();
+  };
+  for (size_t i = 0; i <= definition.size(); i++) {
+    const char c = i < definition.size() ? definition[i] : '\n';
+    if (c != ' ' && c != '\n') {
+      token += c;
+      continue;
+    }
+    if (!token.empty()) {
+      const std::string candidate = line.empty() ? token : line + " " + token;
+      if (renderer.getTextWidth(UI_10_FONT_ID, candidate.c_str()) <= maxWidth) {
+        line = candidate;
+      } else {
+        if (!line.empty()) {
+          flushLine();
+        }
+        // An over-wide single token still gets its own (truncated) line
+        line = token;
+      }
+      token.clear();
+    }
+    if (c == '\n' && (!line.empty() || !wrappedLines.empty())) {
+      flushLine();
+    }
+  }
+  while (!wrappedLines.empty() && wrappedLines.back().empty()) {
+    wrappedLines.pop_back();
+  }
+}
+
+void DictionaryLookupActivity::loop() {
+  if (subActivity) {
+    subActivity->loop();
+    return;
+  }
+
+  if (pendingLookup) {
+    pendingLookup = false;
+    runLookup();
+    return;
+  }
+
+  if (state != LookupState::RESULT) {
+    return;
+  }
+
+  const bool prevReleased = mappedInput.wasReleased(MappedInputManager::Button::Up) ||
+                            mappedInput.wasReleased(MappedInputManager::Button::Left);
+  const bool nextReleased = mappedInput.wasReleased(MappedInputManager::Button::Down) ||
+                            mappedInput.wasReleased(MappedInputManager::Button::Right);
+  const bool skipPage = mappedInput.getHeldTime() > SKIP_PAGE_MS;
+  const int pageLines = getPageLines();
+  const int maxScroll = static_cast<int>(wrappedLines.size()) - pageLines;
+
+  if (mappedInput.wasReleased(MappedInputManager::Button::Confirm) ||
+      mappedInput.wasReleased(MappedInputManager::Button::Back)) {
+    // Both buttons go back to the keyboard for the next word; exiting the
+    // feature is the keyboard's cancel
+    launchKeyboard();
+  } else if (prevReleased && scrollLine > 0) {
+    scrollLine -= skipPage ? pageLines : 1;
+    if (scrollLine < 0) {
+      scrollLine = 0;
+    }
+    updateRequired = true;
+  } else if (nextReleased && scrollLine < maxScroll) {
+    scrollLine += skipPage ? pageLines : 1;
+    if (scrollLine > maxScroll) {
+      scrollLine = maxScroll;
+    }
+    updateRequired = true;
+  }
+}
+
+void DictionaryLookupActivity::displayTaskLoop() {
+  while (true) {
+    if (updateRequired && !subActivity) {
+      updateRequired = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      render();
+      xSemaphoreGive(renderingMutex);
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+}
+
+void DictionaryLookupActivity::render() {
+  renderer.clearScreen();
+
+  const auto pageWidth = renderer.getScreenWidth();
+  const auto pageHeight = renderer.getScreenHeight();
+
+  const std::string title = renderer.truncatedText(UI_12_FONT_ID, word.c_str(), pageWidth - 40, EpdFontFamily::BOLD);
+  renderer.drawCenteredText(UI_12_FONT_ID, 15, title.c_str(), true, EpdFontFamily::BOLD);
+
+  if (state != LookupState::RESULT) {
+    renderer.displayBuffer();
+    return;
+  }
+
+  if (!entryFound) {
+    const char* message = DICTIONARY.isAvailable() ? "No entry found" : "No dictionary on SD card (/dictionary.xdic)";
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, message);
+  } else {
+    const int pageLines = getPageLines();
+    for (int i = 0; i < pageLines; i++) {
+      const int lineIndex = scrollLine + i;
+      if (lineIndex >= static_cast<int>(wrappedLines.size())) {
+        break;
+      }
+      const std::string line =
+          renderer.truncatedText(UI_10_FONT_ID, wrappedLines[lineIndex].c_str(), pageWidth - SIDE_MARGIN * 2);
+      renderer.drawText(UI_10_FONT_ID, SIDE_MARGIN, CONTENT_START_Y + i * LINE_HEIGHT, line.c_str());
+    }
+    if (static_cast<int>(wrappedLines.size()) > pageLines) {
+      const std::string more = std::to_string(scrollLine + 1) + "-" +
+                               std::to_string(std::min(scrollLine + pageLines, static_cast<int>(wrappedLines.size()))) +
+                               " of " + std::to_string(wrappedLines.size()) + " lines";
+      renderer.drawCenteredText(SMALL_FONT_ID, pageHeight - 55, more.c_str());
+    }
+  }
+
+  const auto labels = mappedInput.mapLabels("« Word", "Word", "Up", "Down");
+  renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+
+  renderer.displayBuffer();
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <string>
+#include <vector>
+
+#include "../ActivityWithSubactivity.h"
+
+/**
+ * Dictionary lookup from the reader menu. The word is entered (or refined) on
+ * the keyboard; the definition comes from the on-SD dictionary file via
+ * Dictionary's binary-searched index, so the answer paints well inside a page
+ * turn. Back from the definition re-opens the keyboard for the next word.
+ */
+class DictionaryLookupActivity final : public ActivityWithSubactivity {
+  enum class LookupState {
+    WORD_ENTRY,  // Keyboard subactivity is up
+    RESULT,      // Showing the definition (or a miss)
+  };
+
+  TaskHandle_t displayTaskHandle = nullptr;
+  SemaphoreHandle_t renderingMutex = nullptr;
+  bool updateRequired = false;
+
+  LookupState state = LookupState::WORD_ENTRY;
+  std::string word;
+  std::string definition;
+  bool entryFound = false;
+  // Definition pre-wrapped to the content width; scrolled by whole lines
+  std::vector<std::string> wrappedLines;
+  int scrollLine = 0;
+  bool pendingLookup = false;
+
+  const std::function<void()> onGoBack;
+
+  int getPageLines() const;
+  static void taskTrampoline(void* param);
+  [[noreturn]] void displayTaskLoop();
+  void render();
+  void launchKeyboard();
+  void runLookup();
+  void wrapDefinition();
+
+ public:
+  explicit DictionaryLookupActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
+                                    const std::function<void()>& onGoBack)
+      : ActivityWithSubactivity("DictionaryLookup", renderer, mappedInput), onGoBack(onGoBack) {}
+  void onEnter() override;
+  void onExit() override;
+  void loop() override;
+};
@@ -3,22 +3,59 @@
 #include <Epub/Page.h>
 #include <FsHelpers.h>
 #include <GfxRenderer.h>
+#include <HeapMonitor.h>
+#include <KOReaderCredentialStore.h>
+#include <KOReaderDocumentId.h>
+#include <KOReaderSyncQueue.h>
+#include <ProgressMapper.h>
 #include <SDCardManager.h>
+#include <Serialization.h>
+#include <Trace.h>
+#include <TurnLatency.h>
 
+#include "CacheGc.h"
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
 #include "EpubReaderChapterSelectionActivity.h"
 #include "MappedInputManager.h"
+#include "PowerGovernor.h"
+#include "ReadingStats.h"
 #include "RecentBooksStore.h"
 #include "ScreenComponents.h"
+#include "SdIoScheduler.h"
 #include "fontIds.h"
 
 namespace {
 // pagesPerRefresh now comes from SETTINGS.getRefreshFrequency()
 constexpr unsigned long skipChapterMs = 700;
 constexpr unsigned long goHomeMs = 1000;
+// How long the reader must sit idle before we speculatively paginate adjacent chapters
+constexpr unsigned long prePaginateIdleMs = 2000;
+// Dwell before a turbo-flushed page is silently re-pushed with a quality refresh
+constexpr unsigned long settleDwellMs = 2000;
 constexpr int statusBarMargin = 19;
 constexpr int progressBarMarginTop = 1;
+// Shadow-diff bytes a dense text page typically changes (~a quarter of the panel); the ghosting
+// budget is the refresh-frequency setting times this, keeping "every N pages" semantics for
+// full-text books while lighter pages accumulate less
+constexpr size_t GHOSTING_BYTES_PER_PAGE = HalDisplay::BUFFER_SIZE / 4;
+// Hard cap on consecutive turbo page turns before a quality settle; the byte budget alone can
+// stretch too far on sparse pages while the turbo waveform accumulates residue every flush
+constexpr int MAX_TURBO_TURNS = 20;
+// Skim mode: several turns in a row arriving under skimEnterGapMs switch the reader to
+// decimated rendering - only every skimFullRenderEvery'th page is painted, the rest show just
+// the progress strip. A dwell of skimExitDwellMs counts as release and paints the landing page
+// at full quality.
+constexpr unsigned long skimEnterGapMs = 600;
+constexpr int skimEnterTurns = 3;
+constexpr int skimFullRenderEvery = 10;
+constexpr unsigned long skimExitDwellMs = 700;
+constexpr uint8_t RESUME_MANIFEST_VERSION = 1;
+// Version byte + the ResumeManifest fields in declaration order
+constexpr uint32_t RESUME_MANIFEST_SIZE = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint16_t) +
+                                          sizeof(int) + sizeof(float) + sizeof(bool) + sizeof(uint8_t) +
+                                          sizeof(uint16_t) + sizeof(uint16_t) + sizeof(bool) + sizeof(bool) +
+                                          sizeof(uint32_t) + sizeof(uint32_t);
 
 }  // namespace
 
@@ -27,6 +64,93 @@ void EpubReaderActivity::taskTrampoline(void* param) {
   self->displayTaskLoop();
 }
 
+void EpubReaderActivity::prePaginateTaskTrampoline(void* param) {
+  auto* self = static_cast<EpubReaderActivity*>(param);
+  self->prePaginateTaskLoop();
+}
+
+// Consume-once: the manifest is only trustworthy when written by a clean exit, so it's removed as
+// soon as it's read. A crash mid-session falls back to progress.bin on the next open.
+bool EpubReaderActivity::loadResumeManifest() {
+  const auto path = epub->getCachePath() + "/resume.bin";
+  FsFile f;
+  if (!SdMan.openFileForRead("ERS", path, f)) {
+    return false;
+  }
+
+  uint8_t version = 0;
+  serialization::readPod(f, version);
+  bool ok = version == RESUME_MANIFEST_VERSION && f.size() == RESUME_MANIFEST_SIZE;
+  if (ok) {
+    serialization::readPod(f, resumeManifest.spineIndex);
+    serialization::readPod(f, resumeManifest.page);
+    serialization::readPod(f, resumeManifest.chapterPageCount);
+    serialization::readPod(f, resumeManifest.fontId);
+    serialization::readPod(f, resumeManifest.lineCompression);
+    serialization::readPod(f, resumeManifest.extraParagraphSpacing);
+    serialization::readPod(f, resumeManifest.paragraphAlignment);
+    serialization::readPod(f, resumeManifest.viewportWidth);
+    serialization::readPod(f, resumeManifest.viewportHeight);
+    serialization::readPod(f, resumeManifest.hyphenationEnabled);
+    serialization::readPod(f, resumeManifest.optimalLineBreaks);
+    serialization::readPod(f, resumeManifest.lutOffset);
+    serialization::readPod(f, resumeManifest.pagePos);
+  }
+  f.close();
+  SdMan.remove(path.c_str());
+  if (!ok) {
+    Serial.printf("[%lu] [ERS] Ignoring resume manifest with unknown version or bad length\n", millis());
+  }
+  return ok;
+}
+
+// Written on clean exit while the section is still alive; packs everything the next open needs
+// for its first paint into one blob
+void EpubReaderActivity::saveResumeManifest() {
+  if (!epub || !section || section->pageCount == 0 || currentSpineIndex >= epub->getSpineItemsCount()) {
+    return;
+  }
+
+  ResumeManifest m;
+  m.spineIndex = static_cast<uint16_t>(currentSpineIndex);
+  m.page = static_cast<uint16_t>(section->currentPage);
+  m.chapterPageCount = section->pageCount;
+  m.fontId = SETTINGS.getReaderFontId();
+  m.lineCompression = SETTINGS.getReaderLineCompression();
+  m.extraParagraphSpacing = SETTINGS.extraParagraphSpacing;
+  m.paragraphAlignment = SETTINGS.paragraphAlignment;
+  m.viewportWidth = lastViewportWidth;
+  m.viewportHeight = lastViewportHeight;
+  m.hyphenationEnabled = SETTINGS.hyphenationEnabled;
+  m.optimalLineBreaks = SETTINGS.optimalLineBreaks;
+  m.lutOffset = section->getLutOffset();
+  m.pagePos = section->getPagePosition(section->currentPage);
+  if (m.lutOffset == 0 || m.pagePos == 0) {
+    return;
+  }
+
+  FsFile f;
+  if (!SdMan.openFileForWrite("ERS", epub->getCachePath() + "/resume.bin", f)) {
+    return;
+  }
+  serialization::writePod(f, RESUME_MANIFEST_VERSION);
+  serialization::writePod(f, m.spineIndex);
+  serialization::writePod(f, m.page);
+  serialization::writePod(f, m.chapterPageCount);
+  serialization::writePod(f, m.fontId);
+  serialization::writePod(f, m.lineCompression);
+  serialization::writePod(f, m.extraParagraphSpacing);
+  serialization::writePod(f, m.paragraphAlignment);
+  serialization::writePod(f, m.viewportWidth);
+  serialization::writePod(f, m.viewportHeight);
+  serialization::writePod(f, m.hyphenationEnabled);
+  serialization::writePod(f, m.optimalLineBreaks);
+  serialization::writePod(f, m.lutOffset);
+  serialization::writePod(f, m.pagePos);
+  f.close();
+  Serial.printf("[%lu] [ERS] Saved resume manifest: %d, %d\n", millis(), currentSpineIndex, section->currentPage);
+}
+
 void EpubReaderActivity::onEnter() {
   ActivityWithSubactivity::onEnter();
 
@@ -54,22 +178,38 @@ void EpubReaderActivity::onEnter() {
 
   renderingMutex = xSemaphoreCreateMutex();
 
-  epub->setupCacheDir();
+  // Page turns mostly preserve margins and chrome; the shadow lets the renderer skip or
+  // downgrade refreshes based on what actually changed
+  renderer.setFrameShadowEnabled(true);
 
-  FsFile f;
-  if (SdMan.openFileForRead("ERS", epub->getCachePath() + "/progress.bin", f)) {
-    uint8_t data[6];
-    int dataSize = f.read(data, 6);
-    if (dataSize == 4 || dataSize == 6) {
-      currentSpineIndex = data[0] + (data[1] << 8);
-      nextPageNumber = data[2] + (data[3] << 8);
-      cachedSpineIndex = currentSpineIndex;
-      Serial.printf("[%lu] [ERS] Loaded cache: %d, %d\n", millis(), currentSpineIndex, nextPageNumber);
-    }
-    if (dataSize == 6) {
-      cachedChapterTotalPageCount = data[4] + (data[5] << 8);
+  epub->setupCacheDir();
+  annotations.load(epub->getCachePath());
+
+  if (loadResumeManifest()) {
+    // The manifest supersedes progress.bin: it was written after the last progress update and
+    // additionally carries the section header state for renderScreen's fast path
+    currentSpineIndex = resumeManifest.spineIndex;
+    nextPageNumber = resumeManifest.page;
+    cachedSpineIndex = currentSpineIndex;
+    cachedChapterTotalPageCount = resumeManifest.chapterPageCount;
+    resumeManifestLoaded = true;
+    Serial.printf("[%lu] [ERS] Loaded resume manifest: %d, %d\n", millis(), currentSpineIndex, nextPageNumber);
+  } else {
+    FsFile f;
+    if (SdMan.openFileForRead("ERS", epub->getCachePath() + "/progress.bin", f)) {
+      uint8_t data[6];
+      int dataSize = f.read(data, 6);
+      if (dataSize == 4 || dataSize == 6) {
+        currentSpineIndex = data[0] + (data[1] << 8);
+        nextPageNumber = data[2] + (data[3] << 8);
+        cachedSpineIndex = currentSpineIndex;
+        Serial.printf("[%lu] [ERS] Loaded cache: %d, %d\n", millis(), currentSpineIndex, nextPageNumber);
+      }
+      if (dataSize == 6) {
+        cachedChapterTotalPageCount = data[4] + (data[5] << 8);
+      }
+      f.close();
     }
-    f.close();
   }
   // We may want a better condition to detect if we are opening for the first time.
   // This will trigger if the book is re-opened at Chapter 0.
@@ -84,8 +224,10 @@ void EpubReaderActivity::onEnter() {
 
   // Save current epub as last opened epub and add to recent books
   APP_STATE.openEpubPath = epub->getPath();
-  APP_STATE.saveToFile();
+  APP_STATE.markDirty();
   RECENT_BOOKS.addBook(epub->getPath(), epub->getTitle(), epub->getAuthor());
+  READING_STATS.beginSession(epub->getPath());
+  CACHE_GC.noteCacheUsed(epub->getCachePath());
 
   // Trigger first update
   updateRequired = true;
@@ -96,6 +238,37 @@ void EpubReaderActivity::onEnter() {
               1,                  // Priority
               &displayTaskHandle  // Task handle
   );
+
+  // Low-priority task that pre-paginates the adjacent spine items while the user is reading
+  prePaginateAbort = false;
+  xTaskCreate(&EpubReaderActivity::prePaginateTaskTrampoline, "EpubPrePaginateTask",
+              8192,                   // Stack size
+              this,                   // Parameters
+              0,                      // Priority (below display task so rendering always wins)
+              &prePaginateTaskHandle  // Task handle
+  );
+
+  // Under memory pressure the prefetched neighbour sections are the first thing to go - the
+  // pre-paginate task rebuilds them when the heap recovers. CRITICAL also drops the expanded
+  // glyph cache. Runs on whichever task hit pressure, so it skips rather than stalls behind an
+  // in-flight render.
+  HEAP_MON.registerReclaimer("reader-prefetch", [this](const HeapMonitor::Pressure level) -> size_t {
+    if (renderingMutex == nullptr || xSemaphoreTake(renderingMutex, pdMS_TO_TICKS(50)) != pdTRUE) {
+      return 0;
+    }
+    const uint32_t before = ESP.getFreeHeap();
+    prefetchedNext.reset();
+    prefetchedPrev.reset();
+    free(specBuffer);
+    specBuffer = nullptr;
+    specPage = -1;
+    if (level == HeapMonitor::Pressure::CRITICAL) {
+      renderer.clearGlyphCache();
+    }
+    const uint32_t after = ESP.getFreeHeap();
+    xSemaphoreGive(renderingMutex);
+    return after > before ? after - before : 0;
+  });
 }
 
 void EpubReaderActivity::onExit() {
@@ -104,15 +277,50 @@ void EpubReaderActivity::onExit() {
   // Reset orientation back to portrait for the rest of the UI
   renderer.setOrientation(GfxRenderer::Orientation::Portrait);
 
+  // Unregister before tearing down the mutex the reclaimer takes
+  HEAP_MON.unregisterReclaimer("reader-prefetch");
+
   // Wait until not rendering to delete task to avoid killing mid-instruction to EPD
+  prePaginateAbort = true;
   xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  if (prePaginateTaskHandle) {
+    vTaskDelete(prePaginateTaskHandle);
+    prePaginateTaskHandle = nullptr;
+  }
   if (displayTaskHandle) {
     vTaskDelete(displayTaskHandle);
     displayTaskHandle = nullptr;
   }
   vSemaphoreDelete(renderingMutex);
   renderingMutex = nullptr;
+  // Release the 48KB frame shadow; the rest of the UI doesn't need differential flushes
+  renderer.setFrameShadowEnabled(false);
+  saveResumeManifest();
+  // Record final progress on the recent-books entry; this is also its write-behind flush point
+  if (epub) {
+    const float sectionProg =
+        section && section->pageCount > 0 ? static_cast<float>(section->currentPage) / section->pageCount : 0.0f;
+    RECENT_BOOKS.updateProgress(epub->getPath(),
+                                static_cast<uint8_t>(epub->calculateProgress(currentSpineIndex, sectionProg) * 100));
+  }
+  RECENT_BOOKS.flushIfDirty();
+  // Fold this reading session into the stats rows; persisted by the sleep-path flush
+  READING_STATS.endSession();
+  // Queue the final position for KOReader sync; it gets pushed next time WiFi is up
+  if (epub && section && KOREADER_STORE.hasCredentials()) {
+    const std::string documentHash =
+        KOREADER_STORE.getMatchMethod() == DocumentMatchMethod::FILENAME
+            ? KOReaderDocumentId::calculateFromFilename(epub->getPath())
+            : KOReaderDocumentId::calculateCached(epub->getPath(), epub->getCachePath());
+    const CrossPointPosition localPos = {currentSpineIndex, section->currentPage, section->pageCount};
+    const KOReaderPosition koPos = ProgressMapper::toKOReader(epub, localPos);
+    KOSYNC_QUEUE.enqueue(documentHash, koPos.xpath, koPos.percentage);
+  }
   section.reset();
+  prefetchedNext.reset();
+  prefetchedPrev.reset();
+  free(specBuffer);
+  specBuffer = nullptr;
   epub.reset();
 }
 
@@ -123,15 +331,58 @@ void EpubReaderActivity::loop() {
     return;
   }
 
-  // Enter chapter selection activity
+  if (mappedInput.wasAnyPressed() || mappedInput.wasAnyReleased()) {
+    lastInputAt = millis();
+  }
+
+  // Quality settle: once the reader has dwelt on a turbo-flushed page, re-render it through the
+  // forceFullRefresh path. That pushes the identical page with the quality waveform, cleaning
+  // the turbo residue, and resets the ghosting budget so the following turns are turbo again.
+  if (settlePending && !updateRequired && section) {
+    const unsigned long now = millis();
+    if (now - settleFlushAt >= settleDwellMs && now - lastInputAt >= settleDwellMs) {
+      settlePending = false;
+      forceFullRefresh = true;
+      updateRequired = true;
+    }
+  }
+
+  // Skim release: the flipping stopped, so paint the landing page at full quality
+  if (skimming && millis() - lastTurnAt >= skimExitDwellMs) {
+    Serial.printf("[%lu] [ERS] Skim released at chapter %d page %d\n", millis(), currentSpineIndex,
+                  section ? section->currentPage : 0);
+    skimming = false;
+    skimStreak = 0;
+    skimStripRequired = false;
+    forceFullRefresh = true;
+    updateRequired = true;
+  }
+
+  // Confirm: long press toggles a bookmark on the current page, short press
+  // enters the chapter selection activity
   if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
+    if (mappedInput.getHeldTime() > skipChapterMs) {
+      if (section && section->pageCount > 0) {
+        const bool added = annotations.toggleBookmark(static_cast<uint16_t>(currentSpineIndex),
+                                                      static_cast<uint16_t>(section->currentPage));
+        Serial.printf("[%lu] [ERS] %s bookmark at %d:%d\n", millis(), added ? "Added" : "Removed", currentSpineIndex,
+                      section->currentPage);
+        updateRequired = true;  // Repaint for the corner marker
+      }
+      return;
+    }
     // Don't start activity transition while rendering
+    prePaginateAbort = true;
     xSemaphoreTake(renderingMutex, portMAX_DELAY);
     const int currentPage = section ? section->currentPage : 0;
     const int totalPages = section ? section->pageCount : 0;
+    const uint32_t layoutKey = Section::layoutKey(
+        SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+        SETTINGS.paragraphAlignment, lastViewportWidth, lastViewportHeight, SETTINGS.hyphenationEnabled,
+        SETTINGS.optimalLineBreaks);
     exitActivity();
     enterNewActivity(new EpubReaderChapterSelectionActivity(
-        this->renderer, this->mappedInput, epub, epub->getPath(), currentSpineIndex, currentPage, totalPages,
+        this->renderer, this->mappedInput, epub, epub->getPath(), layoutKey, currentSpineIndex, currentPage, totalPages,
         [this] {
           exitActivity();
           updateRequired = true;
@@ -156,6 +407,7 @@ void EpubReaderActivity::loop() {
           updateRequired = true;
         }));
     xSemaphoreGive(renderingMutex);
+    prePaginateAbort = false;
   }
 
   // Long press BACK (1s+) goes directly to home
@@ -172,14 +424,18 @@ void EpubReaderActivity::loop() {
 
   // When long-press chapter skip is disabled, turn pages on press instead of release.
   const bool usePressForPageTurn = !SETTINGS.longPressChapterSkip;
-  const bool prevTriggered = usePressForPageTurn ? (mappedInput.wasPressed(MappedInputManager::Button::PageBack) ||
-                                                    mappedInput.wasPressed(MappedInputManager::Button::Left))
+  // Press-to-turn drains the coalesced page-turn queue (which includes hold-to-repeat events);
+  // release mode keeps the raw edges so held time can still mean chapter skip
+  const uint8_t queuedPrev = usePressForPageTurn ? mappedInput.takePageTurns(MappedInputManager::Button::PageBack) : 0;
+  const uint8_t queuedNext =
+      usePressForPageTurn ? mappedInput.takePageTurns(MappedInputManager::Button::PageForward) : 0;
+  const bool prevTriggered = usePressForPageTurn ? (queuedPrev > 0 || mappedInput.wasPressed(MappedInputManager::Button::Left))
                                                  : (mappedInput.wasReleased(MappedInputManager::Button::PageBack) ||
                                                     mappedInput.wasReleased(MappedInputManager::Button::Left));
   const bool powerPageTurn = SETTINGS.shortPwrBtn == CrossPointSettings::SHORT_PWRBTN::PAGE_TURN &&
                              mappedInput.wasReleased(MappedInputManager::Button::Power);
   const bool nextTriggered = usePressForPageTurn
-                                 ? (mappedInput.wasPressed(MappedInputManager::Button::PageForward) || powerPageTurn ||
+                                 ? (queuedNext > 0 || powerPageTurn ||
                                     mappedInput.wasPressed(MappedInputManager::Button::Right))
                                  : (mappedInput.wasReleased(MappedInputManager::Button::PageForward) || powerPageTurn ||
                                     mappedInput.wasReleased(MappedInputManager::Button::Right));
@@ -200,11 +456,13 @@ void EpubReaderActivity::loop() {
 
   if (skipChapter) {
     // We don't want to delete the section mid-render, so grab the semaphore
+    prePaginateAbort = true;
     xSemaphoreTake(renderingMutex, portMAX_DELAY);
     nextPageNumber = 0;
     currentSpineIndex = nextTriggered ? currentSpineIndex + 1 : currentSpineIndex - 1;
     section.reset();
     xSemaphoreGive(renderingMutex);
+    prePaginateAbort = false;
     updateRequired = true;
     return;
   }
@@ -215,50 +473,288 @@ void EpubReaderActivity::loop() {
     return;
   }
 
+  // O(1) in-RAM accumulation; folded into the stats file on exit/sleep
+  READING_STATS.notePageTurn();
+
+  // Skim detection: a streak of turns under the gap means the user is flipping, not reading
+  {
+    const unsigned long now = millis();
+    skimStreak = (now - lastTurnAt < skimEnterGapMs) ? skimStreak + 1 : 1;
+    lastTurnAt = now;
+    if (!skimming && skimStreak >= skimEnterTurns) {
+      Serial.printf("[%lu] [ERS] Skim mode on\n", millis());
+      skimming = true;
+      skimPagesSinceRender = 0;
+    }
+  }
+  // Skim turns are deliberately cheap frames; sampling them would poison the latency stats
+  if (!skimming) {
+    // Start (or continue) an input-to-photon sample for this turn
+    TURN_LATENCY.noteTurnAccepted();
+  }
+
+  // Within-chapter skim turns paint only every Nth page; the rest get the progress strip
+  const auto noteSkimTurn = [this](const int steps) {
+    if (!skimming) {
+      updateRequired = true;
+      return;
+    }
+    skimPagesSinceRender += steps;
+    if (skimPagesSinceRender >= skimFullRenderEvery) {
+      skimPagesSinceRender = 0;
+      updateRequired = true;
+    } else {
+      skimStripRequired = true;
+    }
+  };
+
   if (prevTriggered) {
     if (section->currentPage > 0) {
-      section->currentPage--;
+      // Coalesced queue turns land as one jump, clamped to the chapter
+      const int steps = queuedPrev > 1 ? queuedPrev : 1;
+      section->currentPage = section->currentPage > steps ? section->currentPage - steps : 0;
+      noteSkimTurn(steps);
+      return;
     } else {
       // We don't want to delete the section mid-render, so grab the semaphore
+      prePaginateAbort = true;
       xSemaphoreTake(renderingMutex, portMAX_DELAY);
       nextPageNumber = UINT16_MAX;
       currentSpineIndex--;
       section.reset();
       xSemaphoreGive(renderingMutex);
+      prePaginateAbort = false;
+      skimPagesSinceRender = 0;  // Chapter crossings always paint
     }
     updateRequired = true;
   } else {
     if (section->currentPage < section->pageCount - 1) {
-      section->currentPage++;
+      const int steps = queuedNext > 1 ? queuedNext : 1;
+      const int lastPage = section->pageCount - 1;
+      section->currentPage = section->currentPage + steps < lastPage ? section->currentPage + steps : lastPage;
+      noteSkimTurn(steps);
+      return;
     } else {
       // We don't want to delete the section mid-render, so grab the semaphore
+      prePaginateAbort = true;
       xSemaphoreTake(renderingMutex, portMAX_DELAY);
       nextPageNumber = 0;
       currentSpineIndex++;
       section.reset();
       xSemaphoreGive(renderingMutex);
+      prePaginateAbort = false;
+      skimPagesSinceRender = 0;  // Chapter crossings always paint
     }
     updateRequired = true;
   }
 }
 
+void EpubReaderActivity::ensurePageTable(const uint32_t layoutKey) {
+  if (pageTableLayoutKey == layoutKey) {
+    return;
+  }
+  pageTable.load(Section::pageTablePath(*epub, layoutKey), epub->getSpineItemsCount());
+  pageTableLayoutKey = layoutKey;
+}
+
+void EpubReaderActivity::prePaginateTaskLoop() {
+  while (true) {
+    vTaskDelay(prePaginateIdleMs / portTICK_PERIOD_MS);
+
+    // Only work when the reader is idle and we know the viewport from a previous build
+    if (updateRequired || subActivity || prePaginateAbort || lastViewportWidth == 0) {
+      continue;
+    }
+
+    // Next page first: it's the frame most likely to be asked for by the very next input
+    buildSpeculativePage();
+    if (updateRequired || subActivity || prePaginateAbort) {
+      continue;
+    }
+
+    // Speculatively build the section files for the next and previous spine items so crossing a
+    // chapter boundary doesn't stall on a multi-second pagination pass
+    for (const int offset : {1, -1}) {
+      const int targetSpineIndex = currentSpineIndex + offset;
+      if (targetSpineIndex < 0 || targetSpineIndex >= epub->getSpineItemsCount()) {
+        continue;
+      }
+      if (updateRequired || subActivity || prePaginateAbort) {
+        break;
+      }
+
+      // Give way if the display task is mid-render before contending for the mutex
+      SD_SCHED.yieldToUi();
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      if (!updateRequired && !subActivity && !prePaginateAbort) {
+        const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::PREFETCH);
+        const uint32_t layoutKey = Section::layoutKey(
+            SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+            SETTINGS.paragraphAlignment, lastViewportWidth, lastViewportHeight, SETTINGS.hyphenationEnabled,
+            SETTINGS.optimalLineBreaks);
+        auto candidate = std::unique_ptr<Section>(new Section(epub, targetSpineIndex, renderer, layoutKey));
+        bool ready = candidate->loadSectionFile(
+            SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+            SETTINGS.paragraphAlignment, lastViewportWidth, lastViewportHeight, SETTINGS.hyphenationEnabled,
+            SETTINGS.optimalLineBreaks);
+        if (!ready) {
+          Serial.printf("[%lu] [ERS] Pre-paginating spine index %d\n", millis(), targetSpineIndex);
+          const PowerGovernor::Lease powerLease;  // CPU-bound: inflate + parse + layout
+          ready = candidate->createSectionFile(
+              SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+              SETTINGS.paragraphAlignment, lastViewportWidth, lastViewportHeight, SETTINGS.hyphenationEnabled,
+              SETTINGS.optimalLineBreaks, nullptr, nullptr,
+              [this] { return updateRequired || subActivity != nullptr || prePaginateAbort; });
+        }
+
+        if (ready) {
+          ensurePageTable(layoutKey);
+          pageTable.setPageCount(targetSpineIndex, candidate->pageCount);
+        }
+
+        // Keep both neighbours resident with their boundary page already deserialized: page 0 of
+        // the next chapter and the last page of the previous one, so crossing a chapter boundary
+        // in either direction swaps in from RAM instead of going back to the SD card
+        PrefetchedSection& slot = offset == 1 ? prefetchedNext : prefetchedPrev;
+        if (ready && targetSpineIndex != slot.spineIndex) {
+          // Preloaded pages live in the shared page arena too; both tasks only touch it with
+          // renderingMutex held
+          const ParseArena::Scope pageArenaScope(pageArena);
+          const int boundaryPage = offset == 1 ? 0 : candidate->pageCount - 1;
+          if (candidate->preloadPage(boundaryPage)) {
+            slot.section = std::move(candidate);
+            slot.spineIndex = targetSpineIndex;
+          }
+        }
+      }
+      xSemaphoreGive(renderingMutex);
+    }
+
+    // With the neighbours warm, keep paginating the rest of the book one chapter per idle wake
+    // so the status bar can graduate from interpolated progress to real book-wide page numbers
+    if (updateRequired || subActivity || prePaginateAbort) {
+      continue;
+    }
+    SD_SCHED.yieldToUi();
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    if (!updateRequired && !subActivity && !prePaginateAbort) {
+      const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::PREFETCH);
+      const uint32_t layoutKey = Section::layoutKey(
+          SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+          SETTINGS.paragraphAlignment, lastViewportWidth, lastViewportHeight, SETTINGS.hyphenationEnabled,
+          SETTINGS.optimalLineBreaks);
+      ensurePageTable(layoutKey);
+      const int targetSpineIndex = pageTable.firstUnknownSpine();
+      if (targetSpineIndex != -1) {
+        auto candidate = std::unique_ptr<Section>(new Section(epub, targetSpineIndex, renderer, layoutKey));
+        bool ready = candidate->loadSectionFile(
+            SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+            SETTINGS.paragraphAlignment, lastViewportWidth, lastViewportHeight, SETTINGS.hyphenationEnabled,
+            SETTINGS.optimalLineBreaks);
+        if (!ready) {
+          Serial.printf("[%lu] [ERS] Paginating spine index %d for the page table\n", millis(), targetSpineIndex);
+          const PowerGovernor::Lease powerLease;
+          ready = candidate->createSectionFile(
+              SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+              SETTINGS.paragraphAlignment, lastViewportWidth, lastViewportHeight, SETTINGS.hyphenationEnabled,
+              SETTINGS.optimalLineBreaks, nullptr, nullptr,
+              [this] { return updateRequired || subActivity != nullptr || prePaginateAbort; });
+        }
+        if (ready && pageTable.setPageCount(targetSpineIndex, candidate->pageCount) && pageTable.isComplete()) {
+          Serial.printf("[%lu] [ERS] Page table complete: %lu pages\n", millis(),
+                        static_cast<unsigned long>(pageTable.totalPages()));
+          updateRequired = true;  // Repaint the status bar with real page numbers
+        }
+      }
+    }
+    xSemaphoreGive(renderingMutex);
+  }
+}
+
+bool EpubReaderActivity::isIdle() {
+  if (subActivity) {
+    return subActivity->isIdle();
+  }
+  if (updateRequired || settlePending || !section || lastViewportWidth == 0) {
+    return false;
+  }
+  // A held rendering mutex means the display task or a background build is mid-flight
+  if (xSemaphoreTake(renderingMutex, 0) != pdTRUE) {
+    return false;
+  }
+  // Idle only once the pre-paginate task has nothing left: both neighbours resident and the
+  // book-wide page table filled in. Light sleep halts its task, so declaring idle while it
+  // still has chapters to build would starve it down to the wake duty cycle.
+  const bool nextWarm =
+      currentSpineIndex + 1 >= epub->getSpineItemsCount() || prefetchedNext.spineIndex == currentSpineIndex + 1;
+  const bool prevWarm = currentSpineIndex <= 0 || prefetchedPrev.spineIndex == currentSpineIndex - 1;
+  const bool tableDone = pageTableLayoutKey != 0 && pageTable.isComplete();
+  xSemaphoreGive(renderingMutex);
+  return nextWarm && prevWarm && tableDone;
+}
+
 void EpubReaderActivity::displayTaskLoop() {
   while (true) {
     if (updateRequired) {
       updateRequired = false;
+      skimStripRequired = false;  // The full paint supersedes any pending strip
       xSemaphoreTake(renderingMutex, portMAX_DELAY);
       renderScreen();
       xSemaphoreGive(renderingMutex);
+    } else if (skimStripRequired) {
+      skimStripRequired = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      renderSkimStrip();
+      xSemaphoreGive(renderingMutex);
     }
     vTaskDelay(10 / portTICK_PERIOD_MS);
   }
 }
 
+// Skim-mode feedback frame: a position strip stamped over the stale page instead of a full
+// paint. Everything on it comes from RAM (the section header and the whole-book page table),
+// so the cost is a couple of text blits and a turbo flush - no SD page load, no body render.
+void EpubReaderActivity::renderSkimStrip() {
+  if (!section || section->pageCount == 0) {
+    return;
+  }
+  // The strip writes the framebuffer directly, so wait out any in-flight async flush
+  renderer.waitForDisplayFlush();
+
+  constexpr int stripWidth = 320;
+  constexpr int stripHeight = 76;
+  const int x = (renderer.getScreenWidth() - stripWidth) / 2;
+  const int y = renderer.getScreenHeight() - stripHeight - 44;
+
+  renderer.fillRect(x, y, stripWidth, stripHeight, false);
+  renderer.drawRect(x + 2, y + 2, stripWidth - 4, stripHeight - 4);
+
+  char line[48];
+  snprintf(line, sizeof(line), "Chapter %d of %d", currentSpineIndex + 1, epub->getSpineItemsCount());
+  renderer.drawCenteredText(UI_10_FONT_ID, y + 12, line, true, EpdFontFamily::BOLD);
+  if (pageTableLayoutKey != 0 && pageTable.isComplete()) {
+    // Book-wide position via the cached per-chapter page counts
+    snprintf(line, sizeof(line), "Page %lu of %lu",
+             static_cast<unsigned long>(pageTable.pagesBefore(currentSpineIndex) + section->currentPage + 1),
+             static_cast<unsigned long>(pageTable.totalPages()));
+  } else {
+    snprintf(line, sizeof(line), "Page %d of %d", section->currentPage + 1, section->pageCount);
+  }
+  renderer.drawCenteredText(UI_10_FONT_ID, y + 42, line);
+
+  // Turbo flush: the strip smears over page content, so the release paint settles at quality
+  renderer.displayBufferAsync(HalDisplay::TURBO_REFRESH);
+  forceFullRefresh = true;
+}
+
 // TODO: Failure handling
 void EpubReaderActivity::renderScreen() {
+  TRACE_SCOPE("EpubReaderActivity::renderScreen");
   if (!epub) {
     return;
   }
+  // The user is waiting on this paint; background SD writers give way until it's out
+  const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::UI);
 
   // edge case handling for sub-zero spine index
   if (currentSpineIndex < 0) {
@@ -279,33 +775,61 @@ void EpubReaderActivity::renderScreen() {
 
   // Apply screen viewable areas and additional padding
   int orientedMarginTop, orientedMarginRight, orientedMarginBottom, orientedMarginLeft;
-  renderer.getOrientedViewableTRBL(&orientedMarginTop, &orientedMarginRight, &orientedMarginBottom,
-                                   &orientedMarginLeft);
-  orientedMarginTop += SETTINGS.screenMargin;
-  orientedMarginLeft += SETTINGS.screenMargin;
-  orientedMarginRight += SETTINGS.screenMargin;
-  orientedMarginBottom += SETTINGS.screenMargin;
-
-  // Add status bar margin
-  if (SETTINGS.statusBar != CrossPointSettings::STATUS_BAR_MODE::NONE) {
-    // Add additional margin for status bar if progress bar is shown
-    const bool showProgressBar = SETTINGS.statusBar == CrossPointSettings::STATUS_BAR_MODE::FULL_WITH_PROGRESS_BAR ||
-                                 SETTINGS.statusBar == CrossPointSettings::STATUS_BAR_MODE::ONLY_PROGRESS_BAR;
-    orientedMarginBottom += statusBarMargin - SETTINGS.screenMargin +
-                            (showProgressBar ? (ScreenComponents::BOOK_PROGRESS_BAR_HEIGHT + progressBarMarginTop) : 0);
-  }
+  computeOrientedMargins(orientedMarginTop, orientedMarginRight, orientedMarginBottom, orientedMarginLeft);
 
   if (!section) {
     const auto filepath = epub->getSpineItem(currentSpineIndex).href;
     Serial.printf("[%lu] [ERS] Loading file: %s, index: %d\n", millis(), filepath.c_str(), currentSpineIndex);
-    section = std::unique_ptr<Section>(new Section(epub, currentSpineIndex, renderer));
 
     const uint16_t viewportWidth = renderer.getScreenWidth() - orientedMarginLeft - orientedMarginRight;
     const uint16_t viewportHeight = renderer.getScreenHeight() - orientedMarginTop - orientedMarginBottom;
 
-    if (!section->loadSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
+    // Remember the viewport so the pre-paginate task builds byte-identical section files
+    lastViewportWidth = viewportWidth;
+    lastViewportHeight = viewportHeight;
+
+    // The idle prefetch may have this chapter ready with its boundary page already in RAM
+    if (prefetchedNext.section && prefetchedNext.spineIndex == currentSpineIndex) {
+      Serial.printf("[%lu] [ERS] Using prefetched section, skipping SD load\n", millis());
+      section = std::move(prefetchedNext.section);
+      prefetchedNext.reset();
+    } else if (prefetchedPrev.section && prefetchedPrev.spineIndex == currentSpineIndex) {
+      Serial.printf("[%lu] [ERS] Using prefetched section, skipping SD load\n", millis());
+      section = std::move(prefetchedPrev.section);
+      prefetchedPrev.reset();
+    } else {
+      const uint32_t layoutKey = Section::layoutKey(
+          SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+          SETTINGS.paragraphAlignment, viewportWidth, viewportHeight, SETTINGS.hyphenationEnabled,
+          SETTINGS.optimalLineBreaks);
+      section = std::unique_ptr<Section>(new Section(epub, currentSpineIndex, renderer, layoutKey));
+    }
+
+    // Prefetched sections arrive with their header already parsed
+    bool alreadyLoaded = section->pageCount > 0;
+
+    // A resume manifest from the last clean exit carries the section header state and page
+    // offset, so the first paint skips the header and LUT reads entirely
+    if (!alreadyLoaded && resumeManifestLoaded && resumeManifest.spineIndex == currentSpineIndex &&
+        resumeManifest.fontId == SETTINGS.getReaderFontId() &&
+        resumeManifest.lineCompression == SETTINGS.getReaderLineCompression() &&
+        resumeManifest.extraParagraphSpacing == static_cast<bool>(SETTINGS.extraParagraphSpacing) &&
+        resumeManifest.paragraphAlignment == SETTINGS.paragraphAlignment &&
+        resumeManifest.viewportWidth == viewportWidth && resumeManifest.viewportHeight == viewportHeight &&
+        resumeManifest.hyphenationEnabled == static_cast<bool>(SETTINGS.hyphenationEnabled) &&
+        resumeManifest.optimalLineBreaks == static_cast<bool>(SETTINGS.optimalLineBreaks)) {
+      alreadyLoaded = section->restoreFromManifest(resumeManifest.chapterPageCount, resumeManifest.lutOffset,
+                                                   resumeManifest.page, resumeManifest.pagePos);
+      if (alreadyLoaded) {
+        Serial.printf("[%lu] [ERS] Restored section state from resume manifest\n", millis());
+      }
+    }
+    resumeManifestLoaded = false;  // Only valid for the first section load after opening
+
+    if (!alreadyLoaded &&
+        !section->loadSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
                                   SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
-                                  viewportHeight, SETTINGS.hyphenationEnabled)) {
+                                  viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.optimalLineBreaks)) {
       Serial.printf("[%lu] [ERS] Cache not found, building...\n", millis());
 
       // Progress bar dimensions
@@ -325,11 +849,13 @@ void EpubReaderActivity::renderScreen() {
 
       // Always show "Indexing..." text first
       {
+        // fillRect writes the framebuffer directly, so wait out any in-flight async flush
+        renderer.waitForDisplayFlush();
         renderer.fillRect(boxXNoBar, boxY, boxWidthNoBar, boxHeightNoBar, false);
         renderer.drawText(UI_12_FONT_ID, boxXNoBar + boxMargin, boxY + boxMargin, "Indexing...");
         renderer.drawRect(boxXNoBar + 5, boxY + 5, boxWidthNoBar - 10, boxHeightNoBar - 10);
         renderer.displayBuffer();
-        pagesUntilFullRefresh = 0;
+        forceFullRefresh = true;
       }
 
       // Setup callback - only called for chapters >= 50KB, redraws with progress bar
@@ -345,12 +871,14 @@ void EpubReaderActivity::renderScreen() {
       auto progressCallback = [this, barX, barY, barWidth, barHeight](int progress) {
         const int fillWidth = (barWidth - 2) * progress / 100;
         renderer.fillRect(barX + 1, barY + 1, fillWidth, barHeight - 2, true);
-        renderer.displayBuffer(HalDisplay::FAST_REFRESH);
+        renderer.displayDirty();
       };
 
+      const PowerGovernor::Lease powerLease;  // The user is watching the indexing bar; build at full clock
       if (!section->createSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
                                       SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
-                                      viewportHeight, SETTINGS.hyphenationEnabled, progressSetup, progressCallback)) {
+                                      viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.optimalLineBreaks,
+                                      progressSetup, progressCallback)) {
         Serial.printf("[%lu] [ERS] Failed to persist page data to SD\n", millis());
         section.reset();
         return;
@@ -359,19 +887,22 @@ void EpubReaderActivity::renderScreen() {
       Serial.printf("[%lu] [ERS] Cache found, skipping build...\n", millis());
     }
 
-    if (nextPageNumber == UINT16_MAX) {
-      section->currentPage = section->pageCount - 1;
-    } else {
-      section->currentPage = nextPageNumber;
-    }
+    // Feed the whole-book page table so on-demand loads count towards completing it
+    ensurePageTable(Section::layoutKey(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
+                                       SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
+                                       viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.optimalLineBreaks));
+    pageTable.setPageCount(currentSpineIndex, section->pageCount);
+
+    const int restoredPage = nextPageNumber == UINT16_MAX ? section->pageCount - 1 : nextPageNumber;
+    section->seekToPage(restoredPage);
 
     // handles changes in reader settings and reset to approximate position based on cached progress
     if (cachedChapterTotalPageCount > 0) {
       // only goes to relative position if spine index matches cached value
       if (currentSpineIndex == cachedSpineIndex && section->pageCount != cachedChapterTotalPageCount) {
-        float progress = static_cast<float>(section->currentPage) / static_cast<float>(cachedChapterTotalPageCount);
-        int newPage = static_cast<int>(progress * section->pageCount);
-        section->currentPage = newPage;
+        // restoredPage is in units of the cached page count, so compute the ratio before clamping
+        const float progress = static_cast<float>(restoredPage) / static_cast<float>(cachedChapterTotalPageCount);
+        section->seekToPage(static_cast<int>(progress * section->pageCount));
       }
       cachedChapterTotalPageCount = 0;  // resets to 0 to prevent reading cached progress again
     }
@@ -395,7 +926,20 @@ void EpubReaderActivity::renderScreen() {
     return;
   }
 
-  {
+  if (specBuffer && specSpineIndex == currentSpineIndex && specPage == section->currentPage) {
+    // The dwell speculation already painted this exact frame: the turn is a buffer swap plus
+    // flush, with no SD page load or glyph blit on the path. Speculation is disabled under
+    // anti-aliasing, so no grayscale passes are owed here.
+    renderer.waitForDisplayFlush();
+    memcpy(renderer.getFrameBuffer(), specBuffer, GfxRenderer::getBufferSize());
+    renderer.markFullScreenDirty();
+    specPage = -1;  // Consumed; the next dwell rebuilds for the new N+1
+    TURN_LATENCY.notePageLoaded();
+    TURN_LATENCY.noteRenderDone();
+    flushTurnBuffer();
+  } else {
+    // Page storage comes from the recycled arena; freed back to it when `p` dies below
+    const ParseArena::Scope pageArenaScope(pageArena);
     auto p = section->loadPageFromSectionFile();
     if (!p) {
       Serial.printf("[%lu] [ERS] Failed to load page from SD - clearing section cache\n", millis());
@@ -403,6 +947,7 @@ void EpubReaderActivity::renderScreen() {
       section.reset();
       return renderScreen();
     }
+    TURN_LATENCY.notePageLoaded();
     const auto start = millis();
     renderContents(std::move(p), orientedMarginTop, orientedMarginRight, orientedMarginBottom, orientedMarginLeft);
     Serial.printf("[%lu] [ERS] Rendered page in %dms\n", millis(), millis() - start);
@@ -427,13 +972,17 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
                                         const int orientedMarginLeft) {
   page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
   renderStatusBar(orientedMarginRight, orientedMarginBottom, orientedMarginLeft);
-  if (pagesUntilFullRefresh <= 1) {
-    renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-    pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
-  } else {
-    renderer.displayBuffer();
-    pagesUntilFullRefresh--;
+  // Bit-filter test; the common unannotated page costs nothing on the paint path
+  if (section && annotations.hasAnnotations(static_cast<uint16_t>(currentSpineIndex),
+                                            static_cast<uint16_t>(section->currentPage))) {
+    drawAnnotationMarker(orientedMarginTop, orientedMarginRight);
+  }
+  if (SETTINGS.turnLatencyOverlay) {
+    drawLatencyOverlay(orientedMarginTop, orientedMarginLeft);
   }
+  // Framebuffer complete; everything past here is getting it onto glass
+  TURN_LATENCY.noteRenderDone();
+  flushTurnBuffer();
 
   // Save bw buffer to reset buffer state after grayscale data sync
   renderer.storeBwBuffer();
@@ -441,26 +990,198 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   // grayscale rendering
   // TODO: Only do this if font supports it
   if (SETTINGS.textAntiAliasing) {
-    renderer.clearScreen(0x00);
-    renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
-    page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
-    renderer.copyGrayscaleLsbBuffers();
-
-    // Render and copy to MSB buffer
-    renderer.clearScreen(0x00);
-    renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
-    page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
-    renderer.copyGrayscaleMsbBuffers();
-
-    // display grayscale part
-    renderer.displayGrayBuffer();
-    renderer.setRenderMode(GfxRenderer::BW);
+    if (renderer.beginGrayscalePass()) {
+      // One traversal writes both gray planes
+      page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+      renderer.flushGrayscalePass();
+    } else {
+      renderer.clearScreen(0x00);
+      renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
+      page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+      renderer.copyGrayscaleLsbBuffers();
+
+      // Render and copy to MSB buffer
+      renderer.clearScreen(0x00);
+      renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
+      page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+      renderer.copyGrayscaleMsbBuffers();
+
+      // display grayscale part
+      renderer.displayGrayBuffer();
+      renderer.setRenderMode(GfxRenderer::BW);
+    }
   }
 
   // restore the bw data
   renderer.restoreBwBuffer();
 }
 
+// Flush on the background task: the remaining work on the turn path (storing the BW buffer,
+// saving progress) and the next page's SD loads run while the panel is still refreshing.
+// Anything that writes to the framebuffer again waits for the flush via HalDisplay.
+// Deghost once the accumulated change since the last flash crosses the budget, instead of on
+// a fixed page count. The refresh-frequency setting scales the budget: N means "flash every N
+// dense text pages", so text-light pages earn extra fast turns between flashes.
+void EpubReaderActivity::flushTurnBuffer() {
+  const size_t ghostingBudget = static_cast<size_t>(SETTINGS.getRefreshFrequency()) * GHOSTING_BYTES_PER_PAGE;
+  ghostedBytes += renderer.pendingFlushDiffBytes();
+  turboTurns++;
+  if (forceFullRefresh || ghostedBytes >= ghostingBudget || turboTurns >= MAX_TURBO_TURNS) {
+    renderer.displayBufferAsync(HalDisplay::HALF_REFRESH);
+    ghostedBytes = 0;
+    turboTurns = 0;
+    forceFullRefresh = false;
+    settlePending = false;  // The screen is clean; nothing for the dwell settle to do
+  } else {
+    renderer.displayBufferAsync(HalDisplay::TURBO_REFRESH);
+    // Phase one of the two-phase policy; loop() schedules the quality settle on dwell
+    settlePending = true;
+    settleFlushAt = millis();
+  }
+}
+
+void EpubReaderActivity::computeOrientedMargins(int& top, int& right, int& bottom, int& left) const {
+  renderer.getOrientedViewableTRBL(&top, &right, &bottom, &left);
+  top += SETTINGS.screenMargin;
+  left += SETTINGS.screenMargin;
+  right += SETTINGS.screenMargin;
+  bottom += SETTINGS.screenMargin;
+
+  // Add status bar margin
+  if (SETTINGS.statusBar != CrossPointSettings::STATUS_BAR_MODE::NONE) {
+    // Add additional margin for status bar if progress bar is shown
+    const bool showProgressBar = SETTINGS.statusBar == CrossPointSettings::STATUS_BAR_MODE::FULL_WITH_PROGRESS_BAR ||
+                                 SETTINGS.statusBar == CrossPointSettings::STATUS_BAR_MODE::ONLY_PROGRESS_BAR;
+    bottom += statusBarMargin - SETTINGS.screenMargin +
+              (showProgressBar ? (ScreenComponents::BOOK_PROGRESS_BAR_HEIGHT + progressBarMarginTop) : 0);
+  }
+}
+
+void EpubReaderActivity::currentLayoutViewport(GfxRenderer& renderer, uint16_t& width, uint16_t& height) {
+  // Same orientation mapping as onEnter; sections built against any other viewport would land
+  // in a layout namespace the reader never opens
+  switch (SETTINGS.orientation) {
+    case CrossPointSettings::ORIENTATION::LANDSCAPE_CW:
+      renderer.setOrientation(GfxRenderer::Orientation::LandscapeClockwise);
+      break;
+    case CrossPointSettings::ORIENTATION::INVERTED:
+      renderer.setOrientation(GfxRenderer::Orientation::PortraitInverted);
+      break;
+    case CrossPointSettings::ORIENTATION::LANDSCAPE_CCW:
+      renderer.setOrientation(GfxRenderer::Orientation::LandscapeCounterClockwise);
+      break;
+    default:
+      renderer.setOrientation(GfxRenderer::Orientation::Portrait);
+      break;
+  }
+
+  int top, right, bottom, left;
+  renderer.getOrientedViewableTRBL(&top, &right, &bottom, &left);
+  top += SETTINGS.screenMargin;
+  left += SETTINGS.screenMargin;
+  right += SETTINGS.screenMargin;
+  bottom += SETTINGS.screenMargin;
+  if (SETTINGS.statusBar != CrossPointSettings::STATUS_BAR_MODE::NONE) {
+    const bool showProgressBar = SETTINGS.statusBar == CrossPointSettings::STATUS_BAR_MODE::FULL_WITH_PROGRESS_BAR ||
+                                 SETTINGS.statusBar == CrossPointSettings::STATUS_BAR_MODE::ONLY_PROGRESS_BAR;
+    bottom += statusBarMargin - SETTINGS.screenMargin +
+              (showProgressBar ? (ScreenComponents::BOOK_PROGRESS_BAR_HEIGHT + progressBarMarginTop) : 0);
+  }
+
+  width = static_cast<uint16_t>(renderer.getScreenWidth() - left - right);
+  height = static_cast<uint16_t>(renderer.getScreenHeight() - top - bottom);
+
+  renderer.setOrientation(GfxRenderer::Orientation::Portrait);
+}
+
+// Paint page N+1 into specBuffer while the reader dwells on page N, so the forward turn in
+// renderScreen() swaps the finished frame in instead of deserializing and blitting glyphs.
+// Runs on the pre-paginate task. The live framebuffer is the scratch canvas: the on-glass
+// frame is parked in the BW store, the next page painted, copied aside and the on-glass frame
+// put back - all under renderingMutex, so the display task never sees the intermediate state.
+void EpubReaderActivity::buildSpeculativePage() {
+  // The swap path can't reproduce the grayscale overlay, and with the latency badge on the
+  // speculative frame would show stale numbers, so build only when neither is in play
+  if (SETTINGS.textAntiAliasing || SETTINGS.turnLatencyOverlay) {
+    return;
+  }
+  SD_SCHED.yieldToUi();
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  const bool wanted = !updateRequired && !subActivity && !prePaginateAbort && !settlePending && section &&
+                      section->pageCount > 0 && section->currentPage < section->pageCount - 1 &&
+                      !(specSpineIndex == currentSpineIndex && specPage == section->currentPage + 1);
+  if (wanted) {
+    const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::PREFETCH);
+    const int savedPage = section->currentPage;
+    const int target = savedPage + 1;
+    int top, right, bottom, left;
+    computeOrientedMargins(top, right, bottom, left);
+
+    renderer.waitForDisplayFlush();
+    if (renderer.storeBwBuffer()) {
+      section->currentPage = target;
+      bool painted = false;
+      {
+        // Speculative pages recycle through the shared arena like live ones
+        const ParseArena::Scope pageArenaScope(pageArena);
+        if (auto p = section->loadPageFromSectionFile()) {
+          renderer.clearScreen();
+          p->render(renderer, SETTINGS.getReaderFontId(), left, top);
+          renderStatusBar(right, bottom, left);
+          if (annotations.hasAnnotations(static_cast<uint16_t>(currentSpineIndex), static_cast<uint16_t>(target))) {
+            drawAnnotationMarker(top, right);
+          }
+          painted = true;
+        }
+      }
+      if (painted) {
+        if (!specBuffer) {
+          specBuffer = static_cast<uint8_t*>(malloc(GfxRenderer::getBufferSize()));
+        }
+        if (specBuffer) {
+          memcpy(specBuffer, renderer.getFrameBuffer(), GfxRenderer::getBufferSize());
+          specSpineIndex = currentSpineIndex;
+          specPage = target;
+        }
+      }
+      section->currentPage = savedPage;
+      renderer.restoreBwBuffer();
+    }
+  }
+  xSemaphoreGive(renderingMutex);
+}
+
+// Diagnostics overlay in the top-left corner: live p50/p95 input-to-photon turn latency over
+// the monitor's recent-sample ring. Drawn before the flush, so the page being painted shows
+// the distribution up to and including the previous turn.
+void EpubReaderActivity::drawLatencyOverlay(const int orientedMarginTop, const int orientedMarginLeft) const {
+  char text[48];
+  const int sampleCount = TURN_LATENCY.getSampleCount();
+  if (sampleCount == 0) {
+    snprintf(text, sizeof(text), "turn: no samples yet");
+  } else {
+    snprintf(text, sizeof(text), "turn p50 %u / p95 %u ms (n=%d)", TURN_LATENCY.getTotalPercentileMs(50),
+             TURN_LATENCY.getTotalPercentileMs(95), sampleCount);
+  }
+  constexpr int PADDING = 3;
+  const int boxWidth = renderer.getTextWidth(UI_10_FONT_ID, text) + PADDING * 2;
+  const int boxHeight = renderer.getLineHeight(UI_10_FONT_ID) + PADDING * 2;
+  const int y = orientedMarginTop > boxHeight ? orientedMarginTop - boxHeight : 0;
+  renderer.fillRect(orientedMarginLeft, y, boxWidth, boxHeight, false);
+  renderer.drawRect(orientedMarginLeft, y, boxWidth, boxHeight);
+  renderer.drawText(UI_10_FONT_ID, orientedMarginLeft + PADDING, y + PADDING, text);
+}
+
+// Dog-ear ribbon in the top-right corner of the text area marking an annotated page
+void EpubReaderActivity::drawAnnotationMarker(const int orientedMarginTop, const int orientedMarginRight) const {
+  constexpr int MARKER_SIZE = 12;
+  const int x = renderer.getScreenWidth() - orientedMarginRight - MARKER_SIZE;
+  const int y = orientedMarginTop > MARKER_SIZE ? orientedMarginTop - MARKER_SIZE : 0;
+  for (int i = 0; i < MARKER_SIZE; i++) {
+    renderer.fillRect(x + i, y, 1, i + 1);
+  }
+}
+
 void EpubReaderActivity::renderStatusBar(const int orientedMarginRight, const int orientedMarginBottom,
                                          const int orientedMarginLeft) const {
   // determine visible status bar elements
@@ -483,16 +1204,28 @@ void EpubReaderActivity::renderStatusBar(const int orientedMarginRight, const in
   const auto textY = screenHeight - orientedMarginBottom - 4;
   int progressTextWidth = 0;
 
-  // Calculate progress in book
+  // Calculate progress in book: once the background pagination pass has covered every chapter,
+  // real book-wide page numbers replace the byte-size interpolation
+  const bool pageTableComplete = pageTable.isComplete();
+  const uint32_t bookPage = pageTableComplete ? pageTable.pagesBefore(currentSpineIndex) + section->currentPage + 1 : 0;
+  const uint32_t bookPageCount = pageTableComplete ? pageTable.totalPages() : 0;
   const float sectionChapterProg = static_cast<float>(section->currentPage) / section->pageCount;
-  const float bookProgress = epub->calculateProgress(currentSpineIndex, sectionChapterProg) * 100;
+  const float bookProgress = pageTableComplete && bookPageCount > 0
+                                 ? static_cast<float>(bookPage) * 100 / bookPageCount
+                                 : epub->calculateProgress(currentSpineIndex, sectionChapterProg) * 100;
 
   if (showProgressText || showProgressPercentage) {
     // Right aligned text for progress counter
     char progressStr[32];
 
     // Hide percentage when progress bar is shown to reduce clutter
-    if (showProgressPercentage) {
+    if (pageTableComplete && showProgressPercentage) {
+      snprintf(progressStr, sizeof(progressStr), "%lu/%lu  %.0f%%", static_cast<unsigned long>(bookPage),
+               static_cast<unsigned long>(bookPageCount), bookProgress);
+    } else if (pageTableComplete) {
+      snprintf(progressStr, sizeof(progressStr), "%lu/%lu", static_cast<unsigned long>(bookPage),
+               static_cast<unsigned long>(bookPageCount));
+    } else if (showProgressPercentage) {
       snprintf(progressStr, sizeof(progressStr), "%d/%d  %.0f%%", section->currentPage + 1, section->pageCount,
                bookProgress);
     } else {
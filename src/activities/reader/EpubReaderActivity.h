@@ -1,5 +1,8 @@
 #pragma once
 #include <Epub.h>
+#include <Epub/AnnotationStore.h>
+#include <Epub/BookPageTable.h>
+#include <Epub/ParseArena.h>
 #include <Epub/Section.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
@@ -9,24 +12,122 @@
 
 class EpubReaderActivity final : public ActivityWithSubactivity {
   std::shared_ptr<Epub> epub;
+  // Arena behind every page load: the Page elements, TextBlock word lists and glyph-run vectors
+  // deserialized on a page turn come from here and go back onto its free lists ~1s later when
+  // the next page replaces them, so steady-state reading does no general-heap churn. Declared
+  // before the sections below so it outlives the pages they still hold at destruction time.
+  ParseArena pageArena;
   std::unique_ptr<Section> section = nullptr;
+  // One neighbour of the current section kept resident by the pre-paginate task (header parsed,
+  // boundary page in RAM) so a chapter crossing swaps it in without touching the SD card
+  struct PrefetchedSection {
+    std::unique_ptr<Section> section = nullptr;
+    int spineIndex = -1;
+    void reset() {
+      section.reset();
+      spineIndex = -1;
+    }
+  };
+  PrefetchedSection prefetchedNext;  // first page preloaded, for forward crossings
+  PrefetchedSection prefetchedPrev;  // last page preloaded, for backward crossings
+  // Speculative next-page frame built by the pre-paginate task during reading dwell: the fully
+  // painted BW framebuffer for page N+1 (text, status bar, markers), so the common forward turn
+  // collapses to a buffer swap plus flush. Keyed by spine index and page; only touched with
+  // renderingMutex held.
+  uint8_t* specBuffer = nullptr;
+  int specSpineIndex = -1;
+  int specPage = -1;
   TaskHandle_t displayTaskHandle = nullptr;
+  TaskHandle_t prePaginateTaskHandle = nullptr;
   SemaphoreHandle_t renderingMutex = nullptr;
+  // Set before blocking on renderingMutex so an in-flight background build yields quickly
+  volatile bool prePaginateAbort = false;
+  // Viewport of the last section build, reused for speculative builds of adjacent sections
+  volatile uint16_t lastViewportWidth = 0;
+  volatile uint16_t lastViewportHeight = 0;
   int currentSpineIndex = 0;
   int nextPageNumber = 0;
-  int pagesUntilFullRefresh = 0;
+  // Content-aware deghosting: changed framebuffer bytes accumulated over fast flushes since the
+  // last full refresh, measured against the frame shadow. Light pages stretch the interval
+  // between flashes, dense ones shorten it; forceFullRefresh overrides for the next flush.
+  size_t ghostedBytes = 0;
+  // Consecutive turbo flushes since the last settle; the turbo waveform leaves residue even on
+  // light pages, so a standard refresh is forced after a hard cap regardless of the byte budget
+  int turboTurns = 0;
+  bool forceFullRefresh = true;
+  // Two-phase display policy: page turns go on glass with the turbo waveform immediately, and
+  // once the user dwells on a page loop() re-pushes the same screen through the quality path -
+  // the deghosting flash happens while they read, not while they wait for the next page
+  volatile bool settlePending = false;  // a turbo flush is on glass awaiting its quality settle
+  unsigned long settleFlushAt = 0;      // millis() of that flush (written on the display task)
+  unsigned long lastInputAt = 0;        // last button activity seen by loop()
   int cachedSpineIndex = 0;
   int cachedChapterTotalPageCount = 0;
   bool updateRequired = false;
+  // Skim mode: rapid consecutive turns decimate rendering so holding next-page flips through a
+  // book in seconds instead of flashing every page. Intermediate pages paint only a progress
+  // strip from in-RAM state (section header + page table, no SD page load); every Nth page and
+  // the landing page after the flipping stops get the full paint. loop() detects entry and
+  // release, the display task paints the strip.
+  bool skimming = false;
+  int skimStreak = 0;            // Consecutive turns under the skim gap
+  int skimPagesSinceRender = 0;  // Pages flipped since the last full paint
+  unsigned long lastTurnAt = 0;
+  volatile bool skimStripRequired = false;
+  // One-shot resume manifest written on clean exit: packs the reading position together with the
+  // current chapter's section header fields and page offset so re-opening the book is a single
+  // contiguous SD read instead of the progress/header/LUT chain
+  struct ResumeManifest {
+    uint16_t spineIndex = 0;
+    uint16_t page = 0;
+    uint16_t chapterPageCount = 0;
+    int fontId = 0;
+    float lineCompression = 0.0f;
+    bool extraParagraphSpacing = false;
+    uint8_t paragraphAlignment = 0;
+    uint16_t viewportWidth = 0;
+    uint16_t viewportHeight = 0;
+    bool hyphenationEnabled = false;
+    bool optimalLineBreaks = false;
+    uint32_t lutOffset = 0;
+    uint32_t pagePos = 0;
+  };
+  ResumeManifest resumeManifest;
+  bool resumeManifestLoaded = false;
+  // Whole-book page counts for the current layout, filled in by section loads and the idle
+  // pre-paginate task; once complete the status bar shows real book-wide page numbers.
+  // Touched only with renderingMutex held (both tasks already hold it at every access site).
+  BookPageTable pageTable;
+  uint32_t pageTableLayoutKey = 0;
+  // Bookmarks/highlights for this book; loaded once at open, consulted on every
+  // page paint through its in-RAM page filter (long-press Confirm toggles)
+  AnnotationStore annotations;
   const std::function<void()> onGoBack;
   const std::function<void()> onGoHome;
 
   static void taskTrampoline(void* param);
+  static void prePaginateTaskTrampoline(void* param);
+  // (Re)load the page table when the layout namespace changes
+  void ensurePageTable(uint32_t layoutKey);
+  bool loadResumeManifest();
+  void saveResumeManifest();
   [[noreturn]] void displayTaskLoop();
+  [[noreturn]] void prePaginateTaskLoop();
+  // Paint page N+1 into specBuffer while the reader dwells (pre-paginate task)
+  void buildSpeculativePage();
+  // Screen margins shared by the live paint and the speculative one
+  void computeOrientedMargins(int& top, int& right, int& bottom, int& left) const;
+  // Ghosting-budget flush shared by renderContents and the speculative swap path
+  void flushTurnBuffer();
   void renderScreen();
+  // Lightweight position strip over the stale page for skim-mode intermediate turns
+  void renderSkimStrip();
   void renderContents(std::unique_ptr<Page> page, int orientedMarginTop, int orientedMarginRight,
                       int orientedMarginBottom, int orientedMarginLeft);
   void renderStatusBar(int orientedMarginRight, int orientedMarginBottom, int orientedMarginLeft) const;
+  void drawAnnotationMarker(int orientedMarginTop, int orientedMarginRight) const;
+  // Live p50/p95 turn latency badge, gated on SETTINGS.turnLatencyOverlay
+  void drawLatencyOverlay(int orientedMarginTop, int orientedMarginLeft) const;
 
  public:
   explicit EpubReaderActivity(GfxRenderer& renderer, MappedInputManager& mappedInput, std::unique_ptr<Epub> epub,
@@ -38,4 +139,9 @@ class EpubReaderActivity final : public ActivityWithSubactivity {
   void onEnter() override;
   void onExit() override;
   void loop() override;
+  bool isIdle() override;
+  // Reading viewport the current settings produce, for section builds outside the reader
+  // (library indexing). Applies the reader orientation for the measurement and restores
+  // portrait before returning, so callers must hold the display quiescent around it.
+  static void currentLayoutViewport(GfxRenderer& renderer, uint16_t& width, uint16_t& height);
 };
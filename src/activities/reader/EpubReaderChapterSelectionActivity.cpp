@@ -2,6 +2,12 @@
 
 #include <GfxRenderer.h>
 
+#include <Epub/Section.h>
+
+#include <Dictionary.h>
+
+#include "DictionaryLookupActivity.h"
+#include "EpubReaderSearchActivity.h"
 #include "KOReaderCredentialStore.h"
 #include "KOReaderSyncActivity.h"
 #include "MappedInputManager.h"
@@ -14,21 +20,30 @@ constexpr int SKIP_PAGE_MS = 700;
 
 bool EpubReaderChapterSelectionActivity::hasSyncOption() const { return KOREADER_STORE.hasCredentials(); }
 
+bool EpubReaderChapterSelectionActivity::hasDictionaryOption() const { return DICTIONARY.isAvailable(); }
+
 int EpubReaderChapterSelectionActivity::getTotalItems() const {
-  // Add 2 for sync options (top and bottom) if credentials are configured
+  // Search item at the top, a dictionary item when /dictionary.xdic is present,
+  // plus 2 sync options (top and bottom) if credentials are configured
   const int syncCount = hasSyncOption() ? 2 : 0;
-  return epub->getTocItemsCount() + syncCount;
+  return epub->getTocItemsCount() + 1 + (hasDictionaryOption() ? 1 : 0) + syncCount;
+}
+
+bool EpubReaderChapterSelectionActivity::isSearchItem(int index) const { return index == 0; }
+
+bool EpubReaderChapterSelectionActivity::isDictionaryItem(int index) const {
+  return hasDictionaryOption() && index == 1;
 }
 
 bool EpubReaderChapterSelectionActivity::isSyncItem(int index) const {
   if (!hasSyncOption()) return false;
-  // First item and last item are sync options
-  return index == 0 || index == getTotalItems() - 1;
+  // Item below search/dictionary and last item are sync options
+  return index == 1 + (hasDictionaryOption() ? 1 : 0) || index == getTotalItems() - 1;
 }
 
 int EpubReaderChapterSelectionActivity::tocIndexFromItemIndex(int itemIndex) const {
-  // Account for the sync option at the top
-  const int offset = hasSyncOption() ? 1 : 0;
+  // Account for the search, dictionary and top sync items
+  const int offset = 1 + (hasDictionaryOption() ? 1 : 0) + (hasSyncOption() ? 1 : 0);
   return itemIndex - offset;
 }
 
@@ -64,13 +79,13 @@ void EpubReaderChapterSelectionActivity::onEnter() {
 
   renderingMutex = xSemaphoreCreateMutex();
 
-  // Account for sync option offset when finding current TOC index
-  const int syncOffset = hasSyncOption() ? 1 : 0;
+  // Account for search, dictionary and sync option offsets when finding current TOC index
+  const int topOffset = 1 + (hasDictionaryOption() ? 1 : 0) + (hasSyncOption() ? 1 : 0);
   selectorIndex = epub->getTocIndexForSpineIndex(currentSpineIndex);
   if (selectorIndex == -1) {
     selectorIndex = 0;
   }
-  selectorIndex += syncOffset;  // Offset for top sync option
+  selectorIndex += topOffset;  // Offset for search and top sync items
 
   // Trigger first update
   updateRequired = true;
@@ -113,6 +128,35 @@ void EpubReaderChapterSelectionActivity::launchSyncActivity() {
   xSemaphoreGive(renderingMutex);
 }
 
+void EpubReaderChapterSelectionActivity::launchSearchActivity() {
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  exitActivity();
+  enterNewActivity(new EpubReaderSearchActivity(
+      renderer, mappedInput, epub, layoutKey,
+      [this]() {
+        // On back
+        exitActivity();
+        updateRequired = true;
+      },
+      [this](int newSpineIndex, int newPage) {
+        // Jumping to a search result is the same operation as adopting a synced position
+        exitActivity();
+        onSyncPosition(newSpineIndex, newPage);
+      }));
+  xSemaphoreGive(renderingMutex);
+}
+
+void EpubReaderChapterSelectionActivity::launchDictionaryActivity() {
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  exitActivity();
+  enterNewActivity(new DictionaryLookupActivity(renderer, mappedInput, [this]() {
+    // On back
+    exitActivity();
+    updateRequired = true;
+  }));
+  xSemaphoreGive(renderingMutex);
+}
+
 void EpubReaderChapterSelectionActivity::loop() {
   if (subActivity) {
     subActivity->loop();
@@ -129,7 +173,17 @@ void EpubReaderChapterSelectionActivity::loop() {
   const int totalItems = getTotalItems();
 
   if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
-    // Check if sync option is selected (first or last item)
+    if (isSearchItem(selectorIndex)) {
+      launchSearchActivity();
+      return;
+    }
+
+    if (isDictionaryItem(selectorIndex)) {
+      launchDictionaryActivity();
+      return;
+    }
+
+    // Check if sync option is selected
     if (isSyncItem(selectorIndex)) {
       launchSyncActivity();
       return;
@@ -141,6 +195,17 @@ void EpubReaderChapterSelectionActivity::loop() {
     if (newSpineIndex == -1) {
       onGoBack();
     } else {
+      // Anchored entries resolve through the section's anchor map so the jump lands on
+      // the exact page; missing map (section not built for this layout) or unknown
+      // anchor falls back to the chapter top
+      const auto tocEntry = epub->getTocItem(tocIndex);
+      if (!tocEntry.anchor.empty()) {
+        const int anchorPage = Section::lookupAnchorPage(*epub, newSpineIndex, layoutKey, tocEntry.anchor);
+        if (anchorPage >= 0) {
+          onSyncPosition(newSpineIndex, anchorPage);
+          return;
+        }
+      }
       onSelectSpineIndex(newSpineIndex);
     }
   } else if (mappedInput.wasReleased(MappedInputManager::Button::Back)) {
@@ -148,17 +213,52 @@ void EpubReaderChapterSelectionActivity::loop() {
   } else if (prevReleased) {
     if (skipPage) {
       selectorIndex = ((selectorIndex / pageItems - 1) * pageItems + totalItems) % totalItems;
+      updateRequired = true;
     } else {
       selectorIndex = (selectorIndex + totalItems - 1) % totalItems;
+      selectorOnlyUpdate = true;
     }
-    updateRequired = true;
   } else if (nextReleased) {
     if (skipPage) {
       selectorIndex = ((selectorIndex / pageItems + 1) * pageItems) % totalItems;
+      updateRequired = true;
     } else {
       selectorIndex = (selectorIndex + 1) % totalItems;
+      selectorOnlyUpdate = true;
     }
-    updateRequired = true;
+  }
+}
+
+void EpubReaderChapterSelectionActivity::ensureTocWindow(int firstToc, int lastToc) {
+  const int tocCount = epub->getTocItemsCount();
+  if (tocCount == 0) {
+    return;
+  }
+  if (firstToc < 0) firstToc = 0;
+  if (lastToc >= tocCount) lastToc = tocCount - 1;
+  if (firstToc > lastToc) {
+    return;
+  }
+
+  // Already covered (the prefetch margin below makes this the common case when scrolling)
+  if (!tocWindow.empty() && tocWindowStart <= firstToc &&
+      tocWindowStart + static_cast<int>(tocWindow.size()) > lastToc) {
+    return;
+  }
+
+  // Reload centred on the request with a page of margin either side, so single-step and
+  // page-skip scrolls both land inside the window
+  const int pageItems = getPageItems();
+  int start = firstToc - pageItems;
+  if (start < 0) start = 0;
+  int end = lastToc + pageItems;
+  if (end >= tocCount) end = tocCount - 1;
+
+  if (epub->getTocItems(start, end - start + 1, tocWindow)) {
+    tocWindowStart = start;
+  } else {
+    tocWindow.clear();
+    tocWindowStart = 0;
   }
 }
 
@@ -166,9 +266,15 @@ void EpubReaderChapterSelectionActivity::displayTaskLoop() {
   while (true) {
     if (updateRequired && !subActivity) {
       updateRequired = false;
+      selectorOnlyUpdate = false;
       xSemaphoreTake(renderingMutex, portMAX_DELAY);
       renderScreen();
       xSemaphoreGive(renderingMutex);
+    } else if (selectorOnlyUpdate && !subActivity) {
+      selectorOnlyUpdate = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      renderSelectorMove();
+      xSemaphoreGive(renderingMutex);
     }
     vTaskDelay(10 / portTICK_PERIOD_MS);
   }
@@ -188,28 +294,64 @@ void EpubReaderChapterSelectionActivity::renderScreen() {
   const auto pageStartIndex = selectorIndex / pageItems * pageItems;
   renderer.fillRect(0, 60 + (selectorIndex % pageItems) * 30 - 2, pageWidth - 1, 30);
 
+  // One windowed read covers every TOC row on this page (no-op while scrolling
+  // within the prefetched margin)
+  ensureTocWindow(tocIndexFromItemIndex(pageStartIndex), tocIndexFromItemIndex(pageStartIndex + pageItems - 1));
+
   for (int i = 0; i < pageItems; i++) {
-    int itemIndex = pageStartIndex + i;
+    const int itemIndex = pageStartIndex + i;
     if (itemIndex >= totalItems) break;
-    const int displayY = 60 + i * 30;
-    const bool isSelected = (itemIndex == selectorIndex);
-
-    if (isSyncItem(itemIndex)) {
-      renderer.drawText(UI_10_FONT_ID, 20, displayY, ">> Sync Progress", !isSelected);
-    } else {
-      const int tocIndex = tocIndexFromItemIndex(itemIndex);
-      auto item = epub->getTocItem(tocIndex);
-
-      const int indentSize = 20 + (item.level - 1) * 15;
-      const std::string chapterName =
-          renderer.truncatedText(UI_10_FONT_ID, item.title.c_str(), pageWidth - 40 - indentSize);
-
-      renderer.drawText(UI_10_FONT_ID, indentSize, displayY, chapterName.c_str(), !isSelected);
-    }
+    drawItemRow(itemIndex, 60 + i * 30, itemIndex == selectorIndex);
   }
 
   const auto labels = mappedInput.mapLabels("« Back", "Select", "Up", "Down");
   renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
 
   renderer.displayBuffer();
+  lastRenderedSelectorIndex = selectorIndex;
+}
+
+void EpubReaderChapterSelectionActivity::drawItemRow(const int itemIndex, const int displayY, const bool isSelected) {
+  if (isSearchItem(itemIndex)) {
+    renderer.drawText(UI_10_FONT_ID, 20, displayY, ">> Search", !isSelected);
+  } else if (isDictionaryItem(itemIndex)) {
+    renderer.drawText(UI_10_FONT_ID, 20, displayY, ">> Dictionary", !isSelected);
+  } else if (isSyncItem(itemIndex)) {
+    renderer.drawText(UI_10_FONT_ID, 20, displayY, ">> Sync Progress", !isSelected);
+  } else {
+    const auto pageWidth = renderer.getScreenWidth();
+    const int tocIndex = tocIndexFromItemIndex(itemIndex);
+    const int windowIndex = tocIndex - tocWindowStart;
+    const auto item = windowIndex >= 0 && windowIndex < static_cast<int>(tocWindow.size())
+                          ? tocWindow[windowIndex]
+                          : epub->getTocItem(tocIndex);
+
+    const int indentSize = 20 + (item.level - 1) * 15;
+    const std::string chapterName =
+        renderer.truncatedText(UI_10_FONT_ID, item.title.c_str(), pageWidth - 40 - indentSize);
+
+    renderer.drawText(UI_10_FONT_ID, indentSize, displayY, chapterName.c_str(), !isSelected);
+  }
+}
+
+// Selector moved within an already rendered page: repaint just the two affected rows and let
+// the refresh planner flush the small dirty band instead of a full-screen refresh
+void EpubReaderChapterSelectionActivity::renderSelectorMove() {
+  const int pageItems = getPageItems();
+  // Fall back to a full render before the first paint or when the move crossed a page boundary
+  if (lastRenderedSelectorIndex < 0 || lastRenderedSelectorIndex / pageItems != selectorIndex / pageItems) {
+    renderScreen();
+    return;
+  }
+
+  const auto pageWidth = renderer.getScreenWidth();
+  const int rows[2] = {lastRenderedSelectorIndex, selectorIndex};
+  for (const int itemIndex : rows) {
+    const bool isSelected = itemIndex == selectorIndex;
+    const int displayY = 60 + (itemIndex % pageItems) * 30;
+    renderer.fillRect(0, displayY - 2, pageWidth - 1, 30, isSelected);
+    drawItemRow(itemIndex, displayY, isSelected);
+  }
+  lastRenderedSelectorIndex = selectorIndex;
+  renderer.displayDirty();
 }
@@ -11,6 +11,9 @@
 class EpubReaderChapterSelectionActivity final : public ActivityWithSubactivity {
   std::shared_ptr<Epub> epub;
   std::string epubPath;
+  // Layout namespace of the current reader settings; forwarded to the search
+  // activity so it reads the posting indexes matching the on-screen pagination
+  const uint32_t layoutKey;
   TaskHandle_t displayTaskHandle = nullptr;
   SemaphoreHandle_t renderingMutex = nullptr;
   int currentSpineIndex = 0;
@@ -18,6 +21,16 @@ class EpubReaderChapterSelectionActivity final : public ActivityWithSubactivity
   int totalPagesInSpine = 0;
   int selectorIndex = 0;
   bool updateRequired = false;
+  // Selector moved within the rendered page: repaint just the two affected rows and flush
+  // them through the refresh planner instead of a full-screen refresh
+  bool selectorOnlyUpdate = false;
+  // Item the last paint left highlighted (-1 before the first full render)
+  int lastRenderedSelectorIndex = -1;
+
+  // Virtualized TOC model: the rendered page of entries plus one page either side,
+  // fetched with a single windowed read instead of a seek per visible row
+  std::vector<BookMetadataCache::TocEntry> tocWindow;
+  int tocWindowStart = 0;
   const std::function<void()> onGoBack;
   const std::function<void(int newSpineIndex)> onSelectSpineIndex;
   const std::function<void(int newSpineIndex, int newPage)> onSyncPosition;
@@ -26,33 +39,54 @@ class EpubReaderChapterSelectionActivity final : public ActivityWithSubactivity
   // This adapts automatically when switching between portrait and landscape.
   int getPageItems() const;
 
-  // Total items including sync options (top and bottom)
+  // Total items including the search/dictionary items and sync options
   int getTotalItems() const;
 
   // Check if sync option is available (credentials configured)
   bool hasSyncOption() const;
 
-  // Check if given item index is a sync option (first or last)
+  // Check if a dictionary file is present on the SD card
+  bool hasDictionaryOption() const;
+
+  // Check if given item index is the search item (always first)
+  bool isSearchItem(int index) const;
+
+  // Check if given item index is the dictionary item (below search, when present)
+  bool isDictionaryItem(int index) const;
+
+  // Check if given item index is a sync option (below search/dictionary, and last)
   bool isSyncItem(int index) const;
 
-  // Convert item index to TOC index (accounting for top sync option offset)
+  // Convert item index to TOC index (accounting for search, dictionary and sync offsets)
   int tocIndexFromItemIndex(int itemIndex) const;
 
+  // Make sure tocWindow covers [firstToc, lastToc], reloading it with a page of
+  // prefetch margin on both sides when the view scrolls out of the current window
+  void ensureTocWindow(int firstToc, int lastToc);
+
   static void taskTrampoline(void* param);
   [[noreturn]] void displayTaskLoop();
   void renderScreen();
+  // Draw one row's text content (no selector band); shared by the full render and the
+  // selector-only repaint
+  void drawItemRow(int itemIndex, int displayY, bool isSelected);
+  void renderSelectorMove();
   void launchSyncActivity();
+  void launchSearchActivity();
+  void launchDictionaryActivity();
 
  public:
   explicit EpubReaderChapterSelectionActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
                                               const std::shared_ptr<Epub>& epub, const std::string& epubPath,
-                                              const int currentSpineIndex, const int currentPage,
-                                              const int totalPagesInSpine, const std::function<void()>& onGoBack,
+                                              const uint32_t layoutKey, const int currentSpineIndex,
+                                              const int currentPage, const int totalPagesInSpine,
+                                              const std::function<void()>& onGoBack,
                                               const std::function<void(int newSpineIndex)>& onSelectSpineIndex,
                                               const std::function<void(int newSpineIndex, int newPage)>& onSyncPosition)
       : ActivityWithSubactivity("EpubReaderChapterSelection", renderer, mappedInput),
         epub(epub),
         epubPath(epubPath),
+        layoutKey(layoutKey),
         currentSpineIndex(currentSpineIndex),
         currentPage(currentPage),
         totalPagesInSpine(totalPagesInSpine),
@@ -0,0 +1,287 @@
+#include "EpubReaderSearchActivity.h"
+
+#include <Epub/SearchIndex.h>
+#include <Epub/Section.h>
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+
+#include <algorithm>
+
+#include "MappedInputManager.h"
+#include "activities/util/KeyboardEntryActivity.h"
+#include "fontIds.h"
+
+namespace {
+// Time threshold for treating a long press as a page-up/page-down
+constexpr int SKIP_PAGE_MS = 700;
+// Plenty to scroll through; a query this broad needs refining anyway
+constexpr size_t MAX_RESULTS = 200;
+}  // namespace
+
+int EpubReaderSearchActivity::getPageItems() const {
+  constexpr int startY = 60;
+  constexpr int lineHeight = 30;
+  const int endY = renderer.getScreenHeight() - lineHeight;
+  const int items = (endY - startY) / lineHeight;
+  return items < 1 ? 1 : items;
+}
+
+void EpubReaderSearchActivity::taskTrampoline(void* param) {
+  auto* self = static_cast<EpubReaderSearchActivity*>(param);
+  self->displayTaskLoop();
+}
+
+void EpubReaderSearchActivity::onEnter() {
+  ActivityWithSubactivity::onEnter();
+
+  renderingMutex = xSemaphoreCreateMutex();
+  state = SearchState::QUERY_ENTRY;
+  updateRequired = true;
+
+  xTaskCreate(&EpubReaderSearchActivity::taskTrampoline, "EpubReaderSearchTask",
+              4096,               // Stack size
+              this,               // Parameters
+              1,                  // Priority
+              &displayTaskHandle  // Task handle
+  );
+
+  launchKeyboard();
+}
+
+void EpubReaderSearchActivity::onExit() {
+  ActivityWithSubactivity::onExit();
+
+  // Wait until not rendering to delete task to avoid killing mid-instruction to EPD
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  if (displayTaskHandle) {
+    vTaskDelete(displayTaskHandle);
+    displayTaskHandle = nullptr;
+  }
+  vSemaphoreDelete(renderingMutex);
+  renderingMutex = nullptr;
+}
+
+void EpubReaderSearchActivity::launchKeyboard() {
+  state = SearchState::QUERY_ENTRY;
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  exitActivity();
+  enterNewActivity(new KeyboardEntryActivity(
+      renderer, mappedInput, "Search", query,
+      10,     // startY
+      64,     // maxLength
+      false,  // not password
+      [this](const std::string& entered) {
+        exitActivity();
+        query = entered;
+        // Run from loop() rather than inside the keyboard's callback stack
+        pendingSearch = true;
+      },
+      [this] {
+        exitActivity();
+        onGoBack();
+      }));
+  xSemaphoreGive(renderingMutex);
+}
+
+void EpubReaderSearchActivity::runSearch() {
+  state = SearchState::SEARCHING;
+  results.clear();
+  selectorIndex = 0;
+  indexedSpines = 0;
+  searchedSpines = 0;
+  updateRequired = true;
+
+  // Hash each query word; posting lookups AND the words within a page
+  std::vector<uint16_t> wordHashes;
+  std::string word;
+  for (size_t i = 0; i <= query.size(); i++) {
+    if (i == query.size() || query[i] == ' ') {
+      if (!word.empty()) {
+        const uint16_t hash = SearchIndex::hashWord(word.c_str());
+        if (hash != 0) {
+          wordHashes.push_back(hash);
+        }
+        word.clear();
+      }
+    } else {
+      word += query[i];
+    }
+  }
+
+  const int spineCount = epub->getSpineItemsCount();
+  if (wordHashes.empty()) {
+    searchedSpines = spineCount;
+    state = SearchState::RESULTS;
+    updateRequired = true;
+    return;
+  }
+
+  const unsigned long start = millis();
+  for (int spine = 0; spine < spineCount; spine++) {
+    // SD and the display share the SPI bus; hold the lock per spine so progress
+    // renders can interleave between lookups
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    const auto indexPath = Section::searchIndexPath(*epub, spine, layoutKey);
+    std::vector<uint16_t> pages;
+    bool indexed = SearchIndex::lookup(indexPath, wordHashes[0], pages);
+    for (size_t w = 1; indexed && !pages.empty() && w < wordHashes.size(); w++) {
+      std::vector<uint16_t> wordPages;
+      indexed = SearchIndex::lookup(indexPath, wordHashes[w], wordPages);
+      // Both lists are ascending; keep pages containing every word
+      std::vector<uint16_t> common;
+      std::set_intersection(pages.begin(), pages.end(), wordPages.begin(), wordPages.end(),
+                            std::back_inserter(common));
+      pages = std::move(common);
+    }
+    xSemaphoreGive(renderingMutex);
+
+    if (indexed) {
+      indexedSpines++;
+      for (const uint16_t page : pages) {
+        if (results.size() >= MAX_RESULTS) {
+          break;
+        }
+        results.push_back({static_cast<uint16_t>(spine), page});
+      }
+    }
+    searchedSpines++;
+    if (searchedSpines % 8 == 0) {
+      updateRequired = true;
+    }
+    if (results.size() >= MAX_RESULTS) {
+      searchedSpines = spineCount;
+      break;
+    }
+  }
+
+  Serial.printf("[%lu] [SRCH] \"%s\": %u match(es) in %d/%d chapters, %lums\n", millis(), query.c_str(),
+                static_cast<unsigned>(results.size()), indexedSpines, spineCount, millis() - start);
+  state = SearchState::RESULTS;
+  updateRequired = true;
+}
+
+std::string EpubReaderSearchActivity::resultLabel(const SearchResult& result) const {
+  std::string title;
+  const int tocIndex = epub->getTocIndexForSpineIndex(result.spineIndex);
+  if (tocIndex >= 0) {
+    title = epub->getTocItem(tocIndex).title;
+  }
+  if (title.empty()) {
+    title = "Chapter " + std::to_string(result.spineIndex + 1);
+  }
+  return title + " - p." + std::to_string(result.page + 1);
+}
+
+void EpubReaderSearchActivity::loop() {
+  if (subActivity) {
+    subActivity->loop();
+    return;
+  }
+
+  if (pendingSearch) {
+    pendingSearch = false;
+    runSearch();
+    return;
+  }
+
+  if (state != SearchState::RESULTS) {
+    return;
+  }
+
+  const bool prevReleased = mappedInput.wasReleased(MappedInputManager::Button::Up) ||
+                            mappedInput.wasReleased(MappedInputManager::Button::Left);
+  const bool nextReleased = mappedInput.wasReleased(MappedInputManager::Button::Down) ||
+                            mappedInput.wasReleased(MappedInputManager::Button::Right);
+  const bool skipPage = mappedInput.getHeldTime() > SKIP_PAGE_MS;
+  const int pageItems = getPageItems();
+  const int totalItems = static_cast<int>(results.size());
+
+  if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
+    if (!results.empty()) {
+      const auto& result = results[selectorIndex];
+      onSelectResult(result.spineIndex, result.page);
+    }
+  } else if (mappedInput.wasReleased(MappedInputManager::Button::Back)) {
+    // Back from results re-opens the query for refinement
+    launchKeyboard();
+  } else if (prevReleased && totalItems > 0) {
+    if (skipPage) {
+      selectorIndex = ((selectorIndex / pageItems - 1) * pageItems + totalItems) % totalItems;
+    } else {
+      selectorIndex = (selectorIndex + totalItems - 1) % totalItems;
+    }
+    updateRequired = true;
+  } else if (nextReleased && totalItems > 0) {
+    if (skipPage) {
+      selectorIndex = ((selectorIndex / pageItems + 1) * pageItems) % totalItems;
+    } else {
+      selectorIndex = (selectorIndex + 1) % totalItems;
+    }
+    updateRequired = true;
+  }
+}
+
+void EpubReaderSearchActivity::displayTaskLoop() {
+  while (true) {
+    if (updateRequired && !subActivity) {
+      updateRequired = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      render();
+      xSemaphoreGive(renderingMutex);
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+}
+
+void EpubReaderSearchActivity::render() {
+  renderer.clearScreen();
+
+  const auto pageWidth = renderer.getScreenWidth();
+  const auto pageHeight = renderer.getScreenHeight();
+
+  renderer.drawCenteredText(UI_12_FONT_ID, 15, "Search", true, EpdFontFamily::BOLD);
+
+  if (state == SearchState::SEARCHING) {
+    const std::string progress =
+        "Searching... " + std::to_string(searchedSpines) + "/" + std::to_string(epub->getSpineItemsCount());
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, progress.c_str());
+    renderer.displayBuffer();
+    return;
+  }
+
+  if (state != SearchState::RESULTS) {
+    renderer.displayBuffer();
+    return;
+  }
+
+  if (results.empty()) {
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, "No matches");
+  } else {
+    const int pageItems = getPageItems();
+    const int pageStartIndex = selectorIndex / pageItems * pageItems;
+    renderer.fillRect(0, 60 + (selectorIndex % pageItems) * 30 - 2, pageWidth - 1, 30);
+
+    for (int i = 0; i < pageItems; i++) {
+      const int itemIndex = pageStartIndex + i;
+      if (itemIndex >= static_cast<int>(results.size())) {
+        break;
+      }
+      const std::string label =
+          renderer.truncatedText(UI_10_FONT_ID, resultLabel(results[itemIndex]).c_str(), pageWidth - 40);
+      renderer.drawText(UI_10_FONT_ID, 20, 60 + i * 30, label.c_str(), itemIndex != selectorIndex);
+    }
+  }
+
+  // Only built (read or prefetched) chapters have an index; make partial coverage visible
+  const int spineCount = epub->getSpineItemsCount();
+  if (indexedSpines < spineCount) {
+    const std::string coverage =
+        "Searched " + std::to_string(indexedSpines) + " of " + std::to_string(spineCount) + " chapters";
+    renderer.drawCenteredText(SMALL_FONT_ID, pageHeight - 55, coverage.c_str());
+  }
+
+  const auto labels = mappedInput.mapLabels("« Query", "Go to", "Up", "Down");
+  renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+
+  renderer.displayBuffer();
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <Epub.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../ActivityWithSubactivity.h"
+
+/**
+ * Full-text search within the open book. Queries run against the per-section
+ * posting indexes written during section builds, so only chapters that have been
+ * paginated (read or prefetched) are searchable; the footer shows the coverage.
+ * Selecting a result jumps the reader to that page.
+ */
+class EpubReaderSearchActivity final : public ActivityWithSubactivity {
+  struct SearchResult {
+    uint16_t spineIndex;
+    uint16_t page;
+  };
+
+  enum class SearchState {
+    QUERY_ENTRY,  // Keyboard subactivity is up
+    SEARCHING,    // Walking the per-section indexes
+    RESULTS,      // Showing matches (possibly none)
+  };
+
+  std::shared_ptr<Epub> epub;
+  const uint32_t layoutKey;
+  TaskHandle_t displayTaskHandle = nullptr;
+  SemaphoreHandle_t renderingMutex = nullptr;
+  bool updateRequired = false;
+
+  SearchState state = SearchState::QUERY_ENTRY;
+  std::string query;
+  std::vector<SearchResult> results;
+  int indexedSpines = 0;
+  int searchedSpines = 0;
+  int selectorIndex = 0;
+  bool pendingSearch = false;
+
+  const std::function<void()> onGoBack;
+  const std::function<void(int spineIndex, int page)> onSelectResult;
+
+  int getPageItems() const;
+  static void taskTrampoline(void* param);
+  [[noreturn]] void displayTaskLoop();
+  void render();
+  void launchKeyboard();
+  void runSearch();
+  std::string resultLabel(const SearchResult& result) const;
+
+ public:
+  explicit EpubReaderSearchActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
+                                    const std::shared_ptr<Epub>& epub, const uint32_t layoutKey,
+                                    const std::function<void()>& onGoBack,
+                                    const std::function<void(int spineIndex, int page)>& onSelectResult)
+      : ActivityWithSubactivity("EpubReaderSearch", renderer, mappedInput),
+        epub(epub),
+        layoutKey(layoutKey),
+        onGoBack(onGoBack),
+        onSelectResult(onSelectResult) {}
+  void onEnter() override;
+  void onExit() override;
+  void loop() override;
+};
@@ -4,11 +4,16 @@
 #include <WiFi.h>
 #include <esp_sntp.h>
 
+#include <ctime>
+
 #include "KOReaderCredentialStore.h"
 #include "KOReaderDocumentId.h"
+#include "KOReaderPositionCache.h"
+#include "KOReaderSyncQueue.h"
 #include "MappedInputManager.h"
 #include "activities/network/WifiSelectionActivity.h"
 #include "fontIds.h"
+#include "network/WifiFastConnect.h"
 
 namespace {
 void syncTimeWithNTP() {
@@ -71,13 +76,24 @@ void KOReaderSyncActivity::onWifiSelectionComplete(const bool success) {
   performSync();
 }
 
-void KOReaderSyncActivity::performSync() {
+void KOReaderSyncActivity::calculateDocumentHash() {
+  if (!documentHash.empty()) {
+    return;
+  }
   // Calculate document hash based on user's preferred method
   if (KOREADER_STORE.getMatchMethod() == DocumentMatchMethod::FILENAME) {
     documentHash = KOReaderDocumentId::calculateFromFilename(epubPath);
   } else {
-    documentHash = KOReaderDocumentId::calculate(epubPath);
+    documentHash = KOReaderDocumentId::calculateCached(epubPath, epub->getCachePath());
   }
+}
+
+void KOReaderSyncActivity::performSync() {
+  // A cached comparison may already be on screen; keep it there and stay quiet
+  // instead of flashing through the SYNCING status updates
+  const bool quiet = remoteFromCache && state == SHOWING_RESULT;
+
+  calculateDocumentHash();
   if (documentHash.empty()) {
     xSemaphoreTake(renderingMutex, portMAX_DELAY);
     state = SYNC_FAILED;
@@ -89,26 +105,51 @@ void KOReaderSyncActivity::performSync() {
 
   Serial.printf("[%lu] [KOSync] Document hash: %s\n", millis(), documentHash.c_str());
 
-  xSemaphoreTake(renderingMutex, portMAX_DELAY);
-  statusMessage = "Fetching remote progress...";
-  xSemaphoreGive(renderingMutex);
-  updateRequired = true;
-  vTaskDelay(10 / portTICK_PERIOD_MS);
+  // Push any offline-queued progress first so the fetch compares against our latest position
+  if (KOSYNC_QUEUE.hasPending()) {
+    if (!quiet) {
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      statusMessage = "Pushing queued progress...";
+      xSemaphoreGive(renderingMutex);
+      updateRequired = true;
+    }
+    KOSYNC_QUEUE.flush();
+  }
+
+  if (!quiet) {
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    statusMessage = "Fetching remote progress...";
+    xSemaphoreGive(renderingMutex);
+    updateRequired = true;
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
 
   // Fetch remote progress
-  const auto result = KOReaderSyncClient::getProgress(documentHash, remoteProgress);
+  KOReaderProgress fetched;
+  const auto result = KOReaderSyncClient::getProgress(documentHash, fetched);
 
   if (result == KOReaderSyncClient::NOT_FOUND) {
-    // No remote progress - offer to upload
+    // No remote progress - offer to upload. A cached comparison would now be
+    // a lie, so the entry goes too
+    KOSYNC_POSITIONS.remove(documentHash);
     xSemaphoreTake(renderingMutex, portMAX_DELAY);
     state = NO_REMOTE_PROGRESS;
     hasRemoteProgress = false;
+    remoteFromCache = false;
+    revalidating = false;
     xSemaphoreGive(renderingMutex);
     updateRequired = true;
     return;
   }
 
   if (result != KOReaderSyncClient::OK) {
+    if (quiet) {
+      // The cached comparison stands on its own; just stop pretending to revalidate
+      Serial.printf("[%lu] [KOSync] Revalidation failed (%s), keeping cached position\n", millis(),
+                    KOReaderSyncClient::errorString(result));
+      revalidating = false;
+      return;
+    }
     xSemaphoreTake(renderingMutex, portMAX_DELAY);
     state = SYNC_FAILED;
     statusMessage = KOReaderSyncClient::errorString(result);
@@ -117,20 +158,33 @@ void KOReaderSyncActivity::performSync() {
     return;
   }
 
+  // Cached screen already shows exactly this position: skip the repaint
+  const bool unchanged =
+      quiet && fetched.progress == remoteProgress.progress && fetched.percentage == remoteProgress.percentage;
+
   // Convert remote progress to CrossPoint position
+  remoteProgress = fetched;
+  remoteProgress.document = documentHash;
+  KOSYNC_POSITIONS.put(remoteProgress);
   hasRemoteProgress = true;
-  KOReaderPosition koPos = {remoteProgress.progress, remoteProgress.percentage};
-  remotePosition = ProgressMapper::toCrossPoint(epub, koPos, totalPagesInSpine);
+  const KOReaderPosition koPos = {remoteProgress.progress, remoteProgress.percentage};
+  remotePosition = ProgressMapper::toCrossPoint(spineTable, koPos, totalPagesInSpine);
 
   // Calculate local progress in KOReader format (for display)
-  CrossPointPosition localPos = {currentSpineIndex, currentPage, totalPagesInSpine};
-  localProgress = ProgressMapper::toKOReader(epub, localPos);
+  const CrossPointPosition localPos = {currentSpineIndex, currentPage, totalPagesInSpine};
+  localProgress = ProgressMapper::toKOReader(spineTable, localPos);
 
   xSemaphoreTake(renderingMutex, portMAX_DELAY);
   state = SHOWING_RESULT;
-  selectedOption = 0;  // Default to "Apply"
+  if (!quiet) {
+    selectedOption = 0;  // Default to "Apply"
+  }
+  remoteFromCache = false;
+  revalidating = false;
   xSemaphoreGive(renderingMutex);
-  updateRequired = true;
+  if (!unchanged) {
+    updateRequired = true;
+  }
 }
 
 void KOReaderSyncActivity::performUpload() {
@@ -142,8 +196,8 @@ void KOReaderSyncActivity::performUpload() {
   vTaskDelay(10 / portTICK_PERIOD_MS);
 
   // Convert current position to KOReader format
-  CrossPointPosition localPos = {currentSpineIndex, currentPage, totalPagesInSpine};
-  KOReaderPosition koPos = ProgressMapper::toKOReader(epub, localPos);
+  const CrossPointPosition localPos = {currentSpineIndex, currentPage, totalPagesInSpine};
+  const KOReaderPosition koPos = ProgressMapper::toKOReader(spineTable, localPos);
 
   KOReaderProgress progress;
   progress.document = documentHash;
@@ -161,6 +215,10 @@ void KOReaderSyncActivity::performUpload() {
     return;
   }
 
+  // Pushes are last-writer-wins, so our position is now the remote one
+  progress.timestamp = time(nullptr);
+  KOSYNC_POSITIONS.put(progress);
+
   xSemaphoreTake(renderingMutex, portMAX_DELAY);
   state = UPLOAD_COMPLETE;
   xSemaphoreGive(renderingMutex);
@@ -170,6 +228,9 @@ void KOReaderSyncActivity::performUpload() {
 void KOReaderSyncActivity::onEnter() {
   ActivityWithSubactivity::onEnter();
 
+  // Credentials load lazily since boot no longer reads them
+  KOREADER_STORE.ensureLoaded();
+
   renderingMutex = xSemaphoreCreateMutex();
 
   xTaskCreate(&KOReaderSyncActivity::taskTrampoline, "KOSyncTask",
@@ -186,6 +247,47 @@ void KOReaderSyncActivity::onEnter() {
     return;
   }
 
+  // Spine size prefix sums once; both conversion directions reuse them
+  spineTable = ProgressMapper::buildTable(epub);
+
+  // The document hash needs no network (and the content hash is memoised as
+  // koid.bin after the first sync), so the position cache can be consulted
+  // before WiFi even comes up
+  calculateDocumentHash();
+  KOReaderProgress cached;
+  if (KOSYNC_POSITIONS.get(documentHash, cached)) {
+    Serial.printf("[%lu] [KOSync] Showing cached position (%.2f%%), revalidating in background\n", millis(),
+                  cached.percentage * 100);
+    remoteProgress = cached;
+    hasRemoteProgress = true;
+    remoteFromCache = true;
+    const KOReaderPosition koPos = {remoteProgress.progress, remoteProgress.percentage};
+    remotePosition = ProgressMapper::toCrossPoint(spineTable, koPos, totalPagesInSpine);
+    const CrossPointPosition localPos = {currentSpineIndex, currentPage, totalPagesInSpine};
+    localProgress = ProgressMapper::toKOReader(spineTable, localPos);
+    state = SHOWING_RESULT;
+    selectedOption = 0;  // Default to "Apply"
+    updateRequired = true;
+
+    // Revalidate only if a connection comes for free (already up, or the fast
+    // reconnect lands); the interactive WiFi picker would stomp on the
+    // comparison that's already on screen
+    WiFi.mode(WIFI_STA);
+    if (WiFi.status() == WL_CONNECTED) {
+      revalidating = true;
+      startRevalidateTask();
+      return;
+    }
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    const bool fastConnectStarted = WifiFastConnect::begin();
+    xSemaphoreGive(renderingMutex);
+    if (fastConnectStarted) {
+      revalidating = true;
+      connectionStartTime = millis();
+    }
+    return;
+  }
+
   // Turn on WiFi
   Serial.printf("[%lu] [KOSync] Turning on WiFi...\n", millis());
   WiFi.mode(WIFI_STA);
@@ -193,29 +295,56 @@ void KOReaderSyncActivity::onEnter() {
   // Check if already connected
   if (WiFi.status() == WL_CONNECTED) {
     Serial.printf("[%lu] [KOSync] Already connected to WiFi\n", millis());
-    state = SYNCING;
-    statusMessage = "Syncing time...";
-    updateRequired = true;
+    startSyncTask();
+    return;
+  }
 
-    // Perform sync directly (will be handled in loop)
-    xTaskCreate(
-        [](void* param) {
-          auto* self = static_cast<KOReaderSyncActivity*>(param);
-          // Sync time first
-          syncTimeWithNTP();
-          xSemaphoreTake(self->renderingMutex, portMAX_DELAY);
-          self->statusMessage = "Calculating document hash...";
-          xSemaphoreGive(self->renderingMutex);
-          self->updateRequired = true;
-          self->performSync();
-          vTaskDelete(nullptr);
-        },
-        "SyncTask", 4096, this, 1, nullptr);
+  // Try a targeted reconnect to the last AP before paying for a full scan.
+  // SD card read needs the lock as we use SPI for both.
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  const bool fastConnectStarted = WifiFastConnect::begin();
+  xSemaphoreGive(renderingMutex);
+  if (fastConnectStarted) {
+    state = CONNECTING;
+    statusMessage = "Connecting to WiFi...";
+    connectionStartTime = millis();
+    updateRequired = true;
     return;
   }
 
   // Launch WiFi selection subactivity
+  launchWifiSelection();
+}
+
+void KOReaderSyncActivity::startSyncTask() {
+  state = SYNCING;
+  statusMessage = "Syncing time...";
+  updateRequired = true;
+
+  // Perform sync on the shared worker (progress is rendered from the display task)
+  syncJob = TASK_QUEUE.enqueue("KOSync", [this](const AsyncTaskQueue::Job&) {
+    // Sync time first
+    syncTimeWithNTP();
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    statusMessage = "Calculating document hash...";
+    xSemaphoreGive(renderingMutex);
+    updateRequired = true;
+    performSync();
+  });
+}
+
+void KOReaderSyncActivity::startRevalidateTask() {
+  // The cached comparison stays on screen; performSync notices and only
+  // repaints if the server's answer differs
+  syncJob = TASK_QUEUE.enqueue("KOSyncRevalidate", [this](const AsyncTaskQueue::Job&) {
+    syncTimeWithNTP();
+    performSync();
+  });
+}
+
+void KOReaderSyncActivity::launchWifiSelection() {
   Serial.printf("[%lu] [KOSync] Launching WifiSelectionActivity...\n", millis());
+  state = WIFI_SELECTION;
   enterNewActivity(new WifiSelectionActivity(renderer, mappedInput,
                                              [this](const bool connected) { onWifiSelectionComplete(connected); }));
 }
@@ -223,6 +352,11 @@ void KOReaderSyncActivity::onEnter() {
 void KOReaderSyncActivity::onExit() {
   ActivityWithSubactivity::onExit();
 
+  // The sync job captures `this`; make sure it's done before teardown (and before we hold the
+  // rendering mutex, which the job takes while updating status)
+  TASK_QUEUE.cancelAndWait(syncJob);
+  syncJob = nullptr;
+
   // Turn off wifi
   WiFi.disconnect(false);
   delay(100);
@@ -271,7 +405,7 @@ void KOReaderSyncActivity::render() {
     return;
   }
 
-  if (state == SYNCING || state == UPLOADING) {
+  if (state == CONNECTING || state == SYNCING || state == UPLOADING) {
     renderer.drawCenteredText(UI_10_FONT_ID, 300, statusMessage.c_str(), true, EpdFontFamily::BOLD);
     renderer.displayBuffer();
     return;
@@ -291,7 +425,7 @@ void KOReaderSyncActivity::render() {
                                                           : ("Section " + std::to_string(currentSpineIndex + 1));
 
     // Remote progress - chapter and page
-    renderer.drawText(UI_10_FONT_ID, 20, 160, "Remote:", true);
+    renderer.drawText(UI_10_FONT_ID, 20, 160, remoteFromCache ? "Remote (cached):" : "Remote:", true);
     char remoteChapterStr[128];
     snprintf(remoteChapterStr, sizeof(remoteChapterStr), "  %s", remoteChapter.c_str());
     renderer.drawText(UI_10_FONT_ID, 20, 185, remoteChapterStr);
@@ -380,6 +514,26 @@ void KOReaderSyncActivity::loop() {
     return;
   }
 
+  if (state == CONNECTING) {
+    const wl_status_t status = WiFi.status();
+    if (status == WL_CONNECTED) {
+      Serial.printf("[%lu] [KOSync] Fast reconnect succeeded in %lums\n", millis(), millis() - connectionStartTime);
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      WifiFastConnect::noteConnected();
+      xSemaphoreGive(renderingMutex);
+      startSyncTask();
+      return;
+    }
+    if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL ||
+        millis() - connectionStartTime > WifiFastConnect::TIMEOUT_MS) {
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      WifiFastConnect::noteFailed();
+      xSemaphoreGive(renderingMutex);
+      launchWifiSelection();
+    }
+    return;
+  }
+
   if (state == NO_CREDENTIALS || state == SYNC_FAILED || state == UPLOAD_COMPLETE) {
     if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
       onCancel();
@@ -388,6 +542,25 @@ void KOReaderSyncActivity::loop() {
   }
 
   if (state == SHOWING_RESULT) {
+    // Background revalidation rides the fast reconnect without leaving the
+    // cached comparison screen; no sync job yet means still waiting for WiFi
+    if (revalidating && syncJob == nullptr) {
+      const wl_status_t status = WiFi.status();
+      if (status == WL_CONNECTED) {
+        xSemaphoreTake(renderingMutex, portMAX_DELAY);
+        WifiFastConnect::noteConnected();
+        xSemaphoreGive(renderingMutex);
+        startRevalidateTask();
+      } else if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL ||
+                 millis() - connectionStartTime > WifiFastConnect::TIMEOUT_MS) {
+        xSemaphoreTake(renderingMutex, portMAX_DELAY);
+        WifiFastConnect::noteFailed();
+        xSemaphoreGive(renderingMutex);
+        revalidating = false;
+        Serial.printf("[%lu] [KOSync] Offline, keeping cached position\n", millis());
+      }
+    }
+
     // Navigate options
     if (mappedInput.wasPressed(MappedInputManager::Button::Up) ||
         mappedInput.wasPressed(MappedInputManager::Button::Left)) {
@@ -421,13 +594,7 @@ void KOReaderSyncActivity::loop() {
   if (state == NO_REMOTE_PROGRESS) {
     if (mappedInput.wasPressed(MappedInputManager::Button::Confirm)) {
       // Calculate hash if not done yet
-      if (documentHash.empty()) {
-        if (KOREADER_STORE.getMatchMethod() == DocumentMatchMethod::FILENAME) {
-          documentHash = KOReaderDocumentId::calculateFromFilename(epubPath);
-        } else {
-          documentHash = KOReaderDocumentId::calculate(epubPath);
-        }
-      }
+      calculateDocumentHash();
       performUpload();
     }
 
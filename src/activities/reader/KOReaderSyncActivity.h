@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 
+#include "AsyncTaskQueue.h"
 #include "KOReaderSyncClient.h"
 #include "ProgressMapper.h"
 #include "activities/ActivityWithSubactivity.h"
@@ -68,17 +69,29 @@ class KOReaderSyncActivity final : public ActivityWithSubactivity {
 
   TaskHandle_t displayTaskHandle = nullptr;
   SemaphoreHandle_t renderingMutex = nullptr;
+  AsyncTaskQueue::JobHandle syncJob;
   bool updateRequired = false;
 
   State state = WIFI_SELECTION;
   std::string statusMessage;
   std::string documentHash;
 
+  // Start time of the fast-reconnect attempt (CONNECTING state)
+  unsigned long connectionStartTime = 0;
+
+  // Spine size prefix sums, snapshotted once on enter and reused for every conversion
+  ProgressMapper::SpineFractionTable spineTable;
+
   // Remote progress data
   bool hasRemoteProgress = false;
   KOReaderProgress remoteProgress;
   CrossPointPosition remotePosition;
 
+  // The comparison on screen came from the local position cache; the real
+  // fetch (if reachable) revalidates it in the background
+  bool remoteFromCache = false;
+  bool revalidating = false;
+
   // Local progress as KOReader format (for display)
   KOReaderPosition localProgress;
 
@@ -89,6 +102,10 @@ class KOReaderSyncActivity final : public ActivityWithSubactivity {
   OnSyncCompleteCallback onSyncComplete;
 
   void onWifiSelectionComplete(bool success);
+  void startSyncTask();
+  void startRevalidateTask();
+  void calculateDocumentHash();
+  void launchWifiSelection();
   void performSync();
   void performUpload();
 
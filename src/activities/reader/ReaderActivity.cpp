@@ -4,6 +4,7 @@
 #include "EpubReaderActivity.h"
 #include "Txt.h"
 #include "TxtReaderActivity.h"
+#include "UserFontStore.h"
 #include "Xtc.h"
 #include "XtcReaderActivity.h"
 #include "activities/util/FullScreenMessageActivity.h"
@@ -104,6 +105,10 @@ void ReaderActivity::onGoToTxtReader(std::unique_ptr<Txt> txt) {
 void ReaderActivity::onEnter() {
   ActivityWithSubactivity::onEnter();
 
+  // Register any user fonts from the card before a reader resolves its font id; no-op after
+  // the first book this session
+  USER_FONTS.ensureRegistered(renderer);
+
   if (initialBookPath.empty()) {
     goToLibrary();  // Start from root when entering via Browse
     return;
@@ -1,18 +1,22 @@
 #include "TxtReaderActivity.h"
 
+#include <BufferedFileReader.h>
 #include <GfxRenderer.h>
 #include <SDCardManager.h>
 #include <Serialization.h>
 #include <Utf8.h>
 
+#include "CacheGc.h"
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
 #include "MappedInputManager.h"
 #include "RecentBooksStore.h"
 #include "ScreenComponents.h"
+#include "SdIoScheduler.h"
 #include "fontIds.h"
 
 namespace {
+constexpr unsigned long percentJumpMs = 700;
 constexpr unsigned long goHomeMs = 1000;
 constexpr int statusBarMargin = 25;
 constexpr int progressBarMarginTop = 1;
@@ -20,7 +24,22 @@ constexpr size_t CHUNK_SIZE = 8 * 1024;  // 8KB chunk for reading
 
 // Cache file magic and version
 constexpr uint32_t CACHE_MAGIC = 0x54585449;  // "TXTI"
-constexpr uint8_t CACHE_VERSION = 2;          // Increment when cache format changes
+constexpr uint8_t CACHE_VERSION = 3;          // Increment when cache format changes
+
+// Fixed header size of the index cache file; page offset records follow as packed uint32_t,
+// so record i lives at INDEX_HEADER_SIZE + 4 * i and the page count is implied by file size
+constexpr size_t INDEX_HEADER_SIZE = 4 + 1 + 4 + 4 + 4 + 4 + 4 + 1;
+
+// Every Nth page offset is kept in RAM; the rest are read from the index file on demand
+constexpr int CHECKPOINT_INTERVAL = 16;
+
+// Compiled page records file: Page/PageGlyphRun records (the section-file page format) with a
+// trailing LUT, one record per page. Settings validation rides on index.bin - both files come out
+// of the same build pass - so the header only carries what the loader needs.
+constexpr uint32_t PAGES_MAGIC = 0x50545854;  // "TXTP"
+constexpr uint8_t PAGES_VERSION = 1;
+// Position of the LUT-offset field, patched after the records are streamed out
+constexpr size_t PAGES_LUT_FIELD_OFFSET = 4 + 1 + 4;
 }  // namespace
 
 void TxtReaderActivity::taskTrampoline(void* param) {
@@ -55,12 +74,17 @@ void TxtReaderActivity::onEnter() {
 
   renderingMutex = xSemaphoreCreateMutex();
 
+  // Page turns mostly preserve margins and chrome; the shadow lets the renderer skip or
+  // downgrade refreshes based on what actually changed
+  renderer.setFrameShadowEnabled(true);
+
   txt->setupCacheDir();
 
   // Save current txt as last opened file and add to recent books
   APP_STATE.openEpubPath = txt->getPath();
-  APP_STATE.saveToFile();
-  RECENT_BOOKS.addBook(txt->getPath(), "", "");
+  APP_STATE.markDirty();
+  RECENT_BOOKS.addBook(txt->getPath(), txt->getTitle(), "");
+  CACHE_GC.noteCacheUsed(txt->getCachePath());
 
   // Trigger first update
   updateRequired = true;
@@ -87,8 +111,16 @@ void TxtReaderActivity::onExit() {
   }
   vSemaphoreDelete(renderingMutex);
   renderingMutex = nullptr;
-  pageOffsets.clear();
+  // Release the 48KB frame shadow; the rest of the UI doesn't need differential flushes
+  renderer.setFrameShadowEnabled(false);
+  // Record final progress on the recent-books entry; this is also its write-behind flush point
+  if (txt && totalPages > 0) {
+    RECENT_BOOKS.updateProgress(txt->getPath(), static_cast<uint8_t>((currentPage + 1) * 100 / totalPages));
+  }
+  RECENT_BOOKS.flushIfDirty();
+  pageOffsetCheckpoints.clear();
   currentPageLines.clear();
+  compiledPage.reset();
   txt.reset();
 }
 
@@ -112,14 +144,18 @@ void TxtReaderActivity::loop() {
 
   // When long-press chapter skip is disabled, turn pages on press instead of release.
   const bool usePressForPageTurn = !SETTINGS.longPressChapterSkip;
-  const bool prevTriggered = usePressForPageTurn ? (mappedInput.wasPressed(MappedInputManager::Button::PageBack) ||
-                                                    mappedInput.wasPressed(MappedInputManager::Button::Left))
+  // Press-to-turn drains the coalesced page-turn queue (which includes hold-to-repeat events);
+  // release mode keeps the raw edges so held time can still mean the 10% jump below
+  const uint8_t queuedPrev = usePressForPageTurn ? mappedInput.takePageTurns(MappedInputManager::Button::PageBack) : 0;
+  const uint8_t queuedNext =
+      usePressForPageTurn ? mappedInput.takePageTurns(MappedInputManager::Button::PageForward) : 0;
+  const bool prevTriggered = usePressForPageTurn ? (queuedPrev > 0 || mappedInput.wasPressed(MappedInputManager::Button::Left))
                                                  : (mappedInput.wasReleased(MappedInputManager::Button::PageBack) ||
                                                     mappedInput.wasReleased(MappedInputManager::Button::Left));
   const bool powerPageTurn = SETTINGS.shortPwrBtn == CrossPointSettings::SHORT_PWRBTN::PAGE_TURN &&
                              mappedInput.wasReleased(MappedInputManager::Button::Power);
   const bool nextTriggered = usePressForPageTurn
-                                 ? (mappedInput.wasPressed(MappedInputManager::Button::PageForward) || powerPageTurn ||
+                                 ? (queuedNext > 0 || powerPageTurn ||
                                     mappedInput.wasPressed(MappedInputManager::Button::Right))
                                  : (mappedInput.wasReleased(MappedInputManager::Button::PageForward) || powerPageTurn ||
                                     mappedInput.wasReleased(MappedInputManager::Button::Right));
@@ -128,11 +164,28 @@ void TxtReaderActivity::loop() {
     return;
   }
 
+  // Plain text has no chapters, so a long press jumps 10% of the book instead
+  const bool percentJump = SETTINGS.longPressChapterSkip && mappedInput.getHeldTime() > percentJumpMs;
+  if (percentJump) {
+    const int step = totalPages / 10 > 0 ? totalPages / 10 : 1;
+    int target = nextTriggered ? currentPage + step : currentPage - step;
+    if (target < 0) target = 0;
+    if (target > totalPages - 1) target = totalPages - 1;
+    if (target != currentPage) {
+      currentPage = target;
+      updateRequired = true;
+    }
+    return;
+  }
+
+  // Coalesced queue turns land as one jump
   if (prevTriggered && currentPage > 0) {
-    currentPage--;
+    const int steps = queuedPrev > 1 ? queuedPrev : 1;
+    currentPage = currentPage > steps ? currentPage - steps : 0;
     updateRequired = true;
   } else if (nextTriggered && currentPage < totalPages - 1) {
-    currentPage++;
+    const int steps = queuedNext > 1 ? queuedNext : 1;
+    currentPage = currentPage + steps < totalPages - 1 ? currentPage + steps : totalPages - 1;
     updateRequired = true;
   }
 }
@@ -187,12 +240,13 @@ void TxtReaderActivity::initializeReader() {
   Serial.printf("[%lu] [TRS] Viewport: %dx%d, lines per page: %d\n", millis(), viewportWidth, viewportHeight,
                 linesPerPage);
 
-  // Try to load cached page index first
-  if (!loadPageIndexCache()) {
-    // Cache not found, build page index
+  // Try to load cached page index first; building writes the cache file as it goes
+  if (loadPageIndexCache()) {
+    // Compiled pages come from the same build pass, so the index's settings validation covers
+    // them; only the header's own integrity needs checking
+    loadCompiledPagesHeader();
+  } else {
     buildPageIndex();
-    // Save to cache for next time
-    savePageIndexCache();
   }
 
   // Load saved progress
@@ -202,15 +256,60 @@ void TxtReaderActivity::initializeReader() {
 }
 
 void TxtReaderActivity::buildPageIndex() {
-  pageOffsets.clear();
-  pageOffsets.push_back(0);  // First page starts at offset 0
+  pageOffsetCheckpoints.clear();
+  indexOnSd = false;
+  pagesOnSd = false;
+  pagesLutOffset = 0;
 
   size_t offset = 0;
   const size_t fileSize = txt->getFileSize();
   int lastProgressPercent = -1;
+  uint32_t pageCount = 0;
 
   Serial.printf("[%lu] [TRS] Building page index for %zu bytes...\n", millis(), fileSize);
 
+  // Offset records stream straight to the cache file so the full table never sits in RAM
+  FsFile indexFile;
+  const bool writingIndex = SdMan.openFileForWrite("TRS", txt->getCachePath() + "/index.bin", indexFile);
+  if (writingIndex) {
+    serialization::writePod(indexFile, CACHE_MAGIC);
+    serialization::writePod(indexFile, CACHE_VERSION);
+    serialization::writePod(indexFile, static_cast<uint32_t>(fileSize));
+    serialization::writePod(indexFile, static_cast<int32_t>(viewportWidth));
+    serialization::writePod(indexFile, static_cast<int32_t>(linesPerPage));
+    serialization::writePod(indexFile, static_cast<int32_t>(cachedFontId));
+    serialization::writePod(indexFile, static_cast<int32_t>(cachedScreenMargin));
+    serialization::writePod(indexFile, cachedParagraphAlignment);
+  } else {
+    Serial.printf("[%lu] [TRS] Failed to open page index cache for write\n", millis());
+  }
+
+  // Compiled page records stream out in the same pass; the wrapped lines are in hand anyway.
+  // LUT offsets collect in RAM during the build (like Section's) and land after the records.
+  FsFile pagesFile;
+  std::vector<uint32_t> pageLut;
+  const bool writingPages = SdMan.openFileForWrite("TRS", txt->getCachePath() + "/pages.bin", pagesFile);
+  if (writingPages) {
+    serialization::writePod(pagesFile, PAGES_MAGIC);
+    serialization::writePod(pagesFile, PAGES_VERSION);
+    serialization::writePod(pagesFile, static_cast<uint32_t>(fileSize));
+    serialization::writePod(pagesFile, static_cast<uint32_t>(0));  // LUT offset, patched below
+  } else {
+    Serial.printf("[%lu] [TRS] Failed to open compiled pages file for write\n", millis());
+  }
+
+  auto emitPageOffset = [&](const size_t pageOffset) {
+    if (writingIndex) {
+      serialization::writePod(indexFile, static_cast<uint32_t>(pageOffset));
+    }
+    if (pageCount % CHECKPOINT_INTERVAL == 0) {
+      pageOffsetCheckpoints.push_back(static_cast<uint32_t>(pageOffset));
+    }
+    pageCount++;
+  };
+
+  emitPageOffset(0);  // First page starts at offset 0
+
   // Progress bar dimensions (matching EpubReaderActivity style)
   constexpr int barWidth = 200;
   constexpr int barHeight = 10;
@@ -243,9 +342,13 @@ void TxtReaderActivity::buildPageIndex() {
       break;
     }
 
+    if (writingPages) {
+      pageLut.push_back(appendCompiledPage(pagesFile, tempLines));
+    }
+
     offset = nextOffset;
     if (offset < fileSize) {
-      pageOffsets.push_back(offset);
+      emitPageOffset(offset);
     }
 
     // Update progress bar every 10% (matching EpubReaderActivity logic)
@@ -256,17 +359,130 @@ void TxtReaderActivity::buildPageIndex() {
       // Fill progress bar
       const int fillWidth = (barWidth - 2) * progressPercent / 100;
       renderer.fillRect(barX + 1, barY + 1, fillWidth, barHeight - 2, true);
-      renderer.displayBuffer(HalDisplay::FAST_REFRESH);
+      renderer.displayDirty();
     }
 
     // Yield to other tasks periodically
-    if (pageOffsets.size() % 20 == 0) {
+    if (pageCount % 20 == 0) {
       vTaskDelay(1);
     }
   }
 
-  totalPages = pageOffsets.size();
-  Serial.printf("[%lu] [TRS] Built page index: %d pages\n", millis(), totalPages);
+  if (writingIndex) {
+    indexFile.close();
+    indexOnSd = true;
+  }
+
+  if (writingPages) {
+    const uint32_t lutOffset = pagesFile.position();
+    for (const uint32_t recordOffset : pageLut) {
+      serialization::writePod(pagesFile, recordOffset);
+    }
+    pagesFile.seek(PAGES_LUT_FIELD_OFFSET);
+    serialization::writePod(pagesFile, lutOffset);
+    pagesFile.close();
+    pagesLutOffset = lutOffset;
+    pagesOnSd = true;
+  }
+
+  totalPages = pageCount;
+  Serial.printf("[%lu] [TRS] Built page index: %d pages (%zu checkpoints in RAM)\n", millis(), totalPages,
+                pageOffsetCheckpoints.size());
+}
+
+uint32_t TxtReaderActivity::appendCompiledPage(FsFile& pagesFile, const std::vector<std::string>& lines) const {
+  const auto recordOffset = static_cast<uint32_t>(pagesFile.position());
+  const int lineHeight = renderer.getLineHeight(cachedFontId);
+
+  // One glyph run per wrapped line, with the alignment x already resolved; coordinates are
+  // content-relative so the renderer applies the oriented margins as offsets
+  Page page;
+  int y = 0;
+  for (const auto& line : lines) {
+    if (!line.empty()) {
+      const int lineWidth = renderer.getTextWidth(cachedFontId, line.c_str());
+      int x = 0;
+      switch (cachedParagraphAlignment) {
+        case CrossPointSettings::CENTER_ALIGN:
+          x = (viewportWidth - lineWidth) / 2;
+          break;
+        case CrossPointSettings::RIGHT_ALIGN:
+          x = viewportWidth - lineWidth;
+          break;
+        default:
+          break;  // Left and justified both render from the left margin
+      }
+      GlyphRunCps cps;
+      utf8ForEachCodepoint(line.c_str(), [&cps](const uint32_t cp, uint32_t) { cps.push_back(cp); });
+      if (!cps.empty()) {
+        page.elements.push_back(std::allocate_shared<PageGlyphRun>(
+            ParseArenaAllocator<PageGlyphRun>(), std::move(cps), EpdFontFamily::REGULAR,
+            static_cast<uint16_t>(lineWidth), static_cast<int16_t>(x), static_cast<int16_t>(y)));
+      }
+    }
+    y += lineHeight;
+  }
+  page.serialize(pagesFile);
+  return recordOffset;
+}
+
+bool TxtReaderActivity::loadCompiledPagesHeader() {
+  pagesOnSd = false;
+  pagesLutOffset = 0;
+
+  FsFile f;
+  if (!SdMan.openFileForRead("TRS", txt->getCachePath() + "/pages.bin", f)) {
+    return false;
+  }
+
+  uint32_t magic = 0, fileSize = 0, lutOffset = 0;
+  uint8_t version = 0;
+  serialization::readPod(f, magic);
+  serialization::readPod(f, version);
+  serialization::readPod(f, fileSize);
+  serialization::readPod(f, lutOffset);
+  const size_t pagesFileSize = f.size();
+  f.close();
+
+  // An unpatched LUT offset means the build never finished; the LUT must also cover every page
+  if (magic != PAGES_MAGIC || version != PAGES_VERSION || fileSize != txt->getFileSize() || lutOffset == 0 ||
+      pagesFileSize < lutOffset + sizeof(uint32_t) * totalPages) {
+    Serial.printf("[%lu] [TRS] Compiled pages file invalid; re-wrapping at render time\n", millis());
+    return false;
+  }
+
+  pagesLutOffset = lutOffset;
+  pagesOnSd = true;
+  return true;
+}
+
+std::unique_ptr<Page> TxtReaderActivity::loadCompiledPage(const int page) const {
+  if (!pagesOnSd || page < 0 || page >= totalPages) {
+    return nullptr;
+  }
+
+  FsFile f;
+  if (!SdMan.openFileForRead("TRS", txt->getCachePath() + "/pages.bin", f)) {
+    return nullptr;
+  }
+
+  // Static window rather than stack: the display task runs a small stack and holds the
+  // rendering mutex here, matching Section::loadPageFromSectionFile()
+  static uint8_t pageReadWindow[8 * 1024];
+  BufferedFileReader reader(f, pageReadWindow, sizeof(pageReadWindow));
+
+  reader.seek(pagesLutOffset + sizeof(uint32_t) * page);
+  uint32_t recordOffset = 0;
+  reader.pod(recordOffset);
+  if (recordOffset == 0) {
+    f.close();
+    return nullptr;
+  }
+  // Pre-fill the window at the page record so the element loop decodes from RAM
+  reader.readAhead(recordOffset);
+  auto loaded = Page::deserialize(reader);
+  f.close();
+  return loaded;
 }
 
 bool TxtReaderActivity::loadPageAtOffset(size_t offset, std::vector<std::string>& outLines, size_t& nextOffset) {
@@ -395,10 +611,53 @@ bool TxtReaderActivity::loadPageAtOffset(size_t offset, std::vector<std::string>
   return !outLines.empty();
 }
 
+bool TxtReaderActivity::pageOffsetFor(const int page, size_t& outOffset) {
+  if (page < 0 || page >= totalPages || pageOffsetCheckpoints.empty()) {
+    return false;
+  }
+
+  const size_t checkpoint = page / CHECKPOINT_INTERVAL;
+  if (page % CHECKPOINT_INTERVAL == 0 && checkpoint < pageOffsetCheckpoints.size()) {
+    outOffset = pageOffsetCheckpoints[checkpoint];
+    return true;
+  }
+
+  // Exact offset lives in the index file at a fixed record position
+  if (indexOnSd) {
+    FsFile f;
+    if (SdMan.openFileForRead("TRS", txt->getCachePath() + "/index.bin", f)) {
+      if (f.seek(INDEX_HEADER_SIZE + sizeof(uint32_t) * page)) {
+        uint32_t offset;
+        serialization::readPod(f, offset);
+        f.close();
+        outOffset = offset;
+        return true;
+      }
+      f.close();
+    }
+  }
+
+  // Index file unavailable: re-wrap forward from the nearest checkpoint (bounded to
+  // CHECKPOINT_INTERVAL - 1 pages)
+  const size_t startCheckpoint = std::min(checkpoint, pageOffsetCheckpoints.size() - 1);
+  size_t offset = pageOffsetCheckpoints[startCheckpoint];
+  std::vector<std::string> tempLines;
+  for (int p = static_cast<int>(startCheckpoint) * CHECKPOINT_INTERVAL; p < page; p++) {
+    size_t nextOffset = offset;
+    if (!loadPageAtOffset(offset, tempLines, nextOffset) || nextOffset <= offset) {
+      return false;
+    }
+    offset = nextOffset;
+  }
+  outOffset = offset;
+  return true;
+}
+
 void TxtReaderActivity::renderScreen() {
   if (!txt) {
     return;
   }
+  const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::UI);
 
   // Initialize reader if not done
   if (!initialized) {
@@ -408,7 +667,7 @@ void TxtReaderActivity::renderScreen() {
     initializeReader();
   }
 
-  if (pageOffsets.empty()) {
+  if (pageOffsetCheckpoints.empty()) {
     renderer.clearScreen();
     renderer.drawCenteredText(UI_12_FONT_ID, 300, "Empty file", true, EpdFontFamily::BOLD);
     renderer.displayBuffer();
@@ -419,11 +678,19 @@ void TxtReaderActivity::renderScreen() {
   if (currentPage < 0) currentPage = 0;
   if (currentPage >= totalPages) currentPage = totalPages - 1;
 
-  // Load current page content
-  size_t offset = pageOffsets[currentPage];
-  size_t nextOffset;
+  // Load current page content: compiled records first (one LUT seek + deserialize, no
+  // re-wrapping), falling back to re-wrapping from the byte offset when they're unavailable
   currentPageLines.clear();
-  loadPageAtOffset(offset, currentPageLines, nextOffset);
+  compiledPage = loadCompiledPage(currentPage);
+  if (!compiledPage) {
+    size_t offset = 0;
+    if (!pageOffsetFor(currentPage, offset)) {
+      Serial.printf("[%lu] [TRS] Failed to resolve offset for page %d\n", millis(), currentPage);
+      return;
+    }
+    size_t nextOffset;
+    loadPageAtOffset(offset, currentPageLines, nextOffset);
+  }
 
   renderer.clearScreen();
   renderPage();
@@ -446,6 +713,11 @@ void TxtReaderActivity::renderPage() {
 
   // Render text lines with alignment
   auto renderLines = [&]() {
+    if (compiledPage) {
+      // Pre-positioned glyph runs: alignment x and line y were baked in at index time
+      compiledPage->render(renderer, cachedFontId, orientedMarginLeft, orientedMarginTop);
+      return;
+    }
     int y = orientedMarginTop;
     for (const auto& line : currentPageLines) {
       if (!line.empty()) {
@@ -496,18 +768,24 @@ void TxtReaderActivity::renderPage() {
     // Save BW buffer for restoration after grayscale pass
     renderer.storeBwBuffer();
 
-    renderer.clearScreen(0x00);
-    renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
-    renderLines();
-    renderer.copyGrayscaleLsbBuffers();
-
-    renderer.clearScreen(0x00);
-    renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
-    renderLines();
-    renderer.copyGrayscaleMsbBuffers();
-
-    renderer.displayGrayBuffer();
-    renderer.setRenderMode(GfxRenderer::BW);
+    if (renderer.beginGrayscalePass()) {
+      // One traversal writes both gray planes
+      renderLines();
+      renderer.flushGrayscalePass();
+    } else {
+      renderer.clearScreen(0x00);
+      renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
+      renderLines();
+      renderer.copyGrayscaleLsbBuffers();
+
+      renderer.clearScreen(0x00);
+      renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
+      renderLines();
+      renderer.copyGrayscaleMsbBuffers();
+
+      renderer.displayGrayBuffer();
+      renderer.setRenderMode(GfxRenderer::BW);
+    }
 
     // Restore BW buffer
     renderer.restoreBwBuffer();
@@ -615,8 +893,10 @@ bool TxtReaderActivity::loadPageIndexCache() {
   // - int32_t: font ID (to invalidate cache on font change)
   // - int32_t: screen margin (to invalidate cache on margin change)
   // - uint8_t: paragraph alignment (to invalidate cache on alignment change)
-  // - uint32_t: total pages count
-  // - N * uint32_t: page offsets
+  // - N * uint32_t: page offsets (count implied by file size so the builder can stream records)
+  //
+  // Only every CHECKPOINT_INTERVAL-th offset is loaded into RAM; pageOffsetFor() reads the
+  // rest from this file on demand.
 
   std::string cachePath = txt->getCachePath() + "/index.bin";
   FsFile f;
@@ -690,49 +970,35 @@ bool TxtReaderActivity::loadPageIndexCache() {
     return false;
   }
 
-  uint32_t numPages;
-  serialization::readPod(f, numPages);
+  const size_t indexSize = f.size();
+  if (indexSize < INDEX_HEADER_SIZE || (indexSize - INDEX_HEADER_SIZE) % sizeof(uint32_t) != 0) {
+    Serial.printf("[%lu] [TRS] Cache record table truncated, rebuilding\n", millis());
+    f.close();
+    return false;
+  }
+
+  const uint32_t numPages = (indexSize - INDEX_HEADER_SIZE) / sizeof(uint32_t);
+  if (numPages == 0) {
+    f.close();
+    return false;
+  }
 
-  // Read page offsets
-  pageOffsets.clear();
-  pageOffsets.reserve(numPages);
+  // Keep every CHECKPOINT_INTERVAL-th offset in RAM; the rest stay on SD
+  pageOffsetCheckpoints.clear();
+  pageOffsetCheckpoints.reserve(numPages / CHECKPOINT_INTERVAL + 1);
 
   for (uint32_t i = 0; i < numPages; i++) {
     uint32_t offset;
     serialization::readPod(f, offset);
-    pageOffsets.push_back(offset);
+    if (i % CHECKPOINT_INTERVAL == 0) {
+      pageOffsetCheckpoints.push_back(offset);
+    }
   }
 
   f.close();
-  totalPages = pageOffsets.size();
-  Serial.printf("[%lu] [TRS] Loaded page index cache: %d pages\n", millis(), totalPages);
+  totalPages = numPages;
+  indexOnSd = true;
+  Serial.printf("[%lu] [TRS] Loaded page index cache: %d pages (%zu checkpoints in RAM)\n", millis(), totalPages,
+                pageOffsetCheckpoints.size());
   return true;
 }
-
-void TxtReaderActivity::savePageIndexCache() const {
-  std::string cachePath = txt->getCachePath() + "/index.bin";
-  FsFile f;
-  if (!SdMan.openFileForWrite("TRS", cachePath, f)) {
-    Serial.printf("[%lu] [TRS] Failed to save page index cache\n", millis());
-    return;
-  }
-
-  // Write header using serialization module
-  serialization::writePod(f, CACHE_MAGIC);
-  serialization::writePod(f, CACHE_VERSION);
-  serialization::writePod(f, static_cast<uint32_t>(txt->getFileSize()));
-  serialization::writePod(f, static_cast<int32_t>(viewportWidth));
-  serialization::writePod(f, static_cast<int32_t>(linesPerPage));
-  serialization::writePod(f, static_cast<int32_t>(cachedFontId));
-  serialization::writePod(f, static_cast<int32_t>(cachedScreenMargin));
-  serialization::writePod(f, cachedParagraphAlignment);
-  serialization::writePod(f, static_cast<uint32_t>(pageOffsets.size()));
-
-  // Write page offsets
-  for (size_t offset : pageOffsets) {
-    serialization::writePod(f, static_cast<uint32_t>(offset));
-  }
-
-  f.close();
-  Serial.printf("[%lu] [TRS] Saved page index cache: %d pages\n", millis(), totalPages);
-}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Epub/Page.h>
 #include <Txt.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
@@ -21,8 +22,16 @@ class TxtReaderActivity final : public ActivityWithSubactivity {
   const std::function<void()> onGoBack;
   const std::function<void()> onGoHome;
 
-  // Streaming text reader - stores file offsets for each page
-  std::vector<size_t> pageOffsets;  // File offset for start of each page
+  // Streaming text reader. The full per-page offset table lives in the index cache file on SD;
+  // RAM only holds every CHECKPOINT_INTERVAL-th offset so a 5MB book doesn't cost ~20KB of heap.
+  std::vector<uint32_t> pageOffsetCheckpoints;
+  bool indexOnSd = false;  // True when index.bin holds the full record table for exact lookups
+  // Compiled page records (same Page/PageGlyphRun format section files use) written alongside
+  // the index: each page's wrapped lines stored as pre-positioned glyph runs, so a page view is
+  // one LUT seek plus a record deserialize with no re-wrapping or measurement
+  bool pagesOnSd = false;
+  uint32_t pagesLutOffset = 0;
+  std::unique_ptr<Page> compiledPage;
   std::vector<std::string> currentPageLines;
   int linesPerPage = 0;
   int viewportWidth = 0;
@@ -41,9 +50,12 @@ class TxtReaderActivity final : public ActivityWithSubactivity {
 
   void initializeReader();
   bool loadPageAtOffset(size_t offset, std::vector<std::string>& outLines, size_t& nextOffset);
+  bool pageOffsetFor(int page, size_t& outOffset);
   void buildPageIndex();
   bool loadPageIndexCache();
-  void savePageIndexCache() const;
+  uint32_t appendCompiledPage(FsFile& pagesFile, const std::vector<std::string>& lines) const;
+  bool loadCompiledPagesHeader();
+  std::unique_ptr<Page> loadCompiledPage(int page) const;
   void saveProgress() const;
   void loadProgress();
 
@@ -57,4 +69,5 @@ class TxtReaderActivity final : public ActivityWithSubactivity {
   void onEnter() override;
   void onExit() override;
   void loop() override;
+  bool isIdle() override { return subActivity ? subActivity->isIdle() : !updateRequired; }
 };
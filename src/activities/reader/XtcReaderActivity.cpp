@@ -9,12 +9,15 @@
 
 #include <FsHelpers.h>
 #include <GfxRenderer.h>
+#include <HeapMonitor.h>
 #include <SDCardManager.h>
 
+#include "CacheGc.h"
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
 #include "MappedInputManager.h"
 #include "RecentBooksStore.h"
+#include "SdIoScheduler.h"
 #include "XtcReaderChapterSelectionActivity.h"
 #include "fontIds.h"
 
@@ -37,6 +40,10 @@ void XtcReaderActivity::onEnter() {
 
   renderingMutex = xSemaphoreCreateMutex();
 
+  // Page turns mostly preserve margins and chrome; the shadow lets the renderer skip or
+  // downgrade refreshes based on what actually changed
+  renderer.setFrameShadowEnabled(true);
+
   xtc->setupCacheDir();
 
   // Load saved progress
@@ -44,8 +51,9 @@ void XtcReaderActivity::onEnter() {
 
   // Save current XTC as last opened book and add to recent books
   APP_STATE.openEpubPath = xtc->getPath();
-  APP_STATE.saveToFile();
+  APP_STATE.markDirty();
   RECENT_BOOKS.addBook(xtc->getPath(), xtc->getTitle(), xtc->getAuthor());
+  CACHE_GC.noteCacheUsed(xtc->getCachePath());
 
   // Trigger first update
   updateRequired = true;
@@ -56,11 +64,31 @@ void XtcReaderActivity::onEnter() {
               1,                  // Priority
               &displayTaskHandle  // Task handle
   );
+
+  // The prefetched blob is up to 96KB for 2-bit books; under memory pressure it's the first
+  // thing to go and the next paint simply re-schedules it. Runs on whichever task hit
+  // pressure, so it skips rather than stalls behind an in-flight render.
+  HEAP_MON.registerReclaimer("xtc-prefetch", [this](HeapMonitor::Pressure) -> size_t {
+    if (renderingMutex == nullptr || xSemaphoreTake(renderingMutex, pdMS_TO_TICKS(50)) != pdTRUE) {
+      return 0;
+    }
+    const size_t freed = prefetchBuffer ? pageBufferSize() : 0;
+    dropPrefetch();
+    xSemaphoreGive(renderingMutex);
+    return freed;
+  });
 }
 
 void XtcReaderActivity::onExit() {
   ActivityWithSubactivity::onExit();
 
+  // Unregister before tearing down the mutex the reclaimer takes
+  HEAP_MON.unregisterReclaimer("xtc-prefetch");
+
+  // The prefetch job captures `this` and takes the rendering mutex; let it wind down first
+  TASK_QUEUE.cancelAndWait(prefetchJob);
+  prefetchJob = nullptr;
+
   // Wait until not rendering to delete task
   xSemaphoreTake(renderingMutex, portMAX_DELAY);
   if (displayTaskHandle) {
@@ -69,6 +97,14 @@ void XtcReaderActivity::onExit() {
   }
   vSemaphoreDelete(renderingMutex);
   renderingMutex = nullptr;
+  dropPrefetch();
+  // Release the 48KB frame shadow; the rest of the UI doesn't need differential flushes
+  renderer.setFrameShadowEnabled(false);
+  // Record final progress on the recent-books entry; this is also its write-behind flush point
+  if (xtc) {
+    RECENT_BOOKS.updateProgress(xtc->getPath(), xtc->calculateProgress(currentPage));
+  }
+  RECENT_BOOKS.flushIfDirty();
   xtc.reset();
 }
 
@@ -113,14 +149,18 @@ void XtcReaderActivity::loop() {
 
   // When long-press chapter skip is disabled, turn pages on press instead of release.
   const bool usePressForPageTurn = !SETTINGS.longPressChapterSkip;
-  const bool prevTriggered = usePressForPageTurn ? (mappedInput.wasPressed(MappedInputManager::Button::PageBack) ||
-                                                    mappedInput.wasPressed(MappedInputManager::Button::Left))
+  // Press-to-turn drains the coalesced page-turn queue (which includes hold-to-repeat events);
+  // release mode keeps the raw edges so held time can still mean the 10-page skip below
+  const uint8_t queuedPrev = usePressForPageTurn ? mappedInput.takePageTurns(MappedInputManager::Button::PageBack) : 0;
+  const uint8_t queuedNext =
+      usePressForPageTurn ? mappedInput.takePageTurns(MappedInputManager::Button::PageForward) : 0;
+  const bool prevTriggered = usePressForPageTurn ? (queuedPrev > 0 || mappedInput.wasPressed(MappedInputManager::Button::Left))
                                                  : (mappedInput.wasReleased(MappedInputManager::Button::PageBack) ||
                                                     mappedInput.wasReleased(MappedInputManager::Button::Left));
   const bool powerPageTurn = SETTINGS.shortPwrBtn == CrossPointSettings::SHORT_PWRBTN::PAGE_TURN &&
                              mappedInput.wasReleased(MappedInputManager::Button::Power);
   const bool nextTriggered = usePressForPageTurn
-                                 ? (mappedInput.wasPressed(MappedInputManager::Button::PageForward) || powerPageTurn ||
+                                 ? (queuedNext > 0 || powerPageTurn ||
                                     mappedInput.wasPressed(MappedInputManager::Button::Right))
                                  : (mappedInput.wasReleased(MappedInputManager::Button::PageForward) || powerPageTurn ||
                                     mappedInput.wasReleased(MappedInputManager::Button::Right));
@@ -137,7 +177,9 @@ void XtcReaderActivity::loop() {
   }
 
   const bool skipPages = SETTINGS.longPressChapterSkip && mappedInput.getHeldTime() > skipPageMs;
-  const int skipAmount = skipPages ? 10 : 1;
+  // Coalesced queue turns land as one jump in press-to-turn mode
+  const int queuedSteps = prevTriggered ? (queuedPrev > 1 ? queuedPrev : 1) : (queuedNext > 1 ? queuedNext : 1);
+  const int skipAmount = skipPages ? 10 : queuedSteps;
 
   if (prevTriggered) {
     if (currentPage >= static_cast<uint32_t>(skipAmount)) {
@@ -171,6 +213,7 @@ void XtcReaderActivity::renderScreen() {
   if (!xtc) {
     return;
   }
+  const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::UI);
 
   // Bounds check
   if (currentPage >= xtc->getPageCount()) {
@@ -183,6 +226,8 @@ void XtcReaderActivity::renderScreen() {
 
   renderPage();
   saveProgress();
+  // With the page on glass, line up the next blob so the following forward turn skips the SD read
+  schedulePrefetch();
 }
 
 void XtcReaderActivity::renderPage() {
@@ -190,35 +235,35 @@ void XtcReaderActivity::renderPage() {
   const uint16_t pageHeight = xtc->getPageHeight();
   const uint8_t bitDepth = xtc->getBitDepth();
 
-  // Calculate buffer size for one page
-  // XTG (1-bit): Row-major, ((width+7)/8) * height bytes
-  // XTH (2-bit): Two bit planes, column-major, ((width * height + 7) / 8) * 2 bytes
-  size_t pageBufferSize;
-  if (bitDepth == 2) {
-    pageBufferSize = ((static_cast<size_t>(pageWidth) * pageHeight + 7) / 8) * 2;
-  } else {
-    pageBufferSize = ((pageWidth + 7) / 8) * pageHeight;
-  }
+  const size_t bufferSize = pageBufferSize();
 
-  // Allocate page buffer
-  uint8_t* pageBuffer = static_cast<uint8_t*>(malloc(pageBufferSize));
-  if (!pageBuffer) {
-    Serial.printf("[%lu] [XTR] Failed to allocate page buffer (%lu bytes)\n", millis(), pageBufferSize);
-    renderer.clearScreen();
-    renderer.drawCenteredText(UI_12_FONT_ID, 300, "Memory error", true, EpdFontFamily::BOLD);
-    renderer.displayBuffer();
-    return;
-  }
+  uint8_t* pageBuffer;
+  if (prefetchBuffer && prefetchedPage == currentPage) {
+    // Prefetch hit: take ownership of the blob already in RAM and skip the SD read entirely
+    pageBuffer = prefetchBuffer;
+    prefetchBuffer = nullptr;
+    prefetchedPage = UINT32_MAX;
+  } else {
+    // Allocate page buffer
+    pageBuffer = static_cast<uint8_t*>(malloc(bufferSize));
+    if (!pageBuffer) {
+      Serial.printf("[%lu] [XTR] Failed to allocate page buffer (%lu bytes)\n", millis(), bufferSize);
+      renderer.clearScreen();
+      renderer.drawCenteredText(UI_12_FONT_ID, 300, "Memory error", true, EpdFontFamily::BOLD);
+      renderer.displayBuffer();
+      return;
+    }
 
-  // Load page data
-  size_t bytesRead = xtc->loadPage(currentPage, pageBuffer, pageBufferSize);
-  if (bytesRead == 0) {
-    Serial.printf("[%lu] [XTR] Failed to load page %lu\n", millis(), currentPage);
-    free(pageBuffer);
-    renderer.clearScreen();
-    renderer.drawCenteredText(UI_12_FONT_ID, 300, "Page load error", true, EpdFontFamily::BOLD);
-    renderer.displayBuffer();
-    return;
+    // Load page data
+    const size_t bytesRead = xtc->loadPage(currentPage, pageBuffer, bufferSize);
+    if (bytesRead == 0) {
+      Serial.printf("[%lu] [XTR] Failed to load page %lu\n", millis(), currentPage);
+      free(pageBuffer);
+      renderer.clearScreen();
+      renderer.drawCenteredText(UI_12_FONT_ID, 300, "Page load error", true, EpdFontFamily::BOLD);
+      renderer.displayBuffer();
+      return;
+    }
   }
 
   // Clear screen first
@@ -253,23 +298,17 @@ void XtcReaderActivity::renderPage() {
     };
 
     // Optimized grayscale rendering without storeBwBuffer (saves 48KB peak memory)
-    // Flow: BW display → LSB/MSB passes → grayscale display → re-render BW for next frame
-
-    // Count pixel distribution for debugging
-    uint32_t pixelCounts[4] = {0, 0, 0, 0};
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        pixelCounts[getPixelValue(x, y)]++;
-      }
-    }
-    Serial.printf("[%lu] [XTR] Pixel distribution: White=%lu, DarkGrey=%lu, LightGrey=%lu, Black=%lu\n", millis(),
-                  pixelCounts[0], pixelCounts[1], pixelCounts[2], pixelCounts[3]);
+    // Flow: BW display → LSB/MSB passes → grayscale display → re-render BW for next frame.
+    // Each pass tries the direct byte-wise blit first; the per-pixel loops only run for
+    // non-panel-sized pages or rotated orientations.
 
     // Pass 1: BW buffer - draw all non-white pixels as black
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) >= 1) {
-          renderer.drawPixel(x, y, true);
+    if (!xtc->blitPageToBuffer(renderer, pageBuffer, Xtc::PagePass::BW)) {
+      for (uint16_t y = 0; y < pageHeight; y++) {
+        for (uint16_t x = 0; x < pageWidth; x++) {
+          if (getPixelValue(x, y) >= 1) {
+            renderer.drawPixel(x, y, true);
+          }
         }
       }
     }
@@ -286,10 +325,12 @@ void XtcReaderActivity::renderPage() {
     // Pass 2: LSB buffer - mark DARK gray only (XTH value 1)
     // In LUT: 0 bit = apply gray effect, 1 bit = untouched
     renderer.clearScreen(0x00);
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) == 1) {  // Dark grey only
-          renderer.drawPixel(x, y, false);
+    if (!xtc->blitPageToBuffer(renderer, pageBuffer, Xtc::PagePass::GRAY_LSB)) {
+      for (uint16_t y = 0; y < pageHeight; y++) {
+        for (uint16_t x = 0; x < pageWidth; x++) {
+          if (getPixelValue(x, y) == 1) {  // Dark grey only
+            renderer.drawPixel(x, y, false);
+          }
         }
       }
     }
@@ -298,11 +339,13 @@ void XtcReaderActivity::renderPage() {
     // Pass 3: MSB buffer - mark LIGHT AND DARK gray (XTH value 1 or 2)
     // In LUT: 0 bit = apply gray effect, 1 bit = untouched
     renderer.clearScreen(0x00);
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        const uint8_t pv = getPixelValue(x, y);
-        if (pv == 1 || pv == 2) {  // Dark grey or Light grey
-          renderer.drawPixel(x, y, false);
+    if (!xtc->blitPageToBuffer(renderer, pageBuffer, Xtc::PagePass::GRAY_MSB)) {
+      for (uint16_t y = 0; y < pageHeight; y++) {
+        for (uint16_t x = 0; x < pageWidth; x++) {
+          const uint8_t pv = getPixelValue(x, y);
+          if (pv == 1 || pv == 2) {  // Dark grey or Light grey
+            renderer.drawPixel(x, y, false);
+          }
         }
       }
     }
@@ -313,10 +356,12 @@ void XtcReaderActivity::renderPage() {
 
     // Pass 4: Re-render BW to framebuffer (restore for next frame, instead of restoreBwBuffer)
     renderer.clearScreen();
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) >= 1) {
-          renderer.drawPixel(x, y, true);
+    if (!xtc->blitPageToBuffer(renderer, pageBuffer, Xtc::PagePass::BW)) {
+      for (uint16_t y = 0; y < pageHeight; y++) {
+        for (uint16_t x = 0; x < pageWidth; x++) {
+          if (getPixelValue(x, y) >= 1) {
+            renderer.drawPixel(x, y, true);
+          }
         }
       }
     }
@@ -331,19 +376,21 @@ void XtcReaderActivity::renderPage() {
     return;
   } else {
     // 1-bit mode: 8 pixels per byte, MSB first
-    const size_t srcRowBytes = (pageWidth + 7) / 8;  // 60 bytes for 480 width
+    if (!xtc->blitPageToBuffer(renderer, pageBuffer)) {
+      const size_t srcRowBytes = (pageWidth + 7) / 8;  // 60 bytes for 480 width
 
-    for (uint16_t srcY = 0; srcY < maxSrcY; srcY++) {
-      const size_t srcRowStart = srcY * srcRowBytes;
+      for (uint16_t srcY = 0; srcY < maxSrcY; srcY++) {
+        const size_t srcRowStart = srcY * srcRowBytes;
 
-      for (uint16_t srcX = 0; srcX < pageWidth; srcX++) {
-        // Read source pixel (MSB first, bit 7 = leftmost pixel)
-        const size_t srcByte = srcRowStart + srcX / 8;
-        const size_t srcBit = 7 - (srcX % 8);
-        const bool isBlack = !((pageBuffer[srcByte] >> srcBit) & 1);  // XTC: 0 = black, 1 = white
+        for (uint16_t srcX = 0; srcX < pageWidth; srcX++) {
+          // Read source pixel (MSB first, bit 7 = leftmost pixel)
+          const size_t srcByte = srcRowStart + srcX / 8;
+          const size_t srcBit = 7 - (srcX % 8);
+          const bool isBlack = !((pageBuffer[srcByte] >> srcBit) & 1);  // XTC: 0 = black, 1 = white
 
-        if (isBlack) {
-          renderer.drawPixel(srcX, srcY, true);
+          if (isBlack) {
+            renderer.drawPixel(srcX, srcY, true);
+          }
         }
       }
     }
@@ -367,6 +414,52 @@ void XtcReaderActivity::renderPage() {
                 bitDepth);
 }
 
+// Buffer size for one page blob
+// XTG (1-bit): Row-major, ((width+7)/8) * height bytes
+// XTH (2-bit): Two bit planes, column-major, ((width * height + 7) / 8) * 2 bytes
+size_t XtcReaderActivity::pageBufferSize() const {
+  const uint16_t pageWidth = xtc->getPageWidth();
+  const uint16_t pageHeight = xtc->getPageHeight();
+  if (xtc->getBitDepth() == 2) {
+    return ((static_cast<size_t>(pageWidth) * pageHeight + 7) / 8) * 2;
+  }
+  return ((pageWidth + 7) / 8) * pageHeight;
+}
+
+void XtcReaderActivity::schedulePrefetch() {
+  const uint32_t target = currentPage + 1;
+  if (target >= xtc->getPageCount() || prefetchedPage == target) {
+    return;
+  }
+  prefetchJob = TASK_QUEUE.enqueue(
+      "XtcPrefetch",
+      [this, target](const AsyncTaskQueue::Job& job) {
+        xSemaphoreTake(renderingMutex, portMAX_DELAY);
+        // A turn that landed while this job was queued repaints and re-schedules; don't race it
+        if (!job.isCancelled() && !updateRequired && prefetchedPage != target) {
+          const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::PREFETCH);
+          prefetchedPage = UINT32_MAX;  // The buffer is garbage until the load lands
+          const size_t size = pageBufferSize();
+          if (!prefetchBuffer) {
+            prefetchBuffer = static_cast<uint8_t*>(malloc(size));
+          }
+          if (prefetchBuffer && xtc->loadPage(target, prefetchBuffer, size) > 0) {
+            prefetchedPage = target;
+          } else {
+            dropPrefetch();
+          }
+        }
+        xSemaphoreGive(renderingMutex);
+      },
+      AsyncTaskQueue::Priority::LOW);
+}
+
+void XtcReaderActivity::dropPrefetch() {
+  free(prefetchBuffer);
+  prefetchBuffer = nullptr;
+  prefetchedPage = UINT32_MAX;
+}
+
 void XtcReaderActivity::saveProgress() const {
   FsFile f;
   if (SdMan.openFileForWrite("XTR", xtc->getCachePath() + "/progress.bin", f)) {
@@ -12,6 +12,7 @@
 #include <freertos/semphr.h>
 #include <freertos/task.h>
 
+#include "AsyncTaskQueue.h"
 #include "activities/ActivityWithSubactivity.h"
 
 class XtcReaderActivity final : public ActivityWithSubactivity {
@@ -24,10 +25,20 @@ class XtcReaderActivity final : public ActivityWithSubactivity {
   const std::function<void()> onGoBack;
   const std::function<void()> onGoHome;
 
+  // One-page-ahead prefetch: reading is sequential and XTC pages are fixed-size, so the
+  // background queue loads the next blob after each paint and a forward turn renders
+  // straight from RAM. Both tasks only touch the buffer with renderingMutex held.
+  uint8_t* prefetchBuffer = nullptr;
+  uint32_t prefetchedPage = UINT32_MAX;
+  AsyncTaskQueue::JobHandle prefetchJob = nullptr;
+
   static void taskTrampoline(void* param);
   [[noreturn]] void displayTaskLoop();
   void renderScreen();
   void renderPage();
+  size_t pageBufferSize() const;
+  void schedulePrefetch();
+  void dropPrefetch();
   void saveProgress() const;
   void loadProgress();
 
@@ -41,4 +52,5 @@ class XtcReaderActivity final : public ActivityWithSubactivity {
   void onEnter() override;
   void onExit() override;
   void loop() override;
+  bool isIdle() override { return subActivity ? subActivity->isIdle() : !updateRequired; }
 };
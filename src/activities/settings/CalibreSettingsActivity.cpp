@@ -86,7 +86,7 @@ void CalibreSettingsActivity::handleSelection() {
         [this](const std::string& url) {
           strncpy(SETTINGS.opdsServerUrl, url.c_str(), sizeof(SETTINGS.opdsServerUrl) - 1);
           SETTINGS.opdsServerUrl[sizeof(SETTINGS.opdsServerUrl) - 1] = '\0';
-          SETTINGS.saveToFile();
+          SETTINGS.save();
           exitActivity();
           updateRequired = true;
         },
@@ -104,7 +104,7 @@ void CalibreSettingsActivity::handleSelection() {
         [this](const std::string& username) {
           strncpy(SETTINGS.opdsUsername, username.c_str(), sizeof(SETTINGS.opdsUsername) - 1);
           SETTINGS.opdsUsername[sizeof(SETTINGS.opdsUsername) - 1] = '\0';
-          SETTINGS.saveToFile();
+          SETTINGS.save();
           exitActivity();
           updateRequired = true;
         },
@@ -122,7 +122,7 @@ void CalibreSettingsActivity::handleSelection() {
         [this](const std::string& password) {
           strncpy(SETTINGS.opdsPassword, password.c_str(), sizeof(SETTINGS.opdsPassword) - 1);
           SETTINGS.opdsPassword[sizeof(SETTINGS.opdsPassword) - 1] = '\0';
-          SETTINGS.saveToFile();
+          SETTINGS.save();
           exitActivity();
           updateRequired = true;
         },
@@ -1,5 +1,7 @@
 #include "ClearCacheActivity.h"
 
+#include <FileHandleCache.h>
+#include <FsHelpers.h>
 #include <GfxRenderer.h>
 #include <HardwareSerial.h>
 #include <SDCardManager.h>
@@ -73,6 +75,10 @@ void ClearCacheActivity::render() {
 
   if (state == CLEARING) {
     renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, "Clearing cache...", true, EpdFontFamily::BOLD);
+    if (removedEntries > 0) {
+      const String progressText = String(static_cast<unsigned long>(removedEntries)) + " entries removed";
+      renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 + 30, progressText.c_str());
+    }
     renderer.displayBuffer();
     return;
   }
@@ -117,8 +123,23 @@ void ClearCacheActivity::clearCache() {
 
   clearedCount = 0;
   failedCount = 0;
+  removedEntries = 0;
   char name[128];
 
+  // Entry counts climb fast on a big cache; repaint at a coarse step so the progress line
+  // doesn't queue a refresh per file
+  size_t lastShownEntries = 0;
+  const auto progressFn = [&](const size_t removed) {
+    removedEntries = removed;
+    if (removed - lastShownEntries >= 50) {
+      lastShownEntries = removed;
+      updateRequired = true;
+    }
+  };
+
+  // Cached read handles may point into directories about to be swept
+  FILE_HANDLES.invalidateAll();
+
   // Iterate through all entries in the directory
   for (auto file = root.openNextFile(); file; file = root.openNextFile()) {
     file.getName(name, sizeof(name));
@@ -131,7 +152,7 @@ void ClearCacheActivity::clearCache() {
 
       file.close();  // Close before attempting to delete
 
-      if (SdMan.removeDir(fullPath.c_str())) {
+      if (FsHelpers::removeDirRecursive(fullPath.c_str(), progressFn)) {
         clearedCount++;
       } else {
         Serial.printf("[%lu] [CLEAR_CACHE] Failed to remove: %s\n", millis(), fullPath.c_str());
@@ -29,6 +29,8 @@ class ClearCacheActivity final : public ActivityWithSubactivity {
 
   int clearedCount = 0;
   int failedCount = 0;
+  // Running file count from the bulk deleter, repainted while the clear is in flight
+  volatile size_t removedEntries = 0;
 
   static void taskTrampoline(void* param);
   [[noreturn]] void displayTaskLoop();
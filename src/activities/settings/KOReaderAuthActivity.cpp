@@ -71,14 +71,8 @@ void KOReaderAuthActivity::onEnter() {
     statusMessage = "Authenticating...";
     updateRequired = true;
 
-    // Perform authentication in a separate task
-    xTaskCreate(
-        [](void* param) {
-          auto* self = static_cast<KOReaderAuthActivity*>(param);
-          self->performAuthentication();
-          vTaskDelete(nullptr);
-        },
-        "AuthTask", 4096, this, 1, nullptr);
+    // Perform authentication on the shared worker
+    authJob = TASK_QUEUE.enqueue("KOAuth", [this](const AsyncTaskQueue::Job&) { performAuthentication(); });
     return;
   }
 
@@ -90,6 +84,10 @@ void KOReaderAuthActivity::onEnter() {
 void KOReaderAuthActivity::onExit() {
   ActivityWithSubactivity::onExit();
 
+  // The auth job captures `this`; make sure it's done before teardown
+  TASK_QUEUE.cancelAndWait(authJob);
+  authJob = nullptr;
+
   // Turn off wifi
   WiFi.disconnect(false);
   delay(100);
@@ -5,6 +5,7 @@
 
 #include <functional>
 
+#include "AsyncTaskQueue.h"
 #include "activities/ActivityWithSubactivity.h"
 
 /**
@@ -27,6 +28,7 @@ class KOReaderAuthActivity final : public ActivityWithSubactivity {
 
   TaskHandle_t displayTaskHandle = nullptr;
   SemaphoreHandle_t renderingMutex = nullptr;
+  AsyncTaskQueue::JobHandle authJob;
   bool updateRequired = false;
 
   State state = WIFI_SELECTION;
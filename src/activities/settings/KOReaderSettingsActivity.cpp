@@ -23,6 +23,9 @@ void KOReaderSettingsActivity::taskTrampoline(void* param) {
 void KOReaderSettingsActivity::onEnter() {
   ActivityWithSubactivity::onEnter();
 
+  // Credentials load lazily since boot no longer reads them
+  KOREADER_STORE.ensureLoaded();
+
   renderingMutex = xSemaphoreCreateMutex();
   selectedIndex = 0;
   updateRequired = true;
@@ -0,0 +1,333 @@
+#include "LibraryIndexerActivity.h"
+
+#include <Epub.h>
+#include <Epub/Section.h>
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+#include <Xtc.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "CrossPointSettings.h"
+#include "LibraryIndex.h"
+#include "MappedInputManager.h"
+#include "PowerGovernor.h"
+#include "ScreenComponents.h"
+#include "SdIoScheduler.h"
+#include "activities/reader/EpubReaderActivity.h"
+#include "fontIds.h"
+#include "util/StringUtils.h"
+
+namespace {
+constexpr char CHECKPOINT_FILE[] = "/.crosspoint/libindex.ckpt";
+constexpr uint32_t CHECKPOINT_MAGIC = 0x4C495843;  // 'LIXC'
+constexpr uint8_t CHECKPOINT_VERSION = 1;
+}  // namespace
+
+void LibraryIndexerActivity::taskTrampoline(void* param) {
+  auto* self = static_cast<LibraryIndexerActivity*>(param);
+  self->displayTaskLoop();
+}
+
+void LibraryIndexerActivity::onEnter() {
+  Activity::onEnter();
+
+  renderingMutex = xSemaphoreCreateMutex();
+  state = INTRO;
+  updateRequired = true;
+
+  xTaskCreate(&LibraryIndexerActivity::taskTrampoline, "LibIndexerTask",
+              4096,               // Stack size
+              this,               // Parameters
+              1,                  // Priority
+              &displayTaskHandle  // Task handle
+  );
+}
+
+void LibraryIndexerActivity::onExit() {
+  Activity::onExit();
+
+  // The sweep job captures `this`; a running section build polls the cancel flag, so this
+  // returns as soon as the current work unit notices. Checkpoint state survives the abort.
+  TASK_QUEUE.cancelAndWait(sweepJob);
+  sweepJob = nullptr;
+
+  // Wait until not rendering to delete task to avoid killing mid-instruction to EPD
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  if (displayTaskHandle) {
+    vTaskDelete(displayTaskHandle);
+    displayTaskHandle = nullptr;
+  }
+  vSemaphoreDelete(renderingMutex);
+  renderingMutex = nullptr;
+}
+
+void LibraryIndexerActivity::loop() {
+  if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
+    // Stop (checkpointed) or leave; onExit cancels the job either way
+    goBack();
+    return;
+  }
+
+  if (mappedInput.wasPressed(MappedInputManager::Button::Confirm)) {
+    if (state == INTRO) {
+      startSweep();
+    } else if (state == DONE) {
+      goBack();
+    }
+  }
+}
+
+void LibraryIndexerActivity::startSweep() {
+  state = RUNNING;
+  updateRequired = true;
+  sweepJob = TASK_QUEUE.enqueue(
+      "LibIndex", [this](const AsyncTaskQueue::Job& job) { runSweep(job); }, AsyncTaskQueue::Priority::LOW);
+}
+
+void LibraryIndexerActivity::collectBooks(const std::string& dirPath, std::vector<std::string>& out) {
+  FsFile dir = SdMan.open(dirPath.c_str());
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+  for (FsFile entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    char name[256] = {0};
+    entry.getName(name, sizeof(name));
+    if (name[0] == '\0' || name[0] == '.') {
+      entry.close();
+      continue;
+    }
+    const std::string path = dirPath == "/" ? std::string("/") + name : dirPath + "/" + name;
+    if (entry.isDirectory()) {
+      entry.close();
+      collectBooks(path, out);
+      continue;
+    }
+    if (LibraryIndex::isListedFile(name)) {
+      out.emplace_back(path);
+    }
+    entry.close();
+  }
+  dir.close();
+}
+
+bool LibraryIndexerActivity::loadCheckpoint(const uint32_t layoutKey, std::string& lastCompleted) {
+  FsFile file;
+  if (!SdMan.openFileForRead("LIX", CHECKPOINT_FILE, file)) {
+    return false;
+  }
+  uint32_t magic = 0, storedKey = 0;
+  uint8_t version = 0;
+  serialization::readPod(file, magic);
+  serialization::readPod(file, version);
+  serialization::readPod(file, storedKey);
+  serialization::readString(file, lastCompleted);
+  file.close();
+  if (magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION || storedKey != layoutKey) {
+    // Layout settings changed since the last night; the section namespace is different, so
+    // the earlier books need their sections rebuilt and the cursor is meaningless
+    lastCompleted.clear();
+    return false;
+  }
+  return !lastCompleted.empty();
+}
+
+void LibraryIndexerActivity::saveCheckpoint(const uint32_t layoutKey, const std::string& lastCompleted) {
+  FsFile file;
+  if (!SdMan.openFileForWrite("LIX", CHECKPOINT_FILE, file)) {
+    return;
+  }
+  serialization::writePod(file, CHECKPOINT_MAGIC);
+  serialization::writePod(file, CHECKPOINT_VERSION);
+  serialization::writePod(file, layoutKey);
+  serialization::writeString(file, lastCompleted);
+  file.close();
+}
+
+void LibraryIndexerActivity::runSweep(const AsyncTaskQueue::Job& job) {
+  // Stable sorted order makes the checkpoint a simple resume cursor: everything at or before
+  // it was completed on an earlier night
+  std::vector<std::string> paths;
+  {
+    const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::BACKGROUND);
+    collectBooks("/", paths);
+  }
+  std::sort(paths.begin(), paths.end());
+  totalBooks = static_cast<int>(paths.size());
+
+  // The viewport derivation pokes the renderer's orientation, so run it between renders
+  uint16_t viewportWidth = 0, viewportHeight = 0;
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  EpubReaderActivity::currentLayoutViewport(renderer, viewportWidth, viewportHeight);
+  xSemaphoreGive(renderingMutex);
+  const uint32_t layoutKey = Section::layoutKey(
+      SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
+      SETTINGS.paragraphAlignment, viewportWidth, viewportHeight, SETTINGS.hyphenationEnabled,
+      SETTINGS.optimalLineBreaks);
+
+  std::string resumeAfter;
+  if (loadCheckpoint(layoutKey, resumeAfter)) {
+    Serial.printf("[%lu] [LIX] Resuming sweep after %s\n", millis(), resumeAfter.c_str());
+  }
+
+  for (const auto& path : paths) {
+    if (job.isCancelled()) {
+      return;
+    }
+    if (!resumeAfter.empty() && path <= resumeAfter) {
+      doneBooks = doneBooks + 1;
+      continue;
+    }
+
+    // Charger-only contract: pause (not abort) while unplugged, keep the checkpoint
+    while (!TASK_QUEUE.isCharging()) {
+      if (job.isCancelled()) {
+        return;
+      }
+      if (state != WAITING_FOR_POWER) {
+        state = WAITING_FOR_POWER;
+        updateRequired = true;
+      }
+      vTaskDelay(1000 / portTICK_PERIOD_MS);
+    }
+    if (state != RUNNING) {
+      state = RUNNING;
+      updateRequired = true;
+    }
+
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    currentName = path.substr(path.find_last_of('/') + 1);
+    xSemaphoreGive(renderingMutex);
+    updateRequired = true;
+
+    SD_SCHED.yieldToUi();
+    xSemaphoreTake(renderingMutex, portMAX_DELAY);
+    if (!job.isCancelled()) {
+      const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::BACKGROUND);
+      const PowerGovernor::Lease powerLease;  // On charger by contract; build at full clock
+      indexOneBook(path, viewportWidth, viewportHeight, layoutKey, job);
+    }
+    xSemaphoreGive(renderingMutex);
+
+    if (job.isCancelled()) {
+      // The aborted book is not checkpointed; the next run redoes it
+      return;
+    }
+    doneBooks = doneBooks + 1;
+    builtBooks = builtBooks + 1;
+    saveCheckpoint(layoutKey, path);
+    updateRequired = true;
+    vTaskDelay(50 / portTICK_PERIOD_MS);
+  }
+
+  // Whole card warm: drop the cursor so a future run starts a fresh (cheap) verification pass
+  SdMan.remove(CHECKPOINT_FILE);
+  state = DONE;
+  updateRequired = true;
+}
+
+void LibraryIndexerActivity::indexOneBook(const std::string& path, const uint16_t viewportWidth,
+                                          const uint16_t viewportHeight, const uint32_t layoutKey,
+                                          const AsyncTaskQueue::Job& job) const {
+  if (StringUtils::checkFileExtension(path, ".epub")) {
+    const auto epub = std::make_shared<Epub>(path, "/.crosspoint");
+    if (!epub->load()) {  // first contact builds the metadata cache
+      Serial.printf("[%lu] [LIX] Failed to load %s\n", millis(), path.c_str());
+      return;
+    }
+    epub->setupCacheDir();
+    epub->generateCoverAssets();  // cover, cropped cover and thumb; existing variants skipped
+
+    // Paginate the section a first open lands on, in the layout namespace the reader will use
+    int spineIndex = epub->getSpineIndexForTextReference();
+    if (spineIndex < 0 || spineIndex >= epub->getSpineItemsCount()) {
+      spineIndex = 0;
+    }
+    Section section(epub, spineIndex, renderer, layoutKey);
+    if (!section.loadSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
+                                 SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
+                                 viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.optimalLineBreaks)) {
+      section.createSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
+                                SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
+                                viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.optimalLineBreaks, nullptr,
+                                nullptr, [&job] { return job.isCancelled(); });
+    }
+  } else if (StringUtils::checkFileExtension(path, ".xtch") || StringUtils::checkFileExtension(path, ".xtc")) {
+    // XTC ships pre-paginated; metadata and the thumb are all a first open builds
+    Xtc xtc(path, "/.crosspoint");
+    if (xtc.load()) {
+      xtc.generateThumbBmp();
+    }
+  }
+}
+
+void LibraryIndexerActivity::displayTaskLoop() {
+  while (true) {
+    if (updateRequired) {
+      updateRequired = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      render();
+      xSemaphoreGive(renderingMutex);
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+}
+
+void LibraryIndexerActivity::render() {
+  const auto pageWidth = renderer.getScreenWidth();
+  const auto pageHeight = renderer.getScreenHeight();
+
+  renderer.clearScreen();
+  renderer.drawCenteredText(UI_12_FONT_ID, 15, "Index Library", true, EpdFontFamily::BOLD);
+
+  if (state == INTRO) {
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 80, "Builds metadata, covers and first", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 60, "chapters for every book on the card,", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 40, "so first opens are instant.", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, "Runs only while plugged in. A large", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 + 20, "card can take hours; progress is kept,", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 + 40, "so it resumes if you stop it.", true);
+
+    const auto labels = mappedInput.mapLabels("« Cancel", "Start", "", "");
+    renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+    renderer.displayBuffer();
+    return;
+  }
+
+  if (state == RUNNING || state == WAITING_FOR_POWER) {
+    char line[96];
+    snprintf(line, sizeof(line), "Book %d of %d", doneBooks < totalBooks ? doneBooks + 1 : totalBooks, totalBooks);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 60, line, true, EpdFontFamily::BOLD);
+    renderer.drawCenteredText(SMALL_FONT_ID, pageHeight / 2 - 35, currentName.c_str(), true);
+
+    constexpr int barHeight = 12;
+    const int barWidth = pageWidth - 120;
+    ScreenComponents::drawProgressBar(renderer, (pageWidth - barWidth) / 2, pageHeight / 2, barWidth, barHeight,
+                                      doneBooks, totalBooks > 0 ? totalBooks : 1);
+
+    if (state == WAITING_FOR_POWER) {
+      renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 + 40, "Paused - plug in to continue", true,
+                                EpdFontFamily::BOLD);
+    } else {
+      renderer.drawCenteredText(SMALL_FONT_ID, pageHeight / 2 + 40, "Keep the device plugged in", true);
+    }
+
+    const auto labels = mappedInput.mapLabels("« Stop", "", "", "");
+    renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+    renderer.displayBuffer();
+    return;
+  }
+
+  // DONE
+  char line[64];
+  renderer.drawCenteredText(UI_12_FONT_ID, pageHeight / 2 - 40, "Library indexed", true, EpdFontFamily::BOLD);
+  snprintf(line, sizeof(line), "%d books warmed this run", builtBooks);
+  renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, line, true);
+
+  const auto labels = mappedInput.mapLabels("« Back", "Done", "", "");
+  renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+  renderer.displayBuffer();
+}
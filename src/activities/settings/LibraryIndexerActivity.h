@@ -0,0 +1,62 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "AsyncTaskQueue.h"
+#include "activities/Activity.h"
+
+/**
+ * Whole-card indexing sweep, launched from System settings. A full SD card otherwise warms
+ * up one lazy miss at a time: every first open pays metadata parsing, cover conversion and
+ * first-section pagination. The sweep walks the card and builds all of it per book on the
+ * shared worker, but only on charger power - unplugging pauses the sweep rather than
+ * draining the battery. Progress is checkpointed after every book, so a sweep too large for
+ * one night resumes where it stopped on the next run.
+ */
+class LibraryIndexerActivity final : public Activity {
+ public:
+  explicit LibraryIndexerActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
+                                  const std::function<void()>& goBack)
+      : Activity("LibraryIndexer", renderer, mappedInput), goBack(goBack) {}
+
+  void onEnter() override;
+  void onExit() override;
+  void loop() override;
+  // The sweep is the point of leaving the device on the charger overnight
+  bool preventAutoSleep() override { return state == RUNNING || state == WAITING_FOR_POWER; }
+
+ private:
+  enum State { INTRO, RUNNING, WAITING_FOR_POWER, DONE };
+
+  volatile State state = INTRO;
+  TaskHandle_t displayTaskHandle = nullptr;
+  SemaphoreHandle_t renderingMutex = nullptr;
+  AsyncTaskQueue::JobHandle sweepJob;
+  volatile bool updateRequired = false;
+
+  // Sweep progress, written by the job and read by render()
+  volatile int totalBooks = 0;
+  volatile int doneBooks = 0;   // includes books a previous night already completed
+  volatile int builtBooks = 0;  // books this run actually did work for
+  std::string currentName;      // guarded by renderingMutex
+
+  const std::function<void()> goBack;
+
+  static void taskTrampoline(void* param);
+  [[noreturn]] void displayTaskLoop();
+  void render();
+  void startSweep();
+  void runSweep(const AsyncTaskQueue::Job& job);
+  // Warm every cache the first open of this book would build; holds renderingMutex
+  void indexOneBook(const std::string& path, uint16_t viewportWidth, uint16_t viewportHeight, uint32_t layoutKey,
+                    const AsyncTaskQueue::Job& job) const;
+  static void collectBooks(const std::string& dirPath, std::vector<std::string>& out);
+  static bool loadCheckpoint(uint32_t layoutKey, std::string& lastCompleted);
+  static void saveCheckpoint(uint32_t layoutKey, const std::string& lastCompleted);
+};
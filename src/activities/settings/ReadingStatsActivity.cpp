@@ -0,0 +1,116 @@
+#include "ReadingStatsActivity.h"
+
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+
+#include "MappedInputManager.h"
+#include "ReadingStats.h"
+#include "fontIds.h"
+
+namespace {
+// "Xh Ym" / "Ym" for readable durations
+void formatDuration(char* out, const size_t outSize, const uint32_t seconds) {
+  const uint32_t hours = seconds / 3600;
+  const uint32_t minutes = (seconds % 3600) / 60;
+  if (hours > 0) {
+    snprintf(out, outSize, "%luh %lum", static_cast<unsigned long>(hours), static_cast<unsigned long>(minutes));
+  } else {
+    snprintf(out, outSize, "%lum", static_cast<unsigned long>(minutes));
+  }
+}
+}  // namespace
+
+void ReadingStatsActivity::taskTrampoline(void* param) {
+  auto* self = static_cast<ReadingStatsActivity*>(param);
+  self->displayTaskLoop();
+}
+
+void ReadingStatsActivity::onEnter() {
+  ActivityWithSubactivity::onEnter();
+
+  renderingMutex = xSemaphoreCreateMutex();
+  updateRequired = true;
+
+  xTaskCreate(&ReadingStatsActivity::taskTrampoline, "ReadingStatsActivityTask",
+              4096,               // Stack size
+              this,               // Parameters
+              1,                  // Priority
+              &displayTaskHandle  // Task handle
+  );
+}
+
+void ReadingStatsActivity::onExit() {
+  ActivityWithSubactivity::onExit();
+
+  // Wait until not rendering to delete task to avoid killing mid-instruction to EPD
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  if (displayTaskHandle) {
+    vTaskDelete(displayTaskHandle);
+    displayTaskHandle = nullptr;
+  }
+  vSemaphoreDelete(renderingMutex);
+  renderingMutex = nullptr;
+}
+
+void ReadingStatsActivity::displayTaskLoop() {
+  while (true) {
+    if (updateRequired) {
+      updateRequired = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      render();
+      xSemaphoreGive(renderingMutex);
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+}
+
+void ReadingStatsActivity::render() {
+  renderer.clearScreen();
+  renderer.drawCenteredText(UI_12_FONT_ID, 15, "Reading Stats", true, EpdFontFamily::BOLD);
+
+  char line[64];
+  char duration[16];
+  int y = 70;
+  constexpr int lineHeight = 30;
+
+  const auto today = READING_STATS.getToday();
+  formatDuration(duration, sizeof(duration), today.readSeconds);
+  snprintf(line, sizeof(line), "Today: %s, %lu pages", duration, static_cast<unsigned long>(today.pageTurns));
+  renderer.drawText(UI_10_FONT_ID, 20, y, line);
+  y += lineHeight;
+
+  const int streak = READING_STATS.getStreakDays();
+  snprintf(line, sizeof(line), "Current streak: %d day%s", streak, streak == 1 ? "" : "s");
+  renderer.drawText(UI_10_FONT_ID, 20, y, line);
+  y += lineHeight * 2;
+
+  formatDuration(duration, sizeof(duration), READING_STATS.getTotalReadSeconds());
+  snprintf(line, sizeof(line), "Total reading time: %s", duration);
+  renderer.drawText(UI_10_FONT_ID, 20, y, line);
+  y += lineHeight;
+
+  snprintf(line, sizeof(line), "Pages turned: %lu", static_cast<unsigned long>(READING_STATS.getTotalPageTurns()));
+  renderer.drawText(UI_10_FONT_ID, 20, y, line);
+  y += lineHeight;
+
+  snprintf(line, sizeof(line), "Pages per hour: %lu", static_cast<unsigned long>(READING_STATS.getPagesPerHour()));
+  renderer.drawText(UI_10_FONT_ID, 20, y, line);
+  y += lineHeight;
+
+  snprintf(line, sizeof(line), "Books tracked: %d", READING_STATS.getBookRowCount());
+  renderer.drawText(UI_10_FONT_ID, 20, y, line);
+  y += lineHeight * 2;
+
+  // The device has no calendar clock, so "days" are 24h windows since the last full power-off
+  renderer.drawText(SMALL_FONT_ID, 20, y, "Days count 24h periods of device time.");
+
+  const auto labels = mappedInput.mapLabels("« Back", "", "", "");
+  renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+  renderer.displayBuffer();
+}
+
+void ReadingStatsActivity::loop() {
+  if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
+    goBack();
+  }
+}
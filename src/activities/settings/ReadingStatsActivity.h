@@ -0,0 +1,31 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <functional>
+
+#include "activities/ActivityWithSubactivity.h"
+
+// Read-only screen over the pre-aggregated ReadingStatsStore rows; no SD access on render
+class ReadingStatsActivity final : public ActivityWithSubactivity {
+ public:
+  explicit ReadingStatsActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
+                                const std::function<void()>& goBack)
+      : ActivityWithSubactivity("ReadingStats", renderer, mappedInput), goBack(goBack) {}
+
+  void onEnter() override;
+  void onExit() override;
+  void loop() override;
+
+ private:
+  TaskHandle_t displayTaskHandle = nullptr;
+  SemaphoreHandle_t renderingMutex = nullptr;
+  bool updateRequired = false;
+  const std::function<void()> goBack;
+
+  static void taskTrampoline(void* param);
+  [[noreturn]] void displayTaskLoop();
+  void render();
+};
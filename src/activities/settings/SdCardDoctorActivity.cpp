@@ -0,0 +1,302 @@
+#include "SdCardDoctorActivity.h"
+
+#include <GfxRenderer.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "MappedInputManager.h"
+#include "PowerGovernor.h"
+#include "fontIds.h"
+
+namespace {
+constexpr const char* BENCH_FILE = "/.crosspoint/sdbench.tmp";
+constexpr const char* RESULTS_FILE = "/.crosspoint/sdbench.txt";
+
+// One sequential pass and a few hundred scattered reads is enough to separate a healthy card
+// from a counterfeit without chewing minutes of the user's time (or flash endurance)
+constexpr size_t CHUNK_BYTES = 16 * 1024;
+constexpr size_t SEQ_CHUNKS = 64;  // 1MB total
+constexpr size_t RAND_READ_BYTES = 4 * 1024;
+constexpr size_t RAND_READS = 200;
+
+// Known-good thresholds for this hardware (SPI bus shared with the panel). A genuine card of
+// any recent class clears these comfortably; worn or counterfeit cards miss by integer factors
+constexpr uint32_t GOOD_SEQ_WRITE_KBPS = 300;
+constexpr uint32_t GOOD_SEQ_READ_KBPS = 700;
+constexpr uint32_t GOOD_RAND_P99_US = 25000;
+
+const char* verdict(const bool ok) { return ok ? "OK" : "SLOW"; }
+
+// Local PRNG so the read offsets scatter without pulling in esp_random
+uint32_t xorshift32(uint32_t& s) {
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
+}  // namespace
+
+void SdCardDoctorActivity::taskTrampoline(void* param) {
+  auto* self = static_cast<SdCardDoctorActivity*>(param);
+  self->displayTaskLoop();
+}
+
+void SdCardDoctorActivity::onEnter() {
+  ActivityWithSubactivity::onEnter();
+
+  renderingMutex = xSemaphoreCreateMutex();
+  state = INTRO;
+  updateRequired = true;
+
+  xTaskCreate(&SdCardDoctorActivity::taskTrampoline, "SdCardDoctorTask",
+              4096,               // Stack size
+              this,               // Parameters
+              1,                  // Priority
+              &displayTaskHandle  // Task handle
+  );
+}
+
+void SdCardDoctorActivity::onExit() {
+  ActivityWithSubactivity::onExit();
+
+  // Wait until not rendering to delete task to avoid killing mid-instruction to EPD
+  xSemaphoreTake(renderingMutex, portMAX_DELAY);
+  if (displayTaskHandle) {
+    vTaskDelete(displayTaskHandle);
+    displayTaskHandle = nullptr;
+  }
+  vSemaphoreDelete(renderingMutex);
+  renderingMutex = nullptr;
+}
+
+void SdCardDoctorActivity::displayTaskLoop() {
+  while (true) {
+    if (updateRequired) {
+      updateRequired = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      render();
+      xSemaphoreGive(renderingMutex);
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+}
+
+void SdCardDoctorActivity::render() {
+  const auto pageHeight = renderer.getScreenHeight();
+
+  renderer.clearScreen();
+  renderer.drawCenteredText(UI_12_FONT_ID, 15, "SD Card Check", true, EpdFontFamily::BOLD);
+
+  if (state == INTRO) {
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 60, "Benchmarks the inserted card against", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 40, "known-good thresholds.", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, "Takes about 10 seconds and writes", true);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 + 20, "1 MB of temporary data.", true);
+
+    const auto labels = mappedInput.mapLabels("« Cancel", "Start", "", "");
+    renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+    renderer.displayBuffer();
+    return;
+  }
+
+  if (state == RUNNING) {
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2, "Checking card...", true, EpdFontFamily::BOLD);
+    renderer.displayBuffer();
+    return;
+  }
+
+  if (state == DONE) {
+    const bool writeOk = results.seqWriteKbps >= GOOD_SEQ_WRITE_KBPS;
+    const bool readOk = results.seqReadKbps >= GOOD_SEQ_READ_KBPS;
+    const bool randOk = results.randP99Us <= GOOD_RAND_P99_US;
+
+    char line[64];
+    int y = pageHeight / 2 - 80;
+    snprintf(line, sizeof(line), "Sequential write: %lu KB/s [%s]", static_cast<unsigned long>(results.seqWriteKbps),
+             verdict(writeOk));
+    renderer.drawCenteredText(UI_10_FONT_ID, y, line, true);
+    y += 25;
+    snprintf(line, sizeof(line), "Sequential read: %lu KB/s [%s]", static_cast<unsigned long>(results.seqReadKbps),
+             verdict(readOk));
+    renderer.drawCenteredText(UI_10_FONT_ID, y, line, true);
+    y += 25;
+    snprintf(line, sizeof(line), "Random reads: %lu/s [%s]", static_cast<unsigned long>(results.randReadsPerSec),
+             verdict(randOk));
+    renderer.drawCenteredText(UI_10_FONT_ID, y, line, true);
+    y += 25;
+    snprintf(line, sizeof(line), "Read latency: p50 %lu ms, p99 %lu ms",
+             static_cast<unsigned long>(results.randP50Us / 1000), static_cast<unsigned long>(results.randP99Us / 1000));
+    renderer.drawCenteredText(UI_10_FONT_ID, y, line, true);
+    y += 40;
+    if (writeOk && readOk && randOk) {
+      renderer.drawCenteredText(UI_10_FONT_ID, y, "Card looks healthy.", true, EpdFontFamily::BOLD);
+    } else {
+      renderer.drawCenteredText(UI_10_FONT_ID, y, "Card underperforms a known-good one.", true, EpdFontFamily::BOLD);
+      renderer.drawCenteredText(UI_10_FONT_ID, y + 20, "Slow pages are likely the card, not the device.", true);
+    }
+
+    const auto labels = mappedInput.mapLabels("« Back", "", "", "");
+    renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+    renderer.displayBuffer();
+    return;
+  }
+
+  if (state == FAILED) {
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 - 20, "Benchmark failed", true, EpdFontFamily::BOLD);
+    renderer.drawCenteredText(UI_10_FONT_ID, pageHeight / 2 + 10, "Check serial output for details");
+
+    const auto labels = mappedInput.mapLabels("« Back", "", "", "");
+    renderer.drawButtonHints(UI_10_FONT_ID, labels.btn1, labels.btn2, labels.btn3, labels.btn4);
+    renderer.displayBuffer();
+    return;
+  }
+}
+
+void SdCardDoctorActivity::runBenchmark() {
+  Serial.printf("[%lu] [SDD] Starting SD card benchmark\n", millis());
+  // Benchmark at the boosted clock so the numbers measure the card, not the idle CPU
+  const PowerGovernor::Lease powerLease;
+
+  std::vector<uint8_t> chunk(CHUNK_BYTES);
+  for (size_t i = 0; i < chunk.size(); i++) {
+    chunk[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+
+  // Aligned sequential write, one timed chunk at a time
+  FsFile file;
+  if (!SdMan.openFileForWrite("SDD", BENCH_FILE, file)) {
+    state = FAILED;
+    updateRequired = true;
+    return;
+  }
+  unsigned long start = micros();
+  for (size_t i = 0; i < SEQ_CHUNKS; i++) {
+    if (file.write(chunk.data(), chunk.size()) != chunk.size()) {
+      Serial.printf("[%lu] [SDD] Write failed at chunk %u\n", millis(), i);
+      file.close();
+      SdMan.remove(BENCH_FILE);
+      state = FAILED;
+      updateRequired = true;
+      return;
+    }
+  }
+  file.flush();
+  file.close();
+  unsigned long elapsedUs = micros() - start;
+  const uint32_t totalKb = (CHUNK_BYTES * SEQ_CHUNKS) / 1024;
+  results.seqWriteKbps = elapsedUs > 0 ? static_cast<uint32_t>((static_cast<uint64_t>(totalKb) * 1000000) / elapsedUs)
+                                       : 0;
+
+  // Sequential read of the same file
+  file = SdMan.open(BENCH_FILE, O_RDONLY);
+  if (!file) {
+    SdMan.remove(BENCH_FILE);
+    state = FAILED;
+    updateRequired = true;
+    return;
+  }
+  start = micros();
+  for (size_t i = 0; i < SEQ_CHUNKS; i++) {
+    if (file.read(chunk.data(), chunk.size()) != static_cast<int>(chunk.size())) {
+      Serial.printf("[%lu] [SDD] Read failed at chunk %u\n", millis(), i);
+      file.close();
+      SdMan.remove(BENCH_FILE);
+      state = FAILED;
+      updateRequired = true;
+      return;
+    }
+  }
+  elapsedUs = micros() - start;
+  results.seqReadKbps = elapsedUs > 0 ? static_cast<uint32_t>((static_cast<uint64_t>(totalKb) * 1000000) / elapsedUs)
+                                      : 0;
+
+  // Scattered small reads with per-read latency for the percentiles; this is the access pattern
+  // page loads and section header walks actually generate
+  std::vector<uint32_t> latencies;
+  latencies.reserve(RAND_READS);
+  uint32_t seed = micros() | 1;
+  const uint32_t offsetRange = CHUNK_BYTES * SEQ_CHUNKS - RAND_READ_BYTES;
+  start = micros();
+  for (size_t i = 0; i < RAND_READS; i++) {
+    const uint32_t offset = xorshift32(seed) % offsetRange;
+    const unsigned long readStart = micros();
+    if (!file.seekSet(offset) || file.read(chunk.data(), RAND_READ_BYTES) != static_cast<int>(RAND_READ_BYTES)) {
+      Serial.printf("[%lu] [SDD] Random read failed at offset %lu\n", millis(), static_cast<unsigned long>(offset));
+      file.close();
+      SdMan.remove(BENCH_FILE);
+      state = FAILED;
+      updateRequired = true;
+      return;
+    }
+    latencies.push_back(micros() - readStart);
+  }
+  elapsedUs = micros() - start;
+  file.close();
+  SdMan.remove(BENCH_FILE);
+
+  std::sort(latencies.begin(), latencies.end());
+  results.randP50Us = latencies[latencies.size() / 2];
+  results.randP99Us = latencies[(latencies.size() * 99) / 100];
+  results.randReadsPerSec =
+      elapsedUs > 0 ? static_cast<uint32_t>((static_cast<uint64_t>(RAND_READS) * 1000000) / elapsedUs) : 0;
+
+  persistResults();
+
+  Serial.printf("[%lu] [SDD] seq write %lu KB/s, seq read %lu KB/s, rand %lu/s, p50 %lu us, p99 %lu us\n", millis(),
+                static_cast<unsigned long>(results.seqWriteKbps), static_cast<unsigned long>(results.seqReadKbps),
+                static_cast<unsigned long>(results.randReadsPerSec), static_cast<unsigned long>(results.randP50Us),
+                static_cast<unsigned long>(results.randP99Us));
+
+  state = DONE;
+  updateRequired = true;
+}
+
+// One plain-text line per metric; the web server's /api/sdbench endpoint serves this file
+bool SdCardDoctorActivity::persistResults() const {
+  FsFile file;
+  if (!SdMan.openFileForWrite("SDD", RESULTS_FILE, file)) {
+    return false;
+  }
+  char line[96];
+  const int len = snprintf(line, sizeof(line),
+                           "seqWriteKbps %lu\nseqReadKbps %lu\nrandReadsPerSec %lu\nrandP50Us %lu\nrandP99Us %lu\n",
+                           static_cast<unsigned long>(results.seqWriteKbps),
+                           static_cast<unsigned long>(results.seqReadKbps),
+                           static_cast<unsigned long>(results.randReadsPerSec),
+                           static_cast<unsigned long>(results.randP50Us),
+                           static_cast<unsigned long>(results.randP99Us));
+  if (len > 0) {
+    file.write(reinterpret_cast<const uint8_t*>(line), len);
+  }
+  file.close();
+  return true;
+}
+
+void SdCardDoctorActivity::loop() {
+  if (state == INTRO) {
+    if (mappedInput.wasPressed(MappedInputManager::Button::Confirm)) {
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      state = RUNNING;
+      xSemaphoreGive(renderingMutex);
+      updateRequired = true;
+      vTaskDelay(10 / portTICK_PERIOD_MS);
+
+      runBenchmark();
+    }
+
+    if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
+      goBack();
+    }
+    return;
+  }
+
+  if (state == DONE || state == FAILED) {
+    if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
+      goBack();
+    }
+    return;
+  }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <cstdint>
+#include <functional>
+
+#include "activities/ActivityWithSubactivity.h"
+
+// SD card performance doctor: benchmarks the inserted card through SDCardManager (sequential
+// read/write, random reads with latency percentiles), compares against known-good thresholds
+// and says so on screen. Half the "device is slow" reports trace to counterfeit or worn cards;
+// this lets users confirm that without swapping hardware. Results persist to /.crosspoint so
+// the web server's debug endpoint can serve the last run.
+class SdCardDoctorActivity final : public ActivityWithSubactivity {
+ public:
+  explicit SdCardDoctorActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
+                                const std::function<void()>& goBack)
+      : ActivityWithSubactivity("SdCardDoctor", renderer, mappedInput), goBack(goBack) {}
+
+  void onEnter() override;
+  void onExit() override;
+  void loop() override;
+
+ private:
+  enum State { INTRO, RUNNING, DONE, FAILED };
+
+  struct Results {
+    uint32_t seqWriteKbps = 0;
+    uint32_t seqReadKbps = 0;
+    uint32_t randReadsPerSec = 0;
+    uint32_t randP50Us = 0;
+    uint32_t randP99Us = 0;
+  };
+
+  State state = INTRO;
+  TaskHandle_t displayTaskHandle = nullptr;
+  SemaphoreHandle_t renderingMutex = nullptr;
+  bool updateRequired = false;
+  const std::function<void()> goBack;
+
+  Results results;
+
+  static void taskTrampoline(void* param);
+  [[noreturn]] void displayTaskLoop();
+  void render();
+  void runBenchmark();
+  bool persistResults() const;
+};
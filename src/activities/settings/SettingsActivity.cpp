@@ -24,15 +24,17 @@ const SettingInfo displaySettings[displaySettingsCount] = {
     SettingInfo::Enum("Refresh Frequency", &CrossPointSettings::refreshFrequency,
                       {"1 page", "5 pages", "10 pages", "15 pages", "30 pages"})};
 
-constexpr int readerSettingsCount = 9;
+constexpr int readerSettingsCount = 10;
 const SettingInfo readerSettings[readerSettingsCount] = {
-    SettingInfo::Enum("Font Family", &CrossPointSettings::fontFamily, {"Bookerly", "Noto Sans", "Open Dyslexic"}),
+    SettingInfo::Enum("Font Family", &CrossPointSettings::fontFamily,
+                      {"Bookerly", "Noto Sans", "Open Dyslexic", "User (SD Card)"}),
     SettingInfo::Enum("Font Size", &CrossPointSettings::fontSize, {"Small", "Medium", "Large", "X Large"}),
     SettingInfo::Enum("Line Spacing", &CrossPointSettings::lineSpacing, {"Tight", "Normal", "Wide"}),
     SettingInfo::Value("Screen Margin", &CrossPointSettings::screenMargin, {5, 40, 5}),
     SettingInfo::Enum("Paragraph Alignment", &CrossPointSettings::paragraphAlignment,
                       {"Justify", "Left", "Center", "Right"}),
     SettingInfo::Toggle("Hyphenation", &CrossPointSettings::hyphenationEnabled),
+    SettingInfo::Toggle("Optimal Line Breaks", &CrossPointSettings::optimalLineBreaks),
     SettingInfo::Enum("Reading Orientation", &CrossPointSettings::orientation,
                       {"Portrait", "Landscape CW", "Inverted", "Landscape CCW"}),
     SettingInfo::Toggle("Extra Paragraph Spacing", &CrossPointSettings::extraParagraphSpacing),
@@ -48,11 +50,17 @@ const SettingInfo controlsSettings[controlsSettingsCount] = {
     SettingInfo::Toggle("Long-press Chapter Skip", &CrossPointSettings::longPressChapterSkip),
     SettingInfo::Enum("Short Power Button Click", &CrossPointSettings::shortPwrBtn, {"Ignore", "Sleep", "Page Turn"})};
 
-constexpr int systemSettingsCount = 5;
+constexpr int systemSettingsCount = 11;
 const SettingInfo systemSettings[systemSettingsCount] = {
     SettingInfo::Enum("Time to Sleep", &CrossPointSettings::sleepTimeout,
                       {"1 min", "5 min", "10 min", "15 min", "30 min"}),
-    SettingInfo::Action("KOReader Sync"), SettingInfo::Action("OPDS Browser"), SettingInfo::Action("Clear Cache"),
+    SettingInfo::Enum("Cache Size Limit", &CrossPointSettings::cacheSizeLimit,
+                      {"64 MB", "128 MB", "256 MB", "Unlimited"}),
+    SettingInfo::Enum("Throttle Background Jobs", &CrossPointSettings::bgBatteryThrottle,
+                      {"Never", "Below 15%", "Below 25%", "Below 40%"}),
+    SettingInfo::Toggle("Turn Latency Overlay", &CrossPointSettings::turnLatencyOverlay),
+    SettingInfo::Action("KOReader Sync"), SettingInfo::Action("OPDS Browser"), SettingInfo::Action("Reading Stats"),
+    SettingInfo::Action("Clear Cache"), SettingInfo::Action("Index Library"), SettingInfo::Action("SD Card Check"),
     SettingInfo::Action("Check for updates")};
 }  // namespace
 
@@ -105,7 +113,7 @@ void SettingsActivity::loop() {
   }
 
   if (mappedInput.wasPressed(MappedInputManager::Button::Back)) {
-    SETTINGS.saveToFile();
+    SETTINGS.save();
     onGoHome();
     return;
   }
@@ -115,12 +123,12 @@ void SettingsActivity::loop() {
       mappedInput.wasPressed(MappedInputManager::Button::Left)) {
     // Move selection up (with wrap-around)
     selectedCategoryIndex = (selectedCategoryIndex > 0) ? (selectedCategoryIndex - 1) : (categoryCount - 1);
-    updateRequired = true;
+    selectorOnlyUpdate = true;
   } else if (mappedInput.wasPressed(MappedInputManager::Button::Down) ||
              mappedInput.wasPressed(MappedInputManager::Button::Right)) {
     // Move selection down (with wrap around)
     selectedCategoryIndex = (selectedCategoryIndex < categoryCount - 1) ? (selectedCategoryIndex + 1) : 0;
-    updateRequired = true;
+    selectorOnlyUpdate = true;
   }
 }
 
@@ -166,9 +174,15 @@ void SettingsActivity::displayTaskLoop() {
   while (true) {
     if (updateRequired && !subActivity) {
       updateRequired = false;
+      selectorOnlyUpdate = false;
       xSemaphoreTake(renderingMutex, portMAX_DELAY);
       render();
       xSemaphoreGive(renderingMutex);
+    } else if (selectorOnlyUpdate && !subActivity) {
+      selectorOnlyUpdate = false;
+      xSemaphoreTake(renderingMutex, portMAX_DELAY);
+      renderSelectorMove();
+      xSemaphoreGive(renderingMutex);
     }
     vTaskDelay(10 / portTICK_PERIOD_MS);
   }
@@ -204,4 +218,24 @@ void SettingsActivity::render() const {
 
   // Always use standard refresh for settings screen
   renderer.displayBuffer();
+  lastRenderedSelectorIndex = selectedCategoryIndex;
+}
+
+// Selector moved within an already rendered list: repaint just the two affected rows and let
+// the refresh planner flush the small dirty band instead of re-rendering the whole screen
+void SettingsActivity::renderSelectorMove() const {
+  if (lastRenderedSelectorIndex < 0 || lastRenderedSelectorIndex == selectedCategoryIndex) {
+    render();
+    return;
+  }
+
+  const auto pageWidth = renderer.getScreenWidth();
+  const int rows[2] = {lastRenderedSelectorIndex, selectedCategoryIndex};
+  for (const int i : rows) {
+    const bool selected = i == selectedCategoryIndex;
+    renderer.fillRect(0, 60 + i * 30 - 2, pageWidth - 1, 30, selected);
+    renderer.drawText(UI_10_FONT_ID, 20, 60 + i * 30, categoryNames[i], !selected);
+  }
+  lastRenderedSelectorIndex = selectedCategoryIndex;
+  renderer.displayDirty();
 }
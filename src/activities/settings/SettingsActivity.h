@@ -16,7 +16,12 @@ class SettingsActivity final : public ActivityWithSubactivity {
   TaskHandle_t displayTaskHandle = nullptr;
   SemaphoreHandle_t renderingMutex = nullptr;
   bool updateRequired = false;
+  // Selector moved but nothing else changed: the display task repaints just the two affected
+  // rows and flushes them through the refresh planner instead of a full-screen refresh
+  bool selectorOnlyUpdate = false;
   int selectedCategoryIndex = 0;  // Currently selected category
+  // Row the last paint left highlighted (-1 before the first full render)
+  mutable int lastRenderedSelectorIndex = -1;
   const std::function<void()> onGoHome;
 
   static constexpr int categoryCount = 4;
@@ -25,6 +30,7 @@ class SettingsActivity final : public ActivityWithSubactivity {
   static void taskTrampoline(void* param);
   [[noreturn]] void displayTaskLoop();
   void render() const;
+  void renderSelectorMove() const;
   void enterCategory(int categoryIndex);
 
  public:
@@ -34,4 +40,5 @@ class SettingsActivity final : public ActivityWithSubactivity {
   void onEnter() override;
   void onExit() override;
   void loop() override;
+  bool isIdle() override { return subActivity ? subActivity->isIdle() : !updateRequired && !selectorOnlyUpdate; }
 };
@@ -35,6 +35,12 @@ void KeyboardEntryActivity::onEnter() {
 
   renderingMutex = xSemaphoreCreateMutex();
 
+  // The frame shadow lets identical re-renders skip the panel push entirely (held keys,
+  // bounced input), which matters at per-keystroke cadence
+  renderer.setFrameShadowEnabled(true);
+  firstRenderDone = false;
+  turboFlushes = 0;
+
   // Trigger first update
   updateRequired = true;
 
@@ -57,6 +63,8 @@ void KeyboardEntryActivity::onExit() {
   }
   vSemaphoreDelete(renderingMutex);
   renderingMutex = nullptr;
+
+  renderer.setFrameShadowEnabled(false);
 }
 
 int KeyboardEntryActivity::getRowLength(const int row) const {
@@ -247,7 +255,11 @@ void KeyboardEntryActivity::loop() {
   }
 }
 
-void KeyboardEntryActivity::render() const {
+// A standard refresh is forced after this many consecutive turbo flushes; the moving selector
+// brackets leave low-grayscale residue that the byte diffs alone never flag as dense
+constexpr int KEYBOARD_TURBO_SETTLE = 30;
+
+void KeyboardEntryActivity::render() {
   const auto pageWidth = renderer.getScreenWidth();
 
   renderer.clearScreen();
@@ -359,7 +371,20 @@ void KeyboardEntryActivity::render() const {
   // Draw side button hints for Up/Down navigation
   renderer.drawSideButtonHints(UI_10_FONT_ID, "Up", "Down");
 
-  renderer.displayBuffer();
+  // The panel has no windowed update path, so per-keystroke speed comes from the waveform:
+  // selector moves and typed characters flush with the turbo mode (an unchanged frame skips
+  // the push via the shadow), while the first paint, shift layout switches and the periodic
+  // settle take a standard refresh to clear accumulated residue
+  const bool layoutSwitch = !firstRenderDone || shiftActive != lastRenderedShift;
+  lastRenderedShift = shiftActive;
+  firstRenderDone = true;
+  if (layoutSwitch || turboFlushes >= KEYBOARD_TURBO_SETTLE) {
+    renderer.displayBuffer();
+    turboFlushes = 0;
+  } else {
+    renderer.displayBuffer(HalDisplay::TURBO_REFRESH);
+    turboFlushes++;
+  }
 }
 
 void KeyboardEntryActivity::renderItemWithSelector(const int x, const int y, const char* item,
@@ -72,6 +72,13 @@ class KeyboardEntryActivity : public Activity {
   int selectedCol = 0;
   bool shiftActive = false;
 
+  // Refresh planning: keystroke and cursor renders flush with the turbo waveform so input
+  // tracks at partial-update speed; layout switches (shift toggles the whole key set) and a
+  // periodic settle after consecutive turbo flushes get a standard deghosting refresh
+  bool lastRenderedShift = false;
+  bool firstRenderDone = false;
+  int turboFlushes = 0;
+
   // Callbacks
   OnCompleteCallback onComplete;
   OnCancelCallback onCancel;
@@ -94,6 +101,6 @@ class KeyboardEntryActivity : public Activity {
   char getSelectedChar() const;
   void handleKeyPress();
   int getRowLength(int row) const;
-  void render() const;
+  void render();
   void renderItemWithSelector(int x, int y, const char* item, bool isSelected) const;
 };
@@ -0,0 +1,596 @@
+// Serial-driven micro-benchmark runner (env:bench). Flash it, drop fixture books under /bench
+// on the SD card, and drive it over the serial monitor:
+//
+//   list         print available scenarios
+//   run <name>   run one scenario
+//   all          run every scenario in order
+//
+// Each scenario reports cycle counts from the RISC-V cycle counter (via ESP.getCycleCount();
+// valid for runs shorter than ~26s at 160MHz before the 32-bit counter wraps), wall time, and
+// heap numbers, so perf-touching PRs can attach before/after figures from real hardware.
+//
+// The `corpus` scenario additionally needs the fixture set described by src/bench/corpus.manifest
+// copied under /bench/corpus; its per-class pagination figures are the ones published per
+// release, so parser, hyphenator, or ZIP-layer regressions surface before users feel them.
+#include <Arduino.h>
+#include <Epub.h>
+#include <Epub/Section.h>
+#include <Epub/hyphenation/Hyphenator.h>
+#include <Epub/hyphenation/LanguageRegistry.h>
+#include <GfxRenderer.h>
+#include <HalDisplay.h>
+#include <SDCardManager.h>
+#include <ZipFile.h>
+#include <builtinFonts/all.h>
+
+#include "fontIds.h"
+
+HalDisplay display;
+GfxRenderer renderer(display);
+
+// Heap allocation counter surfaced in every report() line. The bench image replaces the global
+// allocation operators with counting wrappers, so scenarios can attach before/after allocation
+// counts to PRs that touch allocation-heavy paths (e.g. per-manifest-item string churn in
+// Epub::load). Counts cover operator new only; raw malloc/free traffic is not included.
+static volatile uint32_t totalAllocs = 0;
+
+void* operator new(const size_t size) {
+  totalAllocs = totalAllocs + 1;
+  return malloc(size);
+}
+void* operator new[](const size_t size) {
+  totalAllocs = totalAllocs + 1;
+  return malloc(size);
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+// Only the fonts the scenarios touch; the full set would just slow the build down
+EpdFont bookerly14RegularFont(&bookerly_14_regular);
+EpdFont bookerly14BoldFont(&bookerly_14_bold);
+EpdFont bookerly14ItalicFont(&bookerly_14_italic);
+EpdFont bookerly14BoldItalicFont(&bookerly_14_bolditalic);
+EpdFontFamily bookerly14FontFamily(&bookerly14RegularFont, &bookerly14BoldFont, &bookerly14ItalicFont,
+                                   &bookerly14BoldItalicFont);
+EpdFont ui12RegularFont(&ubuntu_12_regular);
+EpdFont ui12BoldFont(&ubuntu_12_bold);
+EpdFontFamily ui12FontFamily(&ui12RegularFont, &ui12BoldFont);
+
+namespace {
+constexpr const char* FIXTURE_EPUB = "/bench/fixture.epub";
+constexpr const char* BENCH_CACHE_DIR = "/bench/.cache";
+// Corpus sweep fixtures: the checked-in manifest (src/bench/corpus.manifest) lists one fixture
+// book per content class; copy it and the books it names onto the card
+constexpr const char* CORPUS_MANIFEST = "/bench/corpus.manifest";
+
+// Layout parameters held constant across firmware versions so section numbers stay comparable
+constexpr int BENCH_FONT_ID = BOOKERLY_14_FONT_ID;
+constexpr float BENCH_LINE_COMPRESSION = 1.0f;
+constexpr uint16_t BENCH_VIEWPORT_WIDTH = 440;
+constexpr uint16_t BENCH_VIEWPORT_HEIGHT = 750;
+
+struct BenchScenario {
+  const char* name;
+  const char* description;
+  bool (*fn)();
+};
+
+struct Measurement {
+  uint32_t startCycles = 0;
+  uint32_t startMicros = 0;
+  uint32_t heapBefore = 0;
+  uint32_t minFreeBefore = 0;
+  uint32_t allocsBefore = 0;
+};
+
+Measurement begin() {
+  Measurement m;
+  m.heapBefore = ESP.getFreeHeap();
+  m.minFreeBefore = ESP.getMinFreeHeap();
+  m.allocsBefore = totalAllocs;
+  m.startMicros = micros();
+  m.startCycles = ESP.getCycleCount();
+  return m;
+}
+
+void report(const char* name, const Measurement& m) {
+  const uint32_t cycles = ESP.getCycleCount() - m.startCycles;
+  const uint32_t elapsedUs = micros() - m.startMicros;
+  const uint32_t allocs = totalAllocs - m.allocsBefore;
+  const uint32_t heapAfter = ESP.getFreeHeap();
+  const uint32_t minFree = ESP.getMinFreeHeap();
+  // The lifetime minimum only identifies this scenario's high-water mark when it dropped here
+  Serial.printf(
+      "[BENCH] %s: cycles=%lu time_us=%lu allocs=%lu heap_before=%lu heap_after=%lu min_free=%lu min_free_hit=%s\n",
+      name, static_cast<unsigned long>(cycles), static_cast<unsigned long>(elapsedUs),
+      static_cast<unsigned long>(allocs), static_cast<unsigned long>(m.heapBefore),
+      static_cast<unsigned long>(heapAfter), static_cast<unsigned long>(minFree),
+      minFree < m.minFreeBefore ? "yes" : "no");
+}
+
+bool requireFixture() {
+  if (SdMan.exists(FIXTURE_EPUB)) {
+    return true;
+  }
+  Serial.printf("[BENCH] Missing fixture %s on SD card\n", FIXTURE_EPUB);
+  return false;
+}
+
+// ZipFile::readFileToMemory on an entry every EPUB carries
+bool benchZipRead() {
+  if (!requireFixture()) {
+    return false;
+  }
+  const std::string path = FIXTURE_EPUB;
+  ZipFile zip(path);
+
+  const auto m = begin();
+  size_t size = 0;
+  uint8_t* data = zip.readFileToMemory("META-INF/container.xml", &size);
+  report("zip-read", m);
+
+  if (!data) {
+    Serial.printf("[BENCH] zip-read failed: entry not found\n");
+    return false;
+  }
+  Serial.printf("[BENCH] zip-read inflated %u bytes\n", size);
+  free(data);
+  return true;
+}
+
+// Cold Epub::load (container + content.opf parse, spine/TOC cache build); the per-manifest-item
+// allocation figure lives here. Removes book.bin first so the parse actually runs
+bool benchEpubLoad() {
+  if (!requireFixture()) {
+    return false;
+  }
+  SdMan.mkdir(BENCH_CACHE_DIR);
+
+  auto epub = std::make_shared<Epub>(FIXTURE_EPUB, BENCH_CACHE_DIR);
+  const auto bookBin = epub->getCachePath() + "/book.bin";
+  if (SdMan.exists(bookBin.c_str())) {
+    SdMan.remove(bookBin.c_str());
+  }
+
+  const auto m = begin();
+  const bool ok = epub->load();
+  report("epub-load", m);
+
+  if (!ok) {
+    Serial.printf("[BENCH] Epub load failed\n");
+    return false;
+  }
+  Serial.printf("[BENCH] Loaded \"%s\": %d spine items\n", epub->getTitle().c_str(), epub->getSpineItemsCount());
+  return true;
+}
+
+// Full Section::createSectionFile pass (inflate + HTML parse + layout) for spine item 0
+bool benchSectionBuild(const bool useWordCache) {
+  if (!requireFixture()) {
+    return false;
+  }
+  SdMan.mkdir(BENCH_CACHE_DIR);
+
+  auto epub = std::make_shared<Epub>(FIXTURE_EPUB, BENCH_CACHE_DIR);
+  if (!epub->load()) {
+    Serial.printf("[BENCH] Failed to load fixture epub\n");
+    return false;
+  }
+  if (epub->getSpineItemsCount() == 0) {
+    Serial.printf("[BENCH] Fixture epub has no spine items\n");
+    return false;
+  }
+
+  const uint32_t layoutKey = Section::layoutKey(BENCH_FONT_ID, BENCH_LINE_COMPRESSION, false, 0, BENCH_VIEWPORT_WIDTH,
+                                                BENCH_VIEWPORT_HEIGHT, false, false);
+  Section section(epub, 0, renderer, layoutKey);
+  section.clearCache();
+  if (!useWordCache) {
+    // Force the full inflate + parse path; the warm variant measures the word-cache replay
+    const auto wordCache = epub->getCachePath() + "/sections/0.words";
+    if (SdMan.exists(wordCache.c_str())) {
+      SdMan.remove(wordCache.c_str());
+    }
+  }
+
+  const auto m = begin();
+  const bool ok = section.createSectionFile(BENCH_FONT_ID, BENCH_LINE_COMPRESSION, false, 0, BENCH_VIEWPORT_WIDTH,
+                                            BENCH_VIEWPORT_HEIGHT, false, false);
+  const uint32_t elapsedUs = micros() - m.startMicros;
+  report(useWordCache ? "section-rebuild" : "section-build", m);
+
+  if (!ok) {
+    Serial.printf("[BENCH] Section build failed\n");
+    return false;
+  }
+  Serial.printf("[BENCH] Section built: %d pages\n", section.pageCount);
+
+  if (!useWordCache && elapsedUs > 0) {
+    // Tracked parse-throughput figure: the cold build is expat-dominated, so bytes of
+    // XHTML per second is the number to compare across parser changes
+    size_t sourceSize = 0;
+    if (epub->getItemSize(epub->getSpineItem(0).href, &sourceSize) && sourceSize > 0) {
+      const uint32_t kbPerSec = static_cast<uint32_t>((static_cast<uint64_t>(sourceSize) * 1000000u) / elapsedUs / 1024u);
+      Serial.printf("[BENCH] XHTML parse throughput: %u bytes in %lu us (%lu KB/s)\n", sourceSize,
+                    static_cast<unsigned long>(elapsedUs), static_cast<unsigned long>(kbPerSec));
+    }
+  }
+  return true;
+}
+
+bool benchSectionBuildCold() { return benchSectionBuild(false); }
+bool benchSectionBuildWarm() { return benchSectionBuild(true); }
+
+// Section::loadPageFromSectionFile for every page of spine item 0; the page-turn hot path.
+// The compressed variant rebuilds the section with LZ4 page records first, so running
+// `page-load` then `page-load-z` on the same card gives the decode+read vs plain read figures
+// that decide whether EPUB_COMPRESS_SECTION_PAGES is worth enabling.
+bool benchPageLoad(const bool compressed) {
+  if (!requireFixture()) {
+    return false;
+  }
+  SdMan.mkdir(BENCH_CACHE_DIR);
+
+  auto epub = std::make_shared<Epub>(FIXTURE_EPUB, BENCH_CACHE_DIR);
+  if (!epub->load()) {
+    Serial.printf("[BENCH] Failed to load fixture epub\n");
+    return false;
+  }
+
+  const uint32_t layoutKey = Section::layoutKey(BENCH_FONT_ID, BENCH_LINE_COMPRESSION, false, 0, BENCH_VIEWPORT_WIDTH,
+                                                BENCH_VIEWPORT_HEIGHT, false, false);
+  Section section(epub, 0, renderer, layoutKey);
+  const bool savedCompress = Section::compressPageRecords;
+  Section::compressPageRecords = compressed;
+  if (compressed) {
+    // A section built by an earlier scenario has plain records; force a compressed build
+    section.clearCache();
+  }
+  const bool ready = section.loadSectionFile(BENCH_FONT_ID, BENCH_LINE_COMPRESSION, false, 0, BENCH_VIEWPORT_WIDTH,
+                                             BENCH_VIEWPORT_HEIGHT, false, false) ||
+                     section.createSectionFile(BENCH_FONT_ID, BENCH_LINE_COMPRESSION, false, 0, BENCH_VIEWPORT_WIDTH,
+                                               BENCH_VIEWPORT_HEIGHT, false, false);
+  if (!ready) {
+    Section::compressPageRecords = savedCompress;
+    Serial.printf("[BENCH] Could not load or build section file\n");
+    return false;
+  }
+  if (section.pageCount == 0) {
+    Section::compressPageRecords = savedCompress;
+    Serial.printf("[BENCH] Section has no pages\n");
+    return false;
+  }
+
+  const auto m = begin();
+  int loadedPages = 0;
+  for (int page = 0; page < section.pageCount; page++) {
+    section.seekToPage(page);
+    if (section.loadPageFromSectionFile()) {
+      loadedPages++;
+    }
+  }
+  report(compressed ? "page-load-z" : "page-load", m);
+
+  Serial.printf("[BENCH] Loaded %d/%d pages\n", loadedPages, section.pageCount);
+  if (compressed) {
+    // The on-SD saving is the other half of the trade; a compressed build that loads slower
+    // can still win on a library that no longer fits the card
+    char layoutDir[9];
+    snprintf(layoutDir, sizeof(layoutDir), "%08lx", static_cast<unsigned long>(layoutKey));
+    const auto path = epub->getCachePath() + "/sections/" + layoutDir + "/0.bin";
+    FsFile sectionFile;
+    if (SdMan.openFileForRead("BNC", path, sectionFile)) {
+      Serial.printf("[BENCH] Compressed section file: %lu bytes\n", static_cast<unsigned long>(sectionFile.size()));
+      sectionFile.close();
+    }
+    // Leave the cache plain for whatever scenario runs next
+    section.clearCache();
+  }
+  Section::compressPageRecords = savedCompress;
+  return loadedPages == section.pageCount;
+}
+
+bool benchPageLoadPlain() { return benchPageLoad(false); }
+bool benchPageLoadCompressed() { return benchPageLoad(true); }
+
+// Cold Epub::load plus a full Section::createSectionFile sweep for one corpus class: every
+// spine item built from scratch (no book.bin, no word cache), which is exactly the first-open
+// and font-change experience. Reports wall time per stage, parse throughput (source XHTML
+// bytes per second), pages per second, section bytes written, and the heap high-water mark.
+// Timing uses millis() rather than the cycle counter: a 1,500-item comic sweep runs far past
+// the 32-bit counter's ~26s wrap.
+bool benchCorpusClass(const char* bookClass, const std::string& epubPath) {
+  if (!SdMan.exists(epubPath.c_str())) {
+    Serial.printf("[BENCH] corpus %s: missing fixture %s\n", bookClass, epubPath.c_str());
+    return false;
+  }
+
+  auto epub = std::make_shared<Epub>(epubPath, BENCH_CACHE_DIR);
+  const auto bookBin = epub->getCachePath() + "/book.bin";
+  if (SdMan.exists(bookBin.c_str())) {
+    SdMan.remove(bookBin.c_str());
+  }
+
+  const uint32_t heapBefore = ESP.getFreeHeap();
+  const uint32_t minFreeBefore = ESP.getMinFreeHeap();
+
+  const uint32_t loadStart = millis();
+  if (!epub->load()) {
+    Serial.printf("[BENCH] corpus %s: Epub load failed\n", bookClass);
+    return false;
+  }
+  const uint32_t loadMs = millis() - loadStart;
+
+  const int items = epub->getSpineItemsCount();
+  if (items == 0) {
+    Serial.printf("[BENCH] corpus %s: fixture has no spine items\n", bookClass);
+    return false;
+  }
+
+  const uint32_t layoutKey = Section::layoutKey(BENCH_FONT_ID, BENCH_LINE_COMPRESSION, false, 0, BENCH_VIEWPORT_WIDTH,
+                                                BENCH_VIEWPORT_HEIGHT, false, false);
+  char layoutDir[9];
+  snprintf(layoutDir, sizeof(layoutDir), "%08lx", static_cast<unsigned long>(layoutKey));
+
+  uint64_t srcBytes = 0;
+  uint64_t sectionBytes = 0;
+  uint32_t pages = 0;
+  int built = 0;
+  const uint32_t sweepStart = millis();
+  for (int i = 0; i < items; i++) {
+    Section section(epub, i, renderer, layoutKey);
+    // Cold per item: drop both the section file and the word cache so every build pays the
+    // full inflate + parse + layout cost
+    section.clearCache();
+    const auto wordCache = epub->getCachePath() + "/sections/" + std::to_string(i) + ".words";
+    if (SdMan.exists(wordCache.c_str())) {
+      SdMan.remove(wordCache.c_str());
+    }
+
+    if (!section.createSectionFile(BENCH_FONT_ID, BENCH_LINE_COMPRESSION, false, 0, BENCH_VIEWPORT_WIDTH,
+                                   BENCH_VIEWPORT_HEIGHT, false, false)) {
+      Serial.printf("[BENCH] corpus %s: section build failed for spine item %d\n", bookClass, i);
+      continue;
+    }
+    built++;
+    pages += section.pageCount;
+
+    size_t itemSize = 0;
+    if (epub->getItemSize(epub->getSpineItem(i).href, &itemSize)) {
+      srcBytes += itemSize;
+    }
+    // Output side of the SD traffic; the input side is srcBytes (what the ZIP layer inflated)
+    const auto binPath = epub->getCachePath() + "/sections/" + layoutDir + "/" + std::to_string(i) + ".bin";
+    FsFile bin;
+    if (SdMan.openFileForRead("BNC", binPath, bin)) {
+      sectionBytes += bin.size();
+      bin.close();
+    }
+  }
+  const uint32_t sweepMs = millis() - sweepStart;
+  const uint32_t minFree = ESP.getMinFreeHeap();
+
+  const uint32_t ms = sweepMs > 0 ? sweepMs : 1;
+  const uint32_t parseKbPerSec = static_cast<uint32_t>(srcBytes * 1000u / ms / 1024u);
+  const uint32_t pagesPerSecTenths = static_cast<uint32_t>(static_cast<uint64_t>(pages) * 10000u / ms);
+  Serial.printf(
+      "[BENCH] corpus %s: items=%d/%d pages=%lu load_ms=%lu sweep_ms=%lu parse_kb_s=%lu pages_s=%lu.%lu "
+      "src_kb=%lu section_kb=%lu heap_before=%lu min_free=%lu min_free_hit=%s\n",
+      bookClass, built, items, static_cast<unsigned long>(pages), static_cast<unsigned long>(loadMs),
+      static_cast<unsigned long>(sweepMs), static_cast<unsigned long>(parseKbPerSec),
+      static_cast<unsigned long>(pagesPerSecTenths / 10), static_cast<unsigned long>(pagesPerSecTenths % 10),
+      static_cast<unsigned long>(srcBytes / 1024), static_cast<unsigned long>(sectionBytes / 1024),
+      static_cast<unsigned long>(heapBefore), static_cast<unsigned long>(minFree),
+      minFree < minFreeBefore ? "yes" : "no");
+  return built == items;
+}
+
+// Walks the corpus manifest and sweeps every class present; a missing fixture fails its class
+// but the rest still report, so a partial card population yields partial figures
+bool benchCorpus() {
+  FsFile manifest;
+  if (!SdMan.openFileForRead("BNC", CORPUS_MANIFEST, manifest)) {
+    Serial.printf("[BENCH] Missing %s on SD card (checked in at src/bench/corpus.manifest)\n", CORPUS_MANIFEST);
+    return false;
+  }
+
+  bool allOk = true;
+  int classes = 0;
+  String line;
+  while (true) {
+    const int c = manifest.read();
+    if (c >= 0 && c != '\n' && c != '\r') {
+      line += static_cast<char>(c);
+      continue;
+    }
+    line.trim();
+    if (line.length() > 0 && !line.startsWith("#")) {
+      const int split = line.indexOf(' ');
+      if (split > 0) {
+        String cls = line.substring(0, split);
+        String path = line.substring(split);
+        path.trim();
+        classes++;
+        if (!benchCorpusClass(cls.c_str(), std::string(path.c_str()))) {
+          allOk = false;
+        }
+      } else {
+        Serial.printf("[BENCH] Malformed manifest line: %s\n", line.c_str());
+        allOk = false;
+      }
+    }
+    line = "";
+    if (c < 0) {
+      break;
+    }
+  }
+  manifest.close();
+
+  if (classes == 0) {
+    Serial.printf("[BENCH] Corpus manifest has no entries\n");
+    return false;
+  }
+  return allOk;
+}
+
+// Full-screen text paint + GfxRenderer::displayBuffer flush
+bool benchDisplayFlush() {
+  renderer.clearScreen();
+  for (int y = 40; y < renderer.getScreenHeight() - 40; y += 28) {
+    renderer.drawText(BENCH_FONT_ID, 20, y, "The quick brown fox jumps over the lazy dog");
+  }
+
+  const auto m = begin();
+  renderer.displayBuffer();
+  report("display-flush", m);
+  return true;
+}
+
+// Liang trie walk on real hardware: raw LanguageHyphenator::breakIndexes throughput (the trie
+// format's number) plus the full memoized Hyphenator::breakOffsetsInto path layout actually
+// hits. Companion to `run_hyphenation_eval.sh bench`, which compares trie layouts on the host;
+// format changes need both sets of figures.
+bool benchHyphenation() {
+  const auto* hyphenator = getLanguageHyphenatorForPrimaryTag("en");
+  if (!hyphenator) {
+    Serial.printf("[BENCH] No English trie in the hyph partition\n");
+    return false;
+  }
+  Hyphenator::setPreferredLanguage("en");
+
+  // Long-ish words so most walks actually descend the trie instead of bailing at minima
+  static const char* const words[] = {
+      "hyphenation",   "associate",   "declination",  "philanthropic", "university",   "representative",
+      "demonstration", "algorithm",   "projects",     "concatenation", "supercalifragilistic",
+      "computer",      "table",       "programming",  "present",       "necessary",
+      "dictionary",    "information", "considerable", "miscellaneous", "understanding",
+      "extraordinary", "photography", "mathematics",
+  };
+  constexpr size_t WORD_COUNT = sizeof(words) / sizeof(words[0]);
+  constexpr int ROUNDS = 200;
+
+  std::vector<std::vector<CodepointInfo>> corpus(WORD_COUNT);
+  for (size_t i = 0; i < WORD_COUNT; i++) {
+    corpus[i] = collectCodepoints(words[i]);
+    trimSurroundingPunctuationAndFootnote(corpus[i]);
+  }
+
+  size_t breaks = 0;
+  auto m = begin();
+  for (int round = 0; round < ROUNDS; round++) {
+    for (const auto& cps : corpus) {
+      breaks += hyphenator->breakIndexes(cps).size();
+    }
+  }
+  uint32_t elapsedUs = micros() - m.startMicros;
+  report("hyph-trie", m);
+  Serial.printf("[BENCH] trie walk: %u words, %u breaks, %lu words/s\n",
+                static_cast<unsigned>(WORD_COUNT * ROUNDS), static_cast<unsigned>(breaks),
+                static_cast<unsigned long>(static_cast<uint64_t>(WORD_COUNT) * ROUNDS * 1000000u /
+                                           (elapsedUs > 0 ? elapsedUs : 1)));
+
+  Hyphenator::BreakInfo buffer[16];
+  breaks = 0;
+  m = begin();
+  for (int round = 0; round < ROUNDS; round++) {
+    for (size_t i = 0; i < WORD_COUNT; i++) {
+      breaks += Hyphenator::breakOffsetsInto(words[i], false, buffer, 16);
+    }
+  }
+  elapsedUs = micros() - m.startMicros;
+  report("hyph-cached", m);
+  Serial.printf("[BENCH] memoized path: %u breaks, %lu words/s\n", static_cast<unsigned>(breaks),
+                static_cast<unsigned long>(static_cast<uint64_t>(WORD_COUNT) * ROUNDS * 1000000u /
+                                           (elapsedUs > 0 ? elapsedUs : 1)));
+  return true;
+}
+
+const BenchScenario scenarios[] = {
+    {"zip-read", "ZipFile::readFileToMemory of META-INF/container.xml", benchZipRead},
+    {"epub-load", "Cold Epub::load (metadata parse + cache build)", benchEpubLoad},
+    {"section-build", "Section::createSectionFile, cold (inflate + parse + layout)", benchSectionBuildCold},
+    {"section-rebuild", "Section::createSectionFile from the word cache", benchSectionBuildWarm},
+    {"page-load", "Section::loadPageFromSectionFile for every page", benchPageLoadPlain},
+    {"page-load-z", "page-load over an LZ4-compressed section build", benchPageLoadCompressed},
+    {"corpus", "Cold Epub::load + full section sweep per corpus manifest class", benchCorpus},
+    {"display-flush", "Full-screen text paint + displayBuffer", benchDisplayFlush},
+    {"hyphenation", "Liang trie walk + memoized breakOffsets on the English trie", benchHyphenation},
+};
+
+void printScenarios() {
+  Serial.printf("[BENCH] Scenarios:\n");
+  for (const auto& scenario : scenarios) {
+    Serial.printf("[BENCH]   %-16s %s\n", scenario.name, scenario.description);
+  }
+}
+
+void runScenario(const BenchScenario& scenario) {
+  Serial.printf("[BENCH] Running %s...\n", scenario.name);
+  if (!scenario.fn()) {
+    Serial.printf("[BENCH] %s FAILED\n", scenario.name);
+  }
+}
+
+void handleCommand(const String& line) {
+  if (line == "list" || line == "help") {
+    printScenarios();
+    return;
+  }
+  if (line == "all") {
+    for (const auto& scenario : scenarios) {
+      runScenario(scenario);
+    }
+    return;
+  }
+  if (line.startsWith("run ")) {
+    const String name = line.substring(4);
+    for (const auto& scenario : scenarios) {
+      if (name == scenario.name) {
+        runScenario(scenario);
+        return;
+      }
+    }
+    Serial.printf("[BENCH] Unknown scenario: %s\n", name.c_str());
+    return;
+  }
+  Serial.printf("[BENCH] Unknown command: %s (try: list, run <name>, all)\n", line.c_str());
+}
+}  // namespace
+
+void setup() {
+  Serial.begin(115200);
+  const unsigned long start = millis();
+  while (!Serial && millis() - start < 3000) {
+    delay(10);
+  }
+
+  Serial.printf("[%lu] [BENCH] CrossPoint benchmark runner " CROSSPOINT_VERSION "\n", millis());
+
+  if (!SdMan.begin()) {
+    Serial.printf("[%lu] [BENCH] SD card initialization failed\n", millis());
+  }
+
+  display.begin();
+  renderer.insertFont(BOOKERLY_14_FONT_ID, bookerly14FontFamily);
+  renderer.insertFont(UI_12_FONT_ID, ui12FontFamily);
+
+  printScenarios();
+}
+
+void loop() {
+  static String line;
+  while (Serial.available()) {
+    const char c = static_cast<char>(Serial.read());
+    if (c == '\n' || c == '\r') {
+      if (line.length() > 0) {
+        handleCommand(line);
+        line = "";
+      }
+    } else {
+      line += c;
+    }
+  }
+  delay(10);
+}
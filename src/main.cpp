@@ -1,20 +1,29 @@
 #include <Arduino.h>
+#include <CrashLog.h>
 #include <Epub.h>
 #include <GfxRenderer.h>
 #include <HalDisplay.h>
 #include <HalGPIO.h>
+#include <HalSpiBus.h>
+#include <HeapMonitor.h>
 #include <SDCardManager.h>
 #include <SPI.h>
+#include <Trace.h>
 #include <builtinFonts/all.h>
 
 #include <cstring>
 
+#include "AsyncTaskQueue.h"
 #include "Battery.h"
+#include "CacheGc.h"
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
-#include "KOReaderCredentialStore.h"
+#include "HomeFrameCache.h"
 #include "MappedInputManager.h"
+#include "PowerGovernor.h"
+#include "ReadingStats.h"
 #include "RecentBooksStore.h"
+#include "SdIoScheduler.h"
 #include "activities/boot_sleep/BootActivity.h"
 #include "activities/boot_sleep/SleepActivity.h"
 #include "activities/browser/OpdsBookBrowserActivity.h"
@@ -196,6 +205,12 @@ void enterDeepSleep() {
   enterNewActivity(new SleepActivity(renderer, mappedInputManager));
 
   display.deepSleep();
+
+  // Last chance to land write-behind state (open book, sleep image, stats) before power-down
+  APP_STATE.flush();
+  READING_STATS.flushIfDirty();
+  CACHE_GC.flushIfDirty();
+
   Serial.printf("[%lu] [   ] Power button press calibration value: %lu ms\n", millis(), t2 - t1);
   Serial.printf("[%lu] [   ] Entering deep sleep.\n", millis());
 
@@ -268,6 +283,7 @@ void setupDisplayAndFonts() {
 
 void setup() {
   t1 = millis();
+  TRACE_BEGIN("boot");
 
   gpio.begin();
 
@@ -280,9 +296,18 @@ void setup() {
       delay(10);
     }
   }
+  const unsigned long tSerial = millis();
+
+  // Capture whatever the previous run left in the RTC crash region before anything can reset it
+  CRASH_LOG.begin();
+
+  // Settings live in NVS, so they load before the SD card is even mounted and survive card swaps
+  SETTINGS.load();
+  const unsigned long tSettings = millis();
 
   // SD Card Initialization
   // We need 6 open files concurrently when parsing a new chapter
+  TRACE_BEGIN("boot/sd");
   if (!SdMan.begin()) {
     Serial.printf("[%lu] [   ] SD card initialization failed\n", millis());
     setupDisplayAndFonts();
@@ -290,28 +315,56 @@ void setup() {
     enterNewActivity(new FullScreenMessageActivity(renderer, mappedInputManager, "SD card error", EpdFontFamily::BOLD));
     return;
   }
+  TRACE_END("boot/sd");
+  const unsigned long tSd = millis();
+
+  // Land the previous run's crash report now that the SD card is up
+  CRASH_LOG.persistIfCrashed();
 
-  SETTINGS.loadFromFile();
-  KOREADER_STORE.loadFromFile();
+  // One-time import for devices whose settings still live on the card; no-op once NVS has them.
+  // The credential and queue stores load lazily from the activities that use them
+  SETTINGS.migrateFromSd();
 
   if (gpio.isWakeupByPowerButton()) {
     // For normal wakeups, verify power button press duration
     Serial.printf("[%lu] [   ] Verifying power button press duration\n", millis());
     verifyPowerButtonDuration();
   }
+  const unsigned long tPwrBtn = millis();
 
   // First serial output only here to avoid timing inconsistencies for power button press duration verification
   Serial.printf("[%lu] [   ] Starting CrossPoint version " CROSSPOINT_VERSION "\n", millis());
 
+  // Seed the battery filter with one synchronous read before anything renders a status bar
+  BATTERY.begin();
+
+  TRACE_BEGIN("boot/display");
   setupDisplayAndFonts();
+  TRACE_END("boot/display");
+  const unsigned long tDisplay = millis();
 
+  TRACE_BEGIN("boot/splash");
   exitActivity();
   enterNewActivity(new BootActivity(renderer, mappedInputManager));
+  TRACE_END("boot/splash");
+  const unsigned long tSplash = millis();
 
+  TRACE_BEGIN("boot/activity");
   APP_STATE.loadFromFile();
   RECENT_BOOKS.loadFromFile();
+  READING_STATS.loadFromFile();
+  CACHE_GC.loadFromFile();
+  // Trim over-budget caches in the background once boot-time SD traffic has priority sorted out
+  CACHE_GC.scheduleSweep();
 
   if (APP_STATE.openEpubPath.empty()) {
+    // Cold boot lands on the home screen: blit the frame it composed last time, tagged as
+    // refreshing, so the menu is on glass while HomeActivity rebuilds it behind
+    if (HomeFrameCache::restore(renderer, HomeFrameCache::currentKey())) {
+      renderer.drawText(SMALL_FONT_ID, 10, 10, "refreshing...");
+      renderer.markFullScreenDirty();
+      renderer.displayBuffer();
+    }
     onGoHome();
   } else {
     // Clear app state to avoid getting into a boot loop if the epub doesn't load
@@ -321,9 +374,51 @@ void setup() {
     APP_STATE.saveToFile();
     onGoToReader(path, MyLibraryActivity::Tab::Recent);
   }
+  TRACE_END("boot/activity");
+  TRACE_END("boot");
+
+  // Per-stage boot breakdown (pwrbtn includes however long the user held the button)
+  Serial.printf("[%lu] [BOOT] serial %lums, settings %lums, sd %lums, pwrbtn %lums, display+fonts %lums, "
+                "splash %lums, activity %lums\n",
+                millis(), tSerial - t1, tSettings - tSerial, tSd - tSettings, tPwrBtn - tSd, tDisplay - tPwrBtn,
+                tSplash - tDisplay, millis() - tSplash);
 
   // Ensure we're not still holding the power button before leaving setup
   waitForPowerRelease();
+
+  // Boot ran at the full clock; from here on the hot paths earn the boost via leases
+  PGOV.begin();
+}
+
+// Keep the tight 10ms poll for a bit after the last input so multi-press interactions stay snappy;
+// this also outlasts the reader's 2s idle wake, so its speculative pagination gets going first
+constexpr unsigned long lightSleepGraceMs = 2500;
+// Light-sleep timer wake; bounds the latency of the buttons that can't wake us by GPIO
+constexpr uint32_t lightSleepPollMs = 60;
+unsigned long lightSleeps = 0;
+unsigned long lightSleptMs = 0;
+
+// Light sleep halts every FreeRTOS task, so only enter once the whole system is quiescent
+bool readyForLightSleep(const unsigned long lastActivityTime) {
+  if (!currentActivity || !currentActivity->isIdle()) {
+    return false;
+  }
+  // Held buttons need tight getHeldTime() sampling (chapter skip, hold-to-sleep)
+  if (gpio.isAnyPressed()) {
+    return false;
+  }
+  if (millis() - lastActivityTime < lightSleepGraceMs) {
+    return false;
+  }
+  // Background jobs and an in-flight panel flush stop when the clock does
+  if (!TASK_QUEUE.isIdle() || display.isFlushing()) {
+    return false;
+  }
+  // Light sleep kills USB CDC; stay awake while tethered so serial logging and flashing work
+  if (gpio.isUsbConnected()) {
+    return false;
+  }
+  return true;
 }
 
 void loop() {
@@ -332,13 +427,55 @@ void loop() {
   static unsigned long lastMemPrint = 0;
 
   gpio.update();
+  mappedInputManager.update();
 
-  if (Serial && millis() - lastMemPrint >= 10000) {
-    Serial.printf("[%lu] [MEM] Free: %d bytes, Total: %d bytes, Min Free: %d bytes\n", millis(), ESP.getFreeHeap(),
-                  ESP.getHeapSize(), ESP.getMinFreeHeap());
+  // Button activity boosts the clock so the triggered render runs fast; update() drops back to
+  // the idle clock once leases are gone and the interactive hold expires
+  if (gpio.wasAnyPressed()) {
+    PGOV.kick();
+  }
+  PGOV.update();
+
+  if (millis() - lastMemPrint >= 10000) {
+    // Feed the fragmentation history behind the web server's /api/heap debug endpoint
+    HEAP_MON.sample();
+    // Keep the RTC crash region's uptime and heap low-water fresh for the next post-mortem
+    CRASH_LOG.sample();
+    // Re-sample the battery in the background once its cadence elapses, and let the task queue
+    // gate its background classes on the result (USB power stands in for charging)
+    BATTERY.update();
+    TASK_QUEUE.setPowerState(BATTERY.percentage(), gpio.isUsbConnected());
+    // Shed reclaimable caches while the heap is under pressure (web server + big book open)
+    HEAP_MON.checkPressure();
+    if (Serial) {
+      Serial.printf("[%lu] [MEM] Free: %d bytes, Total: %d bytes, Min Free: %d bytes, Largest Block: %d bytes\n",
+                    millis(), ESP.getFreeHeap(), ESP.getHeapSize(), ESP.getMinFreeHeap(), ESP.getMaxAllocHeap());
+      const auto sdStats = SD_SCHED.getStats();
+      if (sdStats.yields > 0) {
+        Serial.printf("[%lu] [SDQ] I/O yields: %lu (%lu ms total), max depth ui/prefetch/bg: %u/%u/%u\n", millis(),
+                      sdStats.yields, sdStats.yieldWaitMs, sdStats.maxDepth[0], sdStats.maxDepth[1],
+                      sdStats.maxDepth[2]);
+      }
+      const auto busStats = SPI_BUS.getStats();
+      if (busStats.contentions > 0) {
+        Serial.printf("[%lu] [SPI] Panel windows: %lu, SD waits: %lu (%lu ms total)\n", millis(), busStats.windows,
+                      busStats.contentions, busStats.contentionWaitMs);
+      }
+      const auto pgvStats = PGOV.getStats();
+      if (pgvStats.boosts > 0) {
+        Serial.printf("[%lu] [PGV] Boosts: %lu (%lu ms total), active leases: %u\n", millis(), pgvStats.boosts,
+                      pgvStats.boostedMs, pgvStats.activeLeases);
+      }
+      if (lightSleeps > 0) {
+        Serial.printf("[%lu] [SLP] Light sleeps: %lu (%lu ms total)\n", millis(), lightSleeps, lightSleptMs);
+      }
+    }
     lastMemPrint = millis();
   }
 
+  // Write-behind flush of app state; no-op unless a reader/sleep path marked it dirty
+  APP_STATE.flushIfDirty();
+
   // Check for any user activity (button press or release) or active background work
   static unsigned long lastActivityTime = millis();
   if (gpio.wasAnyPressed() || gpio.wasAnyReleased() || (currentActivity && currentActivity->preventAutoSleep())) {
@@ -376,9 +513,15 @@ void loop() {
 
   // Add delay at the end of the loop to prevent tight spinning
   // When an activity requests skip loop delay (e.g., webserver running), use yield() for faster response
-  // Otherwise, use longer delay to save power
+  // When everything is quiescent, light-sleep between input polls instead of delaying: the power
+  // button wakes us level-triggered and the timer wake bounds the other buttons' latency
   if (currentActivity && currentActivity->skipLoopDelay()) {
     yield();  // Give FreeRTOS a chance to run tasks, but return immediately
+  } else if (readyForLightSleep(lastActivityTime)) {
+    const unsigned long beforeSleepMs = millis();
+    gpio.lightSleep(lightSleepPollMs);
+    lightSleeps++;
+    lightSleptMs += millis() - beforeSleepMs;
   } else {
     delay(10);  // Normal delay when no activity requires fast response
   }
@@ -0,0 +1,91 @@
+// Host-native pagination harness (env:native). Builds the EPUB parsing and pagination pipeline
+// - ZipFile inflate, the slim HTML parser, hyphenation, line layout, section file writing -
+// against the POSIX shims in native/shims, as a CLI that paginates a corpus of books. That puts
+// the hot paths in front of tooling the device can't run:
+//
+//   pio run -e native
+//   .pio/build/native/program <sd-root> <epub-path>...
+//
+// where <sd-root> is a host directory standing in for the SD card root and each <epub-path> is
+// an SD-absolute path beneath it (e.g. /books/alice.epub). Caches land under <sd-root>/.crosspoint
+// like on device; each run clears the per-section caches first so every invocation measures a
+// full cold paginate. Wrap the binary in perf/valgrind/ASan as needed.
+#include <Epub.h>
+#include <Epub/Section.h>
+#include <GfxRenderer.h>
+#include <HalDisplay.h>
+#include <SDCardManager.h>
+#include <builtinFonts/all.h>
+
+#include "fontIds.h"
+
+HalDisplay display;
+GfxRenderer renderer(display);
+
+EpdFont bookerly14RegularFont(&bookerly_14_regular);
+EpdFont bookerly14BoldFont(&bookerly_14_bold);
+EpdFont bookerly14ItalicFont(&bookerly_14_italic);
+EpdFont bookerly14BoldItalicFont(&bookerly_14_bolditalic);
+EpdFontFamily bookerly14FontFamily(&bookerly14RegularFont, &bookerly14BoldFont, &bookerly14ItalicFont,
+                                   &bookerly14BoldItalicFont);
+
+namespace {
+constexpr const char* CACHE_DIR = "/.crosspoint";
+
+// Same fixed layout parameters as env:bench, so numbers from the two harnesses line up
+constexpr int LAYOUT_FONT_ID = BOOKERLY_14_FONT_ID;
+constexpr float LAYOUT_LINE_COMPRESSION = 1.0f;
+constexpr uint16_t LAYOUT_VIEWPORT_WIDTH = 440;
+constexpr uint16_t LAYOUT_VIEWPORT_HEIGHT = 750;
+
+bool paginateBook(const char* path) {
+  auto epub = std::make_shared<Epub>(path, CACHE_DIR);
+  if (!epub->load()) {
+    Serial.printf("[NATIVE] Failed to load %s\n", path);
+    return false;
+  }
+  Serial.printf("[NATIVE] %s: \"%s\", %d spine items\n", path, epub->getTitle().c_str(), epub->getSpineItemsCount());
+
+  const uint32_t layoutKey = Section::layoutKey(LAYOUT_FONT_ID, LAYOUT_LINE_COMPRESSION, false, 0,
+                                                LAYOUT_VIEWPORT_WIDTH, LAYOUT_VIEWPORT_HEIGHT, true, false);
+  uint32_t totalPages = 0;
+  const unsigned long bookStart = millis();
+  for (int i = 0; i < epub->getSpineItemsCount(); i++) {
+    Section section(epub, i, renderer, layoutKey);
+    section.clearCache();
+    const unsigned long sectionStart = millis();
+    if (!section.createSectionFile(LAYOUT_FONT_ID, LAYOUT_LINE_COMPRESSION, false, 0, LAYOUT_VIEWPORT_WIDTH,
+                                   LAYOUT_VIEWPORT_HEIGHT, true, false)) {
+      Serial.printf("[NATIVE] %s: section %d failed to paginate\n", path, i);
+      return false;
+    }
+    Serial.printf("[NATIVE] %s: section %d -> %u pages in %lums\n", path, i,
+                  static_cast<unsigned>(section.pageCount), millis() - sectionStart);
+    totalPages += section.pageCount;
+  }
+  Serial.printf("[NATIVE] %s: %lu pages total in %lums\n", path, static_cast<unsigned long>(totalPages),
+                millis() - bookStart);
+  return true;
+}
+}  // namespace
+
+int main(const int argc, const char** argv) {
+  if (argc < 3) {
+    Serial.printf("usage: %s <sd-root> <epub-path>...\n", argv[0]);
+    Serial.printf("  sd-root    host directory standing in for the SD card root\n");
+    Serial.printf("  epub-path  SD-absolute path beneath sd-root, e.g. /books/alice.epub\n");
+    return 2;
+  }
+
+  SdMan.setRootPath(argv[1]);
+  SdMan.mkdir(CACHE_DIR);
+  renderer.insertFont(BOOKERLY_14_FONT_ID, bookerly14FontFamily);
+
+  int failures = 0;
+  for (int i = 2; i < argc; i++) {
+    if (!paginateBook(argv[i])) {
+      failures++;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
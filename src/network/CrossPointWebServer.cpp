@@ -1,14 +1,26 @@
 #include "CrossPointWebServer.h"
 
 #include <ArduinoJson.h>
+#include <CrashLog.h>
+#include <ESPmDNS.h>
 #include <Epub.h>
+#include <FileHandleCache.h>
 #include <FsHelpers.h>
+#include <HeapMonitor.h>
 #include <SDCardManager.h>
+#include <Serialization.h>
 #include <WiFi.h>
+#include <Xtc.h>
+#include <ZipFile.h>
 #include <esp_task_wdt.h>
 
 #include <algorithm>
+#include <cstring>
 
+#include "AsyncTaskQueue.h"
+#include "LibraryIndex.h"
+#include "PowerGovernor.h"
+#include "SdIoScheduler.h"
 #include "html/FilesPageHtml.generated.h"
 #include "html/HomePageHtml.generated.h"
 #include "util/StringUtils.h"
@@ -18,12 +30,117 @@ namespace {
 // Note: Items starting with "." are automatically hidden
 const char* HIDDEN_ITEMS[] = {"System Volume Information", "XTCache"};
 constexpr size_t HIDDEN_ITEMS_COUNT = sizeof(HIDDEN_ITEMS) / sizeof(HIDDEN_ITEMS[0]);
-constexpr uint16_t UDP_PORTS[] = {54982, 48123, 39001, 44044, 59678};
-constexpr uint16_t LOCAL_UDP_PORT = 8134;
+// Advertised over mDNS/DNS-SD so the device shows up as crosspoint.local in any browser
+constexpr const char* MDNS_HOSTNAME = "crosspoint";
 
 // Static pointer for WebSocket callback (WebSocketsServer requires C-style callback)
 CrossPointWebServer* wsInstance = nullptr;
 
+// Upload deduplication manifest: one entry per file the uploader has written, keyed by the
+// FNV-1a hash of the full path. The client sends its content hash in the START handshake and
+// matching files are skipped without transferring a byte, so re-syncing a library only moves
+// files that actually changed.
+struct UploadManifestEntry {
+  uint64_t pathHash;
+  uint64_t contentHash;
+  uint64_t size;
+};
+constexpr char MANIFEST_FILE[] = "/.crosspoint/uploads.bin";
+constexpr uint32_t MANIFEST_MAGIC = 0x55504D46;  // 'UPMF'
+constexpr uint8_t MANIFEST_VERSION = 1;
+constexpr size_t MANIFEST_MAX_ENTRIES = 512;
+std::vector<UploadManifestEntry> manifestEntries;
+bool manifestLoaded = false;
+
+void loadUploadManifest() {
+  if (manifestLoaded) {
+    return;
+  }
+  manifestLoaded = true;
+  FsFile file;
+  if (!SdMan.openFileForRead("WEB", MANIFEST_FILE, file)) {
+    return;
+  }
+  uint32_t magic = 0;
+  uint8_t version = 0;
+  uint32_t count = 0;
+  serialization::readPod(file, magic);
+  serialization::readPod(file, version);
+  serialization::readPod(file, count);
+  if (magic != MANIFEST_MAGIC || version != MANIFEST_VERSION || count > MANIFEST_MAX_ENTRIES) {
+    Serial.printf("[%lu] [WEB] Upload manifest invalid, starting fresh\n", millis());
+    file.close();
+    return;
+  }
+  manifestEntries.resize(count);
+  const size_t wanted = count * sizeof(UploadManifestEntry);
+  if (file.read(manifestEntries.data(), wanted) != static_cast<int>(wanted)) {
+    manifestEntries.clear();
+  }
+  file.close();
+  Serial.printf("[%lu] [WEB] Upload manifest loaded (%zu entries)\n", millis(), manifestEntries.size());
+}
+
+void saveUploadManifest() {
+  SdMan.mkdir("/.crosspoint");
+  FsFile file;
+  if (!SdMan.openFileForWrite("WEB", MANIFEST_FILE, file)) {
+    return;
+  }
+  serialization::writePod(file, MANIFEST_MAGIC);
+  serialization::writePod(file, MANIFEST_VERSION);
+  serialization::writePod(file, static_cast<uint32_t>(manifestEntries.size()));
+  file.write(manifestEntries.data(), manifestEntries.size() * sizeof(UploadManifestEntry));
+  file.close();
+}
+
+UploadManifestEntry* findManifestEntry(const String& path) {
+  loadUploadManifest();
+  const uint64_t pathHash = ZipFile::fnvHash64(path.c_str(), path.length());
+  for (auto& entry : manifestEntries) {
+    if (entry.pathHash == pathHash) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void recordManifestEntry(const String& path, const uint64_t size, const uint64_t contentHash) {
+  if (auto* existing = findManifestEntry(path)) {
+    existing->size = size;
+    existing->contentHash = contentHash;
+  } else {
+    if (manifestEntries.size() >= MANIFEST_MAX_ENTRIES) {
+      manifestEntries.erase(manifestEntries.begin());  // drop the oldest record
+    }
+    manifestEntries.push_back({ZipFile::fnvHash64(path.c_str(), path.length()), contentHash, size});
+  }
+  saveUploadManifest();
+}
+
+// Drop a stale record when a file is deleted or rewritten outside the hashed handshake
+void forgetManifestEntry(const String& path) {
+  loadUploadManifest();
+  const uint64_t pathHash = ZipFile::fnvHash64(path.c_str(), path.length());
+  for (auto it = manifestEntries.begin(); it != manifestEntries.end(); ++it) {
+    if (it->pathHash == pathHash) {
+      manifestEntries.erase(it);
+      saveUploadManifest();
+      return;
+    }
+  }
+}
+
+// Negotiated large-frame uploads: 4KB client frames spend more CPU on per-frame
+// WebSocket processing (mask, copy, callback) than on moving bytes - on the bench
+// AP the old framing cost roughly half the achievable throughput. A client that
+// advertises its max frame size in the START handshake gets large binary frames
+// back, each prefixed with a little-endian sequence number, and an ACK per frame
+// so it can keep a fixed window in flight instead of guessing at backpressure.
+constexpr size_t WS_MAX_FRAME_SIZE = 32 * 1024;  // bounded by the upload ring
+constexpr size_t WS_ACK_WINDOW_FRAMES = 4;       // unacked frames the client may keep in flight
+constexpr size_t WS_FRAME_SEQ_HEADER = 4;        // little-endian uint32 sequence prefix
+
 // WebSocket upload state
 FsFile wsUploadFile;
 String wsUploadFileName;
@@ -32,24 +149,174 @@ size_t wsUploadSize = 0;
 size_t wsUploadReceived = 0;
 unsigned long wsUploadStartTime = 0;
 bool wsUploadInProgress = false;
+uint64_t wsUploadContentHash = 0;
+bool wsUploadHashValid = false;  // client sent a hash in the START handshake
+bool wsUploadFramed = false;     // client negotiated sequence-prefixed large frames
+size_t wsUploadFrameSize = 0;    // negotiated frame payload size
+uint32_t wsUploadNextSeq = 0;    // next expected sequence number
 String wsLastCompleteName;
 size_t wsLastCompleteSize = 0;
 unsigned long wsLastCompleteAt = 0;
 
-// Helper function to clear epub cache after upload
+// Upload ring buffer: WebSocket frames land here at network speed and the
+// flush task drains them to SdFat in aligned chunks, so the WebSocket loop
+// is never stalled waiting on SD write latency. Single producer (WebSocket
+// event handler) / single consumer (flush task), so the indices need no lock.
+constexpr size_t WS_UPLOAD_RING_SIZE = 32 * 1024;
+constexpr size_t WS_FLUSH_CHUNK_SIZE = 4096;  // multiple of the SD sector size
+uint8_t* wsUploadRing = nullptr;
+volatile size_t wsRingHead = 0;  // write index (event handler)
+volatile size_t wsRingTail = 0;  // read index (flush task)
+volatile size_t wsFlushedBytes = 0;
+volatile bool wsFlushFinal = false;  // all bytes received; drain remainder and close
+volatile bool wsFlushAbort = false;  // client vanished; drop data and delete the partial file
+volatile bool wsFlushError = false;  // SD write failed
+volatile bool wsFlushIdle = true;    // flush task is done with the current file
+TaskHandle_t wsFlushTaskHandle = nullptr;
+
+size_t wsRingPending() { return (wsRingHead + WS_UPLOAD_RING_SIZE - wsRingTail) % WS_UPLOAD_RING_SIZE; }
+size_t wsRingSpace() { return WS_UPLOAD_RING_SIZE - 1 - wsRingPending(); }
+
+// POD status snapshot posted through the mailbox queue (a FreeRTOS queue copies items
+// bitwise, so no std::string/String members here)
+struct WsStatusSnapshot {
+  bool inProgress;
+  size_t received;
+  size_t flushed;
+  size_t total;
+  char filename[96];
+  char lastCompleteName[96];
+  size_t lastCompleteSize;
+  unsigned long lastCompleteAt;
+};
+
+String wsUploadFilePath() {
+  String filePath = wsUploadPath;
+  if (!filePath.endsWith("/")) filePath += "/";
+  filePath += wsUploadFileName;
+  return filePath;
+}
+
+[[noreturn]] void wsFlushTaskLoop(void*) {
+  while (true) {
+    if (wsFlushAbort) {
+      if (wsUploadFile) {
+        wsUploadFile.close();
+        const String filePath = wsUploadFilePath();
+        SdMan.remove(filePath.c_str());
+        Serial.printf("[%lu] [WS] Deleted incomplete upload: %s\n", millis(), filePath.c_str());
+      }
+      wsRingTail = wsRingHead;
+      wsFlushAbort = false;
+      wsFlushIdle = true;
+      continue;
+    }
+
+    const size_t pending = wsRingPending();
+    if (pending == 0) {
+      if (wsFlushFinal && !wsFlushIdle) {
+        wsUploadFile.close();
+        wsFlushIdle = true;
+      }
+      vTaskDelay(1);
+      continue;
+    }
+
+    // No open file (e.g. after a write error) - discard whatever trickles in
+    if (wsFlushIdle) {
+      wsRingTail = wsRingHead;
+      vTaskDelay(1);
+      continue;
+    }
+
+    // Wait for a full chunk unless this is the tail end of the file
+    if (pending < WS_FLUSH_CHUNK_SIZE && !wsFlushFinal) {
+      vTaskDelay(1);
+      continue;
+    }
+
+    // Write one contiguous span, capped at the chunk size. Give way between chunks if a render
+    // is in flight - the ring absorbs incoming frames while we wait
+    SD_SCHED.yieldToUi();
+    const size_t tail = wsRingTail;
+    size_t toWrite = pending < WS_UPLOAD_RING_SIZE - tail ? pending : WS_UPLOAD_RING_SIZE - tail;
+    if (toWrite > WS_FLUSH_CHUNK_SIZE) toWrite = WS_FLUSH_CHUNK_SIZE;
+
+    const SdIoScheduler::Scope sdScope(SdIoScheduler::IoClass::BACKGROUND);
+    const size_t written = wsUploadFile.write(wsUploadRing + tail, toWrite);
+    if (written != toWrite) {
+      Serial.printf("[%lu] [WS] Flush write failed (%zu of %zu bytes)\n", millis(), written, toWrite);
+      wsUploadFile.close();
+      wsRingTail = wsRingHead;
+      wsFlushError = true;
+      wsFlushIdle = true;
+      continue;
+    }
+
+    wsRingTail = (tail + written) % WS_UPLOAD_RING_SIZE;
+    wsFlushedBytes += written;
+  }
+}
+
+// Helper function to clear book caches after upload, so an overwritten file can't keep
+// serving stale metadata or cover assets
 void clearEpubCacheIfNeeded(const String& filePath) {
-  // Only clear cache for .epub files
   if (StringUtils::checkFileExtension(filePath, ".epub")) {
     Epub(filePath.c_str(), "/.crosspoint").clearCache();
     Serial.printf("[%lu] [WEB] Cleared epub cache for: %s\n", millis(), filePath.c_str());
+  } else if (StringUtils::checkFileExtension(filePath, ".xtch") || StringUtils::checkFileExtension(filePath, ".xtc")) {
+    Xtc(filePath.c_str(), "/.crosspoint").clearCache();
+    Serial.printf("[%lu] [WEB] Cleared xtc cache for: %s\n", millis(), filePath.c_str());
   }
 }
+
+// Build a freshly uploaded book's caches in the background while the device sits on the
+// server screen, so its first open pays none of the metadata/cover build cost. Section
+// files are left to the reader: they depend on the active font and margins.
+void warmEpubCacheIfNeeded(const String& filePath) {
+  const bool isEpub = StringUtils::checkFileExtension(filePath, ".epub");
+  const bool isXtc =
+      StringUtils::checkFileExtension(filePath, ".xtch") || StringUtils::checkFileExtension(filePath, ".xtc");
+  if (!isEpub && !isXtc) {
+    return;
+  }
+  TASK_QUEUE.enqueue(
+      "CacheWarm",
+      [path = std::string(filePath.c_str()), isEpub](const AsyncTaskQueue::Job& job) {
+        Serial.printf("[%lu] [WEB] Warming caches for: %s\n", millis(), path.c_str());
+        if (isEpub) {
+          Epub epub(path, "/.crosspoint");
+          if (!epub.load(true)) {
+            Serial.printf("[%lu] [WEB] Cache warm aborted, load failed: %s\n", millis(), path.c_str());
+            return;
+          }
+          if (job.isCancelled()) {
+            return;
+          }
+          const PowerGovernor::Lease powerLease;  // The shared cover/thumb JPEG decode is CPU-bound
+          epub.generateCoverAssets();
+        } else {
+          Xtc xtc(path, "/.crosspoint");
+          if (!xtc.load()) {
+            Serial.printf("[%lu] [WEB] Cache warm aborted, load failed: %s\n", millis(), path.c_str());
+            return;
+          }
+          if (job.isCancelled()) {
+            return;
+          }
+          const PowerGovernor::Lease powerLease;  // The thumb's scaled page decode is CPU-bound
+          xtc.generateCoverBmp();
+          xtc.generateThumbBmp();
+        }
+        Serial.printf("[%lu] [WEB] Caches warm for: %s\n", millis(), path.c_str());
+      },
+      AsyncTaskQueue::Priority::LOW);
+}
 }  // namespace
 
-// File listing page template - now using generated headers:
-// - HomePageHtml (from html/HomePage.html)
-// - FilesPageHeaderHtml (from html/FilesPageHeader.html)
-// - FilesPageFooterHtml (from html/FilesPageFooter.html)
+// Page templates come from generated headers (gzipped at build time by scripts/build_html.py):
+// - HomePageHtmlGz (from html/HomePage.html)
+// - FilesPageHtmlGz (from html/FilesPage.html)
 CrossPointWebServer::CrossPointWebServer() {}
 
 CrossPointWebServer::~CrossPointWebServer() { stop(); }
@@ -100,6 +367,9 @@ void CrossPointWebServer::begin() {
   server->on("/files", HTTP_GET, [this] { handleFileList(); });
 
   server->on("/api/status", HTTP_GET, [this] { handleStatus(); });
+  server->on("/api/heap", HTTP_GET, [this] { handleHeapDebug(); });
+  server->on("/api/crash", HTTP_GET, [this] { handleCrashDebug(); });
+  server->on("/api/sdbench", HTTP_GET, [this] { handleSdBench(); });
   server->on("/api/files", HTTP_GET, [this] { handleFileListData(); });
   server->on("/download", HTTP_GET, [this] { handleDownload(); });
 
@@ -113,6 +383,11 @@ void CrossPointWebServer::begin() {
   server->on("/delete", HTTP_POST, [this] { handleDelete(); });
 
   server->onNotFound([this] { handleNotFound(); });
+
+  // WebServer only retains headers it's told to collect; Range drives resumable
+  // downloads, If-None-Match the 304 path for the embedded assets
+  const char* collectedHeaders[] = {"Range", "If-None-Match"};
+  server->collectHeaders(collectedHeaders, 2);
   Serial.printf("[%lu] [WEB] [MEM] Free heap after route setup: %d bytes\n", millis(), ESP.getFreeHeap());
 
   server->begin();
@@ -125,12 +400,58 @@ void CrossPointWebServer::begin() {
   wsServer->onEvent(wsEventCallback);
   Serial.printf("[%lu] [WEB] WebSocket server started\n", millis());
 
-  udpActive = udp.begin(LOCAL_UDP_PORT);
-  Serial.printf("[%lu] [WEB] Discovery UDP %s on port %d\n", millis(), udpActive ? "enabled" : "failed",
-                LOCAL_UDP_PORT);
+  // Allocate the upload ring and start the flush task; without the ring we
+  // fall back to writing each frame to SD inline (the pre-ring behaviour)
+  wsUploadRing = static_cast<uint8_t*>(malloc(WS_UPLOAD_RING_SIZE));
+  if (wsUploadRing) {
+    wsRingHead = 0;
+    wsRingTail = 0;
+    wsFlushFinal = false;
+    wsFlushAbort = false;
+    wsFlushError = false;
+    wsFlushIdle = true;
+    xTaskCreate(wsFlushTaskLoop, "WsFlushTask",
+                4096,               // Stack size
+                nullptr,            // Parameters
+                1,                  // Priority
+                &wsFlushTaskHandle  // Task handle
+    );
+    Serial.printf("[%lu] [WEB] Upload flush task started (%zu byte ring)\n", millis(), WS_UPLOAD_RING_SIZE);
+  } else {
+    Serial.printf("[%lu] [WEB] Failed to allocate upload ring, falling back to inline SD writes\n", millis());
+  }
+
+  // Advertise over mDNS/DNS-SD instead of the old UDP beacon: no periodic radio wakeups,
+  // and any browser or the Calibre plugin can resolve crosspoint.local directly
+  if (MDNS.begin(MDNS_HOSTNAME)) {
+    MDNS.addService("http", "tcp", port);
+    MDNS.addService("crosspoint", "tcp", wsPort);
+    Serial.printf("[%lu] [WEB] mDNS advertising http://%s.local/\n", millis(), MDNS_HOSTNAME);
+  } else {
+    Serial.printf("[%lu] [WEB] WARNING: mDNS failed to start, use the IP address directly\n", millis());
+  }
 
   running = true;
 
+  // Client handling runs on its own task so transfers and the activity loop never gate each
+  // other; the mailbox queue carries status snapshots back to the UI
+  statusQueue = xQueueCreate(1, sizeof(WsStatusSnapshot));
+  if (!statusQueue) {
+    Serial.printf("[%lu] [WEB] Failed to allocate status queue, UI will read shared state\n", millis());
+  }
+  serverTaskExit = false;
+  serverTaskDone = false;
+  if (xTaskCreate(serverTaskLoop, "WebServerTask",
+                  8192,              // Stack size - request handlers do SD and String work
+                  this,              // Parameters
+                  1,                 // Priority
+                  &serverTaskHandle  // Task handle
+                  ) != pdPASS) {
+    Serial.printf("[%lu] [WEB] !! Failed to create server task\n", millis());
+    serverTaskHandle = nullptr;
+    serverTaskDone = true;
+  }
+
   Serial.printf("[%lu] [WEB] Web server started on port %d\n", millis(), port);
   // Show the correct IP based on network mode
   const String ipAddr = apMode ? WiFi.softAPIP().toString() : WiFi.localIP().toString();
@@ -149,14 +470,47 @@ void CrossPointWebServer::stop() {
   Serial.printf("[%lu] [WEB] STOP INITIATED - setting running=false first\n", millis());
   running = false;  // Set this FIRST to prevent handleClient from using server
 
+  // Wind down the server task before touching the server objects it pumps
+  if (serverTaskHandle) {
+    serverTaskExit = true;
+    while (!serverTaskDone) {
+      delay(1);
+    }
+    serverTaskHandle = nullptr;
+  }
+  if (statusQueue) {
+    vQueueDelete(statusQueue);
+    statusQueue = nullptr;
+  }
+
   Serial.printf("[%lu] [WEB] [MEM] Free heap before stop: %d bytes\n", millis(), ESP.getFreeHeap());
 
   // Close any in-progress WebSocket upload
-  if (wsUploadInProgress && wsUploadFile) {
-    wsUploadFile.close();
+  if (wsUploadInProgress) {
+    if (wsFlushTaskHandle) {
+      wsFlushAbort = true;
+      while (!wsFlushIdle) {
+        delay(1);
+      }
+    } else if (wsUploadFile) {
+      wsUploadFile.close();
+    }
     wsUploadInProgress = false;
   }
 
+  // Stop the flush task (it parks on vTaskDelay once the ring is drained)
+  if (wsFlushTaskHandle) {
+    while (!wsFlushIdle || wsRingPending() > 0) {
+      delay(1);
+    }
+    vTaskDelete(wsFlushTaskHandle);
+    wsFlushTaskHandle = nullptr;
+  }
+  if (wsUploadRing) {
+    free(wsUploadRing);
+    wsUploadRing = nullptr;
+  }
+
   // Stop WebSocket server
   if (wsServer) {
     Serial.printf("[%lu] [WEB] Stopping WebSocket server...\n", millis());
@@ -166,10 +520,7 @@ void CrossPointWebServer::stop() {
     Serial.printf("[%lu] [WEB] WebSocket server stopped\n", millis());
   }
 
-  if (udpActive) {
-    udp.stop();
-    udpActive = false;
-  }
+  MDNS.end();
 
   // Brief delay to allow any in-flight handleClient() calls to complete
   delay(20);
@@ -189,6 +540,41 @@ void CrossPointWebServer::stop() {
   Serial.printf("[%lu] [WEB] [MEM] Free heap final: %d bytes\n", millis(), ESP.getFreeHeap());
 }
 
+void CrossPointWebServer::serverTaskLoop(void* param) {
+  auto* self = static_cast<CrossPointWebServer*>(param);
+  unsigned long lastStatusPost = 0;
+  while (!self->serverTaskExit) {
+    // Burst like the old activity-loop pump did during uploads: several handleClient calls
+    // per wake keep multipart streams moving, the delay tick keeps the scheduler fair
+    for (int i = 0; i < 64 && !self->serverTaskExit; i++) {
+      self->handleClient();
+    }
+    if (millis() - lastStatusPost >= 50) {
+      self->postStatusSnapshot();
+      lastStatusPost = millis();
+    }
+    vTaskDelay(1);
+  }
+  self->serverTaskDone = true;
+  vTaskDelete(nullptr);
+}
+
+void CrossPointWebServer::postStatusSnapshot() const {
+  if (!statusQueue) {
+    return;
+  }
+  WsStatusSnapshot snap = {};
+  snap.inProgress = wsUploadInProgress;
+  snap.received = wsUploadReceived;
+  snap.flushed = wsFlushedBytes;
+  snap.total = wsUploadSize;
+  strlcpy(snap.filename, wsUploadFileName.c_str(), sizeof(snap.filename));
+  strlcpy(snap.lastCompleteName, wsLastCompleteName.c_str(), sizeof(snap.lastCompleteName));
+  snap.lastCompleteSize = wsLastCompleteSize;
+  snap.lastCompleteAt = wsLastCompleteAt;
+  xQueueOverwrite(statusQueue, &snap);
+}
+
 void CrossPointWebServer::handleClient() {
   static unsigned long lastDebugPrint = 0;
 
@@ -216,33 +602,26 @@ void CrossPointWebServer::handleClient() {
     wsServer->loop();
   }
 
-  // Respond to discovery broadcasts
-  if (udpActive) {
-    int packetSize = udp.parsePacket();
-    if (packetSize > 0) {
-      char buffer[16];
-      int len = udp.read(buffer, sizeof(buffer) - 1);
-      if (len > 0) {
-        buffer[len] = '\0';
-        if (strcmp(buffer, "hello") == 0) {
-          String hostname = WiFi.getHostname();
-          if (hostname.isEmpty()) {
-            hostname = "crosspoint";
-          }
-          String message = "crosspoint (on " + hostname + ");" + String(wsPort);
-          udp.beginPacket(udp.remoteIP(), udp.remotePort());
-          udp.write(reinterpret_cast<const uint8_t*>(message.c_str()), message.length());
-          udp.endPacket();
-        }
-      }
-    }
-  }
 }
 
 CrossPointWebServer::WsUploadStatus CrossPointWebServer::getWsUploadStatus() const {
   WsUploadStatus status;
+  WsStatusSnapshot snap;
+  if (statusQueue && xQueuePeek(statusQueue, &snap, 0) == pdTRUE) {
+    status.inProgress = snap.inProgress;
+    status.received = snap.received;
+    status.flushed = snap.flushed;
+    status.total = snap.total;
+    status.filename = snap.filename;
+    status.lastCompleteName = snap.lastCompleteName;
+    status.lastCompleteSize = snap.lastCompleteSize;
+    status.lastCompleteAt = snap.lastCompleteAt;
+    return status;
+  }
+  // No queue (allocation failed) or nothing posted yet: read the shared state directly
   status.inProgress = wsUploadInProgress;
   status.received = wsUploadReceived;
+  status.flushed = wsFlushedBytes;
   status.total = wsUploadSize;
   status.filename = wsUploadFileName.c_str();
   status.lastCompleteName = wsLastCompleteName.c_str();
@@ -251,8 +630,28 @@ CrossPointWebServer::WsUploadStatus CrossPointWebServer::getWsUploadStatus() con
   return status;
 }
 
+// Conditional requests for the embedded assets: the build hash from
+// scripts/build_html.py is the ETag. Answers 304 and returns true when the
+// client's copy matches, otherwise stamps the validator headers for the full
+// send - repeat visits from the same browser transfer zero asset bytes.
+bool CrossPointWebServer::sendAssetNotModified(const char* etag) const {
+  if (server->header("If-None-Match") == etag) {
+    server->send(304, "text/html", "");
+    return true;
+  }
+  server->sendHeader("ETag", etag);
+  // Revalidate every visit rather than a TTL: the assets only change with firmware
+  server->sendHeader("Cache-Control", "no-cache");
+  return false;
+}
+
 void CrossPointWebServer::handleRoot() const {
-  server->send(200, "text/html", HomePageHtml);
+  if (sendAssetNotModified(HomePageHtmlEtag)) {
+    return;
+  }
+  // Pre-gzipped at build time; send_P streams it from flash in socket-sized writes
+  server->sendHeader("Content-Encoding", "gzip");
+  server->send_P(200, "text/html", reinterpret_cast<const char*>(HomePageHtmlGz), HomePageHtmlGzLen);
   Serial.printf("[%lu] [WEB] Served root page\n", millis());
 }
 
@@ -279,7 +678,93 @@ void CrossPointWebServer::handleStatus() const {
   server->send(200, "application/json", json);
 }
 
-void CrossPointWebServer::scanFiles(const char* path, const std::function<void(FileInfo)>& callback) const {
+// Heap fragmentation debug data: current numbers, the sampled free-vs-largest-block history
+// from the main loop, and per-site allocation counters from HeapMonitor::recordAlloc
+void CrossPointWebServer::handleHeapDebug() const {
+  JsonDocument doc;
+  doc["freeHeap"] = ESP.getFreeHeap();
+  doc["minFreeHeap"] = ESP.getMinFreeHeap();
+  doc["largestFreeBlock"] = ESP.getMaxAllocHeap();
+  doc["heapSize"] = ESP.getHeapSize();
+
+  const JsonArray sites = doc["sites"].to<JsonArray>();
+  HEAP_MON.forEachSite([&sites](const HeapMonitor::Site& site) {
+    JsonObject obj = sites.add<JsonObject>();
+    obj["name"] = site.name;
+    obj["count"] = site.count;
+    obj["failures"] = site.failures;
+    obj["totalBytes"] = site.totalBytes;
+    obj["largestBytes"] = site.largestBytes;
+    obj["lastFailBytes"] = site.lastFailBytes;
+  });
+
+  const JsonArray samples = doc["samples"].to<JsonArray>();
+  HEAP_MON.forEachSample([&samples](const HeapMonitor::Sample& sample) {
+    JsonObject obj = samples.add<JsonObject>();
+    obj["uptime"] = sample.uptimeSeconds;
+    obj["free"] = sample.freeHeap;
+    obj["largestBlock"] = sample.largestFreeBlock;
+    obj["minFree"] = sample.minFreeHeap;
+  });
+
+  String json;
+  serializeJson(doc, json);
+  server->send(200, "application/json", json);
+}
+
+// Flight recorder from the previous run, present only when that run ended in a panic, watchdog
+// bite or brownout. The raw log accumulates across crashes at /crash.log (fetchable through
+// /download); this endpoint serves the most recent report
+void CrossPointWebServer::handleCrashDebug() const {
+  JsonDocument doc;
+  const CrashLog::Report& report = CRASH_LOG.lastReport();
+  doc["crashed"] = report.valid;
+  if (report.valid) {
+    doc["reason"] = CrashLog::resetReasonName(report.resetReason);
+    doc["bootCount"] = report.bootCount;
+    doc["uptimeMs"] = report.uptimeMs;
+    doc["heapLowWater"] = report.freeHeapLowWater;
+    doc["task"] = report.task;
+    doc["checkpoint"] = report.checkpoint;
+    doc["persisted"] = report.persisted;
+
+    const JsonArray events = doc["events"].to<JsonArray>();
+    for (size_t i = 0; i < CrashLog::EVENT_COUNT; i++) {
+      if (report.eventIds[i] == 0) {
+        continue;
+      }
+      JsonObject obj = events.add<JsonObject>();
+      char id[12];
+      snprintf(id, sizeof(id), "0x%08lx", static_cast<unsigned long>(report.eventIds[i]));
+      obj["id"] = id;
+      if (report.namesResolvable) {
+        obj["name"] = reinterpret_cast<const char*>(report.eventIds[i]);
+      }
+    }
+  }
+
+  String json;
+  serializeJson(doc, json);
+  server->send(200, "application/json", json);
+}
+
+// Last SD card benchmark run, as written by the SD Card Check screen; 404 until the user has
+// run one
+void CrossPointWebServer::handleSdBench() const {
+  FsFile file;
+  if (!SdMan.openFileForRead("WEB", "/.crosspoint/sdbench.txt", file)) {
+    server->send(404, "text/plain", "No benchmark results; run Settings > System > SD Card Check");
+    return;
+  }
+  String body;
+  while (file.available()) {
+    body += static_cast<char>(file.read());
+  }
+  file.close();
+  server->send(200, "text/plain", body);
+}
+
+void CrossPointWebServer::scanFiles(const char* path, const std::function<bool(const FileInfo&)>& callback) const {
   FsFile root = SdMan.open(path);
   if (!root) {
     Serial.printf("[%lu] [WEB] Failed to open directory: %s\n", millis(), path);
@@ -326,7 +811,10 @@ void CrossPointWebServer::scanFiles(const char* path, const std::function<void(F
         info.isEpub = isEpubFile(info.name);
       }
 
-      callback(info);
+      if (!callback(info)) {
+        file.close();
+        break;
+      }
     }
 
     file.close();
@@ -343,7 +831,13 @@ bool CrossPointWebServer::isEpubFile(const String& filename) const {
   return lower.endsWith(".epub");
 }
 
-void CrossPointWebServer::handleFileList() const { server->send(200, "text/html", FilesPageHtml); }
+void CrossPointWebServer::handleFileList() const {
+  if (sendAssetNotModified(FilesPageHtmlEtag)) {
+    return;
+  }
+  server->sendHeader("Content-Encoding", "gzip");
+  server->send_P(200, "text/html", reinterpret_cast<const char*>(FilesPageHtmlGz), FilesPageHtmlGzLen);
+}
 
 void CrossPointWebServer::handleFileListData() const {
   // Get current path from query string (default to root)
@@ -360,15 +854,59 @@ void CrossPointWebServer::handleFileListData() const {
     }
   }
 
+  // Optional cursor: with a limit the response is {"files":[...],"nextOffset":N,"hasMore":B} and the
+  // scan stops after one page, so response time stays bounded on huge directories. Without a limit
+  // the legacy full array is streamed.
+  const uint32_t offset = server->hasArg("offset") ? server->arg("offset").toInt() : 0;
+  const uint32_t limit = server->hasArg("limit") ? server->arg("limit").toInt() : 0;
+  const bool paged = limit > 0;
+
   server->setContentLength(CONTENT_LENGTH_UNKNOWN);
   server->send(200, "application/json", "");
-  server->sendContent("[");
+
+  // Accumulate entries into a 4KB window and send whole chunks. Each sendContent() call emits
+  // its own HTTP chunk (one small TCP write), so per-entry sends made listings of thousands of
+  // files crawl; batched, a chunk carries ~40 entries. Falls back to per-entry sends when the
+  // window cannot be allocated.
+  constexpr size_t CHUNK_SIZE = 4096;
+  char* chunk = static_cast<char*>(malloc(CHUNK_SIZE));
+  size_t chunkLen = 0;
+  const auto flushChunk = [&] {
+    if (chunk && chunkLen > 0) {
+      server->sendContent(chunk, chunkLen);
+      chunkLen = 0;
+    }
+  };
+  const auto sendPiece = [&](const char* data, const size_t len) {
+    if (!chunk) {
+      server->sendContent(data, len);
+      return;
+    }
+    if (chunkLen + len > CHUNK_SIZE) {
+      flushChunk();
+    }
+    memcpy(chunk + chunkLen, data, len);
+    chunkLen += len;
+  };
+
+  const char* head = paged ? "{\"files\":[" : "[";
+  sendPiece(head, strlen(head));
   char output[512];
   constexpr size_t outputSize = sizeof(output);
   bool seenFirst = false;
+  uint32_t index = 0;
+  bool hasMore = false;
   JsonDocument doc;
 
-  scanFiles(currentPath.c_str(), [this, &output, &doc, seenFirst](const FileInfo& info) mutable {
+  scanFiles(currentPath.c_str(), [&](const FileInfo& info) {
+    if (paged && index >= offset + limit) {
+      hasMore = true;
+      return false;
+    }
+    if (index++ < offset) {
+      return true;
+    }
+
     doc.clear();
     doc["name"] = info.name;
     doc["size"] = info.size;
@@ -379,22 +917,71 @@ void CrossPointWebServer::handleFileListData() const {
     if (written >= outputSize) {
       // JSON output truncated; skip this entry to avoid sending malformed JSON
       Serial.printf("[%lu] [WEB] Skipping file entry with oversized JSON for name: %s\n", millis(), info.name.c_str());
-      return;
+      return true;
     }
 
     if (seenFirst) {
-      server->sendContent(",");
+      sendPiece(",", 1);
     } else {
       seenFirst = true;
     }
-    server->sendContent(output);
+    sendPiece(output, written);
+    return true;
   });
-  server->sendContent("]");
+
+  if (paged) {
+    const int trailerLen = snprintf(output, outputSize, "],\"nextOffset\":%lu,\"hasMore\":%s}",
+                                    static_cast<unsigned long>(index), hasMore ? "true" : "false");
+    sendPiece(output, trailerLen);
+  } else {
+    sendPiece("]", 1);
+  }
+  flushChunk();
+  free(chunk);
   // End of streamed response, empty chunk to signal client
   server->sendContent("");
   Serial.printf("[%lu] [WEB] Served file listing page for path: %s\n", millis(), currentPath.c_str());
 }
 
+// Parses a single-range "bytes=start-end" header into [start, end] within fileSize.
+// Multi-range and malformed specs return false; the caller then ignores the header and
+// serves a full 200, which RFC 7233 permits.
+static bool parseByteRange(const String& header, const size_t fileSize, size_t& start, size_t& end) {
+  if (!header.startsWith("bytes=") || fileSize == 0) {
+    return false;
+  }
+  const String spec = header.substring(6);
+  if (spec.indexOf(',') >= 0) {
+    return false;  // multipart/byteranges not supported
+  }
+  const int dash = spec.indexOf('-');
+  if (dash < 0) {
+    return false;
+  }
+  const String startStr = spec.substring(0, dash);
+  const String endStr = spec.substring(dash + 1);
+  if (startStr.isEmpty()) {
+    // Suffix form: the last N bytes
+    const long suffix = endStr.toInt();
+    if (suffix <= 0) {
+      return false;
+    }
+    start = static_cast<size_t>(suffix) >= fileSize ? 0 : fileSize - suffix;
+    end = fileSize - 1;
+    return true;
+  }
+  const long s = startStr.toInt();
+  if (s < 0 || static_cast<size_t>(s) >= fileSize) {
+    return false;
+  }
+  start = s;
+  end = endStr.isEmpty() ? fileSize - 1 : static_cast<size_t>(endStr.toInt());
+  if (end >= fileSize) {
+    end = fileSize - 1;
+  }
+  return end >= start;
+}
+
 void CrossPointWebServer::handleDownload() const {
   if (!server->hasArg("path")) {
     server->send(400, "text/plain", "Missing path");
@@ -449,13 +1036,66 @@ void CrossPointWebServer::handleDownload() const {
     filename = nameBuf;
   }
 
-  server->setContentLength(file.size());
+  const size_t fileSize = file.size();
+  size_t rangeStart = 0;
+  size_t rangeEnd = fileSize > 0 ? fileSize - 1 : 0;
+  bool isRange = false;
+  if (server->hasHeader("Range")) {
+    isRange = parseByteRange(server->header("Range"), fileSize, rangeStart, rangeEnd);
+  }
+
+  const size_t sendLength = fileSize > 0 ? rangeEnd - rangeStart + 1 : 0;
+  server->setContentLength(sendLength);
   server->sendHeader("Content-Disposition", "attachment; filename=\"" + filename + "\"");
-  server->send(200, contentType.c_str(), "");
+  server->sendHeader("Accept-Ranges", "bytes");
+  if (isRange) {
+    server->sendHeader("Content-Range",
+                       "bytes " + String(rangeStart) + "-" + String(rangeEnd) + "/" + String(fileSize));
+    server->send(206, contentType.c_str(), "");
+  } else {
+    server->send(200, contentType.c_str(), "");
+  }
 
+  if (isRange && !file.seek(rangeStart)) {
+    file.close();
+    return;
+  }
+
+  // Stream straight from SdFat to the socket in SD-sector-multiple chunks; no String
+  // staging, and each write hands lwIP several TCP segments at once
+  static uint8_t downloadChunk[4096];
   WiFiClient client = server->client();
-  client.write(file);
+  const unsigned long sendStart = millis();
+  size_t remaining = sendLength;
+  while (remaining > 0 && client.connected()) {
+    esp_task_wdt_reset();
+    const size_t toRead = remaining < sizeof(downloadChunk) ? remaining : sizeof(downloadChunk);
+    const int bytesRead = file.read(downloadChunk, toRead);
+    if (bytesRead <= 0) {
+      Serial.printf("[%lu] [WEB] Download read failed with %u bytes left\n", millis(), remaining);
+      break;
+    }
+    size_t offset = 0;
+    while (offset < static_cast<size_t>(bytesRead)) {
+      // write() blocks until lwIP accepts the data; 0 means the connection died
+      const size_t written = client.write(downloadChunk + offset, bytesRead - offset);
+      if (written == 0) {
+        break;
+      }
+      offset += written;
+    }
+    if (offset < static_cast<size_t>(bytesRead)) {
+      Serial.printf("[%lu] [WEB] Download client disconnected with %u bytes left\n", millis(), remaining);
+      break;
+    }
+    remaining -= bytesRead;
+  }
   file.close();
+
+  const unsigned long elapsed = millis() - sendStart;
+  const size_t sent = sendLength - remaining;
+  Serial.printf("[%lu] [WEB] Sent %u/%u bytes%s of %s in %lu ms (%u KB/s)\n", millis(), sent, sendLength,
+                isRange ? " (range)" : "", filename.c_str(), elapsed, elapsed > 0 ? sent / elapsed : 0);
 }
 
 // Static variables for upload handling
@@ -524,6 +1164,8 @@ void CrossPointWebServer::handleUpload() const {
     lastLoggedSize = 0;
     uploadBufferPos = 0;
     totalWriteTime = 0;
+    // Prime suspect for field watchdog resets: make sure a death mid-upload says so
+    CRASH_LOG.note("web-upload");
     writeCount = 0;
 
     // Get upload path from query parameter (defaults to root if not specified)
@@ -556,8 +1198,11 @@ void CrossPointWebServer::handleUpload() const {
     if (SdMan.exists(filePath.c_str())) {
       Serial.printf("[%lu] [WEB] [UPLOAD] Overwriting existing file: %s\n", millis(), filePath.c_str());
       esp_task_wdt_reset();
+      FILE_HANDLES.invalidate(filePath.c_str());  // A reader may hold the old file open
       SdMan.remove(filePath.c_str());
     }
+    // HTTP uploads bypass the hashed handshake, so any dedup record for this path is stale
+    forgetManifestEntry(filePath);
 
     // Open file for writing - this can be slow due to FAT cluster allocation
     esp_task_wdt_reset();
@@ -629,6 +1274,8 @@ void CrossPointWebServer::handleUpload() const {
         if (!filePath.endsWith("/")) filePath += "/";
         filePath += uploadFileName;
         clearEpubCacheIfNeeded(filePath);
+        LIBRARY_INDEX.addEntry(filePath.c_str());
+        warmEpubCacheIfNeeded(filePath);
       }
     }
   } else if (upload.status == UPLOAD_FILE_ABORTED) {
@@ -775,11 +1422,17 @@ void CrossPointWebServer::handleDelete() const {
     success = SdMan.rmdir(itemPath.c_str());
   } else {
     // For files, use remove
+    FILE_HANDLES.invalidate(itemPath.c_str());
     success = SdMan.remove(itemPath.c_str());
+    if (success) {
+      forgetManifestEntry(itemPath);
+    }
   }
 
   if (success) {
     Serial.printf("[%lu] [WEB] Successfully deleted: %s\n", millis(), itemPath.c_str());
+    // Removal isn't patched in place; the next library listing rescans the directory
+    LIBRARY_INDEX.invalidate();
     server->send(200, "text/plain", "Deleted successfully");
   } else {
     Serial.printf("[%lu] [WEB] Failed to delete: %s\n", millis(), itemPath.c_str());
@@ -796,23 +1449,36 @@ void CrossPointWebServer::wsEventCallback(uint8_t num, WStype_t type, uint8_t* p
 
 // WebSocket event handler for fast binary uploads
 // Protocol:
-//   1. Client sends TEXT message: "START:<filename>:<size>:<path>"
-//   2. Client sends BINARY messages with file data chunks
-//   3. Server sends TEXT "PROGRESS:<received>:<total>" after each chunk
-//   4. Server sends TEXT "DONE" or "ERROR:<message>" when complete
+//   1. Client sends TEXT message: "START:<filename>:<size>:<path>[:<fnv1a64-hex>[:<maxframe>]]"
+//   2. Server replies "SKIP" when the manifest already records that exact (path, size, hash).
+//      Otherwise "READY", or "READY:<framesize>:<window>" when the client advertised a max
+//      frame size - the negotiated framesize is min(client max, WS_MAX_FRAME_SIZE)
+//   3. Client sends BINARY messages with file data chunks. In negotiated mode each frame
+//      carries framesize bytes of data behind a 4-byte little-endian sequence number, and at
+//      most <window> frames may be unacknowledged at once
+//   4. Server sends TEXT "ACK:<seq>" per frame in negotiated mode, or
+//      "PROGRESS:<received>:<total>" every 64KB in legacy mode
+//   5. Server sends TEXT "DONE" or "ERROR:<message>" when complete
 void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
   switch (type) {
     case WStype_DISCONNECTED:
       Serial.printf("[%lu] [WS] Client %u disconnected\n", millis(), num);
       // Clean up any in-progress upload
-      if (wsUploadInProgress && wsUploadFile) {
-        wsUploadFile.close();
-        // Delete incomplete file
-        String filePath = wsUploadPath;
-        if (!filePath.endsWith("/")) filePath += "/";
-        filePath += wsUploadFileName;
-        SdMan.remove(filePath.c_str());
-        Serial.printf("[%lu] [WS] Deleted incomplete upload: %s\n", millis(), filePath.c_str());
+      if (wsUploadInProgress) {
+        if (wsFlushTaskHandle) {
+          // Let the flush task drop the ring contents and delete the partial file
+          wsFlushAbort = true;
+          while (!wsFlushIdle) {
+            esp_task_wdt_reset();
+            vTaskDelay(1);
+          }
+        } else if (wsUploadFile) {
+          wsUploadFile.close();
+          // Delete incomplete file
+          const String filePath = wsUploadFilePath();
+          SdMan.remove(filePath.c_str());
+          Serial.printf("[%lu] [WS] Deleted incomplete upload: %s\n", millis(), filePath.c_str());
+        }
       }
       wsUploadInProgress = false;
       break;
@@ -828,14 +1494,40 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
       Serial.printf("[%lu] [WS] Text from client %u: %s\n", millis(), num, msg.c_str());
 
       if (msg.startsWith("START:")) {
-        // Parse: START:<filename>:<size>:<path>
+        // Parse: START:<filename>:<size>:<path>[:<fnv1a64-hex>[:<maxframe>]]
         int firstColon = msg.indexOf(':', 6);
         int secondColon = msg.indexOf(':', firstColon + 1);
+        int thirdColon = msg.indexOf(':', secondColon + 1);
+        int fourthColon = thirdColon > 0 ? msg.indexOf(':', thirdColon + 1) : -1;
 
         if (firstColon > 0 && secondColon > 0) {
+          // Make sure the flush task is done with any previous file first
+          while (!wsFlushIdle) {
+            esp_task_wdt_reset();
+            vTaskDelay(1);
+          }
+
           wsUploadFileName = msg.substring(6, firstColon);
           wsUploadSize = msg.substring(firstColon + 1, secondColon).toInt();
-          wsUploadPath = msg.substring(secondColon + 1);
+          wsUploadPath = thirdColon > 0 ? msg.substring(secondColon + 1, thirdColon) : msg.substring(secondColon + 1);
+          wsUploadHashValid = false;
+          wsUploadContentHash = 0;
+          if (thirdColon > 0) {
+            wsUploadContentHash = strtoull(msg.substring(thirdColon + 1).c_str(), nullptr, 16);
+            wsUploadHashValid = true;
+          }
+          // Frame size negotiation: only clients that ask get the framed protocol
+          wsUploadFramed = false;
+          wsUploadFrameSize = 0;
+          wsUploadNextSeq = 0;
+          if (fourthColon > 0) {
+            const long clientMaxFrame = msg.substring(fourthColon + 1).toInt();
+            if (clientMaxFrame >= static_cast<long>(WS_FLUSH_CHUNK_SIZE)) {
+              wsUploadFramed = true;
+              wsUploadFrameSize =
+                  clientMaxFrame < static_cast<long>(WS_MAX_FRAME_SIZE) ? clientMaxFrame : WS_MAX_FRAME_SIZE;
+            }
+          }
           wsUploadReceived = 0;
           wsUploadStartTime = millis();
 
@@ -853,11 +1545,23 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
           Serial.printf("[%lu] [WS] Starting upload: %s (%d bytes) to %s\n", millis(), wsUploadFileName.c_str(),
                         wsUploadSize, filePath.c_str());
 
+          // Dedup check: skip the transfer when the manifest already records this exact file
+          if (wsUploadHashValid && SdMan.exists(filePath.c_str())) {
+            const UploadManifestEntry* entry = findManifestEntry(filePath);
+            if (entry && entry->size == wsUploadSize && entry->contentHash == wsUploadContentHash) {
+              Serial.printf("[%lu] [WS] Unchanged, skipping: %s\n", millis(), filePath.c_str());
+              wsServer->sendTXT(num, "SKIP");
+              return;
+            }
+          }
+
           // Check if file exists and remove it
           esp_task_wdt_reset();
           if (SdMan.exists(filePath.c_str())) {
+            FILE_HANDLES.invalidate(filePath.c_str());  // A reader may hold the old file open
             SdMan.remove(filePath.c_str());
           }
+          forgetManifestEntry(filePath);  // stale until this upload completes
 
           // Open file for writing
           esp_task_wdt_reset();
@@ -868,8 +1572,25 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
           }
           esp_task_wdt_reset();
 
+          // Hand the file to the flush task
+          wsRingHead = 0;
+          wsRingTail = 0;
+          wsFlushedBytes = 0;
+          wsFlushFinal = false;
+          wsFlushError = false;
+          if (wsFlushTaskHandle) {
+            wsFlushIdle = false;
+          }
+
           wsUploadInProgress = true;
-          wsServer->sendTXT(num, "READY");
+          if (wsUploadFramed) {
+            Serial.printf("[%lu] [WS] Negotiated %zu byte frames, window of %zu\n", millis(), wsUploadFrameSize,
+                          WS_ACK_WINDOW_FRAMES);
+            String ready = "READY:" + String(wsUploadFrameSize) + ":" + String(WS_ACK_WINDOW_FRAMES);
+            wsServer->sendTXT(num, ready);
+          } else {
+            wsServer->sendTXT(num, "READY");
+          }
         } else {
           wsServer->sendTXT(num, "ERROR:Invalid START format");
         }
@@ -883,23 +1604,84 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
         return;
       }
 
-      // Write binary data directly to file
-      esp_task_wdt_reset();
-      size_t written = wsUploadFile.write(payload, length);
-      esp_task_wdt_reset();
+      uint32_t frameSeq = 0;
+      if (wsUploadFramed) {
+        // Strip and verify the sequence prefix before the data touches the ring
+        if (length <= WS_FRAME_SEQ_HEADER) {
+          wsServer->sendTXT(num, "ERROR:Bad frame");
+          return;
+        }
+        memcpy(&frameSeq, payload, WS_FRAME_SEQ_HEADER);  // little-endian, same as the wire
+        if (frameSeq != wsUploadNextSeq) {
+          Serial.printf("[%lu] [WS] Frame out of sequence (got %u, expected %u)\n", millis(), frameSeq,
+                        wsUploadNextSeq);
+          if (wsFlushTaskHandle) {
+            wsFlushAbort = true;
+            while (!wsFlushIdle) {
+              esp_task_wdt_reset();
+              vTaskDelay(1);
+            }
+          } else if (wsUploadFile) {
+            wsUploadFile.close();
+            const String filePath = wsUploadFilePath();
+            SdMan.remove(filePath.c_str());
+          }
+          wsUploadInProgress = false;
+          wsServer->sendTXT(num, "ERROR:Frame out of sequence");
+          return;
+        }
+        wsUploadNextSeq++;
+        payload += WS_FRAME_SEQ_HEADER;
+        length -= WS_FRAME_SEQ_HEADER;
+      }
 
-      if (written != length) {
-        wsUploadFile.close();
+      if (wsUploadRing && wsFlushTaskHandle) {
+        // Copy the frame into the ring, waiting for space when WiFi outruns the SD card
+        size_t offset = 0;
+        while (offset < length && !wsFlushError) {
+          const size_t space = wsRingSpace();
+          if (space == 0) {
+            esp_task_wdt_reset();
+            vTaskDelay(1);
+            continue;
+          }
+          const size_t head = wsRingHead;
+          size_t chunk = length - offset;
+          if (chunk > space) chunk = space;
+          if (chunk > WS_UPLOAD_RING_SIZE - head) chunk = WS_UPLOAD_RING_SIZE - head;
+          memcpy(wsUploadRing + head, payload + offset, chunk);
+          wsRingHead = (head + chunk) % WS_UPLOAD_RING_SIZE;
+          offset += chunk;
+        }
+        wsUploadReceived += length;
+      } else {
+        // No ring available - write the frame to SD inline
+        esp_task_wdt_reset();
+        const size_t written = wsUploadFile.write(payload, length);
+        esp_task_wdt_reset();
+        if (written != length) {
+          wsUploadFile.close();
+          wsFlushError = true;
+        }
+        wsUploadReceived += written;
+        wsFlushedBytes += written;
+      }
+
+      if (wsFlushError) {
         wsUploadInProgress = false;
         wsServer->sendTXT(num, "ERROR:Write failed - disk full?");
         return;
       }
 
-      wsUploadReceived += written;
+      if (wsUploadFramed) {
+        // The ack opens the client's send window and doubles as server-side progress
+        String ack = "ACK:" + String(frameSeq);
+        wsServer->sendTXT(num, ack);
+      }
 
-      // Send progress update (every 64KB or at end)
+      // Send progress update (every 64KB or at end); the ack covers this in framed mode
       static size_t lastProgressSent = 0;
-      if (wsUploadReceived - lastProgressSent >= 65536 || wsUploadReceived >= wsUploadSize) {
+      if (!wsUploadFramed && (wsUploadReceived - lastProgressSent >= 65536 || wsUploadReceived >= wsUploadSize)) {
         String progress = "PROGRESS:" + String(wsUploadReceived) + ":" + String(wsUploadSize);
         wsServer->sendTXT(num, progress);
         lastProgressSent = wsUploadReceived;
@@ -907,7 +1689,22 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
 
       // Check if upload complete
       if (wsUploadReceived >= wsUploadSize) {
-        wsUploadFile.close();
+        if (wsFlushTaskHandle) {
+          // Drain the ring; the flush task closes the file when it is done
+          wsFlushFinal = true;
+          while (!wsFlushIdle) {
+            esp_task_wdt_reset();
+            vTaskDelay(1);
+          }
+          if (wsFlushError) {
+            wsUploadInProgress = false;
+            wsServer->sendTXT(num, "ERROR:Write failed - disk full?");
+            lastProgressSent = 0;
+            return;
+          }
+        } else {
+          wsUploadFile.close();
+        }
         wsUploadInProgress = false;
 
         wsLastCompleteName = wsUploadFileName;
@@ -925,6 +1722,11 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
         if (!filePath.endsWith("/")) filePath += "/";
         filePath += wsUploadFileName;
         clearEpubCacheIfNeeded(filePath);
+        LIBRARY_INDEX.addEntry(filePath.c_str());
+        warmEpubCacheIfNeeded(filePath);
+        if (wsUploadHashValid) {
+          recordManifestEntry(filePath, wsUploadSize, wsUploadContentHash);
+        }
 
         wsServer->sendTXT(num, "DONE");
         lastProgressSent = 0;
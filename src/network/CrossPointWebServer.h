@@ -2,7 +2,9 @@
 
 #include <WebServer.h>
 #include <WebSocketsServer.h>
-#include <WiFiUdp.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 
 #include <memory>
 #include <string>
@@ -20,7 +22,8 @@ class CrossPointWebServer {
  public:
   struct WsUploadStatus {
     bool inProgress = false;
-    size_t received = 0;
+    size_t received = 0;  // Bytes taken off the network
+    size_t flushed = 0;   // Bytes actually written to SD (trails received while the ring drains)
     size_t total = 0;
     std::string filename;
     std::string lastCompleteName;
@@ -31,18 +34,18 @@ class CrossPointWebServer {
   CrossPointWebServer();
   ~CrossPointWebServer();
 
-  // Start the web server (call after WiFi is connected)
+  // Start the web server (call after WiFi is connected). Client handling runs on a dedicated
+  // task from here on; activities only poll getWsUploadStatus() for UI updates.
   void begin();
 
   // Stop the web server
   void stop();
 
-  // Call this periodically to handle client requests
-  void handleClient();
-
   // Check if server is running
   bool isRunning() const { return running; }
 
+  // Latest status snapshot from the server task's mailbox queue; falls back to reading the
+  // shared upload state directly when the queue could not be allocated
   WsUploadStatus getWsUploadStatus() const;
 
   // Get the port number
@@ -55,22 +58,37 @@ class CrossPointWebServer {
   bool apMode = false;  // true when running in AP mode, false for STA mode
   uint16_t port = 80;
   uint16_t wsPort = 81;  // WebSocket port
-  WiFiUDP udp;
-  bool udpActive = false;
+
+  // Server task: pumps HTTP and WebSocket traffic independently of the activity loop,
+  // so upload throughput no longer collapses during renders and the UI never blocks on a
+  // request in flight. Posts status snapshots to a length-1 mailbox queue for the UI.
+  TaskHandle_t serverTaskHandle = nullptr;
+  QueueHandle_t statusQueue = nullptr;
+  volatile bool serverTaskExit = false;
+  volatile bool serverTaskDone = true;
+  static void serverTaskLoop(void* param);
+  void handleClient();
+  void postStatusSnapshot() const;
 
   // WebSocket upload state
   void onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
   static void wsEventCallback(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
 
   // File scanning
-  void scanFiles(const char* path, const std::function<void(FileInfo)>& callback) const;
+  // Calls back per visible directory entry; return false from the callback to stop the scan early
+  void scanFiles(const char* path, const std::function<bool(const FileInfo&)>& callback) const;
   String formatFileSize(size_t bytes) const;
   bool isEpubFile(const String& filename) const;
 
   // Request handlers
+  // Shared 304 path for the embedded assets; true means the response is already sent
+  bool sendAssetNotModified(const char* etag) const;
   void handleRoot() const;
   void handleNotFound() const;
   void handleStatus() const;
+  void handleHeapDebug() const;
+  void handleCrashDebug() const;
+  void handleSdBench() const;
   void handleFileList() const;
   void handleFileListData() const;
   void handleDownload() const;
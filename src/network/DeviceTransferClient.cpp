@@ -0,0 +1,309 @@
+#include "DeviceTransferClient.h"
+
+#include <FileHandleCache.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+#include <cstring>
+
+#include "DeviceTransferProtocol.h"
+
+using namespace devicetransfer;
+
+namespace {
+// One network read per SD write
+constexpr size_t RECEIVE_CHUNK_SIZE = 8 * 1024;
+
+// How many GET requests to keep queued at the source ahead of the file being written. The
+// cache dirs are thousands of small section/LUT files; without the pipeline each would pay a
+// full request round trip against a few KB of payload.
+constexpr size_t PIPELINE_DEPTH = 4;
+
+constexpr unsigned long CONNECT_TIMEOUT_MS = 10000;
+constexpr unsigned long DATA_TIMEOUT_MS = 15000;
+
+// Upper bound on the up-front index reservation; the advertised entry count is network input
+constexpr uint32_t MAX_INDEX_RESERVE = 1024;
+
+// Create every missing directory on the path leading to (but not including) the final segment
+void ensureParentDirs(const std::string& path) {
+  for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+    const std::string parent = path.substr(0, pos);
+    if (!SdMan.exists(parent.c_str())) {
+      SdMan.mkdir(parent.c_str());
+    }
+  }
+}
+}  // namespace
+
+DeviceTransferClient::~DeviceTransferClient() { stop(); }
+
+void DeviceTransferClient::begin(const std::string& host) {
+  if (running) {
+    return;
+  }
+  this->host = host;
+
+  statusMutex = xSemaphoreCreateMutex();
+  status = Status();
+  running = true;
+
+  taskCancel = false;
+  taskDone = false;
+  if (xTaskCreate(taskTrampoline, "DevTransferCli",
+                  8192,        // Stack size - index entries build std::string paths
+                  this,        // Parameters
+                  1,           // Priority
+                  &taskHandle  // Task handle
+                  ) != pdPASS) {
+    Serial.printf("[%lu] [DTC] !! Failed to create client task\n", millis());
+    taskDone = true;
+    running = false;
+  }
+}
+
+void DeviceTransferClient::stop() {
+  if (!running) {
+    return;
+  }
+  taskCancel = true;
+  while (!taskDone) {
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+  taskHandle = nullptr;
+  running = false;
+
+  if (statusMutex) {
+    vSemaphoreDelete(statusMutex);
+    statusMutex = nullptr;
+  }
+}
+
+DeviceTransferClient::Status DeviceTransferClient::getStatus() const {
+  Status copy;
+  if (statusMutex) {
+    xSemaphoreTake(statusMutex, portMAX_DELAY);
+    copy = status;
+    xSemaphoreGive(statusMutex);
+  }
+  return copy;
+}
+
+void DeviceTransferClient::updateStatus(const std::function<void(Status&)>& fn) {
+  xSemaphoreTake(statusMutex, portMAX_DELAY);
+  fn(status);
+  xSemaphoreGive(statusMutex);
+}
+
+void DeviceTransferClient::fail(const char* message) {
+  Serial.printf("[%lu] [DTC] Transfer failed: %s\n", millis(), message);
+  updateStatus([&](Status& s) {
+    s.state = State::FAILED;
+    s.error = message;
+  });
+}
+
+void DeviceTransferClient::taskTrampoline(void* param) {
+  auto* self = static_cast<DeviceTransferClient*>(param);
+  self->run();
+  self->taskDone = true;
+  vTaskDelete(nullptr);
+}
+
+void DeviceTransferClient::run() {
+  WiFiClient client;
+  client.setNoDelay(true);
+  Serial.printf("[%lu] [DTC] Connecting to %s:%u...\n", millis(), host.c_str(), PORT);
+  if (!client.connect(host.c_str(), PORT, CONNECT_TIMEOUT_MS)) {
+    fail("Could not connect to source device");
+    return;
+  }
+
+  // Handshake
+  char magic[sizeof(MAGIC)];
+  uint8_t version;
+  if (!readExact(client, reinterpret_cast<uint8_t*>(magic), sizeof(magic), DATA_TIMEOUT_MS) ||
+      memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !readPod(client, version, DATA_TIMEOUT_MS) ||
+      version != VERSION) {
+    fail("Source device spoke an unexpected protocol");
+    return;
+  }
+
+  // Pull the index
+  updateStatus([](Status& s) { s.state = State::INDEXING; });
+  std::vector<IndexEntry> entries;
+  if (!writePod(client, CMD_INDEX) || !readIndex(client, entries)) {
+    fail("Could not read library index");
+    return;
+  }
+  Serial.printf("[%lu] [DTC] Index received: %u entries\n", millis(), static_cast<unsigned>(entries.size()));
+
+  // Skip pass: a file already present with the same size is assumed transferred. Sizes in
+  // the cache dirs change whenever their content does (section files embed their pages), so
+  // this is enough to make re-runs cheap without hashing.
+  std::vector<const IndexEntry*> wanted;
+  uint64_t bytesTotal = 0;
+  uint32_t skipped = 0;
+  for (const auto& entry : entries) {
+    FsFile existing = SdMan.open(entry.path.c_str());
+    const bool have = existing && !existing.isDirectory() && existing.size() == entry.size;
+    if (existing) {
+      existing.close();
+    }
+    if (have) {
+      skipped++;
+    } else {
+      wanted.push_back(&entry);
+      bytesTotal += entry.size;
+    }
+  }
+  updateStatus([&](Status& s) {
+    s.state = State::TRANSFERRING;
+    s.filesTotal = wanted.size();
+    s.filesSkipped = skipped;
+    s.bytesTotal = bytesTotal;
+  });
+  Serial.printf("[%lu] [DTC] Pulling %u files (%llu KB), %u already present\n", millis(),
+                static_cast<unsigned>(wanted.size()), bytesTotal / 1024, skipped);
+
+  // Pipelined pull: keep PIPELINE_DEPTH requests in flight, consume responses in order
+  size_t requested = 0;
+  size_t received = 0;
+  while (received < wanted.size()) {
+    while (requested < wanted.size() && requested - received < PIPELINE_DEPTH) {
+      if (!sendGet(client, wanted[requested]->path)) {
+        fail("Connection lost while requesting files");
+        return;
+      }
+      requested++;
+    }
+    if (!receiveFile(client, *wanted[received])) {
+      // receiveFile set the error (or we were cancelled)
+      if (!taskCancel) {
+        return;
+      }
+      break;
+    }
+    received++;
+    if (taskCancel) {
+      break;
+    }
+  }
+
+  writePod(client, CMD_BYE);
+  client.stop();
+
+  if (taskCancel && received < wanted.size()) {
+    fail("Transfer cancelled");
+    return;
+  }
+  updateStatus([](Status& s) {
+    s.state = State::DONE;
+    s.currentFile.clear();
+  });
+  Serial.printf("[%lu] [DTC] Transfer complete: %u pulled, %u skipped\n", millis(),
+                static_cast<unsigned>(received), skipped);
+}
+
+bool DeviceTransferClient::readIndex(WiFiClient& client, std::vector<IndexEntry>& out) {
+  uint32_t count;
+  if (!readPod(client, count, DATA_TIMEOUT_MS)) {
+    return false;
+  }
+  // The count comes off an open network, so like pathLen below it cannot be trusted as-is: a
+  // spoofed huge value would force a multi-megabyte reservation and abort this no-exceptions
+  // build. Reserve within a sane bound and let push_back grow past it if the entries actually
+  // arrive.
+  out.reserve(count < MAX_INDEX_RESERVE ? count : MAX_INDEX_RESERVE);
+  char pathBuf[MAX_PATH_LEN + 1];
+  for (uint32_t i = 0; i < count; i++) {
+    uint16_t pathLen;
+    if (!readPod(client, pathLen, DATA_TIMEOUT_MS) || pathLen == 0 || pathLen > MAX_PATH_LEN) {
+      return false;
+    }
+    if (!readExact(client, reinterpret_cast<uint8_t*>(pathBuf), pathLen, DATA_TIMEOUT_MS)) {
+      return false;
+    }
+    pathBuf[pathLen] = '\0';
+    uint32_t size;
+    if (!readPod(client, size, DATA_TIMEOUT_MS)) {
+      return false;
+    }
+    out.push_back({pathBuf, size});
+    if (taskCancel) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DeviceTransferClient::sendGet(WiFiClient& client, const std::string& path) {
+  const auto pathLen = static_cast<uint16_t>(path.length());
+  return writePod(client, CMD_GET) && writePod(client, pathLen) &&
+         client.write(reinterpret_cast<const uint8_t*>(path.c_str()), pathLen) == pathLen;
+}
+
+bool DeviceTransferClient::receiveFile(WiFiClient& client, const IndexEntry& entry) {
+  uint32_t size;
+  if (!readPod(client, size, DATA_TIMEOUT_MS)) {
+    fail("Connection lost while waiting for a file");
+    return false;
+  }
+  if (size == SIZE_MISSING) {
+    // Source couldn't open it (deleted since indexing); count it done and move on
+    Serial.printf("[%lu] [DTC] Source skipped %s\n", millis(), entry.path.c_str());
+    updateStatus([](Status& s) { s.filesDone++; });
+    return true;
+  }
+
+  updateStatus([&](Status& s) { s.currentFile = entry.path; });
+
+  ensureParentDirs(entry.path);
+  FILE_HANDLES.invalidate(entry.path);  // A reader may hold the old file open
+  if (SdMan.exists(entry.path.c_str())) {
+    SdMan.remove(entry.path.c_str());
+  }
+  FsFile file;
+  if (!SdMan.openFileForWrite("DTC", entry.path, file)) {
+    // The response bytes are already on the wire; drain them so the stream stays framed
+    static uint8_t drain[RECEIVE_CHUNK_SIZE];
+    uint32_t remaining = size;
+    while (remaining > 0) {
+      const size_t want = remaining < RECEIVE_CHUNK_SIZE ? remaining : RECEIVE_CHUNK_SIZE;
+      if (!readExact(client, drain, want, DATA_TIMEOUT_MS)) {
+        fail("Connection lost");
+        return false;
+      }
+      remaining -= want;
+    }
+    Serial.printf("[%lu] [DTC] Could not write %s, skipped\n", millis(), entry.path.c_str());
+    updateStatus([](Status& s) { s.filesDone++; });
+    return true;
+  }
+
+  static uint8_t chunk[RECEIVE_CHUNK_SIZE];
+  uint32_t remaining = size;
+  bool writeFailed = false;
+  while (remaining > 0) {
+    const size_t want = remaining < RECEIVE_CHUNK_SIZE ? remaining : RECEIVE_CHUNK_SIZE;
+    if (!readExact(client, chunk, want, DATA_TIMEOUT_MS)) {
+      file.close();
+      SdMan.remove(entry.path.c_str());
+      fail("Connection lost mid-file");
+      return false;
+    }
+    if (!writeFailed && file.write(chunk, want) != want) {
+      // Keep draining the response so the stream stays framed, but drop the partial file
+      writeFailed = true;
+    }
+    remaining -= want;
+    updateStatus([&](Status& s) { s.bytesDone += want; });
+  }
+  file.close();
+  if (writeFailed) {
+    Serial.printf("[%lu] [DTC] Write failed for %s (card full?), partial removed\n", millis(), entry.path.c_str());
+    SdMan.remove(entry.path.c_str());
+  }
+  updateStatus([](Status& s) { s.filesDone++; });
+  return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <WiFiClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Target side of device-to-device library transfer.
+ *
+ * Connects to a DeviceTransferServer, pulls the library index and streams every missing file
+ * to the SD card. Files that already exist with the index's size are skipped, so an
+ * interrupted transfer resumes where it left off.
+ *
+ * GET requests are pipelined a few files ahead on the single TCP connection: while one file's
+ * bytes are being written to SD the requests for the next ones are already queued at the
+ * source, so the link never idles on a request round trip and throughput stays pinned to
+ * SD-write speed. The whole pull runs on a dedicated task; the activity polls getStatus().
+ */
+class DeviceTransferClient {
+ public:
+  enum class State { CONNECTING, INDEXING, TRANSFERRING, DONE, FAILED };
+
+  struct Status {
+    State state = State::CONNECTING;
+    uint32_t filesTotal = 0;    // Files to pull after the skip pass
+    uint32_t filesDone = 0;
+    uint32_t filesSkipped = 0;  // Already present with matching size
+    uint64_t bytesTotal = 0;
+    uint64_t bytesDone = 0;
+    std::string currentFile;
+    std::string error;
+  };
+
+  ~DeviceTransferClient();
+
+  // Connect to the source and start pulling on a background task
+  void begin(const std::string& host);
+  // Ask the task to stop after the file in flight; stop() then joins it
+  void cancel() { taskCancel = true; }
+  void stop();
+  bool isRunning() const { return running; }
+  Status getStatus() const;
+
+ private:
+  struct IndexEntry {
+    std::string path;
+    uint32_t size;
+  };
+
+  std::string host;
+  bool running = false;
+
+  TaskHandle_t taskHandle = nullptr;
+  volatile bool taskCancel = false;
+  volatile bool taskDone = true;
+  static void taskTrampoline(void* param);
+  void run();
+
+  mutable SemaphoreHandle_t statusMutex = nullptr;
+  Status status;
+  void updateStatus(const std::function<void(Status&)>& fn);
+  void fail(const char* message);
+
+  bool readIndex(WiFiClient& client, std::vector<IndexEntry>& out);
+  bool sendGet(WiFiClient& client, const std::string& path);
+  bool receiveFile(WiFiClient& client, const IndexEntry& entry);
+};
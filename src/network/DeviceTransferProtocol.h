@@ -0,0 +1,75 @@
+#pragma once
+
+#include <WiFiClient.h>
+
+#include <cstdint>
+
+/**
+ * Wire protocol shared by DeviceTransferServer and DeviceTransferClient.
+ *
+ * Deliberately raw TCP rather than HTTP: transfers move whole libraries (books plus their
+ * cache directories), so per-file HTTP headers and chunked encoding would add a round trip
+ * and header parse per item. Here the only per-file overhead is a fixed-width frame header,
+ * and the client can pipeline requests so the source's SD reads and the target's SD writes
+ * never wait on the network turnaround.
+ *
+ * All integers are little-endian (both ends are ESP32).
+ *
+ *   On connect the server sends: magic "XPDT" + u8 version.
+ *   Client commands (1 byte each):
+ *     CMD_INDEX  -> server replies u32 entryCount, then per entry u16 pathLen, path bytes,
+ *                   u32 fileSize
+ *     CMD_GET    -> followed by u16 pathLen + path; server replies u32 size (SIZE_MISSING if
+ *                   the file cannot be opened) + size raw bytes
+ *     CMD_BYE    -> server closes the connection
+ */
+namespace devicetransfer {
+
+constexpr uint16_t PORT = 9917;
+constexpr char MAGIC[4] = {'X', 'P', 'D', 'T'};
+constexpr uint8_t VERSION = 1;
+
+constexpr uint8_t CMD_INDEX = 0x01;
+constexpr uint8_t CMD_GET = 0x02;
+constexpr uint8_t CMD_BYE = 0x03;
+
+// Size sentinel for a GET the server could not satisfy
+constexpr uint32_t SIZE_MISSING = 0xFFFFFFFF;
+
+// Longest entry path accepted on either end
+constexpr size_t MAX_PATH_LEN = 256;
+
+// Reads exactly len bytes, waiting up to timeoutMs between progress. Returns false on
+// disconnect or timeout.
+inline bool readExact(WiFiClient& client, uint8_t* buf, size_t len, const unsigned long timeoutMs) {
+  size_t got = 0;
+  unsigned long lastProgress = millis();
+  while (got < len) {
+    if (!client.connected()) {
+      return false;
+    }
+    const int n = client.read(buf + got, len - got);
+    if (n > 0) {
+      got += n;
+      lastProgress = millis();
+    } else {
+      if (millis() - lastProgress > timeoutMs) {
+        return false;
+      }
+      vTaskDelay(1);
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool readPod(WiFiClient& client, T& value, const unsigned long timeoutMs) {
+  return readExact(client, reinterpret_cast<uint8_t*>(&value), sizeof(T), timeoutMs);
+}
+
+template <typename T>
+bool writePod(WiFiClient& client, const T& value) {
+  return client.write(reinterpret_cast<const uint8_t*>(&value), sizeof(T)) == sizeof(T);
+}
+
+}  // namespace devicetransfer
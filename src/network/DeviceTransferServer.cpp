@@ -0,0 +1,305 @@
+#include "DeviceTransferServer.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+
+#include <cstring>
+
+#include "DeviceTransferProtocol.h"
+
+using namespace devicetransfer;
+
+namespace {
+// One SD read per network write; sized like the web server's download chunks
+constexpr size_t SEND_CHUNK_SIZE = 8 * 1024;
+
+// Commands are tiny; anything slower than this means the peer went away
+constexpr unsigned long COMMAND_TIMEOUT_MS = 30000;
+}  // namespace
+
+DeviceTransferServer::~DeviceTransferServer() { stop(); }
+
+void DeviceTransferServer::begin() {
+  if (running) {
+    return;
+  }
+
+  statusMutex = xSemaphoreCreateMutex();
+  status = Status();
+
+  server.reset(new WiFiServer(PORT));
+  server->begin();
+  running = true;
+
+  serverTaskExit = false;
+  serverTaskDone = false;
+  if (xTaskCreate(serverTaskLoop, "DevTransferSrv",
+                  8192,              // Stack size - file walking builds std::string paths
+                  this,              // Parameters
+                  1,                 // Priority
+                  &serverTaskHandle  // Task handle
+                  ) != pdPASS) {
+    Serial.printf("[%lu] [DTS] !! Failed to create server task\n", millis());
+    serverTaskDone = true;
+    running = false;
+    server->stop();
+    server.reset();
+    return;
+  }
+
+  Serial.printf("[%lu] [DTS] Transfer server listening on port %u\n", millis(), PORT);
+}
+
+void DeviceTransferServer::stop() {
+  if (!running) {
+    return;
+  }
+  running = false;
+  serverTaskExit = true;
+  while (!serverTaskDone) {
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+  serverTaskHandle = nullptr;
+
+  server->stop();
+  server.reset();
+
+  if (statusMutex) {
+    vSemaphoreDelete(statusMutex);
+    statusMutex = nullptr;
+  }
+  Serial.printf("[%lu] [DTS] Transfer server stopped\n", millis());
+}
+
+DeviceTransferServer::Status DeviceTransferServer::getStatus() const {
+  Status copy;
+  if (statusMutex) {
+    xSemaphoreTake(statusMutex, portMAX_DELAY);
+    copy = status;
+    xSemaphoreGive(statusMutex);
+  }
+  return copy;
+}
+
+void DeviceTransferServer::updateStatus(const std::function<void(Status&)>& fn) {
+  xSemaphoreTake(statusMutex, portMAX_DELAY);
+  fn(status);
+  xSemaphoreGive(statusMutex);
+}
+
+void DeviceTransferServer::serverTaskLoop(void* param) {
+  auto* self = static_cast<DeviceTransferServer*>(param);
+  while (!self->serverTaskExit) {
+    WiFiClient client = self->server->available();
+    if (client) {
+      Serial.printf("[%lu] [DTS] Client connected: %s\n", millis(), client.remoteIP().toString().c_str());
+      self->updateStatus([](Status& s) { s.clientConnected = true; });
+      self->serveClient(client);
+      client.stop();
+      self->updateStatus([](Status& s) {
+        s.clientConnected = false;
+        s.currentFile.clear();
+      });
+      Serial.printf("[%lu] [DTS] Client disconnected\n", millis());
+    }
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+  self->serverTaskDone = true;
+  vTaskDelete(nullptr);
+}
+
+void DeviceTransferServer::serveClient(WiFiClient& client) {
+  client.setNoDelay(true);
+
+  // Handshake: magic + version, so a stray connection to the port fails fast on the client
+  client.write(reinterpret_cast<const uint8_t*>(MAGIC), sizeof(MAGIC));
+  writePod(client, VERSION);
+
+  char pathBuf[MAX_PATH_LEN + 1];
+  while (!serverTaskExit && client.connected()) {
+    uint8_t cmd;
+    if (!readPod(client, cmd, COMMAND_TIMEOUT_MS)) {
+      return;
+    }
+
+    if (cmd == CMD_INDEX) {
+      if (!sendIndex(client)) {
+        return;
+      }
+    } else if (cmd == CMD_GET) {
+      uint16_t pathLen;
+      if (!readPod(client, pathLen, COMMAND_TIMEOUT_MS) || pathLen == 0 || pathLen > MAX_PATH_LEN) {
+        return;
+      }
+      if (!readExact(client, reinterpret_cast<uint8_t*>(pathBuf), pathLen, COMMAND_TIMEOUT_MS)) {
+        return;
+      }
+      pathBuf[pathLen] = '\0';
+      if (!sendFile(client, pathBuf)) {
+        return;
+      }
+    } else if (cmd == CMD_BYE) {
+      return;
+    } else {
+      Serial.printf("[%lu] [DTS] Unknown command 0x%02x, dropping client\n", millis(), cmd);
+      return;
+    }
+  }
+}
+
+bool DeviceTransferServer::sendIndex(WiFiClient& client) {
+  std::vector<IndexEntry> entries;
+  collectIndex(entries);
+  Serial.printf("[%lu] [DTS] Sending index: %u entries\n", millis(), static_cast<unsigned>(entries.size()));
+
+  if (!writePod(client, static_cast<uint32_t>(entries.size()))) {
+    return false;
+  }
+  for (const auto& entry : entries) {
+    const auto pathLen = static_cast<uint16_t>(entry.path.length());
+    if (!writePod(client, pathLen) ||
+        client.write(reinterpret_cast<const uint8_t*>(entry.path.c_str()), pathLen) != pathLen ||
+        !writePod(client, entry.size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Re-applies collectIndex's visibility rules to a GET path, so the server only ever opens
+// files it would itself have listed: hidden entries are off limits everywhere except inside
+// the per-book cache directories, and /.crosspoint's own state (wifi.bin, sync credentials,
+// manifests) is never reachable. Anyone in radio range can join the transfer AP, so this
+// cannot rely on the peer only requesting what sendIndex returned.
+bool DeviceTransferServer::isIndexablePath(const std::string& path) {
+  if (path.length() < 2 || path[0] != '/') {
+    return false;
+  }
+  const bool cacheTree = path.rfind("/.crosspoint/", 0) == 0;
+  size_t start = 1;
+  if (cacheTree) {
+    // Only files inside an epub_/xtc_ cache dir are indexed, never /.crosspoint's top level
+    start = strlen("/.crosspoint/");
+    if (path.find('/', start) == std::string::npos ||
+        (path.compare(start, 5, "epub_") != 0 && path.compare(start, 4, "xtc_") != 0)) {
+      return false;
+    }
+  }
+  // Walk the remaining components: no relative steps, no empty names, and (outside the cache
+  // dirs, where collectDir passes includeHidden) nothing hidden
+  while (start <= path.length()) {
+    size_t end = path.find('/', start);
+    if (end == std::string::npos) {
+      end = path.length();
+    }
+    const size_t len = end - start;
+    if (len == 0) {
+      return false;
+    }
+    if (path[start] == '.') {
+      if (!cacheTree || len == 1 || (len == 2 && path[start + 1] == '.')) {
+        return false;
+      }
+    }
+    start = end + 1;
+  }
+  return true;
+}
+
+bool DeviceTransferServer::sendFile(WiFiClient& client, const std::string& path) {
+  if (!isIndexablePath(path)) {
+    Serial.printf("[%lu] [DTS] Refusing GET for non-indexed path: %s\n", millis(), path.c_str());
+    return writePod(client, SIZE_MISSING);
+  }
+  FsFile file;
+  if (!SdMan.openFileForRead("DTS", path, file)) {
+    return writePod(client, SIZE_MISSING);
+  }
+
+  const uint32_t size = file.size();
+  if (!writePod(client, size)) {
+    file.close();
+    return false;
+  }
+
+  updateStatus([&](Status& s) { s.currentFile = path; });
+
+  static uint8_t chunk[SEND_CHUNK_SIZE];
+  uint32_t remaining = size;
+  while (remaining > 0) {
+    const size_t want = remaining < SEND_CHUNK_SIZE ? remaining : SEND_CHUNK_SIZE;
+    const int got = file.read(chunk, want);
+    if (got <= 0) {
+      // The index promised more bytes than the file delivered; the stream is now misframed,
+      // so the only safe recovery is dropping the connection
+      Serial.printf("[%lu] [DTS] Short read on %s, dropping client\n", millis(), path.c_str());
+      file.close();
+      return false;
+    }
+    if (client.write(chunk, got) != static_cast<size_t>(got)) {
+      file.close();
+      return false;
+    }
+    remaining -= got;
+    updateStatus([&](Status& s) { s.bytesSent += got; });
+    if (serverTaskExit) {
+      file.close();
+      return false;
+    }
+  }
+  file.close();
+  updateStatus([](Status& s) { s.filesSent++; });
+  return true;
+}
+
+void DeviceTransferServer::collectIndex(std::vector<IndexEntry>& out) const {
+  // User-visible library: everything outside hidden directories
+  collectDir("", out, false);
+
+  // Warm caches: section files, LUTs and thumbnails under /.crosspoint. Only the per-book
+  // cache directories move; device-local state (settings, manifests, logs) stays behind.
+  FsFile root = SdMan.open("/.crosspoint");
+  if (!root) {
+    return;
+  }
+  char name[128];
+  for (FsFile entry = root.openNextFile(); entry; entry = root.openNextFile()) {
+    entry.getName(name, sizeof(name));
+    const bool isCacheDir =
+        entry.isDirectory() && (strncmp(name, "epub_", 5) == 0 || strncmp(name, "xtc_", 4) == 0);
+    entry.close();
+    if (isCacheDir) {
+      collectDir(std::string("/.crosspoint/") + name, out, true);
+    }
+  }
+  root.close();
+}
+
+void DeviceTransferServer::collectDir(const std::string& dirPath, std::vector<IndexEntry>& out,
+                                      const bool includeHidden) const {
+  FsFile dir = SdMan.open(dirPath.empty() ? "/" : dirPath.c_str());
+  if (!dir) {
+    return;
+  }
+  char name[128];
+  for (FsFile entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    entry.getName(name, sizeof(name));
+    if (!includeHidden && name[0] == '.') {
+      entry.close();
+      continue;
+    }
+    const std::string path = dirPath + "/" + name;
+    if (path.length() > MAX_PATH_LEN) {
+      entry.close();
+      continue;
+    }
+    if (entry.isDirectory()) {
+      entry.close();
+      collectDir(path, out, includeHidden);
+    } else {
+      out.push_back({path, static_cast<uint32_t>(entry.size())});
+      entry.close();
+    }
+  }
+  dir.close();
+}
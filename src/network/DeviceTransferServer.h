@@ -0,0 +1,68 @@
+#pragma once
+
+#include <WiFiClient.h>
+#include <WiFiServer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Source side of device-to-device library transfer.
+ *
+ * Listens on a raw TCP port (see DeviceTransferProtocol.h) and serves the library index plus
+ * file contents to one connected CrossPoint at a time. The index covers the user-visible
+ * files on the SD card and the warm cache directories under /.crosspoint, so the target ends
+ * up with pre-paginated sections and thumbnails instead of rebuilding them from scratch.
+ *
+ * Client handling runs on a dedicated task, mirroring CrossPointWebServer; the activity only
+ * polls getStatus() for UI updates.
+ */
+class DeviceTransferServer {
+ public:
+  struct Status {
+    bool clientConnected = false;
+    uint32_t filesSent = 0;
+    uint64_t bytesSent = 0;
+    std::string currentFile;
+  };
+
+  ~DeviceTransferServer();
+
+  // Start listening (call after the AP or STA link is up)
+  void begin();
+  void stop();
+  bool isRunning() const { return running; }
+  Status getStatus() const;
+
+ private:
+  struct IndexEntry {
+    std::string path;
+    uint32_t size;
+  };
+
+  std::unique_ptr<WiFiServer> server;
+  bool running = false;
+
+  TaskHandle_t serverTaskHandle = nullptr;
+  volatile bool serverTaskExit = false;
+  volatile bool serverTaskDone = true;
+  static void serverTaskLoop(void* param);
+
+  mutable SemaphoreHandle_t statusMutex = nullptr;
+  Status status;
+  void updateStatus(const std::function<void(Status&)>& fn);
+
+  void serveClient(WiFiClient& client);
+  bool sendIndex(WiFiClient& client);
+  bool sendFile(WiFiClient& client, const std::string& path);
+  // Whether a client-supplied GET path is one the index could have listed; the hotspot is
+  // open, so paths off the wire are untrusted regardless of what the peer UI requests
+  static bool isIndexablePath(const std::string& path);
+  void collectIndex(std::vector<IndexEntry>& out) const;
+  void collectDir(const std::string& dirPath, std::vector<IndexEntry>& out, bool includeHidden) const;
+};
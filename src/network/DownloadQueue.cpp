@@ -0,0 +1,198 @@
+#include "DownloadQueue.h"
+
+#include <Epub.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+#include <WiFi.h>
+
+#include <algorithm>
+
+#include "HttpDownloader.h"
+#include "LibraryIndex.h"
+
+// Initialize the static instance
+DownloadQueue DownloadQueue::instance;
+
+namespace {
+// File format version
+constexpr uint8_t DOWNLOAD_QUEUE_FILE_VERSION = 1;
+
+// Pending downloads file path
+constexpr char DOWNLOAD_QUEUE_FILE[] = "/.crosspoint/downloads.bin";
+
+// Enough for a generous browsing session; further enqueues replace the oldest
+constexpr size_t MAX_QUEUE_ENTRIES = 32;
+}  // namespace
+
+void DownloadQueue::lock() {
+  if (!mutex) {
+    mutex = xSemaphoreCreateMutex();
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+void DownloadQueue::unlock() { xSemaphoreGive(mutex); }
+
+bool DownloadQueue::loadFromFile() {
+  loaded = true;  // A missing or bad file still counts as loaded (empty queue)
+  FsFile file;
+  if (!SdMan.openFileForRead("DLQ", DOWNLOAD_QUEUE_FILE, file)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(file, version);
+  if (version != DOWNLOAD_QUEUE_FILE_VERSION) {
+    Serial.printf("[%lu] [DLQ] Unknown file version: %u\n", millis(), version);
+    file.close();
+    return false;
+  }
+
+  uint8_t count;
+  serialization::readPod(file, count);
+
+  lock();
+  pending.clear();
+  pending.reserve(count);
+  for (uint8_t i = 0; i < count; i++) {
+    PendingDownload entry;
+    serialization::readString(file, entry.url);
+    serialization::readString(file, entry.destPath);
+    serialization::readString(file, entry.title);
+    pending.push_back(std::move(entry));
+  }
+  const size_t loaded = pending.size();
+  unlock();
+
+  file.close();
+  Serial.printf("[%lu] [DLQ] Loaded %d pending download(s)\n", millis(), loaded);
+  return true;
+}
+
+bool DownloadQueue::saveToFile() {
+  lock();
+  if (pending.empty()) {
+    unlock();
+    // Nothing pending; drop the file so boot skips the load
+    SdMan.remove(DOWNLOAD_QUEUE_FILE);
+    return true;
+  }
+
+  // Make sure the directory exists
+  SdMan.mkdir("/.crosspoint");
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("DLQ", DOWNLOAD_QUEUE_FILE, file)) {
+    unlock();
+    return false;
+  }
+
+  serialization::writePod(file, DOWNLOAD_QUEUE_FILE_VERSION);
+  serialization::writePod(file, static_cast<uint8_t>(pending.size()));
+  for (const auto& entry : pending) {
+    serialization::writeString(file, entry.url);
+    serialization::writeString(file, entry.destPath);
+    serialization::writeString(file, entry.title);
+  }
+  unlock();
+
+  file.close();
+  return true;
+}
+
+void DownloadQueue::enqueue(const std::string& url, const std::string& destPath, const std::string& title) {
+  if (url.empty() || destPath.empty()) {
+    return;
+  }
+  ensureLoaded();
+
+  lock();
+  // Re-queueing the same book just refreshes its URL
+  auto it = std::find_if(pending.begin(), pending.end(),
+                         [&](const PendingDownload& entry) { return entry.destPath == destPath; });
+  if (it != pending.end()) {
+    pending.erase(it);
+  }
+  pending.push_back({url, destPath, title});
+
+  if (pending.size() > MAX_QUEUE_ENTRIES) {
+    pending.erase(pending.begin());
+  }
+  const size_t queued = pending.size();
+  unlock();
+
+  saveToFile();
+  Serial.printf("[%lu] [DLQ] Queued %s (%d pending)\n", millis(), destPath.c_str(), queued);
+}
+
+bool DownloadQueue::hasPending() {
+  ensureLoaded();
+  lock();
+  const bool result = !pending.empty();
+  unlock();
+  return result;
+}
+
+size_t DownloadQueue::size() {
+  ensureLoaded();
+  lock();
+  const size_t result = pending.size();
+  unlock();
+  return result;
+}
+
+int DownloadQueue::drain(const std::function<bool()>& abortFn, const std::function<void()>& onItemComplete) {
+  ensureLoaded();
+  int completed = 0;
+
+  while (WiFi.status() == WL_CONNECTED && (!abortFn || !abortFn())) {
+    lock();
+    if (pending.empty()) {
+      unlock();
+      break;
+    }
+    // Work on a copy; enqueue() may touch the vector while the transfer runs
+    const PendingDownload item = pending.front();
+    unlock();
+
+    Serial.printf("[%lu] [DLQ] Downloading: %s -> %s\n", millis(), item.url.c_str(), item.destPath.c_str());
+    const auto result = HttpDownloader::downloadToFile(item.url, item.destPath, nullptr, abortFn);
+
+    if (result == HttpDownloader::HTTP_ERROR || result == HttpDownloader::ABORTED) {
+      // Keep the entry; the partial file resumes on the next drain
+      Serial.printf("[%lu] [DLQ] Download %s, will retry later\n", millis(),
+                    result == HttpDownloader::ABORTED ? "aborted" : "failed");
+      break;
+    }
+
+    lock();
+    auto it = std::find_if(pending.begin(), pending.end(),
+                           [&](const PendingDownload& entry) { return entry.destPath == item.destPath; });
+    if (it != pending.end()) {
+      pending.erase(it);
+    }
+    unlock();
+    saveToFile();
+
+    if (result == HttpDownloader::OK) {
+      // Invalidate any existing cache for this file to prevent stale metadata issues
+      Epub epub(item.destPath, "/.crosspoint");
+      epub.clearCache();
+
+      // Keep the library listing current without a directory rescan
+      LIBRARY_INDEX.addEntry(item.destPath);
+
+      completed++;
+      Serial.printf("[%lu] [DLQ] Download complete: %s\n", millis(), item.destPath.c_str());
+      if (onItemComplete) {
+        onItemComplete();
+      }
+    } else {
+      // FILE_ERROR: retrying won't help (bad path, full card) - drop the entry
+      Serial.printf("[%lu] [DLQ] Dropping %s after file error\n", millis(), item.destPath.c_str());
+    }
+  }
+
+  return completed;
+}
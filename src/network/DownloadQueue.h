@@ -0,0 +1,69 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Persistent queue of book downloads for bulk OPDS acquisition.
+ * Entries are saved to SD as they are queued, so an interrupted session (reboot,
+ * WiFi drop, leaving the browser) picks up where it stopped - partial transfers
+ * resume through HttpDownloader's Range support. The drain runs one transfer at
+ * a time: a second TLS session costs heap this board doesn't have, and the SD
+ * write path is the bottleneck anyway.
+ */
+class DownloadQueue {
+ public:
+  struct PendingDownload {
+    std::string url;
+    std::string destPath;
+    std::string title;
+  };
+
+  static DownloadQueue& getInstance() { return instance; }
+
+  DownloadQueue(const DownloadQueue&) = delete;
+  DownloadQueue& operator=(const DownloadQueue&) = delete;
+
+  bool loadFromFile();
+  bool saveToFile();
+
+  // Add a download (coalesces on destination path) and persist the queue
+  void enqueue(const std::string& url, const std::string& destPath, const std::string& title);
+
+  bool hasPending();
+  size_t size();
+
+  /**
+   * Download queued entries until the queue is empty, abortFn returns true, or
+   * a transfer fails. Completed books are registered with the library index.
+   * Call with WiFi up; onItemComplete fires after each finished book.
+   * @return number of downloads completed this call
+   */
+  int drain(const std::function<bool()>& abortFn = nullptr, const std::function<void()>& onItemComplete = nullptr);
+
+ private:
+  DownloadQueue() = default;
+  static DownloadQueue instance;
+
+  std::vector<PendingDownload> pending;
+  SemaphoreHandle_t mutex = nullptr;
+  bool loaded = false;  // Set once loadFromFile has run
+
+  // Queued from the UI loop, drained on the shared worker - every access to `pending` locks
+  void lock();
+  void unlock();
+
+  // Lazy bring-up, keeping the SD read off the boot path. Must run before any
+  // enqueue: a save from an unloaded queue would clobber persisted entries.
+  void ensureLoaded() {
+    if (!loaded) {
+      loadFromFile();
+    }
+  }
+};
+
+// Helper macro to access the download queue
+#define DOWNLOAD_QUEUE DownloadQueue::getInstance()
@@ -2,7 +2,7 @@
 
 #include <HTTPClient.h>
 #include <HardwareSerial.h>
-#include <StreamString.h>
+#include <Serialization.h>
 #include <WiFiClient.h>
 #include <WiFiClientSecure.h>
 #include <base64.h>
@@ -11,23 +11,114 @@
 #include <memory>
 
 #include "CrossPointSettings.h"
+#include "PowerGovernor.h"
 #include "util/UrlUtils.h"
 
-bool HttpDownloader::fetchUrl(const std::string& url, Stream& outContent) {
-  // Use WiFiClientSecure for HTTPS, regular WiFiClient for HTTP
-  std::unique_ptr<WiFiClient> client;
-  if (UrlUtils::isHttpsUrl(url)) {
-    auto* secureClient = new WiFiClientSecure();
-    secureClient->setInsecure();
-    client.reset(secureClient);
-  } else {
-    client.reset(new WiFiClient());
+namespace {
+// Sidecar file next to a partial download, holding the validators needed to
+// resume it safely (expected total size and the server's ETag)
+constexpr uint8_t RESUME_FILE_VERSION = 1;
+
+std::string resumeInfoPath(const std::string& destPath) { return destPath + ".resume"; }
+
+bool loadResumeInfo(const std::string& destPath, size_t& totalSize, std::string& etag) {
+  FsFile file;
+  if (!SdMan.openFileForRead("HTTP", resumeInfoPath(destPath), file)) {
+    return false;
+  }
+  uint8_t version;
+  serialization::readPod(file, version);
+  if (version != RESUME_FILE_VERSION) {
+    file.close();
+    return false;
+  }
+  uint32_t total;
+  serialization::readPod(file, total);
+  totalSize = total;
+  serialization::readString(file, etag);
+  file.close();
+  return true;
+}
+
+void saveResumeInfo(const std::string& destPath, const size_t totalSize, const std::string& etag) {
+  FsFile file;
+  if (!SdMan.openFileForWrite("HTTP", resumeInfoPath(destPath), file)) {
+    return;
+  }
+  serialization::writePod(file, RESUME_FILE_VERSION);
+  serialization::writePod(file, static_cast<uint32_t>(totalSize));
+  serialization::writeString(file, etag);
+  file.close();
+}
+
+void clearResumeInfo(const std::string& destPath) {
+  const std::string path = resumeInfoPath(destPath);
+  if (SdMan.exists(path.c_str())) {
+    SdMan.remove(path.c_str());
+  }
+}
+
+// Pooled keep-alive connection for the small sequential fetches (OPDS feed
+// pages). The TLS handshake takes ~2s on this chip and dominates those
+// requests, so the socket stays open between fetchUrl calls to the same host.
+// Only fetchUrl uses the pool: it always runs on one task at a time, while
+// downloadToFile can run concurrently on the worker and keeps its own client
+// (a multi-megabyte body amortises its handshake anyway).
+std::unique_ptr<WiFiClient> pooledClient;
+std::unique_ptr<HTTPClient> pooledHttp;
+std::string pooledHostKey;
+
+// scheme://host[:port] prefix - connections are only reusable within it
+std::string hostKeyForUrl(const std::string& url) {
+  const size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string::npos) {
+    return url;
+  }
+  const size_t hostEnd = url.find('/', schemeEnd + 3);
+  return hostEnd == std::string::npos ? url : url.substr(0, hostEnd);
+}
+}  // namespace
+
+HTTPClient& HttpDownloader::acquireConnection(const std::string& url) {
+  const std::string key = hostKeyForUrl(url);
+  if (pooledHttp && key != pooledHostKey) {
+    closeConnection();  // Different host; the old socket is useless
   }
-  HTTPClient http;
+
+  if (!pooledHttp) {
+    // Use WiFiClientSecure for HTTPS, regular WiFiClient for HTTP
+    if (UrlUtils::isHttpsUrl(url)) {
+      auto* secureClient = new WiFiClientSecure();
+      secureClient->setInsecure();
+      pooledClient.reset(secureClient);
+    } else {
+      pooledClient.reset(new WiFiClient());
+    }
+    pooledHttp.reset(new HTTPClient());
+    pooledHttp->setReuse(true);
+    pooledHostKey = key;
+  }
+
+  // begin() on a live kept-alive socket skips the reconnect entirely
+  pooledHttp->begin(*pooledClient, url.c_str());
+  return *pooledHttp;
+}
+
+void HttpDownloader::closeConnection() {
+  if (pooledHttp) {
+    pooledHttp->setReuse(false);
+    pooledHttp->end();
+  }
+  pooledHttp.reset();
+  pooledClient.reset();
+  pooledHostKey.clear();
+}
+
+bool HttpDownloader::fetchUrl(const std::string& url, Stream& outContent) {
+  HTTPClient& http = acquireConnection(url);
 
   Serial.printf("[%lu] [HTTP] Fetching: %s\n", millis(), url.c_str());
 
-  http.begin(*client, url.c_str());
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
   http.addHeader("User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
 
@@ -38,32 +129,232 @@ bool HttpDownloader::fetchUrl(const std::string& url, Stream& outContent) {
     http.addHeader("Authorization", "Basic " + encoded);
   }
 
-  const int httpCode = http.GET();
+  int httpCode;
+  {
+    // The TLS handshake behind a fresh HTTPS socket is CPU-bound; run it boosted
+    const PowerGovernor::Lease powerLease;
+    httpCode = http.GET();
+  }
   if (httpCode != HTTP_CODE_OK) {
     Serial.printf("[%lu] [HTTP] Fetch failed: %d\n", millis(), httpCode);
+    if (httpCode < 0) {
+      closeConnection();  // Transport-level failure; don't trust the socket again
+    } else {
+      http.end();
+    }
+    return false;
+  }
+
+  http.writeToStream(&outContent);
+
+  http.end();  // Keep-alive: the socket survives for the next fetch
+
+  Serial.printf("[%lu] [HTTP] Fetch success\n", millis());
+  return true;
+}
+
+bool HttpDownloader::fetchUrl(const std::string& url, Stream& outContent, std::string& etag,
+                              std::string& lastModified, bool& notModified) {
+  notModified = false;
+
+  HTTPClient& http = acquireConnection(url);
+
+  Serial.printf("[%lu] [HTTP] Fetching: %s\n", millis(), url.c_str());
+
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  http.addHeader("User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
+
+  // Add Basic HTTP auth if credentials are configured
+  if (strlen(SETTINGS.opdsUsername) > 0 && strlen(SETTINGS.opdsPassword) > 0) {
+    std::string credentials = std::string(SETTINGS.opdsUsername) + ":" + SETTINGS.opdsPassword;
+    String encoded = base64::encode(credentials.c_str());
+    http.addHeader("Authorization", "Basic " + encoded);
+  }
+
+  const char* headerKeys[] = {"ETag", "Last-Modified"};
+  http.collectHeaders(headerKeys, 2);
+
+  if (!etag.empty()) {
+    http.addHeader("If-None-Match", etag.c_str());
+  }
+  if (!lastModified.empty()) {
+    http.addHeader("If-Modified-Since", lastModified.c_str());
+  }
+
+  int httpCode;
+  {
+    const PowerGovernor::Lease powerLease;  // Boosted TLS handshake, as above
+    httpCode = http.GET();
+  }
+  if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+    Serial.printf("[%lu] [HTTP] Not modified (304)\n", millis());
+    notModified = true;
     http.end();
+    return true;
+  }
+  if (httpCode != HTTP_CODE_OK) {
+    Serial.printf("[%lu] [HTTP] Fetch failed: %d\n", millis(), httpCode);
+    if (httpCode < 0) {
+      closeConnection();  // Transport-level failure; don't trust the socket again
+    } else {
+      http.end();
+    }
     return false;
   }
 
+  etag = http.header("ETag").c_str();
+  lastModified = http.header("Last-Modified").c_str();
+
   http.writeToStream(&outContent);
 
-  http.end();
+  http.end();  // Keep-alive: the socket survives for the next fetch
 
   Serial.printf("[%lu] [HTTP] Fetch success\n", millis());
   return true;
 }
 
 bool HttpDownloader::fetchUrl(const std::string& url, std::string& outContent) {
-  StreamString stream;
-  if (!fetchUrl(url, stream)) {
+  outContent.clear();
+
+  HTTPClient& http = acquireConnection(url);
+
+  Serial.printf("[%lu] [HTTP] Fetching: %s\n", millis(), url.c_str());
+
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  http.addHeader("User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
+
+  // Add Basic HTTP auth if credentials are configured
+  if (strlen(SETTINGS.opdsUsername) > 0 && strlen(SETTINGS.opdsPassword) > 0) {
+    std::string credentials = std::string(SETTINGS.opdsUsername) + ":" + SETTINGS.opdsPassword;
+    String encoded = base64::encode(credentials.c_str());
+    http.addHeader("Authorization", "Basic " + encoded);
+  }
+
+  int httpCode;
+  {
+    const PowerGovernor::Lease powerLease;  // Boosted TLS handshake, as above
+    httpCode = http.GET();
+  }
+  if (httpCode != HTTP_CODE_OK) {
+    Serial.printf("[%lu] [HTTP] Fetch failed: %d\n", millis(), httpCode);
+    if (httpCode < 0) {
+      closeConnection();  // Transport-level failure; don't trust the socket again
+    } else {
+      http.end();
+    }
+    return false;
+  }
+
+  // Reserve the final buffer from Content-Length so the body lands in one
+  // allocation; refuse oversized responses before buying any memory for them
+  const int sizeHeader = http.getSize();
+  const size_t contentLength = sizeHeader > 0 ? static_cast<size_t>(sizeHeader) : 0;
+  if (contentLength > MAX_FETCH_SIZE) {
+    Serial.printf("[%lu] [HTTP] Response too large: %zu bytes (cap %zu)\n", millis(), contentLength, MAX_FETCH_SIZE);
+    closeConnection();  // Unread body; the socket can't be reused
+    return false;
+  }
+  outContent.reserve(contentLength > 0 ? contentLength : DOWNLOAD_CHUNK_SIZE);
+
+  WiFiClient* stream = http.getStreamPtr();
+  if (!stream) {
+    Serial.printf("[%lu] [HTTP] Failed to get stream\n", millis());
+    closeConnection();
+    return false;
+  }
+
+  const std::unique_ptr<uint8_t[]> buffer(new uint8_t[DOWNLOAD_CHUNK_SIZE]);
+  size_t received = 0;
+  while (http.connected() && (contentLength == 0 || received < contentLength)) {
+    const size_t available = stream->available();
+    if (available == 0) {
+      delay(1);
+      continue;
+    }
+    const size_t toRead = available < DOWNLOAD_CHUNK_SIZE ? available : DOWNLOAD_CHUNK_SIZE;
+    const size_t bytesRead = stream->readBytes(buffer.get(), toRead);
+    if (bytesRead == 0) {
+      break;
+    }
+    // Cap enforced as bytes arrive too, for chunked responses with no Content-Length
+    if (received + bytesRead > MAX_FETCH_SIZE) {
+      Serial.printf("[%lu] [HTTP] Fetch aborted: response exceeds %zu byte cap\n", millis(), MAX_FETCH_SIZE);
+      outContent.clear();
+      outContent.shrink_to_fit();
+      closeConnection();  // Mid-body abort; the socket can't be reused
+      return false;
+    }
+    outContent.append(reinterpret_cast<const char*>(buffer.get()), bytesRead);
+    received += bytesRead;
+  }
+
+  http.end();  // Keep-alive: the socket survives for the next fetch
+
+  if (contentLength > 0 && received != contentLength) {
+    Serial.printf("[%lu] [HTTP] Fetch truncated: got %zu of %zu bytes\n", millis(), received, contentLength);
+    outContent.clear();
     return false;
   }
-  outContent = stream.c_str();
+
+  Serial.printf("[%lu] [HTTP] Fetch success (%zu bytes)\n", millis(), received);
   return true;
 }
 
 HttpDownloader::DownloadError HttpDownloader::downloadToFile(const std::string& url, const std::string& destPath,
-                                                             ProgressCallback progress) {
+                                                             ProgressCallback progress,
+                                                             const std::function<bool()>& abortFn) {
+  Serial.printf("[%lu] [HTTP] Downloading: %s\n", millis(), url.c_str());
+  Serial.printf("[%lu] [HTTP] Destination: %s\n", millis(), destPath.c_str());
+
+  // Pick up where a previous attempt left off, if its partial file and
+  // validators are still around
+  size_t resumeOffset = 0;
+  size_t totalSize = 0;
+  std::string etag;
+  if (SdMan.exists(destPath.c_str()) && loadResumeInfo(destPath, totalSize, etag)) {
+    FsFile partial;
+    if (SdMan.openFileForRead("HTTP", destPath, partial)) {
+      resumeOffset = partial.size();
+      partial.close();
+    }
+    if (resumeOffset == 0 || resumeOffset >= totalSize) {
+      resumeOffset = 0;  // Nothing usable; start over
+    } else {
+      Serial.printf("[%lu] [HTTP] Resuming previous download at %zu of %zu bytes\n", millis(), resumeOffset, totalSize);
+    }
+  }
+
+  DownloadError result = HTTP_ERROR;
+  for (int attempt = 0; attempt < MAX_DOWNLOAD_ATTEMPTS; attempt++) {
+    if (attempt > 0) {
+      Serial.printf("[%lu] [HTTP] Retrying download (attempt %d) from offset %zu\n", millis(), attempt + 1,
+                    resumeOffset);
+      delay(500);
+    }
+    result = downloadAttempt(url, destPath, resumeOffset, totalSize, etag, progress, abortFn);
+    if (result != HTTP_ERROR) {
+      break;  // Success, cancellation, or a failure that retrying won't fix
+    }
+  }
+
+  if (result == OK) {
+    clearResumeInfo(destPath);
+  } else if (result == FILE_ERROR) {
+    // SD-side failure; the partial file is not trustworthy
+    if (SdMan.exists(destPath.c_str())) {
+      SdMan.remove(destPath.c_str());
+    }
+    clearResumeInfo(destPath);
+  }
+  // On HTTP_ERROR the partial file and sidecar stay for the next call to resume
+
+  return result;
+}
+
+HttpDownloader::DownloadError HttpDownloader::downloadAttempt(const std::string& url, const std::string& destPath,
+                                                              size_t& resumeOffset, size_t& totalSize,
+                                                              std::string& etag, const ProgressCallback& progress,
+                                                              const std::function<bool()>& abortFn) {
   // Use WiFiClientSecure for HTTPS, regular WiFiClient for HTTP
   std::unique_ptr<WiFiClient> client;
   if (UrlUtils::isHttpsUrl(url)) {
@@ -75,9 +366,6 @@ HttpDownloader::DownloadError HttpDownloader::downloadToFile(const std::string&
   }
   HTTPClient http;
 
-  Serial.printf("[%lu] [HTTP] Downloading: %s\n", millis(), url.c_str());
-  Serial.printf("[%lu] [HTTP] Destination: %s\n", millis(), destPath.c_str());
-
   http.begin(*client, url.c_str());
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
   http.addHeader("User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
@@ -89,84 +377,134 @@ HttpDownloader::DownloadError HttpDownloader::downloadToFile(const std::string&
     http.addHeader("Authorization", "Basic " + encoded);
   }
 
-  const int httpCode = http.GET();
-  if (httpCode != HTTP_CODE_OK) {
+  const char* headerKeys[] = {"ETag"};
+  http.collectHeaders(headerKeys, 1);
+
+  if (resumeOffset > 0) {
+    char range[48];
+    snprintf(range, sizeof(range), "bytes=%zu-", resumeOffset);
+    http.addHeader("Range", range);
+    if (!etag.empty()) {
+      // Server sends 200 with the full body if the content changed
+      http.addHeader("If-Range", etag.c_str());
+    }
+  }
+
+  int httpCode;
+  {
+    const PowerGovernor::Lease powerLease;  // Boosted TLS handshake, as above
+    httpCode = http.GET();
+  }
+  bool resuming = httpCode == HTTP_CODE_PARTIAL_CONTENT && resumeOffset > 0;
+  if (!resuming && httpCode != HTTP_CODE_OK) {
     Serial.printf("[%lu] [HTTP] Download failed: %d\n", millis(), httpCode);
     http.end();
     return HTTP_ERROR;
   }
 
-  const size_t contentLength = http.getSize();
-  Serial.printf("[%lu] [HTTP] Content-Length: %zu\n", millis(), contentLength);
-
-  // Remove existing file if present
-  if (SdMan.exists(destPath.c_str())) {
-    SdMan.remove(destPath.c_str());
+  const String responseEtag = http.header("ETag");
+  if (!resuming) {
+    // Full body (fresh download, or server ignored/rejected the range)
+    resumeOffset = 0;
+    etag = responseEtag.c_str();
   }
 
-  // Open file for writing
+  const int sizeHeader = http.getSize();
+  const size_t contentLength = sizeHeader > 0 ? static_cast<size_t>(sizeHeader) : 0;
+  totalSize = resumeOffset + contentLength;
+  Serial.printf("[%lu] [HTTP] Content-Length: %zu (offset %zu)\n", millis(), contentLength, resumeOffset);
+
+  // Open the destination: append to the partial file when resuming
   FsFile file;
-  if (!SdMan.openFileForWrite("HTTP", destPath.c_str(), file)) {
-    Serial.printf("[%lu] [HTTP] Failed to open file for writing\n", millis());
-    http.end();
-    return FILE_ERROR;
+  if (resuming) {
+    file = SdMan.open(destPath.c_str(), O_WRONLY | O_AT_END);
+    if (!file) {
+      Serial.printf("[%lu] [HTTP] Failed to reopen partial file\n", millis());
+      http.end();
+      return FILE_ERROR;
+    }
+  } else {
+    if (SdMan.exists(destPath.c_str())) {
+      SdMan.remove(destPath.c_str());
+    }
+    if (!SdMan.openFileForWrite("HTTP", destPath.c_str(), file)) {
+      Serial.printf("[%lu] [HTTP] Failed to open file for writing\n", millis());
+      http.end();
+      return FILE_ERROR;
+    }
   }
 
+  // Persist validators up front so even an interrupted transfer can resume
+  saveResumeInfo(destPath, totalSize, etag);
+
   // Get the stream for chunked reading
   WiFiClient* stream = http.getStreamPtr();
   if (!stream) {
     Serial.printf("[%lu] [HTTP] Failed to get stream\n", millis());
     file.close();
-    SdMan.remove(destPath.c_str());
     http.end();
     return HTTP_ERROR;
   }
 
-  // Download in chunks
-  uint8_t buffer[DOWNLOAD_CHUNK_SIZE];
-  size_t downloaded = 0;
-  const size_t total = contentLength > 0 ? contentLength : 0;
+  // Download in adaptively sized chunks: grow while the socket keeps a full
+  // chunk buffered (SD writes are the bottleneck, bigger writes amortise
+  // better), shrink when the network can't keep up
+  const std::unique_ptr<uint8_t[]> buffer(new uint8_t[MAX_DOWNLOAD_CHUNK_SIZE]);
+  size_t chunkSize = DOWNLOAD_CHUNK_SIZE;
+  size_t received = 0;
+
+  while (http.connected() && (contentLength == 0 || received < contentLength)) {
+    if (abortFn && abortFn()) {
+      Serial.printf("[%lu] [HTTP] Download aborted at %zu bytes\n", millis(), resumeOffset);
+      file.close();
+      http.end();
+      return ABORTED;  // Partial file and sidecar stay so a later call resumes
+    }
 
-  while (http.connected() && (contentLength == 0 || downloaded < contentLength)) {
     const size_t available = stream->available();
     if (available == 0) {
       delay(1);
       continue;
     }
 
-    const size_t toRead = available < DOWNLOAD_CHUNK_SIZE ? available : DOWNLOAD_CHUNK_SIZE;
-    const size_t bytesRead = stream->readBytes(buffer, toRead);
+    if (available >= chunkSize * 2 && chunkSize < MAX_DOWNLOAD_CHUNK_SIZE) {
+      chunkSize *= 2;
+    } else if (available < chunkSize / 2 && chunkSize > DOWNLOAD_CHUNK_SIZE) {
+      chunkSize /= 2;
+    }
+
+    const size_t toRead = available < chunkSize ? available : chunkSize;
+    const size_t bytesRead = stream->readBytes(buffer.get(), toRead);
 
     if (bytesRead == 0) {
       break;
     }
 
-    const size_t written = file.write(buffer, bytesRead);
+    const size_t written = file.write(buffer.get(), bytesRead);
     if (written != bytesRead) {
       Serial.printf("[%lu] [HTTP] Write failed: wrote %zu of %zu bytes\n", millis(), written, bytesRead);
       file.close();
-      SdMan.remove(destPath.c_str());
       http.end();
       return FILE_ERROR;
     }
 
-    downloaded += bytesRead;
+    received += bytesRead;
+    resumeOffset += bytesRead;
 
-    if (progress && total > 0) {
-      progress(downloaded, total);
+    if (progress && totalSize > 0) {
+      progress(resumeOffset, totalSize);
     }
   }
 
   file.close();
   http.end();
 
-  Serial.printf("[%lu] [HTTP] Downloaded %zu bytes\n", millis(), downloaded);
+  Serial.printf("[%lu] [HTTP] Downloaded %zu bytes this attempt (%zu total)\n", millis(), received, resumeOffset);
 
   // Verify download size if known
-  if (contentLength > 0 && downloaded != contentLength) {
-    Serial.printf("[%lu] [HTTP] Size mismatch: got %zu, expected %zu\n", millis(), downloaded, contentLength);
-    SdMan.remove(destPath.c_str());
-    return HTTP_ERROR;
+  if (contentLength > 0 && received != contentLength) {
+    Serial.printf("[%lu] [HTTP] Size mismatch: got %zu, expected %zu\n", millis(), received, contentLength);
+    return HTTP_ERROR;  // Partial file is kept; the caller retries with a Range request
   }
 
   return OK;
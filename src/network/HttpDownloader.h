@@ -4,6 +4,8 @@
 #include <functional>
 #include <string>
 
+class HTTPClient;
+
 /**
  * HTTP client utility for fetching content and downloading files.
  * Wraps WiFiClientSecure and HTTPClient for HTTPS requests.
@@ -20,25 +22,67 @@ class HttpDownloader {
   };
 
   /**
-   * Fetch text content from a URL.
+   * Fetch text content from a URL into a string held in RAM.
+   * The buffer is reserved from Content-Length up front and the body streamed
+   * straight into it; responses over MAX_FETCH_SIZE are refused (or aborted
+   * mid-body when the server didn't declare a length) rather than grown until
+   * the heap gives out.
    * @param url The URL to fetch
-   * @param outContent The fetched content (output)
+   * @param outContent The fetched content (output, cleared on failure)
    * @return true if fetch succeeded, false on error
    */
   static bool fetchUrl(const std::string& url, std::string& outContent);
 
   static bool fetchUrl(const std::string& url, Stream& stream);
 
+  /**
+   * Fetch with HTTP cache revalidation. Sends If-None-Match / If-Modified-Since
+   * when the validators are non-empty; on a 304 the stream is left untouched
+   * and notModified is set, on a 200 the body is streamed out and the
+   * validators are replaced with the response's.
+   * @return true if the server answered 200 or 304, false on error
+   */
+  static bool fetchUrl(const std::string& url, Stream& stream, std::string& etag, std::string& lastModified,
+                       bool& notModified);
+
   /**
    * Download a file to the SD card.
+   * Downloads are resumable: a partial file plus a sidecar with the expected
+   * size and ETag survive a failed transfer, and retries pick up where the
+   * last one stopped via HTTP Range requests.
    * @param url The URL to download
    * @param destPath The destination path on SD card
    * @param progress Optional progress callback
+   * @param abortFn Optional cancellation check, polled between chunks; aborting
+   *                keeps the partial file so a later call resumes it
    * @return DownloadError indicating success or failure type
    */
   static DownloadError downloadToFile(const std::string& url, const std::string& destPath,
-                                      ProgressCallback progress = nullptr);
+                                      ProgressCallback progress = nullptr,
+                                      const std::function<bool()>& abortFn = nullptr);
+
+  /**
+   * Drop the pooled keep-alive connection used by fetchUrl. Call when leaving
+   * a network-using activity (before WiFi goes down) so the socket and its
+   * TLS buffers don't outlive the session that opened them.
+   */
+  static void closeConnection();
 
  private:
-  static constexpr size_t DOWNLOAD_CHUNK_SIZE = 1024;
+  static constexpr size_t DOWNLOAD_CHUNK_SIZE = 1024;      // Initial chunk size
+  static constexpr size_t MAX_DOWNLOAD_CHUNK_SIZE = 8192;  // Adaptive ceiling
+  static constexpr int MAX_DOWNLOAD_ATTEMPTS = 4;
+  // Largest body the in-RAM fetchUrl accepts; anything bigger belongs on SD
+  // via downloadToFile. Sized for the largest OPDS feed pages seen in the wild
+  // while staying well clear of the device's free heap.
+  static constexpr size_t MAX_FETCH_SIZE = 256 * 1024;
+
+  // Bind the pooled keep-alive client to a URL, reconnecting only when the
+  // host changes or the previous socket died
+  static HTTPClient& acquireConnection(const std::string& url);
+
+  // One connection attempt; advances resumeOffset as bytes land on SD
+  static DownloadError downloadAttempt(const std::string& url, const std::string& destPath, size_t& resumeOffset,
+                                       size_t& totalSize, std::string& etag, const ProgressCallback& progress,
+                                       const std::function<bool()>& abortFn);
 };
@@ -0,0 +1,113 @@
+#include "OpdsCoverCache.h"
+
+#include <HardwareSerial.h>
+#include <JpegToBmpConverter.h>
+#include <SDCardManager.h>
+
+#include <cstdio>
+
+#include "HttpDownloader.h"
+
+namespace {
+constexpr char COVER_CACHE_DIR[] = "/.crosspoint/opds/covers";
+// Shared staging file for the JPEG download; only one cover job runs at a time
+constexpr char COVER_TMP_PATH[] = "/.crosspoint/opds/covers/fetch.tmp";
+// A mini-cover BMP is ~100 bytes, so this bounds the directory well under one SD cluster each
+constexpr size_t MAX_CACHED_COVERS = 128;
+
+// Same scheme as OpdsFeedCache: FNV-1a just names the file, and a collision only
+// costs showing the wrong mini-cover until the colliding entry is pruned
+uint32_t hashUrl(const std::string& url) {
+  uint32_t hash = 2166136261u;
+  for (const char c : url) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+}  // namespace
+
+std::string OpdsCoverCache::bmpPath(const std::string& url) {
+  char name[16];
+  snprintf(name, sizeof(name), "/%08lx.bmp", static_cast<unsigned long>(hashUrl(url)));
+  return std::string(COVER_CACHE_DIR) + name;
+}
+
+bool OpdsCoverCache::exists(const std::string& url) { return SdMan.exists(bmpPath(url).c_str()); }
+
+bool OpdsCoverCache::fetchAndConvert(const std::string& url) {
+  SdMan.mkdir("/.crosspoint");
+  SdMan.mkdir("/.crosspoint/opds");
+  SdMan.mkdir(COVER_CACHE_DIR);
+  pruneOldCovers();
+
+  SdMan.remove(COVER_TMP_PATH);
+  if (HttpDownloader::downloadToFile(url, COVER_TMP_PATH) != HttpDownloader::OK) {
+    // Network failure: leave no marker, so the cover is retried next time
+    SdMan.remove(COVER_TMP_PATH);
+    return false;
+  }
+
+  const std::string outPath = bmpPath(url);
+  bool converted = false;
+  FsFile jpegFile;
+  if (SdMan.openFileForRead("OCC", COVER_TMP_PATH, jpegFile)) {
+    FsFile bmpFile;
+    if (SdMan.openFileForWrite("OCC", outPath, bmpFile)) {
+      converted = JpegToBmpConverter::jpegFileTo1BitBmpStreamWithSize(jpegFile, bmpFile, THUMB_WIDTH, THUMB_HEIGHT);
+      bmpFile.close();
+    }
+    jpegFile.close();
+  }
+  SdMan.remove(COVER_TMP_PATH);
+
+  if (!converted) {
+    // Not a decodable JPEG: truncate to a zero-byte marker so the URL isn't refetched;
+    // the renderer skips it when the BMP headers fail to parse
+    FsFile marker;
+    if (SdMan.openFileForWrite("OCC", outPath, marker)) {
+      marker.close();
+    }
+    Serial.printf("[%lu] [OCC] Cover not decodable, marked: %s\n", millis(), url.c_str());
+    return false;
+  }
+  return true;
+}
+
+void OpdsCoverCache::pruneOldCovers() {
+  FsFile dir = SdMan.open(COVER_CACHE_DIR);
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+
+  // fetchAndConvert() adds at most one file per call, so evicting a single
+  // oldest file here is enough to keep the directory bounded
+  size_t count = 0;
+  uint32_t oldestStamp = UINT32_MAX;
+  char oldestName[32] = {0};
+
+  char name[32];
+  FsFile file = dir.openNextFile();
+  while (file) {
+    if (!file.isDirectory()) {
+      count++;
+      file.getName(name, sizeof(name));
+      uint16_t date = 0, time = 0;
+      file.getModifyDateTime(&date, &time);
+      const uint32_t stamp = (static_cast<uint32_t>(date) << 16) | time;
+      if (stamp < oldestStamp) {
+        oldestStamp = stamp;
+        snprintf(oldestName, sizeof(oldestName), "%s", name);
+      }
+    }
+    file.close();
+    file = dir.openNextFile();
+  }
+  dir.close();
+
+  if (count >= MAX_CACHED_COVERS && oldestName[0] != '\0') {
+    const std::string path = std::string(COVER_CACHE_DIR) + "/" + oldestName;
+    SdMan.remove(path.c_str());
+    Serial.printf("[%lu] [OCC] Pruned oldest cached cover: %s\n", millis(), path.c_str());
+  }
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+
+/**
+ * On-SD cache of OPDS cover thumbnails, keyed by cover URL.
+ * The browser's background cover job downloads the JPEG and converts it to a
+ * 1-bit BMP at list-row size (small enough that the reduced DC-only JPEG
+ * decode path handles any realistic cover), so the list renderer only ever
+ * touches ready-made files. Covers that can't be decoded (PNG art, broken
+ * files) leave a zero-byte marker behind so they aren't refetched every visit.
+ */
+class OpdsCoverCache {
+ public:
+  // Mini-cover size fitting the browser's 30px list rows
+  static constexpr int THUMB_WIDTH = 18;
+  static constexpr int THUMB_HEIGHT = 26;
+
+  /** Cache file path for a cover URL (the file may not exist yet). */
+  static std::string bmpPath(const std::string& url);
+
+  /** True when the cover was already fetched (including failed-decode markers). */
+  static bool exists(const std::string& url);
+
+  /**
+   * Download the cover and convert it to the cached thumbnail BMP.
+   * @return true if a drawable thumbnail now exists for the URL
+   */
+  static bool fetchAndConvert(const std::string& url);
+
+ private:
+  static void pruneOldCovers();
+};
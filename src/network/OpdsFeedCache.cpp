@@ -0,0 +1,169 @@
+#include "OpdsFeedCache.h"
+
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+constexpr uint8_t FEED_CACHE_VERSION = 3;  // v3 added per-entry cover thumbnail hrefs
+constexpr char FEED_CACHE_DIR[] = "/.crosspoint/opds";
+// One file per feed page; prune the least recently written once we hit this
+constexpr size_t MAX_CACHED_FEEDS = 24;
+
+// FNV-1a over the URL just names the file; the full URL is stored inside and
+// verified on load, so a hash collision only costs a cache miss
+uint32_t hashUrl(const std::string& url) {
+  uint32_t hash = 2166136261u;
+  for (const char c : url) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+}  // namespace
+
+std::string OpdsFeedCache::cachePath(const std::string& url) {
+  char name[16];
+  snprintf(name, sizeof(name), "/%08lx.bin", static_cast<unsigned long>(hashUrl(url)));
+  return std::string(FEED_CACHE_DIR) + name;
+}
+
+bool OpdsFeedCache::load(const std::string& url, OpdsFeedArena& outEntries, std::string& outEtag,
+                         std::string& outLastModified, std::string& outNextHref) {
+  FsFile file;
+  if (!SdMan.openFileForRead("OFC", cachePath(url), file)) {
+    return false;
+  }
+
+  uint8_t version;
+  serialization::readPod(file, version);
+  if (version != FEED_CACHE_VERSION) {
+    Serial.printf("[%lu] [OFC] Deserialization failed: Unknown version %u\n", millis(), version);
+    file.close();
+    return false;
+  }
+
+  std::string cachedUrl;
+  serialization::readString(file, cachedUrl);
+  if (cachedUrl != url) {
+    // Hash collision with another feed; treat as a miss and let save() overwrite
+    file.close();
+    return false;
+  }
+
+  serialization::readString(file, outEtag);
+  serialization::readString(file, outLastModified);
+  serialization::readString(file, outNextHref);
+
+  uint16_t count;
+  serialization::readPod(file, count);
+  outEntries.clear();
+
+  serialization::RecordView record;
+  for (uint16_t i = 0; i < count; i++) {
+    if (!record.readFrom(file)) {
+      Serial.printf("[%lu] [OFC] Bad record %u, dropping cached feed\n", millis(), i);
+      file.close();
+      outEntries.clear();
+      return false;
+    }
+    uint8_t type;
+    record.pod(type);
+    // Field bytes go straight from the record blob into the arena pool; no
+    // per-field std::string is ever built
+    const char* title = nullptr;
+    const char* author = nullptr;
+    const char* href = nullptr;
+    const char* id = nullptr;
+    const char* thumbHref = nullptr;
+    uint32_t titleLen = 0, authorLen = 0, hrefLen = 0, idLen = 0, thumbHrefLen = 0;
+    record.str(title, titleLen);
+    record.str(author, authorLen);
+    record.str(href, hrefLen);
+    record.str(id, idLen);
+    record.str(thumbHref, thumbHrefLen);
+    outEntries.add(static_cast<OpdsEntryType>(type), title, titleLen, author, authorLen, href, hrefLen, id, idLen,
+                   thumbHref, thumbHrefLen);
+  }
+
+  file.close();
+  return true;
+}
+
+void OpdsFeedCache::save(const std::string& url, const OpdsFeedArena& entries, const std::string& etag,
+                         const std::string& lastModified, const std::string& nextHref) {
+  SdMan.mkdir("/.crosspoint");
+  SdMan.mkdir(FEED_CACHE_DIR);
+  pruneOldFeeds();
+
+  FsFile file;
+  if (!SdMan.openFileForWrite("OFC", cachePath(url), file)) {
+    return;
+  }
+
+  serialization::writePod(file, FEED_CACHE_VERSION);
+  serialization::writeString(file, url);
+  serialization::writeString(file, etag);
+  serialization::writeString(file, lastModified);
+  serialization::writeString(file, nextHref);
+
+  const uint16_t count = static_cast<uint16_t>(entries.size());
+  serialization::writePod(file, count);
+
+  serialization::RecordWriter record;
+  for (size_t i = 0; i < entries.size(); i++) {
+    const OpdsEntryView entry = entries[i];
+    record.clear();
+    record.pod(static_cast<uint8_t>(entry.type));
+    record.str(entry.title, strlen(entry.title));
+    record.str(entry.author, strlen(entry.author));
+    record.str(entry.href, strlen(entry.href));
+    record.str(entry.id, strlen(entry.id));
+    record.str(entry.thumbHref, strlen(entry.thumbHref));
+    record.writeTo(file);
+  }
+
+  file.close();
+  Serial.printf("[%lu] [OFC] Cached feed (%u entries): %s\n", millis(), count, url.c_str());
+}
+
+void OpdsFeedCache::pruneOldFeeds() {
+  FsFile dir = SdMan.open(FEED_CACHE_DIR);
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+
+  // save() adds at most one file per call, so evicting a single oldest file
+  // here is enough to keep the directory bounded
+  size_t count = 0;
+  uint32_t oldestStamp = UINT32_MAX;
+  char oldestName[32] = {0};
+
+  char name[32];
+  FsFile file = dir.openNextFile();
+  while (file) {
+    if (!file.isDirectory()) {
+      count++;
+      file.getName(name, sizeof(name));
+      uint16_t date = 0, time = 0;
+      file.getModifyDateTime(&date, &time);
+      const uint32_t stamp = (static_cast<uint32_t>(date) << 16) | time;
+      if (stamp < oldestStamp) {
+        oldestStamp = stamp;
+        snprintf(oldestName, sizeof(oldestName), "%s", name);
+      }
+    }
+    file.close();
+    file = dir.openNextFile();
+  }
+  dir.close();
+
+  if (count >= MAX_CACHED_FEEDS && oldestName[0] != '\0') {
+    const std::string path = std::string(FEED_CACHE_DIR) + "/" + oldestName;
+    SdMan.remove(path.c_str());
+    Serial.printf("[%lu] [OFC] Pruned oldest cached feed: %s\n", millis(), path.c_str());
+  }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <OpdsFeedArena.h>
+
+#include <string>
+
+/**
+ * On-SD cache of parsed OPDS feed pages, keyed by feed URL.
+ * Stores the entry records (not the raw XML) together with the server's cache
+ * validators, so revisiting a page costs at most one conditional GET and
+ * back-navigation can skip the network entirely.
+ */
+class OpdsFeedCache {
+ public:
+  /**
+   * Load the cached entries, validators and next-page link for a feed URL.
+   * @return true if a cache file for this exact URL exists and decoded cleanly
+   */
+  static bool load(const std::string& url, OpdsFeedArena& outEntries, std::string& outEtag,
+                   std::string& outLastModified, std::string& outNextHref);
+
+  /**
+   * Persist the parsed entries, response validators and next-page link for a
+   * feed URL. Old feed files are pruned so the cache stays bounded.
+   */
+  static void save(const std::string& url, const OpdsFeedArena& entries, const std::string& etag,
+                   const std::string& lastModified, const std::string& nextHref);
+
+ private:
+  static std::string cachePath(const std::string& url);
+  static void pruneOldFeeds();
+};
@@ -0,0 +1,236 @@
+#include "OtaCheck.h"
+
+#include <ArduinoJson.h>
+#include <HardwareSerial.h>
+#include <SDCardManager.h>
+#include <Serialization.h>
+#include <WiFi.h>
+
+#include <cstring>
+
+#include "AsyncTaskQueue.h"
+#include "OtaUpdater.h"
+#include "esp_http_client.h"
+
+OtaCheck OtaCheck::instance;
+
+namespace {
+constexpr char latestReleaseUrl[] = "https://api.github.com/repos/crosspoint-reader/crosspoint-reader/releases/latest";
+constexpr char VERDICT_FILE[] = "/.crosspoint/otacheck.bin";
+constexpr uint32_t VERDICT_MAGIC = 0x4F544143;  // 'OTAC'
+constexpr uint8_t VERDICT_VERSION = 1;
+
+/* Response accumulation for the manifest fetch; same event-handler shape as OtaUpdater.
+ * A 304 never reaches HTTP_EVENT_ON_DATA, so the buffer stays empty on the cheap path. */
+char* manifest_buf;
+int manifest_len;
+std::string last_modified_hdr;
+
+/*
+ * When esp_crt_bundle.h included, it is pointing wrong header file
+ * which is something under WifiClientSecure because of our framework based on arduno platform.
+ * To manage this obstacle, don't include anything, just extern and it will point correct one.
+ */
+extern "C" {
+extern esp_err_t esp_crt_bundle_attach(void* conf);
+}
+
+esp_err_t event_handler(esp_http_client_event_t* event) {
+  if (event->event_id == HTTP_EVENT_ON_HEADER) {
+    if (strcasecmp(event->header_key, "Last-Modified") == 0) {
+      last_modified_hdr = event->header_value;
+    }
+    return ESP_OK;
+  }
+  if (event->event_id != HTTP_EVENT_ON_DATA) return ESP_OK;
+  if (esp_http_client_is_chunked_response(event->client)) {
+    return ESP_OK; /* the OtaUpdater path has never seen this stick; ignore and fail the parse */
+  }
+
+  const int content_len = esp_http_client_get_content_length(event->client);
+  if (manifest_buf == NULL) {
+    manifest_buf = static_cast<char*>(calloc(content_len + 1, sizeof(char)));
+    manifest_len = 0;
+    if (manifest_buf == NULL) {
+      Serial.printf("[%lu] [OTC] Out of memory for manifest buffer (%d)\n", millis(), content_len);
+      return ESP_ERR_NO_MEM;
+    }
+  }
+  const int copy_len = min(event->data_len, content_len - manifest_len);
+  if (copy_len > 0) {
+    memcpy(manifest_buf + manifest_len, event->data, copy_len);
+    manifest_len += copy_len;
+  }
+  return ESP_OK;
+}
+}  // namespace
+
+void OtaCheck::lock() {
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateMutex();
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+void OtaCheck::unlock() { xSemaphoreGive(mutex); }
+
+void OtaCheck::loadVerdict() {
+  if (loaded) {
+    return;
+  }
+  loaded = true;
+  FsFile file;
+  if (!SdMan.openFileForRead("OTC", VERDICT_FILE, file)) {
+    return;
+  }
+  uint32_t magic = 0;
+  uint8_t version = 0;
+  uint8_t avail = 0;
+  std::string checkedFrom;
+  serialization::readPod(file, magic);
+  serialization::readPod(file, version);
+  serialization::readString(file, checkedFrom);
+  serialization::readString(file, lastModified);
+  serialization::readString(file, latest);
+  serialization::readPod(file, avail);
+  file.close();
+  if (magic != VERDICT_MAGIC || version != VERDICT_VERSION || checkedFrom != CROSSPOINT_VERSION) {
+    // A verdict taken from a different running version is meaningless after an update;
+    // drop the conditional hint too so the next check fetches a fresh manifest
+    lastModified.clear();
+    latest.clear();
+    return;
+  }
+  available = avail != 0;
+}
+
+void OtaCheck::saveVerdict() {
+  FsFile file;
+  if (!SdMan.openFileForWrite("OTC", VERDICT_FILE, file)) {
+    return;
+  }
+  serialization::writePod(file, VERDICT_MAGIC);
+  serialization::writePod(file, VERDICT_VERSION);
+  serialization::writeString(file, CROSSPOINT_VERSION);
+  serialization::writeString(file, lastModified);
+  serialization::writeString(file, latest);
+  serialization::writePod(file, static_cast<uint8_t>(available ? 1 : 0));
+  file.close();
+}
+
+void OtaCheck::scheduleOnSession() {
+  lock();
+  const bool alreadyScheduled = scheduled;
+  scheduled = true;
+  unlock();
+  if (alreadyScheduled) {
+    return;
+  }
+  // LOW priority: the session's own traffic (sync, feed fetch, downloads) goes first, and
+  // the battery gating in the queue applies as for any other background job
+  TASK_QUEUE.enqueue(
+      "OtaCheck", [this](const AsyncTaskQueue::Job&) { runCheck(); }, AsyncTaskQueue::Priority::LOW);
+}
+
+void OtaCheck::runCheck() {
+  // AP-mode sessions (hotspot, device transfer) have no route to the manifest
+  if (WiFi.status() != WL_CONNECTED) {
+    lock();
+    scheduled = false;  // session ended first; try again on the next one
+    unlock();
+    return;
+  }
+
+  lock();
+  loadVerdict();
+  const std::string condition = lastModified;
+  unlock();
+
+  manifest_buf = NULL;
+  manifest_len = 0;
+  last_modified_hdr.clear();
+
+  /* To track life time of manifest_buf, dtor will be called on exit from that function */
+  struct manifestBufCleaner {
+    char** bufPtr;
+    ~manifestBufCleaner() {
+      if (*bufPtr) {
+        free(*bufPtr);
+        *bufPtr = NULL;
+      }
+    }
+  } manifestBufCleaner = {&manifest_buf};
+
+  esp_http_client_config_t client_config = {
+      .url = latestReleaseUrl,
+      .event_handler = event_handler,
+      /* Default HTTP client buffer size 512 byte only */
+      .buffer_size = 8192,
+      .buffer_size_tx = 8192,
+      .skip_cert_common_name_check = true,
+      .crt_bundle_attach = esp_crt_bundle_attach,
+  };
+
+  esp_http_client_handle_t client = esp_http_client_init(&client_config);
+  if (!client) {
+    Serial.printf("[%lu] [OTC] HTTP Client Handle Failed\n", millis());
+    return;
+  }
+  esp_http_client_set_header(client, "User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
+  if (!condition.empty()) {
+    esp_http_client_set_header(client, "If-Modified-Since", condition.c_str());
+  }
+
+  const esp_err_t esp_err = esp_http_client_perform(client);
+  const int statusCode = esp_http_client_get_status_code(client);
+  esp_http_client_cleanup(client);
+  if (esp_err != ESP_OK) {
+    Serial.printf("[%lu] [OTC] Background check failed: %s\n", millis(), esp_err_to_name(esp_err));
+    return;
+  }
+
+  if (statusCode == 304) {
+    // Manifest unchanged since the stored verdict; nothing to parse, nothing to write
+    Serial.printf("[%lu] [OTC] Release manifest unchanged (304)\n", millis());
+    return;
+  }
+  if (statusCode != 200 || manifest_buf == NULL) {
+    Serial.printf("[%lu] [OTC] Unexpected HTTP status: %d\n", millis(), statusCode);
+    return;
+  }
+
+  JsonDocument filter;
+  filter["tag_name"] = true;
+  JsonDocument doc;
+  const DeserializationError error = deserializeJson(doc, manifest_buf, DeserializationOption::Filter(filter));
+  if (error || !doc["tag_name"].is<std::string>()) {
+    Serial.printf("[%lu] [OTC] Manifest parse failed\n", millis());
+    return;
+  }
+  const std::string tag = doc["tag_name"].as<std::string>();
+
+  lock();
+  latest = tag;
+  available = OtaUpdater::isVersionNewer(tag);
+  lastModified = last_modified_hdr;
+  saveVerdict();
+  unlock();
+  Serial.printf("[%lu] [OTC] Latest release %s: %s\n", millis(), tag.c_str(),
+                available ? "update available" : "up to date");
+}
+
+bool OtaCheck::updateAvailable() {
+  lock();
+  loadVerdict();
+  const bool result = available;
+  unlock();
+  return result;
+}
+
+std::string OtaCheck::latestVersion() {
+  lock();
+  loadVerdict();
+  std::string result = latest;
+  unlock();
+  return result;
+}
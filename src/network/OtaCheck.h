@@ -0,0 +1,51 @@
+#pragma once
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <string>
+
+/**
+ * Opportunistic background update check, piggybacked on WiFi sessions the user already
+ * started (sync, OPDS browse, web transfer over a joined network).
+ *
+ * OtaUpdateActivity pays a TLS handshake and a full manifest fetch while the user watches a
+ * spinner. This module does the same release lookup once per boot on the shared worker while
+ * a session is connected anyway, sends If-Modified-Since so an unchanged manifest costs a
+ * 304 and no body, and persists the verdict on SD. The settings screen reads the cached
+ * verdict with zero network wait; the activity still does its own authoritative check when
+ * opened.
+ */
+class OtaCheck {
+  // Static instance
+  static OtaCheck instance;
+
+  SemaphoreHandle_t mutex = nullptr;
+  bool loaded = false;
+  bool scheduled = false;
+  // Cached verdict, persisted across boots
+  bool available = false;
+  std::string latest;
+  std::string lastModified;  // Last-Modified of the manifest the verdict came from
+
+  void lock();
+  void unlock();
+  void loadVerdict();
+  void saveVerdict();
+  // Conditional manifest fetch; runs on the shared worker with WiFi already up
+  void runCheck();
+
+ public:
+  // Get singleton instance
+  static OtaCheck& getInstance() { return instance; }
+
+  // Queue one low-priority check for this boot; call once a STA session is associated.
+  // Re-arms itself when the session ends before the job gets network time.
+  void scheduleOnSession();
+
+  // Cached verdict for the settings screen; no network, one small SD read on first use
+  bool updateAvailable();
+  std::string latestVersion();
+};
+
+// Helper macro to access the background update check
+#define OTA_CHECK OtaCheck::getInstance()
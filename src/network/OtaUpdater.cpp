@@ -1,14 +1,53 @@
 #include "OtaUpdater.h"
 
 #include <ArduinoJson.h>
+#include <miniz.h>
 
 #include "esp_http_client.h"
 #include "esp_https_ota.h"
+#include "esp_ota_ops.h"
 #include "esp_wifi.h"
 
 namespace {
 constexpr char latestReleaseUrl[] = "https://api.github.com/repos/crosspoint-reader/crosspoint-reader/releases/latest";
 
+/* Delta patch format written by scripts/make_ota_patch.py:
+ *   header: magic u32, version u8, oldSize u32, oldHash u64, newSize u32, newHash u64
+ *   ops:    COPY u8, srcOffset u32, length u32   (bytes from the running partition)
+ *           ADD  u8, length u32, literal bytes   (bytes carried in the patch)
+ * All fields little-endian; hashes are FNV-1a 64 over the whole image. */
+constexpr uint32_t PATCH_MAGIC = 0x54445058; /* 'XPDT' */
+constexpr uint8_t PATCH_FORMAT_VERSION = 1;
+constexpr uint8_t PATCH_OP_COPY = 0;
+constexpr uint8_t PATCH_OP_ADD = 1;
+constexpr uint64_t FNV_BASIS = 14695981039346656037ull;
+
+uint64_t fnv1a64(uint64_t hash, const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/* esp_http_client_read may return short; loop until the caller has every byte */
+bool readExact(esp_http_client_handle_t client, uint8_t* out, size_t len) {
+  size_t got = 0;
+  while (got < len) {
+    const int readLen = esp_http_client_read(client, reinterpret_cast<char*>(out) + got, len - got);
+    if (readLen <= 0) {
+      return false;
+    }
+    got += readLen;
+  }
+  return true;
+}
+
+template <typename T>
+bool readPatchField(esp_http_client_handle_t client, T* out) {
+  return readExact(client, reinterpret_cast<uint8_t*>(out), sizeof(T));
+}
+
 /* This is buffer and size holder to keep upcoming data from latestReleaseUrl */
 char* local_buf;
 int output_len;
@@ -135,27 +174,51 @@ OtaUpdater::OtaUpdaterError OtaUpdater::checkForUpdate() {
 
   latestVersion = doc["tag_name"].as<std::string>();
 
+  /* Prefer, in order: a delta patch keyed to the running version (about 10x
+   * smaller again), the zlib-compressed payload (about half the transfer
+   * size), then the raw image. The patch is only an accelerator: a full
+   * asset must still exist so a failed patch can fall back. */
+  const std::string deltaAssetName = std::string("firmware-") + CROSSPOINT_VERSION + ".patch";
   for (int i = 0; i < doc["assets"].size(); i++) {
-    if (doc["assets"][i]["name"] == "firmware.bin") {
+    if (doc["assets"][i]["name"] == deltaAssetName) {
+      deltaUrl = doc["assets"][i]["browser_download_url"].as<std::string>();
+      deltaSize = doc["assets"][i]["size"].as<size_t>();
+      deltaAvailable = true;
+      continue;
+    }
+    if (doc["assets"][i]["name"] == "firmware.bin.zz") {
       otaUrl = doc["assets"][i]["browser_download_url"].as<std::string>();
       otaSize = doc["assets"][i]["size"].as<size_t>();
       totalSize = otaSize;
+      otaCompressed = true;
       updateAvailable = true;
       break;
     }
+    if (doc["assets"][i]["name"] == "firmware.bin" && !updateAvailable) {
+      otaUrl = doc["assets"][i]["browser_download_url"].as<std::string>();
+      otaSize = doc["assets"][i]["size"].as<size_t>();
+      totalSize = otaSize;
+      otaCompressed = false;
+      updateAvailable = true;
+      /* Keep scanning in case a compressed asset appears later in the list */
+    }
   }
 
   if (!updateAvailable) {
     Serial.printf("[%lu] [OTA] No firmware.bin asset found\n", millis());
+    deltaAvailable = false; /* never apply a patch with no full image to fall back on */
     return NO_UPDATE;
   }
 
-  Serial.printf("[%lu] [OTA] Found update: %s\n", millis(), latestVersion.c_str());
+  Serial.printf("[%lu] [OTA] Found update: %s%s\n", millis(), latestVersion.c_str(),
+                deltaAvailable ? " (delta patch available)" : "");
   return OK;
 }
 
-bool OtaUpdater::isUpdateNewer() const {
-  if (!updateAvailable || latestVersion.empty() || latestVersion == CROSSPOINT_VERSION) {
+bool OtaUpdater::isUpdateNewer() const { return updateAvailable && isVersionNewer(latestVersion); }
+
+bool OtaUpdater::isVersionNewer(const std::string& version) {
+  if (version.empty() || version == CROSSPOINT_VERSION) {
     return false;
   }
 
@@ -165,7 +228,7 @@ bool OtaUpdater::isUpdateNewer() const {
   const auto currentVersion = CROSSPOINT_VERSION;
 
   // semantic version check (only match on 3 segments)
-  sscanf(latestVersion.c_str(), "%d.%d.%d", &latestMajor, &latestMinor, &latestPatch);
+  sscanf(version.c_str(), "%d.%d.%d", &latestMajor, &latestMinor, &latestPatch);
   sscanf(currentVersion, "%d.%d.%d", &currentMajor, &currentMinor, &currentPatch);
 
   /*
@@ -195,6 +258,23 @@ OtaUpdater::OtaUpdaterError OtaUpdater::installUpdate() {
     return UPDATE_OLDER_ERROR;
   }
 
+  if (deltaAvailable) {
+    const OtaUpdaterError deltaResult = installDeltaUpdate();
+    if (deltaResult == OK) {
+      return OK;
+    }
+    /* Any failure (mismatched base image, truncated patch, HTTP error) falls
+     * back to the full download; the inactive slot was aborted, not booted. */
+    Serial.printf("[%lu] [OTA] Delta update failed (%d), falling back to full image\n", millis(), deltaResult);
+    processedSize = 0;
+    totalSize = otaSize;
+    render = true;
+  }
+
+  if (otaCompressed) {
+    return installCompressedUpdate();
+  }
+
   esp_https_ota_handle_t ota_handle = NULL;
   esp_err_t esp_err;
   /* Signal for OtaUpdateActivity */
@@ -261,3 +341,390 @@ OtaUpdater::OtaUpdaterError OtaUpdater::installUpdate() {
   Serial.printf("[%lu] [OTA] Update completed\n", millis());
   return OK;
 }
+
+OtaUpdater::OtaUpdaterError OtaUpdater::installCompressedUpdate() {
+  constexpr size_t READ_CHUNK_SIZE = 4096;
+  esp_err_t esp_err;
+  /* Signal for OtaUpdateActivity */
+  render = false;
+
+  const esp_partition_t* updatePartition = esp_ota_get_next_update_partition(NULL);
+  if (!updatePartition) {
+    Serial.printf("[%lu] [OTA] No OTA partition available\n", millis());
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  esp_http_client_config_t client_config = {
+      .url = otaUrl.c_str(),
+      .timeout_ms = 15000,
+      /* Default HTTP client buffer size 512 byte only
+       * not sufficent to handle URL redirection cases or
+       * parsing of large HTTP headers.
+       */
+      .buffer_size = 8192,
+      .buffer_size_tx = 8192,
+      .skip_cert_common_name_check = true,
+      .crt_bundle_attach = esp_crt_bundle_attach,
+      .keep_alive_enable = true,
+  };
+
+  esp_http_client_handle_t client = esp_http_client_init(&client_config);
+  if (!client) {
+    Serial.printf("[%lu] [OTA] HTTP Client Handle Failed\n", millis());
+    return INTERNAL_UPDATE_ERROR;
+  }
+  esp_http_client_set_header(client, "User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
+
+  /* For better timing and connectivity, we disable power saving for WiFi */
+  esp_wifi_set_ps(WIFI_PS_NONE);
+
+  /* Open in streaming mode and follow redirects by hand (GitHub serves
+   * release assets via a redirect; esp_http_client_perform would follow it
+   * for us but cannot stream). */
+  int statusCode = 0;
+  for (int redirects = 0; redirects < 5; redirects++) {
+    esp_err = esp_http_client_open(client, 0);
+    if (esp_err != ESP_OK) {
+      Serial.printf("[%lu] [OTA] esp_http_client_open Failed : %s\n", millis(), esp_err_to_name(esp_err));
+      esp_http_client_cleanup(client);
+      esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+      return HTTP_ERROR;
+    }
+    esp_http_client_fetch_headers(client);
+    statusCode = esp_http_client_get_status_code(client);
+    if (statusCode < 300 || statusCode >= 400) {
+      break;
+    }
+    esp_http_client_set_redirection(client);
+    esp_http_client_close(client);
+  }
+  if (statusCode != 200) {
+    Serial.printf("[%lu] [OTA] Unexpected HTTP status: %d\n", millis(), statusCode);
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return HTTP_ERROR;
+  }
+
+  esp_ota_handle_t ota_handle = 0;
+  esp_err = esp_ota_begin(updatePartition, OTA_SIZE_UNKNOWN, &ota_handle);
+  if (esp_err != ESP_OK) {
+    Serial.printf("[%lu] [OTA] esp_ota_begin Failed: %s\n", millis(), esp_err_to_name(esp_err));
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  /* Inflate straight from the socket into the partition through a circular
+   * dictionary (same tinfl setup as ZipFile's streaming path). esp_ota_write
+   * hashes the image as it lands and esp_ota_end verifies it, so a corrupted
+   * transfer never becomes bootable. */
+  const auto inflator = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
+  const auto readBuffer = static_cast<uint8_t*>(malloc(READ_CHUNK_SIZE));
+  const auto dictBuffer = static_cast<uint8_t*>(malloc(TINFL_LZ_DICT_SIZE));
+  if (!inflator || !readBuffer || !dictBuffer) {
+    Serial.printf("[%lu] [OTA] Out of memory for decompression buffers\n", millis());
+    free(inflator);
+    free(readBuffer);
+    free(dictBuffer);
+    esp_ota_abort(ota_handle);
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return OOM_ERROR;
+  }
+  memset(inflator, 0, sizeof(tinfl_decompressor));
+  tinfl_init(inflator);
+
+  OtaUpdaterError result = OK;
+  size_t readFilled = 0;
+  size_t readCursor = 0;
+  size_t dictCursor = 0;
+  size_t imageSize = 0;
+  bool moreInput = true;
+  bool done = false;
+
+  while (!done) {
+    /* Load more compressed bytes when needed */
+    if (readCursor >= readFilled && moreInput) {
+      const int readLen = esp_http_client_read(client, reinterpret_cast<char*>(readBuffer), READ_CHUNK_SIZE);
+      if (readLen < 0) {
+        Serial.printf("[%lu] [OTA] esp_http_client_read Failed\n", millis());
+        result = HTTP_ERROR;
+        break;
+      }
+      if (readLen == 0) {
+        moreInput = false;
+      }
+      readFilled = readLen;
+      readCursor = 0;
+      processedSize += readLen;
+      /* Sent signal to OtaUpdateActivity */
+      render = true;
+    }
+
+    size_t inBytes = readFilled - readCursor;
+    size_t outBytes = TINFL_LZ_DICT_SIZE - dictCursor;
+
+    const tinfl_status status =
+        tinfl_decompress(inflator, readBuffer + readCursor, &inBytes, dictBuffer, dictBuffer + dictCursor, &outBytes,
+                         (moreInput ? TINFL_FLAG_HAS_MORE_INPUT : 0) | TINFL_FLAG_PARSE_ZLIB_HEADER);
+
+    readCursor += inBytes;
+
+    if (outBytes > 0) {
+      esp_err = esp_ota_write(ota_handle, dictBuffer + dictCursor, outBytes);
+      if (esp_err != ESP_OK) {
+        Serial.printf("[%lu] [OTA] esp_ota_write Failed: %s\n", millis(), esp_err_to_name(esp_err));
+        result = INTERNAL_UPDATE_ERROR;
+        break;
+      }
+      imageSize += outBytes;
+      dictCursor = (dictCursor + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+    }
+
+    if (status < 0) {
+      Serial.printf("[%lu] [OTA] tinfl_decompress() failed with status %d\n", millis(), status);
+      result = INTERNAL_UPDATE_ERROR;
+      break;
+    }
+
+    if (status == TINFL_STATUS_DONE) {
+      done = true;
+    } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && !moreInput) {
+      Serial.printf("[%lu] [OTA] Compressed stream truncated\n", millis());
+      result = HTTP_ERROR;
+      break;
+    }
+  }
+
+  free(inflator);
+  free(readBuffer);
+  free(dictBuffer);
+  esp_http_client_cleanup(client);
+
+  /* Return back to default power saving for WiFi */
+  esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+
+  if (result != OK) {
+    esp_ota_abort(ota_handle);
+    return result;
+  }
+
+  /* esp_ota_end validates the full image written to the partition */
+  esp_err = esp_ota_end(ota_handle);
+  if (esp_err != ESP_OK) {
+    Serial.printf("[%lu] [OTA] esp_ota_end Failed: %s\n", millis(), esp_err_to_name(esp_err));
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  esp_err = esp_ota_set_boot_partition(updatePartition);
+  if (esp_err != ESP_OK) {
+    Serial.printf("[%lu] [OTA] esp_ota_set_boot_partition Failed: %s\n", millis(), esp_err_to_name(esp_err));
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  Serial.printf("[%lu] [OTA] Update completed (%zu bytes inflated from %zu)\n", millis(), imageSize, processedSize);
+  return OK;
+}
+
+OtaUpdater::OtaUpdaterError OtaUpdater::installDeltaUpdate() {
+  constexpr size_t WORK_CHUNK_SIZE = 4096;
+  esp_err_t esp_err;
+  /* Signal for OtaUpdateActivity */
+  render = false;
+  processedSize = 0;
+  totalSize = deltaSize;
+
+  const esp_partition_t* runningPartition = esp_ota_get_running_partition();
+  const esp_partition_t* updatePartition = esp_ota_get_next_update_partition(NULL);
+  if (!runningPartition || !updatePartition) {
+    Serial.printf("[%lu] [OTA] OTA partitions unavailable for delta\n", millis());
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  esp_http_client_config_t client_config = {
+      .url = deltaUrl.c_str(),
+      .timeout_ms = 15000,
+      /* Default HTTP client buffer size 512 byte only
+       * not sufficent to handle URL redirection cases or
+       * parsing of large HTTP headers.
+       */
+      .buffer_size = 8192,
+      .buffer_size_tx = 8192,
+      .skip_cert_common_name_check = true,
+      .crt_bundle_attach = esp_crt_bundle_attach,
+      .keep_alive_enable = true,
+  };
+
+  esp_http_client_handle_t client = esp_http_client_init(&client_config);
+  if (!client) {
+    Serial.printf("[%lu] [OTA] HTTP Client Handle Failed\n", millis());
+    return INTERNAL_UPDATE_ERROR;
+  }
+  esp_http_client_set_header(client, "User-Agent", "CrossPoint-ESP32-" CROSSPOINT_VERSION);
+
+  /* For better timing and connectivity, we disable power saving for WiFi */
+  esp_wifi_set_ps(WIFI_PS_NONE);
+
+  /* Same hand-rolled redirect handling as the compressed path: GitHub serves
+   * release assets via a redirect and we need the streaming read API. */
+  int statusCode = 0;
+  for (int redirects = 0; redirects < 5; redirects++) {
+    esp_err = esp_http_client_open(client, 0);
+    if (esp_err != ESP_OK) {
+      Serial.printf("[%lu] [OTA] esp_http_client_open Failed : %s\n", millis(), esp_err_to_name(esp_err));
+      esp_http_client_cleanup(client);
+      esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+      return HTTP_ERROR;
+    }
+    esp_http_client_fetch_headers(client);
+    statusCode = esp_http_client_get_status_code(client);
+    if (statusCode < 300 || statusCode >= 400) {
+      break;
+    }
+    esp_http_client_set_redirection(client);
+    esp_http_client_close(client);
+  }
+  if (statusCode != 200) {
+    Serial.printf("[%lu] [OTA] Unexpected HTTP status: %d\n", millis(), statusCode);
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return HTTP_ERROR;
+  }
+
+  /* Parse and sanity-check the patch header */
+  uint32_t magic = 0, oldSize = 0, newSize = 0;
+  uint8_t formatVersion = 0;
+  uint64_t oldHash = 0, newHash = 0;
+  if (!readPatchField(client, &magic) || !readPatchField(client, &formatVersion) || !readPatchField(client, &oldSize) ||
+      !readPatchField(client, &oldHash) || !readPatchField(client, &newSize) || !readPatchField(client, &newHash) ||
+      magic != PATCH_MAGIC || formatVersion != PATCH_FORMAT_VERSION || oldSize > runningPartition->size ||
+      newSize > updatePartition->size) {
+    Serial.printf("[%lu] [OTA] Invalid delta patch header\n", millis());
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  const auto workBuffer = static_cast<uint8_t*>(malloc(WORK_CHUNK_SIZE));
+  if (!workBuffer) {
+    Serial.printf("[%lu] [OTA] Out of memory for delta work buffer\n", millis());
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return OOM_ERROR;
+  }
+
+  /* The patch only makes sense against the exact image it was generated from;
+   * verify the running partition before writing a single byte. */
+  uint64_t runningHash = FNV_BASIS;
+  for (size_t offset = 0; offset < oldSize; offset += WORK_CHUNK_SIZE) {
+    const size_t chunk = min(static_cast<size_t>(WORK_CHUNK_SIZE), oldSize - offset);
+    if (esp_partition_read(runningPartition, offset, workBuffer, chunk) != ESP_OK) {
+      Serial.printf("[%lu] [OTA] esp_partition_read Failed\n", millis());
+      free(workBuffer);
+      esp_http_client_cleanup(client);
+      esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+      return INTERNAL_UPDATE_ERROR;
+    }
+    runningHash = fnv1a64(runningHash, workBuffer, chunk);
+  }
+  if (runningHash != oldHash) {
+    Serial.printf("[%lu] [OTA] Running image does not match patch base\n", millis());
+    free(workBuffer);
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  esp_ota_handle_t ota_handle = 0;
+  esp_err = esp_ota_begin(updatePartition, newSize, &ota_handle);
+  if (esp_err != ESP_OK) {
+    Serial.printf("[%lu] [OTA] esp_ota_begin Failed: %s\n", millis(), esp_err_to_name(esp_err));
+    free(workBuffer);
+    esp_http_client_cleanup(client);
+    esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  /* Apply the op stream, hashing the reconstructed image as it is written */
+  OtaUpdaterError result = OK;
+  uint64_t writtenHash = FNV_BASIS;
+  size_t writtenSize = 0;
+  while (writtenSize < newSize && result == OK) {
+    uint8_t op = 0;
+    uint32_t opOffset = 0, opLength = 0;
+    if (!readPatchField(client, &op) || (op == PATCH_OP_COPY && !readPatchField(client, &opOffset)) ||
+        !readPatchField(client, &opLength)) {
+      Serial.printf("[%lu] [OTA] Delta patch stream truncated\n", millis());
+      result = HTTP_ERROR;
+      break;
+    }
+    if ((op != PATCH_OP_COPY && op != PATCH_OP_ADD) || writtenSize + opLength > newSize ||
+        (op == PATCH_OP_COPY && opOffset + opLength > oldSize)) {
+      Serial.printf("[%lu] [OTA] Delta patch op out of bounds\n", millis());
+      result = INTERNAL_UPDATE_ERROR;
+      break;
+    }
+
+    size_t opDone = 0;
+    while (opDone < opLength && result == OK) {
+      const size_t chunk = min(static_cast<size_t>(WORK_CHUNK_SIZE), static_cast<size_t>(opLength) - opDone);
+      if (op == PATCH_OP_COPY) {
+        if (esp_partition_read(runningPartition, opOffset + opDone, workBuffer, chunk) != ESP_OK) {
+          Serial.printf("[%lu] [OTA] esp_partition_read Failed\n", millis());
+          result = INTERNAL_UPDATE_ERROR;
+          break;
+        }
+      } else {
+        if (!readExact(client, workBuffer, chunk)) {
+          Serial.printf("[%lu] [OTA] Delta patch literal truncated\n", millis());
+          result = HTTP_ERROR;
+          break;
+        }
+        processedSize += chunk;
+      }
+      esp_err = esp_ota_write(ota_handle, workBuffer, chunk);
+      if (esp_err != ESP_OK) {
+        Serial.printf("[%lu] [OTA] esp_ota_write Failed: %s\n", millis(), esp_err_to_name(esp_err));
+        result = INTERNAL_UPDATE_ERROR;
+        break;
+      }
+      writtenHash = fnv1a64(writtenHash, workBuffer, chunk);
+      opDone += chunk;
+      writtenSize += chunk;
+      /* Sent signal to OtaUpdateActivity; COPY ops advance progress too */
+      render = true;
+    }
+  }
+
+  free(workBuffer);
+  esp_http_client_cleanup(client);
+
+  /* Return back to default power saving for WiFi */
+  esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+
+  if (result == OK && (writtenSize != newSize || writtenHash != newHash)) {
+    Serial.printf("[%lu] [OTA] Reconstructed image hash mismatch\n", millis());
+    result = INTERNAL_UPDATE_ERROR;
+  }
+  if (result != OK) {
+    esp_ota_abort(ota_handle);
+    return result;
+  }
+
+  /* esp_ota_end validates the full image written to the partition */
+  esp_err = esp_ota_end(ota_handle);
+  if (esp_err != ESP_OK) {
+    Serial.printf("[%lu] [OTA] esp_ota_end Failed: %s\n", millis(), esp_err_to_name(esp_err));
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  esp_err = esp_ota_set_boot_partition(updatePartition);
+  if (esp_err != ESP_OK) {
+    Serial.printf("[%lu] [OTA] esp_ota_set_boot_partition Failed: %s\n", millis(), esp_err_to_name(esp_err));
+    return INTERNAL_UPDATE_ERROR;
+  }
+
+  Serial.printf("[%lu] [OTA] Delta update completed (%zu bytes rebuilt from a %zu byte patch)\n", millis(),
+                writtenSize, deltaSize);
+  return OK;
+}
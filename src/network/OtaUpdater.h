@@ -5,9 +5,13 @@
 
 class OtaUpdater {
   bool updateAvailable = false;
+  bool otaCompressed = false;   // Release carries a zlib-compressed image
+  bool deltaAvailable = false;  // Release carries a patch against the running version
   std::string latestVersion;
   std::string otaUrl;
+  std::string deltaUrl;
   size_t otaSize = 0;
+  size_t deltaSize = 0;
   size_t processedSize = 0;
   size_t totalSize = 0;
   bool render = false;
@@ -33,7 +37,18 @@ class OtaUpdater {
 
   OtaUpdater() = default;
   bool isUpdateNewer() const;
+  // Semantic-version compare against the running firmware (3 segments)
+  static bool isVersionNewer(const std::string& version);
   const std::string& getLatestVersion() const;
   OtaUpdaterError checkForUpdate();
   OtaUpdaterError installUpdate();
+
+ private:
+  // Stream a zlib-compressed image: HTTP chunks are inflated through miniz
+  // straight into the inactive OTA partition, no staging copy
+  OtaUpdaterError installCompressedUpdate();
+  // Stream a block-copy delta patch (produced by scripts/make_ota_patch.py) against the
+  // running partition into the inactive slot. The running image and the written image are
+  // both FNV-verified; installUpdate falls back to the full download on any mismatch
+  OtaUpdaterError installDeltaUpdate();
 };
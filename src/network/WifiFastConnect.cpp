@@ -0,0 +1,75 @@
+#include "WifiFastConnect.h"
+
+#include <HardwareSerial.h>
+#include <WiFi.h>
+
+#include <cstring>
+
+#include "OtaCheck.h"
+#include "WifiCredentialStore.h"
+
+bool WifiFastConnect::begin() {
+  WIFI_STORE.loadFromFile();
+
+  if (!WIFI_STORE.hasLastConnection()) {
+    return false;
+  }
+
+  const WifiLastConnection& last = WIFI_STORE.getLastConnection();
+  const WifiCredential* cred = WIFI_STORE.findCredential(last.ssid);
+  if (!cred) {
+    // Hint points at a network we no longer have credentials for
+    return false;
+  }
+
+  Serial.printf("[%lu] [WFC] Fast connect to %s (channel %u)\n", millis(), last.ssid.c_str(), last.channel);
+
+  WiFi.mode(WIFI_STA);
+
+  // Reuse the last lease as a static config to skip the DHCP exchange. If the
+  // network changed underneath us the association itself will fail and the
+  // caller falls back to the scan path, which restores DHCP via noteFailed().
+  if (last.ip != 0 && last.gateway != 0) {
+    WiFi.config(IPAddress(last.ip), IPAddress(last.gateway), IPAddress(last.subnet), IPAddress(last.dns));
+  }
+
+  if (!cred->password.empty()) {
+    WiFi.begin(last.ssid.c_str(), cred->password.c_str(), last.channel, last.bssid);
+  } else {
+    WiFi.begin(last.ssid.c_str(), nullptr, last.channel, last.bssid);
+  }
+  return true;
+}
+
+void WifiFastConnect::noteConnected() {
+  WifiLastConnection last;
+  last.ssid = WiFi.SSID().c_str();
+  const uint8_t* bssid = WiFi.BSSID();
+  if (last.ssid.empty() || bssid == nullptr) {
+    return;
+  }
+  memcpy(last.bssid, bssid, sizeof(last.bssid));
+  last.channel = static_cast<uint8_t>(WiFi.channel());
+  last.ip = static_cast<uint32_t>(WiFi.localIP());
+  last.gateway = static_cast<uint32_t>(WiFi.gatewayIP());
+  last.subnet = static_cast<uint32_t>(WiFi.subnetMask());
+  last.dns = static_cast<uint32_t>(WiFi.dnsIP());
+
+  WIFI_STORE.setLastConnection(last);
+
+  // Every STA session records its association here, so this is the one place to piggyback
+  // the background update check on a connection the user already paid for
+  OTA_CHECK.scheduleOnSession();
+}
+
+void WifiFastConnect::noteFailed() {
+  WiFi.disconnect();
+
+  // All-zeros config re-enables DHCP for the next attempt
+  WiFi.config(IPAddress(), IPAddress(), IPAddress());
+
+  // A stale hint would cost the fast-connect timeout on every sync; drop it
+  // and let the next successful scan-based connection re-record it.
+  WIFI_STORE.clearLastConnection();
+  Serial.printf("[%lu] [WFC] Fast connect failed, falling back to scan\n", millis());
+}
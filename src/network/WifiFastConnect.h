@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * Targeted WiFi reconnect using the hint persisted in WifiCredentialStore.
+ *
+ * A normal connection pays a full scan plus a DHCP exchange (typically 6-10s)
+ * before any network activity can start. When we know the last AP's BSSID and
+ * channel we can associate directly, and seeding the last DHCP lease as a
+ * static config skips the DHCP round-trip too, bringing association down to
+ * a couple of seconds. Used by the sync and OPDS flows before falling back to
+ * the scan-based WifiSelectionActivity.
+ */
+class WifiFastConnect {
+ public:
+  // How long callers should wait before giving up and falling back to a scan
+  static constexpr unsigned long TIMEOUT_MS = 4000;
+
+  // Start a targeted association to the last AP. Loads the credential store,
+  // so callers holding an SPI/rendering mutex should call this under it.
+  // Returns false when there is no usable hint (caller should scan instead).
+  static bool begin();
+
+  // Persist BSSID/channel/lease of the current association for next time.
+  // Writes to the SD card when the hint changed.
+  static void noteConnected();
+
+  // Clean up after a failed fast attempt: drop the static lease config so the
+  // fallback scan path gets a fresh DHCP lease, and clear the stale hint.
+  static void noteFailed();
+};
@@ -0,0 +1,25 @@
+#include "WifiScanCache.h"
+
+#include <Arduino.h>
+
+namespace {
+std::vector<WifiNetworkInfo> cachedNetworks;
+unsigned long lastScanMs = 0;
+bool hasScan = false;
+}  // namespace
+
+bool WifiScanCache::isFresh() { return hasScan && millis() - lastScanMs < TTL_MS; }
+
+const std::vector<WifiNetworkInfo>& WifiScanCache::get() { return cachedNetworks; }
+
+void WifiScanCache::store(const std::vector<WifiNetworkInfo>& networks) {
+  cachedNetworks = networks;
+  lastScanMs = millis();
+  hasScan = true;
+}
+
+void WifiScanCache::invalidate() {
+  cachedNetworks.clear();
+  cachedNetworks.shrink_to_fit();
+  hasScan = false;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Structure to hold WiFi network information
+struct WifiNetworkInfo {
+  std::string ssid;
+  int32_t rssi;
+  bool isEncrypted;
+  bool hasSavedPassword;  // Whether we have saved credentials for this network
+};
+
+/**
+ * Short-TTL cache of the last completed WiFi scan, shared across the network
+ * activities. A scan costs 3-5s of radio time; reopening the picker within the
+ * TTL shows the previous list instantly while a fresh async scan refreshes it
+ * in place. RAM only - the list is small and goes stale across a deep sleep
+ * anyway.
+ */
+class WifiScanCache {
+ public:
+  // Networks move and power-cycle; past a minute the list is as likely to
+  // mislead as to help
+  static constexpr unsigned long TTL_MS = 60 * 1000;
+
+  // True when a scan completed within the TTL
+  static bool isFresh();
+
+  // Last completed scan's deduplicated, sorted network list (empty when never scanned)
+  static const std::vector<WifiNetworkInfo>& get();
+
+  // Record a completed scan's processed results
+  static void store(const std::vector<WifiNetworkInfo>& networks);
+
+  static void invalidate();
+};
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <iostream>
@@ -301,7 +303,425 @@ void printResults(const std::string& language, const std::vector<TestCase>& test
   }
 }
 
+// ===========================================================================
+// Performance bench ("bench" mode)
+//
+// Measures throughput and memory for the Hyphenator::breakOffsets hot path across the generated
+// tries, comparing the shipped node-heap layout against an experimental packed double-array
+// layout built from the same blobs. Trie format changes should be justified by these numbers
+// (and by the matching `hyphenation` scenario in src/bench/BenchMain.cpp for on-device figures)
+// before any generator work happens.
+// ===========================================================================
+namespace bench {
+
+// Minimal reader for the serialized node-heap layout. Mirrors the decoder inside
+// LiangHyphenation.cpp (kept private there); duplicated here so the experiment can rebuild the
+// shipped blobs without growing the firmware's surface.
+struct BlobNode {
+  size_t addr = 0;
+  uint8_t stride = 1;
+  size_t childCount = 0;
+  const uint8_t* transitions = nullptr;
+  const uint8_t* targets = nullptr;
+  const uint8_t* levels = nullptr;
+  size_t levelsLen = 0;
+  bool valid = false;
+};
+
+int32_t decodeDelta(const uint8_t* buf, const uint8_t stride) {
+  if (stride == 1) {
+    return static_cast<int8_t>(buf[0]);
+  }
+  if (stride == 2) {
+    return static_cast<int16_t>((static_cast<uint16_t>(buf[0]) << 8) | static_cast<uint16_t>(buf[1]));
+  }
+  const int32_t unsignedVal =
+      (static_cast<int32_t>(buf[0]) << 16) | (static_cast<int32_t>(buf[1]) << 8) | static_cast<int32_t>(buf[2]);
+  return unsignedVal - (1 << 23);
+}
+
+BlobNode decodeNode(const std::vector<uint8_t>& blob, const size_t addr) {
+  BlobNode node;
+  if (addr >= blob.size()) {
+    return node;
+  }
+  const uint8_t* base = blob.data() + addr;
+  const size_t remaining = blob.size() - addr;
+  size_t pos = 0;
+
+  const uint8_t header = base[pos++];
+  const bool hasLevels = (header >> 7) != 0;
+  uint8_t stride = static_cast<uint8_t>((header >> 5) & 0x03u);
+  if (stride == 0) {
+    stride = 1;
+  }
+  size_t childCount = static_cast<size_t>(header & 0x1Fu);
+  if (childCount == 31u) {
+    if (pos >= remaining) {
+      return node;
+    }
+    childCount = base[pos++];
+  }
+
+  if (hasLevels) {
+    if (pos + 1 >= remaining) {
+      return node;
+    }
+    const uint8_t offsetHi = base[pos++];
+    const uint8_t offsetLoLen = base[pos++];
+    const size_t offset = (static_cast<size_t>(offsetHi) << 4) | (offsetLoLen >> 4);
+    node.levelsLen = offsetLoLen & 0x0Fu;
+    if (offset + node.levelsLen > blob.size()) {
+      return node;
+    }
+    node.levels = blob.data() + offset;
+  }
+
+  if (pos + childCount > remaining) {
+    return node;
+  }
+  node.transitions = base + pos;
+  pos += childCount;
+  if (pos + childCount * stride > remaining) {
+    return node;
+  }
+  node.targets = base + pos;
+  node.addr = addr;
+  node.stride = stride;
+  node.childCount = childCount;
+  node.valid = true;
+  return node;
+}
+
+// Experimental layout: classic Aoe double-array over the augmented word bytes. One slot per trie
+// state; a transition is a single add + bounds check + parent compare instead of the node-heap's
+// header decode and linear child scan. The price is fixed 12 bytes per slot and the loss of the
+// node-heap's suffix sharing (shared subtrees must be duplicated so every state has one parent).
+struct DoubleArrayTrie {
+  std::vector<int32_t> base;
+  std::vector<int32_t> check;      // parent slot + 1; 0 marks a free slot
+  std::vector<uint32_t> levelRef;  // (levelPool offset << 4) | count; low nibble 0 = no levels
+  std::vector<uint8_t> levelPool;
+
+  size_t memoryBytes() const {
+    return base.size() * sizeof(int32_t) + check.size() * sizeof(int32_t) + levelRef.size() * sizeof(uint32_t) +
+           levelPool.size();
+  }
+  size_t usedSlots() const {
+    size_t used = 0;
+    for (const int32_t c : check) {
+      if (c != 0) {
+        used++;
+      }
+    }
+    return used;
+  }
+};
+
+bool buildDoubleArray(const std::vector<uint8_t>& blob, DoubleArrayTrie& out) {
+  if (blob.size() < 4) {
+    return false;
+  }
+  const size_t rootOffset = (static_cast<size_t>(blob[0]) << 24) | (static_cast<size_t>(blob[1]) << 16) |
+                            (static_cast<size_t>(blob[2]) << 8) | static_cast<size_t>(blob[3]);
+  if (rootOffset >= blob.size()) {
+    return false;
+  }
+
+  const auto ensureSize = [&out](const size_t size) {
+    if (out.check.size() < size) {
+      out.base.resize(size, 0);
+      out.check.resize(size, 0);
+      out.levelRef.resize(size, 0);
+    }
+  };
+
+  ensureSize(512);
+  out.check[0] = -1;  // Root owns slot 0; sentinel parent so the slot never reads as free
+
+  std::vector<std::pair<size_t, int32_t>> queue;  // (blob address, assigned slot)
+  queue.push_back({rootOffset, 0});
+  int32_t firstFreeHint = 1;
+
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const auto [addr, slot] = queue[head];
+    const BlobNode node = decodeNode(blob, addr);
+    if (!node.valid) {
+      return false;
+    }
+
+    if (node.levels != nullptr && node.levelsLen > 0) {
+      out.levelRef[slot] = static_cast<uint32_t>((out.levelPool.size() << 4) | node.levelsLen);
+      out.levelPool.insert(out.levelPool.end(), node.levels, node.levels + node.levelsLen);
+    }
+
+    if (node.childCount == 0) {
+      continue;
+    }
+
+    // Find a base so that every child byte lands on a free slot
+    int32_t candidate = firstFreeHint - static_cast<int32_t>(node.transitions[0]);
+    if (candidate < 1) {
+      candidate = 1;
+    }
+    for (;; ++candidate) {
+      ensureSize(static_cast<size_t>(candidate) + 256 + 1);
+      bool fits = true;
+      for (size_t i = 0; i < node.childCount; ++i) {
+        if (out.check[candidate + node.transitions[i]] != 0) {
+          fits = false;
+          break;
+        }
+      }
+      if (fits) {
+        break;
+      }
+    }
+
+    out.base[slot] = candidate;
+    for (size_t i = 0; i < node.childCount; ++i) {
+      const int32_t target = candidate + node.transitions[i];
+      out.check[target] = slot + 1;
+      const int32_t delta = decodeDelta(node.targets + i * node.stride, node.stride);
+      queue.push_back({static_cast<size_t>(static_cast<int64_t>(addr) + delta), target});
+    }
+    while (static_cast<size_t>(firstFreeHint) < out.check.size() && out.check[firstFreeHint] != 0) {
+      ++firstFreeHint;
+    }
+  }
+  return true;
+}
+
+// Augmented-word construction and score filtering, mirroring LiangHyphenation.cpp so the two
+// layouts run the exact same surrounding pipeline and only the trie walk differs
+struct AugmentedWord {
+  std::string bytes;
+  std::vector<size_t> charByteOffsets;
+  std::vector<int32_t> byteToCharIndex;
+};
+
+bool buildAugmentedWord(const std::vector<CodepointInfo>& cps, bool (*isLetter)(uint32_t),
+                        uint32_t (*toLower)(uint32_t), AugmentedWord& word) {
+  if (cps.empty()) {
+    return false;
+  }
+  word.bytes.clear();
+  word.charByteOffsets.clear();
+  word.charByteOffsets.push_back(0);
+  word.bytes.push_back('.');
+  for (const auto& info : cps) {
+    if (!isLetter(info.value)) {
+      return false;
+    }
+    word.charByteOffsets.push_back(word.bytes.size());
+    utf8AppendCodepoint(word.bytes, toLower(info.value));
+  }
+  word.charByteOffsets.push_back(word.bytes.size());
+  word.bytes.push_back('.');
+
+  word.byteToCharIndex.assign(word.bytes.size(), -1);
+  for (size_t i = 0; i < word.charByteOffsets.size(); ++i) {
+    word.byteToCharIndex[word.charByteOffsets[i]] = static_cast<int32_t>(i);
+  }
+  return true;
+}
+
+void applyPackedLevels(const uint8_t* levels, const size_t levelsLen, const size_t byteStart,
+                       const AugmentedWord& augmented, std::vector<uint8_t>& scores) {
+  size_t offset = 0;
+  for (size_t i = 0; i < levelsLen; ++i) {
+    const uint8_t packed = levels[i];
+    offset += static_cast<size_t>(packed / 10);
+    const uint8_t level = static_cast<uint8_t>(packed % 10);
+    const size_t splitByte = byteStart + offset;
+    if (splitByte >= augmented.byteToCharIndex.size()) {
+      continue;
+    }
+    const int32_t boundary = augmented.byteToCharIndex[splitByte];
+    if (boundary < 2 || boundary + 2 > static_cast<int32_t>(augmented.charByteOffsets.size())) {
+      continue;
+    }
+    const size_t idx = static_cast<size_t>(boundary);
+    if (idx < scores.size()) {
+      scores[idx] = std::max(scores[idx], level);
+    }
+  }
+}
+
+std::vector<size_t> daBreakIndexes(const std::vector<CodepointInfo>& cps, const DoubleArrayTrie& trie,
+                                   bool (*isLetter)(uint32_t), uint32_t (*toLower)(uint32_t), const size_t minPrefix,
+                                   const size_t minSuffix) {
+  static AugmentedWord augmented;
+  if (!buildAugmentedWord(cps, isLetter, toLower, augmented)) {
+    return {};
+  }
+
+  std::vector<uint8_t> scores(augmented.charByteOffsets.size(), 0);
+  const size_t checkSize = trie.check.size();
+
+  for (const size_t byteStart : augmented.charByteOffsets) {
+    int32_t state = 0;
+    for (size_t cursor = byteStart; cursor < augmented.bytes.size(); ++cursor) {
+      const size_t target =
+          static_cast<size_t>(trie.base[state]) + static_cast<uint8_t>(augmented.bytes[cursor]);
+      if (target >= checkSize || trie.check[target] != state + 1) {
+        break;
+      }
+      state = static_cast<int32_t>(target);
+      const uint32_t ref = trie.levelRef[state];
+      if ((ref & 0x0Fu) != 0) {
+        applyPackedLevels(trie.levelPool.data() + (ref >> 4), ref & 0x0Fu, byteStart, augmented, scores);
+      }
+    }
+  }
+
+  std::vector<size_t> indexes;
+  for (size_t breakIndex = std::max<size_t>(1, minPrefix); breakIndex < cps.size(); ++breakIndex) {
+    if (cps.size() - breakIndex < minSuffix) {
+      break;
+    }
+    if (breakIndex + 1 < scores.size() && (scores[breakIndex + 1] & 1u) != 0) {
+      indexes.push_back(breakIndex);
+    }
+  }
+  return indexes;
+}
+
+std::vector<uint8_t> loadTrieBlob(const char* primaryTag) {
+  const std::string path = std::string("lib/Epub/Epub/hyphenation/tries/") + primaryTag + ".bin";
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return {};
+  }
+  std::vector<uint8_t> blob(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+  return blob;
+}
+
+// Runs `oneRound` enough times for a stable reading and returns words per second
+template <typename Fn>
+double wordsPerSecond(const size_t wordsPerRound, const Fn& oneRound) {
+  using Clock = std::chrono::steady_clock;
+  oneRound();  // warm caches
+  auto start = Clock::now();
+  oneRound();
+  double roundSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+  const size_t rounds = std::max<size_t>(1, static_cast<size_t>(0.3 / std::max(roundSeconds, 1e-9)));
+  start = Clock::now();
+  for (size_t i = 0; i < rounds; ++i) {
+    oneRound();
+  }
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  return static_cast<double>(wordsPerRound * rounds) / elapsed;
+}
+
+void benchLanguage(const LanguageConfig& lang) {
+  const auto* hyphenator = getLanguageHyphenatorForPrimaryTag(lang.primaryTag);
+  if (!hyphenator) {
+    std::cerr << "No hyphenator registered for tag: " << lang.primaryTag << std::endl;
+    return;
+  }
+  const std::vector<TestCase> testCases = loadTestData(lang.testDataFile);
+  if (testCases.empty()) {
+    std::cerr << "No corpus for " << lang.cliName << ". Skipping." << std::endl;
+    return;
+  }
+
+  // Same helper pairing LanguageRegistry uses; minima come straight from the live hyphenator
+  const bool cyrillic = std::strcmp(lang.primaryTag, "ru") == 0;
+  bool (*isLetter)(uint32_t) = cyrillic ? isCyrillicLetter : isLatinLetter;
+  uint32_t (*toLower)(uint32_t) = cyrillic ? toLowerCyrillic : toLowerLatin;
+  const size_t minPrefix = hyphenator->minPrefix();
+  const size_t minSuffix = hyphenator->minSuffix();
+
+  // Pre-trimmed codepoints so the timed loops isolate the trie walk
+  std::vector<std::vector<CodepointInfo>> corpus;
+  corpus.reserve(testCases.size());
+  for (const auto& testCase : testCases) {
+    auto cps = collectCodepoints(testCase.word);
+    trimSurroundingPunctuationAndFootnote(cps);
+    if (!cps.empty()) {
+      corpus.push_back(std::move(cps));
+    }
+  }
+
+  const std::vector<uint8_t> blob = loadTrieBlob(lang.primaryTag);
+  if (blob.empty()) {
+    std::cerr << "Missing trie blob for " << lang.primaryTag << std::endl;
+    return;
+  }
+
+  size_t breakSink = 0;
+  const double currentWalk = wordsPerSecond(corpus.size(), [&] {
+    for (const auto& cps : corpus) {
+      breakSink += hyphenator->breakIndexes(cps).size();
+    }
+  });
+  const double endToEnd = wordsPerSecond(testCases.size(), [&] {
+    for (const auto& testCase : testCases) {
+      breakSink += hyphenateWordWithHyphenator(testCase.word, *hyphenator).size();
+    }
+  });
+
+  DoubleArrayTrie trie;
+  const auto buildStart = std::chrono::steady_clock::now();
+  const bool built = buildDoubleArray(blob, trie);
+  const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+  if (!built) {
+    std::cerr << "Double-array build failed for " << lang.primaryTag << std::endl;
+    return;
+  }
+
+  const double daWalk = wordsPerSecond(corpus.size(), [&] {
+    for (const auto& cps : corpus) {
+      breakSink += daBreakIndexes(cps, trie, isLetter, toLower, minPrefix, minSuffix).size();
+    }
+  });
+
+  size_t mismatches = 0;
+  for (const auto& cps : corpus) {
+    if (hyphenator->breakIndexes(cps) != daBreakIndexes(cps, trie, isLetter, toLower, minPrefix, minSuffix)) {
+      mismatches++;
+    }
+  }
+
+  const size_t usedSlots = trie.usedSlots();
+  std::cout << lang.cliName << " (" << lang.primaryTag << "): " << corpus.size() << " corpus words" << std::endl;
+  std::cout << "  node-heap (current): " << blob.size() << " B | " << (currentWalk / 1e6) << " Mwords/s trie walk | "
+            << (endToEnd / 1e6) << " Mwords/s end-to-end" << std::endl;
+  std::cout << "  double-array:        " << trie.memoryBytes() << " B ("
+            << (static_cast<double>(trie.memoryBytes()) / blob.size()) << "x) | " << usedSlots << "/"
+            << trie.check.size() << " slots | build " << buildMs << " ms | " << (daWalk / 1e6)
+            << " Mwords/s trie walk" << std::endl;
+  std::cout << "  correctness:         " << mismatches << "/" << corpus.size() << " mismatches (sink " << breakSink
+            << ")" << std::endl;
+  std::cout << std::endl;
+}
+
+int run(const std::string& selection) {
+  const std::vector<LanguageConfig> languages = resolveLanguages(selection);
+  if (languages.empty()) {
+    std::cerr << "Unknown language: " << selection << std::endl;
+    return 1;
+  }
+  std::cout << "================================================================================" << std::endl;
+  std::cout << "HYPHENATION TRIE LAYOUT BENCHMARK" << std::endl;
+  std::cout << "================================================================================" << std::endl;
+  std::cout << std::endl;
+  for (const auto& lang : languages) {
+    benchLanguage(lang);
+  }
+  return 0;
+}
+
+}  // namespace bench
+
 int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "bench") {
+    return bench::run(argc > 2 ? argv[2] : "all");
+  }
+
   const bool summaryMode = argc <= 1;
   const std::string languageSelection = summaryMode ? "all" : argv[1];
 